@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "bench.h"
+
+#include "algorithm.h"
+#include "type.h"
+#include "vector.h"
+
+static bool uint64_lt(const void* lhs, const void* rhs) {
+    return *static_cast<const uint64_t*>(lhs) < *static_cast<const uint64_t*>(rhs);
+}
+
+static bool uint64_eq(const void* lhs, const void* rhs) {
+    return *static_cast<const uint64_t*>(lhs) == *static_cast<const uint64_t*>(rhs);
+}
+
+// Sorts `count` random keys with `std::sort` and with `CSTL_vector_sort`, both
+// with a built-in ordering (radix sort) and with a user comparison function.
+static void bench_sort(size_t count) {
+    CSTL_PodType pod = CSTL_pod_uint64;
+
+    std::mt19937_64 rng{1};
+    std::vector<uint64_t> input(count);
+
+    for (auto& value : input) {
+        value = rng();
+    }
+
+    std::vector<uint64_t> work(count);
+
+    CSTL_VectorVal vec;
+    vec.first = work.data();
+    vec.last  = work.data() + count;
+    vec.end   = vec.last;
+
+    CSTL_CompType user_comp = { &uint64_eq, &uint64_lt };
+
+    double std_ns = bench_ns([&] {
+        std::copy(input.begin(), input.end(), work.begin());
+        std::sort(work.begin(), work.end());
+        bench_keep(work[count / 2]);
+    });
+
+    double radix_ns = bench_ns([&] {
+        std::copy(input.begin(), input.end(), work.begin());
+        CSTL_vector_sort(&vec, pod.type, &pod.copy.move_type, &CSTL_comp_uint64, nullptr);
+        bench_keep(work[count / 2]);
+    });
+
+    double intro_ns = bench_ns([&] {
+        std::copy(input.begin(), input.end(), work.begin());
+        CSTL_vector_sort(&vec, pod.type, &pod.copy.move_type, &user_comp, nullptr);
+        bench_keep(work[count / 2]);
+    });
+
+    bench_report("sort u64, std vs radix", count * sizeof(uint64_t), std_ns, radix_ns);
+    bench_report("sort u64, std vs comparator", count * sizeof(uint64_t), std_ns, intro_ns);
+}
+
+// Looks up `count` random keys in a `std::set` and in a sorted vector of the same keys.
+static void bench_lookup(size_t count) {
+    CSTL_PodType pod = CSTL_pod_uint64;
+
+    std::mt19937_64 rng{2};
+    std::vector<uint64_t> keys(count);
+
+    for (auto& key : keys) {
+        key = rng();
+    }
+
+    std::set<uint64_t> tree(keys.begin(), keys.end());
+    std::vector<uint64_t> sorted(tree.begin(), tree.end());
+    std::vector<uint64_t> probes(4096);
+
+    for (auto& probe : probes) {
+        probe = rng() % 2 ? keys[rng() % count] : rng();
+    }
+
+    CSTL_VectorVal vec;
+    vec.first = sorted.data();
+    vec.last  = sorted.data() + sorted.size();
+    vec.end   = vec.last;
+
+    double tree_ns = bench_ns([&] {
+        size_t found = 0;
+
+        for (uint64_t probe : probes) {
+            found += tree.find(probe) != tree.end();
+        }
+
+        bench_keep(found);
+    });
+
+    double vector_ns = bench_ns([&] {
+        size_t found = 0;
+
+        for (uint64_t probe : probes) {
+            found += CSTL_vector_binary_search(&vec, pod.type, &CSTL_comp_uint64, &probe);
+        }
+
+        bench_keep(found);
+    });
+
+    bench_report("lookup, std::set vs sorted vector", count * sizeof(uint64_t), tree_ns, vector_ns);
+}
+
+// Intersects a small sorted vector with a large one.
+static void bench_intersection(size_t small, size_t large) {
+    CSTL_PodType pod = CSTL_pod_uint64;
+
+    std::mt19937_64 rng{3};
+    std::vector<uint64_t> lhs(small), rhs(large);
+
+    for (auto& key : lhs) {
+        key = rng() % (large * 4);
+    }
+
+    for (auto& key : rhs) {
+        key = rng() % (large * 4);
+    }
+
+    std::sort(lhs.begin(), lhs.end());
+    std::sort(rhs.begin(), rhs.end());
+
+    CSTL_VectorVal lhs_vec = { lhs.data(), lhs.data() + lhs.size(), lhs.data() + lhs.size() };
+    CSTL_VectorVal rhs_vec = { rhs.data(), rhs.data() + rhs.size(), rhs.data() + rhs.size() };
+
+    std::vector<uint64_t> out;
+    out.reserve(small);
+
+    CSTL_VectorVal dest;
+    CSTL_vector_construct(&dest);
+
+    double std_ns = bench_ns([&] {
+        out.clear();
+        std::set_intersection(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(out));
+        bench_keep(out.size());
+    });
+
+    double cstl_ns = bench_ns([&] {
+        CSTL_vector_clear(&dest, &pod.copy.move_type.drop_type);
+        CSTL_vector_set_intersection(&dest, pod.type, &pod.copy, &CSTL_comp_uint64, &lhs_vec, &rhs_vec, nullptr);
+        bench_keep(CSTL_vector_size(&dest, pod.type));
+    });
+
+    bench_report("intersection, std vs galloping", (small + large) * sizeof(uint64_t), std_ns, cstl_ns);
+
+    CSTL_vector_destroy(&dest, pod.type, &pod.copy.move_type.drop_type, nullptr);
+}
+
+int main() {
+    for (size_t count : {1 << 10, 1 << 16, 1 << 20}) {
+        bench_sort(count);
+    }
+
+    for (size_t count : {1 << 10, 1 << 16, 1 << 20}) {
+        bench_lookup(count);
+    }
+
+    bench_intersection(1 << 8, 1 << 20);
+    bench_intersection(1 << 16, 1 << 16);
+
+    return 0;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+// Runs `body` repeatedly for at least `min_ms` milliseconds and returns
+// the average time per call in nanoseconds.
+template <class F>
+double bench_ns(F&& body, int min_ms = 200) {
+    using clock = std::chrono::steady_clock;
+
+    size_t iterations = 0;
+    auto start = clock::now();
+    auto elapsed = clock::duration{};
+
+    do {
+        for (int i = 0; i < 16; ++i) {
+            body();
+        }
+
+        iterations += 16;
+        elapsed = clock::now() - start;
+    } while (elapsed < std::chrono::milliseconds{min_ms});
+
+    return std::chrono::duration<double, std::nano>(elapsed).count() / (double)iterations;
+}
+
+inline void bench_report(const char* name, size_t bytes, double baseline_ns, double cstl_ns) {
+    std::printf("%-28s %9zu B  baseline %10.1f ns  cstl %10.1f ns  %6.2fx\n",
+        name, bytes, baseline_ns, cstl_ns, baseline_ns / cstl_ns);
+}
+
+// Keeps the optimizer from discarding a computed value.
+template <class T>
+inline void bench_keep(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile T sink;
+    sink = value;
+#endif
+}
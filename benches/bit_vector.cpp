@@ -0,0 +1,55 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+
+#include "bit_vector.h"
+
+// Combines two bit vectors of `size` bits and counts the result,
+// bit by bit with `std::vector<bool>` against word at a time.
+static void bench_and_count(size_t size) {
+    std::mt19937_64 rng{1};
+    std::vector<bool> left(size), right(size);
+
+    CSTL_BitVectorVal lhs, rhs;
+    CSTL_bit_vector_construct(&lhs);
+    CSTL_bit_vector_construct(&rhs);
+    CSTL_bit_vector_assign_n(&lhs, size, false, nullptr);
+    CSTL_bit_vector_assign_n(&rhs, size, false, nullptr);
+
+    for (size_t i = 0; i < size; ++i) {
+        left[i]  = rng() % 2 != 0;
+        right[i] = rng() % 2 != 0;
+        CSTL_bit_vector_assign_bit(&lhs, i, left[i]);
+        CSTL_bit_vector_assign_bit(&rhs, i, right[i]);
+    }
+
+    double std_ns = bench_ns([&] {
+        for (size_t i = 0; i < size; ++i) {
+            left[i] = left[i] && right[i];
+        }
+
+        bench_keep((size_t)std::count(left.begin(), left.end(), true));
+    });
+
+    double cstl_ns = bench_ns([&] {
+        CSTL_bit_vector_and_assign(&lhs, &rhs);
+        bench_keep(CSTL_bit_vector_count(&lhs));
+    });
+
+    bench_report("bit vector and + count, std::vector<bool> vs CSTL", size / 8, std_ns, cstl_ns);
+
+    CSTL_bit_vector_destroy(&rhs, nullptr);
+    CSTL_bit_vector_destroy(&lhs, nullptr);
+}
+
+int main() {
+    for (size_t size : {1 << 12, 1 << 20}) {
+        bench_and_count(size);
+    }
+
+    return 0;
+}
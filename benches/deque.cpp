@@ -0,0 +1,60 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "bench.h"
+
+#include "alloc.h"
+#include "deque.h"
+#include "type.h"
+
+// Pushes `size` elements through a FIFO queue in batches of `batch`.
+static void bench_queue(size_t size, size_t batch) {
+    CSTL_PodType pod = CSTL_pod_uint64;
+
+    std::vector<uint64_t> input(batch);
+    std::vector<uint64_t> output(batch);
+
+    for (size_t i = 0; i < batch; ++i) {
+        input[i] = i;
+    }
+
+    CSTL_DequeVal deque;
+    CSTL_deque_construct(&deque, nullptr);
+
+    double element_ns = bench_ns([&] {
+        for (size_t done = 0; done < size; done += batch) {
+            for (size_t i = 0; i < batch; ++i) {
+                CSTL_deque_copy_push_back(&deque, pod.type, &pod.copy, &input[i], nullptr);
+            }
+
+            for (size_t i = 0; i < batch; ++i) {
+                output[i] = *static_cast<uint64_t*>(CSTL_deque_front(&deque, pod.type));
+                CSTL_deque_pop_front(&deque, pod.type, &pod.copy.move_type.drop_type);
+            }
+        }
+
+        bench_keep(output[0]);
+    });
+
+    double span_ns = bench_ns([&] {
+        for (size_t done = 0; done < size; done += batch) {
+            CSTL_deque_copy_append_range(&deque, pod.type, &pod.copy, input.data(), input.data() + batch, nullptr);
+            CSTL_deque_move_take_front(&deque, pod.type, &pod.copy.move_type, batch, output.data());
+        }
+
+        bench_keep(output[0]);
+    });
+
+    bench_report("deque fifo, element vs span", size * sizeof(uint64_t), element_ns, span_ns);
+
+    CSTL_deque_destroy(&deque, pod.type, &pod.copy.move_type.drop_type, nullptr);
+}
+
+int main() {
+    for (size_t batch : {16, 256, 4096}) {
+        bench_queue(1 << 20, batch);
+    }
+
+    return 0;
+}
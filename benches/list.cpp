@@ -0,0 +1,70 @@
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+
+#include "alloc.h"
+#include "list.h"
+#include "node_pool.h"
+#include "type.h"
+
+// Runs `ops` operations of an LRU cache holding `capacity` entries:
+// a miss inserts at the back and evicts from the front, a hit moves the entry to the back.
+static void bench_lru(size_t capacity, size_t ops) {
+    CSTL_PodType pod = CSTL_pod_uint64;
+
+    std::mt19937_64 rng{1};
+    std::vector<uint64_t> keys(ops);
+
+    for (auto& key : keys) {
+        key = rng() % (capacity * 2);
+    }
+
+    auto run = [&](CSTL_Alloc* alloc) {
+        CSTL_ListVal list;
+        CSTL_list_construct(&list, pod.type, alloc);
+
+        // The list position of every cached key, a stand-in for the cache's hash map.
+        std::vector<CSTL_ListIter> where(capacity * 2, CSTL_list_end(&list, pod.type));
+
+        for (uint64_t key : keys) {
+            if (!CSTL_list_iterator_eq(where[key], CSTL_list_end(&list, pod.type))) {
+                CSTL_list_splice_one(&list, CSTL_list_end(&list, pod.type), &list, where[key]);
+                continue;
+            }
+
+            if (CSTL_list_size(&list) == capacity) {
+                auto evicted = *static_cast<uint64_t*>(CSTL_list_front(&list, pod.type));
+
+                where[evicted] = CSTL_list_end(&list, pod.type);
+                CSTL_list_pop_front(&list, pod.type, &pod.copy.move_type.drop_type, alloc);
+            }
+
+            where[key] = CSTL_list_copy_insert(&list, pod.type, &pod.copy, CSTL_list_end(&list, pod.type), &key, alloc);
+        }
+
+        bench_keep(CSTL_list_size(&list));
+
+        CSTL_list_destroy(&list, pod.type, &pod.copy.move_type.drop_type, alloc);
+    };
+
+    CSTL_NodePool pool;
+    CSTL_node_pool_construct(&pool, CSTL_list_node_size(pod.type), CSTL_list_node_alignment(pod.type), nullptr);
+
+    double malloc_ns = bench_ns([&] { run(nullptr); });
+    double pool_ns   = bench_ns([&] { run(&pool.alloc); });
+
+    bench_report("list lru, malloc vs node pool", ops * sizeof(uint64_t), malloc_ns, pool_ns);
+
+    CSTL_node_pool_destroy(&pool);
+}
+
+int main() {
+    for (size_t capacity : {1 << 10, 1 << 16}) {
+        bench_lru(capacity, 1 << 20);
+    }
+
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "bench.h"
+
+#include "alloc.h"
+#include "map.h"
+#include "type.h"
+
+struct Entry {
+    uint64_t key;
+    uint64_t value;
+};
+
+static bool key_eq(const void* lhs, const void* rhs) {
+    return *static_cast<const uint64_t*>(lhs) == *static_cast<const uint64_t*>(rhs);
+}
+
+static bool key_lt(const void* lhs, const void* rhs) {
+    return *static_cast<const uint64_t*>(lhs) < *static_cast<const uint64_t*>(rhs);
+}
+
+static const CSTL_CompType comp = { &key_eq, &key_lt };
+
+static void bench_map(size_t size) {
+    CSTL_PodType pod = CSTL_pod_type(sizeof(Entry), alignof(Entry));
+
+    std::vector<Entry> sorted(size);
+
+    for (uint64_t i = 0; i < size; ++i) {
+        sorted[i] = { i * 3, i };
+    }
+
+    double insert_ns = bench_ns([&] {
+        CSTL_MapVal map;
+        CSTL_tree_construct(&map, pod.type, nullptr);
+
+        for (const Entry& entry : sorted) {
+            CSTL_tree_copy_insert(&map, pod.type, &comp, &pod.copy, &entry, nullptr, nullptr);
+        }
+
+        bench_keep(map.size);
+        CSTL_tree_destroy(&map, pod.type, &pod.copy.move_type.drop_type, nullptr);
+    }, 100);
+
+    double hint_ns = bench_ns([&] {
+        CSTL_MapVal map;
+        CSTL_tree_construct(&map, pod.type, nullptr);
+
+        for (const Entry& entry : sorted) {
+            CSTL_tree_copy_insert_hint(&map, pod.type, &comp, &pod.copy, CSTL_tree_end(&map, pod.type), &entry, nullptr, nullptr);
+        }
+
+        bench_keep(map.size);
+        CSTL_tree_destroy(&map, pod.type, &pod.copy.move_type.drop_type, nullptr);
+    }, 100);
+
+    double range_ns = bench_ns([&] {
+        CSTL_MapVal map;
+        CSTL_tree_construct(&map, pod.type, nullptr);
+        CSTL_tree_copy_insert_range(&map, pod.type, &comp, &pod.copy, sorted.data(), sorted.data() + size, nullptr);
+        bench_keep(map.size);
+        CSTL_tree_destroy(&map, pod.type, &pod.copy.move_type.drop_type, nullptr);
+    }, 100);
+
+    bench_report("tree insert, hint", size * sizeof(Entry), insert_ns, hint_ns);
+    bench_report("tree insert, sorted range", size * sizeof(Entry), insert_ns, range_ns);
+}
+
+int main() {
+    for (size_t size : {1000, 100000, 2000000}) {
+        bench_map(size);
+    }
+
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#include "bench.h"
+
+#include "alloc.h"
+#include "mmap_alloc.h"
+#include "type.h"
+#include "vector.h"
+
+// The default allocator without growth hooks, as before they existed.
+namespace baseline {
+    void* aligned_alloc(void*, size_t size, size_t alignment) {
+        return std::aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1));
+    }
+
+    void aligned_free(void*, void* memory, size_t, size_t) {
+        std::free(memory);
+    }
+}
+
+static CSTL_VectorVal fill_vector(size_t size, CSTL_Alloc* alloc) {
+    CSTL_PodType pod = CSTL_pod_uint64;
+    CSTL_VectorVal vec;
+
+    CSTL_vector_construct(&vec);
+
+    for (uint64_t i = 0; i < size; ++i) {
+        CSTL_vector_copy_push_back(&vec, pod.type, &pod.copy, &i, alloc);
+    }
+
+    return vec;
+}
+
+static double bench_growth(size_t size, CSTL_Alloc* alloc) {
+    return bench_ns([&] {
+        CSTL_VectorVal vec = fill_vector(size, alloc);
+        bench_keep(vec.last);
+        CSTL_vector_destroy(&vec, CSTL_pod_uint64.type, &CSTL_pod_uint64.copy.move_type.drop_type, alloc);
+    });
+}
+
+// Dependent random reads, bound by TLB misses on large buffers.
+static double bench_gather(size_t size, CSTL_Alloc* alloc) {
+    CSTL_VectorVal vec = fill_vector(size, alloc);
+    uint64_t* data = (uint64_t*)CSTL_vector_data(&vec);
+
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = (i * 0x9E3779B97F4A7C15ull) % size;
+    }
+
+    uint64_t index = 0;
+
+    double ns = bench_ns([&] {
+        for (int i = 0; i < 1024; ++i) {
+            index = data[(index + (uint64_t)i) % size];
+        }
+        bench_keep(index);
+    });
+
+    CSTL_vector_destroy(&vec, CSTL_pod_uint64.type, &CSTL_pod_uint64.copy.move_type.drop_type, alloc);
+
+    return ns;
+}
+
+int main() {
+    CSTL_Alloc plain = { nullptr, &baseline::aligned_alloc, &baseline::aligned_free, nullptr, nullptr };
+
+    CSTL_MmapAlloc mapped;
+    CSTL_mmap_alloc_construct(&mapped, 0, false, nullptr);
+
+    CSTL_MmapAlloc huge;
+    CSTL_mmap_alloc_construct(&huge, 0, true, nullptr);
+
+    for (size_t size : {1 << 16, 1 << 20, 1 << 23}) {
+        size_t bytes = size * sizeof(uint64_t);
+
+        bench_report("vector push_back growth", bytes,
+            bench_growth(size, &plain), bench_growth(size, &mapped.alloc));
+        bench_report("vector gather, huge pages", bytes,
+            bench_gather(size, &plain), bench_gather(size, &huge.alloc));
+    }
+
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+
+#include "algorithm.h"
+#include "parallel.h"
+#include "thread_pool.h"
+#include "type.h"
+#include "vector.h"
+
+static void reduce_sum(const void* first, const void* last, void* result, void*) {
+    *static_cast<uint64_t*>(result) = std::accumulate(static_cast<const uint64_t*>(first), static_cast<const uint64_t*>(last), uint64_t{ 0 });
+}
+
+static void combine_sum(void* result, const void* lhs, const void* rhs, void*) {
+    *static_cast<uint64_t*>(result) = *static_cast<const uint64_t*>(lhs) + *static_cast<const uint64_t*>(rhs);
+}
+
+// Sorts `count` random keys with `CSTL_vector_sort` on one thread and with
+// `CSTL_vector_parallel_sort` on every thread of `pool`.
+static void bench_sort(CSTL_ThreadPool* pool, size_t count) {
+    CSTL_PodType pod = CSTL_pod_uint64;
+
+    std::mt19937_64 rng{1};
+    std::vector<uint64_t> input(count);
+
+    for (auto& value : input) {
+        value = rng();
+    }
+
+    std::vector<uint64_t> work(count);
+    CSTL_VectorVal vec = { work.data(), work.data() + count, work.data() + count };
+
+    double serial_ns = bench_ns([&] {
+        std::copy(input.begin(), input.end(), work.begin());
+        CSTL_vector_sort(&vec, pod.type, &pod.copy.move_type, &CSTL_comp_uint64, nullptr);
+        bench_keep(work[count / 2]);
+    });
+
+    double parallel_ns = bench_ns([&] {
+        std::copy(input.begin(), input.end(), work.begin());
+        CSTL_vector_parallel_sort(pool, &vec, pod.type, &pod.copy.move_type, &CSTL_comp_uint64, nullptr);
+        bench_keep(work[count / 2]);
+    });
+
+    bench_report("sort u64, serial vs parallel", count * sizeof(uint64_t), serial_ns, parallel_ns);
+}
+
+// Sums `count` keys with `std::accumulate` and with `CSTL_vector_parallel_reduce`.
+static void bench_reduce(CSTL_ThreadPool* pool, size_t count) {
+    CSTL_PodType pod = CSTL_pod_uint64;
+
+    std::vector<uint64_t> values(count);
+    std::iota(values.begin(), values.end(), 0);
+
+    CSTL_VectorVal vec = { values.data(), values.data() + count, values.data() + count };
+
+    double serial_ns = bench_ns([&] {
+        bench_keep(std::accumulate(values.begin(), values.end(), uint64_t{ 0 }));
+    });
+
+    double parallel_ns = bench_ns([&] {
+        uint64_t sum = 0;
+        CSTL_vector_parallel_reduce(pool, &vec, pod.type, pod.type, &reduce_sum, &combine_sum, &sum, nullptr, nullptr);
+        bench_keep(sum);
+    });
+
+    bench_report("sum u64, serial vs parallel", count * sizeof(uint64_t), serial_ns, parallel_ns);
+}
+
+int main() {
+    CSTL_ThreadPool* pool = CSTL_thread_pool_create(0, nullptr);
+
+    std::printf("%zu threads\n", CSTL_thread_pool_thread_count(pool));
+
+    for (size_t count : {1 << 16, 1 << 20, 1 << 24}) {
+        bench_sort(pool, count);
+    }
+
+    for (size_t count : {1 << 16, 1 << 20, 1 << 24}) {
+        bench_reduce(pool, count);
+    }
+
+    CSTL_thread_pool_destroy(pool, nullptr);
+    return 0;
+}
@@ -0,0 +1,172 @@
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+
+#include "alloc.h"
+#include "pool.h"
+#include "xstring.h"
+
+// Runs `body(thread_index)` on `threads` threads at once and returns the wall time in nanoseconds.
+template <class F>
+static double bench_threads(size_t threads, F&& body) {
+    using clock = std::chrono::steady_clock;
+
+    std::atomic<bool> go{false};
+    std::vector<std::thread> workers;
+
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+
+            body(t);
+        });
+    }
+
+    auto start = clock::now();
+    go.store(true, std::memory_order_release);
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    return std::chrono::duration<double, std::nano>(clock::now() - start).count();
+}
+
+// Every thread keeps a ring of strings and keeps reassigning them with lengths
+// just past the small string optimisation.
+static double bench_string_churn(size_t threads, CSTL_Alloc* alloc) {
+    constexpr size_t ring = 256;
+    constexpr size_t rounds = 200000;
+
+    static const char text[] = "the quick brown fox jumps over the lazy dog, "
+        "pack my box with five dozen liquor jugs; sphinx of black quartz, judge my vow";
+
+    return bench_threads(threads, [&](size_t t) {
+        std::vector<CSTL_StringVal> strs(ring);
+
+        for (auto& str : strs) {
+            CSTL_string_construct(&str);
+        }
+
+        uint32_t seed = 0x9E3779B9u * (uint32_t)(t + 1);
+
+        for (size_t i = 0; i < rounds; ++i) {
+            seed = seed * 1664525u + 1013904223u;
+
+            CSTL_StringVal& str = strs[seed % ring];
+            size_t length = 16 + (seed >> 24) % 100;
+
+            CSTL_string_destroy(&str, alloc);
+            CSTL_string_construct(&str);
+            CSTL_string_assign_n(&str, text, length, alloc);
+        }
+
+        for (auto& str : strs) {
+            bench_keep(str.size);
+            CSTL_string_destroy(&str, alloc);
+        }
+    });
+}
+
+// Half of the threads allocate blocks and hand them in batches to the other
+// half, which frees them.
+static double bench_cross_thread(size_t threads, void* (*allocate)(size_t), void (*release)(void*, size_t)) {
+    constexpr size_t blocks = 400000;
+    constexpr size_t batch = 256;
+
+    size_t pairs = threads / 2 != 0 ? threads / 2 : 1;
+
+    std::vector<std::mutex> locks(pairs);
+    std::vector<std::vector<std::vector<void*>>> queues(pairs);
+    std::vector<std::atomic<bool>> done(pairs);
+
+    return bench_threads(pairs * 2, [&](size_t t) {
+        size_t pair = t / 2;
+
+        if (t % 2 == 0) {
+            std::vector<void*> current;
+
+            for (size_t i = 0; i < blocks; ++i) {
+                current.push_back(allocate(16 + i % 120));
+
+                if (current.size() == batch) {
+                    std::lock_guard<std::mutex> guard{locks[pair]};
+                    queues[pair].push_back(std::move(current));
+                    current.clear();
+                }
+            }
+
+            std::lock_guard<std::mutex> guard{locks[pair]};
+            queues[pair].push_back(std::move(current));
+            done[pair].store(true, std::memory_order_release);
+        } else {
+            size_t freed = 0;
+
+            for (;;) {
+                std::vector<std::vector<void*>> taken;
+                bool finished = done[pair].load(std::memory_order_acquire);
+
+                {
+                    std::lock_guard<std::mutex> guard{locks[pair]};
+                    taken.swap(queues[pair]);
+                }
+
+                for (auto& current : taken) {
+                    for (void* block : current) {
+                        release(block, 16 + freed++ % 120);
+                    }
+                }
+
+                if (finished && taken.empty()) {
+                    break;
+                }
+            }
+        }
+    });
+}
+
+static void* malloc_allocate(size_t size) {
+    return std::malloc(size);
+}
+
+static void malloc_release(void* block, size_t) {
+    std::free(block);
+}
+
+static void* pool_allocate(size_t size) {
+    return CSTL_pool_allocate(size, 8);
+}
+
+static void pool_release(void* block, size_t size) {
+    CSTL_pool_free(block, size, 8);
+}
+
+int main() {
+    size_t hardware = std::thread::hardware_concurrency();
+
+    for (size_t threads : {(size_t)1, (size_t)4, hardware}) {
+        if (threads == hardware && hardware <= 4) {
+            continue;
+        }
+
+        char name[64];
+
+        std::snprintf(name, sizeof(name), "string churn, %zu threads", threads);
+        bench_report(name, 0, bench_string_churn(threads, nullptr), bench_string_churn(threads, CSTL_pool_alloc()));
+
+        std::snprintf(name, sizeof(name), "cross-thread free, %zu threads", threads < 2 ? 2 : threads);
+        bench_report(name, 0, bench_cross_thread(threads, &malloc_allocate, &malloc_release),
+            bench_cross_thread(threads, &pool_allocate, &pool_release));
+    }
+
+    return 0;
+}
@@ -0,0 +1,356 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+
+#include "alloc.h"
+#include "xstring.h"
+
+// Reference scalar character primitives, one element per iteration.
+namespace baseline {
+    template <class CharT>
+    size_t len(const CharT* ptr) {
+        size_t result = 0;
+        while (ptr[result] != 0) {
+            ++result;
+        }
+        return result;
+    }
+
+    template <class CharT>
+    void set(CharT* dst, CharT ch, size_t n) {
+        while (n-- != 0) {
+            *(dst++) = ch;
+        }
+    }
+
+    template <class CharT>
+    const CharT* memchr(const CharT* first, const CharT* last, CharT ch) {
+        for (; first != last; ++first) {
+            if (*first == ch) {
+                return first;
+            }
+        }
+        return nullptr;
+    }
+
+    template <class CharT>
+    int memcmp(const CharT* first1, const CharT* first2, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            if (first1[i] != first2[i]) {
+                return first1[i] < first2[i] ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_NOINLINE __declspec(noinline)
+#endif
+
+// Keep the reference loops out of line and unvectorised by the caller's context.
+template <class CharT>
+BENCH_NOINLINE size_t baseline_len(const CharT* ptr) { return baseline::len(ptr); }
+
+template <class CharT>
+BENCH_NOINLINE void baseline_set(CharT* dst, CharT ch, size_t n) { baseline::set(dst, ch, n); }
+
+template <class CharT>
+BENCH_NOINLINE const CharT* baseline_memchr(const CharT* first, const CharT* last, CharT ch) { return baseline::memchr(first, last, ch); }
+
+template <class CharT>
+BENCH_NOINLINE int baseline_memcmp(const CharT* first1, const CharT* first2, size_t count) { return baseline::memcmp(first1, first2, count); }
+
+// Reference substring search, first character scan followed by a full comparison.
+template <class CharT>
+BENCH_NOINLINE size_t baseline_find_str(const CharT* hay, size_t hay_size, const CharT* needle, size_t needle_size) {
+    const CharT* last = hay + (hay_size - needle_size) + 1;
+    for (const CharT* match_try = hay;; ++match_try) {
+        match_try = baseline::memchr(match_try, last, *needle);
+        if (match_try == nullptr) {
+            return static_cast<size_t>(-1);
+        }
+        if (baseline::memcmp(match_try + 1, needle + 1, needle_size - 1) == 0) {
+            return static_cast<size_t>(match_try - hay);
+        }
+    }
+}
+
+#define BENCH_WIDTH(CharT, prefix, Type, label)                                                     \
+    static void bench_##prefix##string(size_t size) {                                                \
+        std::basic_string<CharT> text(size, CharT('a'));                                             \
+        std::basic_string<CharT> same(size, CharT('a'));                                             \
+        std::vector<CharT> out(size + 1);                                                            \
+                                                                                                     \
+        CSTL_##Type##StringVal str;                                                                  \
+        CSTL_##prefix##string_construct(&str);                                                       \
+        CSTL_##prefix##string_assign_n(&str, text.data(), text.size(), nullptr);                     \
+                                                                                                     \
+        double base = bench_ns([&] {                                                                 \
+            bench_keep(baseline_memchr(text.data(), text.data() + size, CharT('z')));                \
+        });                                                                                          \
+        double cstl = bench_ns([&] {                                                                 \
+            bench_keep(CSTL_##prefix##string_find_char(&str, CharT('z'), 0));                        \
+        });                                                                                          \
+        bench_report(label " find_char", size * sizeof(CharT), base, cstl);                          \
+                                                                                                     \
+        base = bench_ns([&] {                                                                        \
+            bench_keep(baseline_memcmp(text.data(), same.data(), size));                             \
+        });                                                                                          \
+        cstl = bench_ns([&] {                                                                        \
+            bench_keep(CSTL_##prefix##string_compare_nn(text.data(), size, same.data(), size));      \
+        });                                                                                          \
+        bench_report(label " compare_nn", size * sizeof(CharT), base, cstl);                         \
+                                                                                                     \
+        base = bench_ns([&] {                                                                        \
+            size_t count = baseline_len(text.c_str());                                               \
+            bench_keep(CSTL_##prefix##string_assign_n(&str, text.c_str(), count, nullptr));          \
+        });                                                                                          \
+        cstl = bench_ns([&] {                                                                        \
+            bench_keep(CSTL_##prefix##string_assign(&str, text.c_str(), nullptr));                   \
+        });                                                                                          \
+        bench_report(label " assign (len+copy)", size * sizeof(CharT), base, cstl);                  \
+                                                                                                     \
+        base = bench_ns([&] {                                                                        \
+            baseline_set(out.data(), CharT('b'), size);                                              \
+            bench_keep(out[0]);                                                                      \
+        });                                                                                          \
+        cstl = bench_ns([&] {                                                                        \
+            bench_keep(CSTL_##prefix##string_assign_char(&str, size, CharT('b'), nullptr));          \
+        });                                                                                          \
+        bench_report(label " assign_char", size * sizeof(CharT), base, cstl);                        \
+                                                                                                     \
+        CSTL_##prefix##string_destroy(&str, nullptr);                                                \
+    }
+
+BENCH_WIDTH(char, , , "string")
+BENCH_WIDTH(char16_t, u16, UTF16, "u16string")
+BENCH_WIDTH(char32_t, u32, UTF32, "u32string")
+
+// Searches a large payload for a marker placed at its end.
+static void bench_find_string(size_t size, size_t needle_size) {
+    std::string text(size, 'a');
+    std::string needle(needle_size, 'a');
+    needle.back() = 'b';
+
+    // Low entropy text over "abcd", a worst case for the first character scan:
+    uint32_t state = 12345;
+    for (char& ch : text) {
+        state = state * 1103515245u + 12345u;
+        ch = static_cast<char>('a' + (state >> 16) % 4);
+    }
+    text.replace(size - needle_size, needle_size, needle);
+
+    CSTL_StringVal str;
+    CSTL_string_construct(&str);
+    CSTL_string_assign_n(&str, text.data(), text.size(), nullptr);
+
+    double base = bench_ns([&] {
+        bench_keep(baseline_find_str(text.data(), size, needle.data(), needle_size));
+    });
+    double cstl = bench_ns([&] {
+        bench_keep(CSTL_string_find_n(&str, needle.data(), 0, needle_size));
+    });
+    bench_report(needle_size < 64 ? "string find_n (random, short)" : "string find_n (random, long)", size, base, cstl);
+
+    // Repetitive text, every position matches a prefix of the needle:
+    std::string repeated(size - needle_size, 'a');
+    repeated += needle;
+    CSTL_string_assign_n(&str, repeated.data(), repeated.size(), nullptr);
+
+    base = bench_ns([&] {
+        bench_keep(baseline_find_str(repeated.data(), size, needle.data(), needle_size));
+    });
+    cstl = bench_ns([&] {
+        bench_keep(CSTL_string_find_n(&str, needle.data(), 0, needle_size));
+    });
+    bench_report(needle_size < 64 ? "string find_n (periodic, short)" : "string find_n (periodic, long)", size, base, cstl);
+
+    CSTL_string_destroy(&str, nullptr);
+}
+
+// Runs one long needle against many short haystacks, where per call setup dominates.
+static void bench_searcher(size_t hay_size, size_t needle_size) {
+    const size_t hay_count = 64;
+
+    std::vector<std::string> texts(hay_count);
+    uint32_t state = 54321;
+    for (std::string& text : texts) {
+        text.resize(hay_size);
+        for (char& ch : text) {
+            state = state * 1103515245u + 12345u;
+            ch = static_cast<char>('a' + (state >> 16) % 4);
+        }
+    }
+
+    std::vector<CSTL_StringVal> strs(hay_count);
+    for (size_t i = 0; i < hay_count; ++i) {
+        CSTL_string_construct(&strs[i]);
+        CSTL_string_assign_n(&strs[i], texts[i].data(), texts[i].size(), nullptr);
+    }
+
+    // Takes the tail of one text, which does not occur in the others:
+    std::string needle = texts[0].substr(hay_size - needle_size);
+
+    CSTL_StringSearcher searcher;
+    CSTL_string_searcher_init(&searcher, needle.data(), needle.size());
+
+    double base = bench_ns([&] {
+        for (const CSTL_StringVal& str : strs) {
+            bench_keep(CSTL_string_find_n(&str, needle.data(), 0, needle.size()));
+        }
+    });
+    double cstl = bench_ns([&] {
+        for (const CSTL_StringVal& str : strs) {
+            bench_keep(CSTL_string_searcher_find(&searcher, &str, 0));
+        }
+    });
+    bench_report("string searcher vs find_n (x64)", hay_size * hay_count, base, cstl);
+
+    for (CSTL_StringVal& str : strs) {
+        CSTL_string_destroy(&str, nullptr);
+    }
+}
+
+// Splits text on a delimiter set, the baseline emulates the set with one `find_char` per delimiter.
+static void bench_find_first_of(size_t size, const char* delims) {
+    std::string text;
+    uint32_t state = 777;
+    while (text.size() < size) {
+        state = state * 1103515245u + 12345u;
+        text.append((state >> 16) % 12 + 1, 'w');
+        text.push_back(delims[(state >> 8) % std::char_traits<char>::length(delims)]);
+    }
+    text.resize(size);
+
+    CSTL_StringVal str;
+    CSTL_string_construct(&str);
+    CSTL_string_assign_n(&str, text.data(), text.size(), nullptr);
+
+    size_t delim_count = std::char_traits<char>::length(delims);
+
+    double base = bench_ns([&] {
+        size_t tokens = 0;
+        for (size_t pos = 0;; ++tokens) {
+            size_t next = static_cast<size_t>(-1);
+            for (size_t i = 0; i < delim_count; ++i) {
+                size_t found = CSTL_string_find_char(&str, delims[i], pos);
+                next = found < next ? found : next;
+            }
+            if (next == static_cast<size_t>(-1)) {
+                break;
+            }
+            pos = next + 1;
+        }
+        bench_keep(tokens);
+    });
+    double cstl = bench_ns([&] {
+        size_t tokens = 0;
+        for (size_t pos = 0;; ++tokens) {
+            size_t next = CSTL_string_find_first_of_n(&str, delims, pos, delim_count);
+            if (next == static_cast<size_t>(-1)) {
+                break;
+            }
+            pos = next + 1;
+        }
+        bench_keep(tokens);
+    });
+    bench_report(delim_count <= 4 ? "string find_first_of (small set)" : "string find_first_of (bitmap)", size, base, cstl);
+
+    CSTL_string_destroy(&str, nullptr);
+}
+
+// Hashes a string of `size` bytes, the baseline is the `std::hash` compatible FNV-1a.
+static void bench_hash(size_t size) {
+    std::string text(size, '\0');
+    for (size_t i = 0; i < size; ++i) {
+        text[i] = static_cast<char>(i * 131 + 7);
+    }
+
+    double base = bench_ns([&] { bench_keep(CSTL_string_hash_n(text.data(), text.size())); });
+    double cstl = bench_ns([&] { bench_keep(CSTL_string_fast_hash_n(text.data(), text.size())); });
+    bench_report("string fast_hash vs hash", size, base, cstl);
+}
+
+static void bench_split(size_t size) {
+    std::string text;
+    uint32_t state = 4242;
+    while (text.size() < size) {
+        state = state * 1103515245u + 12345u;
+        text.append((state >> 16) % 24 + 1, 'f');
+        text.push_back(',');
+    }
+    text.resize(size);
+
+    CSTL_StringVal str;
+    CSTL_string_construct(&str);
+    CSTL_string_assign_n(&str, text.data(), text.size(), nullptr);
+
+    double base = bench_ns([&] {
+        size_t total = 0;
+        CSTL_StringVal field;
+        CSTL_string_construct(&field);
+        for (size_t pos = 0;;) {
+            size_t next = CSTL_string_find_char(&str, ',', pos);
+            size_t count = next == static_cast<size_t>(-1) ? static_cast<size_t>(-1) : next - pos;
+            CSTL_string_assign_substr(&field, &str, pos, count, nullptr);
+            total += CSTL_string_size(&field);
+            if (next == static_cast<size_t>(-1)) {
+                break;
+            }
+            pos = next + 1;
+        }
+        CSTL_string_destroy(&field, nullptr);
+        bench_keep(total);
+    });
+    double cstl = bench_ns([&] {
+        size_t total = 0;
+        CSTL_StringSplit split;
+        CSTL_StringView field;
+        CSTL_string_split_init(&split, CSTL_string_as_view(&str), ',', false);
+        while (CSTL_string_split_next(&split, &field)) {
+            total += field.size;
+        }
+        bench_keep(total);
+    });
+    bench_report("string split vs find + assign_substr", size, base, cstl);
+
+    CSTL_string_destroy(&str, nullptr);
+}
+
+int main() {
+    for (size_t size : {16, 256, 4096, 65536}) {
+        bench_string(size);
+        bench_u16string(size);
+        bench_u32string(size);
+    }
+
+    for (size_t size : {65536, 4 << 20}) {
+        bench_find_string(size, 40);
+        bench_find_string(size, 200);
+    }
+
+    for (size_t size : {512, 4096}) {
+        bench_searcher(size, 200);
+    }
+
+    for (size_t size : {4096, 65536}) {
+        bench_find_first_of(size, " ,;");
+        bench_find_first_of(size, " ,;:.!?\t\n\"'()");
+    }
+
+    for (size_t size : {8, 32, 200, 4096, 65536}) {
+        bench_hash(size);
+    }
+
+    for (size_t size : {4096, 65536}) {
+        bench_split(size);
+    }
+
+    return 0;
+}
@@ -0,0 +1,179 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "bench.h"
+
+#include "unicode.h"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_NOINLINE __declspec(noinline)
+#endif
+
+// Reference transcoders, one code point per iteration. Assume well-formed input.
+BENCH_NOINLINE size_t baseline_utf8_to_utf16(const char8_t* first, size_t count, char16_t* dest) {
+    size_t j = 0;
+
+    for (size_t i = 0; i < count;) {
+        uint32_t lead = first[i];
+        uint32_t cp;
+
+        if (lead < 0x80) {
+            cp = lead;
+            i += 1;
+        } else if (lead < 0xE0) {
+            cp = (lead & 0x1F) << 6 | (first[i + 1] & 0x3F);
+            i += 2;
+        } else if (lead < 0xF0) {
+            cp = (lead & 0x0F) << 12 | (first[i + 1] & 0x3F) << 6 | (first[i + 2] & 0x3F);
+            i += 3;
+        } else {
+            cp = (lead & 0x07) << 18 | (first[i + 1] & 0x3F) << 12 | (first[i + 2] & 0x3F) << 6 | (first[i + 3] & 0x3F);
+            i += 4;
+        }
+
+        if (cp < 0x10000) {
+            dest[j++] = (char16_t)cp;
+        } else {
+            dest[j++] = (char16_t)(0xD800 + ((cp - 0x10000) >> 10));
+            dest[j++] = (char16_t)(0xDC00 + (cp & 0x3FF));
+        }
+    }
+
+    return j;
+}
+
+BENCH_NOINLINE size_t baseline_utf16_to_utf8(const char16_t* first, size_t count, char8_t* dest) {
+    size_t j = 0;
+
+    for (size_t i = 0; i < count;) {
+        uint32_t cp = first[i++];
+
+        if (cp - 0xD800 < 0x400) {
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (first[i++] - 0xDC00);
+        }
+
+        if (cp < 0x80) {
+            dest[j++] = (char8_t)cp;
+        } else if (cp < 0x800) {
+            dest[j++] = (char8_t)(0xC0 | cp >> 6);
+            dest[j++] = (char8_t)(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            dest[j++] = (char8_t)(0xE0 | cp >> 12);
+            dest[j++] = (char8_t)(0x80 | (cp >> 6 & 0x3F));
+            dest[j++] = (char8_t)(0x80 | (cp & 0x3F));
+        } else {
+            dest[j++] = (char8_t)(0xF0 | cp >> 18);
+            dest[j++] = (char8_t)(0x80 | (cp >> 12 & 0x3F));
+            dest[j++] = (char8_t)(0x80 | (cp >> 6 & 0x3F));
+            dest[j++] = (char8_t)(0x80 | (cp & 0x3F));
+        }
+    }
+
+    return j;
+}
+
+// Reference validator, one code point per iteration.
+BENCH_NOINLINE bool baseline_utf8_validate(const char8_t* first, size_t count) {
+    for (size_t i = 0; i < count;) {
+        uint32_t lead = first[i];
+
+        if (lead < 0x80) {
+            i += 1;
+            continue;
+        }
+
+        size_t length = lead < 0xC2 ? 0 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : lead < 0xF5 ? 4 : 0;
+
+        if (length == 0 || count - i < length) {
+            return false;
+        }
+
+        uint32_t cp = lead & (0x7F >> length);
+
+        for (size_t k = 1; k < length; ++k) {
+            if ((first[i + k] & 0xC0) != 0x80) {
+                return false;
+            }
+
+            cp = cp << 6 | (first[i + k] & 0x3F);
+        }
+
+        if (cp < (length == 2 ? 0x80u : length == 3 ? 0x800u : 0x10000u) || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
+            return false;
+        }
+
+        i += length;
+    }
+
+    return true;
+}
+
+// Repeats `unit` up to `size` UTF-16 code units.
+static std::u16string make_text(const char16_t* unit, size_t size) {
+    std::u16string result;
+
+    while (result.size() < size) {
+        result += unit;
+    }
+
+    return result;
+}
+
+// Converts `text` to UTF-8 and back through string assigns, which measure the output first.
+static void bench_text(const char* name, const std::u16string& text) {
+    std::u8string utf8(text.size() * 3, u8'\0');
+    std::u16string utf16(text.size(), u'\0');
+
+    CSTL_UTF8StringVal str8;
+    CSTL_UTF16StringVal str16;
+
+    CSTL_u8string_construct(&str8);
+    CSTL_u16string_construct(&str16);
+
+    size_t utf8_size = CSTL_utf16_to_utf8(text.data(), text.size(), utf8.data()).written;
+
+    double base = bench_ns([&] {
+        bench_keep(baseline_utf8_to_utf16(utf8.data(), utf8_size, utf16.data()));
+    });
+
+    double cstl = bench_ns([&] {
+        bench_keep(CSTL_u16string_assign_utf8(&str16, utf8.data(), utf8_size, nullptr, nullptr));
+    });
+
+    bench_report((std::string(name) + " utf8->utf16").c_str(), utf8_size, base, cstl);
+
+    base = bench_ns([&] {
+        bench_keep(baseline_utf16_to_utf8(text.data(), text.size(), utf8.data()));
+    });
+
+    cstl = bench_ns([&] {
+        bench_keep(CSTL_u8string_assign_utf16(&str8, text.data(), text.size(), nullptr, nullptr));
+    });
+
+    bench_report((std::string(name) + " utf16->utf8").c_str(), text.size() * sizeof(char16_t), base, cstl);
+
+    base = bench_ns([&] {
+        bench_keep(baseline_utf8_validate(utf8.data(), utf8_size));
+    });
+
+    cstl = bench_ns([&] {
+        bench_keep(CSTL_utf8_validate(utf8.data(), utf8_size));
+    });
+
+    bench_report((std::string(name) + " utf8 validate").c_str(), utf8_size, base, cstl);
+
+    CSTL_u8string_destroy(&str8, nullptr);
+    CSTL_u16string_destroy(&str16, nullptr);
+}
+
+int main() {
+    const size_t size = 1 << 16;
+
+    bench_text("ascii", make_text(u"The quick brown fox jumps over the lazy dog. ", size));
+    bench_text("latin", make_text(u"Größere Käfer fraßen süße Äpfel, déjà vu. ", size));
+    bench_text("cjk", make_text(u"速い茶色の狐がのろまな犬を飛び越える。", size));
+    return 0;
+}
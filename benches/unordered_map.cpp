@@ -0,0 +1,101 @@
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+
+#include "alloc.h"
+#include "type.h"
+#include "unordered_map.h"
+
+struct Entry {
+    uint64_t key;
+    uint64_t value;
+};
+
+static bool key_eq(const void* lhs, const void* rhs) {
+    return *static_cast<const uint64_t*>(lhs) == *static_cast<const uint64_t*>(rhs);
+}
+
+static size_t key_hash(const void* key) {
+    uint64_t x = *static_cast<const uint64_t*>(key);
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDull;
+    x ^= x >> 33;
+    return (size_t)x;
+}
+
+static const CSTL_HashType hash = { &key_eq, &key_hash };
+
+static void fill_map(CSTL_UnorderedMapVal* map, CSTL_PodType pod, size_t size, bool reserve) {
+    CSTL_hash_construct(map, pod.type, nullptr);
+
+    if (reserve) {
+        CSTL_hash_reserve(map, pod.type, &hash, size, nullptr);
+    }
+
+    for (uint64_t i = 0; i < size; ++i) {
+        Entry entry{i * 0x9E3779B97F4A7C15ull, i};
+        CSTL_hash_copy_insert(map, pod.type, &hash, &pod.copy, &entry, nullptr, nullptr);
+    }
+}
+
+static void bench_map(size_t size) {
+    CSTL_PodType pod = CSTL_pod_type(sizeof(Entry), alignof(Entry));
+
+    double insert_ns = bench_ns([&] {
+        CSTL_UnorderedMapVal map;
+        fill_map(&map, pod, size, false);
+        bench_keep(map.size);
+        CSTL_hash_destroy(&map, pod.type, &pod.copy.move_type.drop_type, nullptr);
+    }, 100);
+
+    double reserved_ns = bench_ns([&] {
+        CSTL_UnorderedMapVal map;
+        fill_map(&map, pod, size, true);
+        bench_keep(map.size);
+        CSTL_hash_destroy(&map, pod.type, &pod.copy.move_type.drop_type, nullptr);
+    }, 100);
+
+    bench_report("hash insert, reserve", size * sizeof(Entry), insert_ns, reserved_ns);
+
+    CSTL_UnorderedMapVal map;
+    fill_map(&map, pod, size, false);
+
+    constexpr size_t lookups = 4096;
+
+    std::mt19937_64 rng{1};
+    std::vector<uint64_t> keys(lookups);
+    std::vector<const void*> key_ptrs(lookups);
+    std::vector<void*> elements(lookups);
+
+    for (size_t i = 0; i < lookups; ++i) {
+        keys[i]     = (rng() % size) * 0x9E3779B97F4A7C15ull;
+        key_ptrs[i] = &keys[i];
+    }
+
+    double find_ns = bench_ns([&] {
+        for (size_t i = 0; i < lookups; ++i) {
+            CSTL_HashIter where = CSTL_hash_find(&map, pod.type, &hash, key_ptrs[i]);
+            bench_keep(where.node);
+        }
+    });
+
+    double find_n_ns = bench_ns([&] {
+        CSTL_hash_find_n(&map, pod.type, &hash, key_ptrs.data(), lookups, elements.data());
+        bench_keep(elements[0]);
+    });
+
+    bench_report("hash find, find_n", size * sizeof(Entry), find_ns / lookups, find_n_ns / lookups);
+
+    CSTL_hash_destroy(&map, pod.type, &pod.copy.move_type.drop_type, nullptr);
+}
+
+int main() {
+    for (size_t size : {1000, 100000, 2000000}) {
+        bench_map(size);
+    }
+
+    return 0;
+}
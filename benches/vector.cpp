@@ -0,0 +1,78 @@
+#include <cstddef>
+#include <cstdint>
+
+#include "bench.h"
+
+#include "alloc.h"
+#include "type.h"
+#include "vector.h"
+
+// Element-wise table for a POD type, as written before trivial traits existed.
+namespace baseline {
+    void drop(void*, void*) {}
+
+    void move(void* first, void* last, void* dest) {
+        auto src = static_cast<uint64_t*>(first);
+        auto dst = static_cast<uint64_t*>(dest);
+
+        while (src != last) {
+            *(dst++) = *(src++);
+        }
+    }
+
+    void copy(const void* first, const void* last, void* dest) {
+        auto src = static_cast<const uint64_t*>(first);
+        auto dst = static_cast<uint64_t*>(dest);
+
+        while (src != last) {
+            *(dst++) = *(src++);
+        }
+    }
+
+    void fill(void* first, void* last, const void* value) {
+        auto dst = static_cast<uint64_t*>(first);
+
+        while (dst != last) {
+            *(dst++) = *static_cast<const uint64_t*>(value);
+        }
+    }
+}
+
+static double bench_erase_insert(const CSTL_CopyType* copy, size_t size) {
+    CSTL_Type type = CSTL_define_type(sizeof(uint64_t), alignof(uint64_t));
+    CSTL_VectorVal vec;
+
+    CSTL_vector_construct(&vec);
+
+    uint64_t value = 0x5EED;
+    CSTL_vector_assign_n(&vec, type, copy, size, &value, nullptr);
+
+    double ns = bench_ns([&] {
+        CSTL_VectorIter mid = CSTL_vector_iterator_add(CSTL_vector_begin(&vec, type), (ptrdiff_t)size / 2);
+        mid = CSTL_vector_erase(&vec, &copy->move_type, mid);
+        CSTL_vector_copy_insert(&vec, copy, mid, &value, nullptr);
+        bench_keep(vec.last);
+    });
+
+    CSTL_vector_destroy(&vec, type, &copy->move_type.drop_type, nullptr);
+
+    return ns;
+}
+
+static void bench_vector(size_t size) {
+    const CSTL_CopyType element_wise = {
+        { { &baseline::drop }, &baseline::move, false }, &baseline::copy, &baseline::fill
+    };
+    const CSTL_CopyType trivial = CSTL_pod_uint64.copy;
+
+    bench_report("vector erase+insert mid", size * sizeof(uint64_t),
+        bench_erase_insert(&element_wise, size), bench_erase_insert(&trivial, size));
+}
+
+int main() {
+    for (size_t size : {4096, 65536, 10000000}) {
+        bench_vector(size);
+    }
+
+    return 0;
+}
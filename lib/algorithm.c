@@ -0,0 +1,904 @@
+#include "algorithm.h"
+
+#include "internal/alloc_dispatch.h"
+#include "internal/type_ext.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Ranges at most this long are insertion sorted.
+#define CSTL_sort_insertion_limit ((size_t)16)
+
+// Vectors shorter than this are sorted with comparisons even with a radix table.
+#define CSTL_sort_radix_min ((size_t)256)
+
+// How radix keys map to unsigned integers of the same order.
+#define CSTL_radix_unsigned 0
+#define CSTL_radix_signed   1
+#define CSTL_radix_float    2
+
+typedef struct CSTL_SortState {
+    char* first;
+    size_t size;
+    CSTL_MoveTypeCRef move;
+    CSTL_IsLt is_lt;
+    void* tmp; // storage for one object
+    bool relocatable;
+} CSTL_SortState;
+
+typedef struct CSTL_RadixTable {
+    const CSTL_CompType* comp;
+    size_t width;
+    int kind;
+} CSTL_RadixTable;
+
+static const CSTL_RadixTable CSTL_radix_tables[] = {
+    { &CSTL_comp_int8,    sizeof(int8_t),    CSTL_radix_signed },
+    { &CSTL_comp_uint8,   sizeof(uint8_t),   CSTL_radix_unsigned },
+    { &CSTL_comp_int16,   sizeof(int16_t),   CSTL_radix_signed },
+    { &CSTL_comp_uint16,  sizeof(uint16_t),  CSTL_radix_unsigned },
+    { &CSTL_comp_int32,   sizeof(int32_t),   CSTL_radix_signed },
+    { &CSTL_comp_uint32,  sizeof(uint32_t),  CSTL_radix_unsigned },
+    { &CSTL_comp_int64,   sizeof(int64_t),   CSTL_radix_signed },
+    { &CSTL_comp_uint64,  sizeof(uint64_t),  CSTL_radix_unsigned },
+    { &CSTL_comp_float,   sizeof(float),     CSTL_radix_float },
+    { &CSTL_comp_double,  sizeof(double),    CSTL_radix_float },
+    { &CSTL_comp_pointer, sizeof(uintptr_t), CSTL_radix_unsigned },
+};
+
+static inline void* CSTL_sort_at(const CSTL_SortState* state, size_t pos) {
+    return state->first + pos * state->size;
+}
+
+static inline bool CSTL_sort_lt(const CSTL_SortState* state, size_t lhs, size_t rhs) {
+    return state->is_lt(CSTL_sort_at(state, lhs), CSTL_sort_at(state, rhs));
+}
+
+// Relocates `count` objects at `src` to uninitialized memory at `dest`.
+static inline void CSTL_sort_relocate(const CSTL_SortState* state, void* src, size_t count, void* dest) {
+    CSTL_type_relocate(state->move, src, (char*)src + count * state->size, dest);
+}
+
+// Relocates one object to a distinct location, with a fixed size copy for common sizes.
+static inline void CSTL_sort_relocate_one(const CSTL_SortState* state, void* src, void* dest) {
+    if (!state->relocatable) {
+        CSTL_sort_relocate(state, src, 1, dest);
+        return;
+    }
+
+    switch (state->size) {
+    case 4:  memcpy(dest, src, 4); break;
+    case 8:  memcpy(dest, src, 8); break;
+    case 16: memcpy(dest, src, 16); break;
+    default: memcpy(dest, src, state->size); break;
+    }
+}
+
+static inline void CSTL_sort_swap(const CSTL_SortState* state, size_t lhs, size_t rhs) {
+    void* left  = CSTL_sort_at(state, lhs);
+    void* right = CSTL_sort_at(state, rhs);
+
+    CSTL_sort_relocate_one(state, left, state->tmp);
+    CSTL_sort_relocate_one(state, right, left);
+    CSTL_sort_relocate_one(state, state->tmp, right);
+}
+
+// Stable, shifts each element left into place through a hole.
+static void CSTL_sort_insertion(const CSTL_SortState* state, size_t first, size_t last) {
+    for (size_t i = first + 1; i < last; ++i) {
+        if (!CSTL_sort_lt(state, i, i - 1)) {
+            continue;
+        }
+
+        size_t hole = i;
+        CSTL_sort_relocate_one(state, CSTL_sort_at(state, i), state->tmp);
+
+        do {
+            CSTL_sort_relocate_one(state, CSTL_sort_at(state, hole - 1), CSTL_sort_at(state, hole));
+            --hole;
+        } while (hole > first && state->is_lt(state->tmp, CSTL_sort_at(state, hole - 1)));
+
+        CSTL_sort_relocate_one(state, state->tmp, CSTL_sort_at(state, hole));
+    }
+}
+
+// Sifts the element at `root` down a max-heap of `count` elements starting at `base`.
+static void CSTL_sort_sift_down(const CSTL_SortState* state, size_t base, size_t count, size_t root) {
+    for (;;) {
+        size_t child = 2 * root + 1;
+
+        if (child >= count) {
+            return;
+        }
+
+        if (child + 1 < count && CSTL_sort_lt(state, base + child, base + child + 1)) {
+            ++child;
+        }
+
+        if (!CSTL_sort_lt(state, base + root, base + child)) {
+            return;
+        }
+
+        CSTL_sort_swap(state, base + root, base + child);
+        root = child;
+    }
+}
+
+static void CSTL_sort_make_heap(const CSTL_SortState* state, size_t base, size_t count) {
+    for (size_t root = count / 2; root-- > 0;) {
+        CSTL_sort_sift_down(state, base, count, root);
+    }
+}
+
+static void CSTL_sort_sort_heap(const CSTL_SortState* state, size_t base, size_t count) {
+    for (size_t end = count; end > 1; --end) {
+        CSTL_sort_swap(state, base, base + end - 1);
+        CSTL_sort_sift_down(state, base, end - 1, 0);
+    }
+}
+
+// Partitions `[first, last)` around the median of its first, middle and last elements
+// and returns the final position of the pivot. Elements equivalent to the pivot
+// stop both scans, so runs of equal elements are split evenly.
+static size_t CSTL_sort_partition(const CSTL_SortState* state, size_t first, size_t last) {
+    size_t mid = first + (last - first) / 2;
+
+    if (CSTL_sort_lt(state, mid, first)) {
+        CSTL_sort_swap(state, mid, first);
+    }
+
+    if (CSTL_sort_lt(state, last - 1, mid)) {
+        CSTL_sort_swap(state, last - 1, mid);
+
+        if (CSTL_sort_lt(state, mid, first)) {
+            CSTL_sort_swap(state, mid, first);
+        }
+    }
+
+    CSTL_sort_swap(state, first, mid);
+
+    size_t lo = first + 1;
+    size_t hi = last - 1;
+
+    for (;;) {
+        while (lo <= hi && CSTL_sort_lt(state, lo, first)) {
+            ++lo;
+        }
+
+        while (lo <= hi && CSTL_sort_lt(state, first, hi)) {
+            --hi;
+        }
+
+        if (lo >= hi) {
+            break;
+        }
+
+        CSTL_sort_swap(state, lo, hi);
+        ++lo;
+        --hi;
+    }
+
+    CSTL_sort_swap(state, first, hi);
+    return hi;
+}
+
+// Introsort: quicksort that falls back to heapsort when it recurses too deep.
+static void CSTL_sort_intro(const CSTL_SortState* state, size_t first, size_t last, size_t depth) {
+    while (last - first > CSTL_sort_insertion_limit) {
+        if (depth == 0) {
+            CSTL_sort_make_heap(state, first, last - first);
+            CSTL_sort_sort_heap(state, first, last - first);
+            return;
+        }
+
+        --depth;
+
+        size_t pivot = CSTL_sort_partition(state, first, last);
+
+        // Recurse into the smaller side to bound the stack depth.
+        if (pivot - first < last - pivot - 1) {
+            CSTL_sort_intro(state, first, pivot, depth);
+            first = pivot + 1;
+        } else {
+            CSTL_sort_intro(state, pivot + 1, last, depth);
+            last = pivot;
+        }
+    }
+
+    CSTL_sort_insertion(state, first, last);
+}
+
+static inline size_t CSTL_sort_depth_limit(size_t count) {
+    size_t depth = 0;
+
+    for (; count > 1; count >>= 1) {
+        depth += 2;
+    }
+
+    return depth;
+}
+
+// Merges the sorted runs `[first, mid)` and `[mid, last)`, moving the shorter one to `buffer`.
+static void CSTL_sort_merge(const CSTL_SortState* state, size_t first, size_t mid, size_t last, char* buffer) {
+    size_t type_size = state->size;
+
+    if (!CSTL_sort_lt(state, mid, mid - 1)) {
+        return; // already in order
+    }
+
+    if (mid - first <= last - mid) {
+        size_t count = mid - first;
+        size_t taken = 0;
+        size_t right = mid;
+        size_t dest  = first;
+
+        CSTL_sort_relocate(state, CSTL_sort_at(state, first), count, buffer);
+
+        while (taken < count && right < last) {
+            char* left = buffer + taken * type_size;
+
+            if (state->is_lt(CSTL_sort_at(state, right), left)) {
+                CSTL_sort_relocate_one(state, CSTL_sort_at(state, right++), CSTL_sort_at(state, dest++));
+            } else {
+                CSTL_sort_relocate_one(state, left, CSTL_sort_at(state, dest++));
+                ++taken;
+            }
+        }
+
+        CSTL_sort_relocate(state, buffer + taken * type_size, count - taken, CSTL_sort_at(state, dest));
+    } else {
+        size_t count = last - mid;
+        size_t left  = mid;
+        size_t dest  = last;
+
+        CSTL_sort_relocate(state, CSTL_sort_at(state, mid), count, buffer);
+
+        // Merge from the back, equivalent elements of the right run go last.
+        while (count > 0 && left > first) {
+            char* right = buffer + (count - 1) * type_size;
+
+            if (state->is_lt(right, CSTL_sort_at(state, left - 1))) {
+                CSTL_sort_relocate_one(state, CSTL_sort_at(state, --left), CSTL_sort_at(state, --dest));
+            } else {
+                CSTL_sort_relocate_one(state, right, CSTL_sort_at(state, --dest));
+                --count;
+            }
+        }
+
+        CSTL_sort_relocate(state, buffer, count, CSTL_sort_at(state, first));
+    }
+}
+
+// Bottom-up merge sort over insertion sorted runs.
+static void CSTL_sort_merge_sort(const CSTL_SortState* state, size_t count, char* buffer) {
+    for (size_t first = 0; first < count; first += CSTL_sort_insertion_limit) {
+        size_t last = count - first < CSTL_sort_insertion_limit ? count : first + CSTL_sort_insertion_limit;
+        CSTL_sort_insertion(state, first, last);
+    }
+
+    for (size_t width = CSTL_sort_insertion_limit; width < count; width *= 2) {
+        for (size_t first = 0; first < count && count - first > width; first += 2 * width) {
+            size_t mid  = first + width;
+            size_t last = count - mid < width ? count : mid + width;
+            CSTL_sort_merge(state, first, mid, last, buffer);
+        }
+    }
+}
+
+// Keys are accessed with `memcpy`, the elements may be floats or signed integers.
+static inline uint64_t CSTL_radix_load(const unsigned char* ptr, size_t width) {
+    uint16_t key2;
+    uint32_t key4;
+    uint64_t key8;
+
+    switch (width) {
+    case 1:  return *ptr;
+    case 2:  memcpy(&key2, ptr, sizeof(key2)); return key2;
+    case 4:  memcpy(&key4, ptr, sizeof(key4)); return key4;
+    default: memcpy(&key8, ptr, sizeof(key8)); return key8;
+    }
+}
+
+static inline void CSTL_radix_store(unsigned char* ptr, uint64_t key, size_t width) {
+    uint16_t key2 = (uint16_t)key;
+    uint32_t key4 = (uint32_t)key;
+
+    switch (width) {
+    case 1:  *ptr = (uint8_t)key; break;
+    case 2:  memcpy(ptr, &key2, sizeof(key2)); break;
+    case 4:  memcpy(ptr, &key4, sizeof(key4)); break;
+    default: memcpy(ptr, &key, sizeof(key)); break;
+    }
+}
+
+// Maps keys to unsigned integers of the same order in place, or back if `decode`.
+// Negative floats are inverted, other keys get their sign bit flipped.
+static inline void CSTL_radix_transform(unsigned char* first, size_t count, size_t width, int kind, bool decode) {
+    if (kind == CSTL_radix_unsigned) {
+        return;
+    }
+
+    uint64_t sign = (uint64_t)1 << (width * 8 - 1);
+    uint64_t mask = sign | (sign - 1);
+
+    for (size_t i = 0; i < count; ++i) {
+        unsigned char* ptr = first + i * width;
+        uint64_t key       = CSTL_radix_load(ptr, width);
+
+        if (kind == CSTL_radix_float && ((key & sign) != 0) != decode) {
+            key = ~key & mask;
+        } else {
+            key ^= sign;
+        }
+
+        CSTL_radix_store(ptr, key, width);
+    }
+}
+
+// Stable LSD radix sort of unsigned integers, one byte per pass.
+// Passes where every key has the same digit are skipped.
+static inline void CSTL_radix_sort(unsigned char* first, unsigned char* buffer, size_t count, size_t width) {
+    size_t counts[8][256];
+    memset(counts, 0, sizeof(counts));
+
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t key = CSTL_radix_load(first + i * width, width);
+
+        for (size_t digit = 0; digit < width; ++digit) {
+            ++counts[digit][(key >> (digit * 8)) & 0xFF];
+        }
+    }
+
+    unsigned char* src = first;
+    unsigned char* dst = buffer;
+
+    for (size_t digit = 0; digit < width; ++digit) {
+        size_t* bucket = counts[digit];
+        size_t offset  = 0;
+
+        if (bucket[(CSTL_radix_load(src, width) >> (digit * 8)) & 0xFF] == count) {
+            continue;
+        }
+
+        for (size_t i = 0; i < 256; ++i) {
+            size_t bucket_count = bucket[i];
+            bucket[i] = offset;
+            offset   += bucket_count;
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t key = CSTL_radix_load(src + i * width, width);
+            CSTL_radix_store(dst + bucket[(key >> (digit * 8)) & 0xFF]++ * width, key, width);
+        }
+
+        unsigned char* swap = src;
+        src = dst;
+        dst = swap;
+    }
+
+    if (src != first) {
+        memcpy(first, src, count * width);
+    }
+}
+
+static void CSTL_radix_sort_1(unsigned char* first, unsigned char* buffer, size_t count) {
+    CSTL_radix_sort(first, buffer, count, 1);
+}
+
+static void CSTL_radix_sort_2(unsigned char* first, unsigned char* buffer, size_t count) {
+    CSTL_radix_sort(first, buffer, count, 2);
+}
+
+static void CSTL_radix_sort_4(unsigned char* first, unsigned char* buffer, size_t count) {
+    CSTL_radix_sort(first, buffer, count, 4);
+}
+
+static void CSTL_radix_sort_8(unsigned char* first, unsigned char* buffer, size_t count) {
+    CSTL_radix_sort(first, buffer, count, 8);
+}
+
+// Returns the radix table matching `comp` and `type`, or `NULL`.
+static const CSTL_RadixTable* CSTL_radix_find_table(CSTL_Type type, CSTL_CompTypeCRef comp) {
+    size_t table_count = sizeof(CSTL_radix_tables) / sizeof(CSTL_radix_tables[0]);
+
+    for (size_t i = 0; i < table_count; ++i) {
+        const CSTL_RadixTable* table = &CSTL_radix_tables[i];
+
+        if (table->comp == comp && table->width == CSTL_type_size(type)) {
+            return table;
+        }
+    }
+
+    return NULL;
+}
+
+// Radix sorts the vector if `comp` is a built-in ordering, returns `false` if it did not.
+static bool CSTL_radix_try_sort(CSTL_VectorRef instance, CSTL_Type type, CSTL_CompTypeCRef comp, bool allow_float, CSTL_Alloc* alloc) {
+    size_t count                 = CSTL_vector_size(instance, type);
+    const CSTL_RadixTable* table = CSTL_radix_find_table(type, comp);
+
+    // `-0.0` and `0.0` are equivalent, but ordered by their bits.
+    if (table == NULL || (table->kind == CSTL_radix_float && !allow_float)) {
+        return false;
+    }
+
+    size_t width = table->width;
+
+    if (count < CSTL_sort_radix_min) {
+        return false;
+    }
+
+    void* buffer = CSTL_allocate(count * width, width, alloc);
+
+    if (buffer == NULL) {
+        return false;
+    }
+
+    unsigned char* first = (unsigned char*)instance->first;
+
+    CSTL_radix_transform(first, count, width, table->kind, false);
+
+    switch (width) {
+    case 1:  CSTL_radix_sort_1(first, (unsigned char*)buffer, count); break;
+    case 2:  CSTL_radix_sort_2(first, (unsigned char*)buffer, count); break;
+    case 4:  CSTL_radix_sort_4(first, (unsigned char*)buffer, count); break;
+    default: CSTL_radix_sort_8(first, (unsigned char*)buffer, count); break;
+    }
+
+    CSTL_radix_transform(first, count, width, table->kind, true);
+
+    CSTL_free(buffer, count * width, width, alloc);
+    return true;
+}
+
+static inline CSTL_SortState CSTL_sort_state(CSTL_VectorRef instance, CSTL_Type type, CSTL_MoveTypeCRef move, CSTL_CompTypeCRef comp, void* tmp) {
+    CSTL_SortState state = { (char*)instance->first, CSTL_type_size(type), move, comp->is_lt, tmp, CSTL_type_is_relocatable(move) };
+    return state;
+}
+
+bool CSTL_vector_sort(CSTL_VectorRef instance, CSTL_Type type, CSTL_MoveTypeCRef move, CSTL_CompTypeCRef comp, CSTL_Alloc* alloc) {
+    size_t count = CSTL_vector_size(instance, type);
+
+    if (count < 2 || CSTL_radix_try_sort(instance, type, comp, true, alloc)) {
+        return true;
+    }
+
+    CSTL_SmallAllocFrame frame;
+
+    size_t type_size = CSTL_type_size(type);
+    size_t alignment = CSTL_type_alignment(type);
+    uintptr_t cookie = (uintptr_t)&CSTL_vector_sort ^ (uintptr_t)&count;
+    void* tmp        = CSTL_small_alloc(&frame, type_size, alignment, alloc, cookie);
+
+    if (tmp == NULL) {
+        return false;
+    }
+
+    CSTL_SortState state = CSTL_sort_state(instance, type, move, comp, tmp);
+    CSTL_sort_intro(&state, 0, count, CSTL_sort_depth_limit(count));
+
+    CSTL_small_free(&frame, type_size, alignment, alloc, cookie);
+    return true;
+}
+
+bool CSTL_vector_stable_sort(CSTL_VectorRef instance, CSTL_Type type, CSTL_MoveTypeCRef move, CSTL_CompTypeCRef comp, CSTL_Alloc* alloc) {
+    size_t count = CSTL_vector_size(instance, type);
+
+    if (count < 2 || CSTL_radix_try_sort(instance, type, comp, false, alloc)) {
+        return true;
+    }
+
+    CSTL_SmallAllocFrame frame;
+
+    size_t type_size    = CSTL_type_size(type);
+    size_t alignment    = CSTL_type_alignment(type);
+    size_t buffer_bytes = (count / 2) * type_size;
+    uintptr_t cookie    = (uintptr_t)&CSTL_vector_stable_sort ^ (uintptr_t)&count;
+    void* tmp           = CSTL_small_alloc(&frame, type_size, alignment, alloc, cookie);
+    void* buffer        = NULL;
+
+    if (tmp == NULL) {
+        return false;
+    }
+
+    if (count > CSTL_sort_insertion_limit) {
+        buffer = CSTL_allocate(buffer_bytes, alignment, alloc);
+
+        if (buffer == NULL) {
+            CSTL_small_free(&frame, type_size, alignment, alloc, cookie);
+            return false;
+        }
+    }
+
+    CSTL_SortState state = CSTL_sort_state(instance, type, move, comp, tmp);
+    CSTL_sort_merge_sort(&state, count, (char*)buffer);
+
+    if (buffer != NULL) {
+        CSTL_free(buffer, buffer_bytes, alignment, alloc);
+    }
+
+    CSTL_small_free(&frame, type_size, alignment, alloc, cookie);
+    return true;
+}
+
+bool CSTL_vector_partial_sort(CSTL_VectorRef instance, CSTL_Type type, CSTL_MoveTypeCRef move, CSTL_CompTypeCRef comp, size_t middle, CSTL_Alloc* alloc) {
+    size_t count = CSTL_vector_size(instance, type);
+
+    assert(middle <= count);
+
+    if (middle == 0) {
+        return true;
+    }
+
+    CSTL_SmallAllocFrame frame;
+
+    size_t type_size = CSTL_type_size(type);
+    size_t alignment = CSTL_type_alignment(type);
+    uintptr_t cookie = (uintptr_t)&CSTL_vector_partial_sort ^ (uintptr_t)&count;
+    void* tmp        = CSTL_small_alloc(&frame, type_size, alignment, alloc, cookie);
+
+    if (tmp == NULL) {
+        return false;
+    }
+
+    CSTL_SortState state = CSTL_sort_state(instance, type, move, comp, tmp);
+
+    // Keep the `middle` smallest elements in a max-heap, then sort it.
+    CSTL_sort_make_heap(&state, 0, middle);
+
+    for (size_t i = middle; i < count; ++i) {
+        if (CSTL_sort_lt(&state, i, 0)) {
+            CSTL_sort_swap(&state, 0, i);
+            CSTL_sort_sift_down(&state, 0, middle, 0);
+        }
+    }
+
+    CSTL_sort_sort_heap(&state, 0, middle);
+
+    CSTL_small_free(&frame, type_size, alignment, alloc, cookie);
+    return true;
+}
+
+bool CSTL_vector_nth_element(CSTL_VectorRef instance, CSTL_Type type, CSTL_MoveTypeCRef move, CSTL_CompTypeCRef comp, size_t nth, CSTL_Alloc* alloc) {
+    size_t count = CSTL_vector_size(instance, type);
+
+    if (nth >= count) {
+        return true;
+    }
+
+    CSTL_SmallAllocFrame frame;
+
+    size_t type_size = CSTL_type_size(type);
+    size_t alignment = CSTL_type_alignment(type);
+    uintptr_t cookie = (uintptr_t)&CSTL_vector_nth_element ^ (uintptr_t)&count;
+    void* tmp        = CSTL_small_alloc(&frame, type_size, alignment, alloc, cookie);
+
+    if (tmp == NULL) {
+        return false;
+    }
+
+    CSTL_SortState state = CSTL_sort_state(instance, type, move, comp, tmp);
+
+    size_t first = 0;
+    size_t last  = count;
+    size_t depth = CSTL_sort_depth_limit(count);
+
+    // Introselect: quickselect that falls back to heapsort when it recurses too deep.
+    while (last - first > CSTL_sort_insertion_limit) {
+        if (depth == 0) {
+            CSTL_sort_make_heap(&state, first, last - first);
+            CSTL_sort_sort_heap(&state, first, last - first);
+            break;
+        }
+
+        --depth;
+
+        size_t pivot = CSTL_sort_partition(&state, first, last);
+
+        if (pivot == nth) {
+            break;
+        } else if (nth < pivot) {
+            last = pivot;
+        } else {
+            first = pivot + 1;
+        }
+    }
+
+    if (last - first <= CSTL_sort_insertion_limit) {
+        CSTL_sort_insertion(&state, first, last);
+    }
+
+    CSTL_small_free(&frame, type_size, alignment, alloc, cookie);
+    return true;
+}
+
+bool CSTL_vector_is_sorted(CSTL_VectorCRef instance, CSTL_Type type, CSTL_CompTypeCRef comp) {
+    size_t count     = CSTL_vector_size(instance, type);
+    size_t type_size = CSTL_type_size(type);
+
+    const char* first = (const char*)instance->first;
+
+    for (size_t i = 1; i < count; ++i) {
+        if (comp->is_lt(first + i * type_size, first + (i - 1) * type_size)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Returns the number of leading elements of `[first, first + count)` that are less than
+// `key`, or not greater than `key` if `upper`. Branchless: the loop only narrows `base`.
+static inline size_t CSTL_search_partition(const char* first, size_t count, size_t type_size, CSTL_IsLt is_lt, const void* key, bool upper) {
+    if (count == 0) {
+        return 0;
+    }
+
+    const char* base = first;
+
+    while (count > 1) {
+        size_t half     = count / 2;
+        const char* mid = base + half * type_size;
+        bool before     = upper ? !is_lt(key, mid) : is_lt(mid, key);
+
+        base  += (size_t)before * half * type_size;
+        count -= half;
+    }
+
+    bool before = upper ? !is_lt(key, base) : is_lt(base, key);
+    return (size_t)(base - first) / type_size + before;
+}
+
+// Like `CSTL_search_partition`, but probes from the start at exponentially growing
+// distances first, so that short runs are found in few comparisons.
+static inline size_t CSTL_search_gallop(const char* first, size_t count, size_t type_size, CSTL_IsLt is_lt, const void* key, bool upper) {
+    size_t known = 0; // `[0, known)` is before `key`
+    size_t limit = count;
+    size_t step  = 1;
+
+    for (;;) {
+        size_t probe = known + step - 1;
+
+        if (probe >= count) {
+            break;
+        }
+
+        const char* elem = first + probe * type_size;
+        bool before      = upper ? !is_lt(key, elem) : is_lt(elem, key);
+
+        if (!before) {
+            limit = probe;
+            break;
+        }
+
+        known = probe + 1;
+        step *= 2;
+    }
+
+    return known + CSTL_search_partition(first + known * type_size, limit - known, type_size, is_lt, key, upper);
+}
+
+size_t CSTL_vector_lower_bound(CSTL_VectorCRef instance, CSTL_Type type, CSTL_CompTypeCRef comp, const void* key) {
+    return CSTL_search_partition((const char*)instance->first, CSTL_vector_size(instance, type), CSTL_type_size(type), comp->is_lt, key, false);
+}
+
+size_t CSTL_vector_upper_bound(CSTL_VectorCRef instance, CSTL_Type type, CSTL_CompTypeCRef comp, const void* key) {
+    return CSTL_search_partition((const char*)instance->first, CSTL_vector_size(instance, type), CSTL_type_size(type), comp->is_lt, key, true);
+}
+
+CSTL_IndexRange CSTL_vector_equal_range(CSTL_VectorCRef instance, CSTL_Type type, CSTL_CompTypeCRef comp, const void* key) {
+    size_t type_size  = CSTL_type_size(type);
+    size_t count      = CSTL_vector_size(instance, type);
+    const char* first = (const char*)instance->first;
+
+    CSTL_IndexRange range;
+    range.first = CSTL_search_partition(first, count, type_size, comp->is_lt, key, false);
+
+    // Equivalent elements are usually few, gallop over them.
+    range.last = range.first + CSTL_search_gallop(first + range.first * type_size, count - range.first, type_size, comp->is_lt, key, true);
+
+    return range;
+}
+
+bool CSTL_vector_binary_search(CSTL_VectorCRef instance, CSTL_Type type, CSTL_CompTypeCRef comp, const void* key) {
+    size_t type_size = CSTL_type_size(type);
+    size_t pos       = CSTL_vector_lower_bound(instance, type, comp, key);
+
+    return pos != CSTL_vector_size(instance, type) && !comp->is_lt(key, (const char*)instance->first + pos * type_size);
+}
+
+// Sorted range operation state, `lhs` and `rhs` are advanced as elements are consumed.
+typedef struct CSTL_SetOpState {
+    const char* lhs;
+    const char* lhs_last;
+    const char* rhs;
+    const char* rhs_last;
+    size_t type_size;
+    CSTL_IsLt is_lt;
+    CSTL_VectorRef dest;
+    CSTL_CopyTypeCRef copy;
+} CSTL_SetOpState;
+
+static inline size_t CSTL_setop_left(const CSTL_SetOpState* state, const char* first, const char* last) {
+    return (size_t)(last - first) / state->type_size;
+}
+
+// Copies `count` elements at `src` to the reserved end of `dest`.
+static inline void CSTL_setop_append(CSTL_SetOpState* state, const char* src, size_t count) {
+    size_t bytes = count * state->type_size;
+
+    CSTL_type_copy(state->copy, src, src + bytes, state->dest->last);
+    state->dest->last = (char*)state->dest->last + bytes;
+}
+
+// Reserves room for `bound` more elements and sets up the state.
+static bool CSTL_setop_begin(CSTL_SetOpState* state, CSTL_VectorRef dest, CSTL_Type type, CSTL_CopyTypeCRef copy, CSTL_CompTypeCRef comp, CSTL_VectorCRef lhs, CSTL_VectorCRef rhs, size_t bound, CSTL_Alloc* alloc) {
+    assert(dest != lhs && dest != rhs);
+
+    size_t size = CSTL_vector_size(dest, type);
+
+    if (bound > CSTL_vector_max_size(type) - size) {
+        return false;
+    }
+
+    if (!CSTL_vector_reserve(dest, type, &copy->move_type, size + bound, alloc)) {
+        return false;
+    }
+
+    state->lhs       = (const char*)lhs->first;
+    state->lhs_last  = (const char*)lhs->last;
+    state->rhs       = (const char*)rhs->first;
+    state->rhs_last  = (const char*)rhs->last;
+    state->type_size = CSTL_type_size(type);
+    state->is_lt     = comp->is_lt;
+    state->dest      = dest;
+    state->copy      = copy;
+
+    return true;
+}
+
+// Returns the number of leading elements of `[first, last)` before `key`, by galloping.
+static inline size_t CSTL_setop_run(const CSTL_SetOpState* state, const char* first, const char* last, const void* key, bool upper) {
+    return CSTL_search_gallop(first, CSTL_setop_left(state, first, last), state->type_size, state->is_lt, key, upper);
+}
+
+bool CSTL_vector_merge(CSTL_VectorRef dest, CSTL_Type type, CSTL_CopyTypeCRef copy, CSTL_CompTypeCRef comp, CSTL_VectorCRef lhs, CSTL_VectorCRef rhs, CSTL_Alloc* alloc) {
+    size_t lhs_size = CSTL_vector_size(lhs, type);
+    size_t rhs_size = CSTL_vector_size(rhs, type);
+
+    CSTL_SetOpState state;
+
+    if (lhs_size > SIZE_MAX - rhs_size || !CSTL_setop_begin(&state, dest, type, copy, comp, lhs, rhs, lhs_size + rhs_size, alloc)) {
+        return false;
+    }
+
+    while (state.lhs != state.lhs_last && state.rhs != state.rhs_last) {
+        // Elements of `lhs` not greater than the next of `rhs` go first.
+        size_t run = CSTL_setop_run(&state, state.lhs, state.lhs_last, state.rhs, true);
+        CSTL_setop_append(&state, state.lhs, run);
+        state.lhs += run * state.type_size;
+
+        if (state.lhs == state.lhs_last) {
+            break;
+        }
+
+        run = CSTL_setop_run(&state, state.rhs, state.rhs_last, state.lhs, false);
+        CSTL_setop_append(&state, state.rhs, run);
+        state.rhs += run * state.type_size;
+    }
+
+    CSTL_setop_append(&state, state.lhs, CSTL_setop_left(&state, state.lhs, state.lhs_last));
+    CSTL_setop_append(&state, state.rhs, CSTL_setop_left(&state, state.rhs, state.rhs_last));
+
+    return true;
+}
+
+bool CSTL_vector_set_union(CSTL_VectorRef dest, CSTL_Type type, CSTL_CopyTypeCRef copy, CSTL_CompTypeCRef comp, CSTL_VectorCRef lhs, CSTL_VectorCRef rhs, CSTL_Alloc* alloc) {
+    size_t lhs_size = CSTL_vector_size(lhs, type);
+    size_t rhs_size = CSTL_vector_size(rhs, type);
+
+    CSTL_SetOpState state;
+
+    if (lhs_size > SIZE_MAX - rhs_size || !CSTL_setop_begin(&state, dest, type, copy, comp, lhs, rhs, lhs_size + rhs_size, alloc)) {
+        return false;
+    }
+
+    while (state.lhs != state.lhs_last && state.rhs != state.rhs_last) {
+        size_t run = CSTL_setop_run(&state, state.lhs, state.lhs_last, state.rhs, false);
+        CSTL_setop_append(&state, state.lhs, run);
+        state.lhs += run * state.type_size;
+
+        if (state.lhs == state.lhs_last) {
+            break;
+        }
+
+        run = CSTL_setop_run(&state, state.rhs, state.rhs_last, state.lhs, false);
+        CSTL_setop_append(&state, state.rhs, run);
+        state.rhs += run * state.type_size;
+
+        if (state.rhs == state.rhs_last) {
+            break;
+        }
+
+        // `rhs` is not less than `lhs` now, if neither is less keep the one from `lhs`.
+        if (!state.is_lt(state.lhs, state.rhs)) {
+            CSTL_setop_append(&state, state.lhs, 1);
+            state.lhs += state.type_size;
+            state.rhs += state.type_size;
+        }
+    }
+
+    CSTL_setop_append(&state, state.lhs, CSTL_setop_left(&state, state.lhs, state.lhs_last));
+    CSTL_setop_append(&state, state.rhs, CSTL_setop_left(&state, state.rhs, state.rhs_last));
+
+    return true;
+}
+
+bool CSTL_vector_set_intersection(CSTL_VectorRef dest, CSTL_Type type, CSTL_CopyTypeCRef copy, CSTL_CompTypeCRef comp, CSTL_VectorCRef lhs, CSTL_VectorCRef rhs, CSTL_Alloc* alloc) {
+    size_t lhs_size = CSTL_vector_size(lhs, type);
+    size_t rhs_size = CSTL_vector_size(rhs, type);
+
+    CSTL_SetOpState state;
+
+    if (!CSTL_setop_begin(&state, dest, type, copy, comp, lhs, rhs, lhs_size < rhs_size ? lhs_size : rhs_size, alloc)) {
+        return false;
+    }
+
+    while (state.lhs != state.lhs_last && state.rhs != state.rhs_last) {
+        state.lhs += CSTL_setop_run(&state, state.lhs, state.lhs_last, state.rhs, false) * state.type_size;
+
+        if (state.lhs == state.lhs_last) {
+            break;
+        }
+
+        state.rhs += CSTL_setop_run(&state, state.rhs, state.rhs_last, state.lhs, false) * state.type_size;
+
+        if (state.rhs == state.rhs_last) {
+            break;
+        }
+
+        if (!state.is_lt(state.lhs, state.rhs)) {
+            CSTL_setop_append(&state, state.lhs, 1);
+            state.lhs += state.type_size;
+            state.rhs += state.type_size;
+        }
+    }
+
+    return true;
+}
+
+bool CSTL_vector_set_difference(CSTL_VectorRef dest, CSTL_Type type, CSTL_CopyTypeCRef copy, CSTL_CompTypeCRef comp, CSTL_VectorCRef lhs, CSTL_VectorCRef rhs, CSTL_Alloc* alloc) {
+    CSTL_SetOpState state;
+
+    if (!CSTL_setop_begin(&state, dest, type, copy, comp, lhs, rhs, CSTL_vector_size(lhs, type), alloc)) {
+        return false;
+    }
+
+    while (state.lhs != state.lhs_last && state.rhs != state.rhs_last) {
+        size_t run = CSTL_setop_run(&state, state.lhs, state.lhs_last, state.rhs, false);
+        CSTL_setop_append(&state, state.lhs, run);
+        state.lhs += run * state.type_size;
+
+        if (state.lhs == state.lhs_last) {
+            break;
+        }
+
+        state.rhs += CSTL_setop_run(&state, state.rhs, state.rhs_last, state.lhs, false) * state.type_size;
+
+        if (state.rhs == state.rhs_last) {
+            break;
+        }
+
+        // Drop a pair of equivalent elements.
+        if (!state.is_lt(state.lhs, state.rhs)) {
+            state.lhs += state.type_size;
+            state.rhs += state.type_size;
+        }
+    }
+
+    CSTL_setop_append(&state, state.lhs, CSTL_setop_left(&state, state.lhs, state.lhs_last));
+
+    return true;
+}
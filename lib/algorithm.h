@@ -0,0 +1,180 @@
+#pragma once
+
+#ifndef CSTL_ALGORITHM_H
+#define CSTL_ALGORITHM_H
+
+#include "alloc.h"
+#include "type.h"
+#include "vector.h"
+
+#if defined(__cplusplus)
+#include <cstddef>
+extern "C" {
+#else
+#include <stdbool.h>
+#include <stddef.h>
+#endif
+
+/**
+ * Algorithms over the elements of a `CSTL_VectorVal`, in place.
+ * 
+ * Elements are ordered with `comp->is_lt` and moved with `move`. Elements
+ * of relocatable types are moved bytewise, others through a temporary
+ * object, which is allocated with `alloc` if it does not fit on the stack.
+ * 
+ * Passing one of the ready-made `CSTL_comp_*` tables with the matching
+ * `CSTL_pod_*` type sorts with a radix sort instead of comparisons,
+ * which needs a temporary buffer as large as the vector. If it cannot
+ * be allocated, the elements are sorted with comparisons instead.
+ * 
+ */
+
+/**
+ * Sorts the elements of the vector in ascending order.
+ * 
+ * The order of equivalent elements is unspecified. Runs in `O(n log n)`
+ * comparisons in the worst case.
+ * 
+ * If allocating the temporary object fails, this function has no effect
+ * and returns `false`, otherwise it returns `true`.
+ * 
+ */
+bool CSTL_vector_sort(CSTL_VectorRef instance, CSTL_Type type, CSTL_MoveTypeCRef move, CSTL_CompTypeCRef comp, CSTL_Alloc* alloc);
+
+/**
+ * Sorts the elements of the vector in ascending order,
+ * preserving the order of equivalent elements.
+ * 
+ * Merges with a temporary buffer of half the vector's size.
+ * If allocating it fails, this function has no effect and returns `false`,
+ * otherwise it returns `true`.
+ * 
+ */
+bool CSTL_vector_stable_sort(CSTL_VectorRef instance, CSTL_Type type, CSTL_MoveTypeCRef move, CSTL_CompTypeCRef comp, CSTL_Alloc* alloc);
+
+/**
+ * Rearranges the elements so that `[0, middle)` holds the `middle` smallest
+ * elements in ascending order, the rest are left in an unspecified order.
+ * 
+ * If `middle > CSTL_vector_size(instance, type)` the behavior is undefined.
+ * 
+ * If allocating the temporary object fails, this function has no effect
+ * and returns `false`, otherwise it returns `true`.
+ * 
+ */
+bool CSTL_vector_partial_sort(CSTL_VectorRef instance, CSTL_Type type, CSTL_MoveTypeCRef move, CSTL_CompTypeCRef comp, size_t middle, CSTL_Alloc* alloc);
+
+/**
+ * Rearranges the elements so that the element at `nth` is the one that would
+ * be there if the vector was sorted, no element before it is greater
+ * and no element after it is less.
+ * 
+ * Has no effect if `nth >= CSTL_vector_size(instance, type)`.
+ * 
+ * If allocating the temporary object fails, this function has no effect
+ * and returns `false`, otherwise it returns `true`.
+ * 
+ */
+bool CSTL_vector_nth_element(CSTL_VectorRef instance, CSTL_Type type, CSTL_MoveTypeCRef move, CSTL_CompTypeCRef comp, size_t nth, CSTL_Alloc* alloc);
+
+/**
+ * Returns `true` if the elements of the vector are in ascending order,
+ * or `false` otherwise.
+ * 
+ */
+bool CSTL_vector_is_sorted(CSTL_VectorCRef instance, CSTL_Type type, CSTL_CompTypeCRef comp);
+
+/**
+ * A range of element indices `[first, last)`.
+ * 
+ */
+typedef struct CSTL_IndexRange {
+    size_t first;
+    size_t last;
+} CSTL_IndexRange;
+
+/**
+ * Returns the index of the first element of a sorted vector that is not less
+ * than `key`, or `CSTL_vector_size(instance, type)` if there is no such element.
+ * 
+ * The search is branchless, it always makes `log2(n) + 1` comparisons.
+ * 
+ */
+size_t CSTL_vector_lower_bound(CSTL_VectorCRef instance, CSTL_Type type, CSTL_CompTypeCRef comp, const void* key);
+
+/**
+ * Returns the index of the first element of a sorted vector that is greater
+ * than `key`, or `CSTL_vector_size(instance, type)` if there is no such element.
+ * 
+ */
+size_t CSTL_vector_upper_bound(CSTL_VectorCRef instance, CSTL_Type type, CSTL_CompTypeCRef comp, const void* key);
+
+/**
+ * Returns the range of elements of a sorted vector that are equivalent to `key`,
+ * as if by `CSTL_vector_lower_bound` and `CSTL_vector_upper_bound`.
+ * 
+ */
+CSTL_IndexRange CSTL_vector_equal_range(CSTL_VectorCRef instance, CSTL_Type type, CSTL_CompTypeCRef comp, const void* key);
+
+/**
+ * Returns `true` if a sorted vector contains an element equivalent to `key`,
+ * or `false` otherwise.
+ * 
+ */
+bool CSTL_vector_binary_search(CSTL_VectorCRef instance, CSTL_Type type, CSTL_CompTypeCRef comp, const void* key);
+
+/**
+ * Sorted range operations.
+ * 
+ * The results of `lhs` and `rhs`, which must be sorted, are appended to `dest`
+ * as if by `std::back_inserter`. `dest` is reserved once up front for the largest
+ * possible result, which must not exceed `CSTL_vector_max_size(type)`, and must
+ * not be `lhs` or `rhs`. If reserving fails, the function has no effect and
+ * returns `false`, otherwise it returns `true`.
+ * 
+ * Runs of elements that go to the result or are skipped together are
+ * found by galloping, an exponential search followed by a binary search,
+ * so inputs of very different sizes take time proportional to the smaller one.
+ * 
+ */
+
+/**
+ * Appends the elements of `lhs` and `rhs` to `dest` in sorted order.
+ * 
+ * Equivalent elements of `lhs` are placed before those of `rhs`.
+ * 
+ */
+bool CSTL_vector_merge(CSTL_VectorRef dest, CSTL_Type type, CSTL_CopyTypeCRef copy, CSTL_CompTypeCRef comp, CSTL_VectorCRef lhs, CSTL_VectorCRef rhs, CSTL_Alloc* alloc);
+
+/**
+ * Appends the elements present in either `lhs` or `rhs` to `dest` in sorted order.
+ * 
+ * An element present `m` times in `lhs` and `n` times in `rhs` is appended `max(m, n)`
+ * times, first from `lhs`, then from `rhs`.
+ * 
+ */
+bool CSTL_vector_set_union(CSTL_VectorRef dest, CSTL_Type type, CSTL_CopyTypeCRef copy, CSTL_CompTypeCRef comp, CSTL_VectorCRef lhs, CSTL_VectorCRef rhs, CSTL_Alloc* alloc);
+
+/**
+ * Appends the elements of `lhs` that are also present in `rhs` to `dest` in sorted order.
+ * 
+ * An element present `m` times in `lhs` and `n` times in `rhs` is appended `min(m, n)`
+ * times, copied from `lhs`.
+ * 
+ */
+bool CSTL_vector_set_intersection(CSTL_VectorRef dest, CSTL_Type type, CSTL_CopyTypeCRef copy, CSTL_CompTypeCRef comp, CSTL_VectorCRef lhs, CSTL_VectorCRef rhs, CSTL_Alloc* alloc);
+
+/**
+ * Appends the elements of `lhs` that are not present in `rhs` to `dest` in sorted order.
+ * 
+ * An element present `m` times in `lhs` and `n` times in `rhs` is appended `max(m - n, 0)`
+ * times, copied from `lhs`.
+ * 
+ */
+bool CSTL_vector_set_difference(CSTL_VectorRef dest, CSTL_Type type, CSTL_CopyTypeCRef copy, CSTL_CompTypeCRef comp, CSTL_VectorCRef lhs, CSTL_VectorCRef rhs, CSTL_Alloc* alloc);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
@@ -7,6 +7,7 @@
 #include <cstddef>
 extern "C" {
 #else
+#include <stdbool.h>
 #include <stddef.h>
 #endif
 
@@ -16,8 +17,13 @@ extern "C" {
  * The caller is responsible for making sure an allocator owns and is compatible
  * for freeing memory of a given container.
  * 
- * `aligned_alloc` and `aligned_free` must not be null, while `allocator` can
+ * `aligned_alloc` and `aligned_free` must not be null, while `opaque` can
  * be used to pass any opaque data (if any) directly to the bound functions.
+ * `try_expand` and `reallocate` are optional and let containers grow without
+ * a separate allocation and copy.
+ * 
+ * The library calls every member that is not null, so an allocator must be
+ * zero-initialized before its members are set one by one.
  * 
  * A strict alignment requirement may be imposed by allocated types.
  * 
@@ -43,6 +49,29 @@ typedef struct CSTL_Alloc {
      * 
      */
     void (*aligned_free)(void* opaque, void* memory, size_t size, size_t alignment);
+
+    /**
+     * Optional, may be null.
+     * 
+     * Attempts to grow the block at `memory` from `old_size` to `new_size` bytes
+     * without moving it. On success the block is afterwards freed with `new_size`,
+     * on failure it is left unchanged.
+     * 
+     */
+    bool (*try_expand)(void* opaque, void* memory, size_t old_size, size_t new_size, size_t alignment);
+
+    /**
+     * Optional, may be null.
+     * 
+     * Resizes the block at `memory` from `old_size` to `new_size` bytes, moving
+     * its contents bytewise if the block has to be moved, and returns the resized
+     * block. Returns `NULL` on failure, leaving the old block unchanged.
+     * 
+     * Only used for blocks whose contents may be copied bytewise, such as
+     * strings and vectors of trivially relocatable types.
+     * 
+     */
+    void* (*reallocate)(void* opaque, void* memory, size_t old_size, size_t new_size, size_t alignment);
 } CSTL_Alloc;
 
 #if defined(__cplusplus)
@@ -0,0 +1,259 @@
+#include "arena.h"
+
+#include "internal/alloc_dispatch.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define CSTL_arena_default_chunk ((size_t)64 * 1024)
+
+// Alignment of chunks and of the first byte after their header.
+#define CSTL_arena_align ((size_t)64)
+
+struct CSTL_ArenaChunk {
+    CSTL_ArenaChunk* next;
+    size_t size; // including the header
+};
+
+#define CSTL_arena_header ((sizeof(CSTL_ArenaChunk) + CSTL_arena_align - 1) & ~(CSTL_arena_align - 1))
+
+static inline char* CSTL_arena_chunk_first(CSTL_ArenaChunk* chunk) {
+    return (char*)chunk + CSTL_arena_header;
+}
+
+static inline char* CSTL_arena_chunk_last(CSTL_ArenaChunk* chunk) {
+    return (char*)chunk + chunk->size;
+}
+
+static inline void CSTL_arena_enter(CSTL_Arena* arena, CSTL_ArenaChunk* chunk) {
+    arena->current = chunk;
+    arena->cursor  = chunk != NULL ? CSTL_arena_chunk_first(chunk) : NULL;
+    arena->limit   = chunk != NULL ? CSTL_arena_chunk_last(chunk) : NULL;
+    arena->block   = NULL;
+}
+
+// Bumps the cursor of the current chunk, returns `NULL` if the block does not fit.
+static inline void* CSTL_arena_bump(CSTL_Arena* arena, size_t size, size_t alignment) {
+    if (arena->cursor == NULL) {
+        return NULL;
+    }
+
+    uintptr_t cursor = (uintptr_t)arena->cursor;
+    uintptr_t first  = (cursor + (alignment - 1)) & ~(uintptr_t)(alignment - 1);
+
+    if (first < cursor || first > (uintptr_t)arena->limit
+        || size > (size_t)((uintptr_t)arena->limit - first)) {
+        return NULL;
+    }
+
+    char* last = (char*)first + size;
+
+    arena->used  += (size_t)(last - arena->cursor);
+    arena->block  = arena->cursor;
+    arena->cursor = last;
+
+    if (arena->used > arena->peak) {
+        arena->peak = arena->used;
+    }
+
+    return (void*)first;
+}
+
+// Returns to `chunk` at `cursor` after a failed allocation.
+static inline void CSTL_arena_leave(CSTL_Arena* arena, CSTL_ArenaChunk* chunk, char* cursor, char* block) {
+    arena->current = chunk;
+    arena->cursor  = cursor;
+    arena->limit   = chunk != NULL ? CSTL_arena_chunk_last(chunk) : NULL;
+    arena->block   = block;
+}
+
+static void* CSTL_arena_allocate_chunk(CSTL_Arena* arena, size_t size, size_t alignment) {
+    CSTL_ArenaChunk* prev = arena->current;
+    CSTL_ArenaChunk* next = prev != NULL ? prev->next : NULL;
+
+    // Restored if no chunk can take the block.
+    char* prev_cursor = arena->cursor;
+    char* prev_block  = arena->block;
+
+    // Reuse the chunk after the current one, kept by a reset or rewind.
+    if (next != NULL) {
+        CSTL_arena_enter(arena, next);
+
+        void* memory = CSTL_arena_bump(arena, size, alignment);
+
+        if (memory != NULL) {
+            return memory;
+        }
+    }
+
+    size_t padding = alignment > CSTL_arena_align ? alignment - CSTL_arena_align : 0;
+
+    if (size > SIZE_MAX - CSTL_arena_header - padding - CSTL_arena_align) {
+        CSTL_arena_leave(arena, prev, prev_cursor, prev_block);
+        return NULL;
+    }
+
+    size_t needed = (CSTL_arena_header + padding + size + CSTL_arena_align - 1) & ~(CSTL_arena_align - 1);
+    size_t bytes  = arena->reserved > arena->chunk_size ? arena->reserved : arena->chunk_size;
+
+    if (arena->max_bytes != 0) {
+        size_t remaining = arena->max_bytes - arena->reserved;
+
+        if (needed > remaining) {
+            CSTL_arena_leave(arena, prev, prev_cursor, prev_block);
+            return NULL;
+        }
+
+        if (bytes > remaining) {
+            bytes = remaining;
+        }
+    }
+
+    bytes &= ~(CSTL_arena_align - 1);
+
+    if (bytes < needed) {
+        bytes = needed;
+    }
+
+    CSTL_ArenaChunk* chunk = CSTL_allocate(bytes, CSTL_arena_align, arena->upstream);
+
+    if (chunk == NULL) {
+        CSTL_arena_leave(arena, prev, prev_cursor, prev_block);
+        return NULL;
+    }
+
+    // Link the new chunk right after the previously current one.
+    chunk->next = next;
+    chunk->size = bytes;
+
+    if (prev != NULL) {
+        prev->next = chunk;
+    } else {
+        arena->first = chunk;
+    }
+
+    arena->reserved += bytes;
+    arena->chunks   += 1;
+
+    CSTL_arena_enter(arena, chunk);
+
+    return CSTL_arena_bump(arena, size, alignment);
+}
+
+static void* CSTL_arena_aligned_alloc(void* opaque, size_t size, size_t alignment) {
+    return CSTL_arena_allocate((CSTL_Arena*)opaque, size, alignment);
+}
+
+static void CSTL_arena_aligned_free(void* opaque, void* memory, size_t size, size_t alignment) {
+    CSTL_Arena* arena = (CSTL_Arena*)opaque;
+
+    (void)alignment;
+
+    // Only the most recent block can be given back, with its alignment padding if it is known.
+    if ((char*)memory + size == arena->cursor && memory != NULL) {
+        char* first = arena->block != NULL && arena->block <= (char*)memory ? arena->block : (char*)memory;
+
+        arena->used  -= (size_t)(arena->cursor - first);
+        arena->cursor = first;
+        arena->block  = NULL;
+    }
+}
+
+// Only the most recent block can grow, up to the end of its chunk.
+static bool CSTL_arena_try_expand(void* opaque, void* memory, size_t old_size, size_t new_size, size_t alignment) {
+    CSTL_Arena* arena = (CSTL_Arena*)opaque;
+
+    (void)alignment;
+
+    if ((char*)memory + old_size != arena->cursor || memory == NULL
+        || new_size < old_size || new_size - old_size > (size_t)(arena->limit - arena->cursor)) {
+        return false;
+    }
+
+    arena->cursor += new_size - old_size;
+    arena->used   += new_size - old_size;
+
+    if (arena->used > arena->peak) {
+        arena->peak = arena->used;
+    }
+
+    return true;
+}
+
+void CSTL_arena_construct(CSTL_Arena* new_arena, size_t chunk_size, size_t max_bytes, CSTL_Alloc* upstream) {
+    if (new_arena == NULL) {
+        return;
+    }
+
+    new_arena->alloc.opaque        = new_arena;
+    new_arena->alloc.aligned_alloc = &CSTL_arena_aligned_alloc;
+    new_arena->alloc.aligned_free  = &CSTL_arena_aligned_free;
+    new_arena->alloc.try_expand    = &CSTL_arena_try_expand;
+    new_arena->alloc.reallocate    = NULL;
+
+    new_arena->upstream   = upstream;
+    new_arena->first      = NULL;
+    new_arena->current    = NULL;
+    new_arena->cursor     = NULL;
+    new_arena->limit      = NULL;
+    new_arena->block      = NULL;
+    new_arena->chunk_size = chunk_size != 0 ? chunk_size : CSTL_arena_default_chunk;
+    new_arena->max_bytes  = max_bytes;
+    new_arena->reserved   = 0;
+    new_arena->used       = 0;
+    new_arena->peak       = 0;
+    new_arena->chunks     = 0;
+}
+
+void CSTL_arena_destroy(CSTL_Arena* arena) {
+    CSTL_ArenaChunk* chunk = arena->first;
+
+    while (chunk != NULL) {
+        CSTL_ArenaChunk* next = chunk->next;
+        CSTL_free(chunk, chunk->size, CSTL_arena_align, arena->upstream);
+        chunk = next;
+    }
+
+    CSTL_arena_construct(arena, arena->chunk_size, arena->max_bytes, arena->upstream);
+}
+
+void* CSTL_arena_allocate(CSTL_Arena* arena, size_t size, size_t alignment) {
+    assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+    void* memory = CSTL_arena_bump(arena, size, alignment);
+
+    if (memory != NULL) {
+        return memory;
+    }
+
+    return CSTL_arena_allocate_chunk(arena, size, alignment);
+}
+
+void CSTL_arena_reset(CSTL_Arena* arena) {
+    CSTL_arena_enter(arena, arena->first);
+    arena->used = 0;
+}
+
+CSTL_ArenaMark CSTL_arena_mark(const CSTL_Arena* arena) {
+    CSTL_ArenaMark mark = {arena->current, arena->cursor, arena->used};
+    return mark;
+}
+
+void CSTL_arena_rewind(CSTL_Arena* arena, CSTL_ArenaMark mark) {
+    if (mark.chunk == NULL) {
+        CSTL_arena_reset(arena);
+        return;
+    }
+
+    arena->current = mark.chunk;
+    arena->cursor  = mark.cursor;
+    arena->limit   = CSTL_arena_chunk_last(mark.chunk);
+    arena->block   = NULL;
+    arena->used    = mark.used;
+}
+
+CSTL_ArenaStats CSTL_arena_stats(const CSTL_Arena* arena) {
+    CSTL_ArenaStats stats = {arena->used, arena->peak, arena->reserved, arena->chunks};
+    return stats;
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#ifndef CSTL_ARENA_H
+#define CSTL_ARENA_H
+
+#include "alloc.h"
+
+#if defined(__cplusplus)
+#include <cstddef>
+extern "C" {
+#else
+#include <stddef.h>
+#endif
+
+/**
+ * A block of memory owned by an arena.
+ * 
+ */
+typedef struct CSTL_ArenaChunk CSTL_ArenaChunk;
+
+/**
+ * Bump allocator that hands out memory from large chunks.
+ * 
+ * Memory is not returned by freeing individual blocks, only by resetting
+ * or rewinding the arena, which is O(1). Chunks are kept across resets and
+ * reused, and only given back to the upstream allocator on destruction.
+ * Freeing the most recently allocated block is the one exception, it is
+ * returned to the arena immediately.
+ * 
+ * Containers use the arena through `alloc`, which can be passed to every
+ * function taking a `CSTL_Alloc*`. The arena must not be moved or copied
+ * after construction, as `alloc` refers to it.
+ * 
+ * Not thread-safe.
+ * 
+ * Do not manipulate the members directly, use the associated functions!
+ * 
+ */
+typedef struct CSTL_Arena {
+    CSTL_Alloc alloc;
+    CSTL_Alloc* upstream;
+    CSTL_ArenaChunk* first;
+    CSTL_ArenaChunk* current;
+    char* cursor;
+    char* limit;
+    char* block; // start of the most recent block including its padding, if known
+    size_t chunk_size;
+    size_t max_bytes;
+    size_t reserved;
+    size_t used;
+    size_t peak;
+    size_t chunks;
+} CSTL_Arena;
+
+/**
+ * Position in an arena that it can be rewound to.
+ * 
+ */
+typedef struct CSTL_ArenaMark {
+    CSTL_ArenaChunk* chunk;
+    char* cursor;
+    size_t used;
+} CSTL_ArenaMark;
+
+/**
+ * Usage statistics of an arena.
+ * 
+ */
+typedef struct CSTL_ArenaStats {
+    size_t used;     // bytes handed out since the last reset, including alignment padding
+    size_t peak;     // greatest value of `used` since construction
+    size_t reserved; // bytes obtained from the upstream allocator
+    size_t chunks;   // number of chunks obtained from the upstream allocator
+} CSTL_ArenaStats;
+
+/**
+ * Initializes the arena pointed to by `new_arena`, but does not allocate any memory.
+ * 
+ * Chunks are obtained from `upstream`, or the default allocator if it is `NULL`.
+ * Every new chunk is at least `chunk_size` bytes large (a default size is used
+ * if it is 0) and at least as large as all previous chunks combined.
+ * 
+ * If `max_bytes` is not 0, the arena never obtains more than `max_bytes` bytes
+ * from `upstream` in total and allocations that would exceed it fail.
+ * 
+ */
+void CSTL_arena_construct(CSTL_Arena* new_arena, size_t chunk_size, size_t max_bytes, CSTL_Alloc* upstream);
+
+/**
+ * Destroys the arena pointed to by `arena`, freeing all of its chunks.
+ * 
+ * Any memory allocated from the arena becomes invalid.
+ * 
+ */
+void CSTL_arena_destroy(CSTL_Arena* arena);
+
+/**
+ * Allocates `size` bytes aligned to `alignment`, which must be a power of 2.
+ * 
+ * Returns `NULL` if the arena is out of memory or over its limit.
+ * 
+ */
+void* CSTL_arena_allocate(CSTL_Arena* arena, size_t size, size_t alignment);
+
+/**
+ * Frees all memory allocated from the arena at once, keeping its chunks
+ * for subsequent allocations.
+ * 
+ * Containers using the arena must not be used afterwards, except to be
+ * constructed again. Their elements are not destroyed.
+ * 
+ */
+void CSTL_arena_reset(CSTL_Arena* arena);
+
+/**
+ * Returns the current position of the arena.
+ * 
+ */
+CSTL_ArenaMark CSTL_arena_mark(const CSTL_Arena* arena);
+
+/**
+ * Frees all memory allocated from the arena since `mark` was obtained from it.
+ * 
+ * `mark` is invalidated by a reset, or by rewinding to an earlier mark.
+ * 
+ */
+void CSTL_arena_rewind(CSTL_Arena* arena, CSTL_ArenaMark mark);
+
+/**
+ * Returns the usage statistics of the arena.
+ * 
+ */
+CSTL_ArenaStats CSTL_arena_stats(const CSTL_Arena* arena);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
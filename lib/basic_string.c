@@ -0,0 +1,731 @@
+#include "basic_string.h"
+
+#include "internal/alloc_dispatch.h"
+#include "internal/char_dispatch.h"
+#include "internal/char_search.h"
+#include "internal/type_ext.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define CSTL_basic_string_npos ((size_t)-1)
+
+static size_t CSTL_char_traits_length_1(const void* ptr) {
+    return CSTL_char_len_1(ptr);
+}
+
+static size_t CSTL_char_traits_length_2(const void* ptr) {
+    return CSTL_char_len_2(ptr);
+}
+
+static size_t CSTL_char_traits_length_4(const void* ptr) {
+    return CSTL_char_len_4(ptr);
+}
+
+static int CSTL_char_traits_compare_1(const void* lhs, const void* rhs, size_t count) {
+    size_t i = CSTL_char_mismatch_1(lhs, rhs, count);
+    return i == count ? 0 : ((const uint8_t*)lhs)[i] < ((const uint8_t*)rhs)[i] ? -1 : 1;
+}
+
+static int CSTL_char_traits_compare_2(const void* lhs, const void* rhs, size_t count) {
+    size_t i = CSTL_char_mismatch_2(lhs, rhs, count);
+    return i == count ? 0 : ((const uint16_t*)lhs)[i] < ((const uint16_t*)rhs)[i] ? -1 : 1;
+}
+
+static int CSTL_char_traits_compare_4(const void* lhs, const void* rhs, size_t count) {
+    size_t i = CSTL_char_mismatch_4(lhs, rhs, count);
+    return i == count ? 0 : ((const uint32_t*)lhs)[i] < ((const uint32_t*)rhs)[i] ? -1 : 1;
+}
+
+static size_t CSTL_char_traits_find_1(const void* first, size_t count, const void* ch) {
+    return CSTL_char_find_1(first, count, *(const uint8_t*)ch);
+}
+
+static size_t CSTL_char_traits_find_2(const void* first, size_t count, const void* ch) {
+    return CSTL_char_find_2(first, count, *(const uint16_t*)ch);
+}
+
+static size_t CSTL_char_traits_find_4(const void* first, size_t count, const void* ch) {
+    return CSTL_char_find_4(first, count, *(const uint32_t*)ch);
+}
+
+const CSTL_CharTraits CSTL_char_traits_uint8  = { &CSTL_char_traits_length_1, &CSTL_char_traits_compare_1, &CSTL_char_traits_find_1 };
+const CSTL_CharTraits CSTL_char_traits_uint16 = { &CSTL_char_traits_length_2, &CSTL_char_traits_compare_2, &CSTL_char_traits_find_2 };
+const CSTL_CharTraits CSTL_char_traits_uint32 = { &CSTL_char_traits_length_4, &CSTL_char_traits_compare_4, &CSTL_char_traits_find_4 };
+
+// Replaces `NULL` with the default traits of 1, 2 and 4 byte characters.
+// Other characters have no table, and are handled by the functions below.
+static inline const CSTL_CharTraits* CSTL_basic_string_traits(const CSTL_CharTraits* traits, size_t width) {
+    if (traits != NULL) {
+        return traits;
+    }
+
+    switch (width) {
+    case 1: return &CSTL_char_traits_uint8;
+    case 2: return &CSTL_char_traits_uint16;
+    case 4: return &CSTL_char_traits_uint32;
+    }
+
+    return NULL;
+}
+
+// Whether the substring search of `char_search.h` has the semantics of `traits`.
+static inline bool CSTL_basic_string_is_vectorised(const CSTL_CharTraits* traits) {
+    return traits == &CSTL_char_traits_uint8
+        || traits == &CSTL_char_traits_uint16
+        || traits == &CSTL_char_traits_uint32;
+}
+
+static inline bool CSTL_basic_string_char_is_zero(const char* ch, size_t width) {
+    static const char zero[16] = { 0 };
+    return memcmp(ch, zero, width) == 0;
+}
+
+static inline size_t CSTL_basic_string_char_len(const CSTL_CharTraits* traits, size_t width, const char* ptr) {
+    if (traits != NULL) {
+        return traits->length(ptr);
+    }
+
+    size_t result = 0;
+
+    while (!CSTL_basic_string_char_is_zero(ptr + result * width, width)) {
+        ++result;
+    }
+
+    return result;
+}
+
+static inline int CSTL_basic_string_char_compare(const CSTL_CharTraits* traits, size_t width, const char* lhs, const char* rhs, size_t count) {
+    if (traits != NULL) {
+        return traits->compare(lhs, rhs, count);
+    }
+
+    if (width == 8) {
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t left;
+            uint64_t right;
+
+            memcpy(&left, lhs + i * 8, 8);
+            memcpy(&right, rhs + i * 8, 8);
+
+            if (left != right) {
+                return left < right ? -1 : 1;
+            }
+        }
+
+        return 0;
+    }
+
+    int result = count != 0 ? memcmp(lhs, rhs, count * width) : 0;
+    return result < 0 ? -1 : result > 0 ? 1 : 0;
+}
+
+// Returns the index of the first character equal to `ch` in `[first, first + count)`, or `count`.
+static inline size_t CSTL_basic_string_char_find(const CSTL_CharTraits* traits, size_t width, const char* first, size_t count, const char* ch) {
+    if (traits != NULL) {
+        return traits->find(first, count, ch);
+    }
+
+    size_t i = 0;
+
+    while (i != count && memcmp(first + i * width, ch, width) != 0) {
+        ++i;
+    }
+
+    return i;
+}
+
+// Returns the index of the last character equal to `ch` in `[first, first + count)`, or `count`.
+static inline size_t CSTL_basic_string_char_rfind(const CSTL_CharTraits* traits, size_t width, const char* first, size_t count, const char* ch) {
+    if (traits == &CSTL_char_traits_uint8) {
+        return CSTL_char_rfind_1(first, count, *(const uint8_t*)ch);
+    } else if (traits == &CSTL_char_traits_uint16) {
+        return CSTL_char_rfind_2(first, count, *(const uint16_t*)ch);
+    } else if (traits == &CSTL_char_traits_uint32) {
+        return CSTL_char_rfind_4(first, count, *(const uint32_t*)ch);
+    }
+
+    for (size_t i = count; i != 0; --i) {
+        if (CSTL_basic_string_char_compare(traits, width, first + (i - 1) * width, ch, 1) == 0) {
+            return i - 1;
+        }
+    }
+
+    return count;
+}
+
+static inline void CSTL_basic_string_char_fill(char* dst, size_t width, const void* ch, size_t count) {
+    switch (width) {
+    case 1: CSTL_char_fill_1(dst, count, *(const uint8_t*)ch); return;
+    case 2: CSTL_char_fill_2(dst, count, *(const uint16_t*)ch); return;
+    case 4: CSTL_char_fill_4(dst, count, *(const uint32_t*)ch); return;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        memcpy(dst + i * width, ch, width);
+    }
+}
+
+// Roundup mask for allocated buffers, as `CSTL_string_alloc_mask`.
+static inline size_t CSTL_basic_string_alloc_mask(size_t width) {
+    return width <= 1 ? 15 : width <= 2 ? 7 : width <= 4 ? 3 : width <= 8 ? 1 : 0;
+}
+
+static inline size_t CSTL_basic_string_small_capacity(size_t width) {
+    return (16 / width < 1 ? 1 : 16 / width) - 1;
+}
+
+static inline bool CSTL_basic_string_large_mode_engaged(CSTL_BasicStringCRef instance, size_t width) {
+    return instance->res > CSTL_basic_string_small_capacity(width);
+}
+
+static inline char* CSTL_basic_string_ptr(CSTL_BasicStringCRef instance, size_t width) {
+    if (CSTL_basic_string_large_mode_engaged(instance, width)) {
+        return (char*)instance->bx.ptr;
+    }
+
+    return (char*)instance->bx.buf;
+}
+
+static inline void CSTL_basic_string_eos(CSTL_BasicStringRef instance, size_t width, size_t new_size) {
+    instance->size = new_size;
+    memset(CSTL_basic_string_ptr(instance, width) + new_size * width, 0, width);
+}
+
+static inline size_t CSTL_basic_string_calculate_growth(CSTL_Type type, size_t requested, size_t old) {
+    const size_t max    = CSTL_basic_string_max_size(type);
+    const size_t masked = requested | CSTL_basic_string_alloc_mask(CSTL_type_size(type));
+
+    if (masked > max) {
+        return max;
+    }
+
+    if (old > max - old / 2) {
+        return max;
+    }
+
+    size_t geometric = old + old / 2;
+
+    return geometric > masked ? geometric : masked;
+}
+
+static inline char* CSTL_basic_string_allocate_for_capacity(CSTL_Type type, size_t capacity, CSTL_Alloc* alloc) {
+    size_t size = (capacity + 1) * CSTL_type_size(type); // +1 for null terminator
+    return CSTL_allocate(size, CSTL_type_alignment(type), alloc);
+}
+
+static inline void CSTL_basic_string_deallocate_for_capacity(CSTL_Type type, void* old_ptr, size_t capacity, CSTL_Alloc* alloc) {
+    size_t size = (capacity + 1) * CSTL_type_size(type); // +1 for null terminator
+    CSTL_free(old_ptr, size, CSTL_type_alignment(type), alloc);
+}
+
+// Replaces `[off, off + count)` with `count2` characters, copied from `src` unless it is `NULL`,
+// like `std::basic_string::replace`. `src` may point into the string itself.
+// Returns a pointer to the replacement characters, or `NULL` if the string would be too long
+// or an allocation fails, in which case the string is unchanged.
+static char* CSTL_basic_string_replace_raw(CSTL_BasicStringRef instance, CSTL_Type type, size_t off, size_t count, const void* src, size_t count2, CSTL_Alloc* alloc) {
+    size_t width       = CSTL_type_size(type);
+    size_t old_size    = instance->size;
+    size_t suffix_size = old_size - off - count;
+
+    if (count2 > count && count2 - count > CSTL_basic_string_max_size(type) - old_size) {
+        return NULL;
+    }
+
+    size_t new_size = old_size - count + count2;
+
+    char* old_ptr    = CSTL_basic_string_ptr(instance, width);
+    const char* from = src;
+
+    if (new_size <= instance->res) {
+        char* where        = old_ptr + off * width;
+        char* suffix_first = where + count * width;
+
+        if (count2 <= count) {
+            // The hole only shrinks, so the source is intact until the suffix moves.
+            if (from != NULL) {
+                memmove(where, from, count2 * width);
+            }
+
+            memmove(where + count2 * width, suffix_first, (suffix_size + 1) * width);
+        } else {
+            // Move the suffix out of the way first, and then find the part of
+            // the source it took with it, like `std::basic_string::_Replace`.
+            size_t shift = (count2 - count) * width;
+
+            memmove(suffix_first + shift, suffix_first, (suffix_size + 1) * width);
+
+            if (from == NULL) {
+                // Nothing to copy.
+            } else if (from + count2 * width <= suffix_first || from >= old_ptr + (old_size + 1) * width) {
+                memmove(where, from, count2 * width);
+            } else if (from >= suffix_first) {
+                memmove(where, from + shift, count2 * width);
+            } else {
+                size_t head = (size_t)(suffix_first - from);
+
+                memmove(where, from, head);
+                memcpy(where + head, where + count2 * width, count2 * width - head);
+            }
+        }
+
+        instance->size = new_size;
+
+        return where;
+    }
+
+    size_t old_capacity = instance->res;
+    size_t new_capacity = CSTL_basic_string_calculate_growth(type, new_size, old_capacity);
+    char* new_ptr       = CSTL_basic_string_allocate_for_capacity(type, new_capacity, alloc);
+
+    if (new_ptr == NULL) {
+        return NULL;
+    }
+
+    memcpy(new_ptr, old_ptr, off * width);
+
+    if (from != NULL) {
+        memcpy(new_ptr + off * width, from, count2 * width);
+    }
+
+    memcpy(new_ptr + (off + count2) * width, old_ptr + (off + count) * width, (suffix_size + 1) * width);
+
+    if (CSTL_basic_string_large_mode_engaged(instance, width)) {
+        CSTL_basic_string_deallocate_for_capacity(type, old_ptr, old_capacity, alloc);
+    }
+
+    instance->bx.ptr = new_ptr;
+    instance->size   = new_size;
+    instance->res    = new_capacity;
+
+    return new_ptr + off * width;
+}
+
+// Replaces `[off, off + count)` with `count2` copies of the character at `ch`,
+// which may be a part of the string.
+static bool CSTL_basic_string_replace_fill(CSTL_BasicStringRef instance, CSTL_Type type, size_t off, size_t count, size_t count2, const void* ch, CSTL_Alloc* alloc) {
+    unsigned char value[16];
+    size_t width = CSTL_type_size(type);
+
+    memcpy(value, ch, width);
+
+    char* where = CSTL_basic_string_replace_raw(instance, type, off, count, NULL, count2, alloc);
+
+    if (where == NULL) {
+        return false;
+    }
+
+    CSTL_basic_string_char_fill(where, width, value, count2);
+
+    return true;
+}
+
+size_t CSTL_basic_string_bufsize(CSTL_Type type) {
+    return CSTL_basic_string_small_capacity(CSTL_type_size(type)) + 1;
+}
+
+void CSTL_basic_string_construct(CSTL_BasicStringVal* new_instance, CSTL_Type type) {
+    if (new_instance == NULL) {
+        return;
+    }
+
+    size_t width = CSTL_type_size(type);
+
+    assert(width <= 16 && CSTL_type_alignment(type) <= _Alignof(void*));
+
+    new_instance->size = 0;
+    new_instance->res  = CSTL_basic_string_small_capacity(width);
+
+    memset(new_instance->bx.buf, 0, width);
+}
+
+void CSTL_basic_string_destroy(CSTL_BasicStringRef instance, CSTL_Type type, CSTL_Alloc* alloc) {
+    size_t width = CSTL_type_size(type);
+
+    if (CSTL_basic_string_large_mode_engaged(instance, width)) {
+        CSTL_basic_string_deallocate_for_capacity(type, instance->bx.ptr, instance->res, alloc);
+    }
+
+    CSTL_basic_string_construct(instance, type);
+}
+
+bool CSTL_basic_string_assign(CSTL_BasicStringRef instance, CSTL_Type type, const CSTL_CharTraits* traits, const void* ptr, CSTL_Alloc* alloc) {
+    size_t width = CSTL_type_size(type);
+    size_t count = CSTL_basic_string_char_len(CSTL_basic_string_traits(traits, width), width, ptr);
+
+    return CSTL_basic_string_assign_n(instance, type, ptr, count, alloc);
+}
+
+bool CSTL_basic_string_assign_n(CSTL_BasicStringRef instance, CSTL_Type type, const void* ptr, size_t count, CSTL_Alloc* alloc) {
+    return CSTL_basic_string_replace_raw(instance, type, 0, instance->size, ptr, count, alloc) != NULL;
+}
+
+bool CSTL_basic_string_assign_char(CSTL_BasicStringRef instance, CSTL_Type type, size_t count, const void* ch, CSTL_Alloc* alloc) {
+    return CSTL_basic_string_replace_fill(instance, type, 0, instance->size, count, ch, alloc);
+}
+
+bool CSTL_basic_string_assign_str(CSTL_BasicStringRef instance, CSTL_Type type, CSTL_BasicStringCRef other_instance, CSTL_Alloc* alloc) {
+    if (instance == other_instance) {
+        return true;
+    }
+
+    const void* other_ptr = CSTL_basic_string_ptr(other_instance, CSTL_type_size(type));
+    return CSTL_basic_string_assign_n(instance, type, other_ptr, other_instance->size, alloc);
+}
+
+void CSTL_basic_string_swap(CSTL_BasicStringRef instance, CSTL_BasicStringRef other_instance) {
+    CSTL_BasicStringVal temp = *instance;
+    *instance                = *other_instance;
+    *other_instance          = temp;
+}
+
+void* CSTL_basic_string_index(CSTL_BasicStringRef instance, CSTL_Type type, size_t pos) {
+    assert(pos < instance->size);
+
+    size_t width = CSTL_type_size(type);
+    return CSTL_basic_string_ptr(instance, width) + pos * width;
+}
+
+const void* CSTL_basic_string_const_index(CSTL_BasicStringCRef instance, CSTL_Type type, size_t pos) {
+    assert(pos < instance->size);
+
+    size_t width = CSTL_type_size(type);
+    return CSTL_basic_string_ptr(instance, width) + pos * width;
+}
+
+void* CSTL_basic_string_at(CSTL_BasicStringRef instance, CSTL_Type type, size_t pos) {
+    if (instance->size <= pos) {
+        return NULL;
+    }
+
+    return CSTL_basic_string_index(instance, type, pos);
+}
+
+const void* CSTL_basic_string_const_at(CSTL_BasicStringCRef instance, CSTL_Type type, size_t pos) {
+    if (instance->size <= pos) {
+        return NULL;
+    }
+
+    return CSTL_basic_string_const_index(instance, type, pos);
+}
+
+void* CSTL_basic_string_data(CSTL_BasicStringRef instance, CSTL_Type type) {
+    return CSTL_basic_string_ptr(instance, CSTL_type_size(type));
+}
+
+const void* CSTL_basic_string_c_str(CSTL_BasicStringCRef instance, CSTL_Type type) {
+    return CSTL_basic_string_ptr(instance, CSTL_type_size(type));
+}
+
+bool CSTL_basic_string_empty(CSTL_BasicStringCRef instance) {
+    return instance->size == 0;
+}
+
+size_t CSTL_basic_string_size(CSTL_BasicStringCRef instance) {
+    return instance->size;
+}
+
+size_t CSTL_basic_string_capacity(CSTL_BasicStringCRef instance) {
+    return instance->res;
+}
+
+size_t CSTL_basic_string_max_size(CSTL_Type type) {
+    size_t width = CSTL_type_size(type);
+    return width == 1 ? (size_t)PTRDIFF_MAX - 1 : (size_t)PTRDIFF_MAX / width;
+}
+
+bool CSTL_basic_string_reserve(CSTL_BasicStringRef instance, CSTL_Type type, size_t new_capacity, CSTL_Alloc* alloc) {
+    if (instance->res >= new_capacity) {
+        return true; // nothing to do
+    }
+
+    if (new_capacity > CSTL_basic_string_max_size(type)) {
+        return false;
+    }
+
+    size_t width        = CSTL_type_size(type);
+    size_t old_capacity = instance->res;
+    char* old_ptr       = CSTL_basic_string_ptr(instance, width);
+
+    new_capacity  = CSTL_basic_string_calculate_growth(type, new_capacity, old_capacity);
+    char* new_ptr = CSTL_basic_string_allocate_for_capacity(type, new_capacity, alloc);
+
+    if (new_ptr == NULL) {
+        return false;
+    }
+
+    memcpy(new_ptr, old_ptr, (instance->size + 1) * width);
+
+    if (CSTL_basic_string_large_mode_engaged(instance, width)) {
+        CSTL_basic_string_deallocate_for_capacity(type, old_ptr, old_capacity, alloc);
+    }
+
+    instance->bx.ptr = new_ptr;
+    instance->res    = new_capacity;
+
+    return true;
+}
+
+void CSTL_basic_string_shrink_to_fit(CSTL_BasicStringRef instance, CSTL_Type type, CSTL_Alloc* alloc) {
+    size_t width = CSTL_type_size(type);
+
+    if (!CSTL_basic_string_large_mode_engaged(instance, width)) {
+        return;
+    }
+
+    char* old_ptr         = instance->bx.ptr;
+    size_t small_capacity = CSTL_basic_string_small_capacity(width);
+
+    if (instance->size <= small_capacity) {
+        memcpy(instance->bx.buf, old_ptr, (instance->size + 1) * width);
+        CSTL_basic_string_deallocate_for_capacity(type, old_ptr, instance->res, alloc);
+
+        instance->res = small_capacity;
+        return;
+    }
+
+    size_t max_size        = CSTL_basic_string_max_size(type);
+    size_t masked_size     = instance->size | CSTL_basic_string_alloc_mask(width);
+    size_t target_capacity = masked_size < max_size ? masked_size : max_size;
+
+    if (target_capacity < instance->res) {
+        char* new_ptr = CSTL_basic_string_allocate_for_capacity(type, target_capacity, alloc);
+
+        if (new_ptr == NULL) {
+            return;
+        }
+
+        memcpy(new_ptr, old_ptr, (instance->size + 1) * width);
+        CSTL_basic_string_deallocate_for_capacity(type, old_ptr, instance->res, alloc);
+
+        instance->bx.ptr = new_ptr;
+        instance->res    = target_capacity;
+    }
+}
+
+void CSTL_basic_string_clear(CSTL_BasicStringRef instance, CSTL_Type type) {
+    CSTL_basic_string_eos(instance, CSTL_type_size(type), 0);
+}
+
+bool CSTL_basic_string_push_back(CSTL_BasicStringRef instance, CSTL_Type type, const void* ch, CSTL_Alloc* alloc) {
+    return CSTL_basic_string_append_n(instance, type, ch, 1, alloc);
+}
+
+void CSTL_basic_string_pop_back(CSTL_BasicStringRef instance, CSTL_Type type) {
+    assert(instance->size != 0);
+    CSTL_basic_string_eos(instance, CSTL_type_size(type), instance->size - 1);
+}
+
+bool CSTL_basic_string_append(CSTL_BasicStringRef instance, CSTL_Type type, const CSTL_CharTraits* traits, const void* ptr, CSTL_Alloc* alloc) {
+    size_t width = CSTL_type_size(type);
+    size_t count = CSTL_basic_string_char_len(CSTL_basic_string_traits(traits, width), width, ptr);
+
+    return CSTL_basic_string_append_n(instance, type, ptr, count, alloc);
+}
+
+bool CSTL_basic_string_append_n(CSTL_BasicStringRef instance, CSTL_Type type, const void* ptr, size_t count, CSTL_Alloc* alloc) {
+    return CSTL_basic_string_replace_raw(instance, type, instance->size, 0, ptr, count, alloc) != NULL;
+}
+
+bool CSTL_basic_string_append_char(CSTL_BasicStringRef instance, CSTL_Type type, size_t count, const void* ch, CSTL_Alloc* alloc) {
+    return CSTL_basic_string_insert_char_at(instance, type, instance->size, count, ch, alloc);
+}
+
+bool CSTL_basic_string_append_str(CSTL_BasicStringRef instance, CSTL_Type type, CSTL_BasicStringCRef other_instance, CSTL_Alloc* alloc) {
+    const void* other_ptr = CSTL_basic_string_ptr(other_instance, CSTL_type_size(type));
+    return CSTL_basic_string_append_n(instance, type, other_ptr, other_instance->size, alloc);
+}
+
+bool CSTL_basic_string_insert_n_at(CSTL_BasicStringRef instance, CSTL_Type type, size_t off, const void* ptr, size_t count, CSTL_Alloc* alloc) {
+    if (off > instance->size) {
+        return false;
+    }
+
+    return CSTL_basic_string_replace_raw(instance, type, off, 0, ptr, count, alloc) != NULL;
+}
+
+bool CSTL_basic_string_insert_char_at(CSTL_BasicStringRef instance, CSTL_Type type, size_t off, size_t count, const void* ch, CSTL_Alloc* alloc) {
+    if (off > instance->size) {
+        return false;
+    }
+
+    return CSTL_basic_string_replace_fill(instance, type, off, 0, count, ch, alloc);
+}
+
+bool CSTL_basic_string_erase_substr_at(CSTL_BasicStringRef instance, CSTL_Type type, size_t off, size_t count) {
+    if (off > instance->size) {
+        return false;
+    }
+
+    size_t suffix_size = instance->size - off;
+    count              = count < suffix_size ? count : suffix_size;
+
+    // Never allocates, since the string does not grow.
+    CSTL_basic_string_replace_raw(instance, type, off, count, NULL, 0, NULL);
+
+    return true;
+}
+
+bool CSTL_basic_string_replace_n_at(CSTL_BasicStringRef instance, CSTL_Type type, size_t off, size_t count, const void* ptr, size_t count2, CSTL_Alloc* alloc) {
+    if (off > instance->size) {
+        return false;
+    }
+
+    size_t suffix_size = instance->size - off;
+    count              = count < suffix_size ? count : suffix_size;
+
+    return CSTL_basic_string_replace_raw(instance, type, off, count, ptr, count2, alloc) != NULL;
+}
+
+bool CSTL_basic_string_resize(CSTL_BasicStringRef instance, CSTL_Type type, size_t new_size, const void* ch, CSTL_Alloc* alloc) {
+    size_t old_size = instance->size;
+
+    if (new_size <= old_size) {
+        CSTL_basic_string_eos(instance, CSTL_type_size(type), new_size);
+        return true;
+    }
+
+    return CSTL_basic_string_append_char(instance, type, new_size - old_size, ch, alloc);
+}
+
+size_t CSTL_basic_string_find_n(CSTL_BasicStringCRef instance, CSTL_Type type, const CSTL_CharTraits* traits, const void* ptr, size_t off, size_t count) {
+    size_t hay_size = instance->size;
+
+    if (count > hay_size || off > hay_size - count) {
+        return CSTL_basic_string_npos;
+    }
+
+    if (count == 0) {
+        return off;
+    }
+
+    size_t width       = CSTL_type_size(type);
+    const char* first  = CSTL_basic_string_ptr(instance, width) + off * width;
+    const char* needle = ptr;
+    size_t hay_count   = hay_size - off;
+    size_t found_at    = hay_count;
+
+    traits = CSTL_basic_string_traits(traits, width);
+
+    if (CSTL_basic_string_is_vectorised(traits)) {
+        switch (width) {
+        case 1: found_at = CSTL_char_find_seq_1(first, hay_count, needle, count); break;
+        case 2: found_at = CSTL_char_find_seq_2(first, hay_count, needle, count); break;
+        case 4: found_at = CSTL_char_find_seq_4(first, hay_count, needle, count); break;
+        }
+    } else {
+        // Find candidates by their first character, then compare the rest.
+        size_t last = hay_count - count + 1;
+        size_t i    = 0;
+
+        while (i != last) {
+            i += CSTL_basic_string_char_find(traits, width, first + i * width, last - i, needle);
+
+            if (i == last) {
+                break;
+            }
+
+            if (CSTL_basic_string_char_compare(traits, width, first + (i + 1) * width, needle + width, count - 1) == 0) {
+                found_at = i;
+                break;
+            }
+
+            ++i;
+        }
+    }
+
+    return found_at != hay_count ? off + found_at : CSTL_basic_string_npos;
+}
+
+size_t CSTL_basic_string_find_char(CSTL_BasicStringCRef instance, CSTL_Type type, const CSTL_CharTraits* traits, const void* ch, size_t off) {
+    size_t hay_size = instance->size;
+
+    if (off >= hay_size) {
+        return CSTL_basic_string_npos;
+    }
+
+    size_t width      = CSTL_type_size(type);
+    const char* first = CSTL_basic_string_ptr(instance, width) + off * width;
+    size_t count      = hay_size - off;
+    size_t found_at   = CSTL_basic_string_char_find(CSTL_basic_string_traits(traits, width), width, first, count, ch);
+
+    return found_at != count ? off + found_at : CSTL_basic_string_npos;
+}
+
+size_t CSTL_basic_string_rfind_n(CSTL_BasicStringCRef instance, CSTL_Type type, const CSTL_CharTraits* traits, const void* ptr, size_t off, size_t count) {
+    size_t hay_size = instance->size;
+
+    if (count == 0) {
+        return off < hay_size ? off : hay_size;
+    }
+
+    if (count > hay_size) {
+        return CSTL_basic_string_npos;
+    }
+
+    size_t width         = CSTL_type_size(type);
+    const char* haystack = CSTL_basic_string_ptr(instance, width);
+    const char* needle   = ptr;
+    size_t start_pos     = off < hay_size - count ? off : hay_size - count;
+    size_t hay_count     = start_pos + count; // a match must end before `haystack + hay_count`
+    size_t found_at      = hay_count;
+
+    traits = CSTL_basic_string_traits(traits, width);
+
+    if (CSTL_basic_string_is_vectorised(traits)) {
+        switch (width) {
+        case 1: found_at = CSTL_char_rfind_seq_1(haystack, hay_count, needle, count); break;
+        case 2: found_at = CSTL_char_rfind_seq_2(haystack, hay_count, needle, count); break;
+        case 4: found_at = CSTL_char_rfind_seq_4(haystack, hay_count, needle, count); break;
+        }
+    } else {
+        for (size_t i = start_pos + 1; i != 0; --i) {
+            if (CSTL_basic_string_char_compare(traits, width, haystack + (i - 1) * width, needle, count) == 0) {
+                found_at = i - 1;
+                break;
+            }
+        }
+    }
+
+    return found_at != hay_count ? found_at : CSTL_basic_string_npos;
+}
+
+size_t CSTL_basic_string_rfind_char(CSTL_BasicStringCRef instance, CSTL_Type type, const CSTL_CharTraits* traits, const void* ch, size_t off) {
+    size_t hay_size = instance->size;
+
+    if (hay_size == 0) {
+        return CSTL_basic_string_npos;
+    }
+
+    size_t width         = CSTL_type_size(type);
+    const char* haystack = CSTL_basic_string_ptr(instance, width);
+    size_t count         = (off < hay_size - 1 ? off : hay_size - 1) + 1;
+    size_t found_at      = CSTL_basic_string_char_rfind(CSTL_basic_string_traits(traits, width), width, haystack, count, ch);
+
+    return found_at != count ? found_at : CSTL_basic_string_npos;
+}
+
+int CSTL_basic_string_compare_nn(CSTL_Type type, const CSTL_CharTraits* traits, const void* left, size_t left_count, const void* right, size_t right_count) {
+    size_t width       = CSTL_type_size(type);
+    bool left_lt_right = left_count < right_count;
+    size_t count       = left_lt_right ? left_count : right_count;
+
+    int result = CSTL_basic_string_char_compare(CSTL_basic_string_traits(traits, width), width, left, right, count);
+
+    if (result == 0 && left_count != right_count) {
+        return left_lt_right ? -1 : 1;
+    }
+
+    return result;
+}
+
+int CSTL_basic_string_compare_str(CSTL_BasicStringCRef instance, CSTL_Type type, const CSTL_CharTraits* traits, CSTL_BasicStringCRef other_instance) {
+    size_t width = CSTL_type_size(type);
+
+    return CSTL_basic_string_compare_nn(type, traits,
+        CSTL_basic_string_ptr(instance, width), instance->size,
+        CSTL_basic_string_ptr(other_instance, width), other_instance->size);
+}
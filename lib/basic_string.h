@@ -0,0 +1,409 @@
+#pragma once
+
+#ifndef CSTL_BASIC_STRING_PUBLIC_H
+#define CSTL_BASIC_STRING_PUBLIC_H
+
+#include "alloc.h"
+#include "type.h"
+
+#if defined(__cplusplus)
+#include <cstddef>
+extern "C" {
+#else
+#include <stdbool.h>
+#include <stddef.h>
+#endif
+
+/**
+ * STL ABI `std::basic_string` layout for a character type only known at run time.
+ * 
+ * Characters are described by a `CSTL_Type`, and must be trivial, at most 16 bytes
+ * large and no more aligned than a pointer. The inline buffer holds 16 bytes,
+ * which is `CSTL_basic_string_bufsize(type)` characters including the terminator,
+ * as in the typed strings of `xstring.h`. A `CSTL_BasicStringVal` of 1, 2 or 4 byte
+ * characters has the same layout as a `CSTL_String`, `CSTL_UTF16StringVal` or
+ * `CSTL_UTF32StringVal`, and of any other size as the `std::basic_string` of it.
+ * 
+ * Does not include the allocator, which nonetheless is a part of the `std::basic_string`
+ * structure! You are responsible for including it, since it can take on any form.
+ * 
+ * Do not manipulate the members directly, use the associated functions!
+ * 
+ */
+typedef struct CSTL_BasicStringVal {
+    union CSTL_BasicStringUnion {
+        unsigned char buf[16];
+        void* ptr;
+    } bx;
+    size_t size;
+    size_t res;
+} CSTL_BasicStringVal;
+
+/**
+ * Reference to a mutable `CSTL_BasicStringVal`.
+ * 
+ * Must not be null.
+ * 
+ */
+typedef CSTL_BasicStringVal* CSTL_BasicStringRef;
+
+/**
+ * Reference to a const `CSTL_BasicStringVal`.
+ * 
+ * Must not be null.
+ * 
+ */
+typedef const CSTL_BasicStringVal* CSTL_BasicStringCRef;
+
+/**
+ * Function table for character traits, like `std::char_traits`.
+ * 
+ * `length` returns the number of characters before the null terminator at `ptr`,
+ * `compare` compares `count` characters lexicographically and returns a negative value,
+ * zero or a positive value, and `find` returns the index of the first character equal
+ * to `*ch` in `[first, first + count)` or `count` if there is none.
+ * 
+ * Functions taking a `const CSTL_CharTraits*` use the default traits if it is `NULL`.
+ * The default traits compare characters as unsigned integers if they are 1, 2, 4 or 8 bytes
+ * large and bytewise otherwise, and are vectorised for 1, 2 and 4 byte characters.
+ * The tables below are the default traits of those sizes.
+ * 
+ */
+typedef struct CSTL_CharTraits {
+    size_t (*length)(const void* ptr);
+    int (*compare)(const void* lhs, const void* rhs, size_t count);
+    size_t (*find)(const void* first, size_t count, const void* ch);
+} CSTL_CharTraits;
+
+/**
+ * Ready-made default traits for 1, 2 and 4 byte characters.
+ * 
+ */
+extern const CSTL_CharTraits CSTL_char_traits_uint8;
+extern const CSTL_CharTraits CSTL_char_traits_uint16;
+extern const CSTL_CharTraits CSTL_char_traits_uint32;
+
+/**
+ * Returns the number of characters of `type` in the inline buffer,
+ * including the null terminator, like `CSTL_string_bufsize`.
+ * 
+ */
+size_t CSTL_basic_string_bufsize(CSTL_Type type);
+
+/**
+ * Initializes the string, but does not allocate any memory.
+ * 
+ * An initialized string can be trivially destroyed without leaks as long
+ * as its contents fit in the inline buffer.
+ * 
+ * Re-initializing a string with a backing memory allocation will leak the old
+ * memory allocation.
+ * 
+ */
+void CSTL_basic_string_construct(CSTL_BasicStringVal* new_instance, CSTL_Type type);
+
+/**
+ * Destroys the string, freeing the backing storage if necessary.
+ * 
+ */
+void CSTL_basic_string_destroy(CSTL_BasicStringRef instance, CSTL_Type type, CSTL_Alloc* alloc);
+
+/**
+ * Replaces the contents of `instance` with the null-terminated string at `ptr`.
+ * 
+ * If the length of the string at `ptr` is greater than `CSTL_basic_string_max_size(type)`
+ * or an allocation fails, this function has no effect and returns `false`,
+ * otherwise it returns `true`.
+ * 
+ */
+bool CSTL_basic_string_assign(CSTL_BasicStringRef instance, CSTL_Type type, const CSTL_CharTraits* traits, const void* ptr, CSTL_Alloc* alloc);
+
+/**
+ * Replaces the contents of `instance` with the first `count` characters of the string at `ptr`.
+ * 
+ * If `count` is greater than `CSTL_basic_string_max_size(type)` or an allocation fails,
+ * this function has no effect and returns `false`, otherwise it returns `true`.
+ * 
+ */
+bool CSTL_basic_string_assign_n(CSTL_BasicStringRef instance, CSTL_Type type, const void* ptr, size_t count, CSTL_Alloc* alloc);
+
+/**
+ * Replaces the contents of `instance` with `count` copies of the character at `ch`.
+ * 
+ * If `count` is greater than `CSTL_basic_string_max_size(type)` or an allocation fails,
+ * this function has no effect and returns `false`, otherwise it returns `true`.
+ * 
+ */
+bool CSTL_basic_string_assign_char(CSTL_BasicStringRef instance, CSTL_Type type, size_t count, const void* ch, CSTL_Alloc* alloc);
+
+/**
+ * Replaces the contents of `instance` with the contents of `other_instance`.
+ * 
+ * If an allocation fails, this function has no effect and returns `false`,
+ * otherwise it returns `true`.
+ * 
+ */
+bool CSTL_basic_string_assign_str(CSTL_BasicStringRef instance, CSTL_Type type, CSTL_BasicStringCRef other_instance, CSTL_Alloc* alloc);
+
+/**
+ * Swaps the contents of two strings.
+ * 
+ * You are responsible for swapping the allocators outside of `CSTL_BasicStringVal` if applicable.
+ * 
+ */
+void CSTL_basic_string_swap(CSTL_BasicStringRef instance, CSTL_BasicStringRef other_instance);
+
+/**
+ * Returns a pointer to the character at `pos`.
+ * 
+ * If `pos >= CSTL_basic_string_size(instance)` the behavior is undefined.
+ * 
+ */
+void* CSTL_basic_string_index(CSTL_BasicStringRef instance, CSTL_Type type, size_t pos);
+
+/**
+ * Returns a const pointer to the character at `pos`.
+ * 
+ * If `pos >= CSTL_basic_string_size(instance)` the behavior is undefined.
+ * 
+ */
+const void* CSTL_basic_string_const_index(CSTL_BasicStringCRef instance, CSTL_Type type, size_t pos);
+
+/**
+ * Returns a pointer to the character at `pos`.
+ * 
+ * If `pos >= CSTL_basic_string_size(instance)` a null pointer is returned.
+ * 
+ */
+void* CSTL_basic_string_at(CSTL_BasicStringRef instance, CSTL_Type type, size_t pos);
+
+/**
+ * Returns a const pointer to the character at `pos`.
+ * 
+ * If `pos >= CSTL_basic_string_size(instance)` a null pointer is returned.
+ * 
+ */
+const void* CSTL_basic_string_const_at(CSTL_BasicStringCRef instance, CSTL_Type type, size_t pos);
+
+/**
+ * Returns a pointer to the underlying null-terminated array.
+ * 
+ * The pointer is invalidated by any call that changes the capacity.
+ * 
+ */
+void* CSTL_basic_string_data(CSTL_BasicStringRef instance, CSTL_Type type);
+
+/**
+ * Returns a const pointer to the underlying null-terminated array.
+ * 
+ * The pointer is invalidated by any call that changes the capacity.
+ * 
+ */
+const void* CSTL_basic_string_c_str(CSTL_BasicStringCRef instance, CSTL_Type type);
+
+/**
+ * Returns `true` if the string is empty.
+ * 
+ */
+bool CSTL_basic_string_empty(CSTL_BasicStringCRef instance);
+
+/**
+ * Returns the number of characters in the string.
+ * 
+ */
+size_t CSTL_basic_string_size(CSTL_BasicStringCRef instance);
+
+/**
+ * Returns the number of characters the string can hold without reallocating.
+ * 
+ */
+size_t CSTL_basic_string_capacity(CSTL_BasicStringCRef instance);
+
+/**
+ * Returns the maximum number of characters of `type` a string can hold.
+ * 
+ */
+size_t CSTL_basic_string_max_size(CSTL_Type type);
+
+/**
+ * Reserves storage for at least `new_capacity` characters.
+ * 
+ * If `new_capacity` is greater than `CSTL_basic_string_max_size(type)` or an allocation fails,
+ * this function has no effect and returns `false`, otherwise it returns `true`.
+ * 
+ */
+bool CSTL_basic_string_reserve(CSTL_BasicStringRef instance, CSTL_Type type, size_t new_capacity, CSTL_Alloc* alloc);
+
+/**
+ * Reduces the capacity to fit the size of the string, moving the contents
+ * back into the inline buffer if they fit.
+ * 
+ * Has no effect if an allocation fails.
+ * 
+ */
+void CSTL_basic_string_shrink_to_fit(CSTL_BasicStringRef instance, CSTL_Type type, CSTL_Alloc* alloc);
+
+/**
+ * Erases all characters, keeping the capacity.
+ * 
+ */
+void CSTL_basic_string_clear(CSTL_BasicStringRef instance, CSTL_Type type);
+
+/**
+ * Appends the character at `ch` to the end of the string.
+ * 
+ * Returns `false` if the string is too long or an allocation fails,
+ * in which case it has no effect.
+ * 
+ */
+bool CSTL_basic_string_push_back(CSTL_BasicStringRef instance, CSTL_Type type, const void* ch, CSTL_Alloc* alloc);
+
+/**
+ * Removes the last character from the string.
+ * 
+ * If `CSTL_basic_string_empty(instance) == true` the behavior is undefined.
+ * 
+ */
+void CSTL_basic_string_pop_back(CSTL_BasicStringRef instance, CSTL_Type type);
+
+/**
+ * Appends the null-terminated string at `ptr`.
+ * 
+ * Returns `false` if the string would be too long or an allocation fails,
+ * in which case it has no effect.
+ * 
+ */
+bool CSTL_basic_string_append(CSTL_BasicStringRef instance, CSTL_Type type, const CSTL_CharTraits* traits, const void* ptr, CSTL_Alloc* alloc);
+
+/**
+ * Appends the first `count` characters of the string at `ptr`, which may be
+ * a part of the string itself.
+ * 
+ * Returns `false` if the string would be too long or an allocation fails,
+ * in which case it has no effect.
+ * 
+ */
+bool CSTL_basic_string_append_n(CSTL_BasicStringRef instance, CSTL_Type type, const void* ptr, size_t count, CSTL_Alloc* alloc);
+
+/**
+ * Appends `count` copies of the character at `ch`.
+ * 
+ * Returns `false` if the string would be too long or an allocation fails,
+ * in which case it has no effect.
+ * 
+ */
+bool CSTL_basic_string_append_char(CSTL_BasicStringRef instance, CSTL_Type type, size_t count, const void* ch, CSTL_Alloc* alloc);
+
+/**
+ * Appends the contents of `other_instance`, which may be the string itself.
+ * 
+ * Returns `false` if the string would be too long or an allocation fails,
+ * in which case it has no effect.
+ * 
+ */
+bool CSTL_basic_string_append_str(CSTL_BasicStringRef instance, CSTL_Type type, CSTL_BasicStringCRef other_instance, CSTL_Alloc* alloc);
+
+/**
+ * Inserts the first `count` characters of the string at `ptr`, which may be
+ * a part of the string itself, at offset `off`.
+ * 
+ * Returns `false` if `off > CSTL_basic_string_size(instance)`, the string would
+ * be too long or an allocation fails, in which case it has no effect.
+ * 
+ */
+bool CSTL_basic_string_insert_n_at(CSTL_BasicStringRef instance, CSTL_Type type, size_t off, const void* ptr, size_t count, CSTL_Alloc* alloc);
+
+/**
+ * Inserts `count` copies of the character at `ch` at offset `off`.
+ * 
+ * Returns `false` if `off > CSTL_basic_string_size(instance)`, the string would
+ * be too long or an allocation fails, in which case it has no effect.
+ * 
+ */
+bool CSTL_basic_string_insert_char_at(CSTL_BasicStringRef instance, CSTL_Type type, size_t off, size_t count, const void* ch, CSTL_Alloc* alloc);
+
+/**
+ * Erases at most `count` characters starting at offset `off`.
+ * 
+ * Returns `false` if `off > CSTL_basic_string_size(instance)`,
+ * in which case it has no effect.
+ * 
+ */
+bool CSTL_basic_string_erase_substr_at(CSTL_BasicStringRef instance, CSTL_Type type, size_t off, size_t count);
+
+/**
+ * Replaces at most `count` characters starting at offset `off` with the first `count2`
+ * characters of the string at `ptr`, which may be a part of the string itself.
+ * 
+ * Returns `false` if `off > CSTL_basic_string_size(instance)`, the string would
+ * be too long or an allocation fails, in which case it has no effect.
+ * 
+ */
+bool CSTL_basic_string_replace_n_at(CSTL_BasicStringRef instance, CSTL_Type type, size_t off, size_t count, const void* ptr, size_t count2, CSTL_Alloc* alloc);
+
+/**
+ * Resizes the string to `new_size` characters, appending copies of the character
+ * at `ch` if it grows.
+ * 
+ * Returns `false` if `new_size` is greater than `CSTL_basic_string_max_size(type)`
+ * or an allocation fails, in which case it has no effect.
+ * 
+ */
+bool CSTL_basic_string_resize(CSTL_BasicStringRef instance, CSTL_Type type, size_t new_size, const void* ch, CSTL_Alloc* alloc);
+
+/**
+ * Returns the index of the first occurrence of the first `count` characters at `ptr`
+ * in the string, starting at offset `off`, or `(size_t)-1` (npos) if there is none.
+ * 
+ * Uses the vectorised substring search if `traits` are the default traits of 1, 2
+ * or 4 byte characters.
+ * 
+ */
+size_t CSTL_basic_string_find_n(CSTL_BasicStringCRef instance, CSTL_Type type, const CSTL_CharTraits* traits, const void* ptr, size_t off, size_t count);
+
+/**
+ * Returns the index of the first occurrence of the character at `ch` in the string,
+ * starting at offset `off`, or `(size_t)-1` (npos) if there is none.
+ * 
+ */
+size_t CSTL_basic_string_find_char(CSTL_BasicStringCRef instance, CSTL_Type type, const CSTL_CharTraits* traits, const void* ch, size_t off);
+
+/**
+ * Returns the index of the last occurrence of the first `count` characters at `ptr`
+ * in the string that starts at or before offset `off`, or `(size_t)-1` (npos) if there is none.
+ * 
+ * Uses the vectorised substring search if `traits` are the default traits of 1, 2
+ * or 4 byte characters.
+ * 
+ */
+size_t CSTL_basic_string_rfind_n(CSTL_BasicStringCRef instance, CSTL_Type type, const CSTL_CharTraits* traits, const void* ptr, size_t off, size_t count);
+
+/**
+ * Returns the index of the last occurrence of the character at `ch` in the string
+ * at or before offset `off`, or `(size_t)-1` (npos) if there is none.
+ * 
+ */
+size_t CSTL_basic_string_rfind_char(CSTL_BasicStringCRef instance, CSTL_Type type, const CSTL_CharTraits* traits, const void* ch, size_t off);
+
+/**
+ * Compares the string at `left` of `left_count` characters to the string at `right`
+ * of `right_count` characters lexicographically.
+ * 
+ * Returns a negative value if `left` is ordered before `right`, zero if they
+ * are equal and a positive value otherwise.
+ * 
+ */
+int CSTL_basic_string_compare_nn(CSTL_Type type, const CSTL_CharTraits* traits, const void* left, size_t left_count, const void* right, size_t right_count);
+
+/**
+ * Compares the contents of `instance` to the contents of `other_instance` lexicographically,
+ * like `CSTL_basic_string_compare_nn`.
+ * 
+ */
+int CSTL_basic_string_compare_str(CSTL_BasicStringCRef instance, CSTL_Type type, const CSTL_CharTraits* traits, CSTL_BasicStringCRef other_instance);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
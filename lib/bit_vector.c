@@ -0,0 +1,640 @@
+#include "bit_vector.h"
+
+#include "internal/char_class.h"
+#include "internal/char_dispatch.h"
+#include "internal/char_simd.h"
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Bits per word, as `std::_VBITS`.
+#define CSTL_bit_vector_bits ((size_t)32)
+
+// Bitwise operations of the bulk kernels.
+#define CSTL_bit_and 0
+#define CSTL_bit_or  1
+#define CSTL_bit_xor 2
+
+// Number of words holding `size` bits, without overflowing.
+static inline size_t CSTL_bit_vector_words_for(size_t size) {
+    return size / CSTL_bit_vector_bits + (size % CSTL_bit_vector_bits != 0);
+}
+
+// Mask of the bits at or above `bit` in a word, `bit < 32`.
+static inline uint32_t CSTL_bit_vector_mask_from(size_t bit) {
+    return UINT32_MAX << bit;
+}
+
+// Mask of the bits below `bit` in a word, `0 < bit <= 32`.
+static inline uint32_t CSTL_bit_vector_mask_below(size_t bit) {
+    return UINT32_MAX >> (CSTL_bit_vector_bits - bit);
+}
+
+static inline uint32_t* CSTL_bit_vector_word_data(CSTL_BitVectorRef instance) {
+    return (uint32_t*)instance->words.first;
+}
+
+static inline const uint32_t* CSTL_bit_vector_const_word_data(CSTL_BitVectorCRef instance) {
+    return (const uint32_t*)instance->words.first;
+}
+
+// Clears the bits past the end of the last word, like `std::vector<bool>::_Trim`.
+static inline void CSTL_bit_vector_trim(CSTL_BitVectorRef instance) {
+    size_t tail = instance->size % CSTL_bit_vector_bits;
+
+    if (tail != 0) {
+        CSTL_bit_vector_word_data(instance)[instance->size / CSTL_bit_vector_bits] &= CSTL_bit_vector_mask_below(tail);
+    }
+}
+
+static inline unsigned CSTL_popcount32(uint32_t word) {
+    word = word - ((word >> 1) & 0x55555555u);
+    word = (word & 0x33333333u) + ((word >> 2) & 0x33333333u);
+    return (((word + (word >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24;
+}
+
+static inline uint32_t CSTL_scalar_bitwise_op(uint32_t lhs, uint32_t rhs, int op) {
+    switch (op) {
+    case CSTL_bit_and: return lhs & rhs;
+    case CSTL_bit_or:  return lhs | rhs;
+    default:           return lhs ^ rhs;
+    }
+}
+
+static inline void CSTL_scalar_bitwise(uint32_t* dst, const uint32_t* src, size_t count, int op) {
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] = CSTL_scalar_bitwise_op(dst[i], src[i], op);
+    }
+}
+
+static inline size_t CSTL_scalar_popcount(const uint32_t* words, size_t count) {
+    size_t total = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        total += CSTL_popcount32(words[i]);
+    }
+
+    return total;
+}
+
+// The vector kernels only process whole blocks and return the number
+// of words processed, the scalar kernels finish the rest.
+
+#ifdef CSTL_char_sse2
+static inline __m128i CSTL_sse2_bitwise_op(__m128i lhs, __m128i rhs, int op) {
+    switch (op) {
+    case CSTL_bit_and: return _mm_and_si128(lhs, rhs);
+    case CSTL_bit_or:  return _mm_or_si128(lhs, rhs);
+    default:           return _mm_xor_si128(lhs, rhs);
+    }
+}
+
+static inline size_t CSTL_sse2_bitwise(uint32_t* dst, const uint32_t* src, size_t count, int op) {
+    size_t i = 0;
+
+    for (; count - i >= 4; i += 4) {
+        __m128i lhs = _mm_loadu_si128((const __m128i*)(dst + i));
+        __m128i rhs = _mm_loadu_si128((const __m128i*)(src + i));
+        _mm_storeu_si128((__m128i*)(dst + i), CSTL_sse2_bitwise_op(lhs, rhs, op));
+    }
+
+    return i;
+}
+
+// SWAR bit count of each byte, summed by `psadbw` into two 64-bit lanes.
+static inline size_t CSTL_sse2_popcount(const uint32_t* words, size_t count, size_t* total) {
+    const __m128i m1 = _mm_set1_epi8(0x55);
+    const __m128i m2 = _mm_set1_epi8(0x33);
+    const __m128i m4 = _mm_set1_epi8(0x0F);
+
+    __m128i sum = _mm_setzero_si128();
+    size_t i    = 0;
+
+    for (; count - i >= 4; i += 4) {
+        __m128i data = _mm_loadu_si128((const __m128i*)(words + i));
+        data = _mm_sub_epi8(data, _mm_and_si128(_mm_srli_epi16(data, 1), m1));
+        data = _mm_add_epi8(_mm_and_si128(data, m2), _mm_and_si128(_mm_srli_epi16(data, 2), m2));
+        data = _mm_and_si128(_mm_add_epi8(data, _mm_srli_epi16(data, 4)), m4);
+        sum  = _mm_add_epi64(sum, _mm_sad_epu8(data, _mm_setzero_si128()));
+    }
+
+    uint64_t lanes[2];
+    _mm_storeu_si128((__m128i*)lanes, sum);
+
+    *total += (size_t)(lanes[0] + lanes[1]);
+    return i;
+}
+#endif
+
+#ifdef CSTL_char_avx2
+CSTL_target_avx2 static inline size_t CSTL_avx2_bitwise(uint32_t* dst, const uint32_t* src, size_t count, int op) {
+    size_t i = 0;
+
+    for (; count - i >= 8; i += 8) {
+        __m256i lhs = _mm256_loadu_si256((const __m256i*)(dst + i));
+        __m256i rhs = _mm256_loadu_si256((const __m256i*)(src + i));
+        __m256i result;
+
+        switch (op) {
+        case CSTL_bit_and: result = _mm256_and_si256(lhs, rhs); break;
+        case CSTL_bit_or:  result = _mm256_or_si256(lhs, rhs); break;
+        default:           result = _mm256_xor_si256(lhs, rhs); break;
+        }
+
+        _mm256_storeu_si256((__m256i*)(dst + i), result);
+    }
+
+    return i;
+}
+
+// Counts the bits of each nibble with a `vpshufb` table lookup.
+CSTL_target_avx2 static size_t CSTL_avx2_popcount(const uint32_t* words, size_t count, size_t* total) {
+    const __m256i lookup = _mm256_setr_epi8(
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low = _mm256_set1_epi8(0x0F);
+
+    __m256i sum = _mm256_setzero_si256();
+    size_t i    = 0;
+
+    for (; count - i >= 8; i += 8) {
+        __m256i data   = _mm256_loadu_si256((const __m256i*)(words + i));
+        __m256i counts = _mm256_add_epi8(
+            _mm256_shuffle_epi8(lookup, _mm256_and_si256(data, low)),
+            _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(data, 4), low)));
+        sum = _mm256_add_epi64(sum, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+    }
+
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, sum);
+
+    *total += (size_t)(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+    return i;
+}
+
+// Out of line entry points, so the AVX2 bodies are never inlined into
+// functions compiled for the baseline target.
+
+CSTL_target_avx2 static size_t CSTL_avx2_and(uint32_t* dst, const uint32_t* src, size_t count) {
+    return CSTL_avx2_bitwise(dst, src, count, CSTL_bit_and);
+}
+
+CSTL_target_avx2 static size_t CSTL_avx2_or(uint32_t* dst, const uint32_t* src, size_t count) {
+    return CSTL_avx2_bitwise(dst, src, count, CSTL_bit_or);
+}
+
+CSTL_target_avx2 static size_t CSTL_avx2_xor(uint32_t* dst, const uint32_t* src, size_t count) {
+    return CSTL_avx2_bitwise(dst, src, count, CSTL_bit_xor);
+}
+
+static inline size_t CSTL_avx2_bitwise_n(uint32_t* dst, const uint32_t* src, size_t count, int op) {
+    switch (op) {
+    case CSTL_bit_and: return CSTL_avx2_and(dst, src, count);
+    case CSTL_bit_or:  return CSTL_avx2_or(dst, src, count);
+    default:           return CSTL_avx2_xor(dst, src, count);
+    }
+}
+#endif
+
+#ifdef CSTL_char_neon
+static inline size_t CSTL_neon_bitwise(uint32_t* dst, const uint32_t* src, size_t count, int op) {
+    size_t i = 0;
+
+    for (; count - i >= 4; i += 4) {
+        uint32x4_t lhs = vld1q_u32(dst + i);
+        uint32x4_t rhs = vld1q_u32(src + i);
+        uint32x4_t result;
+
+        switch (op) {
+        case CSTL_bit_and: result = vandq_u32(lhs, rhs); break;
+        case CSTL_bit_or:  result = vorrq_u32(lhs, rhs); break;
+        default:           result = veorq_u32(lhs, rhs); break;
+        }
+
+        vst1q_u32(dst + i, result);
+    }
+
+    return i;
+}
+
+static inline size_t CSTL_neon_popcount(const uint32_t* words, size_t count, size_t* total) {
+    uint64x2_t sum = vdupq_n_u64(0);
+    size_t i       = 0;
+
+    for (; count - i >= 4; i += 4) {
+        uint8x16_t counts = vcntq_u8(vld1q_u8((const uint8_t*)(words + i)));
+        sum = vaddq_u64(sum, vpaddlq_u32(vpaddlq_u16(vpaddlq_u8(counts))));
+    }
+
+    *total += (size_t)(vgetq_lane_u64(sum, 0) + vgetq_lane_u64(sum, 1));
+    return i;
+}
+#endif
+
+static inline void CSTL_bit_vector_bitwise(uint32_t* dst, const uint32_t* src, size_t count, int op) {
+    size_t done = 0;
+
+#if defined(CSTL_char_sse2)
+#if defined(CSTL_char_avx2)
+    if (count >= 8 && CSTL_has_avx2()) {
+        done = CSTL_avx2_bitwise_n(dst, src, count, op);
+    } else {
+        done = CSTL_sse2_bitwise(dst, src, count, op);
+    }
+#else
+    done = CSTL_sse2_bitwise(dst, src, count, op);
+#endif
+#elif defined(CSTL_char_neon)
+    done = CSTL_neon_bitwise(dst, src, count, op);
+#endif
+
+    CSTL_scalar_bitwise(dst + done, src + done, count - done, op);
+}
+
+static inline size_t CSTL_bit_vector_popcount(const uint32_t* words, size_t count) {
+    size_t total = 0;
+    size_t done  = 0;
+
+#if defined(CSTL_char_sse2)
+#if defined(CSTL_char_avx2)
+    if (count >= 8 && CSTL_has_avx2()) {
+        done = CSTL_avx2_popcount(words, count, &total);
+    } else {
+        done = CSTL_sse2_popcount(words, count, &total);
+    }
+#else
+    done = CSTL_sse2_popcount(words, count, &total);
+#endif
+#elif defined(CSTL_char_neon)
+    done = CSTL_neon_popcount(words, count, &total);
+#endif
+
+    return total + CSTL_scalar_popcount(words + done, count - done);
+}
+
+// Clears (`and`), sets (`or`) or inverts (`xor`) the bits in `[first, last)`.
+static inline void CSTL_bit_vector_apply_range(CSTL_BitVectorRef instance, size_t first, size_t last, int op) {
+    if (first == last) {
+        return;
+    }
+
+    uint32_t* words   = CSTL_bit_vector_word_data(instance);
+    size_t first_word = first / CSTL_bit_vector_bits;
+    size_t last_word  = (last - 1) / CSTL_bit_vector_bits;
+    uint32_t head     = CSTL_bit_vector_mask_from(first % CSTL_bit_vector_bits);
+    uint32_t tail     = CSTL_bit_vector_mask_below(last - last_word * CSTL_bit_vector_bits);
+
+    // `and` clears the masked bits, so it is applied with the inverted mask.
+    uint32_t flip_mask = op == CSTL_bit_and ? UINT32_MAX : 0;
+
+    if (first_word == last_word) {
+        words[first_word] = CSTL_scalar_bitwise_op(words[first_word], (head & tail) ^ flip_mask, op);
+        return;
+    }
+
+    words[first_word] = CSTL_scalar_bitwise_op(words[first_word], head ^ flip_mask, op);
+    words[last_word]  = CSTL_scalar_bitwise_op(words[last_word], tail ^ flip_mask, op);
+
+    uint32_t* middle = words + first_word + 1;
+    size_t count     = last_word - first_word - 1;
+
+    switch (op) {
+    case CSTL_bit_and: memset(middle, 0, count * sizeof(uint32_t)); break;
+    case CSTL_bit_or:  memset(middle, 0xFF, count * sizeof(uint32_t)); break;
+    default:
+        for (size_t i = 0; i < count; ++i) {
+            middle[i] = ~middle[i];
+        }
+        break;
+    }
+}
+
+// Returns the index of the first bit at or after `off` that equals `value`, or `size`.
+static inline size_t CSTL_bit_vector_find(CSTL_BitVectorCRef instance, size_t off, bool value) {
+    size_t size = instance->size;
+
+    if (off >= size) {
+        return size;
+    }
+
+    const uint32_t* words = CSTL_bit_vector_const_word_data(instance);
+    uint32_t invert       = value ? 0 : UINT32_MAX;
+    size_t word_index     = off / CSTL_bit_vector_bits;
+    uint32_t word         = (words[word_index] ^ invert) & CSTL_bit_vector_mask_from(off % CSTL_bit_vector_bits);
+
+    if (word == 0) {
+        // Skip whole words without a matching bit with a vectorised scan.
+        size_t next  = word_index + 1;
+        size_t count = CSTL_bit_vector_words_for(size) - next;
+        size_t found = CSTL_char_find_not_of_4(words + next, count, &invert, 1);
+
+        if (found == count) {
+            return size;
+        }
+
+        word_index = next + found;
+        word       = words[word_index] ^ invert;
+    }
+
+    size_t pos = word_index * CSTL_bit_vector_bits + CSTL_ctz32(word);
+
+    // Clear bits past the end read as unset.
+    return pos < size ? pos : size;
+}
+
+void CSTL_bit_vector_construct(CSTL_BitVectorVal* new_instance) {
+    CSTL_vector_construct(&new_instance->words);
+    new_instance->size = 0;
+}
+
+void CSTL_bit_vector_destroy(CSTL_BitVectorRef instance, CSTL_Alloc* alloc) {
+    CSTL_PodType pod = CSTL_pod_uint32;
+    CSTL_vector_destroy(&instance->words, pod.type, &pod.copy.move_type.drop_type, alloc);
+    instance->size = 0;
+}
+
+bool CSTL_bit_vector_copy_assign(CSTL_BitVectorRef instance, CSTL_BitVectorCRef other_instance, CSTL_Alloc* alloc) {
+    if (instance == other_instance) {
+        return true;
+    }
+
+    CSTL_PodType pod = CSTL_pod_uint32;
+
+    if (!CSTL_vector_copy_assign(&instance->words, pod.type, &pod.copy, &other_instance->words, alloc, alloc, false)) {
+        return false;
+    }
+
+    instance->size = other_instance->size;
+    return true;
+}
+
+bool CSTL_bit_vector_assign_n(CSTL_BitVectorRef instance, size_t new_size, bool value, CSTL_Alloc* alloc) {
+    if (new_size > CSTL_bit_vector_max_size()) {
+        return false;
+    }
+
+    CSTL_PodType pod = CSTL_pod_uint32;
+    uint32_t fill    = value ? UINT32_MAX : 0;
+
+    if (!CSTL_vector_assign_n(&instance->words, pod.type, &pod.copy, CSTL_bit_vector_words_for(new_size), &fill, alloc)) {
+        return false;
+    }
+
+    instance->size = new_size;
+    CSTL_bit_vector_trim(instance);
+    return true;
+}
+
+void CSTL_bit_vector_swap(CSTL_BitVectorRef instance, CSTL_BitVectorRef other_instance) {
+    CSTL_vector_swap(&instance->words, &other_instance->words);
+
+    size_t size          = instance->size;
+    instance->size       = other_instance->size;
+    other_instance->size = size;
+}
+
+bool CSTL_bit_vector_empty(CSTL_BitVectorCRef instance) {
+    return instance->size == 0;
+}
+
+size_t CSTL_bit_vector_size(CSTL_BitVectorCRef instance) {
+    return instance->size;
+}
+
+size_t CSTL_bit_vector_capacity(CSTL_BitVectorCRef instance) {
+    size_t word_capacity = CSTL_vector_capacity(&instance->words, CSTL_pod_uint32.type);
+
+    if (word_capacity > SIZE_MAX / CSTL_bit_vector_bits) {
+        return SIZE_MAX;
+    }
+
+    return word_capacity * CSTL_bit_vector_bits;
+}
+
+size_t CSTL_bit_vector_max_size(void) {
+    size_t word_max = CSTL_vector_max_size(CSTL_pod_uint32.type);
+
+    if (word_max > SIZE_MAX / CSTL_bit_vector_bits) {
+        return SIZE_MAX;
+    }
+
+    return word_max * CSTL_bit_vector_bits;
+}
+
+uint32_t* CSTL_bit_vector_words(CSTL_BitVectorRef instance) {
+    return CSTL_bit_vector_word_data(instance);
+}
+
+const uint32_t* CSTL_bit_vector_const_words(CSTL_BitVectorCRef instance) {
+    return CSTL_bit_vector_const_word_data(instance);
+}
+
+size_t CSTL_bit_vector_word_count(CSTL_BitVectorCRef instance) {
+    return CSTL_bit_vector_words_for(instance->size);
+}
+
+bool CSTL_bit_vector_reserve(CSTL_BitVectorRef instance, size_t new_capacity, CSTL_Alloc* alloc) {
+    if (new_capacity > CSTL_bit_vector_max_size()) {
+        return false;
+    }
+
+    CSTL_PodType pod = CSTL_pod_uint32;
+    return CSTL_vector_reserve(&instance->words, pod.type, &pod.copy.move_type, CSTL_bit_vector_words_for(new_capacity), alloc);
+}
+
+bool CSTL_bit_vector_shrink_to_fit(CSTL_BitVectorRef instance, CSTL_Alloc* alloc) {
+    CSTL_PodType pod = CSTL_pod_uint32;
+    return CSTL_vector_shrink_to_fit(&instance->words, pod.type, &pod.copy.move_type, alloc);
+}
+
+bool CSTL_bit_vector_resize(CSTL_BitVectorRef instance, size_t new_size, bool value, CSTL_Alloc* alloc) {
+    if (new_size > CSTL_bit_vector_max_size()) {
+        return false;
+    }
+
+    CSTL_PodType pod = CSTL_pod_uint32;
+    size_t old_size  = instance->size;
+    size_t new_words = CSTL_bit_vector_words_for(new_size);
+
+    if (new_size <= old_size) {
+        CSTL_vector_truncate(&instance->words, pod.type, &pod.copy.move_type.drop_type, new_words);
+        instance->size = new_size;
+        CSTL_bit_vector_trim(instance);
+        return true;
+    }
+
+    // New whole words are filled directly, only the old partial word needs masking.
+    uint32_t fill = value ? UINT32_MAX : 0;
+
+    if (!CSTL_vector_resize(&instance->words, pod.type, &pod.copy, new_words, &fill, alloc)) {
+        return false;
+    }
+
+    instance->size = new_size;
+
+    if (value) {
+        size_t old_end = CSTL_bit_vector_words_for(old_size) * CSTL_bit_vector_bits;
+        CSTL_bit_vector_apply_range(instance, old_size, old_end < new_size ? old_end : new_size, CSTL_bit_or);
+    }
+
+    CSTL_bit_vector_trim(instance);
+    return true;
+}
+
+void CSTL_bit_vector_clear(CSTL_BitVectorRef instance) {
+    CSTL_vector_clear(&instance->words, &CSTL_pod_uint32.copy.move_type.drop_type);
+    instance->size = 0;
+}
+
+bool CSTL_bit_vector_push_back(CSTL_BitVectorRef instance, bool value, CSTL_Alloc* alloc) {
+    size_t size = instance->size;
+
+    if (size == CSTL_bit_vector_max_size()) {
+        return false;
+    }
+
+    if (size % CSTL_bit_vector_bits == 0) {
+        CSTL_PodType pod = CSTL_pod_uint32;
+        uint32_t word    = value;
+
+        if (!CSTL_vector_copy_push_back(&instance->words, pod.type, &pod.copy, &word, alloc)) {
+            return false;
+        }
+    } else if (value) {
+        CSTL_bit_vector_word_data(instance)[size / CSTL_bit_vector_bits] |= (uint32_t)1 << (size % CSTL_bit_vector_bits);
+    }
+
+    instance->size = size + 1;
+    return true;
+}
+
+void CSTL_bit_vector_pop_back(CSTL_BitVectorRef instance) {
+    assert(instance->size != 0);
+
+    size_t size = --instance->size;
+
+    if (size % CSTL_bit_vector_bits == 0) {
+        CSTL_PodType pod = CSTL_pod_uint32;
+        CSTL_vector_pop_back(&instance->words, pod.type, &pod.copy.move_type.drop_type);
+    } else {
+        CSTL_bit_vector_trim(instance);
+    }
+}
+
+bool CSTL_bit_vector_test(CSTL_BitVectorCRef instance, size_t pos) {
+    assert(pos < instance->size);
+
+    return (CSTL_bit_vector_const_word_data(instance)[pos / CSTL_bit_vector_bits] >> (pos % CSTL_bit_vector_bits)) & 1;
+}
+
+void CSTL_bit_vector_assign_bit(CSTL_BitVectorRef instance, size_t pos, bool value) {
+    if (value) {
+        CSTL_bit_vector_set(instance, pos);
+    } else {
+        CSTL_bit_vector_reset(instance, pos);
+    }
+}
+
+void CSTL_bit_vector_set(CSTL_BitVectorRef instance, size_t pos) {
+    assert(pos < instance->size);
+
+    CSTL_bit_vector_word_data(instance)[pos / CSTL_bit_vector_bits] |= (uint32_t)1 << (pos % CSTL_bit_vector_bits);
+}
+
+void CSTL_bit_vector_reset(CSTL_BitVectorRef instance, size_t pos) {
+    assert(pos < instance->size);
+
+    CSTL_bit_vector_word_data(instance)[pos / CSTL_bit_vector_bits] &= ~((uint32_t)1 << (pos % CSTL_bit_vector_bits));
+}
+
+void CSTL_bit_vector_flip(CSTL_BitVectorRef instance, size_t pos) {
+    assert(pos < instance->size);
+
+    CSTL_bit_vector_word_data(instance)[pos / CSTL_bit_vector_bits] ^= (uint32_t)1 << (pos % CSTL_bit_vector_bits);
+}
+
+void CSTL_bit_vector_set_range(CSTL_BitVectorRef instance, size_t first, size_t last) {
+    assert(first <= last && last <= instance->size);
+
+    CSTL_bit_vector_apply_range(instance, first, last, CSTL_bit_or);
+}
+
+void CSTL_bit_vector_reset_range(CSTL_BitVectorRef instance, size_t first, size_t last) {
+    assert(first <= last && last <= instance->size);
+
+    CSTL_bit_vector_apply_range(instance, first, last, CSTL_bit_and);
+}
+
+void CSTL_bit_vector_flip_range(CSTL_BitVectorRef instance, size_t first, size_t last) {
+    assert(first <= last && last <= instance->size);
+
+    CSTL_bit_vector_apply_range(instance, first, last, CSTL_bit_xor);
+}
+
+size_t CSTL_bit_vector_find_first_set(CSTL_BitVectorCRef instance, size_t off) {
+    return CSTL_bit_vector_find(instance, off, true);
+}
+
+size_t CSTL_bit_vector_find_first_unset(CSTL_BitVectorCRef instance, size_t off) {
+    return CSTL_bit_vector_find(instance, off, false);
+}
+
+size_t CSTL_bit_vector_count(CSTL_BitVectorCRef instance) {
+    return CSTL_bit_vector_popcount(CSTL_bit_vector_const_word_data(instance), CSTL_bit_vector_words_for(instance->size));
+}
+
+size_t CSTL_bit_vector_count_range(CSTL_BitVectorCRef instance, size_t first, size_t last) {
+    assert(first <= last && last <= instance->size);
+
+    if (first == last) {
+        return 0;
+    }
+
+    const uint32_t* words = CSTL_bit_vector_const_word_data(instance);
+    size_t first_word     = first / CSTL_bit_vector_bits;
+    size_t last_word      = (last - 1) / CSTL_bit_vector_bits;
+    uint32_t head         = CSTL_bit_vector_mask_from(first % CSTL_bit_vector_bits);
+    uint32_t tail         = CSTL_bit_vector_mask_below(last - last_word * CSTL_bit_vector_bits);
+
+    if (first_word == last_word) {
+        return CSTL_popcount32(words[first_word] & head & tail);
+    }
+
+    return CSTL_popcount32(words[first_word] & head)
+        + CSTL_bit_vector_popcount(words + first_word + 1, last_word - first_word - 1)
+        + CSTL_popcount32(words[last_word] & tail);
+}
+
+void CSTL_bit_vector_and_assign(CSTL_BitVectorRef instance, CSTL_BitVectorCRef other_instance) {
+    assert(instance->size == other_instance->size);
+
+    CSTL_bit_vector_bitwise(CSTL_bit_vector_word_data(instance), CSTL_bit_vector_const_word_data(other_instance),
+        CSTL_bit_vector_words_for(instance->size), CSTL_bit_and);
+}
+
+void CSTL_bit_vector_or_assign(CSTL_BitVectorRef instance, CSTL_BitVectorCRef other_instance) {
+    assert(instance->size == other_instance->size);
+
+    CSTL_bit_vector_bitwise(CSTL_bit_vector_word_data(instance), CSTL_bit_vector_const_word_data(other_instance),
+        CSTL_bit_vector_words_for(instance->size), CSTL_bit_or);
+}
+
+void CSTL_bit_vector_xor_assign(CSTL_BitVectorRef instance, CSTL_BitVectorCRef other_instance) {
+    assert(instance->size == other_instance->size);
+
+    CSTL_bit_vector_bitwise(CSTL_bit_vector_word_data(instance), CSTL_bit_vector_const_word_data(other_instance),
+        CSTL_bit_vector_words_for(instance->size), CSTL_bit_xor);
+}
+
+bool CSTL_bit_vector_equal(CSTL_BitVectorCRef instance, CSTL_BitVectorCRef other_instance) {
+    if (instance->size != other_instance->size) {
+        return false;
+    }
+
+    size_t count = CSTL_bit_vector_words_for(instance->size);
+
+    return CSTL_char_mismatch_4(CSTL_bit_vector_const_word_data(instance), CSTL_bit_vector_const_word_data(other_instance), count) == count;
+}
@@ -0,0 +1,319 @@
+#pragma once
+
+#ifndef CSTL_BIT_VECTOR_H
+#define CSTL_BIT_VECTOR_H
+
+#include "alloc.h"
+#include "vector.h"
+
+#if defined(__cplusplus)
+#include <cstddef>
+#include <cstdint>
+extern "C" {
+#else
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#endif
+
+/**
+ * STL ABI `std::vector<bool>` layout.
+ * 
+ * Bits are packed into a vector of 32-bit words, least significant bit first,
+ * followed by the number of bits. Bits past the end of the last word are
+ * always kept clear, so whole words can be compared, counted and combined.
+ * 
+ * Does not include the allocator, which nonetheless is a part of the `std::vector<bool>`
+ * structure! You are responsible for including it, since it can take on any form.
+ * 
+ * Do not manipulate the members directly, use the associated functions!
+ * 
+ */
+typedef struct CSTL_BitVectorVal {
+    CSTL_VectorVal words;
+    size_t size;
+} CSTL_BitVectorVal;
+
+/**
+ * Reference to a mutable `CSTL_BitVectorVal`.
+ * 
+ * Must not be null.
+ * 
+ */
+typedef CSTL_BitVectorVal* CSTL_BitVectorRef;
+
+/**
+ * Reference to a const `CSTL_BitVectorVal`.
+ * 
+ * Must not be null.
+ * 
+ */
+typedef const CSTL_BitVectorVal* CSTL_BitVectorCRef;
+
+/**
+ * Initializes the bit vector pointed to by `new_instance`, but does not allocate any memory.
+ * 
+ */
+void CSTL_bit_vector_construct(CSTL_BitVectorVal* new_instance);
+
+/**
+ * Destroys the bit vector pointed to by `instance`, freeing the backing storage.
+ * 
+ */
+void CSTL_bit_vector_destroy(CSTL_BitVectorRef instance, CSTL_Alloc* alloc);
+
+/**
+ * Replaces the contents of `instance` with a copy of the contents of `other_instance`.
+ * 
+ * If the allocation fails, this function has no effect and returns `false`,
+ * otherwise it returns `true`.
+ * 
+ */
+bool CSTL_bit_vector_copy_assign(CSTL_BitVectorRef instance, CSTL_BitVectorCRef other_instance, CSTL_Alloc* alloc);
+
+/**
+ * Replaces the contents of `instance` with `new_size` copies of `value`.
+ * 
+ * If `new_size > CSTL_bit_vector_max_size()` (vector too long) or the allocation
+ * fails, this function has no effect and returns `false`, otherwise it returns `true`.
+ * 
+ */
+bool CSTL_bit_vector_assign_n(CSTL_BitVectorRef instance, size_t new_size, bool value, CSTL_Alloc* alloc);
+
+/**
+ * Swaps bit vector contents.
+ * 
+ * You are responsible for swapping the allocators.
+ * 
+ */
+void CSTL_bit_vector_swap(CSTL_BitVectorRef instance, CSTL_BitVectorRef other_instance);
+
+/**
+ * Returns `true` if the bit vector is empty or `false` otherwise.
+ * 
+ */
+bool CSTL_bit_vector_empty(CSTL_BitVectorCRef instance);
+
+/**
+ * Returns the number of bits in the bit vector.
+ * 
+ */
+size_t CSTL_bit_vector_size(CSTL_BitVectorCRef instance);
+
+/**
+ * Returns the number of bits the bit vector can hold without reallocating.
+ * 
+ */
+size_t CSTL_bit_vector_capacity(CSTL_BitVectorCRef instance);
+
+/**
+ * Returns the maximum possible number of bits in the bit vector.
+ * 
+ */
+size_t CSTL_bit_vector_max_size(void);
+
+/**
+ * Returns a pointer to the first word of the bit vector.
+ * 
+ * Bit `pos` is bit `pos % 32` of word `pos / 32`. Bits past
+ * `CSTL_bit_vector_size(instance)` in the last word must be left clear.
+ * 
+ */
+uint32_t* CSTL_bit_vector_words(CSTL_BitVectorRef instance);
+
+/**
+ * Returns a const pointer to the first word of the bit vector.
+ * 
+ */
+const uint32_t* CSTL_bit_vector_const_words(CSTL_BitVectorCRef instance);
+
+/**
+ * Returns the number of words in use, as if by `(CSTL_bit_vector_size(instance) + 31) / 32`.
+ * 
+ */
+size_t CSTL_bit_vector_word_count(CSTL_BitVectorCRef instance);
+
+/**
+ * If `new_capacity > CSTL_bit_vector_capacity(instance)`, reallocates and expands
+ * the bit vector storage.
+ * 
+ * If `new_capacity > CSTL_bit_vector_max_size()` (vector too long) or the allocation
+ * fails, this function has no effect and returns `false`, otherwise it returns `true`.
+ * 
+ */
+bool CSTL_bit_vector_reserve(CSTL_BitVectorRef instance, size_t new_capacity, CSTL_Alloc* alloc);
+
+/**
+ * Request removal of unused capacity.
+ * 
+ * If a reallocation occurs and fails returns `false`, otherwise
+ * always returns `true`.
+ * 
+ */
+bool CSTL_bit_vector_shrink_to_fit(CSTL_BitVectorRef instance, CSTL_Alloc* alloc);
+
+/**
+ * Resizes the bit vector to contain `new_size` bits, new bits are set to `value`.
+ * 
+ * If `new_size > CSTL_bit_vector_max_size()` (vector too long) or the allocation
+ * fails, this function has no effect and returns `false`, otherwise it returns `true`.
+ * 
+ */
+bool CSTL_bit_vector_resize(CSTL_BitVectorRef instance, size_t new_size, bool value, CSTL_Alloc* alloc);
+
+/**
+ * Erase all bits from the bit vector without affecting capacity.
+ * 
+ */
+void CSTL_bit_vector_clear(CSTL_BitVectorRef instance);
+
+/**
+ * Appends `value` to the end of the bit vector.
+ * 
+ * If `CSTL_bit_vector_size(instance) == CSTL_bit_vector_max_size()` (vector too long)
+ * or the allocation fails, this function has no effect and returns `false`,
+ * otherwise it returns `true`.
+ * 
+ */
+bool CSTL_bit_vector_push_back(CSTL_BitVectorRef instance, bool value, CSTL_Alloc* alloc);
+
+/**
+ * Removes the last bit from the bit vector.
+ * 
+ * If `CSTL_bit_vector_empty(instance) == true` the behavior is undefined.
+ * 
+ */
+void CSTL_bit_vector_pop_back(CSTL_BitVectorRef instance);
+
+/**
+ * Returns the value of the bit at `pos`.
+ * 
+ * If `pos >= CSTL_bit_vector_size(instance)` the behavior is undefined.
+ * 
+ */
+bool CSTL_bit_vector_test(CSTL_BitVectorCRef instance, size_t pos);
+
+/**
+ * Sets the bit at `pos` to `value`.
+ * 
+ * If `pos >= CSTL_bit_vector_size(instance)` the behavior is undefined.
+ * 
+ */
+void CSTL_bit_vector_assign_bit(CSTL_BitVectorRef instance, size_t pos, bool value);
+
+/**
+ * Sets the bit at `pos` to `true`.
+ * 
+ * If `pos >= CSTL_bit_vector_size(instance)` the behavior is undefined.
+ * 
+ */
+void CSTL_bit_vector_set(CSTL_BitVectorRef instance, size_t pos);
+
+/**
+ * Sets the bit at `pos` to `false`.
+ * 
+ * If `pos >= CSTL_bit_vector_size(instance)` the behavior is undefined.
+ * 
+ */
+void CSTL_bit_vector_reset(CSTL_BitVectorRef instance, size_t pos);
+
+/**
+ * Inverts the bit at `pos`.
+ * 
+ * If `pos >= CSTL_bit_vector_size(instance)` the behavior is undefined.
+ * 
+ */
+void CSTL_bit_vector_flip(CSTL_BitVectorRef instance, size_t pos);
+
+/**
+ * Sets the bits in `[first, last)` to `true`, a word at a time.
+ * 
+ * If `first > last || last > CSTL_bit_vector_size(instance)` the behavior is undefined.
+ * 
+ */
+void CSTL_bit_vector_set_range(CSTL_BitVectorRef instance, size_t first, size_t last);
+
+/**
+ * Sets the bits in `[first, last)` to `false`, a word at a time.
+ * 
+ * If `first > last || last > CSTL_bit_vector_size(instance)` the behavior is undefined.
+ * 
+ */
+void CSTL_bit_vector_reset_range(CSTL_BitVectorRef instance, size_t first, size_t last);
+
+/**
+ * Inverts the bits in `[first, last)`, a word at a time.
+ * 
+ * Inverting `[0, CSTL_bit_vector_size(instance))` is equivalent to `std::vector<bool>::flip`.
+ * 
+ * If `first > last || last > CSTL_bit_vector_size(instance)` the behavior is undefined.
+ * 
+ */
+void CSTL_bit_vector_flip_range(CSTL_BitVectorRef instance, size_t first, size_t last);
+
+/**
+ * Returns the index of the first set bit at or after `off`,
+ * or `CSTL_bit_vector_size(instance)` if there is no such bit.
+ * 
+ */
+size_t CSTL_bit_vector_find_first_set(CSTL_BitVectorCRef instance, size_t off);
+
+/**
+ * Returns the index of the first clear bit at or after `off`,
+ * or `CSTL_bit_vector_size(instance)` if there is no such bit.
+ * 
+ */
+size_t CSTL_bit_vector_find_first_unset(CSTL_BitVectorCRef instance, size_t off);
+
+/**
+ * Returns the number of set bits in the bit vector.
+ * 
+ */
+size_t CSTL_bit_vector_count(CSTL_BitVectorCRef instance);
+
+/**
+ * Returns the number of set bits in `[first, last)`.
+ * 
+ * If `first > last || last > CSTL_bit_vector_size(instance)` the behavior is undefined.
+ * 
+ */
+size_t CSTL_bit_vector_count_range(CSTL_BitVectorCRef instance, size_t first, size_t last);
+
+/**
+ * Replaces every bit of `instance` with its bitwise AND with the matching bit of `other_instance`.
+ * 
+ * If `CSTL_bit_vector_size(instance) != CSTL_bit_vector_size(other_instance)`
+ * the behavior is undefined.
+ * 
+ */
+void CSTL_bit_vector_and_assign(CSTL_BitVectorRef instance, CSTL_BitVectorCRef other_instance);
+
+/**
+ * Replaces every bit of `instance` with its bitwise OR with the matching bit of `other_instance`.
+ * 
+ * If `CSTL_bit_vector_size(instance) != CSTL_bit_vector_size(other_instance)`
+ * the behavior is undefined.
+ * 
+ */
+void CSTL_bit_vector_or_assign(CSTL_BitVectorRef instance, CSTL_BitVectorCRef other_instance);
+
+/**
+ * Replaces every bit of `instance` with its bitwise XOR with the matching bit of `other_instance`.
+ * 
+ * If `CSTL_bit_vector_size(instance) != CSTL_bit_vector_size(other_instance)`
+ * the behavior is undefined.
+ * 
+ */
+void CSTL_bit_vector_xor_assign(CSTL_BitVectorRef instance, CSTL_BitVectorCRef other_instance);
+
+/**
+ * Returns `true` if both bit vectors have the same size and bits, or `false` otherwise.
+ * 
+ */
+bool CSTL_bit_vector_equal(CSTL_BitVectorCRef instance, CSTL_BitVectorCRef other_instance);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
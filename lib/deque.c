@@ -0,0 +1,484 @@
+#include "deque.h"
+
+#include "internal/alloc_dispatch.h"
+#include "internal/type_ext.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define CSTL_deque_min_map_size ((size_t)8)
+
+// Elements per block, as `_DEQUESIZ` in `std::deque`.
+static inline size_t CSTL_deque_block_elements(size_t type_size) {
+    return type_size <= 1 ? 16 : type_size <= 2 ? 8 : type_size <= 4 ? 4 : type_size <= 8 ? 2 : 1;
+}
+
+static inline size_t CSTL_deque_get_block(CSTL_DequeCRef instance, size_t block_size, size_t offset) {
+    return (offset / block_size) & (instance->map_size - 1);
+}
+
+// Pointer to the element at `offset` into the concatenated blocks.
+static inline char* CSTL_deque_element(CSTL_DequeCRef instance, size_t type_size, size_t block_size, size_t offset) {
+    char* block = instance->map[CSTL_deque_get_block(instance, block_size, offset)];
+    return block + (offset % block_size) * type_size;
+}
+
+static inline void CSTL_deque_free_map(CSTL_DequeRef instance, CSTL_Alloc* alloc) {
+    if (instance->map != NULL) {
+        CSTL_free(instance->map, instance->map_size * sizeof(void*), _Alignof(void*), alloc);
+    }
+}
+
+// Grows the map by at least `count` block pointers, like `std::deque::_Growmap`.
+// The blocks keep their position relative to the first one in the circular map.
+static bool CSTL_deque_grow_map(CSTL_DequeRef instance, CSTL_Type type, size_t count, CSTL_Alloc* alloc) {
+    size_t block_size = CSTL_deque_block_elements(CSTL_type_size(type));
+    size_t map_size   = instance->map_size;
+    size_t new_size   = map_size > 0 ? map_size : 1;
+
+    while (new_size - map_size < count || new_size < CSTL_deque_min_map_size) {
+        if (CSTL_deque_max_size(type) / block_size - new_size < new_size) {
+            return false;
+        }
+
+        new_size *= 2;
+    }
+
+    count = new_size - map_size;
+
+    void** new_map = CSTL_allocate(new_size * sizeof(void*), _Alignof(void*), alloc);
+
+    if (new_map == NULL) {
+        return false;
+    }
+
+    void** old_map     = instance->map;
+    size_t first_block = instance->offset / block_size;
+    size_t i           = 0;
+
+    if (map_size == 0) {
+        for (; i < new_size; ++i) {
+            new_map[i] = NULL;
+        }
+    } else if (first_block <= count) {
+        // Unwrap the blocks before the first one past the end of the old map.
+        memcpy(new_map + first_block, old_map + first_block, (map_size - first_block) * sizeof(void*));
+        memcpy(new_map + map_size, old_map, first_block * sizeof(void*));
+
+        for (i = map_size + first_block; i < new_size; ++i) {
+            new_map[i] = NULL;
+        }
+
+        for (i = 0; i < first_block; ++i) {
+            new_map[i] = NULL;
+        }
+    } else {
+        // Unwrap only the first `count` blocks, and shift the others to the start.
+        memcpy(new_map + first_block, old_map + first_block, (map_size - first_block) * sizeof(void*));
+        memcpy(new_map + map_size, old_map, count * sizeof(void*));
+        memcpy(new_map, old_map + count, (first_block - count) * sizeof(void*));
+
+        for (i = first_block - count; i < first_block; ++i) {
+            new_map[i] = NULL;
+        }
+    }
+
+    CSTL_deque_free_map(instance, alloc);
+
+    instance->map      = new_map;
+    instance->map_size = new_size;
+
+    return true;
+}
+
+// Finds storage for a new last element, like `std::deque::_Emplace_back_internal`.
+// Returns a pointer to it, or `NULL` on failure.
+static void* CSTL_deque_prepare_back(CSTL_DequeRef instance, CSTL_Type type, CSTL_Alloc* alloc) {
+    size_t type_size  = CSTL_type_size(type);
+    size_t block_size = CSTL_deque_block_elements(type_size);
+
+    if (instance->size == CSTL_deque_max_size(type)) {
+        return NULL;
+    }
+
+    if ((instance->offset + instance->size) % block_size == 0
+        && instance->map_size <= (instance->size + block_size) / block_size) {
+        if (!CSTL_deque_grow_map(instance, type, 1, alloc)) {
+            return NULL;
+        }
+    }
+
+    instance->offset &= instance->map_size * block_size - 1;
+
+    size_t new_offset = instance->offset + instance->size;
+    size_t block      = CSTL_deque_get_block(instance, block_size, new_offset);
+
+    if (instance->map[block] == NULL) {
+        instance->map[block] = CSTL_allocate(block_size * type_size, CSTL_type_alignment(type), alloc);
+
+        if (instance->map[block] == NULL) {
+            return NULL;
+        }
+    }
+
+    return (char*)instance->map[block] + (new_offset % block_size) * type_size;
+}
+
+// Finds storage for a new first element, like `std::deque::_Emplace_front_internal`.
+// Returns a pointer to it and sets `*new_offset`, or returns `NULL` on failure.
+static void* CSTL_deque_prepare_front(CSTL_DequeRef instance, CSTL_Type type, size_t* new_offset, CSTL_Alloc* alloc) {
+    size_t type_size  = CSTL_type_size(type);
+    size_t block_size = CSTL_deque_block_elements(type_size);
+
+    if (instance->size == CSTL_deque_max_size(type)) {
+        return NULL;
+    }
+
+    if (instance->offset % block_size == 0 && instance->map_size <= (instance->size + block_size) / block_size) {
+        if (!CSTL_deque_grow_map(instance, type, 1, alloc)) {
+            return NULL;
+        }
+    }
+
+    instance->offset &= instance->map_size * block_size - 1;
+
+    size_t offset = (instance->offset != 0 ? instance->offset : instance->map_size * block_size) - 1;
+    size_t block  = CSTL_deque_get_block(instance, block_size, offset);
+
+    if (instance->map[block] == NULL) {
+        instance->map[block] = CSTL_allocate(block_size * type_size, CSTL_type_alignment(type), alloc);
+
+        if (instance->map[block] == NULL) {
+            return NULL;
+        }
+    }
+
+    *new_offset = offset;
+
+    return (char*)instance->map[block] + (offset % block_size) * type_size;
+}
+
+// Destroys the last `count` elements, one block at a time.
+static void CSTL_deque_drop_back(CSTL_DequeRef instance, CSTL_Type type, CSTL_DropTypeCRef drop, size_t count) {
+    size_t type_size  = CSTL_type_size(type);
+    size_t block_size = CSTL_deque_block_elements(type_size);
+
+    while (count != 0) {
+        size_t last     = instance->offset + instance->size;
+        size_t in_block = (last - 1) % block_size + 1;
+        size_t n        = in_block < count ? in_block : count;
+
+        char* end = CSTL_deque_element(instance, type_size, block_size, last - 1) + type_size;
+
+        CSTL_type_drop(drop, end - n * type_size, end);
+
+        instance->size -= n;
+        count          -= n;
+    }
+
+    if (instance->size == 0) {
+        instance->offset = 0;
+    }
+}
+
+bool CSTL_deque_construct(CSTL_DequeVal* new_instance, CSTL_Alloc* alloc) {
+    CSTL_ContainerProxy* proxy = CSTL_allocate(sizeof(CSTL_ContainerProxy), _Alignof(CSTL_ContainerProxy), alloc);
+
+    new_instance->proxy    = proxy;
+    new_instance->map      = NULL;
+    new_instance->map_size = 0;
+    new_instance->offset   = 0;
+    new_instance->size     = 0;
+
+    if (proxy == NULL) {
+        return false;
+    }
+
+    proxy->cont       = new_instance;
+    proxy->first_iter = NULL;
+
+    return true;
+}
+
+void CSTL_deque_destroy(CSTL_DequeRef instance, CSTL_Type type, CSTL_DropTypeCRef drop, CSTL_Alloc* alloc) {
+    if (instance->proxy == NULL) {
+        return;
+    }
+
+    CSTL_deque_clear(instance, type, drop, alloc);
+    CSTL_free(instance->proxy, sizeof(CSTL_ContainerProxy), _Alignof(CSTL_ContainerProxy), alloc);
+
+    instance->proxy = NULL;
+}
+
+void CSTL_deque_clear(CSTL_DequeRef instance, CSTL_Type type, CSTL_DropTypeCRef drop, CSTL_Alloc* alloc) {
+    CSTL_deque_consume_front(instance, type, drop, instance->size);
+
+    size_t type_size  = CSTL_type_size(type);
+    size_t block_size = CSTL_deque_block_elements(type_size);
+
+    for (size_t block = instance->map_size; block > 0;) {
+        void* memory = instance->map[--block];
+
+        if (memory != NULL) {
+            CSTL_free(memory, block_size * type_size, CSTL_type_alignment(type), alloc);
+        }
+    }
+
+    CSTL_deque_free_map(instance, alloc);
+
+    instance->map      = NULL;
+    instance->map_size = 0;
+    instance->offset   = 0;
+}
+
+void CSTL_deque_swap(CSTL_DequeRef instance, CSTL_DequeRef other_instance) {
+    CSTL_DequeVal tmp = *instance;
+    *instance         = *other_instance;
+    *other_instance   = tmp;
+
+    if (instance->proxy != NULL) {
+        instance->proxy->cont = instance;
+    }
+
+    if (other_instance->proxy != NULL) {
+        other_instance->proxy->cont = other_instance;
+    }
+}
+
+bool CSTL_deque_empty(CSTL_DequeCRef instance) {
+    return instance->size == 0;
+}
+
+size_t CSTL_deque_size(CSTL_DequeCRef instance) {
+    return instance->size;
+}
+
+size_t CSTL_deque_max_size(CSTL_Type type) {
+    return (size_t)(PTRDIFF_MAX - 1) / CSTL_type_size(type);
+}
+
+size_t CSTL_deque_block_size(CSTL_Type type) {
+    return CSTL_deque_block_elements(CSTL_type_size(type));
+}
+
+void* CSTL_deque_index(CSTL_DequeRef instance, CSTL_Type type, size_t pos) {
+    size_t type_size = CSTL_type_size(type);
+
+    assert(pos < instance->size);
+
+    return CSTL_deque_element(instance, type_size, CSTL_deque_block_elements(type_size), instance->offset + pos);
+}
+
+const void* CSTL_deque_const_index(CSTL_DequeCRef instance, CSTL_Type type, size_t pos) {
+    size_t type_size = CSTL_type_size(type);
+
+    assert(pos < instance->size);
+
+    return CSTL_deque_element(instance, type_size, CSTL_deque_block_elements(type_size), instance->offset + pos);
+}
+
+void* CSTL_deque_at(CSTL_DequeRef instance, CSTL_Type type, size_t pos) {
+    return pos < instance->size ? CSTL_deque_index(instance, type, pos) : NULL;
+}
+
+void* CSTL_deque_front(CSTL_DequeRef instance, CSTL_Type type) {
+    return CSTL_deque_index(instance, type, 0);
+}
+
+void* CSTL_deque_back(CSTL_DequeRef instance, CSTL_Type type) {
+    return CSTL_deque_index(instance, type, instance->size - 1);
+}
+
+bool CSTL_deque_copy_push_back(CSTL_DequeRef instance, CSTL_Type type, CSTL_CopyTypeCRef copy, const void* value, CSTL_Alloc* alloc) {
+    void* dest = CSTL_deque_prepare_back(instance, type, alloc);
+
+    if (dest == NULL) {
+        return false;
+    }
+
+    CSTL_type_copy(copy, value, (const char*)value + CSTL_type_size(type), dest);
+    instance->size += 1;
+
+    return true;
+}
+
+bool CSTL_deque_move_push_back(CSTL_DequeRef instance, CSTL_Type type, CSTL_MoveTypeCRef move, void* value, CSTL_Alloc* alloc) {
+    void* dest = CSTL_deque_prepare_back(instance, type, alloc);
+
+    if (dest == NULL) {
+        return false;
+    }
+
+    CSTL_type_move(move, value, (char*)value + CSTL_type_size(type), dest);
+    instance->size += 1;
+
+    return true;
+}
+
+bool CSTL_deque_copy_push_front(CSTL_DequeRef instance, CSTL_Type type, CSTL_CopyTypeCRef copy, const void* value, CSTL_Alloc* alloc) {
+    size_t new_offset = 0;
+    void* dest        = CSTL_deque_prepare_front(instance, type, &new_offset, alloc);
+
+    if (dest == NULL) {
+        return false;
+    }
+
+    CSTL_type_copy(copy, value, (const char*)value + CSTL_type_size(type), dest);
+    instance->offset = new_offset;
+    instance->size  += 1;
+
+    return true;
+}
+
+bool CSTL_deque_move_push_front(CSTL_DequeRef instance, CSTL_Type type, CSTL_MoveTypeCRef move, void* value, CSTL_Alloc* alloc) {
+    size_t new_offset = 0;
+    void* dest        = CSTL_deque_prepare_front(instance, type, &new_offset, alloc);
+
+    if (dest == NULL) {
+        return false;
+    }
+
+    CSTL_type_move(move, value, (char*)value + CSTL_type_size(type), dest);
+    instance->offset = new_offset;
+    instance->size  += 1;
+
+    return true;
+}
+
+void CSTL_deque_pop_back(CSTL_DequeRef instance, CSTL_Type type, CSTL_DropTypeCRef drop) {
+    assert(instance->size != 0);
+
+    CSTL_deque_drop_back(instance, type, drop, 1);
+}
+
+void CSTL_deque_pop_front(CSTL_DequeRef instance, CSTL_Type type, CSTL_DropTypeCRef drop) {
+    assert(instance->size != 0);
+
+    CSTL_deque_consume_front(instance, type, drop, 1);
+}
+
+void* CSTL_deque_back_span(CSTL_DequeRef instance, CSTL_Type type, size_t* count, CSTL_Alloc* alloc) {
+    void* dest = CSTL_deque_prepare_back(instance, type, alloc);
+
+    if (dest == NULL) {
+        *count = 0;
+        return NULL;
+    }
+
+    size_t block_size = CSTL_deque_block_elements(CSTL_type_size(type));
+    size_t available  = block_size - (instance->offset + instance->size) % block_size;
+    size_t remaining  = CSTL_deque_max_size(type) - instance->size;
+
+    *count = available < remaining ? available : remaining;
+
+    return dest;
+}
+
+void CSTL_deque_commit_back(CSTL_DequeRef instance, CSTL_Type type, size_t count) {
+    assert(count <= CSTL_deque_block_size(type) - (instance->offset + instance->size) % CSTL_deque_block_size(type));
+    (void)type;
+
+    instance->size += count;
+}
+
+void* CSTL_deque_front_span(CSTL_DequeRef instance, CSTL_Type type, size_t* count) {
+    if (instance->size == 0) {
+        *count = 0;
+        return NULL;
+    }
+
+    size_t type_size  = CSTL_type_size(type);
+    size_t block_size = CSTL_deque_block_elements(type_size);
+    size_t available  = block_size - instance->offset % block_size;
+
+    *count = available < instance->size ? available : instance->size;
+
+    return CSTL_deque_element(instance, type_size, block_size, instance->offset);
+}
+
+void CSTL_deque_consume_front(CSTL_DequeRef instance, CSTL_Type type, CSTL_DropTypeCRef drop, size_t count) {
+    size_t type_size  = CSTL_type_size(type);
+    size_t block_size = CSTL_deque_block_elements(type_size);
+
+    assert(count <= instance->size);
+
+    while (count != 0) {
+        size_t available = block_size - instance->offset % block_size;
+        size_t n         = available < count ? available : count;
+
+        char* first = CSTL_deque_element(instance, type_size, block_size, instance->offset);
+
+        CSTL_type_drop(drop, first, first + n * type_size);
+
+        instance->offset += n;
+        instance->size   -= n;
+        count            -= n;
+    }
+
+    if (instance->size == 0) {
+        instance->offset = 0;
+    }
+}
+
+bool CSTL_deque_copy_append_range(CSTL_DequeRef instance, CSTL_Type type, CSTL_CopyTypeCRef copy, const void* first, const void* last, CSTL_Alloc* alloc) {
+    size_t type_size = CSTL_type_size(type);
+    size_t count     = (size_t)((const char*)last - (const char*)first) / type_size;
+
+    if (count > CSTL_deque_max_size(type) - instance->size) {
+        return false;
+    }
+
+    const char* source = first;
+    size_t appended    = 0;
+
+    while (appended != count) {
+        size_t available = 0;
+        char* dest       = CSTL_deque_back_span(instance, type, &available, alloc);
+
+        if (dest == NULL) {
+            // Keep the blocks, but remove the elements appended so far.
+            CSTL_deque_drop_back(instance, type, &copy->move_type.drop_type, appended);
+            return false;
+        }
+
+        size_t n = available < count - appended ? available : count - appended;
+
+        CSTL_type_copy(copy, source, source + n * type_size, dest);
+
+        instance->size += n;
+        source         += n * type_size;
+        appended       += n;
+    }
+
+    return true;
+}
+
+void CSTL_deque_move_take_front(CSTL_DequeRef instance, CSTL_Type type, CSTL_MoveTypeCRef move, size_t count, void* dest) {
+    size_t type_size  = CSTL_type_size(type);
+    size_t block_size = CSTL_deque_block_elements(type_size);
+
+    char* out = dest;
+
+    assert(count <= instance->size);
+
+    while (count != 0) {
+        size_t available = block_size - instance->offset % block_size;
+        size_t n         = available < count ? available : count;
+
+        char* first = CSTL_deque_element(instance, type_size, block_size, instance->offset);
+
+        CSTL_type_relocate(move, first, first + n * type_size, out);
+
+        instance->offset += n;
+        instance->size   -= n;
+        count            -= n;
+        out              += n * type_size;
+    }
+
+    if (instance->size == 0) {
+        instance->offset = 0;
+    }
+}
@@ -0,0 +1,280 @@
+#pragma once
+
+#ifndef CSTL_DEQUE_H
+#define CSTL_DEQUE_H
+
+#include "alloc.h"
+#include "type.h"
+
+#if defined(__cplusplus)
+#include <cstddef>
+extern "C" {
+#else
+#include <stdbool.h>
+#include <stddef.h>
+#endif
+
+/**
+ * STL ABI `std::_Container_proxy` layout.
+ * 
+ * `std::deque` always owns one, even when iterator debugging is disabled.
+ * It points back to the deque that owns it.
+ * 
+ */
+typedef struct CSTL_ContainerProxy {
+    const void* cont;
+    void* first_iter;
+} CSTL_ContainerProxy;
+
+/**
+ * STL ABI `std::deque` layout.
+ * 
+ * Elements are stored in fixed size blocks of 16 bytes, or a single element
+ * if it is larger, as in MSVC. `map` is a circular array of `map_size` block
+ * pointers, some of which may be null. The first element is at offset `offset`
+ * into the concatenated blocks.
+ * 
+ * Holds a pointer to the deque in its proxy, which is updated by `CSTL_deque_swap`.
+ * You are responsible for the proxy if you relocate the deque in any other way.
+ * 
+ * Does not include the allocator, which nonetheless is a part of the `std::deque`
+ * structure! You are responsible for including it, since it can take on any form.
+ * 
+ * Do not manipulate the members directly, use the associated functions!
+ * 
+ */
+typedef struct CSTL_DequeVal {
+    CSTL_ContainerProxy* proxy;
+    void** map;
+    size_t map_size;
+    size_t offset;
+    size_t size;
+} CSTL_DequeVal;
+
+/**
+ * Reference to a mutable `CSTL_DequeVal`.
+ * 
+ * Must not be null.
+ * 
+ */
+typedef CSTL_DequeVal* CSTL_DequeRef;
+
+/**
+ * Reference to a const `CSTL_DequeVal`.
+ * 
+ * Must not be null.
+ * 
+ */
+typedef const CSTL_DequeVal* CSTL_DequeCRef;
+
+/**
+ * Initializes the deque pointed to by `new_instance` as empty.
+ * 
+ * Like its C++ counterpart, an empty deque owns a container proxy, which must be
+ * freed with `CSTL_deque_destroy`. Returns `false` if the allocation fails,
+ * in which case nothing needs to be freed.
+ * 
+ */
+bool CSTL_deque_construct(CSTL_DequeVal* new_instance, CSTL_Alloc* alloc);
+
+/**
+ * Destroys the deque pointed to by `instance`, destroying elements
+ * and freeing the blocks, the map and the proxy.
+ * 
+ */
+void CSTL_deque_destroy(CSTL_DequeRef instance, CSTL_Type type, CSTL_DropTypeCRef drop, CSTL_Alloc* alloc);
+
+/**
+ * Destroys all elements and frees the blocks and the map, like `std::deque::clear`.
+ * 
+ */
+void CSTL_deque_clear(CSTL_DequeRef instance, CSTL_Type type, CSTL_DropTypeCRef drop, CSTL_Alloc* alloc);
+
+/**
+ * Swaps deque contents.
+ * 
+ * You are responsible for swapping the allocators.
+ * 
+ */
+void CSTL_deque_swap(CSTL_DequeRef instance, CSTL_DequeRef other_instance);
+
+/**
+ * Returns `true` if the deque is empty.
+ * 
+ */
+bool CSTL_deque_empty(CSTL_DequeCRef instance);
+
+/**
+ * Returns the number of elements in the deque.
+ * 
+ */
+size_t CSTL_deque_size(CSTL_DequeCRef instance);
+
+/**
+ * Returns the maximum number of elements of `type` a deque can hold.
+ * 
+ */
+size_t CSTL_deque_max_size(CSTL_Type type);
+
+/**
+ * Returns the number of elements of `type` in a block.
+ * 
+ */
+size_t CSTL_deque_block_size(CSTL_Type type);
+
+/**
+ * Returns a pointer to the element at `pos`.
+ * 
+ * If `pos >= CSTL_deque_size(instance)` the behavior is undefined.
+ * 
+ */
+void* CSTL_deque_index(CSTL_DequeRef instance, CSTL_Type type, size_t pos);
+
+/**
+ * Returns a const pointer to the element at `pos`.
+ * 
+ * If `pos >= CSTL_deque_size(instance)` the behavior is undefined.
+ * 
+ */
+const void* CSTL_deque_const_index(CSTL_DequeCRef instance, CSTL_Type type, size_t pos);
+
+/**
+ * Returns a pointer to the element at `pos`.
+ * 
+ * If `pos >= CSTL_deque_size(instance)` a null pointer is returned.
+ * 
+ */
+void* CSTL_deque_at(CSTL_DequeRef instance, CSTL_Type type, size_t pos);
+
+/**
+ * Returns a pointer to the first element in the deque.
+ * 
+ * If `CSTL_deque_empty(instance) == true` the behavior is undefined.
+ * 
+ */
+void* CSTL_deque_front(CSTL_DequeRef instance, CSTL_Type type);
+
+/**
+ * Returns a pointer to the last element in the deque.
+ * 
+ * If `CSTL_deque_empty(instance) == true` the behavior is undefined.
+ * 
+ */
+void* CSTL_deque_back(CSTL_DequeRef instance, CSTL_Type type);
+
+/**
+ * Appends a copy of `value` to the end of the deque.
+ * 
+ * Returns `false` if the deque is too long or an allocation fails,
+ * in which case it has no effect.
+ * 
+ */
+bool CSTL_deque_copy_push_back(CSTL_DequeRef instance, CSTL_Type type, CSTL_CopyTypeCRef copy, const void* value, CSTL_Alloc* alloc);
+
+/**
+ * Appends `value` to the end of the deque by moving it.
+ * 
+ * Returns `false` if the deque is too long or an allocation fails,
+ * in which case it has no effect.
+ * 
+ */
+bool CSTL_deque_move_push_back(CSTL_DequeRef instance, CSTL_Type type, CSTL_MoveTypeCRef move, void* value, CSTL_Alloc* alloc);
+
+/**
+ * Prepends a copy of `value` to the beginning of the deque.
+ * 
+ * Returns `false` if the deque is too long or an allocation fails,
+ * in which case it has no effect.
+ * 
+ */
+bool CSTL_deque_copy_push_front(CSTL_DequeRef instance, CSTL_Type type, CSTL_CopyTypeCRef copy, const void* value, CSTL_Alloc* alloc);
+
+/**
+ * Prepends `value` to the beginning of the deque by moving it.
+ * 
+ * Returns `false` if the deque is too long or an allocation fails,
+ * in which case it has no effect.
+ * 
+ */
+bool CSTL_deque_move_push_front(CSTL_DequeRef instance, CSTL_Type type, CSTL_MoveTypeCRef move, void* value, CSTL_Alloc* alloc);
+
+/**
+ * Removes the last element from the deque.
+ * 
+ * If `CSTL_deque_empty(instance) == true` the behavior is undefined.
+ * 
+ */
+void CSTL_deque_pop_back(CSTL_DequeRef instance, CSTL_Type type, CSTL_DropTypeCRef drop);
+
+/**
+ * Removes the first element from the deque.
+ * 
+ * If `CSTL_deque_empty(instance) == true` the behavior is undefined.
+ * 
+ */
+void CSTL_deque_pop_front(CSTL_DequeRef instance, CSTL_Type type, CSTL_DropTypeCRef drop);
+
+/**
+ * Returns a pointer to uninitialized storage for new elements at the end
+ * of the deque, allocating a block if needed, and sets `*count` to the number
+ * of elements that fit there contiguously, which is at least 1.
+ * 
+ * Construct up to `*count` elements in place and then publish them with
+ * `CSTL_deque_commit_back`. Any other call that modifies the deque in between
+ * invalidates the storage.
+ * 
+ * Returns `NULL` if the deque is too long or an allocation fails.
+ * 
+ */
+void* CSTL_deque_back_span(CSTL_DequeRef instance, CSTL_Type type, size_t* count, CSTL_Alloc* alloc);
+
+/**
+ * Appends `count` elements constructed in the storage returned by the last
+ * `CSTL_deque_back_span`, where `count` is at most the count it returned.
+ * 
+ */
+void CSTL_deque_commit_back(CSTL_DequeRef instance, CSTL_Type type, size_t count);
+
+/**
+ * Returns a pointer to the first element of the deque, and sets `*count` to
+ * the number of elements that follow it contiguously, including itself.
+ * 
+ * Returns `NULL` and sets `*count` to 0 if the deque is empty.
+ * 
+ */
+void* CSTL_deque_front_span(CSTL_DequeRef instance, CSTL_Type type, size_t* count);
+
+/**
+ * Removes the first `count` elements from the deque, destroying them
+ * with one call to `drop` per block.
+ * 
+ * If `count > CSTL_deque_size(instance)` the behavior is undefined.
+ * 
+ */
+void CSTL_deque_consume_front(CSTL_DequeRef instance, CSTL_Type type, CSTL_DropTypeCRef drop, size_t count);
+
+/**
+ * Appends copies of the elements in the range `[first, last)` to the end
+ * of the deque, with one call to `copy` per block.
+ * 
+ * Returns `false` if the deque would be too long or an allocation fails,
+ * in which case it has no effect.
+ * 
+ */
+bool CSTL_deque_copy_append_range(CSTL_DequeRef instance, CSTL_Type type, CSTL_CopyTypeCRef copy, const void* first, const void* last, CSTL_Alloc* alloc);
+
+/**
+ * Moves the first `count` elements of the deque to uninitialized memory
+ * at `dest` and removes them, with one call to `move` and `drop` per block,
+ * or a single `memcpy` per block if the type is trivially relocatable.
+ * 
+ * If `count > CSTL_deque_size(instance)` the behavior is undefined.
+ * 
+ */
+void CSTL_deque_move_take_front(CSTL_DequeRef instance, CSTL_Type type, CSTL_MoveTypeCRef move, size_t count, void* dest);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
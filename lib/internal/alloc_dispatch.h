@@ -6,6 +6,7 @@
 #include "../alloc.h"
 
 #include <assert.h>
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
@@ -21,7 +22,8 @@ static inline void* CSTL_allocate(size_t size, size_t alignment, CSTL_Alloc* all
 #if defined(_CRTALLOCATOR) || defined(_CRT_ALLOCATION_DEFINED)
         return _aligned_malloc(size, alignment);
 #else
-        return aligned_alloc(alignment, size);
+        // C11 requires `size` to be a multiple of `alignment`
+        return aligned_alloc(alignment, (size + (alignment - 1)) & ~(alignment - 1));
 #endif
     }
 
@@ -45,6 +47,38 @@ static inline void CSTL_free(void* memory, size_t size, size_t alignment, CSTL_A
     alloc->aligned_free(alloc->opaque, memory, size, alignment);
 }
 
+static inline bool CSTL_try_expand(void* memory, size_t old_size, size_t new_size, size_t alignment, CSTL_Alloc* alloc) {
+    if (alloc == NULL || alloc->try_expand == NULL) {
+        return false;
+    }
+
+    return alloc->try_expand(alloc->opaque, memory, old_size, new_size, alignment);
+}
+
+static inline void* CSTL_reallocate(void* memory, size_t old_size, size_t new_size, size_t alignment, CSTL_Alloc* alloc) {
+    if (alloc == NULL) {
+#if defined(_CRTALLOCATOR) || defined(_CRT_ALLOCATION_DEFINED)
+        (void)old_size;
+        return _aligned_realloc(memory, new_size, alignment);
+#else
+        (void)old_size;
+
+        // `realloc` only keeps fundamental alignment
+        if (alignment > _Alignof(max_align_t)) {
+            return NULL;
+        }
+
+        return realloc(memory, new_size);
+#endif
+    }
+
+    if (alloc->reallocate == NULL) {
+        return NULL;
+    }
+
+    return alloc->reallocate(alloc->opaque, memory, old_size, new_size, alignment);
+}
+
 static inline void* CSTL_small_alloc(CSTL_SmallAllocFrame* frame, size_t size, size_t alignment, CSTL_Alloc* alloc, uintptr_t cookie) {
     size_t align_val  = alignment - 1;
 
@@ -1,6 +1,9 @@
 #include "basic_string.h"
 
 #include "../alloc.h"
+#include "../type.h"
+#include "../vector.h"
+#include "char_search.h"
 
 #if defined(__cplusplus)
 #include <cstddef>
@@ -33,6 +36,9 @@ typedef unsigned char char8_t;
 #undef CSTL_string_alloc_mask
 #undef CSTL_string_small_capacity
 #undef CSTL_string_npos
+#undef CSTL_string_split_char
+#undef CSTL_string_split_any_of
+#undef CSTL_string_split_str
 
 // length of internal buffer, [1, 16]
 #define CSTL_string_bufsize (16 / sizeof(CSTL_char_t) < 1 ? 1 : 16 / sizeof(CSTL_char_t))
@@ -46,6 +52,10 @@ typedef unsigned char char8_t;
 #define CSTL_string_small_capacity (CSTL_string_bufsize - 1)
 // `std::basic_string` npos constant
 #define CSTL_string_npos (size_t)-1;
+// delimiter kinds of the split iterator
+#define CSTL_string_split_char   0
+#define CSTL_string_split_any_of 1
+#define CSTL_string_split_str    2
 
 /**
  * STL ABI `std::basic_string` layout.
@@ -806,6 +816,262 @@ size_t CSTL_string_(rfind_char)(CSTL_String(CRef) instance, CSTL_char_t ch, size
  */
 size_t CSTL_string_(rfind_str)(CSTL_String(CRef) instance, CSTL_String(CRef) other, size_t off);
 
+/**
+ * Find the first from offset `off` character equal to any of the characters
+ * in the null-terminated string `ptr` and return its
+ * position from the start of the string.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_(find_first_of)(CSTL_String(CRef) instance, const CSTL_char_t* ptr, size_t off);
+
+/**
+ * Find the first from offset `off` character equal to any of the characters
+ * in the first `count` characters at `ptr` and return its
+ * position from the start of the string.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_(find_first_of_n)(CSTL_String(CRef) instance, const CSTL_char_t* ptr, size_t off, size_t count);
+
+/**
+ * Find the first from offset `off` character equal to `ch`
+ * and return its position from the start of the string.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_(find_first_of_char)(CSTL_String(CRef) instance, CSTL_char_t ch, size_t off);
+
+/**
+ * Find the first from offset `off` character equal to any of the characters
+ * in the string `other` and return its
+ * position from the start of the original string.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_(find_first_of_str)(CSTL_String(CRef) instance, CSTL_String(CRef) other, size_t off);
+
+/**
+ * Find the last before offset `off` character equal to any of the characters
+ * in the null-terminated string `ptr` and return its
+ * position from the start of the string.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_(find_last_of)(CSTL_String(CRef) instance, const CSTL_char_t* ptr, size_t off);
+
+/**
+ * Find the last before offset `off` character equal to any of the characters
+ * in the first `count` characters at `ptr` and return its
+ * position from the start of the string.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_(find_last_of_n)(CSTL_String(CRef) instance, const CSTL_char_t* ptr, size_t off, size_t count);
+
+/**
+ * Find the last before offset `off` character equal to `ch`
+ * and return its position from the start of the string.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_(find_last_of_char)(CSTL_String(CRef) instance, CSTL_char_t ch, size_t off);
+
+/**
+ * Find the last before offset `off` character equal to any of the characters
+ * in the string `other` and return its
+ * position from the start of the original string.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_(find_last_of_str)(CSTL_String(CRef) instance, CSTL_String(CRef) other, size_t off);
+
+/**
+ * Find the first from offset `off` character equal to none of the characters
+ * in the null-terminated string `ptr` and return its
+ * position from the start of the string.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_(find_first_not_of)(CSTL_String(CRef) instance, const CSTL_char_t* ptr, size_t off);
+
+/**
+ * Find the first from offset `off` character equal to none of the characters
+ * in the first `count` characters at `ptr` and return its
+ * position from the start of the string.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_(find_first_not_of_n)(CSTL_String(CRef) instance, const CSTL_char_t* ptr, size_t off, size_t count);
+
+/**
+ * Find the first from offset `off` character not equal to `ch`
+ * and return its position from the start of the string.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_(find_first_not_of_char)(CSTL_String(CRef) instance, CSTL_char_t ch, size_t off);
+
+/**
+ * Find the first from offset `off` character equal to none of the characters
+ * in the string `other` and return its
+ * position from the start of the original string.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_(find_first_not_of_str)(CSTL_String(CRef) instance, CSTL_String(CRef) other, size_t off);
+
+/**
+ * Find the last before offset `off` character equal to none of the characters
+ * in the null-terminated string `ptr` and return its
+ * position from the start of the string.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_(find_last_not_of)(CSTL_String(CRef) instance, const CSTL_char_t* ptr, size_t off);
+
+/**
+ * Find the last before offset `off` character equal to none of the characters
+ * in the first `count` characters at `ptr` and return its
+ * position from the start of the string.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_(find_last_not_of_n)(CSTL_String(CRef) instance, const CSTL_char_t* ptr, size_t off, size_t count);
+
+/**
+ * Find the last before offset `off` character not equal to `ch`
+ * and return its position from the start of the string.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_(find_last_not_of_char)(CSTL_String(CRef) instance, CSTL_char_t ch, size_t off);
+
+/**
+ * Find the last before offset `off` character equal to none of the characters
+ * in the string `other` and return its
+ * position from the start of the original string.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_(find_last_not_of_str)(CSTL_String(CRef) instance, CSTL_String(CRef) other, size_t off);
+
+/**
+ * Precomputed search state for a fixed needle.
+ * 
+ * Initialize with `CSTL_*string_searcher_init`, then use it to search any number of
+ * strings or character ranges. Searches never modify the searcher, so it can be
+ * shared between threads. There is nothing to destroy.
+ * 
+ * The searcher borrows the needle, which must stay alive and unmodified
+ * for as long as the searcher is used.
+ * 
+ * Do not manipulate the members directly, use the associated functions!
+ * 
+ */
+typedef struct CSTL_String(Searcher) {
+    CSTL_CharSearch state;
+} CSTL_String(Searcher);
+
+/**
+ * Prepares `new_searcher` for searching the first `count` characters at `needle`.
+ * 
+ */
+void CSTL_string_(searcher_init)(CSTL_String(Searcher)* new_searcher, const CSTL_char_t* needle, size_t count);
+
+/**
+ * Find the first from offset `off` occurence of the searcher's needle in `instance`
+ * and return its position from the start of the string.
+ * 
+ * Equivalent to `CSTL_*string_find_n`.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_(searcher_find)(const CSTL_String(Searcher)* searcher, CSTL_String(CRef) instance, size_t off);
+
+/**
+ * Find the last before offset `off` occurence of the searcher's needle in `instance`
+ * and return its position from the start of the string.
+ * 
+ * Equivalent to `CSTL_*string_rfind_n`.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_(searcher_rfind)(const CSTL_String(Searcher)* searcher, CSTL_String(CRef) instance, size_t off);
+
+/**
+ * Find the first occurence of the searcher's needle in the first `count` characters
+ * at `ptr` and return its position from `ptr`.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_(searcher_find_in)(const CSTL_String(Searcher)* searcher, const CSTL_char_t* ptr, size_t count);
+
+/**
+ * Find the last occurence of the searcher's needle in the first `count` characters
+ * at `ptr` and return its position from `ptr`.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_(searcher_rfind_in)(const CSTL_String(Searcher)* searcher, const CSTL_char_t* ptr, size_t count);
+
+/**
+ * Count the non-overlapping occurences of the searcher's needle in `instance`.
+ * 
+ * An empty needle occurs at every position, including the end of the string.
+ * 
+ */
+size_t CSTL_string_(searcher_count)(const CSTL_String(Searcher)* searcher, CSTL_String(CRef) instance);
+
+/**
+ * Count the non-overlapping occurences of the searcher's needle
+ * in the first `count` characters at `ptr`.
+ * 
+ * An empty needle occurs at every position, including the end of the range.
+ * 
+ */
+size_t CSTL_string_(searcher_count_in)(const CSTL_String(Searcher)* searcher, const CSTL_char_t* ptr, size_t count);
+
+/**
+ * Find the non-overlapping occurences of the searcher's needle in `instance`
+ * and store up to `capacity` of their positions, in order, to `positions`.
+ * 
+ * Returns the total number of occurences, which may be greater than `capacity`.
+ * Call with `capacity == 0` to only count them.
+ * 
+ */
+size_t CSTL_string_(searcher_find_all)(const CSTL_String(Searcher)* searcher, CSTL_String(CRef) instance, size_t* positions, size_t capacity);
+
+/**
+ * Find the non-overlapping occurences of the searcher's needle in the first `count`
+ * characters at `ptr` and store up to `capacity` of their positions, in order, to `positions`.
+ * 
+ * Returns the total number of occurences, which may be greater than `capacity`.
+ * Call with `capacity == 0` to only count them.
+ * 
+ */
+size_t CSTL_string_(searcher_find_all_in)(const CSTL_String(Searcher)* searcher, const CSTL_char_t* ptr, size_t count, size_t* positions, size_t capacity);
+
 /**
  * Compare two null-terminated character sequences.
  * 
@@ -847,3 +1113,346 @@ int CSTL_string_(compare_n)(const CSTL_char_t* left, const CSTL_char_t* right, s
  * 
  */
 int CSTL_string_(compare_nn)(const CSTL_char_t* left, size_t left_count, const CSTL_char_t* right, size_t right_count);
+
+/**
+ * Hash the first `count` characters at `ptr`.
+ * 
+ * Matches MSVC's `std::hash` of the equivalent `std::basic_string` bit for bit:
+ * FNV-1a over the bytes of the characters, with the 64-bit parameters where
+ * `size_t` is 64 bits wide and the 32-bit ones otherwise.
+ * 
+ */
+size_t CSTL_string_(hash_n)(const CSTL_char_t* ptr, size_t count);
+
+/**
+ * Hash the string `instance`, as if by `CSTL_*string_hash_n`.
+ * 
+ */
+size_t CSTL_string_(hash)(CSTL_String(CRef) instance);
+
+/**
+ * Hash the first `count` characters at `ptr` several times faster than
+ * `CSTL_*string_hash_n`, 16 bytes per 128-bit multiply and longer strings
+ * with SIMD.
+ * 
+ * The result does not match `std::hash` and may change between versions,
+ * so only use it for tables that never leave this library.
+ * 
+ */
+size_t CSTL_string_(fast_hash_n)(const CSTL_char_t* ptr, size_t count);
+
+/**
+ * Hash the string `instance`, as if by `CSTL_*string_fast_hash_n`.
+ * 
+ */
+size_t CSTL_string_(fast_hash)(CSTL_String(CRef) instance);
+
+/**
+ * Ready-made tables for hash containers with `CSTL_*StringVal` keys,
+ * which compare the contents of the strings for equality.
+ * 
+ * `CSTL_*string_hash_type` hashes with `CSTL_*string_hash`, like `std::hash`,
+ * and `CSTL_*string_fast_hash_type` with `CSTL_*string_fast_hash`.
+ * 
+ */
+extern const CSTL_HashType CSTL_string_(hash_type);
+extern const CSTL_HashType CSTL_string_(fast_hash_type);
+
+/**
+ * STL ABI `std::basic_string_view` layout.
+ * 
+ * A view refers to `size` characters at `data` without owning them,
+ * so the characters must outlive the view. Views are passed by value.
+ * 
+ */
+typedef struct CSTL_String(View) {
+    const CSTL_char_t* data;
+    size_t size;
+} CSTL_String(View);
+
+/**
+ * Returns a view of the null-terminated string at `ptr`, without the null terminator.
+ * 
+ */
+CSTL_String(View) CSTL_string_(view)(const CSTL_char_t* ptr);
+
+/**
+ * Returns a view of the first `count` characters at `ptr`.
+ * 
+ */
+CSTL_String(View) CSTL_string_(view_n)(const CSTL_char_t* ptr, size_t count);
+
+/**
+ * Returns a view of the contents of `instance`.
+ * 
+ * The view is invalidated by any operation that invalidates iterators to `instance`.
+ * 
+ */
+CSTL_String(View) CSTL_string_(as_view)(CSTL_String(CRef) instance);
+
+/**
+ * Replaces the contents of `instance` with the characters of `view`,
+ * which may refer to `instance` itself.
+ * 
+ * If the size of `view` is greater than `CSTL_*string_max_size()` this function
+ * has no effect and returns `false`, otherwise it returns `true`.
+ * 
+ */
+bool CSTL_string_(assign_view)(CSTL_String(Ref) instance, CSTL_String(View) view, CSTL_Alloc* alloc);
+
+/**
+ * Appends the characters of `view` to `instance`.
+ * 
+ * If the length of the resulting string is greater than `CSTL_*string_max_size()`
+ * this function has no effect and returns `false`, otherwise it returns `true`.
+ * 
+ */
+bool CSTL_string_(append_view)(CSTL_String(Ref) instance, CSTL_String(View) view, CSTL_Alloc* alloc);
+
+/**
+ * Returns a pointer to the character at `pos` in `view`.
+ * 
+ * If `pos` is outside of the range `[0, view.size)` `NULL` is returned.
+ * 
+ */
+const CSTL_char_t* CSTL_string_(view_at)(CSTL_String(View) view, size_t pos);
+
+/**
+ * Shrinks the view pointed to by `view` by moving its start forward by `count` characters.
+ * 
+ * `count` must not be greater than the size of the view.
+ * 
+ */
+void CSTL_string_(view_remove_prefix)(CSTL_String(View)* view, size_t count);
+
+/**
+ * Shrinks the view pointed to by `view` by moving its end backward by `count` characters.
+ * 
+ * `count` must not be greater than the size of the view.
+ * 
+ */
+void CSTL_string_(view_remove_suffix)(CSTL_String(View)* view, size_t count);
+
+/**
+ * Stores the view of the substring at offset `off` in `view` with the length
+ * given by `count` to `new_view`, without copying any characters.
+ * 
+ * If `off` is outside of the range `[0, view.size]` returns `false` and does nothing,
+ * otherwise it returns `true`.
+ * 
+ */
+bool CSTL_string_(view_substr)(CSTL_String(View)* new_view, CSTL_String(View) view, size_t off, size_t count);
+
+/**
+ * Copies a substring `[off, off + count)` of `view` to the character string pointed to by
+ * `dest`. The resulting character string is not null terminated.
+ * 
+ * Returns the number of characters copied or `CSTL_string_npos` if
+ * `off > view.size` (out of range).
+ * 
+ */
+size_t CSTL_string_(view_copy)(CSTL_String(View) view, CSTL_char_t* dest, size_t count, size_t off);
+
+/**
+ * Compare two views.
+ * 
+ * The return value is negative if `left` compares less than `right`,
+ * positive if it compares greater and zero if `left` and `right`
+ * compare equal.
+ * 
+ */
+int CSTL_string_(view_compare)(CSTL_String(View) left, CSTL_String(View) right);
+
+/**
+ * Returns whether two views refer to equal character sequences.
+ * 
+ * Views of different sizes are told apart without comparing any characters.
+ * 
+ */
+bool CSTL_string_(view_equal)(CSTL_String(View) left, CSTL_String(View) right);
+
+/**
+ * Returns whether `view` starts with the characters of `prefix`.
+ * 
+ */
+bool CSTL_string_(view_starts_with)(CSTL_String(View) view, CSTL_String(View) prefix);
+
+/**
+ * Returns whether `view` ends with the characters of `suffix`.
+ * 
+ */
+bool CSTL_string_(view_ends_with)(CSTL_String(View) view, CSTL_String(View) suffix);
+
+/**
+ * Find the first from offset `off` substring of `view` equal to `needle`
+ * and return its position from the start of the view.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_(view_find)(CSTL_String(View) view, CSTL_String(View) needle, size_t off);
+
+/**
+ * Find the first from offset `off` occurence of the character `ch` in `view`
+ * and return its position from the start of the view.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_(view_find_char)(CSTL_String(View) view, CSTL_char_t ch, size_t off);
+
+/**
+ * Find the last before offset `off` substring of `view` equal to `needle`
+ * and return its position from the start of the view.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_(view_rfind)(CSTL_String(View) view, CSTL_String(View) needle, size_t off);
+
+/**
+ * Find the last before offset `off` occurence of the character `ch` in `view`
+ * and return its position from the start of the view.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_(view_rfind_char)(CSTL_String(View) view, CSTL_char_t ch, size_t off);
+
+/**
+ * Find the first from offset `off` character of `view` equal to any of the characters
+ * in `set` and return its position from the start of the view.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_(view_find_first_of)(CSTL_String(View) view, CSTL_String(View) set, size_t off);
+
+/**
+ * Find the last before offset `off` character of `view` equal to any of the characters
+ * in `set` and return its position from the start of the view.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_(view_find_last_of)(CSTL_String(View) view, CSTL_String(View) set, size_t off);
+
+/**
+ * Find the first from offset `off` character of `view` equal to none of the characters
+ * in `set` and return its position from the start of the view.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_(view_find_first_not_of)(CSTL_String(View) view, CSTL_String(View) set, size_t off);
+
+/**
+ * Find the first from offset `off` character of `view` not equal to `ch`
+ * and return its position from the start of the view.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_(view_find_first_not_of_char)(CSTL_String(View) view, CSTL_char_t ch, size_t off);
+
+/**
+ * Find the last before offset `off` character of `view` equal to none of the characters
+ * in `set` and return its position from the start of the view.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_(view_find_last_not_of)(CSTL_String(View) view, CSTL_String(View) set, size_t off);
+
+/**
+ * Find the last before offset `off` character of `view` not equal to `ch`
+ * and return its position from the start of the view.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_(view_find_last_not_of_char)(CSTL_String(View) view, CSTL_char_t ch, size_t off);
+
+/**
+ * Hash the characters of `view`, as if by `CSTL_*string_hash_n`,
+ * which matches MSVC's `std::hash` of the equivalent `std::basic_string_view`.
+ * 
+ */
+size_t CSTL_string_(view_hash)(CSTL_String(View) view);
+
+/**
+ * Hash the characters of `view`, as if by `CSTL_*string_fast_hash_n`.
+ * 
+ */
+size_t CSTL_string_(view_fast_hash)(CSTL_String(View) view);
+
+/**
+ * Iterator over the fields of a view separated by a delimiter, which is
+ * a character, any character of a set or a substring.
+ * 
+ * Fields are returned as views into the original characters, so splitting
+ * never allocates. Delimiters are located with the vectorised searches
+ * behind `CSTL_*string_find_char`, `CSTL_*string_find_first_of` and `CSTL_*string_find`.
+ * 
+ * Like the view it splits, the iterator borrows the characters and the delimiters,
+ * which must outlive it. There is nothing to destroy.
+ * 
+ * Do not manipulate the members directly, use the associated functions!
+ * 
+ */
+typedef struct CSTL_String(Split) {
+    CSTL_String(View) rest;  // characters not split yet
+    CSTL_String(View) delim; // set or substring
+    CSTL_char_t ch;
+    unsigned char mode;      // character, set or substring
+    bool skip_empty;
+    bool done;
+} CSTL_String(Split);
+
+/**
+ * Prepares `new_split` for splitting `view` on every occurrence of the character `delim`.
+ * 
+ * Adjacent delimiters and delimiters at either end delimit empty fields,
+ * which are skipped if `skip_empty` is `true`. An empty view has one empty field.
+ * 
+ * To split a `CSTL_*StringVal`, pass `CSTL_*string_as_view(instance)`.
+ * 
+ */
+void CSTL_string_(split_init)(CSTL_String(Split)* new_split, CSTL_String(View) view, CSTL_char_t delim, bool skip_empty);
+
+/**
+ * Prepares `new_split` for splitting `view` on every character that is
+ * also in `set`, as if by `CSTL_*string_split_init`.
+ * 
+ * An empty `set` matches nothing, so the whole view is one field.
+ * 
+ */
+void CSTL_string_(split_init_any_of)(CSTL_String(Split)* new_split, CSTL_String(View) view, CSTL_String(View) set, bool skip_empty);
+
+/**
+ * Prepares `new_split` for splitting `view` on every non-overlapping
+ * occurrence of the substring `delim`, as if by `CSTL_*string_split_init`.
+ * 
+ * An empty `delim` matches nothing, so the whole view is one field.
+ * 
+ */
+void CSTL_string_(split_init_str)(CSTL_String(Split)* new_split, CSTL_String(View) view, CSTL_String(View) delim, bool skip_empty);
+
+/**
+ * Stores the next field of `split` to `field` and returns `true`,
+ * or returns `false` if all fields have been returned.
+ * 
+ */
+bool CSTL_string_(split_next)(CSTL_String(Split)* split, CSTL_String(View)* field);
+
+/**
+ * Appends the remaining fields of `split` to `vector`, a vector of `CSTL_*StringView`
+ * with the type `CSTL_pod_type(sizeof(CSTL_*StringView), alignof(CSTL_*StringView))`.
+ * 
+ * The fields are counted first, so the vector is reserved at most once.
+ * 
+ * If the vector would become too long or the allocation fails, this function
+ * has no effect and returns `false`, otherwise it returns `true`.
+ * 
+ */
+bool CSTL_string_(split_into_vector)(CSTL_String(Split)* split, CSTL_VectorRef vector, CSTL_Alloc* alloc);
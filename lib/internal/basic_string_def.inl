@@ -1,5 +1,9 @@
 #include "basic_string_decl.inl"
 #include "alloc_dispatch.h"
+#include "char_class.h"
+#include "char_dispatch.h"
+#include "char_hash.h"
+#include "char_search.h"
 
 #include <assert.h>
 #include <stdalign.h>
@@ -17,6 +21,12 @@ void CSTL_string_(char_move)(CSTL_char_t* dst, const CSTL_char_t* src, size_t n)
 }
 
 size_t CSTL_string_(char_len)(const CSTL_char_t* ptr) {
+    switch (sizeof(CSTL_char_t)) {
+    case 1: return CSTL_char_len_1((const void*)ptr);
+    case 2: return CSTL_char_len_2((const void*)ptr);
+    case 4: return CSTL_char_len_4((const void*)ptr);
+    }
+
     size_t result = CSTL_string_npos;
     do {
         ++result;
@@ -25,33 +35,73 @@ size_t CSTL_string_(char_len)(const CSTL_char_t* ptr) {
 }
 
 void CSTL_string_(char_set)(CSTL_char_t* dst, CSTL_char_t ch, size_t n) {
+    switch (sizeof(CSTL_char_t)) {
+    case 1: CSTL_char_fill_1((void*)dst, n, (uint8_t)ch); return;
+    case 2: CSTL_char_fill_2((void*)dst, n, (uint16_t)ch); return;
+    case 4: CSTL_char_fill_4((void*)dst, n, (uint32_t)ch); return;
+    }
+
     while (n-- != 0) {
         *(dst++) = ch;
     }
 }
 
 const CSTL_char_t* CSTL_string_(char_memchr)(const CSTL_char_t* first, const CSTL_char_t* last, CSTL_char_t ch) {
-    for (; first != last; ++first) {
-        if (*first == ch) {
-            return first;
-        }
+    size_t count = (size_t)(last - first);
+    size_t found_at;
+
+    switch (sizeof(CSTL_char_t)) {
+    case 1: found_at = CSTL_char_find_1((const void*)first, count, (uint8_t)ch); break;
+    case 2: found_at = CSTL_char_find_2((const void*)first, count, (uint16_t)ch); break;
+    case 4: found_at = CSTL_char_find_4((const void*)first, count, (uint32_t)ch); break;
+    default:
+        for (found_at = 0; found_at != count && first[found_at] != ch; ++found_at) {}
+        break;
     }
-    return NULL;
+
+    return found_at != count ? first + found_at : NULL;
+}
+
+const CSTL_char_t* CSTL_string_(char_memrchr)(const CSTL_char_t* first, const CSTL_char_t* last, CSTL_char_t ch) {
+    size_t count = (size_t)(last - first);
+    size_t found_at;
+
+    switch (sizeof(CSTL_char_t)) {
+    case 1: found_at = CSTL_char_rfind_1((const void*)first, count, (uint8_t)ch); break;
+    case 2: found_at = CSTL_char_rfind_2((const void*)first, count, (uint16_t)ch); break;
+    case 4: found_at = CSTL_char_rfind_4((const void*)first, count, (uint32_t)ch); break;
+    default:
+        for (found_at = count; found_at != 0 && first[found_at - 1] != ch; --found_at) {}
+        found_at = found_at != 0 ? found_at - 1 : count;
+        break;
+    }
+
+    return found_at != count ? first + found_at : NULL;
 }
 
 int CSTL_string_(char_memcmp)(const CSTL_char_t* first1, const CSTL_char_t* first2, size_t count)  {
-    for (size_t i = 0; i < count; ++i) {
-        if (first1[i] != first2[i]) {
-            return first1[i] < first2[i] ? -1 : 1;
-        }
+    size_t i;
+
+    switch (sizeof(CSTL_char_t)) {
+    case 1: i = CSTL_char_mismatch_1((const void*)first1, (const void*)first2, count); break;
+    case 2: i = CSTL_char_mismatch_2((const void*)first1, (const void*)first2, count); break;
+    case 4: i = CSTL_char_mismatch_4((const void*)first1, (const void*)first2, count); break;
+    default:
+        for (i = 0; i != count && first1[i] == first2[i]; ++i) {}
+        break;
     }
-    return 0;
+
+    if (i == count) {
+        return 0;
+    }
+
+    return first1[i] < first2[i] ? -1 : 1;
 }
 
 size_t CSTL_string_(char_find_ch)(const CSTL_char_t* haystack, size_t hay_size, size_t start_at, CSTL_char_t ch) {
     if (start_at < hay_size) {
         const CSTL_char_t* found_at = CSTL_string_(char_memchr)(haystack + start_at,
-            haystack + start_at + hay_size, ch);
+            haystack + hay_size, ch);
             
         if (found_at != NULL) {
             return (size_t)(found_at - haystack);
@@ -70,36 +120,37 @@ size_t CSTL_string_(char_find_str)(const CSTL_char_t* haystack, size_t hay_size,
         return start_at;
     }
 
-    const CSTL_char_t* possible_matches_end = haystack + (hay_size - needle_size) + 1;
-
-    for (const CSTL_char_t* match_try = haystack + start_at;; ++match_try) {
-        match_try = CSTL_string_(char_memchr)(match_try, possible_matches_end, *needle);
-
-        if (match_try == NULL) {
-            return CSTL_string_npos;
-        }
+    const CSTL_char_t* first = haystack + start_at;
+    size_t count = hay_size - start_at;
+    size_t found_at;
 
-        if (CSTL_string_(char_memcmp)(match_try + 1, needle + 1, needle_size - 1) == 0) {
-            return (size_t)(match_try - haystack);
+    switch (sizeof(CSTL_char_t)) {
+    case 1: found_at = CSTL_char_find_seq_1((const void*)first, count, (const void*)needle, needle_size); break;
+    case 2: found_at = CSTL_char_find_seq_2((const void*)first, count, (const void*)needle, needle_size); break;
+    case 4: found_at = CSTL_char_find_seq_4((const void*)first, count, (const void*)needle, needle_size); break;
+    default:
+        for (found_at = 0; found_at != count - needle_size + 1
+            && CSTL_string_(char_memcmp)(first + found_at, needle, needle_size) != 0; ++found_at) {}
+        if (found_at == count - needle_size + 1) {
+            found_at = count;
         }
+        break;
     }
+
+    return found_at != count ? start_at + found_at : CSTL_string_npos;
 }
 
 size_t CSTL_string_(char_rfind_ch)(const CSTL_char_t* haystack, size_t hay_size, size_t start_at, CSTL_char_t ch) {
     if (hay_size != 0) {
         size_t start_pos = start_at < hay_size - 1 ? start_at : hay_size - 1;
-        for (const CSTL_char_t* match_try = haystack + start_pos;; --match_try) {
-            if (*match_try == ch) {
-                return (size_t)(match_try - haystack);
-            }
+        const CSTL_char_t* found_at = CSTL_string_(char_memrchr)(haystack,
+            haystack + start_pos + 1, ch);
 
-            if (match_try == haystack) {
-                break; // at beginning, no more chance for match
-            }
+        if (found_at != NULL) {
+            return (size_t)(found_at - haystack);
         }
     }
 
-
     return CSTL_string_npos;
 }
 
@@ -108,20 +159,88 @@ size_t CSTL_string_(char_rfind_str)(const CSTL_char_t* haystack, size_t hay_size
         return start_at < hay_size ? start_at : hay_size;
     }
 
-    if (needle_size <= hay_size) {
-        size_t start_pos = start_at < hay_size - needle_size ? start_at : hay_size - needle_size;
-        for (const CSTL_char_t* match_try = haystack + start_pos;; --match_try) {
-            if (*match_try == *needle && CSTL_string_(char_memcmp)(match_try + 1, needle + 1, needle_size - 1) == 0) {
-                return (size_t)(match_try - haystack);
-            }
+    if (needle_size > hay_size) {
+        return CSTL_string_npos;
+    }
 
-            if (match_try == haystack) {
-                break; // at beginning, no more chance for match
-            }
-        }
+    size_t start_pos = start_at < hay_size - needle_size ? start_at : hay_size - needle_size;
+    size_t count     = start_pos + needle_size; // a match must end before `haystack + count`
+    size_t found_at;
+
+    switch (sizeof(CSTL_char_t)) {
+    case 1: found_at = CSTL_char_rfind_seq_1((const void*)haystack, count, (const void*)needle, needle_size); break;
+    case 2: found_at = CSTL_char_rfind_seq_2((const void*)haystack, count, (const void*)needle, needle_size); break;
+    case 4: found_at = CSTL_char_rfind_seq_4((const void*)haystack, count, (const void*)needle, needle_size); break;
+    default:
+        for (found_at = start_pos + 1; found_at != 0
+            && CSTL_string_(char_memcmp)(haystack + found_at - 1, needle, needle_size) != 0; --found_at) {}
+        found_at = found_at != 0 ? found_at - 1 : count;
+        break;
     }
 
-    return CSTL_string_npos;
+    return found_at != count ? found_at : CSTL_string_npos;
+}
+
+size_t CSTL_string_(char_find_of)(const CSTL_char_t* haystack, size_t hay_size, size_t start_at, const CSTL_char_t* set, size_t set_size, bool in_set) {
+    if (start_at >= hay_size) {
+        return CSTL_string_npos;
+    }
+
+    const CSTL_char_t* first = haystack + start_at;
+    size_t count = hay_size - start_at;
+    size_t found_at;
+
+    switch (sizeof(CSTL_char_t)) {
+    case 1:
+        found_at = in_set ? CSTL_char_find_of_1((const void*)first, count, (const void*)set, set_size)
+                          : CSTL_char_find_not_of_1((const void*)first, count, (const void*)set, set_size);
+        break;
+    case 2:
+        found_at = in_set ? CSTL_char_find_of_2((const void*)first, count, (const void*)set, set_size)
+                          : CSTL_char_find_not_of_2((const void*)first, count, (const void*)set, set_size);
+        break;
+    case 4:
+        found_at = in_set ? CSTL_char_find_of_4((const void*)first, count, (const void*)set, set_size)
+                          : CSTL_char_find_not_of_4((const void*)first, count, (const void*)set, set_size);
+        break;
+    default:
+        for (found_at = 0; found_at != count
+            && (CSTL_string_(char_memchr)(set, set + set_size, first[found_at]) != NULL) != in_set; ++found_at) {}
+        break;
+    }
+
+    return found_at != count ? start_at + found_at : CSTL_string_npos;
+}
+
+size_t CSTL_string_(char_rfind_of)(const CSTL_char_t* haystack, size_t hay_size, size_t start_at, const CSTL_char_t* set, size_t set_size, bool in_set) {
+    if (hay_size == 0) {
+        return CSTL_string_npos;
+    }
+
+    size_t count = (start_at < hay_size - 1 ? start_at : hay_size - 1) + 1;
+    size_t found_at;
+
+    switch (sizeof(CSTL_char_t)) {
+    case 1:
+        found_at = in_set ? CSTL_char_rfind_of_1((const void*)haystack, count, (const void*)set, set_size)
+                          : CSTL_char_rfind_not_of_1((const void*)haystack, count, (const void*)set, set_size);
+        break;
+    case 2:
+        found_at = in_set ? CSTL_char_rfind_of_2((const void*)haystack, count, (const void*)set, set_size)
+                          : CSTL_char_rfind_not_of_2((const void*)haystack, count, (const void*)set, set_size);
+        break;
+    case 4:
+        found_at = in_set ? CSTL_char_rfind_of_4((const void*)haystack, count, (const void*)set, set_size)
+                          : CSTL_char_rfind_not_of_4((const void*)haystack, count, (const void*)set, set_size);
+        break;
+    default:
+        for (found_at = count; found_at != 0
+            && (CSTL_string_(char_memchr)(set, set + set_size, haystack[found_at - 1]) != NULL) != in_set; --found_at) {}
+        found_at = found_at != 0 ? found_at - 1 : count;
+        break;
+    }
+
+    return found_at != count ? found_at : CSTL_string_npos;
 }
 
 bool CSTL_string_(large_mode_engaged)(CSTL_String(CRef) instance) {
@@ -179,7 +298,43 @@ CSTL_char_t* CSTL_string_(allocate_for_capacity)(size_t capacity, CSTL_Alloc* al
 }
 
 void CSTL_string_(deallocate_for_capacity)(CSTL_char_t* old_ptr, size_t capacity, CSTL_Alloc* alloc) {
-    CSTL_free((void*)old_ptr, capacity + 1, alignof(CSTL_char_t), alloc); // +1 for null terminator
+    size_t size = (capacity + 1) * sizeof(CSTL_char_t); // +1 for null terminator
+    CSTL_free((void*)old_ptr, size, alignof(CSTL_char_t), alloc);
+}
+
+// Grows a large mode buffer to fit `new_size` characters without a separate allocation,
+// if `alloc` supports it. The buffer may only move if it does not contain `[ptr, ptr + count)`.
+bool CSTL_string_(grow_in_place)(CSTL_String(Ref) instance, size_t new_size, const CSTL_char_t* ptr, size_t count, CSTL_Alloc* alloc) {
+    if (!CSTL_string_(large_mode_engaged)(instance)) {
+        return false;
+    }
+
+    CSTL_char_t* old_ptr = instance->bx.ptr;
+
+    size_t old_capacity = instance->res;
+    size_t new_capacity = CSTL_string_(calculate_growth)(new_size, old_capacity);
+    size_t old_bytes    = (old_capacity + 1) * sizeof(CSTL_char_t);
+    size_t new_bytes    = (new_capacity + 1) * sizeof(CSTL_char_t);
+
+    if (CSTL_try_expand(old_ptr, old_bytes, new_bytes, alignof(CSTL_char_t), alloc)) {
+        instance->res = new_capacity;
+        return true;
+    }
+
+    if (count != 0 && ptr < old_ptr + old_capacity + 1 && old_ptr < ptr + count) {
+        return false;
+    }
+
+    CSTL_char_t* new_ptr = (CSTL_char_t*)CSTL_reallocate(old_ptr, old_bytes, new_bytes, alignof(CSTL_char_t), alloc);
+
+    if (new_ptr == NULL) {
+        return false;
+    }
+
+    instance->bx.ptr = new_ptr;
+    instance->res    = new_capacity;
+
+    return true;
 }
 
 void CSTL_string_(tidy_deallocate)(CSTL_String(Ref) instance, CSTL_Alloc* alloc) {
@@ -484,6 +639,10 @@ bool CSTL_string_(reserve)(CSTL_String(Ref) instance, size_t new_capacity, CSTL_
         return false;
     }
 
+    if (CSTL_string_(grow_in_place)(instance, new_capacity, NULL, 0, alloc)) {
+        return true;
+    }
+
     size_t old_capacity  = instance->res;
     new_capacity         = CSTL_string_(calculate_growth)(new_capacity, instance->res);
     CSTL_char_t* new_ptr = CSTL_string_(allocate_for_capacity)(new_capacity, alloc);
@@ -571,6 +730,10 @@ bool CSTL_string_(insert_n_at)(CSTL_String(Ref) instance, size_t off, const CSTL
 
     size_t new_size = old_size + count;
 
+    if (CSTL_string_(grow_in_place)(instance, new_size, ptr, count, alloc)) {
+        return CSTL_string_(insert_n_at)(instance, off, ptr, count, alloc);
+    }
+
     size_t old_capacity  = instance->res;
     size_t new_capacity  = CSTL_string_(calculate_growth)(new_size, instance->res);
     CSTL_char_t* new_ptr = CSTL_string_(allocate_for_capacity)(new_capacity, alloc);
@@ -618,6 +781,10 @@ bool CSTL_string_(insert_char_at)(CSTL_String(Ref) instance, size_t off, size_t
 
     size_t new_size = old_size + count;
 
+    if (CSTL_string_(grow_in_place)(instance, new_size, NULL, 0, alloc)) {
+        return CSTL_string_(insert_char_at)(instance, off, count, ch, alloc);
+    }
+
     size_t old_capacity  = instance->res;
     size_t new_capacity  = CSTL_string_(calculate_growth)(new_size, instance->res);
     CSTL_char_t* new_ptr = CSTL_string_(allocate_for_capacity)(new_capacity, alloc);
@@ -709,6 +876,10 @@ bool CSTL_string_(push_back)(CSTL_String(Ref) instance, CSTL_char_t ch, CSTL_All
 
     size_t new_size = old_size + 1;
 
+    if (CSTL_string_(grow_in_place)(instance, new_size, NULL, 0, alloc)) {
+        return CSTL_string_(push_back)(instance, ch, alloc);
+    }
+
     size_t old_capacity  = instance->res;
     size_t new_capacity  = CSTL_string_(calculate_growth)(new_size, instance->res);
     CSTL_char_t* new_ptr = CSTL_string_(allocate_for_capacity)(new_capacity, alloc);
@@ -760,6 +931,10 @@ bool CSTL_string_(append_n)(CSTL_String(Ref) instance, const CSTL_char_t* ptr, s
         return false;
     }
 
+    if (CSTL_string_(grow_in_place)(instance, new_size, ptr, count, alloc)) {
+        return CSTL_string_(append_n)(instance, ptr, count, alloc);
+    }
+
     size_t old_capacity  = instance->res;
     size_t new_capacity  = CSTL_string_(calculate_growth)(new_size, instance->res);
     CSTL_char_t* new_ptr = CSTL_string_(allocate_for_capacity)(new_capacity, alloc);
@@ -1016,6 +1191,167 @@ size_t CSTL_string_(rfind_str)(CSTL_String(CRef) instance, CSTL_String(CRef) oth
         CSTL_string_(const_ptr)(other), other->size);
 }
 
+size_t CSTL_string_(find_first_of)(CSTL_String(CRef) instance, const CSTL_char_t* ptr, size_t off) {
+    return CSTL_string_(find_first_of_n)(instance, ptr, off, CSTL_string_(char_len)(ptr));
+}
+
+size_t CSTL_string_(find_first_of_n)(CSTL_String(CRef) instance, const CSTL_char_t* ptr, size_t off, size_t count) {
+    return CSTL_string_(char_find_of)(CSTL_string_(const_ptr)(instance), instance->size, off, ptr, count, true);
+}
+
+size_t CSTL_string_(find_first_of_char)(CSTL_String(CRef) instance, CSTL_char_t ch, size_t off) {
+    return CSTL_string_(char_find_of)(CSTL_string_(const_ptr)(instance), instance->size, off, &ch, 1, true);
+}
+
+size_t CSTL_string_(find_first_of_str)(CSTL_String(CRef) instance, CSTL_String(CRef) other, size_t off) {
+    return CSTL_string_(char_find_of)(CSTL_string_(const_ptr)(instance), instance->size, off,
+        CSTL_string_(const_ptr)(other), other->size, true);
+}
+
+size_t CSTL_string_(find_last_of)(CSTL_String(CRef) instance, const CSTL_char_t* ptr, size_t off) {
+    return CSTL_string_(find_last_of_n)(instance, ptr, off, CSTL_string_(char_len)(ptr));
+}
+
+size_t CSTL_string_(find_last_of_n)(CSTL_String(CRef) instance, const CSTL_char_t* ptr, size_t off, size_t count) {
+    return CSTL_string_(char_rfind_of)(CSTL_string_(const_ptr)(instance), instance->size, off, ptr, count, true);
+}
+
+size_t CSTL_string_(find_last_of_char)(CSTL_String(CRef) instance, CSTL_char_t ch, size_t off) {
+    return CSTL_string_(char_rfind_of)(CSTL_string_(const_ptr)(instance), instance->size, off, &ch, 1, true);
+}
+
+size_t CSTL_string_(find_last_of_str)(CSTL_String(CRef) instance, CSTL_String(CRef) other, size_t off) {
+    return CSTL_string_(char_rfind_of)(CSTL_string_(const_ptr)(instance), instance->size, off,
+        CSTL_string_(const_ptr)(other), other->size, true);
+}
+
+size_t CSTL_string_(find_first_not_of)(CSTL_String(CRef) instance, const CSTL_char_t* ptr, size_t off) {
+    return CSTL_string_(find_first_not_of_n)(instance, ptr, off, CSTL_string_(char_len)(ptr));
+}
+
+size_t CSTL_string_(find_first_not_of_n)(CSTL_String(CRef) instance, const CSTL_char_t* ptr, size_t off, size_t count) {
+    return CSTL_string_(char_find_of)(CSTL_string_(const_ptr)(instance), instance->size, off, ptr, count, false);
+}
+
+size_t CSTL_string_(find_first_not_of_char)(CSTL_String(CRef) instance, CSTL_char_t ch, size_t off) {
+    return CSTL_string_(char_find_of)(CSTL_string_(const_ptr)(instance), instance->size, off, &ch, 1, false);
+}
+
+size_t CSTL_string_(find_first_not_of_str)(CSTL_String(CRef) instance, CSTL_String(CRef) other, size_t off) {
+    return CSTL_string_(char_find_of)(CSTL_string_(const_ptr)(instance), instance->size, off,
+        CSTL_string_(const_ptr)(other), other->size, false);
+}
+
+size_t CSTL_string_(find_last_not_of)(CSTL_String(CRef) instance, const CSTL_char_t* ptr, size_t off) {
+    return CSTL_string_(find_last_not_of_n)(instance, ptr, off, CSTL_string_(char_len)(ptr));
+}
+
+size_t CSTL_string_(find_last_not_of_n)(CSTL_String(CRef) instance, const CSTL_char_t* ptr, size_t off, size_t count) {
+    return CSTL_string_(char_rfind_of)(CSTL_string_(const_ptr)(instance), instance->size, off, ptr, count, false);
+}
+
+size_t CSTL_string_(find_last_not_of_char)(CSTL_String(CRef) instance, CSTL_char_t ch, size_t off) {
+    return CSTL_string_(char_rfind_of)(CSTL_string_(const_ptr)(instance), instance->size, off, &ch, 1, false);
+}
+
+size_t CSTL_string_(find_last_not_of_str)(CSTL_String(CRef) instance, CSTL_String(CRef) other, size_t off) {
+    return CSTL_string_(char_rfind_of)(CSTL_string_(const_ptr)(instance), instance->size, off,
+        CSTL_string_(const_ptr)(other), other->size, false);
+}
+
+void CSTL_string_(searcher_init)(CSTL_String(Searcher)* new_searcher, const CSTL_char_t* needle, size_t count) {
+    CSTL_char_search_init(&new_searcher->state, (const void*)needle, count, sizeof(CSTL_char_t));
+}
+
+size_t CSTL_string_(searcher_find)(const CSTL_String(Searcher)* searcher, CSTL_String(CRef) instance, size_t off) {
+    size_t needle_size = searcher->state.size;
+    size_t hay_size    = instance->size;
+
+    if (needle_size > hay_size || off > hay_size - needle_size) {
+        return CSTL_string_npos;
+    }
+
+    if (needle_size == 0) {
+        return off;
+    }
+
+    size_t count    = hay_size - off;
+    size_t found_at = CSTL_char_search_find(&searcher->state, (const void*)(CSTL_string_(const_ptr)(instance) + off), count);
+    return found_at != count ? off + found_at : CSTL_string_npos;
+}
+
+size_t CSTL_string_(searcher_rfind)(const CSTL_String(Searcher)* searcher, CSTL_String(CRef) instance, size_t off) {
+    size_t needle_size = searcher->state.size;
+    size_t hay_size    = instance->size;
+
+    if (needle_size > hay_size) {
+        return CSTL_string_npos;
+    }
+
+    size_t start_pos = off < hay_size - needle_size ? off : hay_size - needle_size;
+    return CSTL_string_(searcher_rfind_in)(searcher, CSTL_string_(const_ptr)(instance), start_pos + needle_size);
+}
+
+size_t CSTL_string_(searcher_find_in)(const CSTL_String(Searcher)* searcher, const CSTL_char_t* ptr, size_t count) {
+    if (searcher->state.size == 0) {
+        return 0;
+    }
+
+    size_t found_at = CSTL_char_search_find(&searcher->state, (const void*)ptr, count);
+    return found_at != count ? found_at : CSTL_string_npos;
+}
+
+size_t CSTL_string_(searcher_rfind_in)(const CSTL_String(Searcher)* searcher, const CSTL_char_t* ptr, size_t count) {
+    if (searcher->state.size == 0) {
+        return count;
+    }
+
+    size_t found_at = CSTL_char_search_rfind(&searcher->state, (const void*)ptr, count);
+    return found_at != count ? found_at : CSTL_string_npos;
+}
+
+size_t CSTL_string_(searcher_count)(const CSTL_String(Searcher)* searcher, CSTL_String(CRef) instance) {
+    return CSTL_string_(searcher_find_all_in)(searcher, CSTL_string_(const_ptr)(instance), instance->size, NULL, 0);
+}
+
+size_t CSTL_string_(searcher_count_in)(const CSTL_String(Searcher)* searcher, const CSTL_char_t* ptr, size_t count) {
+    return CSTL_string_(searcher_find_all_in)(searcher, ptr, count, NULL, 0);
+}
+
+size_t CSTL_string_(searcher_find_all)(const CSTL_String(Searcher)* searcher, CSTL_String(CRef) instance, size_t* positions, size_t capacity) {
+    return CSTL_string_(searcher_find_all_in)(searcher, CSTL_string_(const_ptr)(instance), instance->size, positions, capacity);
+}
+
+size_t CSTL_string_(searcher_find_all_in)(const CSTL_String(Searcher)* searcher, const CSTL_char_t* ptr, size_t count, size_t* positions, size_t capacity) {
+    size_t needle_size = searcher->state.size;
+    size_t found       = 0;
+
+    if (needle_size == 0) {
+        for (; found < capacity && found <= count; ++found) {
+            positions[found] = found;
+        }
+
+        return count + 1;
+    }
+
+    for (size_t pos = 0; count - pos >= needle_size;) {
+        size_t found_at = CSTL_char_search_find(&searcher->state, (const void*)(ptr + pos), count - pos);
+        if (found_at == count - pos) {
+            break;
+        }
+
+        pos += found_at;
+        if (found < capacity) {
+            positions[found] = pos;
+        }
+
+        ++found;
+        pos += needle_size;
+    }
+
+    return found;
+}
+
 int CSTL_string_(compare)(const CSTL_char_t* left, const CSTL_char_t* right) {
     return CSTL_string_(compare_nn)(left, CSTL_string_(char_len)(left), right, CSTL_string_(char_len)(right));
 }
@@ -1029,13 +1365,274 @@ int CSTL_string_(compare_nn)(const CSTL_char_t* left, size_t left_count, const C
     size_t count       = left_lt_right ? left_count : right_count;
 
     int result = CSTL_string_(char_memcmp)(left, right, count);
-    if (result == 0) {
+    if (result == 0 && left_count != right_count) {
         return left_lt_right ? -1 : 1;
     } else {
         return result;
     }
 }
 
+size_t CSTL_string_(hash_n)(const CSTL_char_t* ptr, size_t count) {
+    return CSTL_char_hash_fnv((const void*)ptr, count * sizeof(CSTL_char_t));
+}
+
+size_t CSTL_string_(hash)(CSTL_String(CRef) instance) {
+    return CSTL_string_(hash_n)(CSTL_string_(const_ptr)(instance), instance->size);
+}
+
+size_t CSTL_string_(fast_hash_n)(const CSTL_char_t* ptr, size_t count) {
+    return CSTL_char_hash_fast((const void*)ptr, count * sizeof(CSTL_char_t));
+}
+
+size_t CSTL_string_(fast_hash)(CSTL_String(CRef) instance) {
+    return CSTL_string_(fast_hash_n)(CSTL_string_(const_ptr)(instance), instance->size);
+}
+
+static bool CSTL_string_(hash_is_eq)(const void* left, const void* right) {
+    CSTL_String(CRef) left_str  = (CSTL_String(CRef))left;
+    CSTL_String(CRef) right_str = (CSTL_String(CRef))right;
+
+    return left_str->size == right_str->size
+        && CSTL_string_(char_memcmp)(CSTL_string_(const_ptr)(left_str), CSTL_string_(const_ptr)(right_str), left_str->size) == 0;
+}
+
+static size_t CSTL_string_(hash_of)(const void* instance) {
+    return CSTL_string_(hash)((CSTL_String(CRef))instance);
+}
+
+static size_t CSTL_string_(fast_hash_of)(const void* instance) {
+    return CSTL_string_(fast_hash)((CSTL_String(CRef))instance);
+}
+
+const CSTL_HashType CSTL_string_(hash_type)      = { &CSTL_string_(hash_is_eq), &CSTL_string_(hash_of) };
+const CSTL_HashType CSTL_string_(fast_hash_type) = { &CSTL_string_(hash_is_eq), &CSTL_string_(fast_hash_of) };
+
+CSTL_String(View) CSTL_string_(view)(const CSTL_char_t* ptr) {
+    return CSTL_string_(view_n)(ptr, CSTL_string_(char_len)(ptr));
+}
+
+CSTL_String(View) CSTL_string_(view_n)(const CSTL_char_t* ptr, size_t count) {
+    CSTL_String(View) view = { ptr, count };
+    return view;
+}
+
+CSTL_String(View) CSTL_string_(as_view)(CSTL_String(CRef) instance) {
+    return CSTL_string_(view_n)(CSTL_string_(const_ptr)(instance), instance->size);
+}
+
+bool CSTL_string_(assign_view)(CSTL_String(Ref) instance, CSTL_String(View) view, CSTL_Alloc* alloc) {
+    return CSTL_string_(assign_n)(instance, view.data, view.size, alloc);
+}
+
+bool CSTL_string_(append_view)(CSTL_String(Ref) instance, CSTL_String(View) view, CSTL_Alloc* alloc) {
+    return CSTL_string_(append_n)(instance, view.data, view.size, alloc);
+}
+
+const CSTL_char_t* CSTL_string_(view_at)(CSTL_String(View) view, size_t pos) {
+    if (view.size <= pos) {
+        return NULL;
+    }
+
+    return &view.data[pos];
+}
+
+void CSTL_string_(view_remove_prefix)(CSTL_String(View)* view, size_t count) {
+    assert(count <= view->size);
+    view->data += count;
+    view->size -= count;
+}
+
+void CSTL_string_(view_remove_suffix)(CSTL_String(View)* view, size_t count) {
+    assert(count <= view->size);
+    view->size -= count;
+}
+
+bool CSTL_string_(view_substr)(CSTL_String(View)* new_view, CSTL_String(View) view, size_t off, size_t count) {
+    if (view.size < off) {
+        return false;
+    }
+
+    size_t suffix_size = view.size - off;
+    new_view->data = view.data + off;
+    new_view->size = count < suffix_size ? count : suffix_size;
+
+    return true;
+}
+
+size_t CSTL_string_(view_copy)(CSTL_String(View) view, CSTL_char_t* dest, size_t count, size_t off) {
+    CSTL_String(View) substr;
+
+    if (!CSTL_string_(view_substr)(&substr, view, off, count)) {
+        return CSTL_string_npos;
+    }
+
+    CSTL_string_(char_copy)(dest, substr.data, substr.size);
+
+    return substr.size;
+}
+
+int CSTL_string_(view_compare)(CSTL_String(View) left, CSTL_String(View) right) {
+    return CSTL_string_(compare_nn)(left.data, left.size, right.data, right.size);
+}
+
+bool CSTL_string_(view_equal)(CSTL_String(View) left, CSTL_String(View) right) {
+    return left.size == right.size && CSTL_string_(char_memcmp)(left.data, right.data, left.size) == 0;
+}
+
+bool CSTL_string_(view_starts_with)(CSTL_String(View) view, CSTL_String(View) prefix) {
+    return prefix.size <= view.size && CSTL_string_(char_memcmp)(view.data, prefix.data, prefix.size) == 0;
+}
+
+bool CSTL_string_(view_ends_with)(CSTL_String(View) view, CSTL_String(View) suffix) {
+    return suffix.size <= view.size
+        && CSTL_string_(char_memcmp)(view.data + (view.size - suffix.size), suffix.data, suffix.size) == 0;
+}
+
+size_t CSTL_string_(view_find)(CSTL_String(View) view, CSTL_String(View) needle, size_t off) {
+    return CSTL_string_(char_find_str)(view.data, view.size, off, needle.data, needle.size);
+}
+
+size_t CSTL_string_(view_find_char)(CSTL_String(View) view, CSTL_char_t ch, size_t off) {
+    return CSTL_string_(char_find_ch)(view.data, view.size, off, ch);
+}
+
+size_t CSTL_string_(view_rfind)(CSTL_String(View) view, CSTL_String(View) needle, size_t off) {
+    return CSTL_string_(char_rfind_str)(view.data, view.size, off, needle.data, needle.size);
+}
+
+size_t CSTL_string_(view_rfind_char)(CSTL_String(View) view, CSTL_char_t ch, size_t off) {
+    return CSTL_string_(char_rfind_ch)(view.data, view.size, off, ch);
+}
+
+size_t CSTL_string_(view_find_first_of)(CSTL_String(View) view, CSTL_String(View) set, size_t off) {
+    return CSTL_string_(char_find_of)(view.data, view.size, off, set.data, set.size, true);
+}
+
+size_t CSTL_string_(view_find_last_of)(CSTL_String(View) view, CSTL_String(View) set, size_t off) {
+    return CSTL_string_(char_rfind_of)(view.data, view.size, off, set.data, set.size, true);
+}
+
+size_t CSTL_string_(view_find_first_not_of)(CSTL_String(View) view, CSTL_String(View) set, size_t off) {
+    return CSTL_string_(char_find_of)(view.data, view.size, off, set.data, set.size, false);
+}
+
+size_t CSTL_string_(view_find_first_not_of_char)(CSTL_String(View) view, CSTL_char_t ch, size_t off) {
+    return CSTL_string_(char_find_of)(view.data, view.size, off, &ch, 1, false);
+}
+
+size_t CSTL_string_(view_find_last_not_of)(CSTL_String(View) view, CSTL_String(View) set, size_t off) {
+    return CSTL_string_(char_rfind_of)(view.data, view.size, off, set.data, set.size, false);
+}
+
+size_t CSTL_string_(view_find_last_not_of_char)(CSTL_String(View) view, CSTL_char_t ch, size_t off) {
+    return CSTL_string_(char_rfind_of)(view.data, view.size, off, &ch, 1, false);
+}
+
+size_t CSTL_string_(view_hash)(CSTL_String(View) view) {
+    return CSTL_string_(hash_n)(view.data, view.size);
+}
+
+size_t CSTL_string_(view_fast_hash)(CSTL_String(View) view) {
+    return CSTL_string_(fast_hash_n)(view.data, view.size);
+}
+
+void CSTL_string_(split_init)(CSTL_String(Split)* new_split, CSTL_String(View) view, CSTL_char_t delim, bool skip_empty) {
+    new_split->rest       = view;
+    new_split->delim      = CSTL_string_(view_n)(NULL, 0);
+    new_split->ch         = delim;
+    new_split->mode       = CSTL_string_split_char;
+    new_split->skip_empty = skip_empty;
+    new_split->done       = false;
+}
+
+void CSTL_string_(split_init_any_of)(CSTL_String(Split)* new_split, CSTL_String(View) view, CSTL_String(View) set, bool skip_empty) {
+    CSTL_string_(split_init)(new_split, view, 0, skip_empty);
+    new_split->delim = set;
+    new_split->mode  = CSTL_string_split_any_of;
+}
+
+void CSTL_string_(split_init_str)(CSTL_String(Split)* new_split, CSTL_String(View) view, CSTL_String(View) delim, bool skip_empty) {
+    CSTL_string_(split_init)(new_split, view, 0, skip_empty);
+    new_split->delim = delim;
+    new_split->mode  = CSTL_string_split_str;
+}
+
+bool CSTL_string_(split_next)(CSTL_String(Split)* split, CSTL_String(View)* field) {
+    CSTL_String(View) rest  = split->rest;
+    CSTL_String(View) delim = split->delim;
+
+    while (!split->done) {
+        CSTL_String(View) next;
+        size_t pos;
+        size_t delim_size = 1;
+
+        switch (split->mode) {
+        case CSTL_string_split_char:
+            pos = CSTL_string_(char_find_ch)(rest.data, rest.size, 0, split->ch);
+            break;
+        case CSTL_string_split_any_of:
+            pos = CSTL_string_(char_find_of)(rest.data, rest.size, 0, delim.data, delim.size, true);
+            break;
+        default:
+            // An empty delimiter would match everywhere without making progress.
+            pos = delim.size == 0 ? rest.size
+                : CSTL_string_(char_find_str)(rest.data, rest.size, 0, delim.data, delim.size);
+            delim_size = delim.size;
+            break;
+        }
+
+        // Not found is `CSTL_string_npos`.
+        if (pos >= rest.size) {
+            next = rest;
+            split->done = true;
+        } else {
+            next = CSTL_string_(view_n)(rest.data, pos);
+            rest.data += pos + delim_size;
+            rest.size -= pos + delim_size;
+        }
+
+        if (!split->skip_empty || next.size != 0) {
+            *field = next;
+            split->rest = rest;
+            return true;
+        }
+    }
+
+    split->rest = rest;
+    return false;
+}
+
+bool CSTL_string_(split_into_vector)(CSTL_String(Split)* split, CSTL_VectorRef vector, CSTL_Alloc* alloc) {
+    CSTL_PodType pod = CSTL_pod_type(sizeof(CSTL_String(View)), alignof(CSTL_String(View)));
+
+    CSTL_String(Split) start   = *split;
+    CSTL_String(Split) counter = *split;
+    CSTL_String(View) field;
+    size_t count = 0;
+
+    while (CSTL_string_(split_next)(&counter, &field)) {
+        ++count;
+    }
+
+    size_t old_size = CSTL_vector_size(vector, pod.type);
+
+    if (count > CSTL_vector_max_size(pod.type) - old_size
+        || !CSTL_vector_reserve(vector, pod.type, &pod.copy.move_type, old_size + count, alloc)) {
+        return false;
+    }
+
+    // Cannot allocate after the reserve above.
+    while (CSTL_string_(split_next)(split, &field)) {
+        if (!CSTL_vector_copy_push_back(vector, pod.type, &pod.copy, &field, alloc)) {
+            CSTL_vector_truncate(vector, pod.type, &pod.copy.move_type.drop_type, old_size);
+            *split = start;
+            return false;
+        }
+    }
+
+    return true;
+}
+
 CSTL_char_t* CSTL_string_(insert)(CSTL_String(Ref) instance, const CSTL_char_t* where, const CSTL_char_t* ptr, CSTL_Alloc* alloc) {
     CSTL_char_t* ptr1 = CSTL_string_(ptr)(instance);
     size_t off = (size_t)(where - ptr1);
@@ -0,0 +1,516 @@
+#include "char_class.h"
+
+#include "char_simd.h"
+
+// Sets up to this many characters are matched with one comparison per member.
+#define CSTL_class_small 16
+
+// Single byte sets above this many characters use the vectorised bitmap lookup.
+#define CSTL_class_bitmap_min 4
+
+typedef struct CSTL_CharClass {
+    const unsigned char* set;
+    size_t size;
+    bool has_wide;      // some member is above 255, see `CSTL_class_init_bitmap`
+    uint64_t bitmap[4]; // members below 256
+} CSTL_CharClass;
+
+static inline void CSTL_class_init(CSTL_CharClass* cls, const void* set, size_t size) {
+    cls->set  = (const unsigned char*)set;
+    cls->size = size;
+}
+
+// Only the scalar paths need the bitmap.
+static inline void CSTL_class_init_bitmap(CSTL_CharClass* cls, size_t width) {
+    cls->has_wide = false;
+
+    for (size_t i = 0; i != 4; ++i) {
+        cls->bitmap[i] = 0;
+    }
+
+    for (size_t i = 0; i != cls->size; ++i) {
+        uint32_t ch = CSTL_char_load(cls->set + i * width, width);
+
+        if (ch < 256) {
+            cls->bitmap[ch >> 6] |= (uint64_t)1 << (ch & 63);
+        } else {
+            cls->has_wide = true;
+        }
+    }
+}
+
+static inline bool CSTL_class_contains(const CSTL_CharClass* cls, uint32_t ch, size_t width) {
+    if (ch < 256) {
+        return (cls->bitmap[ch >> 6] >> (ch & 63) & 1) != 0;
+    }
+
+    if (cls->has_wide) {
+        for (size_t i = 0; i != cls->size; ++i) {
+            if (CSTL_char_load(cls->set + i * width, width) == ch) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+// Scalar fallbacks, also used for ranges shorter than one vector.
+// All offsets are in bytes, results are byte offsets of the matching element.
+
+static inline size_t CSTL_scalar_class_find(const unsigned char* first, size_t bytes, CSTL_CharClass* cls, bool in_set, size_t width) {
+    CSTL_class_init_bitmap(cls, width);
+
+    for (size_t off = 0; off != bytes; off += width) {
+        if (CSTL_class_contains(cls, CSTL_char_load(first + off, width), width) == in_set) {
+            return off;
+        }
+    }
+    return bytes;
+}
+
+static inline size_t CSTL_scalar_class_rfind(const unsigned char* first, size_t bytes, CSTL_CharClass* cls, bool in_set, size_t width) {
+    CSTL_class_init_bitmap(cls, width);
+
+    for (size_t off = bytes; off != 0;) {
+        off -= width;
+        if (CSTL_class_contains(cls, CSTL_char_load(first + off, width), width) == in_set) {
+            return off;
+        }
+    }
+    return bytes;
+}
+
+#ifdef CSTL_char_sse2
+typedef struct CSTL_Sse2Class {
+    __m128i set[CSTL_class_small];
+    size_t size;
+} CSTL_Sse2Class;
+
+static inline void CSTL_sse2_class_init(CSTL_Sse2Class* vcls, const CSTL_CharClass* cls, size_t width) {
+    vcls->size = cls->size;
+    for (size_t i = 0; i != cls->size; ++i) {
+        vcls->set[i] = CSTL_sse2_set1(CSTL_char_load(cls->set + i * width, width), width);
+    }
+}
+
+static inline uint32_t CSTL_sse2_class_mask(const unsigned char* ptr, const CSTL_Sse2Class* vcls, bool in_set, size_t width) {
+    __m128i chunk = _mm_loadu_si128((const __m128i*)ptr);
+    __m128i any   = _mm_setzero_si128();
+
+    for (size_t i = 0; i != vcls->size; ++i) {
+        any = _mm_or_si128(any, CSTL_sse2_cmpeq(chunk, vcls->set[i], width));
+    }
+
+    uint32_t mask = (uint32_t)_mm_movemask_epi8(any);
+    return in_set ? mask : mask ^ 0xFFFFu;
+}
+
+// `bytes >= 16`, `cls->size <= CSTL_class_small`
+static inline size_t CSTL_sse2_class_find(const unsigned char* first, size_t bytes, const CSTL_CharClass* cls, bool in_set, size_t width) {
+    CSTL_Sse2Class vcls;
+    CSTL_sse2_class_init(&vcls, cls, width);
+    size_t off = 0;
+
+    for (; bytes - off >= 16; off += 16) {
+        uint32_t mask = CSTL_sse2_class_mask(first + off, &vcls, in_set, width);
+        if (mask != 0) {
+            return off + CSTL_ctz32(mask);
+        }
+    }
+
+    if (off != bytes) { // overlapping tail, the overlap is known not to match
+        off = bytes - 16;
+        uint32_t mask = CSTL_sse2_class_mask(first + off, &vcls, in_set, width);
+        if (mask != 0) {
+            return off + CSTL_ctz32(mask);
+        }
+    }
+
+    return bytes;
+}
+
+// `bytes >= 16`, `cls->size <= CSTL_class_small`
+static inline size_t CSTL_sse2_class_rfind(const unsigned char* first, size_t bytes, const CSTL_CharClass* cls, bool in_set, size_t width) {
+    CSTL_Sse2Class vcls;
+    CSTL_sse2_class_init(&vcls, cls, width);
+    size_t off = bytes;
+
+    while (off >= 16) {
+        off -= 16;
+        uint32_t mask = CSTL_sse2_class_mask(first + off, &vcls, in_set, width);
+        if (mask != 0) {
+            return off + CSTL_bsr32(mask);
+        }
+    }
+
+    if (off != 0) { // overlapping head, the overlap is known not to match
+        uint32_t mask = CSTL_sse2_class_mask(first, &vcls, in_set, width);
+        if (mask != 0) {
+            return CSTL_bsr32(mask);
+        }
+    }
+
+    return bytes;
+}
+#endif
+
+#ifdef CSTL_char_avx2
+typedef struct CSTL_Avx2Class {
+    __m256i set[CSTL_class_small];
+    size_t size;
+} CSTL_Avx2Class;
+
+// The bitmap lookup is only used for single byte characters.
+typedef struct CSTL_Avx2Bitmap {
+    __m256i rows_lo; // bit `h` of byte `l` is set if `h * 16 + l` is a member
+    __m256i rows_hi; // bit `h` of byte `l` is set if `(h + 8) * 16 + l` is a member
+} CSTL_Avx2Bitmap;
+
+CSTL_target_avx2 static inline void CSTL_avx2_class_init(CSTL_Avx2Class* vcls, const CSTL_CharClass* cls, size_t width) {
+    vcls->size = cls->size;
+    for (size_t i = 0; i != cls->size; ++i) {
+        vcls->set[i] = CSTL_avx2_set1(CSTL_char_load(cls->set + i * width, width), width);
+    }
+}
+
+CSTL_target_avx2 static inline void CSTL_avx2_bitmap_init(CSTL_Avx2Bitmap* vbits, const CSTL_CharClass* cls) {
+    unsigned char rows_lo[16] = {0};
+    unsigned char rows_hi[16] = {0};
+
+    for (size_t i = 0; i != cls->size; ++i) {
+        unsigned ch = cls->set[i];
+        (ch < 128 ? rows_lo : rows_hi)[ch & 15] |= (unsigned char)(1u << (ch >> 4 & 7));
+    }
+
+    vbits->rows_lo = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)rows_lo));
+    vbits->rows_hi = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)rows_hi));
+}
+
+CSTL_target_avx2 static inline uint32_t CSTL_avx2_class_mask(const unsigned char* ptr, const CSTL_Avx2Class* vcls, bool in_set, size_t width) {
+    __m256i chunk = _mm256_loadu_si256((const __m256i*)ptr);
+    __m256i any   = _mm256_setzero_si256();
+
+    for (size_t i = 0; i != vcls->size; ++i) {
+        any = _mm256_or_si256(any, CSTL_avx2_cmpeq(chunk, vcls->set[i], width));
+    }
+
+    uint32_t mask = (uint32_t)_mm256_movemask_epi8(any);
+    return in_set ? mask : ~mask;
+}
+
+CSTL_target_avx2 static inline uint32_t CSTL_avx2_bitmap_mask(const unsigned char* ptr, const CSTL_Avx2Bitmap* vbits, bool in_set) {
+    __m256i chunk = _mm256_loadu_si256((const __m256i*)ptr);
+
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i bits   = _mm256_setr_epi8(
+        1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+        1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+
+    __m256i lo = _mm256_and_si256(chunk, nibble);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(chunk, 4), nibble);
+
+    // The top bit of each character picks the row table
+    __m256i row = _mm256_blendv_epi8(
+        _mm256_shuffle_epi8(vbits->rows_lo, lo), _mm256_shuffle_epi8(vbits->rows_hi, lo), chunk);
+    __m256i bit = _mm256_shuffle_epi8(bits, hi);
+
+    __m256i absent = _mm256_cmpeq_epi8(_mm256_and_si256(row, bit), _mm256_setzero_si256());
+    uint32_t mask  = ~(uint32_t)_mm256_movemask_epi8(absent);
+    return in_set ? mask : ~mask;
+}
+
+// `bytes >= 32`, `cls->size <= CSTL_class_small`
+CSTL_target_avx2 static inline size_t CSTL_avx2_class_find(const unsigned char* first, size_t bytes, const CSTL_CharClass* cls, bool in_set, size_t width) {
+    CSTL_Avx2Class vcls;
+    CSTL_avx2_class_init(&vcls, cls, width);
+    size_t off = 0;
+
+    for (; bytes - off >= 32; off += 32) {
+        uint32_t mask = CSTL_avx2_class_mask(first + off, &vcls, in_set, width);
+        if (mask != 0) {
+            return off + CSTL_ctz32(mask);
+        }
+    }
+
+    if (off != bytes) {
+        off = bytes - 32;
+        uint32_t mask = CSTL_avx2_class_mask(first + off, &vcls, in_set, width);
+        if (mask != 0) {
+            return off + CSTL_ctz32(mask);
+        }
+    }
+
+    return bytes;
+}
+
+// `bytes >= 32`, `cls->size <= CSTL_class_small`
+CSTL_target_avx2 static inline size_t CSTL_avx2_class_rfind(const unsigned char* first, size_t bytes, const CSTL_CharClass* cls, bool in_set, size_t width) {
+    CSTL_Avx2Class vcls;
+    CSTL_avx2_class_init(&vcls, cls, width);
+    size_t off = bytes;
+
+    while (off >= 32) {
+        off -= 32;
+        uint32_t mask = CSTL_avx2_class_mask(first + off, &vcls, in_set, width);
+        if (mask != 0) {
+            return off + CSTL_bsr32(mask);
+        }
+    }
+
+    if (off != 0) {
+        uint32_t mask = CSTL_avx2_class_mask(first, &vcls, in_set, width);
+        if (mask != 0) {
+            return CSTL_bsr32(mask);
+        }
+    }
+
+    return bytes;
+}
+
+// `bytes >= 32`, single byte characters only
+CSTL_target_avx2 static inline size_t CSTL_avx2_bitmap_find(const unsigned char* first, size_t bytes, const CSTL_CharClass* cls, bool in_set) {
+    CSTL_Avx2Bitmap vbits;
+    CSTL_avx2_bitmap_init(&vbits, cls);
+    size_t off = 0;
+
+    for (; bytes - off >= 32; off += 32) {
+        uint32_t mask = CSTL_avx2_bitmap_mask(first + off, &vbits, in_set);
+        if (mask != 0) {
+            return off + CSTL_ctz32(mask);
+        }
+    }
+
+    if (off != bytes) {
+        off = bytes - 32;
+        uint32_t mask = CSTL_avx2_bitmap_mask(first + off, &vbits, in_set);
+        if (mask != 0) {
+            return off + CSTL_ctz32(mask);
+        }
+    }
+
+    return bytes;
+}
+
+// `bytes >= 32`, single byte characters only
+CSTL_target_avx2 static inline size_t CSTL_avx2_bitmap_rfind(const unsigned char* first, size_t bytes, const CSTL_CharClass* cls, bool in_set) {
+    CSTL_Avx2Bitmap vbits;
+    CSTL_avx2_bitmap_init(&vbits, cls);
+    size_t off = bytes;
+
+    while (off >= 32) {
+        off -= 32;
+        uint32_t mask = CSTL_avx2_bitmap_mask(first + off, &vbits, in_set);
+        if (mask != 0) {
+            return off + CSTL_bsr32(mask);
+        }
+    }
+
+    if (off != 0) {
+        uint32_t mask = CSTL_avx2_bitmap_mask(first, &vbits, in_set);
+        if (mask != 0) {
+            return CSTL_bsr32(mask);
+        }
+    }
+
+    return bytes;
+}
+
+CSTL_target_avx2 static size_t CSTL_avx2_class_find_n(const unsigned char* first, size_t bytes, const CSTL_CharClass* cls, bool in_set, size_t width) {
+    switch (width) {
+    case 1:
+        if (cls->size > CSTL_class_bitmap_min) {
+            return CSTL_avx2_bitmap_find(first, bytes, cls, in_set);
+        }
+        return CSTL_avx2_class_find(first, bytes, cls, in_set, 1);
+    case 2:  return CSTL_avx2_class_find(first, bytes, cls, in_set, 2);
+    default: return CSTL_avx2_class_find(first, bytes, cls, in_set, 4);
+    }
+}
+
+CSTL_target_avx2 static size_t CSTL_avx2_class_rfind_n(const unsigned char* first, size_t bytes, const CSTL_CharClass* cls, bool in_set, size_t width) {
+    switch (width) {
+    case 1:
+        if (cls->size > CSTL_class_bitmap_min) {
+            return CSTL_avx2_bitmap_rfind(first, bytes, cls, in_set);
+        }
+        return CSTL_avx2_class_rfind(first, bytes, cls, in_set, 1);
+    case 2:  return CSTL_avx2_class_rfind(first, bytes, cls, in_set, 2);
+    default: return CSTL_avx2_class_rfind(first, bytes, cls, in_set, 4);
+    }
+}
+#endif
+
+#ifdef CSTL_char_neon
+typedef struct CSTL_NeonClass {
+    uint8x16_t set[CSTL_class_small];
+    size_t size;
+} CSTL_NeonClass;
+
+static inline void CSTL_neon_class_init(CSTL_NeonClass* vcls, const CSTL_CharClass* cls, size_t width) {
+    vcls->size = cls->size;
+    for (size_t i = 0; i != cls->size; ++i) {
+        vcls->set[i] = CSTL_neon_set1(CSTL_char_load(cls->set + i * width, width), width);
+    }
+}
+
+static inline uint64_t CSTL_neon_class_mask(const unsigned char* ptr, const CSTL_NeonClass* vcls, bool in_set, size_t width) {
+    uint8x16_t chunk = vld1q_u8(ptr);
+    uint8x16_t any   = vdupq_n_u8(0);
+
+    for (size_t i = 0; i != vcls->size; ++i) {
+        any = vorrq_u8(any, CSTL_neon_cmpeq(chunk, vcls->set[i], width));
+    }
+
+    uint64_t mask = CSTL_neon_mask(any);
+    return in_set ? mask : ~mask;
+}
+
+// `bytes >= 16`, `cls->size <= CSTL_class_small`
+static inline size_t CSTL_neon_class_find(const unsigned char* first, size_t bytes, const CSTL_CharClass* cls, bool in_set, size_t width) {
+    CSTL_NeonClass vcls;
+    CSTL_neon_class_init(&vcls, cls, width);
+    size_t off = 0;
+
+    for (; bytes - off >= 16; off += 16) {
+        uint64_t mask = CSTL_neon_class_mask(first + off, &vcls, in_set, width);
+        if (mask != 0) {
+            return off + CSTL_ctz64(mask) / 4;
+        }
+    }
+
+    if (off != bytes) {
+        off = bytes - 16;
+        uint64_t mask = CSTL_neon_class_mask(first + off, &vcls, in_set, width);
+        if (mask != 0) {
+            return off + CSTL_ctz64(mask) / 4;
+        }
+    }
+
+    return bytes;
+}
+
+// `bytes >= 16`, `cls->size <= CSTL_class_small`
+static inline size_t CSTL_neon_class_rfind(const unsigned char* first, size_t bytes, const CSTL_CharClass* cls, bool in_set, size_t width) {
+    CSTL_NeonClass vcls;
+    CSTL_neon_class_init(&vcls, cls, width);
+    size_t off = bytes;
+
+    while (off >= 16) {
+        off -= 16;
+        uint64_t mask = CSTL_neon_class_mask(first + off, &vcls, in_set, width);
+        if (mask != 0) {
+            return off + CSTL_bsr64(mask) / 4;
+        }
+    }
+
+    if (off != 0) {
+        uint64_t mask = CSTL_neon_class_mask(first, &vcls, in_set, width);
+        if (mask != 0) {
+            return CSTL_bsr64(mask) / 4;
+        }
+    }
+
+    return bytes;
+}
+#endif
+
+// Width generic dispatchers, `width` and `in_set` are always constants.
+
+static inline size_t CSTL_char_class_find(const void* first, size_t count, const void* set, size_t set_size, bool in_set, size_t width) {
+    const unsigned char* bytes_first = (const unsigned char*)first;
+    size_t bytes = count * width;
+
+    CSTL_CharClass cls;
+    CSTL_class_init(&cls, set, set_size);
+
+#if defined(CSTL_char_sse2)
+#if defined(CSTL_char_avx2)
+    if (bytes >= 32 && (set_size <= CSTL_class_small || width == 1) && CSTL_has_avx2()) {
+        return CSTL_avx2_class_find_n(bytes_first, bytes, &cls, in_set, width) / width;
+    }
+#endif
+    if (bytes >= 16 && set_size <= CSTL_class_small) {
+        return CSTL_sse2_class_find(bytes_first, bytes, &cls, in_set, width) / width;
+    }
+#elif defined(CSTL_char_neon)
+    if (bytes >= 16 && set_size <= CSTL_class_small) {
+        return CSTL_neon_class_find(bytes_first, bytes, &cls, in_set, width) / width;
+    }
+#endif
+
+    return CSTL_scalar_class_find(bytes_first, bytes, &cls, in_set, width) / width;
+}
+
+static inline size_t CSTL_char_class_rfind(const void* first, size_t count, const void* set, size_t set_size, bool in_set, size_t width) {
+    const unsigned char* bytes_first = (const unsigned char*)first;
+    size_t bytes = count * width;
+
+    CSTL_CharClass cls;
+    CSTL_class_init(&cls, set, set_size);
+
+#if defined(CSTL_char_sse2)
+#if defined(CSTL_char_avx2)
+    if (bytes >= 32 && (set_size <= CSTL_class_small || width == 1) && CSTL_has_avx2()) {
+        return CSTL_avx2_class_rfind_n(bytes_first, bytes, &cls, in_set, width) / width;
+    }
+#endif
+    if (bytes >= 16 && set_size <= CSTL_class_small) {
+        return CSTL_sse2_class_rfind(bytes_first, bytes, &cls, in_set, width) / width;
+    }
+#elif defined(CSTL_char_neon)
+    if (bytes >= 16 && set_size <= CSTL_class_small) {
+        return CSTL_neon_class_rfind(bytes_first, bytes, &cls, in_set, width) / width;
+    }
+#endif
+
+    return CSTL_scalar_class_rfind(bytes_first, bytes, &cls, in_set, width) / width;
+}
+
+size_t CSTL_char_find_of_1(const void* first, size_t count, const void* set, size_t set_size) {
+    return CSTL_char_class_find(first, count, set, set_size, true, 1);
+}
+
+size_t CSTL_char_find_of_2(const void* first, size_t count, const void* set, size_t set_size) {
+    return CSTL_char_class_find(first, count, set, set_size, true, 2);
+}
+
+size_t CSTL_char_find_of_4(const void* first, size_t count, const void* set, size_t set_size) {
+    return CSTL_char_class_find(first, count, set, set_size, true, 4);
+}
+
+size_t CSTL_char_find_not_of_1(const void* first, size_t count, const void* set, size_t set_size) {
+    return CSTL_char_class_find(first, count, set, set_size, false, 1);
+}
+
+size_t CSTL_char_find_not_of_2(const void* first, size_t count, const void* set, size_t set_size) {
+    return CSTL_char_class_find(first, count, set, set_size, false, 2);
+}
+
+size_t CSTL_char_find_not_of_4(const void* first, size_t count, const void* set, size_t set_size) {
+    return CSTL_char_class_find(first, count, set, set_size, false, 4);
+}
+
+size_t CSTL_char_rfind_of_1(const void* first, size_t count, const void* set, size_t set_size) {
+    return CSTL_char_class_rfind(first, count, set, set_size, true, 1);
+}
+
+size_t CSTL_char_rfind_of_2(const void* first, size_t count, const void* set, size_t set_size) {
+    return CSTL_char_class_rfind(first, count, set, set_size, true, 2);
+}
+
+size_t CSTL_char_rfind_of_4(const void* first, size_t count, const void* set, size_t set_size) {
+    return CSTL_char_class_rfind(first, count, set, set_size, true, 4);
+}
+
+size_t CSTL_char_rfind_not_of_1(const void* first, size_t count, const void* set, size_t set_size) {
+    return CSTL_char_class_rfind(first, count, set, set_size, false, 1);
+}
+
+size_t CSTL_char_rfind_not_of_2(const void* first, size_t count, const void* set, size_t set_size) {
+    return CSTL_char_class_rfind(first, count, set, set_size, false, 2);
+}
+
+size_t CSTL_char_rfind_not_of_4(const void* first, size_t count, const void* set, size_t set_size) {
+    return CSTL_char_class_rfind(first, count, set, set_size, false, 4);
+}
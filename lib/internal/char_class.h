@@ -0,0 +1,58 @@
+#pragma once
+
+#ifndef CSTL_CHAR_CLASS_H
+#define CSTL_CHAR_CLASS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Character set searches shared by all string types, the backbone
+ * of `find_first_of` and its siblings.
+ * 
+ * Small sets are matched with one vector comparison per set member.
+ * Other sets are matched with a 256-bit bitmap of their characters below 256,
+ * which is looked up 32 characters at a time for single byte characters on
+ * targets with AVX2. Characters above 255 fall back to a linear scan of the set.
+ * 
+ * Pointers must be aligned to the width of the character type.
+ * 
+ */
+
+/**
+ * Returns the index of the first element in `[first, first + count)` that is
+ * also in `[set, set + set_size)`, or `count` if there is no such element.
+ * 
+ */
+size_t CSTL_char_find_of_1(const void* first, size_t count, const void* set, size_t set_size);
+size_t CSTL_char_find_of_2(const void* first, size_t count, const void* set, size_t set_size);
+size_t CSTL_char_find_of_4(const void* first, size_t count, const void* set, size_t set_size);
+
+/**
+ * Returns the index of the first element in `[first, first + count)` that is
+ * not in `[set, set + set_size)`, or `count` if there is no such element.
+ * 
+ */
+size_t CSTL_char_find_not_of_1(const void* first, size_t count, const void* set, size_t set_size);
+size_t CSTL_char_find_not_of_2(const void* first, size_t count, const void* set, size_t set_size);
+size_t CSTL_char_find_not_of_4(const void* first, size_t count, const void* set, size_t set_size);
+
+/**
+ * Returns the index of the last element in `[first, first + count)` that is
+ * also in `[set, set + set_size)`, or `count` if there is no such element.
+ * 
+ */
+size_t CSTL_char_rfind_of_1(const void* first, size_t count, const void* set, size_t set_size);
+size_t CSTL_char_rfind_of_2(const void* first, size_t count, const void* set, size_t set_size);
+size_t CSTL_char_rfind_of_4(const void* first, size_t count, const void* set, size_t set_size);
+
+/**
+ * Returns the index of the last element in `[first, first + count)` that is
+ * not in `[set, set + set_size)`, or `count` if there is no such element.
+ * 
+ */
+size_t CSTL_char_rfind_not_of_1(const void* first, size_t count, const void* set, size_t set_size);
+size_t CSTL_char_rfind_not_of_2(const void* first, size_t count, const void* set, size_t set_size);
+size_t CSTL_char_rfind_not_of_4(const void* first, size_t count, const void* set, size_t set_size);
+
+#endif
@@ -0,0 +1,748 @@
+#include "char_dispatch.h"
+
+#include "char_simd.h"
+
+// Scalar fallbacks, also used for ranges shorter than one vector.
+// All offsets are in bytes, results are byte offsets of the matching element.
+
+static inline size_t CSTL_scalar_find(const unsigned char* first, size_t bytes, uint32_t ch, size_t width) {
+    for (size_t off = 0; off != bytes; off += width) {
+        if (CSTL_char_load(first + off, width) == ch) {
+            return off;
+        }
+    }
+    return bytes;
+}
+
+static inline size_t CSTL_scalar_rfind(const unsigned char* first, size_t bytes, uint32_t ch, size_t width) {
+    for (size_t off = bytes; off != 0;) {
+        off -= width;
+        if (CSTL_char_load(first + off, width) == ch) {
+            return off;
+        }
+    }
+    return bytes;
+}
+
+static inline size_t CSTL_scalar_mismatch(const unsigned char* first1, const unsigned char* first2, size_t bytes, size_t width) {
+    for (size_t off = 0; off != bytes; off += width) {
+        if (CSTL_char_load(first1 + off, width) != CSTL_char_load(first2 + off, width)) {
+            return off;
+        }
+    }
+    return bytes;
+}
+
+static inline size_t CSTL_scalar_len(const unsigned char* ptr, size_t width) {
+    size_t off = 0;
+    while (CSTL_char_load(ptr + off, width) != 0) {
+        off += width;
+    }
+    return off;
+}
+
+static inline void CSTL_scalar_fill(unsigned char* dst, size_t bytes, uint32_t ch, size_t width) {
+    for (size_t off = 0; off != bytes; off += width) {
+        CSTL_char_store(dst + off, ch, width);
+    }
+}
+
+#ifdef CSTL_char_sse2
+static inline uint32_t CSTL_sse2_eq_mask(const unsigned char* ptr, __m128i needle, size_t width) {
+    __m128i chunk = _mm_loadu_si128((const __m128i*)ptr);
+    return (uint32_t)_mm_movemask_epi8(CSTL_sse2_cmpeq(chunk, needle, width));
+}
+
+// `bytes >= 16`
+static inline size_t CSTL_sse2_find(const unsigned char* first, size_t bytes, uint32_t ch, size_t width) {
+    __m128i needle = CSTL_sse2_set1(ch, width);
+    size_t off     = 0;
+
+    for (; bytes - off >= 16; off += 16) {
+        uint32_t mask = CSTL_sse2_eq_mask(first + off, needle, width);
+        if (mask != 0) {
+            return off + CSTL_ctz32(mask);
+        }
+    }
+
+    if (off != bytes) { // overlapping tail, the overlap is known not to match
+        off = bytes - 16;
+        uint32_t mask = CSTL_sse2_eq_mask(first + off, needle, width);
+        if (mask != 0) {
+            return off + CSTL_ctz32(mask);
+        }
+    }
+
+    return bytes;
+}
+
+// `bytes >= 16`
+static inline size_t CSTL_sse2_rfind(const unsigned char* first, size_t bytes, uint32_t ch, size_t width) {
+    __m128i needle = CSTL_sse2_set1(ch, width);
+    size_t off     = bytes;
+
+    while (off >= 16) {
+        off -= 16;
+        uint32_t mask = CSTL_sse2_eq_mask(first + off, needle, width);
+        if (mask != 0) {
+            return off + CSTL_bsr32(mask);
+        }
+    }
+
+    if (off != 0) { // overlapping head, the overlap is known not to match
+        uint32_t mask = CSTL_sse2_eq_mask(first, needle, width);
+        if (mask != 0) {
+            return CSTL_bsr32(mask);
+        }
+    }
+
+    return bytes;
+}
+
+static inline uint32_t CSTL_sse2_ne_mask(const unsigned char* first1, const unsigned char* first2, size_t width) {
+    __m128i lhs = _mm_loadu_si128((const __m128i*)first1);
+    __m128i rhs = _mm_loadu_si128((const __m128i*)first2);
+    return (uint32_t)_mm_movemask_epi8(CSTL_sse2_cmpeq(lhs, rhs, width)) ^ 0xFFFFu;
+}
+
+// `bytes >= 16`
+static inline size_t CSTL_sse2_mismatch(const unsigned char* first1, const unsigned char* first2, size_t bytes, size_t width) {
+    size_t off = 0;
+
+    for (; bytes - off >= 16; off += 16) {
+        uint32_t mask = CSTL_sse2_ne_mask(first1 + off, first2 + off, width);
+        if (mask != 0) {
+            return off + CSTL_ctz32(mask);
+        }
+    }
+
+    if (off != bytes) {
+        off = bytes - 16;
+        uint32_t mask = CSTL_sse2_ne_mask(first1 + off, first2 + off, width);
+        if (mask != 0) {
+            return off + CSTL_ctz32(mask);
+        }
+    }
+
+    return bytes;
+}
+
+CSTL_no_sanitize_address static inline size_t CSTL_sse2_len(const unsigned char* ptr, size_t width) {
+    __m128i zero = _mm_setzero_si128();
+
+    // Aligned loads never cross into an unmapped page.
+    size_t skew = (uintptr_t)ptr & 15;
+    const unsigned char* chunk = ptr - skew;
+
+    uint32_t mask = (uint32_t)_mm_movemask_epi8(
+        CSTL_sse2_cmpeq(_mm_load_si128((const __m128i*)chunk), zero, width)) >> skew;
+
+    if (mask != 0) {
+        return CSTL_ctz32(mask);
+    }
+
+    for (;;) {
+        chunk += 16;
+        mask = (uint32_t)_mm_movemask_epi8(
+            CSTL_sse2_cmpeq(_mm_load_si128((const __m128i*)chunk), zero, width));
+
+        if (mask != 0) {
+            return (size_t)(chunk - ptr) + CSTL_ctz32(mask);
+        }
+    }
+}
+
+// `bytes >= 16`
+static inline void CSTL_sse2_fill(unsigned char* dst, size_t bytes, uint32_t ch, size_t width) {
+    __m128i value = CSTL_sse2_set1(ch, width);
+    size_t off    = 0;
+
+    for (; bytes - off >= 16; off += 16) {
+        _mm_storeu_si128((__m128i*)(dst + off), value);
+    }
+
+    if (off != bytes) {
+        _mm_storeu_si128((__m128i*)(dst + bytes - 16), value);
+    }
+}
+#endif
+
+#ifdef CSTL_char_avx2
+CSTL_target_avx2 static inline uint32_t CSTL_avx2_eq_mask(const unsigned char* ptr, __m256i needle, size_t width) {
+    __m256i chunk = _mm256_loadu_si256((const __m256i*)ptr);
+    return (uint32_t)_mm256_movemask_epi8(CSTL_avx2_cmpeq(chunk, needle, width));
+}
+
+// `bytes >= 32`
+CSTL_target_avx2 static inline size_t CSTL_avx2_find(const unsigned char* first, size_t bytes, uint32_t ch, size_t width) {
+    __m256i needle = CSTL_avx2_set1(ch, width);
+    size_t off     = 0;
+
+    if (bytes >= 160) {
+        uint32_t mask = CSTL_avx2_eq_mask(first, needle, width);
+        if (mask != 0) {
+            return CSTL_ctz32(mask);
+        }
+
+        // Continue from the next aligned address, re-checking a part of the first vector.
+        off = 32 - ((uintptr_t)first & 31);
+    }
+
+    for (; bytes - off >= 128; off += 128) {
+        __m256i eq0 = CSTL_avx2_cmpeq(_mm256_loadu_si256((const __m256i*)(first + off)), needle, width);
+        __m256i eq1 = CSTL_avx2_cmpeq(_mm256_loadu_si256((const __m256i*)(first + off + 32)), needle, width);
+        __m256i eq2 = CSTL_avx2_cmpeq(_mm256_loadu_si256((const __m256i*)(first + off + 64)), needle, width);
+        __m256i eq3 = CSTL_avx2_cmpeq(_mm256_loadu_si256((const __m256i*)(first + off + 96)), needle, width);
+
+        __m256i any = _mm256_or_si256(_mm256_or_si256(eq0, eq1), _mm256_or_si256(eq2, eq3));
+
+        if (_mm256_movemask_epi8(any) != 0) {
+            uint32_t mask = (uint32_t)_mm256_movemask_epi8(eq0);
+            if (mask != 0) {
+                return off + CSTL_ctz32(mask);
+            }
+
+            mask = (uint32_t)_mm256_movemask_epi8(eq1);
+            if (mask != 0) {
+                return off + 32 + CSTL_ctz32(mask);
+            }
+
+            mask = (uint32_t)_mm256_movemask_epi8(eq2);
+            if (mask != 0) {
+                return off + 64 + CSTL_ctz32(mask);
+            }
+
+            mask = (uint32_t)_mm256_movemask_epi8(eq3);
+            return off + 96 + CSTL_ctz32(mask);
+        }
+    }
+
+    for (; bytes - off >= 32; off += 32) {
+        uint32_t mask = CSTL_avx2_eq_mask(first + off, needle, width);
+        if (mask != 0) {
+            return off + CSTL_ctz32(mask);
+        }
+    }
+
+    if (off != bytes) {
+        off = bytes - 32;
+        uint32_t mask = CSTL_avx2_eq_mask(first + off, needle, width);
+        if (mask != 0) {
+            return off + CSTL_ctz32(mask);
+        }
+    }
+
+    return bytes;
+}
+
+// `bytes >= 32`
+CSTL_target_avx2 static inline size_t CSTL_avx2_rfind(const unsigned char* first, size_t bytes, uint32_t ch, size_t width) {
+    __m256i needle = CSTL_avx2_set1(ch, width);
+    size_t off     = bytes;
+
+    while (off >= 32) {
+        off -= 32;
+        uint32_t mask = CSTL_avx2_eq_mask(first + off, needle, width);
+        if (mask != 0) {
+            return off + CSTL_bsr32(mask);
+        }
+    }
+
+    if (off != 0) {
+        uint32_t mask = CSTL_avx2_eq_mask(first, needle, width);
+        if (mask != 0) {
+            return CSTL_bsr32(mask);
+        }
+    }
+
+    return bytes;
+}
+
+CSTL_target_avx2 static inline uint32_t CSTL_avx2_ne_mask(const unsigned char* first1, const unsigned char* first2, size_t width) {
+    __m256i lhs = _mm256_loadu_si256((const __m256i*)first1);
+    __m256i rhs = _mm256_loadu_si256((const __m256i*)first2);
+    return ~(uint32_t)_mm256_movemask_epi8(CSTL_avx2_cmpeq(lhs, rhs, width));
+}
+
+// `bytes >= 32`
+CSTL_target_avx2 static inline size_t CSTL_avx2_mismatch(const unsigned char* first1, const unsigned char* first2, size_t bytes, size_t width) {
+    size_t off = 0;
+
+    for (; bytes - off >= 32; off += 32) {
+        uint32_t mask = CSTL_avx2_ne_mask(first1 + off, first2 + off, width);
+        if (mask != 0) {
+            return off + CSTL_ctz32(mask);
+        }
+    }
+
+    if (off != bytes) {
+        off = bytes - 32;
+        uint32_t mask = CSTL_avx2_ne_mask(first1 + off, first2 + off, width);
+        if (mask != 0) {
+            return off + CSTL_ctz32(mask);
+        }
+    }
+
+    return bytes;
+}
+
+CSTL_target_avx2 static inline __m256i CSTL_avx2_min(__m256i lhs, __m256i rhs, size_t width) {
+    switch (width) {
+    case 1:  return _mm256_min_epu8(lhs, rhs);
+    case 2:  return _mm256_min_epu16(lhs, rhs);
+    default: return _mm256_min_epu32(lhs, rhs);
+    }
+}
+
+CSTL_no_sanitize_address CSTL_target_avx2 static inline uint32_t CSTL_avx2_zero_mask(const unsigned char* chunk, size_t width) {
+    __m256i data = _mm256_load_si256((const __m256i*)chunk);
+    return (uint32_t)_mm256_movemask_epi8(CSTL_avx2_cmpeq(data, _mm256_setzero_si256(), width));
+}
+
+CSTL_no_sanitize_address CSTL_target_avx2 static inline size_t CSTL_avx2_len(const unsigned char* ptr, size_t width) {
+    size_t skew = (uintptr_t)ptr & 31;
+    const unsigned char* chunk = ptr - skew;
+
+    uint32_t mask = CSTL_avx2_zero_mask(chunk, width) >> skew;
+
+    if (mask != 0) {
+        return CSTL_ctz32(mask);
+    }
+
+    // Single vectors up to a 128 byte boundary:
+    for (chunk += 32; ((uintptr_t)chunk & 127) != 0; chunk += 32) {
+        mask = CSTL_avx2_zero_mask(chunk, width);
+
+        if (mask != 0) {
+            return (size_t)(chunk - ptr) + CSTL_ctz32(mask);
+        }
+    }
+
+    // The unsigned minimum of four vectors has a zero element
+    // wherever any of them does.
+    for (;; chunk += 128) {
+        __m256i data0 = _mm256_load_si256((const __m256i*)chunk);
+        __m256i data1 = _mm256_load_si256((const __m256i*)(chunk + 32));
+        __m256i data2 = _mm256_load_si256((const __m256i*)(chunk + 64));
+        __m256i data3 = _mm256_load_si256((const __m256i*)(chunk + 96));
+
+        __m256i least = CSTL_avx2_min(CSTL_avx2_min(data0, data1, width),
+            CSTL_avx2_min(data2, data3, width), width);
+
+        if (_mm256_movemask_epi8(CSTL_avx2_cmpeq(least, _mm256_setzero_si256(), width)) != 0) {
+            break;
+        }
+    }
+
+    for (;; chunk += 32) {
+        mask = CSTL_avx2_zero_mask(chunk, width);
+
+        if (mask != 0) {
+            return (size_t)(chunk - ptr) + CSTL_ctz32(mask);
+        }
+    }
+}
+
+// `bytes >= 32`
+CSTL_target_avx2 static inline void CSTL_avx2_fill(unsigned char* dst, size_t bytes, uint32_t ch, size_t width) {
+    __m256i value = CSTL_avx2_set1(ch, width);
+    size_t off    = 0;
+
+    for (; bytes - off >= 32; off += 32) {
+        _mm256_storeu_si256((__m256i*)(dst + off), value);
+    }
+
+    if (off != bytes) {
+        _mm256_storeu_si256((__m256i*)(dst + bytes - 32), value);
+    }
+}
+
+// Out of line entry points, so the AVX2 bodies are never inlined into
+// functions compiled for the baseline target.
+
+CSTL_target_avx2 static size_t CSTL_avx2_find_1(const unsigned char* first, size_t bytes, uint32_t ch) {
+    return CSTL_avx2_find(first, bytes, ch, 1);
+}
+
+CSTL_target_avx2 static size_t CSTL_avx2_find_2(const unsigned char* first, size_t bytes, uint32_t ch) {
+    return CSTL_avx2_find(first, bytes, ch, 2);
+}
+
+CSTL_target_avx2 static size_t CSTL_avx2_find_4(const unsigned char* first, size_t bytes, uint32_t ch) {
+    return CSTL_avx2_find(first, bytes, ch, 4);
+}
+
+CSTL_target_avx2 static size_t CSTL_avx2_rfind_1(const unsigned char* first, size_t bytes, uint32_t ch) {
+    return CSTL_avx2_rfind(first, bytes, ch, 1);
+}
+
+CSTL_target_avx2 static size_t CSTL_avx2_rfind_2(const unsigned char* first, size_t bytes, uint32_t ch) {
+    return CSTL_avx2_rfind(first, bytes, ch, 2);
+}
+
+CSTL_target_avx2 static size_t CSTL_avx2_rfind_4(const unsigned char* first, size_t bytes, uint32_t ch) {
+    return CSTL_avx2_rfind(first, bytes, ch, 4);
+}
+
+CSTL_target_avx2 static size_t CSTL_avx2_mismatch_1(const unsigned char* first1, const unsigned char* first2, size_t bytes) {
+    return CSTL_avx2_mismatch(first1, first2, bytes, 1);
+}
+
+CSTL_target_avx2 static size_t CSTL_avx2_mismatch_2(const unsigned char* first1, const unsigned char* first2, size_t bytes) {
+    return CSTL_avx2_mismatch(first1, first2, bytes, 2);
+}
+
+CSTL_target_avx2 static size_t CSTL_avx2_mismatch_4(const unsigned char* first1, const unsigned char* first2, size_t bytes) {
+    return CSTL_avx2_mismatch(first1, first2, bytes, 4);
+}
+
+CSTL_no_sanitize_address CSTL_target_avx2 static size_t CSTL_avx2_len_1(const unsigned char* ptr) {
+    return CSTL_avx2_len(ptr, 1);
+}
+
+CSTL_no_sanitize_address CSTL_target_avx2 static size_t CSTL_avx2_len_2(const unsigned char* ptr) {
+    return CSTL_avx2_len(ptr, 2);
+}
+
+CSTL_no_sanitize_address CSTL_target_avx2 static size_t CSTL_avx2_len_4(const unsigned char* ptr) {
+    return CSTL_avx2_len(ptr, 4);
+}
+
+CSTL_target_avx2 static void CSTL_avx2_fill_2(unsigned char* dst, size_t bytes, uint32_t ch) {
+    CSTL_avx2_fill(dst, bytes, ch, 2);
+}
+
+CSTL_target_avx2 static void CSTL_avx2_fill_4(unsigned char* dst, size_t bytes, uint32_t ch) {
+    CSTL_avx2_fill(dst, bytes, ch, 4);
+}
+
+static inline size_t CSTL_avx2_find_n(const unsigned char* first, size_t bytes, uint32_t ch, size_t width) {
+    switch (width) {
+    case 1:  return CSTL_avx2_find_1(first, bytes, ch);
+    case 2:  return CSTL_avx2_find_2(first, bytes, ch);
+    default: return CSTL_avx2_find_4(first, bytes, ch);
+    }
+}
+
+static inline size_t CSTL_avx2_rfind_n(const unsigned char* first, size_t bytes, uint32_t ch, size_t width) {
+    switch (width) {
+    case 1:  return CSTL_avx2_rfind_1(first, bytes, ch);
+    case 2:  return CSTL_avx2_rfind_2(first, bytes, ch);
+    default: return CSTL_avx2_rfind_4(first, bytes, ch);
+    }
+}
+
+static inline size_t CSTL_avx2_mismatch_n(const unsigned char* first1, const unsigned char* first2, size_t bytes, size_t width) {
+    switch (width) {
+    case 1:  return CSTL_avx2_mismatch_1(first1, first2, bytes);
+    case 2:  return CSTL_avx2_mismatch_2(first1, first2, bytes);
+    default: return CSTL_avx2_mismatch_4(first1, first2, bytes);
+    }
+}
+
+static inline size_t CSTL_avx2_len_n(const unsigned char* ptr, size_t width) {
+    switch (width) {
+    case 1:  return CSTL_avx2_len_1(ptr);
+    case 2:  return CSTL_avx2_len_2(ptr);
+    default: return CSTL_avx2_len_4(ptr);
+    }
+}
+
+static inline void CSTL_avx2_fill_n(unsigned char* dst, size_t bytes, uint32_t ch, size_t width) {
+    if (width == 2) {
+        CSTL_avx2_fill_2(dst, bytes, ch);
+    } else {
+        CSTL_avx2_fill_4(dst, bytes, ch);
+    }
+}
+#endif
+
+#ifdef CSTL_char_neon
+static inline uint64_t CSTL_neon_eq_mask(const unsigned char* ptr, uint8x16_t needle, size_t width) {
+    return CSTL_neon_mask(CSTL_neon_cmpeq(vld1q_u8(ptr), needle, width));
+}
+
+// `bytes >= 16`
+static inline size_t CSTL_neon_find(const unsigned char* first, size_t bytes, uint32_t ch, size_t width) {
+    uint8x16_t needle = CSTL_neon_set1(ch, width);
+    size_t off        = 0;
+
+    for (; bytes - off >= 16; off += 16) {
+        uint64_t mask = CSTL_neon_eq_mask(first + off, needle, width);
+        if (mask != 0) {
+            return off + CSTL_ctz64(mask) / 4;
+        }
+    }
+
+    if (off != bytes) {
+        off = bytes - 16;
+        uint64_t mask = CSTL_neon_eq_mask(first + off, needle, width);
+        if (mask != 0) {
+            return off + CSTL_ctz64(mask) / 4;
+        }
+    }
+
+    return bytes;
+}
+
+// `bytes >= 16`
+static inline size_t CSTL_neon_rfind(const unsigned char* first, size_t bytes, uint32_t ch, size_t width) {
+    uint8x16_t needle = CSTL_neon_set1(ch, width);
+    size_t off        = bytes;
+
+    while (off >= 16) {
+        off -= 16;
+        uint64_t mask = CSTL_neon_eq_mask(first + off, needle, width);
+        if (mask != 0) {
+            return off + CSTL_bsr64(mask) / 4;
+        }
+    }
+
+    if (off != 0) {
+        uint64_t mask = CSTL_neon_eq_mask(first, needle, width);
+        if (mask != 0) {
+            return CSTL_bsr64(mask) / 4;
+        }
+    }
+
+    return bytes;
+}
+
+static inline uint64_t CSTL_neon_ne_mask(const unsigned char* first1, const unsigned char* first2, size_t width) {
+    return ~CSTL_neon_mask(CSTL_neon_cmpeq(vld1q_u8(first1), vld1q_u8(first2), width));
+}
+
+// `bytes >= 16`
+static inline size_t CSTL_neon_mismatch(const unsigned char* first1, const unsigned char* first2, size_t bytes, size_t width) {
+    size_t off = 0;
+
+    for (; bytes - off >= 16; off += 16) {
+        uint64_t mask = CSTL_neon_ne_mask(first1 + off, first2 + off, width);
+        if (mask != 0) {
+            return off + CSTL_ctz64(mask) / 4;
+        }
+    }
+
+    if (off != bytes) {
+        off = bytes - 16;
+        uint64_t mask = CSTL_neon_ne_mask(first1 + off, first2 + off, width);
+        if (mask != 0) {
+            return off + CSTL_ctz64(mask) / 4;
+        }
+    }
+
+    return bytes;
+}
+
+CSTL_no_sanitize_address static inline size_t CSTL_neon_len(const unsigned char* ptr, size_t width) {
+    uint8x16_t zero = vdupq_n_u8(0);
+
+    size_t skew = (uintptr_t)ptr & 15;
+    const unsigned char* chunk = ptr - skew;
+
+    uint64_t mask = CSTL_neon_eq_mask(chunk, zero, width) >> (skew * 4);
+
+    if (mask != 0) {
+        return CSTL_ctz64(mask) / 4;
+    }
+
+    for (;;) {
+        chunk += 16;
+        mask = CSTL_neon_eq_mask(chunk, zero, width);
+
+        if (mask != 0) {
+            return (size_t)(chunk - ptr) + CSTL_ctz64(mask) / 4;
+        }
+    }
+}
+
+// `bytes >= 16`
+static inline void CSTL_neon_fill(unsigned char* dst, size_t bytes, uint32_t ch, size_t width) {
+    uint8x16_t value = CSTL_neon_set1(ch, width);
+    size_t off       = 0;
+
+    for (; bytes - off >= 16; off += 16) {
+        vst1q_u8(dst + off, value);
+    }
+
+    if (off != bytes) {
+        vst1q_u8(dst + bytes - 16, value);
+    }
+}
+#endif
+
+// Width generic dispatchers, `width` is always a constant.
+
+static inline size_t CSTL_char_find(const void* first, size_t count, uint32_t ch, size_t width) {
+    const unsigned char* bytes_first = (const unsigned char*)first;
+    size_t bytes = count * width;
+
+#if defined(CSTL_char_sse2)
+#if defined(CSTL_char_avx2)
+    if (bytes >= 32 && CSTL_has_avx2()) {
+        return CSTL_avx2_find_n(bytes_first, bytes, ch, width) / width;
+    }
+#endif
+    if (bytes >= 16) {
+        return CSTL_sse2_find(bytes_first, bytes, ch, width) / width;
+    }
+#elif defined(CSTL_char_neon)
+    if (bytes >= 16) {
+        return CSTL_neon_find(bytes_first, bytes, ch, width) / width;
+    }
+#endif
+
+    return CSTL_scalar_find(bytes_first, bytes, ch, width) / width;
+}
+
+static inline size_t CSTL_char_rfind(const void* first, size_t count, uint32_t ch, size_t width) {
+    const unsigned char* bytes_first = (const unsigned char*)first;
+    size_t bytes = count * width;
+
+#if defined(CSTL_char_sse2)
+#if defined(CSTL_char_avx2)
+    if (bytes >= 32 && CSTL_has_avx2()) {
+        return CSTL_avx2_rfind_n(bytes_first, bytes, ch, width) / width;
+    }
+#endif
+    if (bytes >= 16) {
+        return CSTL_sse2_rfind(bytes_first, bytes, ch, width) / width;
+    }
+#elif defined(CSTL_char_neon)
+    if (bytes >= 16) {
+        return CSTL_neon_rfind(bytes_first, bytes, ch, width) / width;
+    }
+#endif
+
+    return CSTL_scalar_rfind(bytes_first, bytes, ch, width) / width;
+}
+
+static inline size_t CSTL_char_mismatch(const void* first1, const void* first2, size_t count, size_t width) {
+    const unsigned char* bytes_first1 = (const unsigned char*)first1;
+    const unsigned char* bytes_first2 = (const unsigned char*)first2;
+    size_t bytes = count * width;
+
+#if defined(CSTL_char_sse2)
+#if defined(CSTL_char_avx2)
+    if (bytes >= 32 && CSTL_has_avx2()) {
+        return CSTL_avx2_mismatch_n(bytes_first1, bytes_first2, bytes, width) / width;
+    }
+#endif
+    if (bytes >= 16) {
+        return CSTL_sse2_mismatch(bytes_first1, bytes_first2, bytes, width) / width;
+    }
+#elif defined(CSTL_char_neon)
+    if (bytes >= 16) {
+        return CSTL_neon_mismatch(bytes_first1, bytes_first2, bytes, width) / width;
+    }
+#endif
+
+    return CSTL_scalar_mismatch(bytes_first1, bytes_first2, bytes, width) / width;
+}
+
+static inline size_t CSTL_char_len(const void* ptr, size_t width) {
+    const unsigned char* bytes_ptr = (const unsigned char*)ptr;
+
+#if defined(CSTL_char_sse2)
+#if defined(CSTL_char_avx2)
+    if (CSTL_has_avx2()) {
+        return CSTL_avx2_len_n(bytes_ptr, width) / width;
+    }
+#endif
+    return CSTL_sse2_len(bytes_ptr, width) / width;
+#elif defined(CSTL_char_neon)
+    return CSTL_neon_len(bytes_ptr, width) / width;
+#else
+    return CSTL_scalar_len(bytes_ptr, width) / width;
+#endif
+}
+
+static inline void CSTL_char_fill(void* dst, size_t count, uint32_t ch, size_t width) {
+    unsigned char* bytes_dst = (unsigned char*)dst;
+    size_t bytes = count * width;
+
+    if (width == 1) {
+        memset(dst, (int)ch, count);
+        return;
+    }
+
+#if defined(CSTL_char_sse2)
+#if defined(CSTL_char_avx2)
+    if (bytes >= 32 && CSTL_has_avx2()) {
+        CSTL_avx2_fill_n(bytes_dst, bytes, ch, width);
+        return;
+    }
+#endif
+    if (bytes >= 16) {
+        CSTL_sse2_fill(bytes_dst, bytes, ch, width);
+        return;
+    }
+#elif defined(CSTL_char_neon)
+    if (bytes >= 16) {
+        CSTL_neon_fill(bytes_dst, bytes, ch, width);
+        return;
+    }
+#endif
+
+    CSTL_scalar_fill(bytes_dst, bytes, ch, width);
+}
+
+size_t CSTL_char_find_1(const void* first, size_t count, uint8_t ch) {
+    return CSTL_char_find(first, count, ch, 1);
+}
+
+size_t CSTL_char_find_2(const void* first, size_t count, uint16_t ch) {
+    return CSTL_char_find(first, count, ch, 2);
+}
+
+size_t CSTL_char_find_4(const void* first, size_t count, uint32_t ch) {
+    return CSTL_char_find(first, count, ch, 4);
+}
+
+size_t CSTL_char_rfind_1(const void* first, size_t count, uint8_t ch) {
+    return CSTL_char_rfind(first, count, ch, 1);
+}
+
+size_t CSTL_char_rfind_2(const void* first, size_t count, uint16_t ch) {
+    return CSTL_char_rfind(first, count, ch, 2);
+}
+
+size_t CSTL_char_rfind_4(const void* first, size_t count, uint32_t ch) {
+    return CSTL_char_rfind(first, count, ch, 4);
+}
+
+size_t CSTL_char_mismatch_1(const void* first1, const void* first2, size_t count) {
+    return CSTL_char_mismatch(first1, first2, count, 1);
+}
+
+size_t CSTL_char_mismatch_2(const void* first1, const void* first2, size_t count) {
+    return CSTL_char_mismatch(first1, first2, count, 2);
+}
+
+size_t CSTL_char_mismatch_4(const void* first1, const void* first2, size_t count) {
+    return CSTL_char_mismatch(first1, first2, count, 4);
+}
+
+size_t CSTL_char_len_1(const void* ptr) {
+    return CSTL_char_len(ptr, 1);
+}
+
+size_t CSTL_char_len_2(const void* ptr) {
+    return CSTL_char_len(ptr, 2);
+}
+
+size_t CSTL_char_len_4(const void* ptr) {
+    return CSTL_char_len(ptr, 4);
+}
+
+void CSTL_char_fill_1(void* dst, size_t count, uint8_t ch) {
+    CSTL_char_fill(dst, count, ch, 1);
+}
+
+void CSTL_char_fill_2(void* dst, size_t count, uint16_t ch) {
+    CSTL_char_fill(dst, count, ch, 2);
+}
+
+void CSTL_char_fill_4(void* dst, size_t count, uint32_t ch) {
+    CSTL_char_fill(dst, count, ch, 4);
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#ifndef CSTL_CHAR_DISPATCH_H
+#define CSTL_CHAR_DISPATCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Character range primitives shared by all string types.
+ * 
+ * Every primitive exists for 1, 2 and 4 byte wide characters and operates
+ * on `count` elements of that width. Vectorised kernels are selected at
+ * compile time (SSE2, NEON) and at run time (AVX2); all other targets use
+ * the scalar fallback.
+ * 
+ * Pointers must be aligned to the width of the character type.
+ * 
+ */
+
+/**
+ * Returns the index of the first element equal to `ch` in `[first, first + count)`,
+ * or `count` if there is no such element.
+ * 
+ */
+size_t CSTL_char_find_1(const void* first, size_t count, uint8_t ch);
+size_t CSTL_char_find_2(const void* first, size_t count, uint16_t ch);
+size_t CSTL_char_find_4(const void* first, size_t count, uint32_t ch);
+
+/**
+ * Returns the index of the last element equal to `ch` in `[first, first + count)`,
+ * or `count` if there is no such element.
+ * 
+ */
+size_t CSTL_char_rfind_1(const void* first, size_t count, uint8_t ch);
+size_t CSTL_char_rfind_2(const void* first, size_t count, uint16_t ch);
+size_t CSTL_char_rfind_4(const void* first, size_t count, uint32_t ch);
+
+/**
+ * Returns the index of the first element that differs between `[first1, first1 + count)`
+ * and `[first2, first2 + count)`, or `count` if the ranges are equal.
+ * 
+ */
+size_t CSTL_char_mismatch_1(const void* first1, const void* first2, size_t count);
+size_t CSTL_char_mismatch_2(const void* first1, const void* first2, size_t count);
+size_t CSTL_char_mismatch_4(const void* first1, const void* first2, size_t count);
+
+/**
+ * Returns the number of elements before the first zero element at `ptr`.
+ * 
+ * May read past the terminator, but never across an aligned 128 byte boundary (and so never across a page).
+ * 
+ */
+size_t CSTL_char_len_1(const void* ptr);
+size_t CSTL_char_len_2(const void* ptr);
+size_t CSTL_char_len_4(const void* ptr);
+
+/**
+ * Writes `count` copies of `ch` to `dst`.
+ * 
+ */
+void CSTL_char_fill_1(void* dst, size_t count, uint8_t ch);
+void CSTL_char_fill_2(void* dst, size_t count, uint16_t ch);
+void CSTL_char_fill_4(void* dst, size_t count, uint32_t ch);
+
+#endif
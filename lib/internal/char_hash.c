@@ -0,0 +1,319 @@
+#include "char_hash.h"
+
+#include "char_simd.h"
+
+// FNV-1a parameters of MSVC's `_Fnv1a_append_bytes`, which depend on the width of `size_t`.
+#if SIZE_MAX > UINT32_MAX
+#define CSTL_fnv_offset_basis (size_t)14695981039346656037ULL
+#define CSTL_fnv_prime        (size_t)1099511628211ULL
+#else
+#define CSTL_fnv_offset_basis (size_t)2166136261U
+#define CSTL_fnv_prime        (size_t)16777619U
+#endif
+
+// Keys of up to this many bytes take the multiply-mix path.
+#define CSTL_hash_short_max 256
+
+// Longer keys are read in stripes of 64 bytes, and the lanes are scrambled every 16 stripes.
+#define CSTL_hash_stripe          64
+#define CSTL_hash_block_stripes   16
+#define CSTL_hash_block           (CSTL_hash_stripe * CSTL_hash_block_stripes)
+#define CSTL_hash_last_key        16 // keys of the last stripe
+#define CSTL_hash_scramble_key    17 // keys of the scramble step
+#define CSTL_hash_scramble_factor 0x9E3779B1U
+
+// Stripe `s` of a block uses keys `[s, s + 8)`.
+static const uint64_t CSTL_hash_key[25] = {
+    0xCFED67A7008B0BA8ULL, 0xEB4156E8C08E13B3ULL, 0xEE6EC8F98D326955ULL, 0x1C7AE9983546F297ULL,
+    0xB2A5EE83372A77F1ULL, 0xD33BFD33B7B9FF54ULL, 0xC5B2C494BF8A5301ULL, 0x55E9C8BCB7273D6AULL,
+    0x75B26D84D6416EA2ULL, 0xF7B771E3267A5EA1ULL, 0x0AB392E98247CDE1ULL, 0x7026CB491E86A997ULL,
+    0x1981A1A6D347EA4EULL, 0x5FF2A2889CD4B846ULL, 0xD0D49FEB0FC7A469ULL, 0x9A42090D2442BDE5ULL,
+    0x1E2C3F67277D0E13ULL, 0x6F71F6A8DF1DF263ULL, 0x7A48A0B8EB8F9A1CULL, 0xA0E19939E2513037ULL,
+    0x6C2B878E7D2587F9ULL, 0x7E6CF360E99372E2ULL, 0x3207EE5260108A70ULL, 0x5963C8B266CA2583ULL,
+    0xFCCC652499A4147EULL,
+};
+
+// `CSTL_hash_mix(CSTL_hash_key[0], CSTL_hash_key[1])`, the initial state of the short path.
+#define CSTL_hash_seed 0x9D4474EA4102DD8DULL
+
+size_t CSTL_char_hash_fnv(const void* first, size_t bytes) {
+    const unsigned char* ptr = (const unsigned char*)first;
+    size_t result = CSTL_fnv_offset_basis;
+
+    for (size_t i = 0; i != bytes; ++i) {
+        result ^= (size_t)ptr[i];
+        result *= CSTL_fnv_prime;
+    }
+
+    return result;
+}
+
+// Unaligned little-endian reads.
+static inline uint64_t CSTL_hash_read64(const unsigned char* ptr) {
+    uint64_t result;
+    memcpy(&result, ptr, sizeof(result));
+    return result;
+}
+
+static inline uint64_t CSTL_hash_read32(const unsigned char* ptr) {
+    uint32_t result;
+    memcpy(&result, ptr, sizeof(result));
+    return result;
+}
+
+// Replaces `lhs` and `rhs` with the low and high halves of their 128-bit product.
+static inline void CSTL_hash_mum(uint64_t* lhs, uint64_t* rhs) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t product = (__uint128_t)*lhs * *rhs;
+    *lhs = (uint64_t)product;
+    *rhs = (uint64_t)(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    *lhs = _umul128(*lhs, *rhs, rhs);
+#else
+    uint64_t lhs_hi = *lhs >> 32, lhs_lo = (uint32_t)*lhs;
+    uint64_t rhs_hi = *rhs >> 32, rhs_lo = (uint32_t)*rhs;
+
+    uint64_t hi_hi = lhs_hi * rhs_hi;
+    uint64_t hi_lo = lhs_hi * rhs_lo;
+    uint64_t lo_hi = lhs_lo * rhs_hi;
+    uint64_t lo_lo = lhs_lo * rhs_lo;
+
+    uint64_t mid   = (lo_lo >> 32) + (uint32_t)hi_lo + (uint32_t)lo_hi;
+    *lhs = (mid << 32) | (uint32_t)lo_lo;
+    *rhs = hi_hi + (hi_lo >> 32) + (lo_hi >> 32) + (mid >> 32);
+#endif
+}
+
+static inline uint64_t CSTL_hash_mix(uint64_t lhs, uint64_t rhs) {
+    CSTL_hash_mum(&lhs, &rhs);
+    return lhs ^ rhs;
+}
+
+// Up to 256 bytes, mixed 16 at a time in the manner of wyhash.
+static inline uint64_t CSTL_hash_short(const unsigned char* ptr, size_t bytes) {
+    const uint64_t* key = CSTL_hash_key;
+    uint64_t seed = CSTL_hash_seed;
+    uint64_t lhs, rhs;
+
+    if (bytes <= 16) {
+        if (bytes >= 4) {
+            size_t mid = (bytes >> 3) << 2; // 0 or 4, so that the reads cover every byte
+            lhs = CSTL_hash_read32(ptr) << 32 | CSTL_hash_read32(ptr + mid);
+            rhs = CSTL_hash_read32(ptr + bytes - 4) << 32 | CSTL_hash_read32(ptr + bytes - 4 - mid);
+        } else if (bytes > 0) {
+            lhs = (uint64_t)ptr[0] << 16 | (uint64_t)ptr[bytes >> 1] << 8 | ptr[bytes - 1];
+            rhs = 0;
+        } else {
+            lhs = rhs = 0;
+        }
+    } else {
+        size_t left = bytes;
+
+        if (left > 48) {
+            uint64_t seed1 = seed, seed2 = seed;
+
+            do {
+                seed  = CSTL_hash_mix(CSTL_hash_read64(ptr) ^ key[1], CSTL_hash_read64(ptr + 8) ^ seed);
+                seed1 = CSTL_hash_mix(CSTL_hash_read64(ptr + 16) ^ key[2], CSTL_hash_read64(ptr + 24) ^ seed1);
+                seed2 = CSTL_hash_mix(CSTL_hash_read64(ptr + 32) ^ key[3], CSTL_hash_read64(ptr + 40) ^ seed2);
+                ptr  += 48;
+                left -= 48;
+            } while (left > 48);
+
+            seed ^= seed1 ^ seed2;
+        }
+
+        while (left > 16) {
+            seed  = CSTL_hash_mix(CSTL_hash_read64(ptr) ^ key[1], CSTL_hash_read64(ptr + 8) ^ seed);
+            ptr  += 16;
+            left -= 16;
+        }
+
+        lhs = CSTL_hash_read64(ptr + left - 16);
+        rhs = CSTL_hash_read64(ptr + left - 8);
+    }
+
+    lhs ^= key[1];
+    rhs ^= seed;
+    CSTL_hash_mum(&lhs, &rhs);
+    return CSTL_hash_mix(lhs ^ key[0] ^ (uint64_t)bytes, rhs ^ key[1]);
+}
+
+// The instruction set specific loops over the stripes of a key longer than 256 bytes.
+// All of them visit the same stripes with the same keys: every full block,
+// then the remaining full stripes and finally the last 64 bytes.
+#define CSTL_hash_long_loop(isa) \
+    size_t blocks  = (bytes - 1) / CSTL_hash_block; \
+    size_t stripes = (bytes - 1) % CSTL_hash_block / CSTL_hash_stripe; \
+    \
+    for (size_t block = 0; block != blocks; ++block) { \
+        for (size_t stripe = 0; stripe != CSTL_hash_block_stripes; ++stripe) { \
+            CSTL_##isa##_hash_stripe(acc, ptr + stripe * CSTL_hash_stripe, CSTL_hash_key + stripe); \
+        } \
+        \
+        CSTL_##isa##_hash_scramble(acc); \
+        ptr += CSTL_hash_block; \
+    } \
+    \
+    for (size_t stripe = 0; stripe != stripes; ++stripe) { \
+        CSTL_##isa##_hash_stripe(acc, ptr + stripe * CSTL_hash_stripe, CSTL_hash_key + stripe); \
+    } \
+    \
+    CSTL_##isa##_hash_stripe(acc, last, CSTL_hash_key + CSTL_hash_last_key)
+
+#if !defined(CSTL_char_sse2)
+// Folds the stripe at `ptr` into the lanes with keys `[key, key + 8)`. The product
+// of the halves of a keyed word is added to its lane and the word itself to the
+// neighbouring lane, so no input is lost when a product is zero.
+static inline void CSTL_scalar_hash_stripe(uint64_t* acc, const unsigned char* ptr, const uint64_t* key) {
+    for (size_t i = 0; i != 8; ++i) {
+        uint64_t word  = CSTL_hash_read64(ptr + i * 8);
+        uint64_t keyed = word ^ key[i];
+
+        acc[i ^ 1] += word;
+        acc[i]     += (keyed & 0xFFFFFFFF) * (keyed >> 32);
+    }
+}
+
+static inline void CSTL_scalar_hash_scramble(uint64_t* acc) {
+    const uint64_t* key = CSTL_hash_key + CSTL_hash_scramble_key;
+
+    for (size_t i = 0; i != 8; ++i) {
+        acc[i] ^= acc[i] >> 47;
+        acc[i] ^= key[i];
+        acc[i] *= CSTL_hash_scramble_factor;
+    }
+}
+
+static void CSTL_scalar_hash_long(uint64_t* acc, const unsigned char* ptr, size_t bytes) {
+    const unsigned char* last = ptr + bytes - CSTL_hash_stripe;
+
+    CSTL_hash_long_loop(scalar);
+}
+#endif
+
+#ifdef CSTL_char_sse2
+static inline void CSTL_sse2_hash_stripe(__m128i* acc, const unsigned char* ptr, const uint64_t* key) {
+    for (size_t i = 0; i != 4; ++i) {
+        __m128i word  = _mm_loadu_si128((const __m128i*)(ptr + i * 16));
+        __m128i keyed = _mm_xor_si128(word, _mm_loadu_si128((const __m128i*)(key + i * 2)));
+
+        __m128i product = _mm_mul_epu32(keyed, _mm_srli_epi64(keyed, 32));
+        __m128i swapped = _mm_shuffle_epi32(word, _MM_SHUFFLE(1, 0, 3, 2));
+
+        acc[i] = _mm_add_epi64(acc[i], _mm_add_epi64(product, swapped));
+    }
+}
+
+static inline void CSTL_sse2_hash_scramble(__m128i* acc) {
+    const uint64_t* key = CSTL_hash_key + CSTL_hash_scramble_key;
+    const __m128i factor = _mm_set1_epi32((int)CSTL_hash_scramble_factor);
+
+    for (size_t i = 0; i != 4; ++i) {
+        __m128i lanes = _mm_xor_si128(acc[i], _mm_srli_epi64(acc[i], 47));
+        lanes = _mm_xor_si128(lanes, _mm_loadu_si128((const __m128i*)(key + i * 2)));
+
+        // 64x32-bit multiply from two 32x32->64-bit ones.
+        __m128i lo = _mm_mul_epu32(lanes, factor);
+        __m128i hi = _mm_mul_epu32(_mm_srli_epi64(lanes, 32), factor);
+        acc[i] = _mm_add_epi64(lo, _mm_slli_epi64(hi, 32));
+    }
+}
+
+static void CSTL_sse2_hash_long(uint64_t* lanes, const unsigned char* ptr, size_t bytes) {
+    const unsigned char* last = ptr + bytes - CSTL_hash_stripe;
+    __m128i acc[4];
+
+    for (size_t i = 0; i != 4; ++i) {
+        acc[i] = _mm_loadu_si128((const __m128i*)(lanes + i * 2));
+    }
+
+    CSTL_hash_long_loop(sse2);
+
+    for (size_t i = 0; i != 4; ++i) {
+        _mm_storeu_si128((__m128i*)(lanes + i * 2), acc[i]);
+    }
+}
+#endif
+
+#ifdef CSTL_char_avx2
+CSTL_target_avx2 static inline void CSTL_avx2_hash_stripe(__m256i* acc, const unsigned char* ptr, const uint64_t* key) {
+    for (size_t i = 0; i != 2; ++i) {
+        __m256i word  = _mm256_loadu_si256((const __m256i*)(ptr + i * 32));
+        __m256i keyed = _mm256_xor_si256(word, _mm256_loadu_si256((const __m256i*)(key + i * 4)));
+
+        __m256i product = _mm256_mul_epu32(keyed, _mm256_srli_epi64(keyed, 32));
+        __m256i swapped = _mm256_shuffle_epi32(word, _MM_SHUFFLE(1, 0, 3, 2));
+
+        acc[i] = _mm256_add_epi64(acc[i], _mm256_add_epi64(product, swapped));
+    }
+}
+
+CSTL_target_avx2 static inline void CSTL_avx2_hash_scramble(__m256i* acc) {
+    const uint64_t* key = CSTL_hash_key + CSTL_hash_scramble_key;
+    const __m256i factor = _mm256_set1_epi32((int)CSTL_hash_scramble_factor);
+
+    for (size_t i = 0; i != 2; ++i) {
+        __m256i lanes = _mm256_xor_si256(acc[i], _mm256_srli_epi64(acc[i], 47));
+        lanes = _mm256_xor_si256(lanes, _mm256_loadu_si256((const __m256i*)(key + i * 4)));
+
+        __m256i lo = _mm256_mul_epu32(lanes, factor);
+        __m256i hi = _mm256_mul_epu32(_mm256_srli_epi64(lanes, 32), factor);
+        acc[i] = _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32));
+    }
+}
+
+CSTL_target_avx2 static void CSTL_avx2_hash_long(uint64_t* lanes, const unsigned char* ptr, size_t bytes) {
+    const unsigned char* last = ptr + bytes - CSTL_hash_stripe;
+    __m256i acc[2];
+
+    for (size_t i = 0; i != 2; ++i) {
+        acc[i] = _mm256_loadu_si256((const __m256i*)(lanes + i * 4));
+    }
+
+    CSTL_hash_long_loop(avx2);
+
+    for (size_t i = 0; i != 2; ++i) {
+        _mm256_storeu_si256((__m256i*)(lanes + i * 4), acc[i]);
+    }
+}
+#endif
+
+// More than 256 bytes, folded into eight lanes which are then mixed pairwise.
+static uint64_t CSTL_hash_long(const unsigned char* ptr, size_t bytes) {
+    uint64_t acc[8];
+
+    for (size_t i = 0; i != 8; ++i) {
+        acc[i] = CSTL_hash_key[i];
+    }
+
+#if defined(CSTL_char_sse2)
+#if defined(CSTL_char_avx2)
+    if (CSTL_has_avx2()) {
+        CSTL_avx2_hash_long(acc, ptr, bytes);
+    } else
+#endif
+    CSTL_sse2_hash_long(acc, ptr, bytes);
+#else
+    CSTL_scalar_hash_long(acc, ptr, bytes);
+#endif
+
+    const uint64_t* key = CSTL_hash_key + CSTL_hash_last_key;
+    uint64_t result = (uint64_t)bytes * CSTL_hash_key[0];
+
+    for (size_t i = 0; i != 8; i += 2) {
+        result += CSTL_hash_mix(acc[i] ^ key[i], acc[i + 1] ^ key[i + 1]);
+    }
+
+    return CSTL_hash_mix(result ^ CSTL_hash_key[2], CSTL_hash_key[3]);
+}
+
+size_t CSTL_char_hash_fast(const void* first, size_t bytes) {
+    const unsigned char* ptr = (const unsigned char*)first;
+
+    if (bytes <= CSTL_hash_short_max) {
+        return (size_t)CSTL_hash_short(ptr, bytes);
+    }
+
+    return (size_t)CSTL_hash_long(ptr, bytes);
+}
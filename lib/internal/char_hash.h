@@ -0,0 +1,38 @@
+#pragma once
+
+#ifndef CSTL_CHAR_HASH_H
+#define CSTL_CHAR_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * String hashing shared by all string types.
+ * 
+ * `CSTL_char_hash_fnv` is FNV-1a over bytes with the parameters of MSVC's
+ * `_Fnv1a_append_bytes`, which `std::hash<std::basic_string>` and
+ * `std::hash<std::basic_string_view>` use, so it matches them bit for bit
+ * on the same platform.
+ * 
+ * `CSTL_char_hash_fast` mixes 16 bytes per 64x64->128-bit multiply for
+ * keys of up to 256 bytes. Longer keys are folded into eight 64-bit lanes with
+ * 32x32->64-bit multiplies, 32 bytes per instruction with AVX2 or 16 with SSE2,
+ * which all compute the same value as the scalar code. The result depends only
+ * on the bytes, never on the instruction set, but it is not seeded and must not
+ * be relied on across versions.
+ * 
+ */
+
+/**
+ * Returns the FNV-1a hash of the `bytes` bytes at `first`.
+ * 
+ */
+size_t CSTL_char_hash_fnv(const void* first, size_t bytes);
+
+/**
+ * Returns the fast hash of the `bytes` bytes at `first`.
+ * 
+ */
+size_t CSTL_char_hash_fast(const void* first, size_t bytes);
+
+#endif
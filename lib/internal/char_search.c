@@ -0,0 +1,734 @@
+#include "char_search.h"
+
+#include "char_dispatch.h"
+#include "char_simd.h"
+
+// Characters the filter may spend on rejected candidates before giving up,
+// in addition to a fixed multiple of the characters it has advanced by.
+#define CSTL_search_budget 512
+#define CSTL_search_budget_factor 4
+
+// Returned by the filters when the search must continue with Two-Way.
+#define CSTL_search_give_up SIZE_MAX
+
+// Characters are accessed through a base pointer and an index. A reverse search
+// uses a pointer to the last character and walks backwards, which lets the
+// same Two-Way implementation handle both directions.
+static inline uint32_t CSTL_search_at(const unsigned char* base, size_t index, size_t width, bool reverse) {
+    return CSTL_char_load(reverse ? base - index * width : base + index * width, width);
+}
+
+static inline const unsigned char* CSTL_search_base(const void* first, size_t count, size_t width, bool reverse) {
+    return (const unsigned char*)first + (reverse ? (count - 1) * width : 0);
+}
+
+static inline size_t CSTL_search_find_ch(const void* first, size_t count, uint32_t ch, size_t width) {
+    switch (width) {
+    case 1:  return CSTL_char_find_1(first, count, (uint8_t)ch);
+    case 2:  return CSTL_char_find_2(first, count, (uint16_t)ch);
+    default: return CSTL_char_find_4(first, count, ch);
+    }
+}
+
+static inline size_t CSTL_search_rfind_ch(const void* first, size_t count, uint32_t ch, size_t width) {
+    switch (width) {
+    case 1:  return CSTL_char_rfind_1(first, count, (uint8_t)ch);
+    case 2:  return CSTL_char_rfind_2(first, count, (uint16_t)ch);
+    default: return CSTL_char_rfind_4(first, count, ch);
+    }
+}
+
+// Two-Way (Crochemore and Perrin), following the formulation used by glibc.
+
+static inline size_t CSTL_search_max_suffix(const unsigned char* needle, size_t size, size_t width, bool reverse, bool flip, size_t* period) {
+    size_t max_suffix = SIZE_MAX; // wraps to the start of the needle when offset
+    size_t j = 0;
+    size_t k = 1;
+    size_t p = 1;
+
+    while (j + k < size) {
+        uint32_t a = CSTL_search_at(needle, j + k, width, reverse);
+        uint32_t b = CSTL_search_at(needle, max_suffix + k, width, reverse);
+
+        if (flip ? b < a : a < b) {
+            j += k;
+            k = 1;
+            p = j - max_suffix;
+        } else if (a == b) {
+            if (k != p) {
+                ++k;
+            } else {
+                j += p;
+                k = 1;
+            }
+        } else {
+            max_suffix = j++;
+            k = p = 1;
+        }
+    }
+
+    *period = p;
+    return max_suffix;
+}
+
+// `size >= 2`, `needle` is a base pointer for the direction
+static inline void CSTL_two_way_init(CSTL_CharTwoWay* two_way, const unsigned char* needle, size_t size, size_t width, bool reverse) {
+    size_t period, period_rev;
+    size_t max_suffix     = CSTL_search_max_suffix(needle, size, width, reverse, false, &period);
+    size_t max_suffix_rev = CSTL_search_max_suffix(needle, size, width, reverse, true, &period_rev);
+
+    size_t suffix = max_suffix + 1;
+    if (max_suffix_rev + 1 >= max_suffix + 1) {
+        suffix = max_suffix_rev + 1;
+        period = period_rev;
+    }
+
+    bool periodic = true;
+    for (size_t i = 0; i != suffix; ++i) {
+        if (CSTL_search_at(needle, i, width, reverse) != CSTL_search_at(needle, i + period, width, reverse)) {
+            periodic = false;
+            break;
+        }
+    }
+
+    two_way->suffix   = suffix;
+    two_way->periodic = periodic;
+    two_way->period   = periodic ? period : (suffix > size - suffix ? suffix : size - suffix) + 1;
+
+    for (size_t c = 0; c != 256; ++c) {
+        two_way->shift[c] = size;
+    }
+
+    for (size_t i = 0; i != size; ++i) {
+        two_way->shift[CSTL_search_at(needle, i, width, reverse) & 0xFF] = size - 1 - i;
+    }
+}
+
+// `2 <= size <= count`, `needle` and `hay` are base pointers for the direction.
+// Returns the index in the direction of the search, or `count`.
+static inline size_t CSTL_two_way_search(const CSTL_CharTwoWay* two_way, const unsigned char* needle, size_t size, const unsigned char* hay, size_t count, size_t width, bool reverse) {
+    size_t suffix = two_way->suffix;
+    size_t period = two_way->period;
+
+    // For single byte characters a zero shift means the last character matched.
+    // Wider characters only share their low byte with the needle.
+    size_t right_end = width == 1 ? size - 1 : size;
+
+    size_t j = 0;
+
+    if (two_way->periodic) {
+        size_t memory = 0; // length of the needle prefix known to match at `j`
+
+        while (j <= count - size) {
+            size_t shift = two_way->shift[CSTL_search_at(hay, j + size - 1, width, reverse) & 0xFF];
+
+            if (shift != 0) {
+                // Only an exact table proves the matched prefix cannot be reused
+                if (width == 1 && memory != 0 && shift < period) {
+                    shift = size - period;
+                }
+
+                memory = 0;
+                j += shift;
+                continue;
+            }
+
+            size_t i = suffix > memory ? suffix : memory;
+            while (i < right_end && CSTL_search_at(needle, i, width, reverse) == CSTL_search_at(hay, i + j, width, reverse)) {
+                ++i;
+            }
+
+            if (i >= right_end) {
+                i = suffix - 1;
+                while (memory < i + 1 && CSTL_search_at(needle, i, width, reverse) == CSTL_search_at(hay, i + j, width, reverse)) {
+                    --i;
+                }
+
+                if (i + 1 < memory + 1) {
+                    return j;
+                }
+
+                j += period;
+                memory = size - period;
+            } else {
+                j += i - suffix + 1;
+                memory = 0;
+            }
+        }
+    } else {
+        while (j <= count - size) {
+            size_t shift = two_way->shift[CSTL_search_at(hay, j + size - 1, width, reverse) & 0xFF];
+
+            if (shift != 0) {
+                j += shift;
+                continue;
+            }
+
+            size_t i = suffix;
+            while (i < right_end && CSTL_search_at(needle, i, width, reverse) == CSTL_search_at(hay, i + j, width, reverse)) {
+                ++i;
+            }
+
+            if (i >= right_end) {
+                i = suffix - 1;
+                while (i != SIZE_MAX && CSTL_search_at(needle, i, width, reverse) == CSTL_search_at(hay, i + j, width, reverse)) {
+                    --i;
+                }
+
+                if (i == SIZE_MAX) {
+                    return j;
+                }
+
+                j += period;
+            } else {
+                j += i - suffix + 1;
+            }
+        }
+    }
+
+    return count;
+}
+
+// First and last character filters. Candidates are verified with `memcmp`,
+// rejected candidates are charged against the budget. A forward filter that
+// runs out of budget stores the first unchecked position to `*pos`,
+// a reverse filter stores the position after the last unchecked one.
+
+static inline bool CSTL_search_over_budget(size_t work, size_t advanced) {
+    return work > CSTL_search_budget + CSTL_search_budget_factor * advanced;
+}
+
+static inline bool CSTL_search_verify(const unsigned char* candidate, const unsigned char* needle, size_t size, size_t width) {
+    return memcmp(candidate + width, needle + width, (size - 2) * width) == 0;
+}
+
+static inline bool CSTL_search_candidate(const unsigned char* candidate, const unsigned char* needle, size_t size, size_t width) {
+    return CSTL_char_load(candidate, width) == CSTL_char_load(needle, width)
+        && CSTL_char_load(candidate + (size - 1) * width, width) == CSTL_char_load(needle + (size - 1) * width, width)
+        && CSTL_search_verify(candidate, needle, size, width);
+}
+
+// `2 <= size <= count`, checks the positions `[*pos, count - size]`
+static inline size_t CSTL_scalar_search_filter(const unsigned char* hay, size_t count, const unsigned char* needle, size_t size, size_t width, size_t* pos) {
+    uint32_t first = CSTL_char_load(needle, width);
+    size_t start   = *pos;
+    size_t end     = count - size + 1;
+    size_t work    = 0;
+
+    for (size_t j = start; j < end;) {
+        size_t found = CSTL_search_find_ch(hay + j * width, end - j, first, width);
+        if (found == end - j) {
+            break;
+        }
+
+        j += found;
+        if (CSTL_search_candidate(hay + j * width, needle, size, width)) {
+            return j;
+        }
+
+        work += size;
+        if (CSTL_search_over_budget(work, j - start)) {
+            *pos = j + 1;
+            return CSTL_search_give_up;
+        }
+
+        ++j;
+    }
+
+    return count;
+}
+
+// `2 <= size <= count`, checks the positions `[0, *pos)`
+static inline size_t CSTL_scalar_search_rfilter(const unsigned char* hay, size_t count, const unsigned char* needle, size_t size, size_t width, size_t* pos) {
+    uint32_t first = CSTL_char_load(needle, width);
+    size_t start   = *pos;
+    size_t work    = 0;
+
+    for (size_t j = start; j != 0;) {
+        size_t found = CSTL_search_rfind_ch(hay, j, first, width);
+        if (found == j) {
+            break;
+        }
+
+        j = found;
+        if (CSTL_search_candidate(hay + j * width, needle, size, width)) {
+            return j;
+        }
+
+        work += size;
+        if (CSTL_search_over_budget(work, start - j)) {
+            *pos = j;
+            return CSTL_search_give_up;
+        }
+    }
+
+    return count;
+}
+
+#ifdef CSTL_char_sse2
+static inline uint32_t CSTL_sse2_starts(size_t width) {
+    switch (width) {
+    case 1:  return 0xFFFFu;
+    case 2:  return 0x5555u;
+    default: return 0x1111u;
+    }
+}
+
+static inline uint32_t CSTL_sse2_pair_mask(const unsigned char* ptr, size_t last_off, __m128i first, __m128i last, size_t width) {
+    __m128i eq_first = CSTL_sse2_cmpeq(_mm_loadu_si128((const __m128i*)ptr), first, width);
+    __m128i eq_last  = CSTL_sse2_cmpeq(_mm_loadu_si128((const __m128i*)(ptr + last_off)), last, width);
+    return (uint32_t)_mm_movemask_epi8(_mm_and_si128(eq_first, eq_last)) & CSTL_sse2_starts(width);
+}
+
+// `2 <= size <= count`
+static inline size_t CSTL_sse2_search_filter(const unsigned char* hay, size_t count, const unsigned char* needle, size_t size, size_t width, size_t* pos) {
+    size_t last_off = (size - 1) * width;
+    size_t lanes    = 16 / width;
+    __m128i first   = CSTL_sse2_set1(CSTL_char_load(needle, width), width);
+    __m128i last    = CSTL_sse2_set1(CSTL_char_load(needle + last_off, width), width);
+
+    size_t j    = *pos;
+    size_t work = 0;
+
+    for (; count - j >= lanes + size - 1; j += lanes) {
+        if (CSTL_search_over_budget(work, j - *pos)) {
+            *pos = j;
+            return CSTL_search_give_up;
+        }
+
+        const unsigned char* chunk = hay + j * width;
+        uint32_t mask = CSTL_sse2_pair_mask(chunk, last_off, first, last, width);
+
+        for (; mask != 0; mask &= mask - 1) {
+            unsigned off = CSTL_ctz32(mask);
+            if (CSTL_search_verify(chunk + off, needle, size, width)) {
+                return j + off / width;
+            }
+
+            work += size;
+        }
+    }
+
+    for (; count - j >= size; ++j) {
+        if (CSTL_search_candidate(hay + j * width, needle, size, width)) {
+            return j;
+        }
+    }
+
+    return count;
+}
+
+// `2 <= size <= count`
+static inline size_t CSTL_sse2_search_rfilter(const unsigned char* hay, size_t count, const unsigned char* needle, size_t size, size_t width, size_t* pos) {
+    size_t last_off = (size - 1) * width;
+    size_t lanes    = 16 / width;
+    __m128i first   = CSTL_sse2_set1(CSTL_char_load(needle, width), width);
+    __m128i last    = CSTL_sse2_set1(CSTL_char_load(needle + last_off, width), width);
+
+    size_t j    = *pos;
+    size_t work = 0;
+
+    for (; j >= lanes; j -= lanes) {
+        if (CSTL_search_over_budget(work, *pos - j)) {
+            *pos = j;
+            return CSTL_search_give_up;
+        }
+
+        const unsigned char* chunk = hay + (j - lanes) * width;
+        uint32_t mask = CSTL_sse2_pair_mask(chunk, last_off, first, last, width);
+
+        while (mask != 0) {
+            unsigned off = CSTL_bsr32(mask);
+            if (CSTL_search_verify(chunk + off, needle, size, width)) {
+                return j - lanes + off / width;
+            }
+
+            mask ^= 1u << off;
+            work += size;
+        }
+    }
+
+    while (j != 0) {
+        --j;
+        if (CSTL_search_candidate(hay + j * width, needle, size, width)) {
+            return j;
+        }
+    }
+
+    return count;
+}
+#endif
+
+#ifdef CSTL_char_avx2
+CSTL_target_avx2 static inline uint32_t CSTL_avx2_starts(size_t width) {
+    switch (width) {
+    case 1:  return 0xFFFFFFFFu;
+    case 2:  return 0x55555555u;
+    default: return 0x11111111u;
+    }
+}
+
+CSTL_target_avx2 static inline uint32_t CSTL_avx2_pair_mask(const unsigned char* ptr, size_t last_off, __m256i first, __m256i last, size_t width) {
+    __m256i eq_first = CSTL_avx2_cmpeq(_mm256_loadu_si256((const __m256i*)ptr), first, width);
+    __m256i eq_last  = CSTL_avx2_cmpeq(_mm256_loadu_si256((const __m256i*)(ptr + last_off)), last, width);
+    return (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(eq_first, eq_last)) & CSTL_avx2_starts(width);
+}
+
+// `2 <= size <= count`
+CSTL_target_avx2 static inline size_t CSTL_avx2_search_filter(const unsigned char* hay, size_t count, const unsigned char* needle, size_t size, size_t width, size_t* pos) {
+    size_t last_off = (size - 1) * width;
+    size_t lanes    = 32 / width;
+    __m256i first   = CSTL_avx2_set1(CSTL_char_load(needle, width), width);
+    __m256i last    = CSTL_avx2_set1(CSTL_char_load(needle + last_off, width), width);
+
+    size_t j    = *pos;
+    size_t work = 0;
+
+    for (; count - j >= lanes + size - 1; j += lanes) {
+        if (CSTL_search_over_budget(work, j - *pos)) {
+            *pos = j;
+            return CSTL_search_give_up;
+        }
+
+        const unsigned char* chunk = hay + j * width;
+        uint32_t mask = CSTL_avx2_pair_mask(chunk, last_off, first, last, width);
+
+        for (; mask != 0; mask &= mask - 1) {
+            unsigned off = CSTL_ctz32(mask);
+            if (CSTL_search_verify(chunk + off, needle, size, width)) {
+                return j + off / width;
+            }
+
+            work += size;
+        }
+    }
+
+    for (; count - j >= size; ++j) {
+        if (CSTL_search_candidate(hay + j * width, needle, size, width)) {
+            return j;
+        }
+    }
+
+    return count;
+}
+
+// `2 <= size <= count`
+CSTL_target_avx2 static inline size_t CSTL_avx2_search_rfilter(const unsigned char* hay, size_t count, const unsigned char* needle, size_t size, size_t width, size_t* pos) {
+    size_t last_off = (size - 1) * width;
+    size_t lanes    = 32 / width;
+    __m256i first   = CSTL_avx2_set1(CSTL_char_load(needle, width), width);
+    __m256i last    = CSTL_avx2_set1(CSTL_char_load(needle + last_off, width), width);
+
+    size_t j    = *pos;
+    size_t work = 0;
+
+    for (; j >= lanes; j -= lanes) {
+        if (CSTL_search_over_budget(work, *pos - j)) {
+            *pos = j;
+            return CSTL_search_give_up;
+        }
+
+        const unsigned char* chunk = hay + (j - lanes) * width;
+        uint32_t mask = CSTL_avx2_pair_mask(chunk, last_off, first, last, width);
+
+        while (mask != 0) {
+            unsigned off = CSTL_bsr32(mask);
+            if (CSTL_search_verify(chunk + off, needle, size, width)) {
+                return j - lanes + off / width;
+            }
+
+            mask ^= 1u << off;
+            work += size;
+        }
+    }
+
+    while (j != 0) {
+        --j;
+        if (CSTL_search_candidate(hay + j * width, needle, size, width)) {
+            return j;
+        }
+    }
+
+    return count;
+}
+
+CSTL_target_avx2 static size_t CSTL_avx2_search_filter_n(const unsigned char* hay, size_t count, const unsigned char* needle, size_t size, size_t width, size_t* pos) {
+    switch (width) {
+    case 1:  return CSTL_avx2_search_filter(hay, count, needle, size, 1, pos);
+    case 2:  return CSTL_avx2_search_filter(hay, count, needle, size, 2, pos);
+    default: return CSTL_avx2_search_filter(hay, count, needle, size, 4, pos);
+    }
+}
+
+CSTL_target_avx2 static size_t CSTL_avx2_search_rfilter_n(const unsigned char* hay, size_t count, const unsigned char* needle, size_t size, size_t width, size_t* pos) {
+    switch (width) {
+    case 1:  return CSTL_avx2_search_rfilter(hay, count, needle, size, 1, pos);
+    case 2:  return CSTL_avx2_search_rfilter(hay, count, needle, size, 2, pos);
+    default: return CSTL_avx2_search_rfilter(hay, count, needle, size, 4, pos);
+    }
+}
+#endif
+
+#ifdef CSTL_char_neon
+static inline uint64_t CSTL_neon_starts(size_t width) {
+    switch (width) {
+    case 1:  return 0x1111111111111111u;
+    case 2:  return 0x0101010101010101u;
+    default: return 0x0001000100010001u;
+    }
+}
+
+// 4 bits per byte, as produced by `CSTL_neon_mask`
+static inline uint64_t CSTL_neon_pair_mask(const unsigned char* ptr, size_t last_off, uint8x16_t first, uint8x16_t last, size_t width) {
+    uint8x16_t eq_first = CSTL_neon_cmpeq(vld1q_u8(ptr), first, width);
+    uint8x16_t eq_last  = CSTL_neon_cmpeq(vld1q_u8(ptr + last_off), last, width);
+    return CSTL_neon_mask(vandq_u8(eq_first, eq_last)) & CSTL_neon_starts(width);
+}
+
+// `2 <= size <= count`
+static inline size_t CSTL_neon_search_filter(const unsigned char* hay, size_t count, const unsigned char* needle, size_t size, size_t width, size_t* pos) {
+    size_t last_off  = (size - 1) * width;
+    size_t lanes     = 16 / width;
+    uint8x16_t first = CSTL_neon_set1(CSTL_char_load(needle, width), width);
+    uint8x16_t last  = CSTL_neon_set1(CSTL_char_load(needle + last_off, width), width);
+
+    size_t j    = *pos;
+    size_t work = 0;
+
+    for (; count - j >= lanes + size - 1; j += lanes) {
+        if (CSTL_search_over_budget(work, j - *pos)) {
+            *pos = j;
+            return CSTL_search_give_up;
+        }
+
+        const unsigned char* chunk = hay + j * width;
+        uint64_t mask = CSTL_neon_pair_mask(chunk, last_off, first, last, width);
+
+        for (; mask != 0; mask &= mask - 1) {
+            unsigned off = CSTL_ctz64(mask) / 4;
+            if (CSTL_search_verify(chunk + off, needle, size, width)) {
+                return j + off / width;
+            }
+
+            work += size;
+        }
+    }
+
+    for (; count - j >= size; ++j) {
+        if (CSTL_search_candidate(hay + j * width, needle, size, width)) {
+            return j;
+        }
+    }
+
+    return count;
+}
+
+// `2 <= size <= count`
+static inline size_t CSTL_neon_search_rfilter(const unsigned char* hay, size_t count, const unsigned char* needle, size_t size, size_t width, size_t* pos) {
+    size_t last_off  = (size - 1) * width;
+    size_t lanes     = 16 / width;
+    uint8x16_t first = CSTL_neon_set1(CSTL_char_load(needle, width), width);
+    uint8x16_t last  = CSTL_neon_set1(CSTL_char_load(needle + last_off, width), width);
+
+    size_t j    = *pos;
+    size_t work = 0;
+
+    for (; j >= lanes; j -= lanes) {
+        if (CSTL_search_over_budget(work, *pos - j)) {
+            *pos = j;
+            return CSTL_search_give_up;
+        }
+
+        const unsigned char* chunk = hay + (j - lanes) * width;
+        uint64_t mask = CSTL_neon_pair_mask(chunk, last_off, first, last, width);
+
+        while (mask != 0) {
+            unsigned bit = CSTL_bsr64(mask);
+            unsigned off = bit / 4;
+            if (CSTL_search_verify(chunk + off, needle, size, width)) {
+                return j - lanes + off / width;
+            }
+
+            mask ^= (uint64_t)1 << bit;
+            work += size;
+        }
+    }
+
+    while (j != 0) {
+        --j;
+        if (CSTL_search_candidate(hay + j * width, needle, size, width)) {
+            return j;
+        }
+    }
+
+    return count;
+}
+#endif
+
+static inline size_t CSTL_search_filter(const unsigned char* hay, size_t count, const unsigned char* needle, size_t size, size_t width, size_t* pos) {
+#if defined(CSTL_char_sse2)
+#if defined(CSTL_char_avx2)
+    if (count * width >= 64 && CSTL_has_avx2()) {
+        return CSTL_avx2_search_filter_n(hay, count, needle, size, width, pos);
+    }
+#endif
+    return CSTL_sse2_search_filter(hay, count, needle, size, width, pos);
+#elif defined(CSTL_char_neon)
+    return CSTL_neon_search_filter(hay, count, needle, size, width, pos);
+#else
+    return CSTL_scalar_search_filter(hay, count, needle, size, width, pos);
+#endif
+}
+
+static inline size_t CSTL_search_rfilter(const unsigned char* hay, size_t count, const unsigned char* needle, size_t size, size_t width, size_t* pos) {
+#if defined(CSTL_char_sse2)
+#if defined(CSTL_char_avx2)
+    if (count * width >= 64 && CSTL_has_avx2()) {
+        return CSTL_avx2_search_rfilter_n(hay, count, needle, size, width, pos);
+    }
+#endif
+    return CSTL_sse2_search_rfilter(hay, count, needle, size, width, pos);
+#elif defined(CSTL_char_neon)
+    return CSTL_neon_search_rfilter(hay, count, needle, size, width, pos);
+#else
+    return CSTL_scalar_search_rfilter(hay, count, needle, size, width, pos);
+#endif
+}
+
+// Width generic searches, `width` is always a constant.
+// `two_way` may be NULL, in which case it is computed when needed.
+
+static inline size_t CSTL_search_find(const CSTL_CharTwoWay* two_way, const void* first, size_t count, const void* needle, size_t size, size_t width) {
+    const unsigned char* hay          = (const unsigned char*)first;
+    const unsigned char* needle_bytes = (const unsigned char*)needle;
+
+    if (size > count) {
+        return count;
+    }
+
+    if (size == 1) {
+        return CSTL_search_find_ch(hay, count, CSTL_char_load(needle_bytes, width), width);
+    }
+
+    size_t pos = 0;
+
+    size_t found = CSTL_search_filter(hay, count, needle_bytes, size, width, &pos);
+    if (found != CSTL_search_give_up) {
+        return found;
+    }
+
+    CSTL_CharTwoWay local;
+    if (two_way == NULL) {
+        CSTL_two_way_init(&local, needle_bytes, size, width, false);
+        two_way = &local;
+    }
+
+    size_t rest = count - pos;
+    found = rest < size ? rest
+        : CSTL_two_way_search(two_way, needle_bytes, size, hay + pos * width, rest, width, false);
+
+    return found == rest ? count : pos + found;
+}
+
+static inline size_t CSTL_search_rfind(const CSTL_CharTwoWay* two_way, const void* first, size_t count, const void* needle, size_t size, size_t width) {
+    const unsigned char* hay          = (const unsigned char*)first;
+    const unsigned char* needle_bytes = (const unsigned char*)needle;
+
+    if (size > count) {
+        return count;
+    }
+
+    if (size == 1) {
+        return CSTL_search_rfind_ch(hay, count, CSTL_char_load(needle_bytes, width), width);
+    }
+
+    size_t pos = count - size + 1; // positions `[0, pos)` are yet to be checked
+
+    size_t found = CSTL_search_rfilter(hay, count, needle_bytes, size, width, &pos);
+    if (found != CSTL_search_give_up) {
+        return found;
+    }
+
+    if (pos == 0) {
+        return count;
+    }
+
+    const unsigned char* needle_base = CSTL_search_base(needle_bytes, size, width, true);
+
+    CSTL_CharTwoWay local;
+    if (two_way == NULL) {
+        CSTL_two_way_init(&local, needle_base, size, width, true);
+        two_way = &local;
+    }
+
+    size_t rest = pos + size - 1;
+    found = CSTL_two_way_search(two_way, needle_base, size,
+        CSTL_search_base(hay, rest, width, true), rest, width, true);
+
+    return found == rest ? count : rest - size - found;
+}
+
+void CSTL_char_search_init(CSTL_CharSearch* search, const void* needle, size_t size, size_t width) {
+    search->needle = needle;
+    search->size   = size;
+    search->width  = width;
+
+    if (size >= 2) {
+        const unsigned char* needle_bytes = (const unsigned char*)needle;
+
+        switch (width) {
+        case 1:
+            CSTL_two_way_init(&search->forward, needle_bytes, size, 1, false);
+            CSTL_two_way_init(&search->reverse, CSTL_search_base(needle_bytes, size, 1, true), size, 1, true);
+            break;
+        case 2:
+            CSTL_two_way_init(&search->forward, needle_bytes, size, 2, false);
+            CSTL_two_way_init(&search->reverse, CSTL_search_base(needle_bytes, size, 2, true), size, 2, true);
+            break;
+        default:
+            CSTL_two_way_init(&search->forward, needle_bytes, size, 4, false);
+            CSTL_two_way_init(&search->reverse, CSTL_search_base(needle_bytes, size, 4, true), size, 4, true);
+            break;
+        }
+    }
+}
+
+size_t CSTL_char_search_find(const CSTL_CharSearch* search, const void* first, size_t count) {
+    switch (search->width) {
+    case 1:  return CSTL_search_find(&search->forward, first, count, search->needle, search->size, 1);
+    case 2:  return CSTL_search_find(&search->forward, first, count, search->needle, search->size, 2);
+    default: return CSTL_search_find(&search->forward, first, count, search->needle, search->size, 4);
+    }
+}
+
+size_t CSTL_char_search_rfind(const CSTL_CharSearch* search, const void* first, size_t count) {
+    switch (search->width) {
+    case 1:  return CSTL_search_rfind(&search->reverse, first, count, search->needle, search->size, 1);
+    case 2:  return CSTL_search_rfind(&search->reverse, first, count, search->needle, search->size, 2);
+    default: return CSTL_search_rfind(&search->reverse, first, count, search->needle, search->size, 4);
+    }
+}
+
+size_t CSTL_char_find_seq_1(const void* first, size_t count, const void* needle, size_t size) {
+    return CSTL_search_find(NULL, first, count, needle, size, 1);
+}
+
+size_t CSTL_char_find_seq_2(const void* first, size_t count, const void* needle, size_t size) {
+    return CSTL_search_find(NULL, first, count, needle, size, 2);
+}
+
+size_t CSTL_char_find_seq_4(const void* first, size_t count, const void* needle, size_t size) {
+    return CSTL_search_find(NULL, first, count, needle, size, 4);
+}
+
+size_t CSTL_char_rfind_seq_1(const void* first, size_t count, const void* needle, size_t size) {
+    return CSTL_search_rfind(NULL, first, count, needle, size, 1);
+}
+
+size_t CSTL_char_rfind_seq_2(const void* first, size_t count, const void* needle, size_t size) {
+    return CSTL_search_rfind(NULL, first, count, needle, size, 2);
+}
+
+size_t CSTL_char_rfind_seq_4(const void* first, size_t count, const void* needle, size_t size) {
+    return CSTL_search_rfind(NULL, first, count, needle, size, 4);
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#ifndef CSTL_CHAR_SEARCH_H
+#define CSTL_CHAR_SEARCH_H
+
+#if defined(__cplusplus)
+#include <cstddef>
+#include <cstdint>
+extern "C" {
+#else
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#endif
+
+/*
+ * Substring search shared by all string types.
+ * 
+ * Needles are first located with a vectorised filter on their first and last
+ * characters, followed by a comparison of the remaining characters. Once the
+ * filter has spent too much time on false positives, which is quick for long
+ * needles in repetitive text, the search continues with the Two-Way algorithm,
+ * extended with a bad character shift table. The worst case is linear in the
+ * size of the haystack.
+ * 
+ * Needles must not be empty. Pointers must be aligned to the width of the
+ * character type.
+ * 
+ */
+
+/**
+ * Two-Way state for searching a needle in one direction.
+ * 
+ */
+typedef struct CSTL_CharTwoWay {
+    size_t suffix;     // critical factorization position
+    size_t period;     // period of the needle if `periodic`, otherwise the minimal shift
+    bool periodic;
+    size_t shift[256]; // bad character shift, keyed by the low byte of a character
+} CSTL_CharTwoWay;
+
+/**
+ * Precomputed state for searching one needle in both directions.
+ * 
+ * Borrows the needle, which must outlive the state. The state is never
+ * modified by a search and can be shared between threads.
+ * 
+ */
+typedef struct CSTL_CharSearch {
+    const void* needle;
+    size_t size;
+    size_t width;
+    CSTL_CharTwoWay forward;
+    CSTL_CharTwoWay reverse;
+} CSTL_CharSearch;
+
+/**
+ * Prepares `search` for the needle `[needle, needle + size)` of characters
+ * that are `width` (1, 2 or 4) bytes wide.
+ * 
+ */
+void CSTL_char_search_init(CSTL_CharSearch* search, const void* needle, size_t size, size_t width);
+
+/**
+ * Returns the index of the first occurrence of the prepared needle in
+ * `[first, first + count)`, or `count` if there is none.
+ * 
+ */
+size_t CSTL_char_search_find(const CSTL_CharSearch* search, const void* first, size_t count);
+
+/**
+ * Returns the index of the last occurrence of the prepared needle in
+ * `[first, first + count)`, or `count` if there is none.
+ * 
+ */
+size_t CSTL_char_search_rfind(const CSTL_CharSearch* search, const void* first, size_t count);
+
+/**
+ * Returns the index of the first occurrence of `[needle, needle + size)`
+ * in `[first, first + count)`, or `count` if there is none.
+ * 
+ */
+size_t CSTL_char_find_seq_1(const void* first, size_t count, const void* needle, size_t size);
+size_t CSTL_char_find_seq_2(const void* first, size_t count, const void* needle, size_t size);
+size_t CSTL_char_find_seq_4(const void* first, size_t count, const void* needle, size_t size);
+
+/**
+ * Returns the index of the last occurrence of `[needle, needle + size)`
+ * in `[first, first + count)`, or `count` if there is none.
+ * 
+ */
+size_t CSTL_char_rfind_seq_1(const void* first, size_t count, const void* needle, size_t size);
+size_t CSTL_char_rfind_seq_2(const void* first, size_t count, const void* needle, size_t size);
+size_t CSTL_char_rfind_seq_4(const void* first, size_t count, const void* needle, size_t size);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
@@ -0,0 +1,196 @@
+#pragma once
+
+#ifndef CSTL_CHAR_SIMD_H
+#define CSTL_CHAR_SIMD_H
+
+/*
+ * Private helpers shared by the vectorised character kernels.
+ * 
+ * Defines `CSTL_char_sse2`, `CSTL_char_avx2` and `CSTL_char_neon` for the available
+ * instruction sets, bit scan helpers and width generic element and vector accessors.
+ * AVX2 support must be checked at run time with `CSTL_has_avx2` before use.
+ * 
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Kernels that may read past the end of a buffer, within an aligned block that
+// is known to be mapped, are excluded from AddressSanitizer instrumentation.
+#if defined(__GNUC__) || defined(__clang__)
+#define CSTL_no_sanitize_address __attribute__((no_sanitize_address))
+#else
+#define CSTL_no_sanitize_address
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CSTL_char_sse2
+#include <emmintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#include <immintrin.h>
+#define CSTL_char_avx2
+#define CSTL_target_avx2
+#elif defined(__GNUC__) || defined(__clang__)
+#include <immintrin.h>
+#define CSTL_char_avx2
+#define CSTL_target_avx2 __attribute__((target("avx2")))
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define CSTL_char_neon
+#include <arm_neon.h>
+#endif
+
+static inline unsigned CSTL_ctz32(uint32_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (unsigned)index;
+#else
+    return (unsigned)__builtin_ctz(mask);
+#endif
+}
+
+static inline unsigned CSTL_bsr32(uint32_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanReverse(&index, mask);
+    return (unsigned)index;
+#else
+    return 31u - (unsigned)__builtin_clz(mask);
+#endif
+}
+
+#ifdef CSTL_char_neon
+static inline unsigned CSTL_ctz64(uint64_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return (unsigned)index;
+#else
+    return (unsigned)__builtin_ctzll(mask);
+#endif
+}
+
+static inline unsigned CSTL_bsr64(uint64_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanReverse64(&index, mask);
+    return (unsigned)index;
+#else
+    return 63u - (unsigned)__builtin_clzll(mask);
+#endif
+}
+#endif
+
+static inline uint32_t CSTL_char_load(const unsigned char* ptr, size_t width) {
+    switch (width) {
+    case 1:  return *ptr;
+    case 2:  return *(const uint16_t*)ptr;
+    default: return *(const uint32_t*)ptr;
+    }
+}
+
+static inline void CSTL_char_store(unsigned char* ptr, uint32_t ch, size_t width) {
+    switch (width) {
+    case 1:  *ptr = (uint8_t)ch; break;
+    case 2:  *(uint16_t*)ptr = (uint16_t)ch; break;
+    default: *(uint32_t*)ptr = ch; break;
+    }
+}
+
+#ifdef CSTL_char_sse2
+static inline __m128i CSTL_sse2_set1(uint32_t ch, size_t width) {
+    switch (width) {
+    case 1:  return _mm_set1_epi8((char)ch);
+    case 2:  return _mm_set1_epi16((short)ch);
+    default: return _mm_set1_epi32((int)ch);
+    }
+}
+
+static inline __m128i CSTL_sse2_cmpeq(__m128i lhs, __m128i rhs, size_t width) {
+    switch (width) {
+    case 1:  return _mm_cmpeq_epi8(lhs, rhs);
+    case 2:  return _mm_cmpeq_epi16(lhs, rhs);
+    default: return _mm_cmpeq_epi32(lhs, rhs);
+    }
+}
+#endif
+
+#ifdef CSTL_char_avx2
+static inline bool CSTL_has_avx2(void) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    static volatile int cached = -1; // idempotent, racing writers store the same value
+    int result = cached;
+
+    if (result < 0) {
+        int info[4];
+        result = 0;
+
+        __cpuid(info, 0);
+
+        if (info[0] >= 7) {
+            __cpuid(info, 1);
+
+            bool has_osxsave = (info[2] & (1 << 27)) != 0;
+            bool has_avx     = (info[2] & (1 << 28)) != 0;
+
+            if (has_osxsave && has_avx && (_xgetbv(0) & 6) == 6) {
+                __cpuidex(info, 7, 0);
+                result = (info[1] & (1 << 5)) != 0;
+            }
+        }
+
+        cached = result;
+    }
+
+    return result != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+CSTL_target_avx2 static inline __m256i CSTL_avx2_set1(uint32_t ch, size_t width) {
+    switch (width) {
+    case 1:  return _mm256_set1_epi8((char)ch);
+    case 2:  return _mm256_set1_epi16((short)ch);
+    default: return _mm256_set1_epi32((int)ch);
+    }
+}
+
+CSTL_target_avx2 static inline __m256i CSTL_avx2_cmpeq(__m256i lhs, __m256i rhs, size_t width) {
+    switch (width) {
+    case 1:  return _mm256_cmpeq_epi8(lhs, rhs);
+    case 2:  return _mm256_cmpeq_epi16(lhs, rhs);
+    default: return _mm256_cmpeq_epi32(lhs, rhs);
+    }
+}
+#endif
+
+#ifdef CSTL_char_neon
+static inline uint8x16_t CSTL_neon_set1(uint32_t ch, size_t width) {
+    switch (width) {
+    case 1:  return vdupq_n_u8((uint8_t)ch);
+    case 2:  return vreinterpretq_u8_u16(vdupq_n_u16((uint16_t)ch));
+    default: return vreinterpretq_u8_u32(vdupq_n_u32(ch));
+    }
+}
+
+static inline uint8x16_t CSTL_neon_cmpeq(uint8x16_t lhs, uint8x16_t rhs, size_t width) {
+    switch (width) {
+    case 1:  return vceqq_u8(lhs, rhs);
+    case 2:  return vreinterpretq_u8_u16(vceqq_u16(vreinterpretq_u16_u8(lhs), vreinterpretq_u16_u8(rhs)));
+    default: return vreinterpretq_u8_u32(vceqq_u32(vreinterpretq_u32_u8(lhs), vreinterpretq_u32_u8(rhs)));
+    }
+}
+
+// Narrows a comparison result to a 64-bit mask with 4 bits per byte.
+static inline uint64_t CSTL_neon_mask(uint8x16_t cmp) {
+    uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+}
+#endif
+
+#endif
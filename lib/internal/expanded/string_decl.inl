@@ -1,4 +1,7 @@
 #include "../../alloc.h"
+#include "../../type.h"
+#include "../../vector.h"
+#include "../char_search.h"
 
 #if defined(__cplusplus)
 #include <cstddef>
@@ -13,6 +16,9 @@
 #undef CSTL_string_alloc_mask
 #undef CSTL_string_small_capacity
 #undef CSTL_string_npos
+#undef CSTL_string_split_char
+#undef CSTL_string_split_any_of
+#undef CSTL_string_split_str
 
 // length of internal buffer, [1, 16]
 #define CSTL_string_bufsize (16 / sizeof(char) < 1 ? 1 : 16 / sizeof(char))
@@ -26,6 +32,10 @@
 #define CSTL_string_small_capacity (CSTL_string_bufsize - 1)
 // `std::basic_string` npos constant
 #define CSTL_string_npos (size_t)-1;
+// delimiter kinds of the split iterator
+#define CSTL_string_split_char   0
+#define CSTL_string_split_any_of 1
+#define CSTL_string_split_str    2
 
 /**
  * STL ABI `std::basic_string` layout.
@@ -786,6 +796,262 @@ size_t CSTL_string_rfind_char(CSTL_StringCRef instance, char ch, size_t off);
  */
 size_t CSTL_string_rfind_str(CSTL_StringCRef instance, CSTL_StringCRef other, size_t off);
 
+/**
+ * Find the first from offset `off` character equal to any of the characters
+ * in the null-terminated string `ptr` and return its
+ * position from the start of the string.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_find_first_of(CSTL_StringCRef instance, const char* ptr, size_t off);
+
+/**
+ * Find the first from offset `off` character equal to any of the characters
+ * in the first `count` characters at `ptr` and return its
+ * position from the start of the string.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_find_first_of_n(CSTL_StringCRef instance, const char* ptr, size_t off, size_t count);
+
+/**
+ * Find the first from offset `off` character equal to `ch`
+ * and return its position from the start of the string.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_find_first_of_char(CSTL_StringCRef instance, char ch, size_t off);
+
+/**
+ * Find the first from offset `off` character equal to any of the characters
+ * in the string `other` and return its
+ * position from the start of the original string.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_find_first_of_str(CSTL_StringCRef instance, CSTL_StringCRef other, size_t off);
+
+/**
+ * Find the last before offset `off` character equal to any of the characters
+ * in the null-terminated string `ptr` and return its
+ * position from the start of the string.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_find_last_of(CSTL_StringCRef instance, const char* ptr, size_t off);
+
+/**
+ * Find the last before offset `off` character equal to any of the characters
+ * in the first `count` characters at `ptr` and return its
+ * position from the start of the string.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_find_last_of_n(CSTL_StringCRef instance, const char* ptr, size_t off, size_t count);
+
+/**
+ * Find the last before offset `off` character equal to `ch`
+ * and return its position from the start of the string.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_find_last_of_char(CSTL_StringCRef instance, char ch, size_t off);
+
+/**
+ * Find the last before offset `off` character equal to any of the characters
+ * in the string `other` and return its
+ * position from the start of the original string.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_find_last_of_str(CSTL_StringCRef instance, CSTL_StringCRef other, size_t off);
+
+/**
+ * Find the first from offset `off` character equal to none of the characters
+ * in the null-terminated string `ptr` and return its
+ * position from the start of the string.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_find_first_not_of(CSTL_StringCRef instance, const char* ptr, size_t off);
+
+/**
+ * Find the first from offset `off` character equal to none of the characters
+ * in the first `count` characters at `ptr` and return its
+ * position from the start of the string.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_find_first_not_of_n(CSTL_StringCRef instance, const char* ptr, size_t off, size_t count);
+
+/**
+ * Find the first from offset `off` character not equal to `ch`
+ * and return its position from the start of the string.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_find_first_not_of_char(CSTL_StringCRef instance, char ch, size_t off);
+
+/**
+ * Find the first from offset `off` character equal to none of the characters
+ * in the string `other` and return its
+ * position from the start of the original string.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_find_first_not_of_str(CSTL_StringCRef instance, CSTL_StringCRef other, size_t off);
+
+/**
+ * Find the last before offset `off` character equal to none of the characters
+ * in the null-terminated string `ptr` and return its
+ * position from the start of the string.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_find_last_not_of(CSTL_StringCRef instance, const char* ptr, size_t off);
+
+/**
+ * Find the last before offset `off` character equal to none of the characters
+ * in the first `count` characters at `ptr` and return its
+ * position from the start of the string.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_find_last_not_of_n(CSTL_StringCRef instance, const char* ptr, size_t off, size_t count);
+
+/**
+ * Find the last before offset `off` character not equal to `ch`
+ * and return its position from the start of the string.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_find_last_not_of_char(CSTL_StringCRef instance, char ch, size_t off);
+
+/**
+ * Find the last before offset `off` character equal to none of the characters
+ * in the string `other` and return its
+ * position from the start of the original string.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_find_last_not_of_str(CSTL_StringCRef instance, CSTL_StringCRef other, size_t off);
+
+/**
+ * Precomputed search state for a fixed needle.
+ * 
+ * Initialize with `CSTL_string_searcher_init`, then use it to search any number of
+ * strings or character ranges. Searches never modify the searcher, so it can be
+ * shared between threads. There is nothing to destroy.
+ * 
+ * The searcher borrows the needle, which must stay alive and unmodified
+ * for as long as the searcher is used.
+ * 
+ * Do not manipulate the members directly, use the associated functions!
+ * 
+ */
+typedef struct CSTL_StringSearcher {
+    CSTL_CharSearch state;
+} CSTL_StringSearcher;
+
+/**
+ * Prepares `new_searcher` for searching the first `count` characters at `needle`.
+ * 
+ */
+void CSTL_string_searcher_init(CSTL_StringSearcher* new_searcher, const char* needle, size_t count);
+
+/**
+ * Find the first from offset `off` occurence of the searcher's needle in `instance`
+ * and return its position from the start of the string.
+ * 
+ * Equivalent to `CSTL_string_find_n`.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_searcher_find(const CSTL_StringSearcher* searcher, CSTL_StringCRef instance, size_t off);
+
+/**
+ * Find the last before offset `off` occurence of the searcher's needle in `instance`
+ * and return its position from the start of the string.
+ * 
+ * Equivalent to `CSTL_string_rfind_n`.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_searcher_rfind(const CSTL_StringSearcher* searcher, CSTL_StringCRef instance, size_t off);
+
+/**
+ * Find the first occurence of the searcher's needle in the first `count` characters
+ * at `ptr` and return its position from `ptr`.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_searcher_find_in(const CSTL_StringSearcher* searcher, const char* ptr, size_t count);
+
+/**
+ * Find the last occurence of the searcher's needle in the first `count` characters
+ * at `ptr` and return its position from `ptr`.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_searcher_rfind_in(const CSTL_StringSearcher* searcher, const char* ptr, size_t count);
+
+/**
+ * Count the non-overlapping occurences of the searcher's needle in `instance`.
+ * 
+ * An empty needle occurs at every position, including the end of the string.
+ * 
+ */
+size_t CSTL_string_searcher_count(const CSTL_StringSearcher* searcher, CSTL_StringCRef instance);
+
+/**
+ * Count the non-overlapping occurences of the searcher's needle
+ * in the first `count` characters at `ptr`.
+ * 
+ * An empty needle occurs at every position, including the end of the range.
+ * 
+ */
+size_t CSTL_string_searcher_count_in(const CSTL_StringSearcher* searcher, const char* ptr, size_t count);
+
+/**
+ * Find the non-overlapping occurences of the searcher's needle in `instance`
+ * and store up to `capacity` of their positions, in order, to `positions`.
+ * 
+ * Returns the total number of occurences, which may be greater than `capacity`.
+ * Call with `capacity == 0` to only count them.
+ * 
+ */
+size_t CSTL_string_searcher_find_all(const CSTL_StringSearcher* searcher, CSTL_StringCRef instance, size_t* positions, size_t capacity);
+
+/**
+ * Find the non-overlapping occurences of the searcher's needle in the first `count`
+ * characters at `ptr` and store up to `capacity` of their positions, in order, to `positions`.
+ * 
+ * Returns the total number of occurences, which may be greater than `capacity`.
+ * Call with `capacity == 0` to only count them.
+ * 
+ */
+size_t CSTL_string_searcher_find_all_in(const CSTL_StringSearcher* searcher, const char* ptr, size_t count, size_t* positions, size_t capacity);
+
 /**
  * Compare two null-terminated character sequences.
  * 
@@ -827,3 +1093,346 @@ int CSTL_string_compare_n(const char* left, const char* right, size_t right_coun
  * 
  */
 int CSTL_string_compare_nn(const char* left, size_t left_count, const char* right, size_t right_count);
+
+/**
+ * Hash the first `count` characters at `ptr`.
+ * 
+ * Matches MSVC's `std::hash` of the equivalent `std::basic_string` bit for bit:
+ * FNV-1a over the bytes of the characters, with the 64-bit parameters where
+ * `size_t` is 64 bits wide and the 32-bit ones otherwise.
+ * 
+ */
+size_t CSTL_string_hash_n(const char* ptr, size_t count);
+
+/**
+ * Hash the string `instance`, as if by `CSTL_string_hash_n`.
+ * 
+ */
+size_t CSTL_string_hash(CSTL_StringCRef instance);
+
+/**
+ * Hash the first `count` characters at `ptr` several times faster than
+ * `CSTL_string_hash_n`, 16 bytes per 128-bit multiply and longer strings
+ * with SIMD.
+ * 
+ * The result does not match `std::hash` and may change between versions,
+ * so only use it for tables that never leave this library.
+ * 
+ */
+size_t CSTL_string_fast_hash_n(const char* ptr, size_t count);
+
+/**
+ * Hash the string `instance`, as if by `CSTL_string_fast_hash_n`.
+ * 
+ */
+size_t CSTL_string_fast_hash(CSTL_StringCRef instance);
+
+/**
+ * Ready-made tables for hash containers with `CSTL_StringVal` keys,
+ * which compare the contents of the strings for equality.
+ * 
+ * `CSTL_string_hash_type` hashes with `CSTL_string_hash`, like `std::hash`,
+ * and `CSTL_string_fast_hash_type` with `CSTL_string_fast_hash`.
+ * 
+ */
+extern const CSTL_HashType CSTL_string_hash_type;
+extern const CSTL_HashType CSTL_string_fast_hash_type;
+
+/**
+ * STL ABI `std::basic_string_view` layout.
+ * 
+ * A view refers to `size` characters at `data` without owning them,
+ * so the characters must outlive the view. Views are passed by value.
+ * 
+ */
+typedef struct CSTL_StringView {
+    const char* data;
+    size_t size;
+} CSTL_StringView;
+
+/**
+ * Returns a view of the null-terminated string at `ptr`, without the null terminator.
+ * 
+ */
+CSTL_StringView CSTL_string_view(const char* ptr);
+
+/**
+ * Returns a view of the first `count` characters at `ptr`.
+ * 
+ */
+CSTL_StringView CSTL_string_view_n(const char* ptr, size_t count);
+
+/**
+ * Returns a view of the contents of `instance`.
+ * 
+ * The view is invalidated by any operation that invalidates iterators to `instance`.
+ * 
+ */
+CSTL_StringView CSTL_string_as_view(CSTL_StringCRef instance);
+
+/**
+ * Replaces the contents of `instance` with the characters of `view`,
+ * which may refer to `instance` itself.
+ * 
+ * If the size of `view` is greater than `CSTL_string_max_size()` this function
+ * has no effect and returns `false`, otherwise it returns `true`.
+ * 
+ */
+bool CSTL_string_assign_view(CSTL_StringRef instance, CSTL_StringView view, CSTL_Alloc* alloc);
+
+/**
+ * Appends the characters of `view` to `instance`.
+ * 
+ * If the length of the resulting string is greater than `CSTL_string_max_size()`
+ * this function has no effect and returns `false`, otherwise it returns `true`.
+ * 
+ */
+bool CSTL_string_append_view(CSTL_StringRef instance, CSTL_StringView view, CSTL_Alloc* alloc);
+
+/**
+ * Returns a pointer to the character at `pos` in `view`.
+ * 
+ * If `pos` is outside of the range `[0, view.size)` `NULL` is returned.
+ * 
+ */
+const char* CSTL_string_view_at(CSTL_StringView view, size_t pos);
+
+/**
+ * Shrinks the view pointed to by `view` by moving its start forward by `count` characters.
+ * 
+ * `count` must not be greater than the size of the view.
+ * 
+ */
+void CSTL_string_view_remove_prefix(CSTL_StringView* view, size_t count);
+
+/**
+ * Shrinks the view pointed to by `view` by moving its end backward by `count` characters.
+ * 
+ * `count` must not be greater than the size of the view.
+ * 
+ */
+void CSTL_string_view_remove_suffix(CSTL_StringView* view, size_t count);
+
+/**
+ * Stores the view of the substring at offset `off` in `view` with the length
+ * given by `count` to `new_view`, without copying any characters.
+ * 
+ * If `off` is outside of the range `[0, view.size]` returns `false` and does nothing,
+ * otherwise it returns `true`.
+ * 
+ */
+bool CSTL_string_view_substr(CSTL_StringView* new_view, CSTL_StringView view, size_t off, size_t count);
+
+/**
+ * Copies a substring `[off, off + count)` of `view` to the character string pointed to by
+ * `dest`. The resulting character string is not null terminated.
+ * 
+ * Returns the number of characters copied or `CSTL_string_npos` if
+ * `off > view.size` (out of range).
+ * 
+ */
+size_t CSTL_string_view_copy(CSTL_StringView view, char* dest, size_t count, size_t off);
+
+/**
+ * Compare two views.
+ * 
+ * The return value is negative if `left` compares less than `right`,
+ * positive if it compares greater and zero if `left` and `right`
+ * compare equal.
+ * 
+ */
+int CSTL_string_view_compare(CSTL_StringView left, CSTL_StringView right);
+
+/**
+ * Returns whether two views refer to equal character sequences.
+ * 
+ * Views of different sizes are told apart without comparing any characters.
+ * 
+ */
+bool CSTL_string_view_equal(CSTL_StringView left, CSTL_StringView right);
+
+/**
+ * Returns whether `view` starts with the characters of `prefix`.
+ * 
+ */
+bool CSTL_string_view_starts_with(CSTL_StringView view, CSTL_StringView prefix);
+
+/**
+ * Returns whether `view` ends with the characters of `suffix`.
+ * 
+ */
+bool CSTL_string_view_ends_with(CSTL_StringView view, CSTL_StringView suffix);
+
+/**
+ * Find the first from offset `off` substring of `view` equal to `needle`
+ * and return its position from the start of the view.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_view_find(CSTL_StringView view, CSTL_StringView needle, size_t off);
+
+/**
+ * Find the first from offset `off` occurence of the character `ch` in `view`
+ * and return its position from the start of the view.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_view_find_char(CSTL_StringView view, char ch, size_t off);
+
+/**
+ * Find the last before offset `off` substring of `view` equal to `needle`
+ * and return its position from the start of the view.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_view_rfind(CSTL_StringView view, CSTL_StringView needle, size_t off);
+
+/**
+ * Find the last before offset `off` occurence of the character `ch` in `view`
+ * and return its position from the start of the view.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_view_rfind_char(CSTL_StringView view, char ch, size_t off);
+
+/**
+ * Find the first from offset `off` character of `view` equal to any of the characters
+ * in `set` and return its position from the start of the view.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_view_find_first_of(CSTL_StringView view, CSTL_StringView set, size_t off);
+
+/**
+ * Find the last before offset `off` character of `view` equal to any of the characters
+ * in `set` and return its position from the start of the view.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_view_find_last_of(CSTL_StringView view, CSTL_StringView set, size_t off);
+
+/**
+ * Find the first from offset `off` character of `view` equal to none of the characters
+ * in `set` and return its position from the start of the view.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_view_find_first_not_of(CSTL_StringView view, CSTL_StringView set, size_t off);
+
+/**
+ * Find the first from offset `off` character of `view` not equal to `ch`
+ * and return its position from the start of the view.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_view_find_first_not_of_char(CSTL_StringView view, char ch, size_t off);
+
+/**
+ * Find the last before offset `off` character of `view` equal to none of the characters
+ * in `set` and return its position from the start of the view.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_view_find_last_not_of(CSTL_StringView view, CSTL_StringView set, size_t off);
+
+/**
+ * Find the last before offset `off` character of `view` not equal to `ch`
+ * and return its position from the start of the view.
+ * 
+ * If no match is found `CSTL_string_npos` is returned.
+ * 
+ */
+size_t CSTL_string_view_find_last_not_of_char(CSTL_StringView view, char ch, size_t off);
+
+/**
+ * Hash the characters of `view`, as if by `CSTL_string_hash_n`,
+ * which matches MSVC's `std::hash` of the equivalent `std::basic_string_view`.
+ * 
+ */
+size_t CSTL_string_view_hash(CSTL_StringView view);
+
+/**
+ * Hash the characters of `view`, as if by `CSTL_string_fast_hash_n`.
+ * 
+ */
+size_t CSTL_string_view_fast_hash(CSTL_StringView view);
+
+/**
+ * Iterator over the fields of a view separated by a delimiter, which is
+ * a character, any character of a set or a substring.
+ * 
+ * Fields are returned as views into the original characters, so splitting
+ * never allocates. Delimiters are located with the vectorised searches
+ * behind `CSTL_string_find_char`, `CSTL_string_find_first_of` and `CSTL_string_find`.
+ * 
+ * Like the view it splits, the iterator borrows the characters and the delimiters,
+ * which must outlive it. There is nothing to destroy.
+ * 
+ * Do not manipulate the members directly, use the associated functions!
+ * 
+ */
+typedef struct CSTL_StringSplit {
+    CSTL_StringView rest;  // characters not split yet
+    CSTL_StringView delim; // set or substring
+    char ch;
+    unsigned char mode;      // character, set or substring
+    bool skip_empty;
+    bool done;
+} CSTL_StringSplit;
+
+/**
+ * Prepares `new_split` for splitting `view` on every occurrence of the character `delim`.
+ * 
+ * Adjacent delimiters and delimiters at either end delimit empty fields,
+ * which are skipped if `skip_empty` is `true`. An empty view has one empty field.
+ * 
+ * To split a `CSTL_StringVal`, pass `CSTL_string_as_view(instance)`.
+ * 
+ */
+void CSTL_string_split_init(CSTL_StringSplit* new_split, CSTL_StringView view, char delim, bool skip_empty);
+
+/**
+ * Prepares `new_split` for splitting `view` on every character that is
+ * also in `set`, as if by `CSTL_string_split_init`.
+ * 
+ * An empty `set` matches nothing, so the whole view is one field.
+ * 
+ */
+void CSTL_string_split_init_any_of(CSTL_StringSplit* new_split, CSTL_StringView view, CSTL_StringView set, bool skip_empty);
+
+/**
+ * Prepares `new_split` for splitting `view` on every non-overlapping
+ * occurrence of the substring `delim`, as if by `CSTL_string_split_init`.
+ * 
+ * An empty `delim` matches nothing, so the whole view is one field.
+ * 
+ */
+void CSTL_string_split_init_str(CSTL_StringSplit* new_split, CSTL_StringView view, CSTL_StringView delim, bool skip_empty);
+
+/**
+ * Stores the next field of `split` to `field` and returns `true`,
+ * or returns `false` if all fields have been returned.
+ * 
+ */
+bool CSTL_string_split_next(CSTL_StringSplit* split, CSTL_StringView* field);
+
+/**
+ * Appends the remaining fields of `split` to `vector`, a vector of `CSTL_StringView`
+ * with the type `CSTL_pod_type(sizeof(CSTL_StringView), alignof(CSTL_StringView))`.
+ * 
+ * The fields are counted first, so the vector is reserved at most once.
+ * 
+ * If the vector would become too long or the allocation fails, this function
+ * has no effect and returns `false`, otherwise it returns `true`.
+ * 
+ */
+bool CSTL_string_split_into_vector(CSTL_StringSplit* split, CSTL_VectorRef vector, CSTL_Alloc* alloc);
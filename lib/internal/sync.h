@@ -0,0 +1,199 @@
+#pragma once
+
+#ifndef CSTL_SYNC_H
+#define CSTL_SYNC_H
+
+/*
+ * Private synchronisation helpers: thread-local storage, spin locks,
+ * and thin wrappers over the platform threads, mutexes and condition variables.
+ * 
+ */
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define CSTL_thread_local __declspec(thread)
+#else
+#define CSTL_thread_local _Thread_local
+#endif
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_IX86)
+#include <emmintrin.h>
+#define CSTL_cpu_relax() _mm_pause()
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+#define CSTL_cpu_relax() __asm__ __volatile__("yield")
+#else
+#define CSTL_cpu_relax() ((void)0)
+#endif
+
+static inline void CSTL_thread_yield(void) {
+#if defined(_WIN32)
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+/**
+ * Test and test-and-set lock for short critical sections.
+ * 
+ * Zero-initialized means unlocked.
+ * 
+ */
+typedef struct CSTL_SpinLock {
+    atomic_bool locked;
+} CSTL_SpinLock;
+
+static inline void CSTL_spin_lock(CSTL_SpinLock* lock) {
+    for (unsigned spins = 0;; ++spins) {
+        if (!atomic_exchange_explicit(&lock->locked, true, memory_order_acquire)) {
+            return;
+        }
+
+        while (atomic_load_explicit(&lock->locked, memory_order_relaxed)) {
+            if (spins++ < 64) {
+                CSTL_cpu_relax();
+            } else {
+                CSTL_thread_yield();
+            }
+        }
+    }
+}
+
+static inline void CSTL_spin_unlock(CSTL_SpinLock* lock) {
+    atomic_store_explicit(&lock->locked, false, memory_order_release);
+}
+
+#if defined(_WIN32)
+typedef HANDLE CSTL_Thread;
+typedef SRWLOCK CSTL_Mutex;
+typedef CONDITION_VARIABLE CSTL_CondVar;
+typedef DWORD(WINAPI* CSTL_ThreadProc)(LPVOID);
+
+#define CSTL_thread_proc(name, param) static DWORD WINAPI name(LPVOID param)
+#define CSTL_thread_proc_return       return 0
+
+static inline bool CSTL_thread_start(CSTL_Thread* thread, CSTL_ThreadProc proc, void* param) {
+    *thread = CreateThread(NULL, 0, proc, param, 0, NULL);
+    return *thread != NULL;
+}
+
+static inline void CSTL_thread_join(CSTL_Thread thread) {
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+
+// Returns the number of logical processors, at least 1.
+static inline size_t CSTL_hardware_concurrency(void) {
+    DWORD count = GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+    return count != 0 ? (size_t)count : 1;
+}
+
+static inline bool CSTL_mutex_init(CSTL_Mutex* mutex) {
+    InitializeSRWLock(mutex);
+    return true;
+}
+
+static inline void CSTL_mutex_destroy(CSTL_Mutex* mutex) {
+    (void)mutex;
+}
+
+static inline void CSTL_mutex_lock(CSTL_Mutex* mutex) {
+    AcquireSRWLockExclusive(mutex);
+}
+
+static inline void CSTL_mutex_unlock(CSTL_Mutex* mutex) {
+    ReleaseSRWLockExclusive(mutex);
+}
+
+static inline bool CSTL_cond_init(CSTL_CondVar* cond) {
+    InitializeConditionVariable(cond);
+    return true;
+}
+
+static inline void CSTL_cond_destroy(CSTL_CondVar* cond) {
+    (void)cond;
+}
+
+static inline void CSTL_cond_wait(CSTL_CondVar* cond, CSTL_Mutex* mutex) {
+    SleepConditionVariableSRW(cond, mutex, INFINITE, 0);
+}
+
+static inline void CSTL_cond_signal(CSTL_CondVar* cond) {
+    WakeConditionVariable(cond);
+}
+
+static inline void CSTL_cond_broadcast(CSTL_CondVar* cond) {
+    WakeAllConditionVariable(cond);
+}
+#else
+typedef pthread_t CSTL_Thread;
+typedef pthread_mutex_t CSTL_Mutex;
+typedef pthread_cond_t CSTL_CondVar;
+typedef void* (*CSTL_ThreadProc)(void*);
+
+#define CSTL_thread_proc(name, param) static void* name(void* param)
+#define CSTL_thread_proc_return       return NULL
+
+static inline bool CSTL_thread_start(CSTL_Thread* thread, CSTL_ThreadProc proc, void* param) {
+    return pthread_create(thread, NULL, proc, param) == 0;
+}
+
+static inline void CSTL_thread_join(CSTL_Thread thread) {
+    pthread_join(thread, NULL);
+}
+
+// Returns the number of logical processors, at least 1.
+static inline size_t CSTL_hardware_concurrency(void) {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (size_t)count : 1;
+}
+
+static inline bool CSTL_mutex_init(CSTL_Mutex* mutex) {
+    return pthread_mutex_init(mutex, NULL) == 0;
+}
+
+static inline void CSTL_mutex_destroy(CSTL_Mutex* mutex) {
+    pthread_mutex_destroy(mutex);
+}
+
+static inline void CSTL_mutex_lock(CSTL_Mutex* mutex) {
+    pthread_mutex_lock(mutex);
+}
+
+static inline void CSTL_mutex_unlock(CSTL_Mutex* mutex) {
+    pthread_mutex_unlock(mutex);
+}
+
+static inline bool CSTL_cond_init(CSTL_CondVar* cond) {
+    return pthread_cond_init(cond, NULL) == 0;
+}
+
+static inline void CSTL_cond_destroy(CSTL_CondVar* cond) {
+    pthread_cond_destroy(cond);
+}
+
+static inline void CSTL_cond_wait(CSTL_CondVar* cond, CSTL_Mutex* mutex) {
+    pthread_cond_wait(cond, mutex);
+}
+
+static inline void CSTL_cond_signal(CSTL_CondVar* cond) {
+    pthread_cond_signal(cond);
+}
+
+static inline void CSTL_cond_broadcast(CSTL_CondVar* cond) {
+    pthread_cond_broadcast(cond);
+}
+#endif
+
+#endif
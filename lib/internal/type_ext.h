@@ -5,8 +5,10 @@
 
 #include "../type.h"
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 static inline size_t CSTL_type_alignment(CSTL_Type type) {
     intptr_t packed  = (intptr_t)type;
@@ -26,4 +28,92 @@ static inline size_t CSTL_type_size(CSTL_Type type) {
     }
 }
 
+/**
+ * Whether a move followed by destruction of the source can be replaced
+ * by a bytewise copy.
+ * 
+ */
+static inline bool CSTL_type_is_relocatable(CSTL_MoveTypeCRef move) {
+    return move->move == NULL || move->trivially_relocatable;
+}
+
+/**
+ * Destroy `[first, last)`, unless the type is trivially destructible.
+ * 
+ */
+static inline void CSTL_type_drop(CSTL_DropTypeCRef drop, void* first, void* last) {
+    if (drop->drop != NULL && first != last) {
+        drop->drop(first, last);
+    }
+}
+
+/**
+ * Move `[first, last)` to uninitialized memory at `dest`,
+ * leaving the source objects valid.
+ * 
+ */
+static inline void CSTL_type_move(CSTL_MoveTypeCRef move, void* first, void* last, void* dest) {
+    if (move->move != NULL) {
+        move->move(first, last, dest);
+    } else if (first != last) {
+        memcpy(dest, first, (size_t)((char*)last - (char*)first));
+    }
+}
+
+/**
+ * Move `[first, last)` to uninitialized memory at `dest` and destroy the
+ * source objects, leaving `[first, last)` uninitialized.
+ * 
+ * The ranges may only overlap if the type is relocatable.
+ * 
+ */
+static inline void CSTL_type_relocate(CSTL_MoveTypeCRef move, void* first, void* last, void* dest) {
+    if (CSTL_type_is_relocatable(move)) {
+        if (first != last) {
+            memmove(dest, first, (size_t)((char*)last - (char*)first));
+        }
+    } else {
+        move->move(first, last, dest);
+        CSTL_type_drop(&move->drop_type, first, last);
+    }
+}
+
+/**
+ * Copy `[first, last)` to uninitialized memory at `dest`.
+ * 
+ */
+static inline void CSTL_type_copy(CSTL_CopyTypeCRef copy, const void* first, const void* last, void* dest) {
+    if (copy->copy != NULL) {
+        copy->copy(first, last, dest);
+    } else if (first != last) {
+        memcpy(dest, first, (size_t)((const char*)last - (const char*)first));
+    }
+}
+
+/**
+ * Fill uninitialized memory at `[first, last)` with copies of `value`,
+ * which is `type_size` bytes large and must not be in `[first, last)`.
+ * 
+ */
+static inline void CSTL_type_fill(CSTL_CopyTypeCRef copy, void* first, void* last, const void* value, size_t type_size) {
+    if (copy->fill != NULL) {
+        copy->fill(first, last, value);
+        return;
+    }
+
+    size_t bytes = (size_t)((char*)last - (char*)first);
+
+    if (bytes == 0) {
+        return;
+    }
+
+    memcpy(first, value, type_size);
+
+    // double the filled prefix until the range is full
+    for (size_t filled = type_size; filled < bytes; filled += filled) {
+        size_t chunk = bytes - filled < filled ? bytes - filled : filled;
+        memcpy((char*)first + filled, first, chunk);
+    }
+}
+
 #endif
@@ -0,0 +1,422 @@
+#include "list.h"
+
+#include "internal/alloc_dispatch.h"
+#include "internal/type_ext.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Enough bins to sort any list that fits in memory.
+#define CSTL_list_sort_bins ((size_t)64)
+
+// Offset of the element in a node, as in `std::_List_node`.
+static inline size_t CSTL_list_value_offset(CSTL_Type type) {
+    size_t alignment = CSTL_type_alignment(type);
+    return (sizeof(CSTL_ListNode) + alignment - 1) & ~(alignment - 1);
+}
+
+static inline void* CSTL_list_value(CSTL_ListNode* node, size_t offset) {
+    return (char*)node + offset;
+}
+
+static inline CSTL_ListIter CSTL_list_make_iter(CSTL_ListNode* node, size_t offset) {
+    CSTL_ListIter iterator = { node, offset };
+    return iterator;
+}
+
+static inline void CSTL_list_free_node(CSTL_ListNode* node, CSTL_Type type, CSTL_Alloc* alloc) {
+    CSTL_free(node, CSTL_list_node_size(type), CSTL_list_node_alignment(type), alloc);
+}
+
+// Links `node` before `where`.
+static inline void CSTL_list_link(CSTL_ListRef instance, CSTL_ListNode* where, CSTL_ListNode* node) {
+    CSTL_ListNode* prev = where->prev;
+
+    node->next  = where;
+    node->prev  = prev;
+    prev->next  = node;
+    where->prev = node;
+
+    instance->size += 1;
+}
+
+// Unlinks `node`, which must not be the head, and returns the node following it.
+static inline CSTL_ListNode* CSTL_list_unlink(CSTL_ListRef instance, CSTL_ListNode* node) {
+    CSTL_ListNode* next = node->next;
+
+    node->prev->next = next;
+    next->prev       = node->prev;
+
+    instance->size -= 1;
+
+    return next;
+}
+
+// Relinks `[first, last)` before `where`, like `std::list::_Unchecked_splice`.
+// Does not update the sizes.
+static inline void CSTL_list_transfer(CSTL_ListNode* where, CSTL_ListNode* first, CSTL_ListNode* last) {
+    CSTL_ListNode* first_prev = first->prev;
+    CSTL_ListNode* last_prev  = last->prev;
+    CSTL_ListNode* where_prev = where->prev;
+
+    first_prev->next = last;
+    last->prev       = first_prev;
+    where_prev->next = first;
+    first->prev      = where_prev;
+    last_prev->next  = where;
+    where->prev      = last_prev;
+}
+
+// Stably merges two null-terminated chains linked through `next`.
+static inline CSTL_ListNode* CSTL_list_merge_chains(CSTL_ListNode* lhs, CSTL_ListNode* rhs, size_t offset, CSTL_CompTypeCRef comp) {
+    CSTL_ListNode* first = NULL;
+    CSTL_ListNode** tail = &first;
+
+    while (lhs != NULL && rhs != NULL) {
+        // Take from `rhs` only if strictly less, which keeps the merge stable.
+        if (comp->is_lt(CSTL_list_value(rhs, offset), CSTL_list_value(lhs, offset))) {
+            *tail = rhs;
+            tail  = &rhs->next;
+            rhs   = rhs->next;
+        } else {
+            *tail = lhs;
+            tail  = &lhs->next;
+            lhs   = lhs->next;
+        }
+    }
+
+    *tail = lhs != NULL ? lhs : rhs;
+
+    return first;
+}
+
+// Links the null-terminated chain `first` as the only contents of `head`,
+// restoring the `prev` pointers.
+static inline void CSTL_list_adopt_chain(CSTL_ListNode* head, CSTL_ListNode* first) {
+    CSTL_ListNode* prev = head;
+
+    while (first != NULL) {
+        prev->next  = first;
+        first->prev = prev;
+        prev        = first;
+        first       = first->next;
+    }
+
+    prev->next = head;
+    head->prev = prev;
+}
+
+static CSTL_ListNode* CSTL_list_buy_node(CSTL_Type type, CSTL_Alloc* alloc) {
+    return CSTL_allocate(CSTL_list_node_size(type), CSTL_list_node_alignment(type), alloc);
+}
+
+size_t CSTL_list_node_size(CSTL_Type type) {
+    size_t alignment = CSTL_list_node_alignment(type);
+    size_t size      = CSTL_list_value_offset(type) + CSTL_type_size(type);
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+size_t CSTL_list_node_alignment(CSTL_Type type) {
+    size_t alignment = CSTL_type_alignment(type);
+    return alignment > _Alignof(CSTL_ListNode) ? alignment : _Alignof(CSTL_ListNode);
+}
+
+bool CSTL_list_construct(CSTL_ListVal* new_instance, CSTL_Type type, CSTL_Alloc* alloc) {
+    if (new_instance == NULL) {
+        return false;
+    }
+
+    // The head node is as large as any other, like `std::list::_Buyheadnode`.
+    CSTL_ListNode* head = CSTL_list_buy_node(type, alloc);
+
+    new_instance->head = head;
+    new_instance->size = 0;
+
+    if (head == NULL) {
+        return false;
+    }
+
+    head->next = head;
+    head->prev = head;
+
+    return true;
+}
+
+void CSTL_list_destroy(CSTL_ListRef instance, CSTL_Type type, CSTL_DropTypeCRef drop, CSTL_Alloc* alloc) {
+    if (instance->head == NULL) {
+        return;
+    }
+
+    CSTL_list_clear(instance, type, drop, alloc);
+    CSTL_list_free_node(instance->head, type, alloc);
+
+    instance->head = NULL;
+}
+
+void CSTL_list_clear(CSTL_ListRef instance, CSTL_Type type, CSTL_DropTypeCRef drop, CSTL_Alloc* alloc) {
+    CSTL_ListNode* head = instance->head;
+    CSTL_ListNode* node = head->next;
+    size_t offset       = CSTL_list_value_offset(type);
+    size_t type_size    = CSTL_type_size(type);
+
+    while (node != head) {
+        CSTL_ListNode* next = node->next;
+        char* value         = CSTL_list_value(node, offset);
+
+        CSTL_type_drop(drop, value, value + type_size);
+        CSTL_list_free_node(node, type, alloc);
+
+        node = next;
+    }
+
+    head->next     = head;
+    head->prev     = head;
+    instance->size = 0;
+}
+
+void CSTL_list_swap(CSTL_ListRef instance, CSTL_ListRef other_instance) {
+    CSTL_ListVal temp = *instance;
+    *instance         = *other_instance;
+    *other_instance   = temp;
+}
+
+bool CSTL_list_empty(CSTL_ListCRef instance) {
+    return instance->size == 0;
+}
+
+size_t CSTL_list_size(CSTL_ListCRef instance) {
+    return instance->size;
+}
+
+CSTL_ListIter CSTL_list_begin(CSTL_ListCRef instance, CSTL_Type type) {
+    return CSTL_list_make_iter(instance->head->next, CSTL_list_value_offset(type));
+}
+
+CSTL_ListIter CSTL_list_end(CSTL_ListCRef instance, CSTL_Type type) {
+    return CSTL_list_make_iter(instance->head, CSTL_list_value_offset(type));
+}
+
+CSTL_ListIter CSTL_list_iterator_next(CSTL_ListIter iterator) {
+    iterator.node = iterator.node->next;
+    return iterator;
+}
+
+CSTL_ListIter CSTL_list_iterator_prev(CSTL_ListIter iterator) {
+    iterator.node = iterator.node->prev;
+    return iterator;
+}
+
+void* CSTL_list_iterator_deref(CSTL_ListIter iterator) {
+    return CSTL_list_value(iterator.node, iterator.offset);
+}
+
+bool CSTL_list_iterator_eq(CSTL_ListIter lhs, CSTL_ListIter rhs) {
+    return lhs.node == rhs.node;
+}
+
+void* CSTL_list_front(CSTL_ListRef instance, CSTL_Type type) {
+    return CSTL_list_value(instance->head->next, CSTL_list_value_offset(type));
+}
+
+void* CSTL_list_back(CSTL_ListRef instance, CSTL_Type type) {
+    return CSTL_list_value(instance->head->prev, CSTL_list_value_offset(type));
+}
+
+CSTL_ListIter CSTL_list_copy_insert(CSTL_ListRef instance, CSTL_Type type, CSTL_CopyTypeCRef copy, CSTL_ListIter where, const void* value, CSTL_Alloc* alloc) {
+    size_t offset = CSTL_list_value_offset(type);
+
+    CSTL_ListNode* node = CSTL_list_buy_node(type, alloc);
+
+    if (node == NULL) {
+        return CSTL_list_make_iter(instance->head, offset);
+    }
+
+    CSTL_type_copy(copy, value, (const char*)value + CSTL_type_size(type), CSTL_list_value(node, offset));
+    CSTL_list_link(instance, where.node, node);
+
+    return CSTL_list_make_iter(node, offset);
+}
+
+CSTL_ListIter CSTL_list_move_insert(CSTL_ListRef instance, CSTL_Type type, CSTL_MoveTypeCRef move, CSTL_ListIter where, void* value, CSTL_Alloc* alloc) {
+    size_t offset = CSTL_list_value_offset(type);
+
+    CSTL_ListNode* node = CSTL_list_buy_node(type, alloc);
+
+    if (node == NULL) {
+        return CSTL_list_make_iter(instance->head, offset);
+    }
+
+    CSTL_type_move(move, value, (char*)value + CSTL_type_size(type), CSTL_list_value(node, offset));
+    CSTL_list_link(instance, where.node, node);
+
+    return CSTL_list_make_iter(node, offset);
+}
+
+bool CSTL_list_copy_push_back(CSTL_ListRef instance, CSTL_Type type, CSTL_CopyTypeCRef copy, const void* value, CSTL_Alloc* alloc) {
+    CSTL_ListIter where = CSTL_list_end(instance, type);
+    return !CSTL_list_iterator_eq(CSTL_list_copy_insert(instance, type, copy, where, value, alloc), where);
+}
+
+bool CSTL_list_move_push_back(CSTL_ListRef instance, CSTL_Type type, CSTL_MoveTypeCRef move, void* value, CSTL_Alloc* alloc) {
+    CSTL_ListIter where = CSTL_list_end(instance, type);
+    return !CSTL_list_iterator_eq(CSTL_list_move_insert(instance, type, move, where, value, alloc), where);
+}
+
+bool CSTL_list_copy_push_front(CSTL_ListRef instance, CSTL_Type type, CSTL_CopyTypeCRef copy, const void* value, CSTL_Alloc* alloc) {
+    CSTL_ListIter where = CSTL_list_begin(instance, type);
+    CSTL_ListIter end   = CSTL_list_end(instance, type);
+    return !CSTL_list_iterator_eq(CSTL_list_copy_insert(instance, type, copy, where, value, alloc), end);
+}
+
+bool CSTL_list_move_push_front(CSTL_ListRef instance, CSTL_Type type, CSTL_MoveTypeCRef move, void* value, CSTL_Alloc* alloc) {
+    CSTL_ListIter where = CSTL_list_begin(instance, type);
+    CSTL_ListIter end   = CSTL_list_end(instance, type);
+    return !CSTL_list_iterator_eq(CSTL_list_move_insert(instance, type, move, where, value, alloc), end);
+}
+
+void CSTL_list_pop_back(CSTL_ListRef instance, CSTL_Type type, CSTL_DropTypeCRef drop, CSTL_Alloc* alloc) {
+    CSTL_list_erase(instance, type, drop, CSTL_list_iterator_prev(CSTL_list_end(instance, type)), alloc);
+}
+
+void CSTL_list_pop_front(CSTL_ListRef instance, CSTL_Type type, CSTL_DropTypeCRef drop, CSTL_Alloc* alloc) {
+    CSTL_list_erase(instance, type, drop, CSTL_list_begin(instance, type), alloc);
+}
+
+CSTL_ListIter CSTL_list_erase(CSTL_ListRef instance, CSTL_Type type, CSTL_DropTypeCRef drop, CSTL_ListIter where, CSTL_Alloc* alloc) {
+    CSTL_ListNode* node = where.node;
+    CSTL_ListNode* next = CSTL_list_unlink(instance, node);
+    char* value         = CSTL_list_value(node, where.offset);
+
+    CSTL_type_drop(drop, value, value + CSTL_type_size(type));
+    CSTL_list_free_node(node, type, alloc);
+
+    return CSTL_list_make_iter(next, where.offset);
+}
+
+void CSTL_list_splice(CSTL_ListRef instance, CSTL_ListIter where, CSTL_ListRef other_instance) {
+    if (instance == other_instance || other_instance->size == 0) {
+        return;
+    }
+
+    CSTL_ListNode* other_head = other_instance->head;
+
+    CSTL_list_transfer(where.node, other_head->next, other_head);
+
+    instance->size       += other_instance->size;
+    other_instance->size  = 0;
+}
+
+void CSTL_list_splice_one(CSTL_ListRef instance, CSTL_ListIter where, CSTL_ListRef other_instance, CSTL_ListIter first) {
+    CSTL_ListNode* node = first.node;
+
+    // Already in place.
+    if (node == where.node || node->next == where.node) {
+        return;
+    }
+
+    CSTL_list_transfer(where.node, node, node->next);
+
+    other_instance->size -= 1;
+    instance->size       += 1;
+}
+
+void CSTL_list_splice_range(CSTL_ListRef instance, CSTL_ListIter where, CSTL_ListRef other_instance, CSTL_ListIter first, CSTL_ListIter last) {
+    if (first.node == last.node || where.node == last.node) {
+        return;
+    }
+
+    if (instance != other_instance) {
+        size_t count = 0;
+
+        if (first.node == other_instance->head->next && last.node == other_instance->head) {
+            count = other_instance->size;
+        } else {
+            for (CSTL_ListNode* node = first.node; node != last.node; node = node->next) {
+                ++count;
+            }
+        }
+
+        other_instance->size -= count;
+        instance->size       += count;
+    }
+
+    CSTL_list_transfer(where.node, first.node, last.node);
+}
+
+void CSTL_list_merge(CSTL_ListRef instance, CSTL_ListRef other_instance, CSTL_Type type, CSTL_CompTypeCRef comp) {
+    if (instance == other_instance || other_instance->size == 0) {
+        return;
+    }
+
+    CSTL_ListNode* head       = instance->head;
+    CSTL_ListNode* other_head = other_instance->head;
+
+    // Detach both chains and terminate them, so that the merge only follows `next`.
+    CSTL_ListNode* lhs = head->next;
+    CSTL_ListNode* rhs = other_head->next;
+
+    head->prev->next       = NULL;
+    other_head->prev->next = NULL;
+
+    if (instance->size == 0) {
+        lhs = NULL;
+    }
+
+    CSTL_list_adopt_chain(head, CSTL_list_merge_chains(lhs, rhs, CSTL_list_value_offset(type), comp));
+
+    other_head->next = other_head;
+    other_head->prev = other_head;
+
+    instance->size       += other_instance->size;
+    other_instance->size  = 0;
+}
+
+void CSTL_list_sort(CSTL_ListRef instance, CSTL_Type type, CSTL_CompTypeCRef comp) {
+    if (instance->size < 2) {
+        return;
+    }
+
+    CSTL_ListNode* head = instance->head;
+    size_t offset       = CSTL_list_value_offset(type);
+
+    // Bottom-up merge sort: `bins[i]` holds a sorted run of 2^i nodes or is empty.
+    // Runs in higher bins came first, so they are always the left side of a merge.
+    CSTL_ListNode* bins[CSTL_list_sort_bins] = { NULL };
+    size_t used                              = 0;
+
+    CSTL_ListNode* node = head->next;
+    head->prev->next    = NULL;
+
+    while (node != NULL) {
+        CSTL_ListNode* run = node;
+
+        node      = node->next;
+        run->next = NULL;
+
+        size_t i = 0;
+
+        for (; i < used && bins[i] != NULL; ++i) {
+            run     = CSTL_list_merge_chains(bins[i], run, offset, comp);
+            bins[i] = NULL;
+        }
+
+        if (i == CSTL_list_sort_bins) {
+            --i;
+        }
+
+        bins[i] = run;
+
+        if (i == used) {
+            ++used;
+        }
+    }
+
+    CSTL_ListNode* sorted = NULL;
+
+    for (size_t i = 0; i < used; ++i) {
+        sorted = CSTL_list_merge_chains(bins[i], sorted, offset, comp);
+    }
+
+    CSTL_list_adopt_chain(head, sorted);
+}
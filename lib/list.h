@@ -0,0 +1,314 @@
+#pragma once
+
+#ifndef CSTL_LIST_H
+#define CSTL_LIST_H
+
+#include "alloc.h"
+#include "type.h"
+
+#if defined(__cplusplus)
+#include <cstddef>
+extern "C" {
+#else
+#include <stdbool.h>
+#include <stddef.h>
+#endif
+
+/**
+ * STL ABI `std::_List_node` header, followed by the element.
+ * 
+ */
+typedef struct CSTL_ListNode {
+    struct CSTL_ListNode* next;
+    struct CSTL_ListNode* prev;
+} CSTL_ListNode;
+
+/**
+ * STL ABI `std::list` layout.
+ * 
+ * The list is circular and doubly linked through `head`, a sentinel node
+ * without an element, which is allocated even when the list is empty.
+ * 
+ * Nodes are allocated one at a time with the size and alignment returned
+ * by `CSTL_list_node_size` and `CSTL_list_node_alignment`. Pass the `alloc`
+ * of a `CSTL_NodePool` constructed with them to recycle nodes instead.
+ * 
+ * Does not include the allocator, which nonetheless is a part of the `std::list`
+ * structure! You are responsible for including it, since it can take on any form.
+ * 
+ * Do not manipulate the members directly, use the associated functions!
+ * 
+ */
+typedef struct CSTL_ListVal {
+    CSTL_ListNode* head;
+    size_t size;
+} CSTL_ListVal;
+
+/**
+ * Reference to a mutable `CSTL_ListVal`.
+ * 
+ * Must not be null.
+ * 
+ */
+typedef CSTL_ListVal* CSTL_ListRef;
+
+/**
+ * Reference to a const `CSTL_ListVal`.
+ * 
+ * Must not be null.
+ * 
+ */
+typedef const CSTL_ListVal* CSTL_ListCRef;
+
+/**
+ * A bidirectional iterator over elements of a list.
+ * 
+ * Not ABI-compatible with `std::list::iterator`.
+ * 
+ */
+typedef struct CSTL_ListIter {
+    CSTL_ListNode* node;
+    size_t offset;
+} CSTL_ListIter;
+
+/**
+ * Returns the size of a node holding an element of `type`.
+ * 
+ */
+size_t CSTL_list_node_size(CSTL_Type type);
+
+/**
+ * Returns the alignment of a node holding an element of `type`.
+ * 
+ */
+size_t CSTL_list_node_alignment(CSTL_Type type);
+
+/**
+ * Initializes the list pointed to by `new_instance` as empty.
+ * 
+ * Like its C++ counterpart, an empty list owns a head node, which must be
+ * freed with `CSTL_list_destroy`. Returns `false` if the allocation fails,
+ * in which case nothing needs to be freed.
+ * 
+ */
+bool CSTL_list_construct(CSTL_ListVal* new_instance, CSTL_Type type, CSTL_Alloc* alloc);
+
+/**
+ * Destroys the list pointed to by `instance`, destroying elements
+ * and freeing all nodes.
+ * 
+ */
+void CSTL_list_destroy(CSTL_ListRef instance, CSTL_Type type, CSTL_DropTypeCRef drop, CSTL_Alloc* alloc);
+
+/**
+ * Destroys all elements.
+ * 
+ */
+void CSTL_list_clear(CSTL_ListRef instance, CSTL_Type type, CSTL_DropTypeCRef drop, CSTL_Alloc* alloc);
+
+/**
+ * Swaps the contents of two lists.
+ * 
+ * You are responsible for swapping the allocators outside of `CSTL_ListVal` if applicable.
+ * 
+ */
+void CSTL_list_swap(CSTL_ListRef instance, CSTL_ListRef other_instance);
+
+/**
+ * Returns `true` if the list is empty.
+ * 
+ */
+bool CSTL_list_empty(CSTL_ListCRef instance);
+
+/**
+ * Returns the number of elements in the list.
+ * 
+ */
+size_t CSTL_list_size(CSTL_ListCRef instance);
+
+/**
+ * Returns an iterator to the first element.
+ * 
+ */
+CSTL_ListIter CSTL_list_begin(CSTL_ListCRef instance, CSTL_Type type);
+
+/**
+ * Returns an iterator past the last element.
+ * 
+ */
+CSTL_ListIter CSTL_list_end(CSTL_ListCRef instance, CSTL_Type type);
+
+/**
+ * Advances the iterator to the next element, or the end iterator.
+ * 
+ */
+CSTL_ListIter CSTL_list_iterator_next(CSTL_ListIter iterator);
+
+/**
+ * Moves the iterator to the previous element.
+ * 
+ * The end iterator moves to the last element.
+ * 
+ */
+CSTL_ListIter CSTL_list_iterator_prev(CSTL_ListIter iterator);
+
+/**
+ * Dereferences the iterator at the element it's pointing to.
+ * 
+ * Returns a pointer to the element.
+ * 
+ * `iterator` must be dereferenceable.
+ * 
+ */
+void* CSTL_list_iterator_deref(CSTL_ListIter iterator);
+
+/**
+ * Returns `true` if both iterators point to the same element.
+ * 
+ */
+bool CSTL_list_iterator_eq(CSTL_ListIter lhs, CSTL_ListIter rhs);
+
+/**
+ * Returns a pointer to the first element in the list.
+ * 
+ * If `CSTL_list_empty(instance) == true` the behavior is undefined.
+ * 
+ */
+void* CSTL_list_front(CSTL_ListRef instance, CSTL_Type type);
+
+/**
+ * Returns a pointer to the last element in the list.
+ * 
+ * If `CSTL_list_empty(instance) == true` the behavior is undefined.
+ * 
+ */
+void* CSTL_list_back(CSTL_ListRef instance, CSTL_Type type);
+
+/**
+ * Inserts a copy of `value` into the list before `where` and returns
+ * an iterator to the newly inserted element.
+ * 
+ * If the allocation fails, this function has no effect and returns `CSTL_list_end(instance, ...)`.
+ * 
+ */
+CSTL_ListIter CSTL_list_copy_insert(CSTL_ListRef instance, CSTL_Type type, CSTL_CopyTypeCRef copy, CSTL_ListIter where, const void* value, CSTL_Alloc* alloc);
+
+/**
+ * Inserts `value` into the list before `where` by moving it and returns
+ * an iterator to the newly inserted element.
+ * 
+ * If the allocation fails, this function has no effect and returns `CSTL_list_end(instance, ...)`.
+ * 
+ */
+CSTL_ListIter CSTL_list_move_insert(CSTL_ListRef instance, CSTL_Type type, CSTL_MoveTypeCRef move, CSTL_ListIter where, void* value, CSTL_Alloc* alloc);
+
+/**
+ * Appends a copy of `value` to the end of the list.
+ * 
+ * Returns `false` if the allocation fails, in which case it has no effect.
+ * 
+ */
+bool CSTL_list_copy_push_back(CSTL_ListRef instance, CSTL_Type type, CSTL_CopyTypeCRef copy, const void* value, CSTL_Alloc* alloc);
+
+/**
+ * Appends `value` to the end of the list by moving it.
+ * 
+ * Returns `false` if the allocation fails, in which case it has no effect.
+ * 
+ */
+bool CSTL_list_move_push_back(CSTL_ListRef instance, CSTL_Type type, CSTL_MoveTypeCRef move, void* value, CSTL_Alloc* alloc);
+
+/**
+ * Prepends a copy of `value` to the beginning of the list.
+ * 
+ * Returns `false` if the allocation fails, in which case it has no effect.
+ * 
+ */
+bool CSTL_list_copy_push_front(CSTL_ListRef instance, CSTL_Type type, CSTL_CopyTypeCRef copy, const void* value, CSTL_Alloc* alloc);
+
+/**
+ * Prepends `value` to the beginning of the list by moving it.
+ * 
+ * Returns `false` if the allocation fails, in which case it has no effect.
+ * 
+ */
+bool CSTL_list_move_push_front(CSTL_ListRef instance, CSTL_Type type, CSTL_MoveTypeCRef move, void* value, CSTL_Alloc* alloc);
+
+/**
+ * Removes the last element from the list.
+ * 
+ * If `CSTL_list_empty(instance) == true` the behavior is undefined.
+ * 
+ */
+void CSTL_list_pop_back(CSTL_ListRef instance, CSTL_Type type, CSTL_DropTypeCRef drop, CSTL_Alloc* alloc);
+
+/**
+ * Removes the first element from the list.
+ * 
+ * If `CSTL_list_empty(instance) == true` the behavior is undefined.
+ * 
+ */
+void CSTL_list_pop_front(CSTL_ListRef instance, CSTL_Type type, CSTL_DropTypeCRef drop, CSTL_Alloc* alloc);
+
+/**
+ * Removes the element at `where` and returns an iterator following the
+ * removed element.
+ * 
+ * The iterator `where` must be valid and dereferenceable.
+ * 
+ */
+CSTL_ListIter CSTL_list_erase(CSTL_ListRef instance, CSTL_Type type, CSTL_DropTypeCRef drop, CSTL_ListIter where, CSTL_Alloc* alloc);
+
+/**
+ * Moves all elements of `other_instance` into the list before `where`
+ * in constant time, without copying or moving the elements.
+ * 
+ * Both lists must use compatible allocators and `other_instance` must
+ * not be the same list.
+ * 
+ */
+void CSTL_list_splice(CSTL_ListRef instance, CSTL_ListIter where, CSTL_ListRef other_instance);
+
+/**
+ * Moves the element at `first` from `other_instance` into the list before `where`
+ * in constant time, without copying or moving the element.
+ * 
+ * `other_instance` may be the same list. Both lists must use compatible allocators.
+ * 
+ */
+void CSTL_list_splice_one(CSTL_ListRef instance, CSTL_ListIter where, CSTL_ListRef other_instance, CSTL_ListIter first);
+
+/**
+ * Moves the elements in the range `[first, last)` from `other_instance` into the list
+ * before `where`, without copying or moving the elements.
+ * 
+ * Takes constant time if `other_instance` is the same list or the range spans all of it,
+ * otherwise the elements are counted. `where` must not be in the range.
+ * Both lists must use compatible allocators.
+ * 
+ */
+void CSTL_list_splice_range(CSTL_ListRef instance, CSTL_ListIter where, CSTL_ListRef other_instance, CSTL_ListIter first, CSTL_ListIter last);
+
+/**
+ * Merges the elements of `other_instance` into the list by relinking nodes.
+ * 
+ * Both lists must be sorted in ascending order according to `comp->is_lt`.
+ * The merge is stable: equivalent elements of the list precede those of
+ * `other_instance`, and keep their relative order. `other_instance` is left empty.
+ * 
+ */
+void CSTL_list_merge(CSTL_ListRef instance, CSTL_ListRef other_instance, CSTL_Type type, CSTL_CompTypeCRef comp);
+
+/**
+ * Sorts the list in ascending order according to `comp->is_lt` in O(n log n) time.
+ * 
+ * The sort is stable and only relinks nodes, never allocating, copying or moving elements.
+ * 
+ */
+void CSTL_list_sort(CSTL_ListRef instance, CSTL_Type type, CSTL_CompTypeCRef comp);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
@@ -0,0 +1,250 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // mremap
+#endif
+
+#include "mmap_alloc.h"
+
+#include "internal/alloc_dispatch.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#define CSTL_mmap_supported 1
+#elif defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define CSTL_mmap_supported 1
+#else
+#define CSTL_mmap_supported 0
+#endif
+
+#define CSTL_mmap_default_threshold ((size_t)256 * 1024)
+#define CSTL_mmap_huge_size         ((size_t)2 * 1024 * 1024)
+
+static size_t CSTL_mmap_query_page_size(void) {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (size_t)info.dwPageSize;
+#elif CSTL_mmap_supported
+    long page_size = sysconf(_SC_PAGESIZE);
+    return page_size > 0 ? (size_t)page_size : 4096;
+#else
+    return 4096;
+#endif
+}
+
+// Size of the mapping of a block, `size` must be mapped.
+static inline size_t CSTL_mmap_bytes(const CSTL_MmapAlloc* alloc, size_t size) {
+    return (size + (alloc->page_size - 1)) & ~(alloc->page_size - 1);
+}
+
+// Marks a mapping of `bytes` bytes for huge pages once it is large enough.
+static inline void CSTL_mmap_advise(const CSTL_MmapAlloc* alloc, void* mapping, size_t bytes) {
+#if CSTL_mmap_supported && defined(MADV_HUGEPAGE)
+    if (alloc->huge_pages && bytes >= CSTL_mmap_huge_size) {
+        madvise(mapping, bytes, MADV_HUGEPAGE);
+    }
+#else
+    (void)alloc, (void)mapping, (void)bytes;
+#endif
+}
+
+// `bytes` is a multiple of the page size.
+static void* CSTL_mmap_map(const CSTL_MmapAlloc* alloc, size_t bytes) {
+#if defined(_WIN32)
+    (void)alloc;
+    return VirtualAlloc(NULL, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#elif CSTL_mmap_supported
+    bool huge = alloc->huge_pages && bytes >= CSTL_mmap_huge_size;
+
+    // Over-map to be able to trim the mapping to a huge page boundary.
+    size_t extra = huge ? CSTL_mmap_huge_size - alloc->page_size : 0;
+
+    char* mapping = mmap(NULL, bytes + extra, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (mapping == MAP_FAILED) {
+        return NULL;
+    }
+
+    if (huge) {
+        uintptr_t address = ((uintptr_t)mapping + (CSTL_mmap_huge_size - 1)) & ~(uintptr_t)(CSTL_mmap_huge_size - 1);
+
+        char* first = (char*)address;
+        size_t head = (size_t)(first - mapping);
+
+        if (head != 0) {
+            munmap(mapping, head);
+        }
+
+        if (extra != head) {
+            munmap(first + bytes, extra - head);
+        }
+
+        mapping = first;
+
+        CSTL_mmap_advise(alloc, mapping, bytes);
+    }
+
+    return mapping;
+#else
+    (void)alloc, (void)bytes;
+    return NULL;
+#endif
+}
+
+static void CSTL_mmap_unmap(void* memory, size_t bytes) {
+#if defined(_WIN32)
+    (void)bytes;
+    VirtualFree(memory, 0, MEM_RELEASE);
+#elif CSTL_mmap_supported
+    munmap(memory, bytes);
+#else
+    (void)memory, (void)bytes;
+#endif
+}
+
+bool CSTL_mmap_alloc_is_mapped(const CSTL_MmapAlloc* alloc, size_t size, size_t alignment) {
+    return CSTL_mmap_supported && size >= alloc->threshold && alignment <= alloc->page_size
+        && size <= SIZE_MAX - CSTL_mmap_huge_size;
+}
+
+void* CSTL_mmap_alloc_allocate(CSTL_MmapAlloc* alloc, size_t size, size_t alignment) {
+    if (!CSTL_mmap_alloc_is_mapped(alloc, size, alignment)) {
+        return CSTL_allocate(size, alignment, alloc->fallback);
+    }
+
+    return CSTL_mmap_map(alloc, CSTL_mmap_bytes(alloc, size));
+}
+
+void CSTL_mmap_alloc_free(CSTL_MmapAlloc* alloc, void* memory, size_t size, size_t alignment) {
+    if (memory == NULL) {
+        return;
+    }
+
+    if (!CSTL_mmap_alloc_is_mapped(alloc, size, alignment)) {
+        CSTL_free(memory, size, alignment, alloc->fallback);
+        return;
+    }
+
+    CSTL_mmap_unmap(memory, CSTL_mmap_bytes(alloc, size));
+}
+
+static void* CSTL_mmap_aligned_alloc(void* opaque, size_t size, size_t alignment) {
+    return CSTL_mmap_alloc_allocate((CSTL_MmapAlloc*)opaque, size, alignment);
+}
+
+static void CSTL_mmap_aligned_free(void* opaque, void* memory, size_t size, size_t alignment) {
+    CSTL_mmap_alloc_free((CSTL_MmapAlloc*)opaque, memory, size, alignment);
+}
+
+static bool CSTL_mmap_try_expand(void* opaque, void* memory, size_t old_size, size_t new_size, size_t alignment) {
+    CSTL_MmapAlloc* alloc = (CSTL_MmapAlloc*)opaque;
+
+    bool old_mapped = CSTL_mmap_alloc_is_mapped(alloc, old_size, alignment);
+    bool new_mapped = CSTL_mmap_alloc_is_mapped(alloc, new_size, alignment);
+
+    if (!old_mapped && !new_mapped) {
+        return CSTL_try_expand(memory, old_size, new_size, alignment, alloc->fallback);
+    }
+
+    if (!old_mapped || !new_mapped || new_size < old_size) {
+        return false;
+    }
+
+    size_t old_bytes = CSTL_mmap_bytes(alloc, old_size);
+    size_t new_bytes = CSTL_mmap_bytes(alloc, new_size);
+
+    if (old_bytes == new_bytes) {
+        return true; // the last page has room
+    }
+
+#if defined(__linux__)
+    if (mremap(memory, old_bytes, new_bytes, 0) == MAP_FAILED) {
+        return false;
+    }
+
+    // Blocks that grow past 2 MiB get huge pages like blocks allocated that large.
+    CSTL_mmap_advise(alloc, memory, new_bytes);
+    return true;
+#else
+    return false;
+#endif
+}
+
+static void* CSTL_mmap_reallocate(void* opaque, void* memory, size_t old_size, size_t new_size, size_t alignment) {
+    CSTL_MmapAlloc* alloc = (CSTL_MmapAlloc*)opaque;
+
+    bool old_mapped = CSTL_mmap_alloc_is_mapped(alloc, old_size, alignment);
+    bool new_mapped = CSTL_mmap_alloc_is_mapped(alloc, new_size, alignment);
+
+    if (!old_mapped && !new_mapped) {
+        return CSTL_reallocate(memory, old_size, new_size, alignment, alloc->fallback);
+    }
+
+#if defined(__linux__)
+    // Moves the pages instead of their contents.
+    if (old_mapped && new_mapped) {
+        size_t old_bytes = CSTL_mmap_bytes(alloc, old_size);
+        size_t new_bytes = CSTL_mmap_bytes(alloc, new_size);
+
+        // Moves huge page mappings onto an aligned destination, which the move replaces.
+        if (alloc->huge_pages && new_bytes >= CSTL_mmap_huge_size && new_bytes > old_bytes) {
+            void* dest = CSTL_mmap_map(alloc, new_bytes);
+
+            if (dest != NULL) {
+                void* new_memory = mremap(memory, old_bytes, new_bytes, MREMAP_MAYMOVE | MREMAP_FIXED, dest);
+
+                if (new_memory != MAP_FAILED) {
+                    CSTL_mmap_advise(alloc, new_memory, new_bytes);
+                    return new_memory;
+                }
+
+                CSTL_mmap_unmap(dest, new_bytes);
+            }
+        }
+
+        void* new_memory = mremap(memory, old_bytes, new_bytes, MREMAP_MAYMOVE);
+
+        if (new_memory == MAP_FAILED) {
+            return NULL;
+        }
+
+        CSTL_mmap_advise(alloc, new_memory, new_bytes);
+        return new_memory;
+    }
+#endif
+
+    void* new_memory = CSTL_mmap_alloc_allocate(alloc, new_size, alignment);
+
+    if (new_memory == NULL) {
+        return NULL;
+    }
+
+    memcpy(new_memory, memory, old_size < new_size ? old_size : new_size);
+
+    CSTL_mmap_alloc_free(alloc, memory, old_size, alignment);
+
+    return new_memory;
+}
+
+void CSTL_mmap_alloc_construct(CSTL_MmapAlloc* new_alloc, size_t threshold, bool huge_pages, CSTL_Alloc* fallback) {
+    if (new_alloc == NULL) {
+        return;
+    }
+
+    new_alloc->alloc.opaque        = new_alloc;
+    new_alloc->alloc.aligned_alloc = &CSTL_mmap_aligned_alloc;
+    new_alloc->alloc.aligned_free  = &CSTL_mmap_aligned_free;
+    new_alloc->alloc.try_expand    = &CSTL_mmap_try_expand;
+    new_alloc->alloc.reallocate    = &CSTL_mmap_reallocate;
+
+    new_alloc->fallback   = fallback;
+    new_alloc->threshold  = threshold != 0 ? threshold : CSTL_mmap_default_threshold;
+    new_alloc->page_size  = CSTL_mmap_query_page_size();
+    new_alloc->huge_pages = huge_pages;
+}
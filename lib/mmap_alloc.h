@@ -0,0 +1,85 @@
+#pragma once
+
+#ifndef CSTL_MMAP_ALLOC_H
+#define CSTL_MMAP_ALLOC_H
+
+#include "alloc.h"
+
+#if defined(__cplusplus)
+#include <cstddef>
+extern "C" {
+#else
+#include <stdbool.h>
+#include <stddef.h>
+#endif
+
+/**
+ * Allocator that maps very large blocks directly from the operating system.
+ * 
+ * Blocks of at least `threshold` bytes get their own page-aligned mapping
+ * (`mmap` or `VirtualAlloc`), smaller ones are passed on to the fallback
+ * allocator. With huge pages enabled, mappings of at least 2 MiB are aligned
+ * to 2 MiB and marked with `MADV_HUGEPAGE` where available, which reduces TLB
+ * misses when scanning large containers.
+ * 
+ * On Linux mapped blocks grow with `mremap`, either in place or by remapping
+ * their pages, so vectors of trivially relocatable types and strings never
+ * copy their contents when they grow. Blocks that grow past 2 MiB get huge
+ * pages as well, and are remapped onto 2 MiB aligned addresses when they move.
+ * 
+ * Containers use the allocator through `alloc`, which can be passed to every
+ * function taking a `CSTL_Alloc*`. It must not be moved or copied after
+ * construction, as `alloc` refers to it.
+ * 
+ * Thread-safe if the fallback allocator is.
+ * 
+ * Do not manipulate the members directly, use the associated functions!
+ * 
+ */
+typedef struct CSTL_MmapAlloc {
+    CSTL_Alloc alloc;
+    CSTL_Alloc* fallback;
+    size_t threshold;
+    size_t page_size;
+    bool huge_pages;
+} CSTL_MmapAlloc;
+
+/**
+ * Initializes the allocator pointed to by `new_alloc`.
+ * 
+ * Blocks smaller than `threshold` bytes (a default of 256 KiB is used
+ * if it is 0) are obtained from `fallback`, or the default allocator
+ * if it is `NULL`. Blocks aligned to more than a page always are.
+ * 
+ * If `huge_pages` is true, large mappings are backed by huge pages
+ * where the system allows it.
+ * 
+ */
+void CSTL_mmap_alloc_construct(CSTL_MmapAlloc* new_alloc, size_t threshold, bool huge_pages, CSTL_Alloc* fallback);
+
+/**
+ * Allocates `size` bytes aligned to `alignment`, which must be a power of 2.
+ * 
+ * Returns `NULL` if out of memory.
+ * 
+ */
+void* CSTL_mmap_alloc_allocate(CSTL_MmapAlloc* alloc, size_t size, size_t alignment);
+
+/**
+ * Frees a block allocated by `CSTL_mmap_alloc_allocate` with the same `size` and `alignment`.
+ * 
+ */
+void CSTL_mmap_alloc_free(CSTL_MmapAlloc* alloc, void* memory, size_t size, size_t alignment);
+
+/**
+ * Returns true if a block of `size` bytes aligned to `alignment` is mapped
+ * directly, rather than obtained from the fallback allocator.
+ * 
+ */
+bool CSTL_mmap_alloc_is_mapped(const CSTL_MmapAlloc* alloc, size_t size, size_t alignment);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
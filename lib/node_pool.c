@@ -0,0 +1,181 @@
+#include "node_pool.h"
+
+#include "internal/alloc_dispatch.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define CSTL_node_pool_min_chunk_nodes ((size_t)32)
+#define CSTL_node_pool_max_chunk_nodes ((size_t)4096)
+
+struct CSTL_NodePoolChunk {
+    CSTL_NodePoolChunk* next;
+    size_t size; // including the header
+};
+
+// Free nodes are linked through their first bytes.
+typedef struct CSTL_NodePoolFree {
+    struct CSTL_NodePoolFree* next;
+} CSTL_NodePoolFree;
+
+static inline size_t CSTL_node_pool_chunk_alignment(const CSTL_NodePool* pool) {
+    return pool->node_alignment > _Alignof(CSTL_NodePoolChunk) ? pool->node_alignment : _Alignof(CSTL_NodePoolChunk);
+}
+
+static inline size_t CSTL_node_pool_header(const CSTL_NodePool* pool) {
+    return (sizeof(CSTL_NodePoolChunk) + pool->node_alignment - 1) & ~(pool->node_alignment - 1);
+}
+
+static inline bool CSTL_node_pool_fits(const CSTL_NodePool* pool, size_t size, size_t alignment) {
+    return size <= pool->node_size && alignment <= pool->node_alignment;
+}
+
+// Obtains a chunk of at least `count` nodes and pushes them onto the free list.
+static bool CSTL_node_pool_grow(CSTL_NodePool* pool, size_t count) {
+    size_t header = CSTL_node_pool_header(pool);
+
+    if (count > (SIZE_MAX - header) / pool->node_size) {
+        return false;
+    }
+
+    size_t bytes = header + count * pool->node_size;
+
+    CSTL_NodePoolChunk* chunk = CSTL_allocate(bytes, CSTL_node_pool_chunk_alignment(pool), pool->upstream);
+
+    if (chunk == NULL) {
+        return false;
+    }
+
+    chunk->next  = pool->chunks;
+    chunk->size  = bytes;
+    pool->chunks = chunk;
+
+    // Push in reverse, so that nodes are handed out in address order.
+    char* first = (char*)chunk + header;
+
+    for (size_t i = count; i > 0; --i) {
+        CSTL_NodePoolFree* node = (CSTL_NodePoolFree*)(first + (i - 1) * pool->node_size);
+
+        node->next      = pool->free_list;
+        pool->free_list = node;
+    }
+
+    pool->reserved += count;
+
+    return true;
+}
+
+static void* CSTL_node_pool_aligned_alloc(void* opaque, size_t size, size_t alignment) {
+    return CSTL_node_pool_allocate((CSTL_NodePool*)opaque, size, alignment);
+}
+
+static void CSTL_node_pool_aligned_free(void* opaque, void* memory, size_t size, size_t alignment) {
+    CSTL_node_pool_free((CSTL_NodePool*)opaque, memory, size, alignment);
+}
+
+void CSTL_node_pool_construct(CSTL_NodePool* new_pool, size_t node_size, size_t node_alignment, CSTL_Alloc* upstream) {
+    if (new_pool == NULL) {
+        return;
+    }
+
+    assert(node_alignment != 0 && (node_alignment & (node_alignment - 1)) == 0);
+
+    if (node_alignment < _Alignof(CSTL_NodePoolFree)) {
+        node_alignment = _Alignof(CSTL_NodePoolFree);
+    }
+
+    if (node_size < sizeof(CSTL_NodePoolFree)) {
+        node_size = sizeof(CSTL_NodePoolFree);
+    }
+
+    new_pool->alloc.opaque        = new_pool;
+    new_pool->alloc.aligned_alloc = &CSTL_node_pool_aligned_alloc;
+    new_pool->alloc.aligned_free  = &CSTL_node_pool_aligned_free;
+    new_pool->alloc.try_expand    = NULL;
+    new_pool->alloc.reallocate    = NULL;
+
+    new_pool->upstream       = upstream;
+    new_pool->chunks         = NULL;
+    new_pool->free_list      = NULL;
+    new_pool->node_size      = (node_size + node_alignment - 1) & ~(node_alignment - 1);
+    new_pool->node_alignment = node_alignment;
+    new_pool->chunk_nodes    = CSTL_node_pool_min_chunk_nodes;
+    new_pool->used           = 0;
+    new_pool->reserved       = 0;
+}
+
+void CSTL_node_pool_destroy(CSTL_NodePool* pool) {
+    CSTL_NodePoolChunk* chunk = pool->chunks;
+    size_t alignment          = CSTL_node_pool_chunk_alignment(pool);
+
+    while (chunk != NULL) {
+        CSTL_NodePoolChunk* next = chunk->next;
+        CSTL_free(chunk, chunk->size, alignment, pool->upstream);
+        chunk = next;
+    }
+
+    pool->chunks      = NULL;
+    pool->free_list   = NULL;
+    pool->chunk_nodes = CSTL_node_pool_min_chunk_nodes;
+    pool->used        = 0;
+    pool->reserved    = 0;
+}
+
+bool CSTL_node_pool_reserve(CSTL_NodePool* pool, size_t count) {
+    size_t available = pool->reserved - pool->used;
+
+    if (count <= available) {
+        return true;
+    }
+
+    return CSTL_node_pool_grow(pool, count - available);
+}
+
+void* CSTL_node_pool_allocate(CSTL_NodePool* pool, size_t size, size_t alignment) {
+    assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+    if (!CSTL_node_pool_fits(pool, size, alignment)) {
+        return CSTL_allocate(size, alignment, pool->upstream);
+    }
+
+    if (pool->free_list == NULL) {
+        if (!CSTL_node_pool_grow(pool, pool->chunk_nodes)) {
+            return NULL;
+        }
+
+        // Chunks grow geometrically, so a large pool takes few upstream allocations.
+        if (pool->chunk_nodes < CSTL_node_pool_max_chunk_nodes) {
+            pool->chunk_nodes *= 2;
+        }
+    }
+
+    CSTL_NodePoolFree* node = pool->free_list;
+
+    pool->free_list = node->next;
+    pool->used     += 1;
+
+    return node;
+}
+
+void CSTL_node_pool_free(CSTL_NodePool* pool, void* memory, size_t size, size_t alignment) {
+    if (!CSTL_node_pool_fits(pool, size, alignment)) {
+        CSTL_free(memory, size, alignment, pool->upstream);
+        return;
+    }
+
+    if (memory == NULL) {
+        return;
+    }
+
+    CSTL_NodePoolFree* node = memory;
+
+    node->next      = pool->free_list;
+    pool->free_list = node;
+    pool->used     -= 1;
+}
+
+CSTL_NodePoolStats CSTL_node_pool_stats(const CSTL_NodePool* pool) {
+    CSTL_NodePoolStats stats = {pool->used, pool->reserved};
+    return stats;
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#ifndef CSTL_NODE_POOL_H
+#define CSTL_NODE_POOL_H
+
+#include "alloc.h"
+
+#if defined(__cplusplus)
+#include <cstddef>
+extern "C" {
+#else
+#include <stdbool.h>
+#include <stddef.h>
+#endif
+
+/**
+ * A block of nodes owned by a node pool.
+ * 
+ */
+typedef struct CSTL_NodePoolChunk CSTL_NodePoolChunk;
+
+/**
+ * Free list allocator for the nodes of node-based containers.
+ * 
+ * Blocks of at most `node_size` bytes and `node_alignment` alignment are
+ * carved out of chunks obtained from the upstream allocator, and freed blocks
+ * are kept on a free list for reuse, so a container that erases as often as it
+ * inserts stops allocating once the pool is warm. Other blocks, such as the
+ * bucket arrays of hash tables, are passed on to the upstream allocator.
+ * 
+ * Containers use the pool through `alloc`, which can be passed to every
+ * function taking a `CSTL_Alloc*`. One pool may serve one container or be
+ * shared by several with the same node size. The pool must not be moved or
+ * copied after construction, as `alloc` refers to it.
+ * 
+ * Not thread-safe. Use `CSTL_pool_alloc` to share nodes between threads.
+ * 
+ * Do not manipulate the members directly, use the associated functions!
+ * 
+ */
+typedef struct CSTL_NodePool {
+    CSTL_Alloc alloc;
+    CSTL_Alloc* upstream;
+    CSTL_NodePoolChunk* chunks;
+    void* free_list;
+    size_t node_size;
+    size_t node_alignment;
+    size_t chunk_nodes;
+    size_t used;
+    size_t reserved;
+} CSTL_NodePool;
+
+/**
+ * Usage statistics of a node pool.
+ * 
+ */
+typedef struct CSTL_NodePoolStats {
+    size_t used;     // nodes currently handed out
+    size_t reserved; // nodes obtained from the upstream allocator
+} CSTL_NodePoolStats;
+
+/**
+ * Initializes the pool pointed to by `new_pool`, but does not allocate any memory.
+ * 
+ * Chunks are obtained from `upstream`, or the default allocator if it is `NULL`.
+ * `node_alignment` must be a power of 2. Use the node size functions of a
+ * container, such as `CSTL_list_node_size`, to obtain `node_size` and `node_alignment`.
+ * 
+ */
+void CSTL_node_pool_construct(CSTL_NodePool* new_pool, size_t node_size, size_t node_alignment, CSTL_Alloc* upstream);
+
+/**
+ * Destroys the pool pointed to by `pool`, freeing all of its chunks.
+ * 
+ * Any node allocated from the pool becomes invalid.
+ * 
+ */
+void CSTL_node_pool_destroy(CSTL_NodePool* pool);
+
+/**
+ * Makes sure that at least `count` nodes can be allocated without
+ * calling the upstream allocator.
+ * 
+ * Returns `false` if out of memory.
+ * 
+ */
+bool CSTL_node_pool_reserve(CSTL_NodePool* pool, size_t count);
+
+/**
+ * Allocates `size` bytes aligned to `alignment`, which must be a power of 2.
+ * 
+ * Returns `NULL` if out of memory.
+ * 
+ */
+void* CSTL_node_pool_allocate(CSTL_NodePool* pool, size_t size, size_t alignment);
+
+/**
+ * Frees a block allocated by `CSTL_node_pool_allocate` with the same `size` and `alignment`.
+ * 
+ */
+void CSTL_node_pool_free(CSTL_NodePool* pool, void* memory, size_t size, size_t alignment);
+
+/**
+ * Returns the usage statistics of the pool.
+ * 
+ */
+CSTL_NodePoolStats CSTL_node_pool_stats(const CSTL_NodePool* pool);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
@@ -0,0 +1,513 @@
+#include "parallel.h"
+
+#include "algorithm.h"
+
+#include "internal/alloc_dispatch.h"
+#include "internal/type_ext.h"
+
+#include <assert.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Target size of a chunk, small enough to stay in the L2 cache of one core.
+#define CSTL_parallel_chunk_bytes ((size_t)64 * 1024)
+
+// A vector split into chunks of `chunk_size` elements, the last one may be shorter.
+typedef struct CSTL_Chunks {
+    char* first;
+    size_t count;
+    size_t type_size;
+    size_t chunk_size;
+    size_t chunk_count;
+} CSTL_Chunks;
+
+typedef struct CSTL_ChunkJob {
+    CSTL_Chunks chunks;
+    char* dest;
+    size_t dest_size;
+    union {
+        CSTL_ChunkFn each;
+        CSTL_ChunkTransformFn transform;
+        CSTL_ChunkReduceFn reduce;
+        CSTL_ChunkScanFn scan;
+    } func;
+    const char* carry; // per-chunk scan carries, the first one is null for inclusive scans
+    bool inclusive;
+    void* context;
+} CSTL_ChunkJob;
+
+typedef struct CSTL_ParallelSort {
+    char* first;
+    char* buffer;
+    size_t count;
+    size_t type_size;
+    size_t chunk_size;
+    size_t parts;
+    size_t part_size; // parts are `part_size + 1` elements long up to `long_parts`, then `part_size`
+    size_t long_parts;
+    CSTL_Type type;
+    CSTL_MoveTypeCRef move;
+    CSTL_CompTypeCRef comp;
+    CSTL_Alloc* alloc;
+    bool stable;
+    bool relocatable;
+    atomic_bool failed;
+    const char* src; // merged from `src` to `dest` in runs of `width` parts
+    char* dest;
+    size_t width;
+    size_t* splits; // per output chunk, where it starts in the left run of its group
+} CSTL_ParallelSort;
+
+static inline CSTL_Chunks CSTL_chunks(const void* first, size_t count, size_t type_size) {
+    size_t chunk_size = type_size < CSTL_parallel_chunk_bytes ? CSTL_parallel_chunk_bytes / type_size : 1;
+
+    CSTL_Chunks chunks = { (char*)first, count, type_size, chunk_size, (count + (chunk_size - 1)) / chunk_size };
+    return chunks;
+}
+
+static inline size_t CSTL_chunk_first(const CSTL_Chunks* chunks, size_t index) {
+    return index * chunks->chunk_size;
+}
+
+static inline size_t CSTL_chunk_last(const CSTL_Chunks* chunks, size_t index) {
+    size_t left = chunks->count - index * chunks->chunk_size;
+    return index * chunks->chunk_size + (left < chunks->chunk_size ? left : chunks->chunk_size);
+}
+
+static inline char* CSTL_chunk_at(const CSTL_Chunks* chunks, size_t pos) {
+    return chunks->first + pos * chunks->type_size;
+}
+
+static void CSTL_for_each_task(size_t index, void* param) {
+    const CSTL_ChunkJob* job = (const CSTL_ChunkJob*)param;
+
+    char* first = CSTL_chunk_at(&job->chunks, CSTL_chunk_first(&job->chunks, index));
+    char* last  = CSTL_chunk_at(&job->chunks, CSTL_chunk_last(&job->chunks, index));
+
+    job->func.each(first, last, job->context);
+}
+
+static void CSTL_transform_task(size_t index, void* param) {
+    const CSTL_ChunkJob* job = (const CSTL_ChunkJob*)param;
+
+    size_t pos  = CSTL_chunk_first(&job->chunks, index);
+    char* first = CSTL_chunk_at(&job->chunks, pos);
+    char* last  = CSTL_chunk_at(&job->chunks, CSTL_chunk_last(&job->chunks, index));
+
+    job->func.transform(first, last, job->dest + pos * job->dest_size, job->context);
+}
+
+// Reduces chunk `index` into slot `index + 1` of `dest`, slot 0 is left for the initial value.
+static void CSTL_reduce_task(size_t index, void* param) {
+    const CSTL_ChunkJob* job = (const CSTL_ChunkJob*)param;
+
+    char* first = CSTL_chunk_at(&job->chunks, CSTL_chunk_first(&job->chunks, index));
+    char* last  = CSTL_chunk_at(&job->chunks, CSTL_chunk_last(&job->chunks, index));
+
+    job->func.reduce(first, last, job->dest + (index + 1) * job->dest_size, job->context);
+}
+
+static void CSTL_scan_task(size_t index, void* param) {
+    const CSTL_ChunkJob* job = (const CSTL_ChunkJob*)param;
+
+    char* first       = CSTL_chunk_at(&job->chunks, CSTL_chunk_first(&job->chunks, index));
+    char* last        = CSTL_chunk_at(&job->chunks, CSTL_chunk_last(&job->chunks, index));
+    const char* carry = index == 0 && job->inclusive ? NULL : job->carry + index * job->dest_size;
+
+    job->func.scan(first, last, carry, job->context);
+}
+
+void CSTL_vector_parallel_for_each(CSTL_ThreadPool* pool, CSTL_VectorRef instance, CSTL_Type type, CSTL_ChunkFn func, void* context) {
+    CSTL_ChunkJob job = { 0 };
+
+    job.chunks    = CSTL_chunks(instance->first, CSTL_vector_size(instance, type), CSTL_type_size(type));
+    job.func.each = func;
+    job.context   = context;
+
+    CSTL_thread_pool_run(pool, job.chunks.chunk_count, &CSTL_for_each_task, &job);
+}
+
+bool CSTL_vector_parallel_transform(CSTL_ThreadPool* pool, CSTL_VectorRef dest, CSTL_Type dest_type, CSTL_MoveTypeCRef dest_move, CSTL_VectorCRef src, CSTL_Type src_type, CSTL_ChunkTransformFn func, void* context, CSTL_Alloc* alloc) {
+    assert(dest != src);
+
+    size_t count     = CSTL_vector_size(src, src_type);
+    size_t size      = CSTL_vector_size(dest, dest_type);
+    size_t dest_size = CSTL_type_size(dest_type);
+
+    if (count > CSTL_vector_max_size(dest_type) - size) {
+        return false;
+    }
+
+    if (!CSTL_vector_reserve(dest, dest_type, dest_move, size + count, alloc)) {
+        return false;
+    }
+
+    CSTL_ChunkJob job = { 0 };
+
+    job.chunks         = CSTL_chunks(src->first, count, CSTL_type_size(src_type));
+    job.dest           = (char*)dest->last;
+    job.dest_size      = dest_size;
+    job.func.transform = func;
+    job.context        = context;
+
+    CSTL_thread_pool_run(pool, job.chunks.chunk_count, &CSTL_transform_task, &job);
+
+    dest->last = (char*)dest->last + count * dest_size;
+    return true;
+}
+
+bool CSTL_vector_parallel_reduce(CSTL_ThreadPool* pool, CSTL_VectorCRef instance, CSTL_Type type, CSTL_Type result_type, CSTL_ChunkReduceFn reduce, CSTL_CombineFn combine, void* result, void* context, CSTL_Alloc* alloc) {
+    CSTL_ChunkJob job = { 0 };
+
+    job.chunks = CSTL_chunks(instance->first, CSTL_vector_size(instance, type), CSTL_type_size(type));
+
+    if (job.chunks.chunk_count == 0) {
+        return true;
+    }
+
+    CSTL_SmallAllocFrame frame;
+
+    size_t result_size  = CSTL_type_size(result_type);
+    size_t alignment    = CSTL_type_alignment(result_type);
+    size_t buffer_bytes = (job.chunks.chunk_count + 1) * result_size;
+    uintptr_t cookie    = (uintptr_t)&CSTL_vector_parallel_reduce ^ (uintptr_t)&job;
+    char* partials      = (char*)CSTL_small_alloc(&frame, buffer_bytes, alignment, alloc, cookie);
+
+    if (partials == NULL) {
+        return false;
+    }
+
+    job.dest        = partials;
+    job.dest_size   = result_size;
+    job.func.reduce = reduce;
+    job.context     = context;
+
+    CSTL_thread_pool_run(pool, job.chunks.chunk_count, &CSTL_reduce_task, &job);
+
+    for (size_t i = 1; i <= job.chunks.chunk_count; ++i) {
+        combine(result, result, partials + i * result_size, context);
+    }
+
+    CSTL_small_free(&frame, buffer_bytes, alignment, alloc, cookie);
+    return true;
+}
+
+// Runs both passes of a scan, `init` is null for inclusive scans.
+static bool CSTL_parallel_scan(CSTL_ThreadPool* pool, CSTL_VectorRef instance, CSTL_Type type, CSTL_ChunkReduceFn reduce, CSTL_CombineFn combine, CSTL_ChunkScanFn scan, const void* init, void* context, CSTL_Alloc* alloc) {
+    CSTL_ChunkJob job = { 0 };
+
+    size_t type_size = CSTL_type_size(type);
+
+    job.chunks = CSTL_chunks(instance->first, CSTL_vector_size(instance, type), type_size);
+
+    size_t chunk_count = job.chunks.chunk_count;
+
+    if (chunk_count == 0) {
+        return true;
+    }
+
+    CSTL_SmallAllocFrame frame;
+
+    size_t alignment    = CSTL_type_alignment(type);
+    size_t buffer_bytes = chunk_count * type_size;
+    uintptr_t cookie    = (uintptr_t)&CSTL_parallel_scan ^ (uintptr_t)&job;
+    char* carries       = (char*)CSTL_small_alloc(&frame, buffer_bytes, alignment, alloc, cookie);
+
+    if (carries == NULL) {
+        return false;
+    }
+
+    job.dest        = carries;
+    job.dest_size   = type_size;
+    job.func.reduce = reduce;
+    job.context     = context;
+
+    // The last chunk carries into nothing.
+    CSTL_thread_pool_run(pool, chunk_count - 1, &CSTL_reduce_task, &job);
+
+    if (init != NULL) {
+        memcpy(carries, init, type_size);
+    }
+
+    // Slot `i` becomes the combination of everything before chunk `i`.
+    for (size_t i = init != NULL ? 1 : 2; i < chunk_count; ++i) {
+        combine(carries + i * type_size, carries + (i - 1) * type_size, carries + i * type_size, context);
+    }
+
+    job.func.scan = scan;
+    job.carry     = carries;
+    job.inclusive = init == NULL;
+
+    CSTL_thread_pool_run(pool, chunk_count, &CSTL_scan_task, &job);
+
+    CSTL_small_free(&frame, buffer_bytes, alignment, alloc, cookie);
+    return true;
+}
+
+bool CSTL_vector_parallel_inclusive_scan(CSTL_ThreadPool* pool, CSTL_VectorRef instance, CSTL_Type type, CSTL_ChunkReduceFn reduce, CSTL_CombineFn combine, CSTL_ChunkScanFn scan, void* context, CSTL_Alloc* alloc) {
+    return CSTL_parallel_scan(pool, instance, type, reduce, combine, scan, NULL, context, alloc);
+}
+
+bool CSTL_vector_parallel_exclusive_scan(CSTL_ThreadPool* pool, CSTL_VectorRef instance, CSTL_Type type, CSTL_ChunkReduceFn reduce, CSTL_CombineFn combine, CSTL_ChunkScanFn scan, const void* init, void* context, CSTL_Alloc* alloc) {
+    return CSTL_parallel_scan(pool, instance, type, reduce, combine, scan, init, context, alloc);
+}
+
+// Returns the index of the first element of part `part`.
+static inline size_t CSTL_psort_bound(const CSTL_ParallelSort* sort, size_t part) {
+    return part * sort->part_size + (part < sort->long_parts ? part : sort->long_parts);
+}
+
+// Returns the part holding the element at `pos`.
+static inline size_t CSTL_psort_part(const CSTL_ParallelSort* sort, size_t pos) {
+    size_t long_bound = sort->long_parts * (sort->part_size + 1);
+
+    if (pos < long_bound) {
+        return pos / (sort->part_size + 1);
+    }
+
+    return sort->long_parts + (pos - long_bound) / sort->part_size;
+}
+
+static void CSTL_psort_part_task(size_t index, void* param) {
+    CSTL_ParallelSort* sort = (CSTL_ParallelSort*)param;
+
+    char* first = sort->first + CSTL_psort_bound(sort, index) * sort->type_size;
+    char* last  = sort->first + CSTL_psort_bound(sort, index + 1) * sort->type_size;
+
+    CSTL_VectorVal part = { first, last, last };
+
+    bool sorted = sort->stable ? CSTL_vector_stable_sort(&part, sort->type, sort->move, sort->comp, sort->alloc)
+                               : CSTL_vector_sort(&part, sort->type, sort->move, sort->comp, sort->alloc);
+
+    if (!sorted) {
+        atomic_store_explicit(&sort->failed, true, memory_order_relaxed);
+    }
+}
+
+// Relocates one object to a distinct location, with a fixed size copy for common sizes.
+static inline void CSTL_psort_relocate_one(const CSTL_ParallelSort* sort, const char* src, char* dest) {
+    if (!sort->relocatable) {
+        CSTL_type_relocate(sort->move, (void*)src, (void*)(src + sort->type_size), dest);
+        return;
+    }
+
+    switch (sort->type_size) {
+    case 4:  memcpy(dest, src, 4); break;
+    case 8:  memcpy(dest, src, 8); break;
+    case 16: memcpy(dest, src, 16); break;
+    default: memcpy(dest, src, sort->type_size); break;
+    }
+}
+
+static inline void CSTL_psort_relocate(const CSTL_ParallelSort* sort, const char* src, size_t count, char* dest) {
+    CSTL_type_relocate(sort->move, (void*)src, (void*)(src + count * sort->type_size), dest);
+}
+
+// The runs merged into the output at `pos` in the current round.
+typedef struct CSTL_MergeGroup {
+    size_t first;
+    size_t mid;
+    size_t last;
+} CSTL_MergeGroup;
+
+static inline CSTL_MergeGroup CSTL_psort_group(const CSTL_ParallelSort* sort, size_t pos) {
+    size_t group_parts = sort->width * 2;
+    size_t group       = CSTL_psort_part(sort, pos) / group_parts * group_parts;
+    size_t mid         = group + sort->width < sort->parts ? group + sort->width : sort->parts;
+    size_t last        = group + group_parts < sort->parts ? group + group_parts : sort->parts;
+
+    CSTL_MergeGroup result = { CSTL_psort_bound(sort, group), CSTL_psort_bound(sort, mid), CSTL_psort_bound(sort, last) };
+    return result;
+}
+
+// Returns how many of the first `k` merged elements of the group come from its
+// left run, taking the left run first among equivalents.
+static size_t CSTL_psort_co_rank(const CSTL_ParallelSort* sort, CSTL_MergeGroup group, size_t k) {
+    size_t type_size = sort->type_size;
+    const char* lhs  = sort->src + group.first * type_size;
+    const char* rhs  = sort->src + group.mid * type_size;
+    size_t lhs_count = group.mid - group.first;
+    size_t rhs_count = group.last - group.mid;
+
+    size_t lo = k > rhs_count ? k - rhs_count : 0;
+    size_t hi = k < lhs_count ? k : lhs_count;
+
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+
+        if (sort->comp->is_lt(rhs + (k - mid - 1) * type_size, lhs + mid * type_size)) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+
+    return lo;
+}
+
+// Finds where the output chunk `index` starts in the left run of its group,
+// before any element of the round is moved.
+static void CSTL_psort_split_task(size_t index, void* param) {
+    const CSTL_ParallelSort* sort = (const CSTL_ParallelSort*)param;
+
+    size_t pos            = index * sort->chunk_size;
+    CSTL_MergeGroup group = CSTL_psort_group(sort, pos);
+
+    sort->splits[index] = CSTL_psort_co_rank(sort, group, pos - group.first);
+}
+
+// Merges the outputs `[out_first, out_last)` of a group, which take `[i, i_end)` from the left run.
+static void CSTL_psort_merge(const CSTL_ParallelSort* sort, CSTL_MergeGroup group, size_t out_first, size_t out_last, size_t i, size_t i_end) {
+    size_t type_size = sort->type_size;
+    CSTL_IsLt is_lt  = sort->comp->is_lt;
+
+    const char* lhs = sort->src + group.first * type_size;
+    const char* rhs = sort->src + group.mid * type_size;
+    size_t j        = out_first - i;
+    size_t j_end    = out_last - i_end;
+
+    char* dest = sort->dest + (group.first + out_first) * type_size;
+
+    while (i != i_end && j != j_end) {
+        const char* left  = lhs + i * type_size;
+        const char* right = rhs + j * type_size;
+
+        if (is_lt(right, left)) {
+            CSTL_psort_relocate_one(sort, right, dest);
+            ++j;
+        } else {
+            CSTL_psort_relocate_one(sort, left, dest);
+            ++i;
+        }
+
+        dest += type_size;
+    }
+
+    CSTL_psort_relocate(sort, lhs + i * type_size, i_end - i, dest);
+    dest += (i_end - i) * type_size;
+    CSTL_psort_relocate(sort, rhs + j * type_size, j_end - j, dest);
+}
+
+// Merges one chunk of the output of a round, which may span several groups.
+static void CSTL_psort_merge_task(size_t index, void* param) {
+    const CSTL_ParallelSort* sort = (const CSTL_ParallelSort*)param;
+
+    size_t pos  = index * sort->chunk_size;
+    size_t left = sort->count - pos;
+    size_t end  = pos + (left < sort->chunk_size ? left : sort->chunk_size);
+
+    while (pos != end) {
+        CSTL_MergeGroup group = CSTL_psort_group(sort, pos);
+
+        // Later groups start at their first element, the last one ends at the next chunk.
+        size_t out_last = end < group.last ? end : group.last;
+        size_t i        = pos == index * sort->chunk_size ? sort->splits[index] : 0;
+        size_t i_end    = out_last == group.last ? group.mid - group.first : sort->splits[index + 1];
+
+        CSTL_psort_merge(sort, group, pos - group.first, out_last - group.first, i, i_end);
+        pos = out_last;
+    }
+}
+
+// Relocates the sorted elements from the buffer back into the vector.
+static void CSTL_psort_copy_back_task(size_t index, void* param) {
+    const CSTL_ParallelSort* sort = (const CSTL_ParallelSort*)param;
+
+    size_t pos  = index * sort->chunk_size;
+    size_t left = sort->count - pos;
+    size_t end  = pos + (left < sort->chunk_size ? left : sort->chunk_size);
+
+    CSTL_type_relocate(sort->move, sort->buffer + pos * sort->type_size, sort->buffer + end * sort->type_size, sort->first + pos * sort->type_size);
+}
+
+static bool CSTL_parallel_sort(CSTL_ThreadPool* pool, CSTL_VectorRef instance, CSTL_Type type, CSTL_MoveTypeCRef move, CSTL_CompTypeCRef comp, bool stable, CSTL_Alloc* alloc) {
+    size_t count     = CSTL_vector_size(instance, type);
+    size_t type_size = CSTL_type_size(type);
+
+    CSTL_Chunks chunks = CSTL_chunks(instance->first, count, type_size);
+
+    // Each part gets at least one chunk, or the merges cost more than they save.
+    size_t parts = CSTL_thread_pool_thread_count(pool);
+
+    if (parts > chunks.chunk_count) {
+        parts = chunks.chunk_count;
+    }
+
+    if (parts < 2) {
+        return stable ? CSTL_vector_stable_sort(instance, type, move, comp, alloc) : CSTL_vector_sort(instance, type, move, comp, alloc);
+    }
+
+    size_t alignment = CSTL_type_alignment(type);
+    char* buffer     = (char*)CSTL_allocate(count * type_size, alignment, alloc);
+
+    if (buffer == NULL) {
+        return false;
+    }
+
+    size_t* splits = (size_t*)CSTL_allocate(chunks.chunk_count * sizeof(size_t), _Alignof(size_t), alloc);
+
+    if (splits == NULL) {
+        CSTL_free(buffer, count * type_size, alignment, alloc);
+        return false;
+    }
+
+    CSTL_ParallelSort sort;
+
+    sort.first       = (char*)instance->first;
+    sort.buffer      = buffer;
+    sort.count       = count;
+    sort.type_size   = type_size;
+    sort.chunk_size  = chunks.chunk_size;
+    sort.parts       = parts;
+    sort.part_size   = count / parts;
+    sort.long_parts  = count % parts;
+    sort.type        = type;
+    sort.move        = move;
+    sort.comp        = comp;
+    sort.alloc       = alloc;
+    sort.stable      = stable;
+    sort.relocatable = CSTL_type_is_relocatable(move);
+    sort.splits      = splits;
+
+    atomic_init(&sort.failed, false);
+
+    CSTL_thread_pool_run(pool, parts, &CSTL_psort_part_task, &sort);
+
+    // Unsorted parts give non-monotone co-ranks, so the merges must not run.
+    if (atomic_load_explicit(&sort.failed, memory_order_relaxed)) {
+        CSTL_free(splits, chunks.chunk_count * sizeof(size_t), _Alignof(size_t), alloc);
+        CSTL_free(buffer, count * type_size, alignment, alloc);
+        return false;
+    }
+
+    sort.src  = sort.first;
+    sort.dest = buffer;
+
+    for (sort.width = 1; sort.width < parts; sort.width *= 2) {
+        CSTL_thread_pool_run(pool, chunks.chunk_count, &CSTL_psort_split_task, &sort);
+        CSTL_thread_pool_run(pool, chunks.chunk_count, &CSTL_psort_merge_task, &sort);
+
+        char* merged = sort.dest;
+        sort.dest    = (char*)sort.src;
+        sort.src     = merged;
+    }
+
+    if (sort.src == buffer) {
+        CSTL_thread_pool_run(pool, chunks.chunk_count, &CSTL_psort_copy_back_task, &sort);
+    }
+
+    CSTL_free(splits, chunks.chunk_count * sizeof(size_t), _Alignof(size_t), alloc);
+    CSTL_free(buffer, count * type_size, alignment, alloc);
+    return true;
+}
+
+bool CSTL_vector_parallel_sort(CSTL_ThreadPool* pool, CSTL_VectorRef instance, CSTL_Type type, CSTL_MoveTypeCRef move, CSTL_CompTypeCRef comp, CSTL_Alloc* alloc) {
+    return CSTL_parallel_sort(pool, instance, type, move, comp, false, alloc);
+}
+
+bool CSTL_vector_parallel_stable_sort(CSTL_ThreadPool* pool, CSTL_VectorRef instance, CSTL_Type type, CSTL_MoveTypeCRef move, CSTL_CompTypeCRef comp, CSTL_Alloc* alloc) {
+    return CSTL_parallel_sort(pool, instance, type, move, comp, true, alloc);
+}
@@ -0,0 +1,162 @@
+#pragma once
+
+#ifndef CSTL_PARALLEL_H
+#define CSTL_PARALLEL_H
+
+#include "alloc.h"
+#include "thread_pool.h"
+#include "type.h"
+#include "vector.h"
+
+#if defined(__cplusplus)
+#include <cstddef>
+extern "C" {
+#else
+#include <stdbool.h>
+#include <stddef.h>
+#endif
+
+/**
+ * Parallel algorithms over the elements of a `CSTL_VectorVal`.
+ * 
+ * The elements are split into contiguous chunks of about 64 KiB, going by
+ * the size of `type`, which are handed out to the threads of `pool`.
+ * Callbacks are called once per chunk with a range of elements `[first, last)`,
+ * never with an empty one, concurrently and in an unspecified order.
+ * 
+ * `pool` may be null, in which case everything runs on the calling thread.
+ * `alloc` must be safe to call from several threads at once.
+ * 
+ */
+
+/**
+ * Called with the chunk `[first, last)` of a vector.
+ * 
+ */
+typedef void (*CSTL_ChunkFn)(void* first, void* last, void* context);
+
+/**
+ * Called with the chunk `[first, last)` of the source vector and uninitialized
+ * memory at `dest` for as many destination elements, which it must construct.
+ * 
+ */
+typedef void (*CSTL_ChunkTransformFn)(const void* first, const void* last, void* dest, void* context);
+
+/**
+ * Called with the chunk `[first, last)` of a vector, must store the
+ * combination of its elements in order into uninitialized memory at `result`.
+ * 
+ */
+typedef void (*CSTL_ChunkReduceFn)(const void* first, const void* last, void* result, void* context);
+
+/**
+ * Must store the combination of `*lhs` followed by `*rhs` into `*result`,
+ * which may be the same object as either.
+ * 
+ * The combination must be associative, it need not be commutative.
+ * 
+ */
+typedef void (*CSTL_CombineFn)(void* result, const void* lhs, const void* rhs, void* context);
+
+/**
+ * Called with the chunk `[first, last)` of a vector, must replace each element
+ * with the combination of the elements up to it, starting from `*carry`.
+ * 
+ * `carry` is null for the first chunk of an inclusive scan.
+ * 
+ */
+typedef void (*CSTL_ChunkScanFn)(void* first, void* last, const void* carry, void* context);
+
+/**
+ * Calls `func` for every chunk of the vector.
+ * 
+ */
+void CSTL_vector_parallel_for_each(CSTL_ThreadPool* pool, CSTL_VectorRef instance, CSTL_Type type, CSTL_ChunkFn func, void* context);
+
+/**
+ * Appends to `dest` one element per element of `src`, constructed by `func`
+ * from the chunks of `src`.
+ * 
+ * `dest` is reserved once up front and must not be `src`. If
+ * `CSTL_vector_size(src, src_type) > CSTL_vector_max_size(dest_type) - CSTL_vector_size(dest, dest_type)`
+ * (vector too long) or reserving fails, this function has no effect and returns `false`,
+ * otherwise it returns `true`.
+ * 
+ */
+bool CSTL_vector_parallel_transform(CSTL_ThreadPool* pool, CSTL_VectorRef dest, CSTL_Type dest_type, CSTL_MoveTypeCRef dest_move, CSTL_VectorCRef src, CSTL_Type src_type, CSTL_ChunkTransformFn func, void* context, CSTL_Alloc* alloc);
+
+/**
+ * Combines `*result` with all elements of the vector in order, and stores
+ * the combination into `*result`.
+ * 
+ * Each chunk is reduced by `reduce`, then the results are combined in order
+ * with `combine` on the calling thread. They are objects of `result_type`,
+ * which must be trivially copyable and destructible.
+ * 
+ * If allocating the per-chunk results fails, this function has no effect and returns
+ * `false`, otherwise it returns `true`.
+ * 
+ */
+bool CSTL_vector_parallel_reduce(CSTL_ThreadPool* pool, CSTL_VectorCRef instance, CSTL_Type type, CSTL_Type result_type, CSTL_ChunkReduceFn reduce, CSTL_CombineFn combine, void* result, void* context, CSTL_Alloc* alloc);
+
+/**
+ * Parallel prefix scans, in place.
+ * 
+ * Each chunk but the last is reduced by `reduce`, the results are combined
+ * in order with `combine` on the calling thread, and each chunk is then
+ * scanned by `scan` with the combination of the elements before it.
+ * Elements are read twice, so a scan takes about twice the work of
+ * a sequential one, spread over all threads.
+ * 
+ * The element type must be trivially copyable and destructible.
+ * 
+ * If allocating the per-chunk results fails, these functions have no effect and
+ * return `false`, otherwise they return `true`.
+ * 
+ */
+
+/**
+ * Replaces each element with the combination of the elements up to and including it.
+ * 
+ */
+bool CSTL_vector_parallel_inclusive_scan(CSTL_ThreadPool* pool, CSTL_VectorRef instance, CSTL_Type type, CSTL_ChunkReduceFn reduce, CSTL_CombineFn combine, CSTL_ChunkScanFn scan, void* context, CSTL_Alloc* alloc);
+
+/**
+ * Replaces each element with the combination of `*init` and the elements before it.
+ * 
+ * `scan` must not include an element in its own result.
+ * 
+ */
+bool CSTL_vector_parallel_exclusive_scan(CSTL_ThreadPool* pool, CSTL_VectorRef instance, CSTL_Type type, CSTL_ChunkReduceFn reduce, CSTL_CombineFn combine, CSTL_ChunkScanFn scan, const void* init, void* context, CSTL_Alloc* alloc);
+
+/**
+ * Sorts the elements of the vector in ascending order.
+ * 
+ * The vector is split into one part per thread, the parts are sorted
+ * as if by `CSTL_vector_sort`, then merged pairwise, with every merge split
+ * into chunks of the output. Needs a temporary buffer as large as the vector.
+ * 
+ * The order of equivalent elements is unspecified.
+ * 
+ * If allocating the buffer fails, this function has no effect and returns `false`.
+ * If sorting a part fails, the elements are left in an unspecified order and
+ * it returns `false`. Otherwise it returns `true`.
+ * 
+ */
+bool CSTL_vector_parallel_sort(CSTL_ThreadPool* pool, CSTL_VectorRef instance, CSTL_Type type, CSTL_MoveTypeCRef move, CSTL_CompTypeCRef comp, CSTL_Alloc* alloc);
+
+/**
+ * Sorts the elements of the vector in ascending order,
+ * preserving the order of equivalent elements.
+ * 
+ * Works like `CSTL_vector_parallel_sort`, with the parts sorted
+ * as if by `CSTL_vector_stable_sort`.
+ * 
+ */
+bool CSTL_vector_parallel_stable_sort(CSTL_ThreadPool* pool, CSTL_VectorRef instance, CSTL_Type type, CSTL_MoveTypeCRef move, CSTL_CompTypeCRef comp, CSTL_Alloc* alloc);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
@@ -0,0 +1,340 @@
+#include "pool.h"
+
+#include "internal/alloc_dispatch.h"
+#include "internal/sync.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define CSTL_pool_small_classes 8   // 16, 32, ..., 128
+#define CSTL_pool_classes       40  // then 4 per power of 2 up to 32 KiB
+#define CSTL_pool_max_size      ((size_t)32768)
+
+#define CSTL_pool_slab_size  ((size_t)64 * 1024)
+#define CSTL_pool_slab_align ((size_t)4096)
+
+typedef struct CSTL_PoolBlock {
+    struct CSTL_PoolBlock* next;
+} CSTL_PoolBlock;
+
+// Shared free list of a size class.
+typedef struct CSTL_PoolClass {
+    _Alignas(64) CSTL_SpinLock lock; // one cache line per class
+    CSTL_PoolBlock* free;
+    size_t count;
+} CSTL_PoolClass;
+
+typedef struct CSTL_PoolCache {
+    CSTL_PoolBlock* free[CSTL_pool_classes];
+    uint32_t count[CSTL_pool_classes];
+    bool registered;
+} CSTL_PoolCache;
+
+static CSTL_PoolClass CSTL_pool_shared[CSTL_pool_classes];
+
+static CSTL_thread_local CSTL_PoolCache CSTL_pool_cache;
+
+static inline unsigned CSTL_pool_log2(size_t value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanReverse64(&index, (unsigned long long)value);
+    return (unsigned)index;
+#else
+    return (unsigned)(sizeof(unsigned long long) * 8 - 1) - (unsigned)__builtin_clzll((unsigned long long)value);
+#endif
+}
+
+// `0 < size <= CSTL_pool_max_size`
+static inline size_t CSTL_pool_class_of(size_t size) {
+    if (size <= 128) {
+        return (size - 1) >> 4;
+    }
+
+    unsigned e = CSTL_pool_log2(size - 1); // 2^e < size <= 2^(e + 1)
+    return CSTL_pool_small_classes + (e - 7) * 4 + (((size - 1) - ((size_t)1 << e)) >> (e - 2));
+}
+
+static inline size_t CSTL_pool_class_size(size_t index) {
+    if (index < CSTL_pool_small_classes) {
+        return (index + 1) << 4;
+    }
+
+    size_t k = index - CSTL_pool_small_classes;
+    unsigned e = 7 + (unsigned)(k / 4);
+    return ((size_t)1 << e) + ((k % 4) + 1) * ((size_t)1 << (e - 2));
+}
+
+// Number of blocks moved between a cache and the shared lists at once.
+static inline uint32_t CSTL_pool_batch(size_t index) {
+    size_t batch = CSTL_pool_slab_size / 4 / CSTL_pool_class_size(index);
+
+    if (batch < 4) {
+        return 4;
+    }
+
+    return batch > 64 ? 64 : (uint32_t)batch;
+}
+
+// Whether a block goes through the size classes, decided the same way on allocation and free.
+static inline bool CSTL_pool_is_small(size_t size, size_t alignment) {
+    if (size > CSTL_pool_max_size) {
+        return false;
+    }
+
+    size_t class_size = CSTL_pool_class_size(CSTL_pool_class_of(size != 0 ? size : 1));
+    size_t class_align = class_size & -class_size;
+
+    return alignment <= class_align && alignment <= CSTL_pool_slab_align;
+}
+
+static void CSTL_pool_flush_cache(CSTL_PoolCache* cache);
+
+#if defined(_WIN32)
+static DWORD CSTL_pool_fls = FLS_OUT_OF_INDEXES;
+static INIT_ONCE CSTL_pool_once = INIT_ONCE_STATIC_INIT;
+
+static void WINAPI CSTL_pool_thread_exit(void* cache) {
+    if (cache != NULL) {
+        CSTL_pool_flush_cache((CSTL_PoolCache*)cache);
+    }
+}
+
+static BOOL CALLBACK CSTL_pool_create_key(PINIT_ONCE once, void* param, void** context) {
+    (void)once, (void)param, (void)context;
+    CSTL_pool_fls = FlsAlloc(&CSTL_pool_thread_exit);
+    return TRUE;
+}
+
+static void CSTL_pool_register(CSTL_PoolCache* cache) {
+    InitOnceExecuteOnce(&CSTL_pool_once, &CSTL_pool_create_key, NULL, NULL);
+
+    if (CSTL_pool_fls != FLS_OUT_OF_INDEXES) {
+        FlsSetValue(CSTL_pool_fls, cache);
+    }
+
+    cache->registered = true;
+}
+#else
+static pthread_key_t CSTL_pool_key;
+static pthread_once_t CSTL_pool_once = PTHREAD_ONCE_INIT;
+static bool CSTL_pool_has_key;
+
+static void CSTL_pool_thread_exit(void* cache) {
+    CSTL_pool_flush_cache((CSTL_PoolCache*)cache);
+    ((CSTL_PoolCache*)cache)->registered = false;
+}
+
+static void CSTL_pool_create_key(void) {
+    CSTL_pool_has_key = pthread_key_create(&CSTL_pool_key, &CSTL_pool_thread_exit) == 0;
+}
+
+static void CSTL_pool_register(CSTL_PoolCache* cache) {
+    pthread_once(&CSTL_pool_once, &CSTL_pool_create_key);
+
+    if (CSTL_pool_has_key) {
+        pthread_setspecific(CSTL_pool_key, cache);
+    }
+
+    cache->registered = true;
+}
+#endif
+
+// Moves up to `count` blocks from the front of `*list` to the shared list of class `index`.
+static void CSTL_pool_release(size_t index, CSTL_PoolBlock** list, uint32_t count) {
+    CSTL_PoolBlock* first = *list;
+    CSTL_PoolBlock* last  = first;
+
+    uint32_t moved = 1;
+
+    for (; moved < count && last->next != NULL; ++moved) {
+        last = last->next;
+    }
+
+    *list = last->next;
+
+    CSTL_PoolClass* shared = &CSTL_pool_shared[index];
+
+    CSTL_spin_lock(&shared->lock);
+    last->next     = shared->free;
+    shared->free   = first;
+    shared->count += moved;
+    CSTL_spin_unlock(&shared->lock);
+}
+
+static void CSTL_pool_flush_cache(CSTL_PoolCache* cache) {
+    for (size_t index = 0; index < CSTL_pool_classes; ++index) {
+        if (cache->free[index] != NULL) {
+            CSTL_pool_release(index, &cache->free[index], UINT32_MAX);
+        }
+
+        cache->count[index] = 0;
+    }
+}
+
+// Fills an empty cache list from the shared list, or from a new slab.
+static CSTL_PoolBlock* CSTL_pool_refill(CSTL_PoolCache* cache, size_t index) {
+    uint32_t batch = CSTL_pool_batch(index);
+    CSTL_PoolClass* shared = &CSTL_pool_shared[index];
+
+    CSTL_PoolBlock* first = NULL;
+    uint32_t taken = 0;
+
+    CSTL_spin_lock(&shared->lock);
+
+    if (shared->free != NULL) {
+        first = shared->free;
+
+        CSTL_PoolBlock* last = first;
+
+        for (taken = 1; taken < batch && last->next != NULL; ++taken) {
+            last = last->next;
+        }
+
+        shared->free   = last->next;
+        shared->count -= taken;
+        last->next     = NULL;
+    }
+
+    CSTL_spin_unlock(&shared->lock);
+
+    if (first == NULL) {
+        size_t class_size = CSTL_pool_class_size(index);
+        size_t slab_size  = class_size * 8 > CSTL_pool_slab_size ? class_size * 8 : CSTL_pool_slab_size;
+
+        char* slab = (char*)CSTL_allocate(slab_size, CSTL_pool_slab_align, NULL);
+
+        if (slab == NULL) {
+            return NULL;
+        }
+
+        size_t blocks = slab_size / class_size;
+
+        for (size_t i = 0; i < blocks; ++i) {
+            CSTL_PoolBlock* block = (CSTL_PoolBlock*)(slab + i * class_size);
+            block->next = i + 1 < blocks ? (CSTL_PoolBlock*)(slab + (i + 1) * class_size) : NULL;
+        }
+
+        first = (CSTL_PoolBlock*)slab;
+        taken = (uint32_t)blocks;
+
+        // Keep one batch, share the rest.
+        if (taken > batch) {
+            CSTL_PoolBlock* rest = (CSTL_PoolBlock*)(slab + batch * class_size);
+            ((CSTL_PoolBlock*)(slab + (batch - 1) * class_size))->next = NULL;
+
+            CSTL_pool_release(index, &rest, UINT32_MAX);
+
+            taken = batch;
+        }
+    }
+
+    cache->free[index]  = first;
+    cache->count[index] = taken;
+
+    return first;
+}
+
+void* CSTL_pool_allocate(size_t size, size_t alignment) {
+    if (!CSTL_pool_is_small(size, alignment)) {
+        return CSTL_allocate(size, alignment, NULL);
+    }
+
+    size_t index = CSTL_pool_class_of(size != 0 ? size : 1);
+    CSTL_PoolCache* cache = &CSTL_pool_cache;
+    CSTL_PoolBlock* block = cache->free[index];
+
+    if (block == NULL) {
+        if (!cache->registered) {
+            CSTL_pool_register(cache);
+        }
+
+        block = CSTL_pool_refill(cache, index);
+
+        if (block == NULL) {
+            return NULL;
+        }
+    }
+
+    cache->free[index] = block->next;
+    cache->count[index] -= 1;
+
+    return block;
+}
+
+void CSTL_pool_free(void* memory, size_t size, size_t alignment) {
+    if (memory == NULL) {
+        return;
+    }
+
+    if (!CSTL_pool_is_small(size, alignment)) {
+        CSTL_free(memory, size, alignment, NULL);
+        return;
+    }
+
+    size_t index = CSTL_pool_class_of(size != 0 ? size : 1);
+    CSTL_PoolCache* cache = &CSTL_pool_cache;
+    CSTL_PoolBlock* block = (CSTL_PoolBlock*)memory;
+
+    if (!cache->registered) {
+        CSTL_pool_register(cache);
+    }
+
+    block->next = cache->free[index];
+    cache->free[index] = block;
+
+    uint32_t batch = CSTL_pool_batch(index);
+
+    if (++cache->count[index] > 2 * batch) {
+        CSTL_pool_release(index, &cache->free[index], batch);
+        cache->count[index] -= batch;
+    }
+}
+
+void CSTL_pool_flush_thread(void) {
+    CSTL_pool_flush_cache(&CSTL_pool_cache);
+}
+
+static void* CSTL_pool_aligned_alloc(void* opaque, size_t size, size_t alignment) {
+    (void)opaque;
+    return CSTL_pool_allocate(size, alignment);
+}
+
+static void CSTL_pool_aligned_free(void* opaque, void* memory, size_t size, size_t alignment) {
+    (void)opaque;
+    CSTL_pool_free(memory, size, alignment);
+}
+
+// Blocks of the same size class can grow within their class for free.
+static bool CSTL_pool_try_expand(void* opaque, void* memory, size_t old_size, size_t new_size, size_t alignment) {
+    (void)opaque, (void)memory;
+
+    if (!CSTL_pool_is_small(old_size, alignment) || !CSTL_pool_is_small(new_size, alignment)) {
+        return false;
+    }
+
+    return CSTL_pool_class_of(old_size != 0 ? old_size : 1) == CSTL_pool_class_of(new_size);
+}
+
+// Large blocks belong to the default allocator, which may resize them.
+static void* CSTL_pool_reallocate(void* opaque, void* memory, size_t old_size, size_t new_size, size_t alignment) {
+    (void)opaque;
+
+    if (CSTL_pool_is_small(old_size, alignment) || CSTL_pool_is_small(new_size, alignment)) {
+        return NULL;
+    }
+
+    return CSTL_reallocate(memory, old_size, new_size, alignment, NULL);
+}
+
+static CSTL_Alloc CSTL_pool_instance = {
+    NULL,
+    &CSTL_pool_aligned_alloc,
+    &CSTL_pool_aligned_free,
+    &CSTL_pool_try_expand,
+    &CSTL_pool_reallocate,
+};
+
+CSTL_Alloc* CSTL_pool_alloc(void) {
+    return &CSTL_pool_instance;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#ifndef CSTL_POOL_H
+#define CSTL_POOL_H
+
+#include "alloc.h"
+
+#if defined(__cplusplus)
+#include <cstddef>
+extern "C" {
+#else
+#include <stddef.h>
+#endif
+
+/**
+ * Process-wide thread-caching allocator for small blocks.
+ * 
+ * Blocks of up to 32 KiB are rounded up to one of a set of size classes,
+ * which follow the growth steps of strings and vectors: multiples of 16 bytes
+ * up to 128 bytes, then four classes per power of 2. Each thread keeps a cache
+ * of free blocks per class, so most allocations and frees take no locks.
+ * Caches exchange blocks with shared per-class lists in batches.
+ * 
+ * Blocks may be freed by any thread, not only the one that allocated them.
+ * Freed blocks go to the cache of the freeing thread, and caches are returned
+ * to the shared lists when their thread exits.
+ * 
+ * Larger or over-aligned blocks are passed on to the default allocator.
+ * Memory for small blocks is never returned to the system.
+ * 
+ */
+
+/**
+ * Returns the pool as a `CSTL_Alloc`, which can be passed to every function
+ * taking a `CSTL_Alloc*`.
+ * 
+ */
+CSTL_Alloc* CSTL_pool_alloc(void);
+
+/**
+ * Allocates `size` bytes aligned to `alignment`, which must be a power of 2.
+ * 
+ * Returns `NULL` if out of memory.
+ * 
+ */
+void* CSTL_pool_allocate(size_t size, size_t alignment);
+
+/**
+ * Frees a block allocated by `CSTL_pool_allocate` with the same `size` and `alignment`.
+ * 
+ */
+void CSTL_pool_free(void* memory, size_t size, size_t alignment);
+
+/**
+ * Returns the free blocks cached by the calling thread to the shared lists.
+ * 
+ * Happens automatically when a thread exits.
+ * 
+ */
+void CSTL_pool_flush_thread(void);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
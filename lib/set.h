@@ -0,0 +1,30 @@
+#pragma once
+
+#ifndef CSTL_SET_H
+#define CSTL_SET_H
+
+#include "xtree.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * STL ABI `std::set` layout.
+ * 
+ * Elements are keys described by a `CSTL_Type`.
+ * Use the `CSTL_tree_*` functions, comparing elements.
+ * 
+ * Does not include the allocator, which nonetheless is a part of the `std::set`
+ * structure! You are responsible for including it, since it can take on any form.
+ * 
+ * Do not manipulate the members directly, use the associated functions!
+ * 
+ */
+typedef CSTL_TreeVal CSTL_SetVal;
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
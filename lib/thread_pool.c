@@ -0,0 +1,626 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // pthread_setaffinity_np
+#endif
+
+#include "thread_pool.h"
+
+#include "internal/alloc_dispatch.h"
+#include "internal/sync.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Tasks a worker can have queued, a power of 2. Forks past it run immediately.
+#define CSTL_task_deque_capacity ((ptrdiff_t)256)
+
+// Rounds of looking for work before a worker goes to sleep.
+#define CSTL_worker_spins 64
+
+#define CSTL_queue_min_capacity ((size_t)64)
+
+typedef struct CSTL_Task {
+    CSTL_WorkFn func;
+    void* context;
+    CSTL_TaskGroup* group; // null for submitted tasks
+} CSTL_Task;
+
+// Deque slot, read by thieves while its owner may be reusing it.
+typedef struct CSTL_TaskSlot {
+    _Atomic(CSTL_WorkFn) func;
+    _Atomic(void*) context;
+    _Atomic(CSTL_TaskGroup*) group;
+} CSTL_TaskSlot;
+
+// Chase-Lev deque: the owner pushes and pops at `bottom`, thieves take from `top`.
+typedef struct CSTL_TaskDeque {
+    _Alignas(64) atomic_ptrdiff_t top;
+    _Alignas(64) atomic_ptrdiff_t bottom;
+    CSTL_TaskSlot slots[CSTL_task_deque_capacity];
+} CSTL_TaskDeque;
+
+typedef struct CSTL_Worker {
+    CSTL_TaskDeque deque;
+    CSTL_ThreadPool* pool;
+    uint64_t seed; // picks steal victims
+    CSTL_Thread thread;
+} CSTL_Worker;
+
+struct CSTL_ThreadPool {
+    CSTL_Mutex mutex; // guards the shared queue and going to sleep
+    CSTL_CondVar wake;
+    CSTL_Task* queue; // ring buffer of tasks from threads outside the pool
+    size_t queue_head;
+    size_t queue_capacity;
+    atomic_size_t queue_count; // read without the lock to skip an empty queue
+    atomic_size_t sleepers;
+    atomic_size_t submitted; // submitted tasks that have not returned yet
+    atomic_bool stop;
+    CSTL_Alloc* alloc;
+    size_t thread_count;
+    CSTL_Worker workers[]; // `thread_count - 1`
+};
+
+static CSTL_thread_local CSTL_Worker* CSTL_current_worker;
+
+// Steal victim seed of threads outside any pool.
+static CSTL_thread_local uint64_t CSTL_steal_seed;
+
+static inline size_t CSTL_thread_pool_bytes(size_t thread_count) {
+    return sizeof(CSTL_ThreadPool) + (thread_count - 1) * sizeof(CSTL_Worker);
+}
+
+// Returns the worker of `pool` running on the calling thread, or null.
+static inline CSTL_Worker* CSTL_thread_pool_self(const CSTL_ThreadPool* pool) {
+    CSTL_Worker* self = CSTL_current_worker;
+    return self != NULL && self->pool == pool ? self : NULL;
+}
+
+static inline uint64_t CSTL_xorshift(uint64_t* seed) {
+    uint64_t x = *seed;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return *seed = x;
+}
+
+static inline void CSTL_slot_store(CSTL_TaskSlot* slot, const CSTL_Task* task) {
+    atomic_store_explicit(&slot->func, task->func, memory_order_relaxed);
+    atomic_store_explicit(&slot->context, task->context, memory_order_relaxed);
+    atomic_store_explicit(&slot->group, task->group, memory_order_relaxed);
+}
+
+static inline void CSTL_slot_load(CSTL_TaskSlot* slot, CSTL_Task* task) {
+    task->func    = atomic_load_explicit(&slot->func, memory_order_relaxed);
+    task->context = atomic_load_explicit(&slot->context, memory_order_relaxed);
+    task->group   = atomic_load_explicit(&slot->group, memory_order_relaxed);
+}
+
+static void CSTL_task_deque_init(CSTL_TaskDeque* deque) {
+    atomic_init(&deque->top, 0);
+    atomic_init(&deque->bottom, 0);
+
+    for (ptrdiff_t i = 0; i < CSTL_task_deque_capacity; ++i) {
+        atomic_init(&deque->slots[i].func, NULL);
+        atomic_init(&deque->slots[i].context, NULL);
+        atomic_init(&deque->slots[i].group, NULL);
+    }
+}
+
+// Owner only. Returns `false` if the deque is full.
+static bool CSTL_task_deque_push(CSTL_TaskDeque* deque, const CSTL_Task* task) {
+    ptrdiff_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    ptrdiff_t top    = atomic_load_explicit(&deque->top, memory_order_acquire);
+
+    if (bottom - top >= CSTL_task_deque_capacity) {
+        return false;
+    }
+
+    CSTL_slot_store(&deque->slots[bottom & (CSTL_task_deque_capacity - 1)], task);
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_release);
+    return true;
+}
+
+// Owner only. Takes the most recently pushed task.
+static bool CSTL_task_deque_pop(CSTL_TaskDeque* deque, CSTL_Task* task) {
+    ptrdiff_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+
+    atomic_store_explicit(&deque->bottom, bottom, memory_order_release);
+    atomic_thread_fence(memory_order_seq_cst);
+
+    ptrdiff_t top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+    if (top > bottom) {
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_release);
+        return false;
+    }
+
+    CSTL_slot_load(&deque->slots[bottom & (CSTL_task_deque_capacity - 1)], task);
+
+    if (top != bottom) {
+        return true;
+    }
+
+    // The last task, race the thieves for it.
+    bool taken = atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed);
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_release);
+    return taken;
+}
+
+// Any thread. Takes the least recently pushed task, fails if another thread got there first.
+static bool CSTL_task_deque_steal(CSTL_TaskDeque* deque, CSTL_Task* task) {
+    ptrdiff_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    ptrdiff_t bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+
+    if (top >= bottom) {
+        return false;
+    }
+
+    CSTL_slot_load(&deque->slots[top & (CSTL_task_deque_capacity - 1)], task);
+    return atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed);
+}
+
+// Wakes up to `count` sleeping workers, the caller holds the lock.
+static inline void CSTL_thread_pool_wake_locked(CSTL_ThreadPool* pool, size_t count) {
+    size_t sleepers = atomic_load_explicit(&pool->sleepers, memory_order_relaxed);
+
+    if (sleepers == 0) {
+        return;
+    }
+
+    if (count == 1) {
+        CSTL_cond_signal(&pool->wake);
+    } else {
+        CSTL_cond_broadcast(&pool->wake);
+    }
+}
+
+// Wakes a sleeping worker after a push to a deque.
+static inline void CSTL_thread_pool_wake(CSTL_ThreadPool* pool) {
+    // Pairs with the fence of a worker going to sleep: either it sees
+    // the new task or this sees it among the sleepers.
+    atomic_thread_fence(memory_order_seq_cst);
+
+    if (atomic_load_explicit(&pool->sleepers, memory_order_relaxed) != 0) {
+        CSTL_mutex_lock(&pool->mutex);
+        CSTL_thread_pool_wake_locked(pool, 1);
+        CSTL_mutex_unlock(&pool->mutex);
+    }
+}
+
+// Appends `count` copies of `task` to the shared queue and wakes the workers.
+static bool CSTL_queue_push(CSTL_ThreadPool* pool, const CSTL_Task* task, size_t count) {
+    CSTL_mutex_lock(&pool->mutex);
+
+    size_t size = atomic_load_explicit(&pool->queue_count, memory_order_relaxed);
+
+    if (count > pool->queue_capacity - size) {
+        size_t new_capacity = pool->queue_capacity < CSTL_queue_min_capacity ? CSTL_queue_min_capacity : pool->queue_capacity;
+
+        while (new_capacity - size < count) {
+            if (new_capacity > SIZE_MAX / 2 / sizeof(CSTL_Task)) {
+                CSTL_mutex_unlock(&pool->mutex);
+                return false;
+            }
+
+            new_capacity *= 2;
+        }
+
+        CSTL_Task* queue = (CSTL_Task*)CSTL_allocate(new_capacity * sizeof(CSTL_Task), _Alignof(CSTL_Task), pool->alloc);
+
+        if (queue == NULL) {
+            CSTL_mutex_unlock(&pool->mutex);
+            return false;
+        }
+
+        for (size_t i = 0; i < size; ++i) {
+            queue[i] = pool->queue[(pool->queue_head + i) % pool->queue_capacity];
+        }
+
+        if (pool->queue != NULL) {
+            CSTL_free(pool->queue, pool->queue_capacity * sizeof(CSTL_Task), _Alignof(CSTL_Task), pool->alloc);
+        }
+
+        pool->queue          = queue;
+        pool->queue_head     = 0;
+        pool->queue_capacity = new_capacity;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        pool->queue[(pool->queue_head + size + i) % pool->queue_capacity] = *task;
+    }
+
+    atomic_store_explicit(&pool->queue_count, size + count, memory_order_relaxed);
+
+    CSTL_thread_pool_wake_locked(pool, count);
+    CSTL_mutex_unlock(&pool->mutex);
+    return true;
+}
+
+static bool CSTL_queue_pop(CSTL_ThreadPool* pool, CSTL_Task* task) {
+    if (atomic_load_explicit(&pool->queue_count, memory_order_relaxed) == 0) {
+        return false;
+    }
+
+    CSTL_mutex_lock(&pool->mutex);
+
+    size_t size = atomic_load_explicit(&pool->queue_count, memory_order_relaxed);
+
+    if (size == 0) {
+        CSTL_mutex_unlock(&pool->mutex);
+        return false;
+    }
+
+    *task            = pool->queue[pool->queue_head];
+    pool->queue_head = (pool->queue_head + 1) % pool->queue_capacity;
+    atomic_store_explicit(&pool->queue_count, size - 1, memory_order_relaxed);
+
+    CSTL_mutex_unlock(&pool->mutex);
+    return true;
+}
+
+// Looks for a task: in the calling worker's own deque, then in the others, then in the shared queue.
+static bool CSTL_thread_pool_find(CSTL_ThreadPool* pool, CSTL_Worker* self, CSTL_Task* task) {
+    if (self != NULL && CSTL_task_deque_pop(&self->deque, task)) {
+        return true;
+    }
+
+    size_t worker_count = pool->thread_count - 1;
+
+    if (worker_count != 0) {
+        uint64_t* seed = self != NULL ? &self->seed : &CSTL_steal_seed;
+
+        if (*seed == 0) {
+            *seed = (uint64_t)(uintptr_t)seed | 1;
+        }
+
+        size_t start = (size_t)(CSTL_xorshift(seed) % worker_count);
+
+        for (size_t i = 0; i < worker_count; ++i) {
+            CSTL_Worker* victim = &pool->workers[(start + i) % worker_count];
+
+            if (victim != self && CSTL_task_deque_steal(&victim->deque, task)) {
+                return true;
+            }
+        }
+    }
+
+    return CSTL_queue_pop(pool, task);
+}
+
+static bool CSTL_thread_pool_has_work(CSTL_ThreadPool* pool) {
+    if (atomic_load_explicit(&pool->queue_count, memory_order_relaxed) != 0) {
+        return true;
+    }
+
+    for (size_t i = 0; i < pool->thread_count - 1; ++i) {
+        CSTL_TaskDeque* deque = &pool->workers[i].deque;
+
+        if (atomic_load_explicit(&deque->top, memory_order_relaxed) < atomic_load_explicit(&deque->bottom, memory_order_relaxed)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void CSTL_task_run(CSTL_ThreadPool* pool, const CSTL_Task* task) {
+    task->func(task->context);
+
+    // The group may be gone as soon as its count drops to 0.
+    if (task->group != NULL) {
+        atomic_fetch_sub_explicit(&task->group->pending, 1, memory_order_release);
+    } else {
+        atomic_fetch_sub_explicit(&pool->submitted, 1, memory_order_release);
+    }
+}
+
+CSTL_thread_proc(CSTL_thread_pool_worker, param) {
+    CSTL_Worker* self     = (CSTL_Worker*)param;
+    CSTL_ThreadPool* pool = self->pool;
+    unsigned spins        = 0;
+
+    CSTL_current_worker = self;
+
+    while (!atomic_load_explicit(&pool->stop, memory_order_relaxed)) {
+        CSTL_Task task;
+
+        if (CSTL_thread_pool_find(pool, self, &task)) {
+            CSTL_task_run(pool, &task);
+            spins = 0;
+            continue;
+        }
+
+        if (spins++ < CSTL_worker_spins) {
+            CSTL_cpu_relax();
+            continue;
+        }
+
+        CSTL_mutex_lock(&pool->mutex);
+        atomic_fetch_add_explicit(&pool->sleepers, 1, memory_order_seq_cst);
+        atomic_thread_fence(memory_order_seq_cst);
+
+        if (!atomic_load_explicit(&pool->stop, memory_order_relaxed) && !CSTL_thread_pool_has_work(pool)) {
+            CSTL_cond_wait(&pool->wake, &pool->mutex);
+        }
+
+        atomic_fetch_sub_explicit(&pool->sleepers, 1, memory_order_relaxed);
+        CSTL_mutex_unlock(&pool->mutex);
+        spins = 0;
+    }
+
+    CSTL_current_worker = NULL;
+    CSTL_thread_proc_return;
+}
+
+static void CSTL_thread_pin(CSTL_Thread thread, size_t processor) {
+#if defined(_WIN32)
+    if (processor < sizeof(DWORD_PTR) * 8) {
+        SetThreadAffinityMask(thread, (DWORD_PTR)1 << processor);
+    }
+#elif defined(__linux__)
+    if (processor < CPU_SETSIZE) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(processor, &set);
+        pthread_setaffinity_np(thread, sizeof(set), &set);
+    }
+#else
+    (void)thread, (void)processor;
+#endif
+}
+
+// Stops and joins the first `count` workers.
+static void CSTL_thread_pool_stop(CSTL_ThreadPool* pool, size_t count) {
+    CSTL_mutex_lock(&pool->mutex);
+    atomic_store_explicit(&pool->stop, true, memory_order_relaxed);
+    CSTL_cond_broadcast(&pool->wake);
+    CSTL_mutex_unlock(&pool->mutex);
+
+    for (size_t i = 0; i < count; ++i) {
+        CSTL_thread_join(pool->workers[i].thread);
+    }
+}
+
+CSTL_ThreadPool* CSTL_thread_pool_create(size_t thread_count, CSTL_Alloc* alloc) {
+    CSTL_ThreadPoolConfig config = { thread_count, false, 0 };
+    return CSTL_thread_pool_create_with(&config, alloc);
+}
+
+CSTL_ThreadPool* CSTL_thread_pool_create_with(const CSTL_ThreadPoolConfig* config, CSTL_Alloc* alloc) {
+    size_t processors   = CSTL_hardware_concurrency();
+    size_t thread_count = config->thread_count != 0 ? config->thread_count : processors;
+
+    if (thread_count > (SIZE_MAX - sizeof(CSTL_ThreadPool)) / sizeof(CSTL_Worker)) {
+        return NULL;
+    }
+
+    CSTL_ThreadPool* pool = (CSTL_ThreadPool*)CSTL_allocate(CSTL_thread_pool_bytes(thread_count), _Alignof(CSTL_ThreadPool), alloc);
+
+    if (pool == NULL) {
+        return NULL;
+    }
+
+    if (!CSTL_mutex_init(&pool->mutex)) {
+        goto free_pool;
+    }
+
+    if (!CSTL_cond_init(&pool->wake)) {
+        goto destroy_mutex;
+    }
+
+    atomic_init(&pool->queue_count, 0);
+    atomic_init(&pool->sleepers, 0);
+    atomic_init(&pool->submitted, 0);
+    atomic_init(&pool->stop, false);
+
+    pool->queue          = NULL;
+    pool->queue_head     = 0;
+    pool->queue_capacity = 0;
+    pool->alloc          = alloc;
+    pool->thread_count   = thread_count;
+
+    for (size_t i = 0; i < thread_count - 1; ++i) {
+        CSTL_task_deque_init(&pool->workers[i].deque);
+        pool->workers[i].pool = pool;
+        pool->workers[i].seed = (uint64_t)(i + 1) * 0x9E3779B97F4A7C15u;
+    }
+
+    for (size_t i = 0; i < thread_count - 1; ++i) {
+        CSTL_Worker* worker = &pool->workers[i];
+
+        if (!CSTL_thread_start(&worker->thread, &CSTL_thread_pool_worker, worker)) {
+            CSTL_thread_pool_stop(pool, i);
+            goto destroy_wake;
+        }
+
+        if (config->pin_threads) {
+            CSTL_thread_pin(worker->thread, (config->first_processor + 1 + i) % processors);
+        }
+    }
+
+    return pool;
+
+destroy_wake:
+    CSTL_cond_destroy(&pool->wake);
+destroy_mutex:
+    CSTL_mutex_destroy(&pool->mutex);
+free_pool:
+    CSTL_free(pool, CSTL_thread_pool_bytes(thread_count), _Alignof(CSTL_ThreadPool), alloc);
+    return NULL;
+}
+
+void CSTL_thread_pool_destroy(CSTL_ThreadPool* pool, CSTL_Alloc* alloc) {
+    if (pool == NULL) {
+        return;
+    }
+
+    // Help with the submitted tasks, which may submit more.
+    while (atomic_load_explicit(&pool->submitted, memory_order_acquire) != 0) {
+        CSTL_Task task;
+
+        if (CSTL_thread_pool_find(pool, NULL, &task)) {
+            CSTL_task_run(pool, &task);
+        } else {
+            CSTL_thread_yield();
+        }
+    }
+
+    size_t thread_count = pool->thread_count;
+
+    CSTL_thread_pool_stop(pool, thread_count - 1);
+
+    if (pool->queue != NULL) {
+        CSTL_free(pool->queue, pool->queue_capacity * sizeof(CSTL_Task), _Alignof(CSTL_Task), pool->alloc);
+    }
+
+    CSTL_cond_destroy(&pool->wake);
+    CSTL_mutex_destroy(&pool->mutex);
+
+    CSTL_free(pool, CSTL_thread_pool_bytes(thread_count), _Alignof(CSTL_ThreadPool), alloc);
+}
+
+size_t CSTL_thread_pool_thread_count(const CSTL_ThreadPool* pool) {
+    return pool != NULL ? pool->thread_count : 1;
+}
+
+bool CSTL_thread_pool_submit(CSTL_ThreadPool* pool, CSTL_WorkFn func, void* context) {
+    if (pool == NULL) {
+        func(context);
+        return true;
+    }
+
+    CSTL_Task task    = { func, context, NULL };
+    CSTL_Worker* self = CSTL_thread_pool_self(pool);
+
+    atomic_fetch_add_explicit(&pool->submitted, 1, memory_order_relaxed);
+
+    if (self != NULL && CSTL_task_deque_push(&self->deque, &task)) {
+        CSTL_thread_pool_wake(pool);
+        return true;
+    }
+
+    if (CSTL_queue_push(pool, &task, 1)) {
+        return true;
+    }
+
+    atomic_fetch_sub_explicit(&pool->submitted, 1, memory_order_relaxed);
+    return false;
+}
+
+void CSTL_task_group_construct(CSTL_TaskGroup* new_instance, CSTL_ThreadPool* pool) {
+    new_instance->pool = pool;
+    atomic_init(&new_instance->pending, 0);
+}
+
+void CSTL_task_group_fork(CSTL_TaskGroup* group, CSTL_WorkFn func, void* context) {
+    CSTL_ThreadPool* pool = group->pool;
+
+    if (pool == NULL) {
+        func(context);
+        return;
+    }
+
+    CSTL_Task task    = { func, context, group };
+    CSTL_Worker* self = CSTL_thread_pool_self(pool);
+
+    atomic_fetch_add_explicit(&group->pending, 1, memory_order_relaxed);
+
+    if (self != NULL ? CSTL_task_deque_push(&self->deque, &task) : CSTL_queue_push(pool, &task, 1)) {
+        if (self != NULL) {
+            CSTL_thread_pool_wake(pool);
+        }
+
+        return;
+    }
+
+    atomic_fetch_sub_explicit(&group->pending, 1, memory_order_relaxed);
+    func(context);
+}
+
+void CSTL_task_group_join(CSTL_TaskGroup* group) {
+    CSTL_ThreadPool* pool = group->pool;
+
+    if (pool == NULL) {
+        return;
+    }
+
+    CSTL_Worker* self = CSTL_thread_pool_self(pool);
+    unsigned spins    = 0;
+
+    while (atomic_load_explicit(&group->pending, memory_order_acquire) != 0) {
+        CSTL_Task task;
+
+        if (CSTL_thread_pool_find(pool, self, &task)) {
+            CSTL_task_run(pool, &task);
+            spins = 0;
+        } else if (spins++ < CSTL_worker_spins) {
+            CSTL_cpu_relax();
+        } else {
+            CSTL_thread_yield();
+        }
+    }
+}
+
+typedef struct CSTL_RunState {
+    atomic_size_t next; // next task index to hand out
+    CSTL_TaskFn task;
+    void* context;
+    size_t task_count;
+} CSTL_RunState;
+
+// Runs tasks until none are left to hand out.
+static void CSTL_run_drain(void* param) {
+    CSTL_RunState* state = (CSTL_RunState*)param;
+
+    for (;;) {
+        size_t index = atomic_fetch_add_explicit(&state->next, 1, memory_order_relaxed);
+
+        if (index >= state->task_count) {
+            return;
+        }
+
+        state->task(index, state->context);
+    }
+}
+
+void CSTL_thread_pool_run(CSTL_ThreadPool* pool, size_t task_count, CSTL_TaskFn task, void* context) {
+    if (pool == NULL || task_count < 2 || pool->thread_count == 1) {
+        for (size_t index = 0; index < task_count; ++index) {
+            task(index, context);
+        }
+
+        return;
+    }
+
+    CSTL_RunState state;
+
+    atomic_init(&state.next, 0);
+    state.task       = task;
+    state.context    = context;
+    state.task_count = task_count;
+
+    size_t helpers = (pool->thread_count < task_count ? pool->thread_count : task_count) - 1;
+
+    CSTL_TaskGroup group;
+    CSTL_task_group_construct(&group, pool);
+
+    if (CSTL_thread_pool_self(pool) != NULL) {
+        for (size_t i = 0; i < helpers; ++i) {
+            CSTL_task_group_fork(&group, &CSTL_run_drain, &state);
+        }
+    } else {
+        // One lock and one broadcast for all helpers.
+        CSTL_Task helper = { &CSTL_run_drain, &state, &group };
+
+        atomic_store_explicit(&group.pending, helpers, memory_order_relaxed);
+
+        if (!CSTL_queue_push(pool, &helper, helpers)) {
+            atomic_store_explicit(&group.pending, 0, memory_order_relaxed);
+        }
+    }
+
+    CSTL_run_drain(&state);
+    CSTL_task_group_join(&group);
+}
@@ -0,0 +1,180 @@
+#pragma once
+
+#ifndef CSTL_THREAD_POOL_H
+#define CSTL_THREAD_POOL_H
+
+#include "alloc.h"
+
+#if defined(__cplusplus)
+#include <atomic>
+#include <cstddef>
+extern "C" {
+#else
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#endif
+
+/**
+ * Work-stealing task scheduler.
+ * 
+ * Every worker thread owns a deque of tasks. A worker pushes and pops
+ * tasks it forks at the back of its own deque, so recently forked tasks run
+ * first while their data is still in cache, and idle workers steal from the
+ * front of other deques, taking the oldest and usually largest pieces of work.
+ * Tasks from threads outside the pool go through a shared queue.
+ * Workers sleep when there is nothing to run.
+ * 
+ * Share one pool between all parallel algorithms instead of starting
+ * threads per call, so the total thread count stays under control.
+ * 
+ * Opaque, created with `CSTL_thread_pool_create` or `CSTL_thread_pool_create_with`.
+ * 
+ */
+typedef struct CSTL_ThreadPool CSTL_ThreadPool;
+
+/**
+ * Runs task `index` of a call to `CSTL_thread_pool_run`.
+ * 
+ */
+typedef void (*CSTL_TaskFn)(size_t index, void* context);
+
+/**
+ * Runs a task passed to `CSTL_thread_pool_submit` or `CSTL_task_group_fork`.
+ * 
+ */
+typedef void (*CSTL_WorkFn)(void* context);
+
+/**
+ * Thread pool settings.
+ * 
+ */
+typedef struct CSTL_ThreadPoolConfig {
+    /**
+     * Number of threads that run tasks, the calling thread included,
+     * so `thread_count - 1` worker threads are started.
+     * 
+     * 0 uses one thread per logical processor.
+     * 
+     */
+    size_t thread_count;
+
+    /**
+     * Whether to pin every worker thread to one logical processor.
+     * 
+     * Worker `i` is pinned to processor `(first_processor + 1 + i) % n`,
+     * where `n` is the number of logical processors, leaving `first_processor`
+     * for the calling thread. Has no effect where unsupported.
+     * 
+     */
+    bool pin_threads;
+    size_t first_processor;
+} CSTL_ThreadPoolConfig;
+
+/**
+ * Fork-join group of tasks.
+ * 
+ * Do not manipulate the members directly, use the associated functions!
+ * 
+ */
+typedef struct CSTL_TaskGroup {
+    CSTL_ThreadPool* pool;
+#if defined(__cplusplus)
+    std::atomic<size_t> pending;
+#else
+    atomic_size_t pending;
+#endif
+} CSTL_TaskGroup;
+
+/**
+ * Creates a pool that runs tasks on `thread_count` threads, the calling thread
+ * included, as if by `CSTL_thread_pool_create_with` without pinning.
+ * 
+ */
+CSTL_ThreadPool* CSTL_thread_pool_create(size_t thread_count, CSTL_Alloc* alloc);
+
+/**
+ * Creates a pool with the settings in `config`.
+ * 
+ * `alloc` is also used while the pool runs, and must stay valid until
+ * the pool is destroyed.
+ * 
+ * Returns `NULL` if the allocation or starting a thread fails.
+ * 
+ */
+CSTL_ThreadPool* CSTL_thread_pool_create_with(const CSTL_ThreadPoolConfig* config, CSTL_Alloc* alloc);
+
+/**
+ * Waits for all submitted tasks, then stops and joins the worker threads
+ * and frees the pool.
+ * 
+ * Must not be called from a task or while tasks are being forked or submitted.
+ * 
+ */
+void CSTL_thread_pool_destroy(CSTL_ThreadPool* pool, CSTL_Alloc* alloc);
+
+/**
+ * Returns the number of threads that run tasks, the calling thread included.
+ * 
+ * A null `pool` has one thread.
+ * 
+ */
+size_t CSTL_thread_pool_thread_count(const CSTL_ThreadPool* pool);
+
+/**
+ * Calls `task(index, context)` for every `index` in `[0, task_count)`,
+ * in an unspecified order and on any of the pool's threads,
+ * and returns once all calls have returned.
+ * 
+ * Task indices are handed out one atomic increment at a time by up to one
+ * forked task per thread, and the calling thread takes part. Calls from inside
+ * a task are run the same way, by the threads that are not busy.
+ * 
+ * Everything the tasks wrote is visible to the caller afterwards.
+ * 
+ * If `pool` is null, the tasks run on the calling thread.
+ * 
+ */
+void CSTL_thread_pool_run(CSTL_ThreadPool* pool, size_t task_count, CSTL_TaskFn task, void* context);
+
+/**
+ * Queues `func(context)` to run on the pool without waiting for it.
+ * If `pool` is null, the task runs immediately on the calling thread.
+ * 
+ * If growing the shared queue fails, this function has no effect and returns `false`,
+ * otherwise it returns `true`.
+ * 
+ */
+bool CSTL_thread_pool_submit(CSTL_ThreadPool* pool, CSTL_WorkFn func, void* context);
+
+/**
+ * Initializes the task group pointed to by `new_instance`, whose tasks run on `pool`.
+ * 
+ * If `pool` is null, forked tasks run immediately on the calling thread.
+ * 
+ */
+void CSTL_task_group_construct(CSTL_TaskGroup* new_instance, CSTL_ThreadPool* pool);
+
+/**
+ * Queues `func(context)` to run on the group's pool, as part of the group.
+ * 
+ * If there is no room to queue it, the task runs immediately on the calling thread.
+ * 
+ */
+void CSTL_task_group_fork(CSTL_TaskGroup* group, CSTL_WorkFn func, void* context);
+
+/**
+ * Returns once every task forked into the group has returned,
+ * running queued tasks on the calling thread while waiting.
+ * 
+ * Everything the tasks wrote is visible to the caller afterwards.
+ * The group can be reused for more tasks.
+ * 
+ */
+void CSTL_task_group_join(CSTL_TaskGroup* group);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
@@ -1,7 +1,9 @@
 #include "type.h"
+#include "internal/char_dispatch.h"
 #include "internal/type_ext.h"
 
 #include <stdint.h>
+#include <string.h>
 #include <limits.h>
 
 CSTL_Type CSTL_define_type(size_t size, size_t alignment) {
@@ -37,3 +39,99 @@ size_t CSTL_sizeof_type(CSTL_Type type) {
 size_t CSTL_alignof_type(CSTL_Type type) {
     return CSTL_type_alignment(type);
 }
+
+static void CSTL_pod_fill_1(void* first, void* last, const void* value) {
+    uint8_t pattern;
+    memcpy(&pattern, value, sizeof(pattern));
+    CSTL_char_fill_1(first, (size_t)((char*)last - (char*)first), pattern);
+}
+
+static void CSTL_pod_fill_2(void* first, void* last, const void* value) {
+    uint16_t pattern;
+    memcpy(&pattern, value, sizeof(pattern));
+    CSTL_char_fill_2(first, (size_t)((char*)last - (char*)first) / sizeof(pattern), pattern);
+}
+
+static void CSTL_pod_fill_4(void* first, void* last, const void* value) {
+    uint32_t pattern;
+    memcpy(&pattern, value, sizeof(pattern));
+    CSTL_char_fill_4(first, (size_t)((char*)last - (char*)first) / sizeof(pattern), pattern);
+}
+
+static void CSTL_pod_fill_8(void* first, void* last, const void* value) {
+    uint64_t pattern;
+    memcpy(&pattern, value, sizeof(pattern));
+
+    for (char* dest = (char*)first; dest != (char*)last; dest += sizeof(pattern)) {
+        memcpy(dest, &pattern, sizeof(pattern));
+    }
+}
+
+// Larger types are filled by `CSTL_type_fill`, which doubles the filled prefix with `memcpy`.
+static CSTL_Fill CSTL_pod_fill(size_t size) {
+    switch (size) {
+    case 1:  return &CSTL_pod_fill_1;
+    case 2:  return &CSTL_pod_fill_2;
+    case 4:  return &CSTL_pod_fill_4;
+    case 8:  return &CSTL_pod_fill_8;
+    default: return NULL;
+    }
+}
+
+#if UINTPTR_MAX > UINT32_MAX
+#define CSTL_pod_fill_pointer &CSTL_pod_fill_8
+#else
+#define CSTL_pod_fill_pointer &CSTL_pod_fill_4
+#endif
+
+// Same packing as `CSTL_define_type`, as a constant expression for valid types.
+#define CSTL_pack_type(size, alignment) ((CSTL_Type)((size) & (alignment) \
+    ? (intptr_t)(size) : -(intptr_t)((size) | (alignment))))
+
+#define CSTL_define_pod(name, type, fill) \
+    const CSTL_PodType name = { \
+        CSTL_pack_type(sizeof(type), _Alignof(type)), \
+        { { { NULL }, NULL, true }, NULL, fill } \
+    }
+
+CSTL_define_pod(CSTL_pod_int8,    int8_t,   &CSTL_pod_fill_1);
+CSTL_define_pod(CSTL_pod_uint8,   uint8_t,  &CSTL_pod_fill_1);
+CSTL_define_pod(CSTL_pod_int16,   int16_t,  &CSTL_pod_fill_2);
+CSTL_define_pod(CSTL_pod_uint16,  uint16_t, &CSTL_pod_fill_2);
+CSTL_define_pod(CSTL_pod_int32,   int32_t,  &CSTL_pod_fill_4);
+CSTL_define_pod(CSTL_pod_uint32,  uint32_t, &CSTL_pod_fill_4);
+CSTL_define_pod(CSTL_pod_int64,   int64_t,  &CSTL_pod_fill_8);
+CSTL_define_pod(CSTL_pod_uint64,  uint64_t, &CSTL_pod_fill_8);
+CSTL_define_pod(CSTL_pod_float,   float,    &CSTL_pod_fill_4);
+CSTL_define_pod(CSTL_pod_double,  double,   &CSTL_pod_fill_8);
+CSTL_define_pod(CSTL_pod_pointer, void*,    CSTL_pod_fill_pointer);
+
+#define CSTL_define_comp(name, type) \
+    static bool name##_eq(const void* lhs, const void* rhs) { \
+        return *(const type*)lhs == *(const type*)rhs; \
+    } \
+    static bool name##_lt(const void* lhs, const void* rhs) { \
+        return *(const type*)lhs < *(const type*)rhs; \
+    } \
+    const CSTL_CompType name = { &name##_eq, &name##_lt }
+
+CSTL_define_comp(CSTL_comp_int8,    int8_t);
+CSTL_define_comp(CSTL_comp_uint8,   uint8_t);
+CSTL_define_comp(CSTL_comp_int16,   int16_t);
+CSTL_define_comp(CSTL_comp_uint16,  uint16_t);
+CSTL_define_comp(CSTL_comp_int32,   int32_t);
+CSTL_define_comp(CSTL_comp_uint32,  uint32_t);
+CSTL_define_comp(CSTL_comp_int64,   int64_t);
+CSTL_define_comp(CSTL_comp_uint64,  uint64_t);
+CSTL_define_comp(CSTL_comp_float,   float);
+CSTL_define_comp(CSTL_comp_double,  double);
+CSTL_define_comp(CSTL_comp_pointer, uintptr_t);
+
+CSTL_PodType CSTL_pod_type(size_t size, size_t alignment) {
+    CSTL_PodType pod = {
+        CSTL_define_type(size, alignment),
+        { { { NULL }, NULL, true }, NULL, CSTL_pod_fill(size) }
+    };
+
+    return pod;
+}
@@ -72,6 +72,9 @@ typedef void (*CSTL_Fill)(void* first, void* last, const void* value);
  * Function table for a type that can be destroyed by calling `drop`
  * on a range of objects of that type.
  * 
+ * If `drop` is `NULL`, the type is trivially destructible and
+ * destroying its objects does nothing.
+ * 
  */
 typedef struct CSTL_DropType {
     CSTL_Drop drop;
@@ -81,10 +84,22 @@ typedef struct CSTL_DropType {
  * Function table for a type that can be moved by calling `move`
  * on a range of objects of that type to another range, or destroyed.
  * 
+ * If `move` is `NULL`, objects are moved with `memcpy` and the
+ * source objects are left unchanged. This is only valid for types
+ * whose objects may be duplicated bytewise, such as those that are
+ * also trivially destructible.
+ * 
+ * If `trivially_relocatable` is `true` or `move` is `NULL`, an object
+ * that is moved and then immediately destroyed may instead be copied
+ * bytewise with `memcpy` or `memmove`, without calling `move` or `drop`.
+ * Containers use this when growing, inserting and erasing, where whole
+ * ranges are shifted with a single `memmove`.
+ * 
  */
 typedef struct CSTL_MoveType {
     CSTL_DropType drop_type;
     CSTL_Move move;
+    bool trivially_relocatable;
 } CSTL_MoveType;
 
 /**
@@ -93,6 +108,10 @@ typedef struct CSTL_MoveType {
  * 
  * It is valid for `copy` to bind the same function as `move_type.move`.
  * 
+ * If `copy` is `NULL`, objects are copied with `memcpy`. If `fill` is `NULL`,
+ * ranges are filled by copying the value with `memcpy`. A trivially copyable
+ * type leaves every function in the table `NULL`.
+ * 
  */
 typedef struct CSTL_CopyType {
     CSTL_MoveType move_type;
@@ -153,6 +172,14 @@ typedef struct CSTL_CompType {
     CSTL_IsLt is_lt;
 } CSTL_CompType;
 
+/**
+ * Reference to a const `CSTL_CompType`.
+ * 
+ * Must not be null.
+ * 
+ */
+typedef const CSTL_CompType* CSTL_CompTypeCRef;
+
 /**
  * Obtain a hash for an instance of an object.
  * 
@@ -171,6 +198,14 @@ typedef struct CSTL_HashType {
     CSTL_Hash hash;
 } CSTL_HashType;
 
+/**
+ * Reference to a const `CSTL_HashType`.
+ * 
+ * Must not be null.
+ * 
+ */
+typedef const CSTL_HashType* CSTL_HashTypeCRef;
+
 /**
  * Obtain a pseudohandle to the size and alignment of a C type.
  * 
@@ -195,6 +230,66 @@ size_t CSTL_sizeof_type(CSTL_Type type);
  */
 size_t CSTL_alignof_type(CSTL_Type type);
 
+/**
+ * Size, alignment and function table of a trivially copyable type.
+ * 
+ * Objects are copied and moved with `memcpy`, relocated with `memmove`,
+ * and destroying them does nothing. Ranges are filled with a vectorised
+ * pattern fill where the size of the type allows it.
+ * 
+ * Invalid if `type` is equal to `NULL`.
+ * 
+ */
+typedef struct CSTL_PodType {
+    CSTL_Type type;
+    CSTL_CopyType copy;
+} CSTL_PodType;
+
+/**
+ * Ready-made tables for built-in scalar types.
+ * 
+ */
+extern const CSTL_PodType CSTL_pod_int8;
+extern const CSTL_PodType CSTL_pod_uint8;
+extern const CSTL_PodType CSTL_pod_int16;
+extern const CSTL_PodType CSTL_pod_uint16;
+extern const CSTL_PodType CSTL_pod_int32;
+extern const CSTL_PodType CSTL_pod_uint32;
+extern const CSTL_PodType CSTL_pod_int64;
+extern const CSTL_PodType CSTL_pod_uint64;
+extern const CSTL_PodType CSTL_pod_float;
+extern const CSTL_PodType CSTL_pod_double;
+extern const CSTL_PodType CSTL_pod_pointer;
+
+/**
+ * Ready-made orderings for built-in scalar types, comparing with `==` and `<`.
+ * 
+ * Algorithms recognise these tables by address and may take faster paths
+ * for them, such as radix sorting. Floating point values must not be NaN.
+ * 
+ */
+extern const CSTL_CompType CSTL_comp_int8;
+extern const CSTL_CompType CSTL_comp_uint8;
+extern const CSTL_CompType CSTL_comp_int16;
+extern const CSTL_CompType CSTL_comp_uint16;
+extern const CSTL_CompType CSTL_comp_int32;
+extern const CSTL_CompType CSTL_comp_uint32;
+extern const CSTL_CompType CSTL_comp_int64;
+extern const CSTL_CompType CSTL_comp_uint64;
+extern const CSTL_CompType CSTL_comp_float;
+extern const CSTL_CompType CSTL_comp_double;
+extern const CSTL_CompType CSTL_comp_pointer;
+
+/**
+ * Obtain the size, alignment and function table of a trivially copyable
+ * type, such as a plain C struct.
+ * 
+ * The requirements on `size` and `alignment` are the same as for
+ * `CSTL_define_type`. If they are broken, the returned table is invalid.
+ * 
+ */
+CSTL_PodType CSTL_pod_type(size_t size, size_t alignment);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -0,0 +1,1034 @@
+#include "unicode.h"
+
+#include "internal/char_simd.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Code units converted per ASCII block.
+#define CSTL_unicode_block ((size_t)16)
+
+// The transcoding loop is expanded for every pair of code unit widths.
+#if defined(_MSC_VER) && !defined(__clang__)
+#define CSTL_unicode_inline __forceinline
+#elif defined(__GNUC__) || defined(__clang__)
+#define CSTL_unicode_inline inline __attribute__((always_inline))
+#else
+#define CSTL_unicode_inline inline
+#endif
+
+// Decodes the UTF-8 sequence at `src`, of which `left >= 1` units are readable.
+// Returns its length, or 0 if it is ill-formed.
+static inline size_t CSTL_utf8_decode(const uint8_t* src, size_t left, uint32_t* cp) {
+    uint32_t lead = src[0];
+
+    if (lead < 0x80) {
+        *cp = lead;
+        return 1;
+    }
+
+    if (lead < 0xC2) { // continuation bytes and overlong 2 byte sequences
+        return 0;
+    }
+
+    if (lead < 0xE0) {
+        if (left < 2 || (src[1] & 0xC0) != 0x80) {
+            return 0;
+        }
+
+        *cp = (lead & 0x1F) << 6 | (src[1] & 0x3Fu);
+        return 2;
+    }
+
+    if (lead < 0xF0) {
+        // Excludes overlong sequences after 0xE0 and surrogates after 0xED.
+        uint32_t lo = lead == 0xE0 ? 0xA0 : 0x80;
+        uint32_t hi = lead == 0xED ? 0x9F : 0xBF;
+
+        if (left < 3 || src[1] < lo || src[1] > hi || (src[2] & 0xC0) != 0x80) {
+            return 0;
+        }
+
+        *cp = (lead & 0x0F) << 12 | (src[1] & 0x3Fu) << 6 | (src[2] & 0x3Fu);
+        return 3;
+    }
+
+    if (lead < 0xF5) {
+        // Excludes overlong sequences after 0xF0 and code points above U+10FFFF after 0xF4.
+        uint32_t lo = lead == 0xF0 ? 0x90 : 0x80;
+        uint32_t hi = lead == 0xF4 ? 0x8F : 0xBF;
+
+        if (left < 4 || src[1] < lo || src[1] > hi || (src[2] & 0xC0) != 0x80 || (src[3] & 0xC0) != 0x80) {
+            return 0;
+        }
+
+        *cp = (lead & 0x07) << 18 | (src[1] & 0x3Fu) << 12 | (src[2] & 0x3Fu) << 6 | (src[3] & 0x3Fu);
+        return 4;
+    }
+
+    return 0;
+}
+
+static inline size_t CSTL_utf16_decode(const uint16_t* src, size_t left, uint32_t* cp) {
+    uint32_t unit = src[0];
+
+    if (unit - 0xD800 >= 0x800) {
+        *cp = unit;
+        return 1;
+    }
+
+    if (unit >= 0xDC00 || left < 2 || src[1] - 0xDC00u >= 0x400) { // unpaired surrogates
+        return 0;
+    }
+
+    *cp = 0x10000 + ((unit - 0xD800) << 10) + (src[1] - 0xDC00u);
+    return 2;
+}
+
+static inline size_t CSTL_utf32_decode(const uint32_t* src, uint32_t* cp) {
+    uint32_t unit = src[0];
+
+    if (unit - 0xD800 < 0x800 || unit > 0x10FFFF) {
+        return 0;
+    }
+
+    *cp = unit;
+    return 1;
+}
+
+// Decodes the code point at `src` in the encoding with `width` byte code units.
+static inline size_t CSTL_unicode_decode(const unsigned char* src, size_t left, size_t width, uint32_t* cp) {
+    switch (width) {
+    case 1:  return CSTL_utf8_decode((const uint8_t*)src, left, cp);
+    case 2:  return CSTL_utf16_decode((const uint16_t*)src, left, cp);
+    default: return CSTL_utf32_decode((const uint32_t*)src, cp);
+    }
+}
+
+// Decodes the code point at `src` in input that is known to be well-formed.
+static inline size_t CSTL_unicode_decode_valid(const unsigned char* src, size_t width, uint32_t* cp) {
+    if (width == 1) {
+        uint32_t lead = src[0];
+
+        if (lead < 0x80) {
+            *cp = lead;
+            return 1;
+        }
+
+        if (lead < 0xE0) {
+            *cp = (lead & 0x1F) << 6 | (src[1] & 0x3Fu);
+            return 2;
+        }
+
+        if (lead < 0xF0) {
+            *cp = (lead & 0x0F) << 12 | (src[1] & 0x3Fu) << 6 | (src[2] & 0x3Fu);
+            return 3;
+        }
+
+        *cp = (lead & 0x07) << 18 | (src[1] & 0x3Fu) << 12 | (src[2] & 0x3Fu) << 6 | (src[3] & 0x3Fu);
+        return 4;
+    }
+
+    if (width == 2) {
+        const uint16_t* units = (const uint16_t*)src;
+
+        if (units[0] - 0xD800u >= 0x400) { // anything but a high surrogate
+            *cp = units[0];
+            return 1;
+        }
+
+        *cp = 0x10000 + ((units[0] - 0xD800u) << 10) + (units[1] - 0xDC00u);
+        return 2;
+    }
+
+    *cp = *(const uint32_t*)src;
+    return 1;
+}
+
+static inline size_t CSTL_unicode_encoded_length(uint32_t cp, size_t width) {
+    switch (width) {
+    case 1:  return cp < 0x80 ? 1 : cp < 0x800 ? 2 : cp < 0x10000 ? 3 : 4;
+    case 2:  return cp < 0x10000 ? 1 : 2;
+    default: return 1;
+    }
+}
+
+// Encodes a valid code point at `dest`, returns the number of code units written.
+static inline size_t CSTL_unicode_encode(uint32_t cp, unsigned char* dest, size_t width) {
+    if (width == 1) {
+        if (cp < 0x80) {
+            dest[0] = (unsigned char)cp;
+            return 1;
+        }
+
+        if (cp < 0x800) {
+            dest[0] = (unsigned char)(0xC0 | cp >> 6);
+            dest[1] = (unsigned char)(0x80 | (cp & 0x3F));
+            return 2;
+        }
+
+        if (cp < 0x10000) {
+            dest[0] = (unsigned char)(0xE0 | cp >> 12);
+            dest[1] = (unsigned char)(0x80 | (cp >> 6 & 0x3F));
+            dest[2] = (unsigned char)(0x80 | (cp & 0x3F));
+            return 3;
+        }
+
+        dest[0] = (unsigned char)(0xF0 | cp >> 18);
+        dest[1] = (unsigned char)(0x80 | (cp >> 12 & 0x3F));
+        dest[2] = (unsigned char)(0x80 | (cp >> 6 & 0x3F));
+        dest[3] = (unsigned char)(0x80 | (cp & 0x3F));
+        return 4;
+    }
+
+    if (width == 2 && cp >= 0x10000) {
+        CSTL_char_store(dest, 0xD800 + ((cp - 0x10000) >> 10), 2);
+        CSTL_char_store(dest + 2, 0xDC00 + (cp & 0x3FF), 2);
+        return 2;
+    }
+
+    CSTL_char_store(dest, cp, width);
+    return 1;
+}
+
+#ifdef CSTL_char_sse2
+// Loads 16 code units, narrows them to bytes and returns whether they are all ASCII.
+static inline bool CSTL_sse2_ascii_load(const unsigned char* src, size_t width, __m128i* bytes) {
+    __m128i zero = _mm_setzero_si128();
+
+    switch (width) {
+    case 1: {
+        *bytes = _mm_loadu_si128((const __m128i*)src);
+        return _mm_movemask_epi8(*bytes) == 0;
+    }
+    case 2: {
+        __m128i lo   = _mm_loadu_si128((const __m128i*)src);
+        __m128i hi   = _mm_loadu_si128((const __m128i*)(src + 16));
+        __m128i high = _mm_and_si128(_mm_or_si128(lo, hi), _mm_set1_epi16((short)0xFF80));
+
+        *bytes = _mm_packus_epi16(lo, hi);
+        return _mm_movemask_epi8(_mm_cmpeq_epi16(high, zero)) == 0xFFFF;
+    }
+    default: {
+        __m128i v0   = _mm_loadu_si128((const __m128i*)src);
+        __m128i v1   = _mm_loadu_si128((const __m128i*)(src + 16));
+        __m128i v2   = _mm_loadu_si128((const __m128i*)(src + 32));
+        __m128i v3   = _mm_loadu_si128((const __m128i*)(src + 48));
+        __m128i high = _mm_or_si128(_mm_or_si128(v0, v1), _mm_or_si128(v2, v3));
+
+        high   = _mm_and_si128(high, _mm_set1_epi32((int)0xFFFFFF80));
+        *bytes = _mm_packus_epi16(_mm_packs_epi32(v0, v1), _mm_packs_epi32(v2, v3));
+        return _mm_movemask_epi8(_mm_cmpeq_epi32(high, zero)) == 0xFFFF;
+    }
+    }
+}
+
+// Widens 16 ASCII bytes to code units of `width` and stores them.
+static inline void CSTL_sse2_ascii_store(unsigned char* dest, size_t width, __m128i bytes) {
+    __m128i zero = _mm_setzero_si128();
+
+    switch (width) {
+    case 1:
+        _mm_storeu_si128((__m128i*)dest, bytes);
+        break;
+    case 2:
+        _mm_storeu_si128((__m128i*)dest, _mm_unpacklo_epi8(bytes, zero));
+        _mm_storeu_si128((__m128i*)(dest + 16), _mm_unpackhi_epi8(bytes, zero));
+        break;
+    default: {
+        __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+        __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+
+        _mm_storeu_si128((__m128i*)dest, _mm_unpacklo_epi16(lo, zero));
+        _mm_storeu_si128((__m128i*)(dest + 16), _mm_unpackhi_epi16(lo, zero));
+        _mm_storeu_si128((__m128i*)(dest + 32), _mm_unpacklo_epi16(hi, zero));
+        _mm_storeu_si128((__m128i*)(dest + 48), _mm_unpackhi_epi16(hi, zero));
+        break;
+    }
+    }
+}
+#endif
+
+#ifdef CSTL_char_neon
+static inline bool CSTL_neon_ascii_load(const unsigned char* src, size_t width, uint8x16_t* bytes) {
+    switch (width) {
+    case 1: {
+        *bytes = vld1q_u8(src);
+        return CSTL_neon_mask(vtstq_u8(*bytes, vdupq_n_u8(0x80))) == 0;
+    }
+    case 2: {
+        uint16x8_t lo   = vld1q_u16((const uint16_t*)src);
+        uint16x8_t hi   = vld1q_u16((const uint16_t*)(src + 16));
+        uint16x8_t high = vtstq_u16(vorrq_u16(lo, hi), vdupq_n_u16(0xFF80));
+
+        *bytes = vcombine_u8(vmovn_u16(lo), vmovn_u16(hi));
+        return CSTL_neon_mask(vreinterpretq_u8_u16(high)) == 0;
+    }
+    default: {
+        uint32x4_t v0   = vld1q_u32((const uint32_t*)src);
+        uint32x4_t v1   = vld1q_u32((const uint32_t*)(src + 16));
+        uint32x4_t v2   = vld1q_u32((const uint32_t*)(src + 32));
+        uint32x4_t v3   = vld1q_u32((const uint32_t*)(src + 48));
+        uint32x4_t high = vtstq_u32(vorrq_u32(vorrq_u32(v0, v1), vorrq_u32(v2, v3)), vdupq_n_u32(0xFFFFFF80));
+
+        uint16x8_t lo = vcombine_u16(vmovn_u32(v0), vmovn_u32(v1));
+        uint16x8_t hi = vcombine_u16(vmovn_u32(v2), vmovn_u32(v3));
+
+        *bytes = vcombine_u8(vmovn_u16(lo), vmovn_u16(hi));
+        return CSTL_neon_mask(vreinterpretq_u8_u32(high)) == 0;
+    }
+    }
+}
+
+static inline void CSTL_neon_ascii_store(unsigned char* dest, size_t width, uint8x16_t bytes) {
+    switch (width) {
+    case 1:
+        vst1q_u8(dest, bytes);
+        break;
+    case 2:
+        vst1q_u16((uint16_t*)dest, vmovl_u8(vget_low_u8(bytes)));
+        vst1q_u16((uint16_t*)(dest + 16), vmovl_u8(vget_high_u8(bytes)));
+        break;
+    default: {
+        uint16x8_t lo = vmovl_u8(vget_low_u8(bytes));
+        uint16x8_t hi = vmovl_u8(vget_high_u8(bytes));
+
+        vst1q_u32((uint32_t*)dest, vmovl_u16(vget_low_u16(lo)));
+        vst1q_u32((uint32_t*)(dest + 16), vmovl_u16(vget_high_u16(lo)));
+        vst1q_u32((uint32_t*)(dest + 32), vmovl_u16(vget_low_u16(hi)));
+        vst1q_u32((uint32_t*)(dest + 48), vmovl_u16(vget_high_u16(hi)));
+        break;
+    }
+    }
+}
+#endif
+
+// Converts a block of `CSTL_unicode_block` code units if they are all ASCII,
+// which map one to one between all encodings. Only checks them if `dest` is null.
+static inline bool CSTL_ascii_block(const unsigned char* src, size_t src_width, unsigned char* dest, size_t dest_width) {
+#if defined(CSTL_char_sse2)
+    __m128i bytes;
+
+    if (!CSTL_sse2_ascii_load(src, src_width, &bytes)) {
+        return false;
+    }
+
+    if (dest != NULL) {
+        CSTL_sse2_ascii_store(dest, dest_width, bytes);
+    }
+
+    return true;
+#elif defined(CSTL_char_neon)
+    uint8x16_t bytes;
+
+    if (!CSTL_neon_ascii_load(src, src_width, &bytes)) {
+        return false;
+    }
+
+    if (dest != NULL) {
+        CSTL_neon_ascii_store(dest, dest_width, bytes);
+    }
+
+    return true;
+#else
+    uint32_t high = 0;
+
+    for (size_t i = 0; i != CSTL_unicode_block; ++i) {
+        high |= CSTL_char_load(src + i * src_width, src_width);
+    }
+
+    if (high >= 0x80) {
+        return false;
+    }
+
+    if (dest != NULL) {
+        for (size_t i = 0; i != CSTL_unicode_block; ++i) {
+            CSTL_char_store(dest + i * dest_width, CSTL_char_load(src + i * src_width, src_width), dest_width);
+        }
+    }
+
+    return true;
+#endif
+}
+
+// Converts `count` code units of `src_width` bytes to code units of `dest_width` bytes,
+// or only measures the output if `dest` is null. Skips all checks if `validated`.
+static CSTL_unicode_inline CSTL_UnicodeResult CSTL_transcode(const void* src, size_t count, size_t src_width, void* dest, size_t dest_width, bool validated) {
+    const unsigned char* in = (const unsigned char*)src;
+    unsigned char* out      = (unsigned char*)dest;
+
+    CSTL_UnicodeResult result = { 0, 0, false };
+
+    size_t i = 0;
+    size_t j = 0;
+
+    while (i != count) {
+        if (count - i >= CSTL_unicode_block) {
+            if (CSTL_ascii_block(in + i * src_width, src_width, out != NULL ? out + j * dest_width : NULL, dest_width)) {
+                i += CSTL_unicode_block;
+                j += CSTL_unicode_block;
+                continue;
+            }
+        }
+
+        // Decode the rest of a mixed block one code point at a time, and keep going
+        // until an ASCII code point, which may start a run, before looking for ASCII again.
+        size_t stop = count - i > CSTL_unicode_block ? i + CSTL_unicode_block : count;
+
+        while (i != count) {
+            uint32_t cp;
+            size_t length = validated ? CSTL_unicode_decode_valid(in + i * src_width, src_width, &cp)
+                                      : CSTL_unicode_decode(in + i * src_width, count - i, src_width, &cp);
+
+            if (length == 0) {
+                result.read    = i;
+                result.written = j;
+                return result;
+            }
+
+            i += length;
+            j += out != NULL ? CSTL_unicode_encode(cp, out + j * dest_width, dest_width) : CSTL_unicode_encoded_length(cp, dest_width);
+
+            if (i >= stop && cp < 0x80) {
+                break;
+            }
+        }
+    }
+
+    result.read    = i;
+    result.written = j;
+    result.valid   = true;
+    return result;
+}
+
+// Lookup-table UTF-8 validation: every byte is checked together with the one
+// before it by looking up the high and low nibble of the previous byte and
+// the high nibble of the current byte, and AND-ing the three error sets.
+// The continuation bytes that three and four byte sequences need are checked separately.
+#define CSTL_utf8_too_short  0x01 // lead byte followed by a non-continuation byte
+#define CSTL_utf8_too_long   0x02 // ASCII byte followed by a continuation byte
+#define CSTL_utf8_overlong_3 0x04 // 11100000 100_____
+#define CSTL_utf8_too_large  0x08 // 11110100 1001____, 11110100 101_____, 11110101+
+#define CSTL_utf8_surrogate  0x10 // 11101101 101_____
+#define CSTL_utf8_overlong_2 0x20 // 1100000_ 10______
+#define CSTL_utf8_large_1000 0x40 // 11110101+ 1000____
+#define CSTL_utf8_overlong_4 0x40 // 11110000 1000____
+#define CSTL_utf8_two_conts  0x80 // continuation byte not preceded by a lead byte
+#define CSTL_utf8_carry      (CSTL_utf8_too_short | CSTL_utf8_too_long | CSTL_utf8_two_conts)
+
+// 16 byte table lookups need AArch64 on ARM.
+#if defined(CSTL_char_neon) && (defined(__aarch64__) || defined(_M_ARM64))
+#define CSTL_utf8_neon
+#endif
+
+#if defined(CSTL_char_avx2) || defined(CSTL_utf8_neon)
+// Errors by the high nibble of the previous byte.
+static const uint8_t CSTL_utf8_prev_high[16] = {
+    CSTL_utf8_too_long, CSTL_utf8_too_long, CSTL_utf8_too_long, CSTL_utf8_too_long,
+    CSTL_utf8_too_long, CSTL_utf8_too_long, CSTL_utf8_too_long, CSTL_utf8_too_long,
+    CSTL_utf8_two_conts, CSTL_utf8_two_conts, CSTL_utf8_two_conts, CSTL_utf8_two_conts,
+    CSTL_utf8_too_short | CSTL_utf8_overlong_2,
+    CSTL_utf8_too_short,
+    CSTL_utf8_too_short | CSTL_utf8_overlong_3 | CSTL_utf8_surrogate,
+    CSTL_utf8_too_short | CSTL_utf8_too_large | CSTL_utf8_large_1000 | CSTL_utf8_overlong_4,
+};
+
+// Errors by the low nibble of the previous byte.
+static const uint8_t CSTL_utf8_prev_low[16] = {
+    CSTL_utf8_carry | CSTL_utf8_overlong_3 | CSTL_utf8_overlong_2 | CSTL_utf8_overlong_4,
+    CSTL_utf8_carry | CSTL_utf8_overlong_2,
+    CSTL_utf8_carry,
+    CSTL_utf8_carry,
+    CSTL_utf8_carry | CSTL_utf8_too_large,
+    CSTL_utf8_carry | CSTL_utf8_too_large | CSTL_utf8_large_1000,
+    CSTL_utf8_carry | CSTL_utf8_too_large | CSTL_utf8_large_1000,
+    CSTL_utf8_carry | CSTL_utf8_too_large | CSTL_utf8_large_1000,
+    CSTL_utf8_carry | CSTL_utf8_too_large | CSTL_utf8_large_1000,
+    CSTL_utf8_carry | CSTL_utf8_too_large | CSTL_utf8_large_1000,
+    CSTL_utf8_carry | CSTL_utf8_too_large | CSTL_utf8_large_1000,
+    CSTL_utf8_carry | CSTL_utf8_too_large | CSTL_utf8_large_1000,
+    CSTL_utf8_carry | CSTL_utf8_too_large | CSTL_utf8_large_1000,
+    CSTL_utf8_carry | CSTL_utf8_too_large | CSTL_utf8_large_1000 | CSTL_utf8_surrogate,
+    CSTL_utf8_carry | CSTL_utf8_too_large | CSTL_utf8_large_1000,
+    CSTL_utf8_carry | CSTL_utf8_too_large | CSTL_utf8_large_1000,
+};
+
+// Errors by the high nibble of the current byte.
+static const uint8_t CSTL_utf8_cur_high[16] = {
+    CSTL_utf8_too_short, CSTL_utf8_too_short, CSTL_utf8_too_short, CSTL_utf8_too_short,
+    CSTL_utf8_too_short, CSTL_utf8_too_short, CSTL_utf8_too_short, CSTL_utf8_too_short,
+    CSTL_utf8_too_long | CSTL_utf8_overlong_2 | CSTL_utf8_two_conts | CSTL_utf8_overlong_3 | CSTL_utf8_large_1000 | CSTL_utf8_overlong_4,
+    CSTL_utf8_too_long | CSTL_utf8_overlong_2 | CSTL_utf8_two_conts | CSTL_utf8_overlong_3 | CSTL_utf8_too_large,
+    CSTL_utf8_too_long | CSTL_utf8_overlong_2 | CSTL_utf8_two_conts | CSTL_utf8_surrogate | CSTL_utf8_too_large,
+    CSTL_utf8_too_long | CSTL_utf8_overlong_2 | CSTL_utf8_two_conts | CSTL_utf8_surrogate | CSTL_utf8_too_large,
+    CSTL_utf8_too_short, CSTL_utf8_too_short, CSTL_utf8_too_short, CSTL_utf8_too_short,
+};
+#endif
+
+// Backs up from the end of a checked block to the start of the sequence that may
+// continue past it, everything before which is known to be well-formed.
+static inline size_t CSTL_utf8_boundary(const uint8_t* first, size_t off) {
+    size_t start = off;
+
+    while (start != 0 && off - start < 3 && (first[start - 1] & 0xC0) == 0x80) {
+        --start;
+    }
+
+    if (start != 0 && first[start - 1] >= 0xC0) {
+        --start;
+    }
+
+    return start;
+}
+
+#ifdef CSTL_char_avx2
+// Bytes `n` positions back, reaching into the previous block.
+#define CSTL_avx2_utf8_prev(input, prev, n) _mm256_alignr_epi8((input), _mm256_permute2x128_si256((prev), (input), 0x21), 16 - (n))
+
+CSTL_target_avx2 static inline __m256i CSTL_avx2_utf8_errors(__m256i input, __m256i prev, __m256i prev_high, __m256i prev_low, __m256i cur_high) {
+    __m256i nibble = _mm256_set1_epi8(0x0F);
+    __m256i prev1  = CSTL_avx2_utf8_prev(input, prev, 1);
+
+    __m256i special = _mm256_and_si256(
+        _mm256_and_si256(
+            _mm256_shuffle_epi8(prev_high, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble)),
+            _mm256_shuffle_epi8(prev_low, _mm256_and_si256(prev1, nibble))),
+        _mm256_shuffle_epi8(cur_high, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble)));
+
+    // Only the third byte after 111_____ and the fourth after 1111____ reach 0x80.
+    __m256i third  = _mm256_subs_epu8(CSTL_avx2_utf8_prev(input, prev, 2), _mm256_set1_epi8((char)(0xE0 - 0x80)));
+    __m256i fourth = _mm256_subs_epu8(CSTL_avx2_utf8_prev(input, prev, 3), _mm256_set1_epi8((char)(0xF0 - 0x80)));
+    __m256i must   = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8((char)0x80));
+
+    return _mm256_xor_si256(must, special);
+}
+
+// Returns the end of the well-formed prefix found in whole 32 byte blocks,
+// which is at the start of a sequence. `count >= 32`
+CSTL_target_avx2 static inline size_t CSTL_avx2_utf8_prefix(const uint8_t* first, size_t count) {
+    __m256i prev_high = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)CSTL_utf8_prev_high));
+    __m256i prev_low  = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)CSTL_utf8_prev_low));
+    __m256i cur_high  = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)CSTL_utf8_cur_high));
+
+    // Lead bytes too close to the end of a block to be complete within it.
+    __m256i last_max = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, (char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1));
+
+    __m256i prev       = _mm256_setzero_si256();
+    __m256i incomplete = _mm256_setzero_si256();
+    size_t off         = 0;
+
+    for (; count - off >= 32; off += 32) {
+        __m256i input = _mm256_loadu_si256((const __m256i*)(first + off));
+        __m256i error;
+
+        // An ASCII block can only fail by cutting off a sequence from the previous one.
+        if (_mm256_movemask_epi8(input) != 0) {
+            error      = CSTL_avx2_utf8_errors(input, prev, prev_high, prev_low, cur_high);
+            incomplete = _mm256_subs_epu8(input, last_max);
+        } else {
+            error      = incomplete;
+            incomplete = _mm256_setzero_si256();
+        }
+
+        if (!_mm256_testz_si256(error, error)) {
+            break;
+        }
+
+        prev = input;
+    }
+
+    return CSTL_utf8_boundary(first, off);
+}
+#endif
+
+#ifdef CSTL_utf8_neon
+static inline uint8x16_t CSTL_neon_utf8_errors(uint8x16_t input, uint8x16_t prev, uint8x16_t prev_high, uint8x16_t prev_low, uint8x16_t cur_high) {
+    uint8x16_t prev1 = vextq_u8(prev, input, 15);
+
+    uint8x16_t special = vandq_u8(
+        vandq_u8(vqtbl1q_u8(prev_high, vshrq_n_u8(prev1, 4)), vqtbl1q_u8(prev_low, vandq_u8(prev1, vdupq_n_u8(0x0F)))),
+        vqtbl1q_u8(cur_high, vshrq_n_u8(input, 4)));
+
+    uint8x16_t third  = vqsubq_u8(vextq_u8(prev, input, 14), vdupq_n_u8(0xE0 - 0x80));
+    uint8x16_t fourth = vqsubq_u8(vextq_u8(prev, input, 13), vdupq_n_u8(0xF0 - 0x80));
+    uint8x16_t must   = vandq_u8(vorrq_u8(third, fourth), vdupq_n_u8(0x80));
+
+    return veorq_u8(must, special);
+}
+
+// `count >= 16`
+static inline size_t CSTL_neon_utf8_prefix(const uint8_t* first, size_t count) {
+    static const uint8_t last_max_bytes[16] = {
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1
+    };
+
+    uint8x16_t prev_high = vld1q_u8(CSTL_utf8_prev_high);
+    uint8x16_t prev_low  = vld1q_u8(CSTL_utf8_prev_low);
+    uint8x16_t cur_high  = vld1q_u8(CSTL_utf8_cur_high);
+    uint8x16_t last_max  = vld1q_u8(last_max_bytes);
+
+    uint8x16_t prev       = vdupq_n_u8(0);
+    uint8x16_t incomplete = vdupq_n_u8(0);
+    size_t off            = 0;
+
+    for (; count - off >= 16; off += 16) {
+        uint8x16_t input = vld1q_u8(first + off);
+        uint8x16_t error;
+
+        if (vmaxvq_u8(input) >= 0x80) {
+            error      = CSTL_neon_utf8_errors(input, prev, prev_high, prev_low, cur_high);
+            incomplete = vqsubq_u8(input, last_max);
+        } else {
+            error      = incomplete;
+            incomplete = vdupq_n_u8(0);
+        }
+
+        if (vmaxvq_u8(error) != 0) {
+            break;
+        }
+
+        prev = input;
+    }
+
+    return CSTL_utf8_boundary(first, off);
+}
+#endif
+
+// Returns the length of the longest well-formed prefix of the UTF-8 at `first`.
+static inline size_t CSTL_utf8_prefix(const uint8_t* first, size_t count) {
+    size_t off = 0;
+
+#if defined(CSTL_char_avx2)
+    if (count >= 32 && CSTL_has_avx2()) {
+        off = CSTL_avx2_utf8_prefix(first, count);
+    }
+#elif defined(CSTL_utf8_neon)
+    if (count >= 16) {
+        off = CSTL_neon_utf8_prefix(first, count);
+    }
+#endif
+
+    // The tail, or the block with the first error.
+    return off + CSTL_transcode(first + off, count - off, 1, NULL, 4, false).read;
+}
+
+// Counts the continuation bytes, or the lead bytes of four byte sequences if `four_byte_leads`.
+static inline size_t CSTL_utf8_count_bytes(const uint8_t* first, size_t count, bool four_byte_leads) {
+    size_t total = 0;
+    size_t off   = 0;
+
+#if defined(CSTL_char_sse2)
+    __m128i zero  = _mm_setzero_si128();
+    __m128i bound = four_byte_leads ? _mm_set1_epi8((char)0xF0) : _mm_set1_epi8(-64);
+
+    while (count - off >= 16) {
+        // Byte counters, summed before they can overflow.
+        __m128i counts = zero;
+
+        for (size_t n = 0; n != 255 && count - off >= 16; ++n, off += 16) {
+            __m128i chunk = _mm_loadu_si128((const __m128i*)(first + off));
+            __m128i match = four_byte_leads ? _mm_cmpeq_epi8(_mm_max_epu8(chunk, bound), chunk) : _mm_cmplt_epi8(chunk, bound);
+
+            counts = _mm_sub_epi8(counts, match);
+        }
+
+        __m128i sums = _mm_sad_epu8(counts, zero);
+        total += (size_t)_mm_cvtsi128_si32(sums) + (size_t)_mm_extract_epi16(sums, 4);
+    }
+#elif defined(CSTL_char_neon)
+    while (count - off >= 16) {
+        uint8x16_t counts = vdupq_n_u8(0);
+
+        for (size_t n = 0; n != 255 && count - off >= 16; ++n, off += 16) {
+            uint8x16_t chunk = vld1q_u8(first + off);
+            uint8x16_t match = four_byte_leads ? vcgeq_u8(chunk, vdupq_n_u8(0xF0)) : vcltq_s8(vreinterpretq_s8_u8(chunk), vdupq_n_s8(-64));
+
+            counts = vsubq_u8(counts, match);
+        }
+
+        uint64x2_t sums = vpaddlq_u32(vpaddlq_u16(vpaddlq_u8(counts)));
+        total += (size_t)(vgetq_lane_u64(sums, 0) + vgetq_lane_u64(sums, 1));
+    }
+#endif
+
+    for (; off != count; ++off) {
+        total += four_byte_leads ? first[off] >= 0xF0 : (first[off] & 0xC0) == 0x80;
+    }
+
+    return total;
+}
+
+// Counts the code points of well-formed UTF-8, which start at every byte but continuation bytes.
+static inline size_t CSTL_utf8_code_points(const uint8_t* first, size_t count) {
+    return count - CSTL_utf8_count_bytes(first, count, false);
+}
+
+// Converts the well-formed prefix of the UTF-8 at `first`, or measures its output if `dest` is null.
+static CSTL_unicode_inline CSTL_UnicodeResult CSTL_utf8_transcode(const char8_t* first, size_t count, void* dest, size_t dest_width) {
+    const uint8_t* bytes = (const uint8_t*)first;
+    size_t prefix        = CSTL_utf8_prefix(bytes, count);
+
+    CSTL_UnicodeResult result = { prefix, 0, prefix == count };
+
+    if (dest != NULL) {
+        result.written = CSTL_transcode(bytes, prefix, 1, dest, dest_width, true).written;
+    } else if (dest_width == 2) {
+        // Four byte sequences take a surrogate pair.
+        result.written = CSTL_utf8_code_points(bytes, prefix) + CSTL_utf8_count_bytes(bytes, prefix, true);
+    } else {
+        result.written = CSTL_utf8_code_points(bytes, prefix);
+    }
+
+    return result;
+}
+
+// Measures one block of `block` code units of `src_width` bytes, or a little more to finish
+// a surrogate pair, one code point at a time. Returns false if it is ill-formed.
+static inline bool CSTL_unicode_measure_block(const unsigned char* src, size_t count, size_t src_width, size_t dest_width, size_t block, size_t* i, size_t* j) {
+    size_t stop = *i + block;
+
+    while (*i < stop) {
+        uint32_t cp;
+        size_t length = CSTL_unicode_decode(src + *i * src_width, count - *i, src_width, &cp);
+
+        if (length == 0) {
+            return false;
+        }
+
+        *i += length;
+        *j += CSTL_unicode_encoded_length(cp, dest_width);
+    }
+
+    return true;
+}
+
+// Measures the well-formed prefix of the UTF-16 at `first`. Blocks of 8 code units
+// without surrogates are checked and measured with vector comparisons, only blocks
+// with surrogates are decoded.
+static CSTL_unicode_inline CSTL_UnicodeResult CSTL_utf16_measure(const uint16_t* first, size_t count, size_t dest_width) {
+    const unsigned char* src = (const unsigned char*)first;
+
+    CSTL_UnicodeResult result = { 0, 0, false };
+
+    size_t i = 0;
+    size_t j = 0;
+
+#if defined(CSTL_char_sse2)
+    __m128i zero = _mm_setzero_si128();
+
+    while (count - i >= 8) {
+        // Counters of code units below 0x80 and 0x800, summed before they can overflow.
+        __m128i below = zero;
+        size_t blocks = 0;
+
+        for (; blocks != 16383 && count - i >= 8; ++blocks, i += 8) {
+            __m128i units = _mm_loadu_si128((const __m128i*)(first + i));
+
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(units, _mm_set1_epi16((short)0xF800)), _mm_set1_epi16((short)0xD800))) != 0) {
+                break;
+            }
+
+            if (dest_width == 1) {
+                below = _mm_sub_epi16(below, _mm_cmpeq_epi16(_mm_and_si128(units, _mm_set1_epi16((short)0xFF80)), zero));
+                below = _mm_sub_epi16(below, _mm_cmpeq_epi16(_mm_and_si128(units, _mm_set1_epi16((short)0xF800)), zero));
+            }
+        }
+
+        j += blocks * 8;
+
+        if (dest_width == 1) {
+            __m128i sums = _mm_madd_epi16(below, _mm_set1_epi16(1));
+            sums         = _mm_add_epi32(sums, _mm_shuffle_epi32(sums, _MM_SHUFFLE(1, 0, 3, 2)));
+            sums         = _mm_add_epi32(sums, _mm_shuffle_epi32(sums, _MM_SHUFFLE(2, 3, 0, 1)));
+
+            // Each code unit takes 3 bytes, less one for each threshold it is below.
+            j += blocks * 16 - (size_t)(uint32_t)_mm_cvtsi128_si32(sums);
+        }
+
+        if (blocks != 16383 && count - i >= 8 && !CSTL_unicode_measure_block(src, count, 2, dest_width, 8, &i, &j)) {
+            result.read    = i;
+            result.written = j;
+            return result;
+        }
+    }
+#elif defined(CSTL_char_neon)
+    while (count - i >= 8) {
+        // Counters of code units from 0x80 and 0x800, summed before they can overflow.
+        uint16x8_t above = vdupq_n_u16(0);
+        size_t blocks    = 0;
+
+        for (; blocks != 16383 && count - i >= 8; ++blocks, i += 8) {
+            uint16x8_t units = vld1q_u16(first + i);
+
+            if (CSTL_neon_mask(vreinterpretq_u8_u16(vceqq_u16(vandq_u16(units, vdupq_n_u16(0xF800)), vdupq_n_u16(0xD800)))) != 0) {
+                break;
+            }
+
+            if (dest_width == 1) {
+                above = vsubq_u16(above, vtstq_u16(units, vdupq_n_u16(0xFF80)));
+                above = vsubq_u16(above, vtstq_u16(units, vdupq_n_u16(0xF800)));
+            }
+        }
+
+        j += blocks * 8;
+
+        if (dest_width == 1) {
+            uint64x2_t sums = vpaddlq_u32(vpaddlq_u16(above));
+            j += (size_t)(vgetq_lane_u64(sums, 0) + vgetq_lane_u64(sums, 1));
+        }
+
+        if (blocks != 16383 && count - i >= 8 && !CSTL_unicode_measure_block(src, count, 2, dest_width, 8, &i, &j)) {
+            result.read    = i;
+            result.written = j;
+            return result;
+        }
+    }
+#endif
+
+    if (i < count && !CSTL_unicode_measure_block(src, count, 2, dest_width, count - i, &i, &j)) {
+        result.read    = i;
+        result.written = j;
+        return result;
+    }
+
+    result.read    = count;
+    result.written = j;
+    result.valid   = true;
+    return result;
+}
+
+// Measures the well-formed prefix of the UTF-32 at `first`. Blocks of 4 code points
+// are checked and measured with vector comparisons.
+static CSTL_unicode_inline CSTL_UnicodeResult CSTL_utf32_measure(const uint32_t* first, size_t count, size_t dest_width) {
+    const unsigned char* src = (const unsigned char*)first;
+
+    CSTL_UnicodeResult result = { 0, 0, false };
+
+    size_t i = 0;
+    size_t j = 0;
+
+#if defined(CSTL_char_sse2)
+    __m128i zero = _mm_setzero_si128();
+
+    while (count - i >= 4) {
+        // Counters of extra output code units, summed before they can overflow.
+        __m128i extra = zero;
+        size_t blocks = 0;
+
+        for (; blocks != (1u << 28) && count - i >= 4; ++blocks, i += 4) {
+            __m128i units = _mm_loadu_si128((const __m128i*)(first + i));
+
+            // Values from 0x80000000 compare below zero.
+            __m128i surrogate = _mm_and_si128(_mm_cmpgt_epi32(units, _mm_set1_epi32(0xD7FF)), _mm_cmplt_epi32(units, _mm_set1_epi32(0xE000)));
+            __m128i too_large = _mm_or_si128(_mm_cmpgt_epi32(units, _mm_set1_epi32(0x10FFFF)), _mm_cmplt_epi32(units, zero));
+
+            if (_mm_movemask_epi8(_mm_or_si128(surrogate, too_large)) != 0) {
+                break;
+            }
+
+            if (dest_width == 1) {
+                extra = _mm_sub_epi32(extra, _mm_cmpgt_epi32(units, _mm_set1_epi32(0x7F)));
+                extra = _mm_sub_epi32(extra, _mm_cmpgt_epi32(units, _mm_set1_epi32(0x7FF)));
+            }
+
+            if (dest_width <= 2) {
+                extra = _mm_sub_epi32(extra, _mm_cmpgt_epi32(units, _mm_set1_epi32(0xFFFF)));
+            }
+        }
+
+        extra = _mm_add_epi32(extra, _mm_shuffle_epi32(extra, _MM_SHUFFLE(1, 0, 3, 2)));
+        extra = _mm_add_epi32(extra, _mm_shuffle_epi32(extra, _MM_SHUFFLE(2, 3, 0, 1)));
+
+        j += blocks * 4 + (size_t)(uint32_t)_mm_cvtsi128_si32(extra);
+
+        if (blocks != (1u << 28) && count - i >= 4 && !CSTL_unicode_measure_block(src, count, 4, dest_width, 4, &i, &j)) {
+            result.read    = i;
+            result.written = j;
+            return result;
+        }
+    }
+#elif defined(CSTL_char_neon)
+    while (count - i >= 4) {
+        uint32x4_t extra = vdupq_n_u32(0);
+        size_t blocks    = 0;
+
+        for (; blocks != (1u << 28) && count - i >= 4; ++blocks, i += 4) {
+            uint32x4_t units = vld1q_u32(first + i);
+
+            uint32x4_t surrogate = vcltq_u32(vsubq_u32(units, vdupq_n_u32(0xD800)), vdupq_n_u32(0x800));
+            uint32x4_t too_large = vcgtq_u32(units, vdupq_n_u32(0x10FFFF));
+
+            if (CSTL_neon_mask(vreinterpretq_u8_u32(vorrq_u32(surrogate, too_large))) != 0) {
+                break;
+            }
+
+            if (dest_width == 1) {
+                extra = vsubq_u32(extra, vcgtq_u32(units, vdupq_n_u32(0x7F)));
+                extra = vsubq_u32(extra, vcgtq_u32(units, vdupq_n_u32(0x7FF)));
+            }
+
+            if (dest_width <= 2) {
+                extra = vsubq_u32(extra, vcgtq_u32(units, vdupq_n_u32(0xFFFF)));
+            }
+        }
+
+        uint64x2_t sums = vpaddlq_u32(extra);
+        j += blocks * 4 + (size_t)(vgetq_lane_u64(sums, 0) + vgetq_lane_u64(sums, 1));
+
+        if (blocks != (1u << 28) && count - i >= 4 && !CSTL_unicode_measure_block(src, count, 4, dest_width, 4, &i, &j)) {
+            result.read    = i;
+            result.written = j;
+            return result;
+        }
+    }
+#endif
+
+    if (i < count && !CSTL_unicode_measure_block(src, count, 4, dest_width, count - i, &i, &j)) {
+        result.read    = i;
+        result.written = j;
+        return result;
+    }
+
+    result.read    = count;
+    result.written = j;
+    result.valid   = true;
+    return result;
+}
+
+// Validates and measures the output of `count` code units of `src_width` bytes with
+// the sizing kernel of the source encoding, without decoding any code point twice.
+static CSTL_unicode_inline CSTL_UnicodeResult CSTL_unicode_measure(const void* src, size_t count, size_t src_width, size_t dest_width) {
+    switch (src_width) {
+    case 1:  return CSTL_utf8_transcode((const char8_t*)src, count, NULL, dest_width);
+    case 2:  return CSTL_utf16_measure((const uint16_t*)src, count, dest_width);
+    default: return CSTL_utf32_measure((const uint32_t*)src, count, dest_width);
+    }
+}
+
+// Converts from UTF-16 or UTF-32, or only measures the output if `dest` is null.
+static CSTL_unicode_inline CSTL_UnicodeResult CSTL_unicode_convert(const void* src, size_t count, size_t src_width, void* dest, size_t dest_width) {
+    if (dest == NULL) {
+        return CSTL_unicode_measure(src, count, src_width, dest_width);
+    }
+
+    return CSTL_transcode(src, count, src_width, dest, dest_width, false);
+}
+
+// Stores the outcome of the measuring pass for the caller, returns whether the source is valid.
+// The conversion that follows skips the checks.
+static inline bool CSTL_unicode_measured(CSTL_UnicodeResult measured, CSTL_UnicodeResult* result) {
+    if (result != NULL) {
+        *result = measured;
+    }
+
+    return measured.valid;
+}
+
+bool CSTL_utf8_validate(const char8_t* first, size_t count) {
+    return CSTL_utf8_prefix((const uint8_t*)first, count) == count;
+}
+
+size_t CSTL_utf8_valid_prefix(const char8_t* first, size_t count) {
+    return CSTL_utf8_prefix((const uint8_t*)first, count);
+}
+
+size_t CSTL_utf8_count(const char8_t* first, size_t count) {
+    return CSTL_utf8_code_points((const uint8_t*)first, count);
+}
+
+bool CSTL_u8string_validate(CSTL_UTF8StringCRef instance) {
+    return CSTL_utf8_validate(CSTL_u8string_c_str(instance), CSTL_u8string_size(instance));
+}
+
+size_t CSTL_u8string_valid_prefix(CSTL_UTF8StringCRef instance) {
+    return CSTL_utf8_valid_prefix(CSTL_u8string_c_str(instance), CSTL_u8string_size(instance));
+}
+
+size_t CSTL_u8string_count(CSTL_UTF8StringCRef instance) {
+    return CSTL_utf8_count(CSTL_u8string_c_str(instance), CSTL_u8string_size(instance));
+}
+
+CSTL_UnicodeResult CSTL_utf8_to_utf16(const char8_t* first, size_t count, char16_t* dest) {
+    return CSTL_utf8_transcode(first, count, dest, 2);
+}
+
+CSTL_UnicodeResult CSTL_utf8_to_utf32(const char8_t* first, size_t count, char32_t* dest) {
+    return CSTL_utf8_transcode(first, count, dest, 4);
+}
+
+CSTL_UnicodeResult CSTL_utf8_to_wide(const char8_t* first, size_t count, wchar_t* dest) {
+    return CSTL_utf8_transcode(first, count, dest, sizeof(wchar_t));
+}
+
+CSTL_UnicodeResult CSTL_utf16_to_utf8(const char16_t* first, size_t count, char8_t* dest) {
+    return CSTL_unicode_convert(first, count, 2, dest, 1);
+}
+
+CSTL_UnicodeResult CSTL_utf16_to_utf32(const char16_t* first, size_t count, char32_t* dest) {
+    return CSTL_unicode_convert(first, count, 2, dest, 4);
+}
+
+CSTL_UnicodeResult CSTL_utf16_to_wide(const char16_t* first, size_t count, wchar_t* dest) {
+    return CSTL_unicode_convert(first, count, 2, dest, sizeof(wchar_t));
+}
+
+CSTL_UnicodeResult CSTL_utf32_to_utf8(const char32_t* first, size_t count, char8_t* dest) {
+    return CSTL_unicode_convert(first, count, 4, dest, 1);
+}
+
+CSTL_UnicodeResult CSTL_utf32_to_utf16(const char32_t* first, size_t count, char16_t* dest) {
+    return CSTL_unicode_convert(first, count, 4, dest, 2);
+}
+
+CSTL_UnicodeResult CSTL_utf32_to_wide(const char32_t* first, size_t count, wchar_t* dest) {
+    return CSTL_unicode_convert(first, count, 4, dest, sizeof(wchar_t));
+}
+
+CSTL_UnicodeResult CSTL_wide_to_utf8(const wchar_t* first, size_t count, char8_t* dest) {
+    return CSTL_unicode_convert(first, count, sizeof(wchar_t), dest, 1);
+}
+
+CSTL_UnicodeResult CSTL_wide_to_utf16(const wchar_t* first, size_t count, char16_t* dest) {
+    return CSTL_unicode_convert(first, count, sizeof(wchar_t), dest, 2);
+}
+
+CSTL_UnicodeResult CSTL_wide_to_utf32(const wchar_t* first, size_t count, char32_t* dest) {
+    return CSTL_unicode_convert(first, count, sizeof(wchar_t), dest, 4);
+}
+
+// Defines `CSTL_<string>_assign_<source>`, which measures the source with its sizing kernel,
+// reserves once and converts in a single pass that skips the checks.
+#define CSTL_unicode_define_assign(string, Ref, char_t, source, source_t, source_width) \
+    bool CSTL_##string##_assign_##source(CSTL_##Ref instance, const source_t* first, size_t count, CSTL_UnicodeResult* result, CSTL_Alloc* alloc) { \
+        CSTL_UnicodeResult measured = CSTL_unicode_measure(first, count, source_width, sizeof(char_t)); \
+    \
+        if (!CSTL_unicode_measured(measured, result) || !CSTL_##string##_reserve(instance, measured.written, alloc)) { \
+            return false; \
+        } \
+    \
+        char_t* data = CSTL_##string##_data(instance); \
+    \
+        CSTL_transcode(first, count, source_width, data, sizeof(char_t), true); \
+        data[measured.written] = 0; \
+        instance->size         = measured.written; \
+        return true; \
+    }
+
+CSTL_unicode_define_assign(u8string, UTF8StringRef, char8_t, utf16, char16_t, 2)
+CSTL_unicode_define_assign(u8string, UTF8StringRef, char8_t, utf32, char32_t, 4)
+CSTL_unicode_define_assign(u8string, UTF8StringRef, char8_t, wide, wchar_t, sizeof(wchar_t))
+
+CSTL_unicode_define_assign(u16string, UTF16StringRef, char16_t, utf8, char8_t, 1)
+CSTL_unicode_define_assign(u16string, UTF16StringRef, char16_t, utf32, char32_t, 4)
+CSTL_unicode_define_assign(u16string, UTF16StringRef, char16_t, wide, wchar_t, sizeof(wchar_t))
+
+CSTL_unicode_define_assign(u32string, UTF32StringRef, char32_t, utf8, char8_t, 1)
+CSTL_unicode_define_assign(u32string, UTF32StringRef, char32_t, utf16, char16_t, 2)
+CSTL_unicode_define_assign(u32string, UTF32StringRef, char32_t, wide, wchar_t, sizeof(wchar_t))
+
+CSTL_unicode_define_assign(wstring, WideStringRef, wchar_t, utf8, char8_t, 1)
+CSTL_unicode_define_assign(wstring, WideStringRef, wchar_t, utf16, char16_t, 2)
+CSTL_unicode_define_assign(wstring, WideStringRef, wchar_t, utf32, char32_t, 4)
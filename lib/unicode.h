@@ -0,0 +1,287 @@
+#pragma once
+
+#ifndef CSTL_UNICODE_H
+#define CSTL_UNICODE_H
+
+#include "alloc.h"
+#include "xstring.h"
+
+#if defined(__cplusplus)
+#include <cstddef>
+extern "C" {
+#else
+#include <stdbool.h>
+#include <stddef.h>
+#endif
+
+/**
+ * Transcoding between UTF-8, UTF-16 and UTF-32.
+ * 
+ * `wchar_t` strings are UTF-16 where `wchar_t` is 16 bits wide (Windows)
+ * and UTF-32 where it is 32 bits wide, as with `std::wstring`.
+ * 
+ * Input must be well-formed: overlong UTF-8, encoded or unpaired surrogates
+ * and code points above U+10FFFF are rejected, never replaced.
+ * Runs of ASCII are converted 16 code units at a time. Input is validated
+ * and measured with SIMD before it is converted: UTF-8 with table lookups,
+ * UTF-16 and UTF-32 with comparisons that count the output of whole blocks,
+ * so no code point is decoded twice.
+ * 
+ */
+
+/**
+ * Outcome of a transcoding call.
+ * 
+ */
+typedef struct CSTL_UnicodeResult {
+    /**
+     * Number of source code units read. If the source is ill-formed, this is the
+     * position of the first code unit of the first ill-formed sequence.
+     * 
+     */
+    size_t read;
+
+    /**
+     * Number of destination code units written for the source units read,
+     * or that would have been written when only measuring.
+     * 
+     */
+    size_t written;
+
+    /**
+     * Whether the whole source is well-formed.
+     * 
+     */
+    bool valid;
+} CSTL_UnicodeResult;
+
+/**
+ * Converts the `count` code units at `first` from UTF-8 to UTF-16,
+ * stopping at the first ill-formed sequence.
+ * 
+ * If `dest` is null, nothing is written and the result holds the length of the output,
+ * otherwise `dest` must have room for that many code units. No null terminator is written.
+ * 
+ */
+CSTL_UnicodeResult CSTL_utf8_to_utf16(const char8_t* first, size_t count, char16_t* dest);
+
+/**
+ * Converts the `count` code units at `first` from UTF-8 to UTF-32,
+ * as if by `CSTL_utf8_to_utf16`.
+ * 
+ */
+CSTL_UnicodeResult CSTL_utf8_to_utf32(const char8_t* first, size_t count, char32_t* dest);
+
+/**
+ * Converts the `count` code units at `first` from UTF-8 to the `wchar_t` encoding,
+ * as if by `CSTL_utf8_to_utf16`.
+ * 
+ */
+CSTL_UnicodeResult CSTL_utf8_to_wide(const char8_t* first, size_t count, wchar_t* dest);
+
+/**
+ * Converts the `count` code units at `first` from UTF-16 to UTF-8,
+ * as if by `CSTL_utf8_to_utf16`.
+ * 
+ */
+CSTL_UnicodeResult CSTL_utf16_to_utf8(const char16_t* first, size_t count, char8_t* dest);
+
+/**
+ * Converts the `count` code units at `first` from UTF-16 to UTF-32,
+ * as if by `CSTL_utf8_to_utf16`.
+ * 
+ */
+CSTL_UnicodeResult CSTL_utf16_to_utf32(const char16_t* first, size_t count, char32_t* dest);
+
+/**
+ * Converts the `count` code units at `first` from UTF-16 to the `wchar_t` encoding,
+ * as if by `CSTL_utf8_to_utf16`.
+ * 
+ */
+CSTL_UnicodeResult CSTL_utf16_to_wide(const char16_t* first, size_t count, wchar_t* dest);
+
+/**
+ * Converts the `count` code units at `first` from UTF-32 to UTF-8,
+ * as if by `CSTL_utf8_to_utf16`.
+ * 
+ */
+CSTL_UnicodeResult CSTL_utf32_to_utf8(const char32_t* first, size_t count, char8_t* dest);
+
+/**
+ * Converts the `count` code units at `first` from UTF-32 to UTF-16,
+ * as if by `CSTL_utf8_to_utf16`.
+ * 
+ */
+CSTL_UnicodeResult CSTL_utf32_to_utf16(const char32_t* first, size_t count, char16_t* dest);
+
+/**
+ * Converts the `count` code units at `first` from UTF-32 to the `wchar_t` encoding,
+ * as if by `CSTL_utf8_to_utf16`.
+ * 
+ */
+CSTL_UnicodeResult CSTL_utf32_to_wide(const char32_t* first, size_t count, wchar_t* dest);
+
+/**
+ * Converts the `count` code units at `first` from the `wchar_t` encoding to UTF-8,
+ * as if by `CSTL_utf8_to_utf16`.
+ * 
+ */
+CSTL_UnicodeResult CSTL_wide_to_utf8(const wchar_t* first, size_t count, char8_t* dest);
+
+/**
+ * Converts the `count` code units at `first` from the `wchar_t` encoding to UTF-16,
+ * as if by `CSTL_utf8_to_utf16`.
+ * 
+ */
+CSTL_UnicodeResult CSTL_wide_to_utf16(const wchar_t* first, size_t count, char16_t* dest);
+
+/**
+ * Converts the `count` code units at `first` from the `wchar_t` encoding to UTF-32,
+ * as if by `CSTL_utf8_to_utf16`.
+ * 
+ */
+CSTL_UnicodeResult CSTL_wide_to_utf32(const wchar_t* first, size_t count, char32_t* dest);
+
+/**
+ * Returns whether the `count` code units at `first` are well-formed UTF-8.
+ * 
+ * Checks 32 bytes at a time with AVX2 where available, or 16 with AArch64 NEON.
+ * 
+ */
+bool CSTL_utf8_validate(const char8_t* first, size_t count);
+
+/**
+ * Returns the length of the longest well-formed UTF-8 prefix of the `count` code units at `first`,
+ * which is the position of the first ill-formed sequence or `count`.
+ * 
+ * A sequence cut off by the end of the range is ill-formed.
+ * 
+ */
+size_t CSTL_utf8_valid_prefix(const char8_t* first, size_t count);
+
+/**
+ * Returns the number of code points in the `count` code units of well-formed UTF-8 at `first`.
+ * 
+ * The input is not checked. For ill-formed input the result is the number of
+ * code units that are not continuation bytes.
+ * 
+ */
+size_t CSTL_utf8_count(const char8_t* first, size_t count);
+
+/**
+ * Returns whether the contents of `instance` are well-formed UTF-8.
+ * 
+ */
+bool CSTL_u8string_validate(CSTL_UTF8StringCRef instance);
+
+/**
+ * Returns the length of the longest well-formed UTF-8 prefix of `instance`,
+ * as if by `CSTL_utf8_valid_prefix`.
+ * 
+ */
+size_t CSTL_u8string_valid_prefix(CSTL_UTF8StringCRef instance);
+
+/**
+ * Returns the number of code points in `instance`, which must hold well-formed UTF-8,
+ * as if by `CSTL_utf8_count`.
+ * 
+ */
+size_t CSTL_u8string_count(CSTL_UTF8StringCRef instance);
+
+/**
+ * Replaces the contents of `instance` with the `count` UTF-16 code units at `first`
+ * converted to UTF-8. The output is measured first, so the string allocates at most once.
+ * 
+ * If `result` is not null, it receives the outcome of the conversion.
+ * 
+ * If the source is ill-formed, if the output is longer than `CSTL_u8string_max_size()`
+ * or if the allocation fails, this function has no effect and returns `false`,
+ * otherwise it returns `true`. `result->valid` tells the first case from the others.
+ * 
+ * `first` must not point into `instance`.
+ * 
+ */
+bool CSTL_u8string_assign_utf16(CSTL_UTF8StringRef instance, const char16_t* first, size_t count, CSTL_UnicodeResult* result, CSTL_Alloc* alloc);
+
+/**
+ * Replaces the contents of `instance` with the `count` UTF-32 code units at `first`
+ * converted to UTF-8, as if by `CSTL_u8string_assign_utf16`.
+ * 
+ */
+bool CSTL_u8string_assign_utf32(CSTL_UTF8StringRef instance, const char32_t* first, size_t count, CSTL_UnicodeResult* result, CSTL_Alloc* alloc);
+
+/**
+ * Replaces the contents of `instance` with the `count` `wchar_t` code units at `first`
+ * converted to UTF-8, as if by `CSTL_u8string_assign_utf16`.
+ * 
+ */
+bool CSTL_u8string_assign_wide(CSTL_UTF8StringRef instance, const wchar_t* first, size_t count, CSTL_UnicodeResult* result, CSTL_Alloc* alloc);
+
+/**
+ * Replaces the contents of `instance` with the `count` UTF-8 code units at `first`
+ * converted to UTF-16, as if by `CSTL_u8string_assign_utf16`.
+ * 
+ */
+bool CSTL_u16string_assign_utf8(CSTL_UTF16StringRef instance, const char8_t* first, size_t count, CSTL_UnicodeResult* result, CSTL_Alloc* alloc);
+
+/**
+ * Replaces the contents of `instance` with the `count` UTF-32 code units at `first`
+ * converted to UTF-16, as if by `CSTL_u8string_assign_utf16`.
+ * 
+ */
+bool CSTL_u16string_assign_utf32(CSTL_UTF16StringRef instance, const char32_t* first, size_t count, CSTL_UnicodeResult* result, CSTL_Alloc* alloc);
+
+/**
+ * Replaces the contents of `instance` with the `count` `wchar_t` code units at `first`
+ * converted to UTF-16, as if by `CSTL_u8string_assign_utf16`.
+ * 
+ */
+bool CSTL_u16string_assign_wide(CSTL_UTF16StringRef instance, const wchar_t* first, size_t count, CSTL_UnicodeResult* result, CSTL_Alloc* alloc);
+
+/**
+ * Replaces the contents of `instance` with the `count` UTF-8 code units at `first`
+ * converted to UTF-32, as if by `CSTL_u8string_assign_utf16`.
+ * 
+ */
+bool CSTL_u32string_assign_utf8(CSTL_UTF32StringRef instance, const char8_t* first, size_t count, CSTL_UnicodeResult* result, CSTL_Alloc* alloc);
+
+/**
+ * Replaces the contents of `instance` with the `count` UTF-16 code units at `first`
+ * converted to UTF-32, as if by `CSTL_u8string_assign_utf16`.
+ * 
+ */
+bool CSTL_u32string_assign_utf16(CSTL_UTF32StringRef instance, const char16_t* first, size_t count, CSTL_UnicodeResult* result, CSTL_Alloc* alloc);
+
+/**
+ * Replaces the contents of `instance` with the `count` `wchar_t` code units at `first`
+ * converted to UTF-32, as if by `CSTL_u8string_assign_utf16`.
+ * 
+ */
+bool CSTL_u32string_assign_wide(CSTL_UTF32StringRef instance, const wchar_t* first, size_t count, CSTL_UnicodeResult* result, CSTL_Alloc* alloc);
+
+/**
+ * Replaces the contents of `instance` with the `count` UTF-8 code units at `first`
+ * converted to the `wchar_t` encoding, as if by `CSTL_u8string_assign_utf16`.
+ * 
+ */
+bool CSTL_wstring_assign_utf8(CSTL_WideStringRef instance, const char8_t* first, size_t count, CSTL_UnicodeResult* result, CSTL_Alloc* alloc);
+
+/**
+ * Replaces the contents of `instance` with the `count` UTF-16 code units at `first`
+ * converted to the `wchar_t` encoding, as if by `CSTL_u8string_assign_utf16`.
+ * 
+ */
+bool CSTL_wstring_assign_utf16(CSTL_WideStringRef instance, const char16_t* first, size_t count, CSTL_UnicodeResult* result, CSTL_Alloc* alloc);
+
+/**
+ * Replaces the contents of `instance` with the `count` UTF-32 code units at `first`
+ * converted to the `wchar_t` encoding, as if by `CSTL_u8string_assign_utf16`.
+ * 
+ */
+bool CSTL_wstring_assign_utf32(CSTL_WideStringRef instance, const char32_t* first, size_t count, CSTL_UnicodeResult* result, CSTL_Alloc* alloc);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
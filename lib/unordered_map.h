@@ -0,0 +1,31 @@
+#pragma once
+
+#ifndef CSTL_UNORDERED_MAP_H
+#define CSTL_UNORDERED_MAP_H
+
+#include "xhash.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * STL ABI `std::unordered_map` layout.
+ * 
+ * Elements are `std::pair<const Key, T>` objects described by a single
+ * `CSTL_Type`, with the key at offset 0 and the mapped value after it.
+ * Use the `CSTL_hash_*` functions, hashing and comparing keys.
+ * 
+ * Does not include the allocator, which nonetheless is a part of the `std::unordered_map`
+ * structure! You are responsible for including it, since it can take on any form.
+ * 
+ * Do not manipulate the members directly, use the associated functions!
+ * 
+ */
+typedef CSTL_HashVal CSTL_UnorderedMapVal;
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
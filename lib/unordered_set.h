@@ -0,0 +1,30 @@
+#pragma once
+
+#ifndef CSTL_UNORDERED_SET_H
+#define CSTL_UNORDERED_SET_H
+
+#include "xhash.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/**
+ * STL ABI `std::unordered_set` layout.
+ * 
+ * Elements are keys described by a `CSTL_Type`.
+ * Use the `CSTL_hash_*` functions, hashing and comparing elements.
+ * 
+ * Does not include the allocator, which nonetheless is a part of the `std::unordered_set`
+ * structure! You are responsible for including it, since it can take on any form.
+ * 
+ * Do not manipulate the members directly, use the associated functions!
+ * 
+ */
+typedef CSTL_HashVal CSTL_UnorderedSetVal;
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
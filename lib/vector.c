@@ -21,6 +21,7 @@ static inline bool CSTL_verify_address(CSTL_VectorCRef instance, const char* add
 
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 #include <limits.h>
 
 #ifdef _MSC_VER
@@ -79,7 +80,7 @@ static inline CSTL_VectorVal CSTL_vector_new_with_bytes(size_t bytes, size_t ali
 
 static inline void CSTL_vector_tidy(CSTL_VectorRef instance, size_t alignment, CSTL_DropTypeCRef drop, CSTL_Alloc* alloc) {
     if (instance->first) {
-        drop->drop(instance->first, instance->last);
+        CSTL_type_drop(drop, instance->first, instance->last);
         
         CSTL_free(instance->first, CSTL_vector_capacity_bytes(instance),
             alignment, alloc);
@@ -95,7 +96,14 @@ static inline void CSTL_vector_replace(CSTL_VectorRef instance, size_t alignment
     *instance = val;
 }
 
+static inline bool CSTL_vector_grow_in_place(CSTL_VectorRef instance, size_t alignment, CSTL_MoveTypeCRef move, size_t new_bytes, const void* source_first, const void* source_last, CSTL_Alloc* alloc);
+
 static inline bool CSTL_vector_reallocate_bytes(CSTL_VectorRef instance, size_t alignment, CSTL_MoveTypeCRef move, size_t new_bytes, CSTL_Alloc* old_alloc, CSTL_Alloc* new_alloc) {   
+    if (old_alloc == new_alloc && new_bytes > CSTL_vector_capacity_bytes(instance)
+        && CSTL_vector_grow_in_place(instance, alignment, move, new_bytes, NULL, NULL, old_alloc)) {
+        return true;
+    }
+
     CSTL_VectorVal tmp = CSTL_vector_new_with_bytes(new_bytes, alignment, new_alloc);
 
     if (tmp.first == NULL) {
@@ -103,7 +111,9 @@ static inline bool CSTL_vector_reallocate_bytes(CSTL_VectorRef instance, size_t
     }
 
     tmp.last = (char*)tmp.first + CSTL_vector_size_bytes(instance);
-    move->move(instance->first, instance->last, tmp.first);
+    CSTL_type_relocate(move, instance->first, instance->last, tmp.first);
+
+    instance->last = instance->first; // relocated, nothing left to destroy
 
     CSTL_vector_replace(instance, alignment, &move->drop_type, old_alloc, tmp);
 
@@ -113,9 +123,9 @@ static inline bool CSTL_vector_reallocate_bytes(CSTL_VectorRef instance, size_t
 static inline void* CSTL_vector_sized_move(size_t type_size, CSTL_MoveTypeCRef move, void* first, void* last, void* dest) {
     while ((char*)first < (char*)last) {
         void* dest_next = (char*)dest + type_size;
-        move->drop_type.drop(dest, dest_next);
+        CSTL_type_drop(&move->drop_type, dest, dest_next);
         void* first_next = (char*)first + type_size;
-        move->move(first, first_next, dest);
+        CSTL_type_move(move, first, first_next, dest);
         dest = dest_next;
         first = first_next;
     }
@@ -128,12 +138,99 @@ static inline void* CSTL_vector_sized_move_backwards(size_t type_size, CSTL_Move
         dest = (char*)dest - type_size;
         void* last_prev = last;
         last = (char*)last - type_size;
-        move->drop_type.drop(dest, dest_prev);
-        move->move(last, last_prev, dest);
+        CSTL_type_drop(&move->drop_type, dest, dest_prev);
+        CSTL_type_move(move, last, last_prev, dest);
     }
     return dest;
 }
 
+// Shift `[where, last)` up by `gap_bytes`, leaving `gap_bytes` of uninitialized memory at `where`.
+// There must be at least `gap_bytes` of unused capacity past `last`.
+static inline void CSTL_vector_open_gap(size_t type_size, CSTL_MoveTypeCRef move, void* where, void* last, size_t gap_bytes) {
+    size_t affected_bytes = (size_t)((char*)last - (char*)where);
+
+    if (affected_bytes == 0) {
+        return;
+    }
+
+    if (CSTL_type_is_relocatable(move)) {
+        memmove((char*)where + gap_bytes, where, affected_bytes);
+    } else if (gap_bytes > affected_bytes) {
+        CSTL_type_move(move, where, last, (char*)where + gap_bytes);
+        CSTL_type_drop(&move->drop_type, where, last);
+    } else {
+        void* new_mid = (char*)last - gap_bytes;
+
+        CSTL_type_move(move, new_mid, last, last);
+        CSTL_vector_sized_move_backwards(type_size, move, where, new_mid, last);
+        CSTL_type_drop(&move->drop_type, where, (char*)where + gap_bytes);
+    }
+}
+
+// Relocate the elements of `instance` around `where` into a new buffer, the ones
+// before `where` to `head_dest` and the rest to `tail_dest`, leaving `instance` empty.
+static inline void CSTL_vector_relocate_split(CSTL_VectorRef instance, CSTL_MoveTypeCRef move, void* where, void* head_dest, void* tail_dest) {
+    CSTL_type_relocate(move, where, instance->last, tail_dest);
+    CSTL_type_relocate(move, instance->first, where, head_dest);
+
+    instance->last = instance->first;
+}
+
+// Grow the storage of `instance` to `new_bytes` without a separate allocation: in place, or
+// through the reallocation hook of `alloc` if the type is relocatable and the storage may move.
+// It may not if it overlaps `[source_first, source_last)`, which must stay valid.
+static inline bool CSTL_vector_grow_in_place(CSTL_VectorRef instance, size_t alignment, CSTL_MoveTypeCRef move, size_t new_bytes, const void* source_first, const void* source_last, CSTL_Alloc* alloc) {
+    char* first = instance->first;
+
+    if (first == NULL) {
+        return false;
+    }
+
+    size_t size_bytes   = CSTL_vector_size_bytes(instance);
+    size_t old_capacity = CSTL_vector_capacity_bytes(instance);
+
+    if (CSTL_try_expand(first, old_capacity, new_bytes, alignment, alloc)) {
+        instance->end = first + new_bytes;
+        return true;
+    }
+
+    bool is_aliased = (const char*)source_last > first && (const char*)source_first < (char*)instance->last;
+
+    if (is_aliased || !CSTL_type_is_relocatable(move)) {
+        return false;
+    }
+
+    char* new_first = CSTL_reallocate(first, old_capacity, new_bytes, alignment, alloc);
+
+    if (new_first == NULL) {
+        return false;
+    }
+
+    instance->first = new_first;
+    instance->last  = new_first + size_bytes;
+    instance->end   = new_first + new_bytes;
+
+    return true;
+}
+
+// Make room for `new_bytes` past the last element without reallocating, if possible.
+static inline bool CSTL_vector_try_make_room(CSTL_VectorRef instance, size_t type_size, CSTL_MoveTypeCRef move, size_t new_bytes, const void* source_first, const void* source_last, CSTL_Alloc* alloc) {
+    size_t old_bytes = CSTL_vector_size_bytes(instance);
+
+    if (new_bytes <= CSTL_vector_capacity_bytes(instance) - old_bytes) {
+        return true;
+    }
+
+    if (new_bytes > CSTL_vector_bytes_max(type_size) - old_bytes) {
+        return false;
+    }
+
+    size_t new_capacity = CSTL_vector_growth_bytes(instance, type_size, old_bytes + new_bytes);
+
+    return CSTL_vector_grow_in_place(instance, type_size & -type_size, move, new_capacity,
+        source_first, source_last, alloc);
+}
+
 void CSTL_vector_construct(CSTL_VectorVal* new_instance) {
     if (new_instance == NULL) {
         return;
@@ -184,8 +281,8 @@ bool CSTL_vector_move_assign(CSTL_VectorRef instance, CSTL_Type type, CSTL_MoveT
                 return false;
             }
 
-            move->drop_type.drop(instance->first, instance->last);
-            move->move(other_instance->first, other_instance->last, instance->first);
+            CSTL_type_drop(&move->drop_type, instance->first, instance->last);
+            CSTL_type_move(move, other_instance->first, other_instance->last, instance->first);
 
             instance->last = (char*)instance->first + new_bytes;
 
@@ -226,7 +323,7 @@ bool CSTL_vector_assign_n(CSTL_VectorRef instance, CSTL_Type type, CSTL_CopyType
         }
 
         tmp.last = (char*)tmp.first + new_bytes;
-        copy->fill(tmp.first, tmp.last, value);
+        CSTL_type_fill(copy, tmp.first, tmp.last, value, type_size);
 
         CSTL_vector_replace(instance, alignment, &copy->move_type.drop_type, alloc, tmp);
 
@@ -244,16 +341,16 @@ bool CSTL_vector_assign_n(CSTL_VectorRef instance, CSTL_Type type, CSTL_CopyType
             return false;
         }
 
-        copy->copy(value, (char*)value + type_size, tmp);
+        CSTL_type_copy(copy, value, (char*)value + type_size, tmp);
     }
 
-    copy->move_type.drop_type.drop(first, last);
+    CSTL_type_drop(&copy->move_type.drop_type, first, last);
 
     instance->last = (char*)instance->first + new_bytes;
-    copy->fill(first, instance->last, tmp);
+    CSTL_type_fill(copy, first, instance->last, tmp, type_size);
 
     if (is_aliased) {
-        copy->move_type.drop_type.drop(tmp, (char*)tmp + type_size);
+        CSTL_type_drop(&copy->move_type.drop_type, tmp, (char*)tmp + type_size);
         CSTL_small_free(&frame, new_bytes, alignment, alloc, cookie);
     }
 
@@ -279,7 +376,7 @@ bool CSTL_vector_copy_assign_range(CSTL_VectorRef instance, CSTL_Type type, CSTL
         }
 
         tmp.last = (char*)tmp.first + new_bytes;
-        copy->copy(range_first, range_last, tmp.first);
+        CSTL_type_copy(copy, range_first, range_last, tmp.first);
 
         CSTL_vector_replace(instance, alignment, &copy->move_type.drop_type, alloc, tmp);
 
@@ -299,16 +396,16 @@ bool CSTL_vector_copy_assign_range(CSTL_VectorRef instance, CSTL_Type type, CSTL
             return false;
         }
 
-        copy->copy(range_first, range_last, tmp_first);
+        CSTL_type_copy(copy, range_first, range_last, tmp_first);
     }
 
-    copy->move_type.drop_type.drop(first, last); 
-    copy->copy(tmp_first, tmp_last, first);
+    CSTL_type_drop(&copy->move_type.drop_type, first, last); 
+    CSTL_type_copy(copy, tmp_first, tmp_last, first);
     
     instance->last = first + new_bytes;
 
     if (is_aliased) {
-        copy->move_type.drop_type.drop(tmp_first, tmp_last);
+        CSTL_type_drop(&copy->move_type.drop_type, tmp_first, tmp_last);
         CSTL_small_free(&frame, new_bytes, alignment, alloc, cookie);
     }
 
@@ -334,7 +431,7 @@ bool CSTL_vector_move_assign_range(CSTL_VectorRef instance, CSTL_Type type, CSTL
         }
 
         tmp.last = (char*)tmp.first + new_bytes;
-        move->move(range_first, range_last, tmp.first);
+        CSTL_type_move(move, range_first, range_last, tmp.first);
 
         CSTL_vector_replace(instance, alignment, &move->drop_type, alloc, tmp);
 
@@ -354,16 +451,16 @@ bool CSTL_vector_move_assign_range(CSTL_VectorRef instance, CSTL_Type type, CSTL
             return false;
         }
 
-        move->move(range_first, range_last, tmp_first);
+        CSTL_type_move(move, range_first, range_last, tmp_first);
     }
 
-    move->drop_type.drop(first, last); 
-    move->move(tmp_first, tmp_last, first);
+    CSTL_type_drop(&move->drop_type, first, last); 
+    CSTL_type_move(move, tmp_first, tmp_last, first);
     
     instance->last = first + new_bytes;
 
     if (is_aliased) {
-        move->drop_type.drop(tmp_first, tmp_last);
+        CSTL_type_drop(&move->drop_type, tmp_first, tmp_last);
         CSTL_small_free(&frame, new_bytes, alignment, alloc, cookie);
     }
 
@@ -566,8 +663,16 @@ bool CSTL_vector_resize(CSTL_VectorRef instance, CSTL_Type type, CSTL_CopyTypeCR
     void* new_last = (char*)instance->first + new_bytes;
 
     if (new_bytes > old_bytes) {
+        size_t new_capacity = CSTL_vector_growth_bytes(instance, type_size, new_bytes);
+
+        if (new_bytes > CSTL_vector_capacity_bytes(instance)
+            && CSTL_vector_grow_in_place(instance, alignment, &copy->move_type, new_capacity,
+                value, (const char*)value + type_size, alloc)) {
+            old_last = instance->last;
+            new_last = (char*)instance->first + new_bytes;
+        }
+
         if (new_bytes > CSTL_vector_capacity_bytes(instance)) {
-            size_t new_capacity = CSTL_vector_growth_bytes(instance, type_size, new_bytes);
             CSTL_VectorVal tmp  = CSTL_vector_new_with_bytes(new_capacity, alignment, alloc);
 
             if (tmp.first == NULL) {
@@ -577,14 +682,16 @@ bool CSTL_vector_resize(CSTL_VectorRef instance, CSTL_Type type, CSTL_CopyTypeCR
             old_last = (char*)tmp.first + old_bytes;
             new_last = (char*)tmp.first + new_bytes;
 
-            copy->copy(instance->first, instance->last, tmp.first);
+            CSTL_type_relocate(&copy->move_type, instance->first, instance->last, tmp.first);
+
+            instance->last = instance->first;
 
             CSTL_vector_replace(instance, alignment, &copy->move_type.drop_type, alloc, tmp);
         }
 
-        copy->fill(old_last, new_last, value);
+        CSTL_type_fill(copy, old_last, new_last, value, type_size);
     } else {
-        copy->move_type.drop_type.drop(new_last, old_last);
+        CSTL_type_drop(&copy->move_type.drop_type, new_last, old_last);
     }
 
     instance->last = new_last;
@@ -610,7 +717,7 @@ void CSTL_vector_truncate(CSTL_VectorRef instance, CSTL_Type type, CSTL_DropType
     void* new_last = (char*)instance->first + new_bytes;
     instance->last = new_last;
 
-    drop->drop(new_last, old_last);
+    CSTL_type_drop(drop, new_last, old_last);
 }
 
 bool CSTL_vector_reserve(CSTL_VectorRef instance, CSTL_Type type, CSTL_MoveTypeCRef move, size_t new_capacity, CSTL_Alloc* alloc) {
@@ -658,7 +765,7 @@ void CSTL_vector_clear(CSTL_VectorRef instance, CSTL_DropTypeCRef drop) {
         return;
     }
     
-    drop->drop(first, last);
+    CSTL_type_drop(drop, first, last);
 
     instance->last = first;
 }
@@ -682,10 +789,10 @@ CSTL_VectorIter CSTL_vector_insert_n(CSTL_VectorRef instance, CSTL_CopyTypeCRef
 
     void* where_pointer = (void*)where.pointer;
 
-    size_t where_bytes  = (size_t)((char*)where_pointer - (char*)instance->first);
-    size_t unused_bytes = (size_t)((char*)instance->end - (char*)instance->last);
+    size_t where_bytes = (size_t)((char*)where_pointer - (char*)instance->first);
 
-    if (new_bytes > unused_bytes) {
+    if (!CSTL_vector_try_make_room(instance, type_size, &copy->move_type, new_bytes,
+        value, (const char*)value + type_size, alloc)) {
         size_t old_bytes = CSTL_vector_size_bytes(instance);
 
         if (new_bytes > CSTL_vector_bytes_max(type_size) - old_bytes) {
@@ -707,37 +814,20 @@ CSTL_VectorIter CSTL_vector_insert_n(CSTL_VectorRef instance, CSTL_CopyTypeCRef
         void* constructed_first = (char*)tmp.first + where_bytes;
         void* constructed_last  = (char*)constructed_first + new_bytes;
 
-        copy->fill(constructed_first, constructed_last, value);
-    
-        if (where_pointer != instance->last) {
-            copy->move_type.move(where_pointer, instance->last, constructed_last);
-        }
-
-        copy->move_type.move(instance->first, where_pointer, tmp.first);
+        CSTL_type_fill(copy, constructed_first, constructed_last, value, type_size);
+        CSTL_vector_relocate_split(instance, &copy->move_type, where_pointer, tmp.first, constructed_last);
 
         CSTL_vector_replace(instance, alignment, &copy->move_type.drop_type, alloc, tmp);
 
         where_pointer = constructed_first;
     } else {
+        where_pointer = (char*)instance->first + where_bytes;
+
         void* old_last    = instance->last;
         void* where_last  = (char*)where_pointer + new_bytes;
 
-        size_t affected_bytes = (size_t)((char*)instance->last - (char*)where_pointer);
-
-        if (new_bytes > affected_bytes) {
-            void* new_mid  = (char*)old_last + new_bytes - affected_bytes;
-
-            copy->move_type.move(where_pointer, old_last, new_mid);
-            copy->move_type.drop_type.drop(where_pointer, old_last);
-        } else {
-            void* new_mid  = (char*)old_last - new_bytes;
-
-            copy->move_type.move(new_mid, old_last, old_last);
-            CSTL_vector_sized_move_backwards(type_size, &copy->move_type, where_pointer, new_mid, old_last);
-            copy->move_type.drop_type.drop(where_pointer, where_last);
-        }
-
-        copy->fill(where_pointer, where_last, value);
+        CSTL_vector_open_gap(type_size, &copy->move_type, where_pointer, old_last, new_bytes);
+        CSTL_type_fill(copy, where_pointer, where_last, value, type_size);
         instance->last = (char*)old_last + new_bytes;
     }
 
@@ -764,13 +854,8 @@ void* CSTL_vector_copy_insert_reallocate(CSTL_VectorRef instance, CSTL_CopyTypeC
     void* constructed_first = (char*)tmp.first + where_bytes;
     void* constructed_last  = (char*)constructed_first + type_size;
 
-    copy->copy(value, (const char*)value + type_size, constructed_first);
-
-    if (where != instance->last) {
-        copy->move_type.move(where, instance->last, constructed_last);
-    }
-
-    copy->move_type.move(instance->first, where, tmp.first);
+    CSTL_type_copy(copy, value, (const char*)value + type_size, constructed_first);
+    CSTL_vector_relocate_split(instance, &copy->move_type, where, tmp.first, constructed_last);
 
     CSTL_vector_replace(instance, fake_alignment, &copy->move_type.drop_type, alloc, tmp);
 
@@ -796,13 +881,8 @@ void* CSTL_vector_move_insert_reallocate(CSTL_VectorRef instance, CSTL_MoveTypeC
     void* constructed_first = (char*)tmp.first + where_bytes;
     void* constructed_last  = (char*)constructed_first + type_size;
 
-    move->move(value, (char*)value + type_size, constructed_first);
-
-    if (where != instance->last) {
-        move->move(where, instance->last, constructed_last);
-    }
-
-    move->move(instance->first, where, tmp.first);
+    CSTL_type_move(move, value, (char*)value + type_size, constructed_first);
+    CSTL_vector_relocate_split(instance, move, where, tmp.first, constructed_last);
 
     CSTL_vector_replace(instance, fake_alignment, &move->drop_type, alloc, tmp);
 
@@ -823,15 +903,17 @@ CSTL_VectorIter CSTL_vector_copy_insert(CSTL_VectorRef instance, CSTL_CopyTypeCR
         return where;
     }
 
-    if (old_last != instance->end) {
-        instance->last = (char*)old_last + type_size;
+    size_t where_bytes = (size_t)((char*)where_pointer - (char*)instance->first);
 
-        if (where_pointer != old_last) {
-            CSTL_vector_sized_move_backwards(type_size, &copy->move_type, where_pointer, old_last, old_last);
-            copy->move_type.drop_type.drop(where_pointer, (char*)where_pointer + type_size);
-        }
+    if (CSTL_vector_try_make_room(instance, type_size, &copy->move_type, type_size,
+        value, (const char*)value + type_size, alloc)) {
+        where_pointer  = (char*)instance->first + where_bytes;
+        old_last       = instance->last;
+        where.pointer  = where_pointer;
+        instance->last = (char*)old_last + type_size;
 
-        copy->copy(value, (const char*)value + type_size, where_pointer);
+        CSTL_vector_open_gap(type_size, &copy->move_type, where_pointer, old_last, type_size);
+        CSTL_type_copy(copy, value, (const char*)value + type_size, where_pointer);
     } else {
         where.pointer = CSTL_vector_copy_insert_reallocate(instance, copy, type_size, where_pointer, value, alloc);
     }
@@ -853,18 +935,17 @@ CSTL_VectorIter CSTL_vector_move_insert(CSTL_VectorRef instance, CSTL_MoveTypeCR
         return where;
     }
 
-    if (old_last != instance->end) {
-        instance->last = (char*)old_last + type_size;
-
-        if (where_pointer != old_last) {
-            void* old_back = (char*)old_last - type_size;
+    size_t where_bytes = (size_t)((char*)where_pointer - (char*)instance->first);
 
-            move->move(old_back, old_last, old_last);
-            CSTL_vector_sized_move_backwards(type_size, move, where_pointer, old_back, old_last);
-            move->drop_type.drop(where_pointer, (char*)where_pointer + type_size);
-        }
+    if (CSTL_vector_try_make_room(instance, type_size, move, type_size,
+        value, (char*)value + type_size, alloc)) {
+        where_pointer  = (char*)instance->first + where_bytes;
+        old_last       = instance->last;
+        where.pointer  = where_pointer;
+        instance->last = (char*)old_last + type_size;
 
-        move->move(value, (char*)value + type_size, where_pointer);
+        CSTL_vector_open_gap(type_size, move, where_pointer, old_last, type_size);
+        CSTL_type_move(move, value, (char*)value + type_size, where_pointer);
     } else {
         where.pointer = CSTL_vector_move_insert_reallocate(instance, move, type_size, where_pointer, value, alloc);
     }
@@ -886,10 +967,9 @@ CSTL_VectorIter CSTL_vector_copy_insert_range(CSTL_VectorRef instance, CSTL_Copy
 
     void* where_pointer = (void*)where.pointer;
 
-    size_t where_bytes  = (size_t)((char*)where_pointer - (char*)instance->first);
-    size_t unused_bytes = (size_t)((char*)instance->end - (char*)instance->last);
+    size_t where_bytes = (size_t)((char*)where_pointer - (char*)instance->first);
 
-    if (new_bytes > unused_bytes) {
+    if (!CSTL_vector_try_make_room(instance, type_size, &copy->move_type, new_bytes, range_first, range_last, alloc)) {
         size_t old_bytes = CSTL_vector_size_bytes(instance);
 
         if (new_bytes > CSTL_vector_bytes_max(type_size) - old_bytes) {
@@ -911,36 +991,19 @@ CSTL_VectorIter CSTL_vector_copy_insert_range(CSTL_VectorRef instance, CSTL_Copy
         void* constructed_first = (char*)tmp.first + where_bytes;
         void* constructed_last  = (char*)constructed_first + new_bytes;
 
-        copy->copy(range_first, range_last, constructed_first);
-    
-        if (where_pointer != instance->last) {
-            copy->move_type.move(where_pointer, instance->last, constructed_last);
-        }
-
-        copy->move_type.move(instance->first, where_pointer, tmp.first);
+        CSTL_type_copy(copy, range_first, range_last, constructed_first);
+        CSTL_vector_relocate_split(instance, &copy->move_type, where_pointer, tmp.first, constructed_last);
 
         CSTL_vector_replace(instance, alignment, &copy->move_type.drop_type, alloc, tmp);
 
         where_pointer = constructed_first;
     } else {
-        void* old_last = instance->last;
+        where_pointer = (char*)instance->first + where_bytes;
 
-        size_t affected_bytes = (size_t)((char*)instance->last - (char*)where_pointer);
-
-        if (new_bytes > affected_bytes) {
-            void* new_mid  = (char*)old_last + new_bytes - affected_bytes;
-
-            copy->move_type.move(where_pointer, old_last, new_mid);
-            copy->move_type.drop_type.drop(where_pointer, old_last);
-        } else {
-            void* new_mid  = (char*)old_last - new_bytes;
-
-            copy->move_type.move(new_mid, old_last, old_last);
-            CSTL_vector_sized_move_backwards(type_size, &copy->move_type, where_pointer, new_mid, old_last);
-            copy->move_type.drop_type.drop(where_pointer, (char*)where_pointer + new_bytes);
-        }
+        void* old_last = instance->last;
 
-        copy->copy(range_first, range_last, where_pointer);
+        CSTL_vector_open_gap(type_size, &copy->move_type, where_pointer, old_last, new_bytes);
+        CSTL_type_copy(copy, range_first, range_last, where_pointer);
         instance->last = (char*)old_last + new_bytes;
     }
 
@@ -962,10 +1025,9 @@ CSTL_VectorIter CSTL_vector_move_insert_range(CSTL_VectorRef instance, CSTL_Move
 
     void* where_pointer = (void*)where.pointer;
 
-    size_t where_bytes  = (size_t)((char*)where_pointer - (char*)instance->first);
-    size_t unused_bytes = (size_t)((char*)instance->end - (char*)instance->last);
+    size_t where_bytes = (size_t)((char*)where_pointer - (char*)instance->first);
 
-    if (new_bytes > unused_bytes) {
+    if (!CSTL_vector_try_make_room(instance, type_size, move, new_bytes, range_first, range_last, alloc)) {
         size_t old_bytes = CSTL_vector_size_bytes(instance);
 
         if (new_bytes > CSTL_vector_bytes_max(type_size) - old_bytes) {
@@ -987,36 +1049,19 @@ CSTL_VectorIter CSTL_vector_move_insert_range(CSTL_VectorRef instance, CSTL_Move
         void* constructed_first = (char*)tmp.first + where_bytes;
         void* constructed_last  = (char*)constructed_first + new_bytes;
 
-        move->move(range_first, range_last, constructed_first);
-    
-        if (where_pointer != instance->last) {
-            move->move(where_pointer, instance->last, constructed_last);
-        }
-
-        move->move(instance->first, where_pointer, tmp.first);
+        CSTL_type_move(move, range_first, range_last, constructed_first);
+        CSTL_vector_relocate_split(instance, move, where_pointer, tmp.first, constructed_last);
 
         CSTL_vector_replace(instance, alignment, &move->drop_type, alloc, tmp);
 
         where_pointer = constructed_first;
     } else {
-        void* old_last = instance->last;
-
-        size_t affected_bytes = (size_t)((char*)instance->last - (char*)where_pointer);
-
-        if (new_bytes > affected_bytes) {
-            void* new_mid  = (char*)old_last + new_bytes - affected_bytes;
+        where_pointer = (char*)instance->first + where_bytes;
 
-            move->move(where_pointer, old_last, new_mid);
-            move->drop_type.drop(where_pointer, old_last);
-        } else {
-            void* new_mid  = (char*)old_last - new_bytes;
-
-            move->move(new_mid, old_last, old_last);
-            CSTL_vector_sized_move_backwards(type_size, move, where_pointer, new_mid, old_last);
-            move->drop_type.drop(where_pointer, (char*)where_pointer + new_bytes);
-        }
+        void* old_last = instance->last;
 
-        move->move(range_first, range_last, where_pointer);
+        CSTL_vector_open_gap(type_size, move, where_pointer, old_last, new_bytes);
+        CSTL_type_move(move, range_first, range_last, where_pointer);
         instance->last = (char*)old_last + new_bytes;
     }
 
@@ -1040,7 +1085,7 @@ void CSTL_vector_pop_back(CSTL_VectorRef instance, CSTL_Type type, CSTL_DropType
     void* new_last = CSTL_vector_back(instance, type);
     void* old_last = instance->last;
 
-    drop->drop(new_last, old_last);
+    CSTL_type_drop(drop, new_last, old_last);
 
     instance->last = new_last;
 }
@@ -1055,10 +1100,21 @@ CSTL_VectorIter CSTL_vector_erase_range(CSTL_VectorRef instance, CSTL_MoveTypeCR
     assert(first.owner == instance && first.owner == last.owner);
 
     if (first.pointer != last.pointer) { // something to do
-        void* new_last = CSTL_vector_sized_move(last.size, move, (void*)last.pointer,
-            instance->last, (void*)first.pointer);
+        void* new_last;
+
+        if (CSTL_type_is_relocatable(move)) {
+            size_t tail_bytes = (size_t)((char*)instance->last - (char*)last.pointer);
+
+            CSTL_type_drop(&move->drop_type, (void*)first.pointer, (void*)last.pointer);
+            memmove((void*)first.pointer, last.pointer, tail_bytes);
 
-        move->drop_type.drop(new_last, instance->last);
+            new_last = (char*)first.pointer + tail_bytes;
+        } else {
+            new_last = CSTL_vector_sized_move(last.size, move, (void*)last.pointer,
+                instance->last, (void*)first.pointer);
+
+            CSTL_type_drop(&move->drop_type, new_last, instance->last);
+        }
 
         instance->last = new_last;
     }
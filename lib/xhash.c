@@ -0,0 +1,552 @@
+#include "xhash.h"
+
+#include "internal/alloc_dispatch.h"
+#include "internal/type_ext.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define CSTL_hash_prefetch(pointer) __builtin_prefetch((pointer))
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <xmmintrin.h>
+#define CSTL_hash_prefetch(pointer) _mm_prefetch((const char*)(pointer), _MM_HINT_T0)
+#else
+#define CSTL_hash_prefetch(pointer) ((void)(pointer))
+#endif
+
+#define CSTL_hash_min_buckets ((size_t)8)
+
+// Distance in lookups between the stages of `CSTL_hash_find_n`, a power of 2.
+#define CSTL_hash_lookahead ((size_t)8)
+
+static inline size_t CSTL_hash_node_alignment(CSTL_Type type) {
+    size_t alignment = CSTL_type_alignment(type);
+    return alignment > _Alignof(CSTL_HashNode) ? alignment : _Alignof(CSTL_HashNode);
+}
+
+// Offset of the element in a node, as in `std::_List_node`.
+static inline size_t CSTL_hash_value_offset(CSTL_Type type) {
+    size_t alignment = CSTL_type_alignment(type);
+    return (sizeof(CSTL_HashNode) + alignment - 1) & ~(alignment - 1);
+}
+
+static inline size_t CSTL_hash_node_size(CSTL_Type type) {
+    size_t alignment = CSTL_hash_node_alignment(type);
+    size_t size      = CSTL_hash_value_offset(type) + CSTL_type_size(type);
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+static inline void* CSTL_hash_value(CSTL_HashNode* node, size_t offset) {
+    return (char*)node + offset;
+}
+
+static inline CSTL_HashNode** CSTL_hash_buckets(CSTL_HashCRef instance) {
+    return (CSTL_HashNode**)instance->buckets.first;
+}
+
+static inline CSTL_HashIter CSTL_hash_make_iter(CSTL_HashNode* node, size_t offset) {
+    CSTL_HashIter iterator = { node, offset };
+    return iterator;
+}
+
+static inline void CSTL_hash_free_node(CSTL_HashNode* node, CSTL_Type type, CSTL_Alloc* alloc) {
+    CSTL_free(node, CSTL_hash_node_size(type), CSTL_hash_node_alignment(type), alloc);
+}
+
+// Searches the bucket of `hash_value` from its last node backwards, like `std::_Hash::_Find_last`.
+// Returns the list head if there is no element with a key equal to `key`.
+static inline CSTL_HashNode* CSTL_hash_find_node(CSTL_HashCRef instance, size_t offset, CSTL_HashTypeCRef hash, const void* key, size_t hash_value) {
+    CSTL_HashNode** buckets = CSTL_hash_buckets(instance);
+    CSTL_HashNode* head     = instance->head;
+
+    size_t bucket = hash_value & instance->mask;
+
+    CSTL_HashNode* where = buckets[(bucket << 1) + 1];
+
+    if (where == head) {
+        return head;
+    }
+
+    CSTL_HashNode* bucket_lo = buckets[bucket << 1];
+
+    for (;;) {
+        if (hash->is_eq(key, CSTL_hash_value(where, offset))) {
+            return where;
+        }
+
+        if (where == bucket_lo) {
+            return head;
+        }
+
+        where = where->prev;
+    }
+}
+
+// Rebuilds the buckets with `bucket_count`, a power of 2, in one pass over the list.
+static bool CSTL_hash_forced_rehash(CSTL_HashRef instance, size_t offset, CSTL_HashTypeCRef hash, size_t bucket_count, CSTL_Alloc* alloc) {
+    CSTL_HashNode* head = instance->head;
+    CSTL_PodType pod    = CSTL_pod_pointer;
+
+    if (bucket_count > CSTL_vector_max_size(pod.type) / 2) {
+        return false;
+    }
+
+    if (!CSTL_vector_assign_n(&instance->buckets, pod.type, &pod.copy, bucket_count << 1, &head, alloc)) {
+        return false;
+    }
+
+    instance->mask      = bucket_count - 1;
+    instance->max_index = bucket_count;
+
+    CSTL_HashNode** buckets = CSTL_hash_buckets(instance);
+    CSTL_HashNode* inserted = head->next;
+
+    // The nodes before `inserted` are already grouped by bucket.
+    while (inserted != head) {
+        CSTL_HashNode* next = inserted->next;
+
+        CSTL_hash_prefetch(next->next);
+
+        size_t bucket = hash->hash(CSTL_hash_value(inserted, offset)) & instance->mask;
+
+        CSTL_HashNode** bucket_lo = &buckets[bucket << 1];
+        CSTL_HashNode** bucket_hi = &buckets[(bucket << 1) + 1];
+
+        if (*bucket_lo == head) {
+            *bucket_lo = inserted;
+        } else if ((*bucket_hi)->next != inserted) {
+            // Splice `inserted` right after the last node of its bucket.
+            CSTL_HashNode* insert_after = *bucket_hi;
+
+            inserted->prev->next = next;
+            next->prev           = inserted->prev;
+
+            inserted->prev           = insert_after;
+            inserted->next           = insert_after->next;
+            insert_after->next->prev = inserted;
+            insert_after->next       = inserted;
+        }
+
+        *bucket_hi = inserted;
+        inserted   = next;
+    }
+
+    return true;
+}
+
+// Smallest bucket count that keeps `count` elements under the maximum load factor.
+static inline size_t CSTL_hash_min_load_factor_buckets(CSTL_HashCRef instance, size_t count) {
+    float buckets = (float)count / instance->max_load_factor;
+
+    if (buckets >= (float)SIZE_MAX) {
+        return SIZE_MAX;
+    }
+
+    size_t result = (size_t)buckets;
+    return (float)result < buckets ? result + 1 : result;
+}
+
+static inline size_t CSTL_hash_ceil_pow2(size_t value) {
+    size_t result = CSTL_hash_min_buckets;
+
+    while (result < value && result <= SIZE_MAX / 2) {
+        result <<= 1;
+    }
+
+    return result < value ? SIZE_MAX : result;
+}
+
+// Grows the buckets ahead of inserting one element, like `std::_Hash::_Desired_grow_bucket_count`:
+// small tables grow 8-fold at once, so a burst of insertions rehashes only a few times.
+static bool CSTL_hash_check_rehash(CSTL_HashRef instance, size_t offset, CSTL_HashTypeCRef hash, CSTL_Alloc* alloc) {
+    size_t new_size    = instance->size + 1;
+    size_t old_buckets = instance->max_index;
+
+    if (!(instance->max_load_factor < (float)new_size / (float)old_buckets)) {
+        return true;
+    }
+
+    size_t required = CSTL_hash_min_load_factor_buckets(instance, new_size);
+
+    if (required <= old_buckets) {
+        return true;
+    }
+
+    size_t desired = old_buckets < 512 && old_buckets * 8 >= required ? old_buckets * 8 : required;
+    size_t buckets = CSTL_hash_ceil_pow2(desired);
+
+    if (buckets == SIZE_MAX) {
+        return false;
+    }
+
+    return CSTL_hash_forced_rehash(instance, offset, hash, buckets, alloc);
+}
+
+// Links `new_node` before `insert_before`, like `std::_Hash::_Insert_new_node_before`.
+static inline void CSTL_hash_link_node(CSTL_HashRef instance, size_t hash_value, CSTL_HashNode* insert_before, CSTL_HashNode* new_node) {
+    CSTL_HashNode* insert_after = insert_before->prev;
+    CSTL_HashNode* head         = instance->head;
+
+    instance->size += 1;
+
+    new_node->next      = insert_before;
+    new_node->prev      = insert_after;
+    insert_after->next  = new_node;
+    insert_before->prev = new_node;
+
+    CSTL_HashNode** buckets = CSTL_hash_buckets(instance);
+
+    size_t bucket = hash_value & instance->mask;
+
+    CSTL_HashNode** bucket_lo = &buckets[bucket << 1];
+    CSTL_HashNode** bucket_hi = &buckets[(bucket << 1) + 1];
+
+    if (*bucket_lo == head) {
+        *bucket_lo = new_node;
+        *bucket_hi = new_node;
+    } else if (*bucket_lo == insert_before) {
+        *bucket_lo = new_node;
+    } else if (*bucket_hi == insert_after) {
+        *bucket_hi = new_node;
+    }
+}
+
+// Finds `value` or prepares an unlinked node for it. Returns the existing node,
+// a new node with uninitialized storage (setting `*is_new`), or `NULL` on failure.
+static CSTL_HashNode* CSTL_hash_prepare_insert(CSTL_HashRef instance, CSTL_Type type, CSTL_HashTypeCRef hash, const void* value, size_t* hash_value, bool* is_new, CSTL_Alloc* alloc) {
+    size_t offset = CSTL_hash_value_offset(type);
+
+    *is_new     = false;
+    *hash_value = hash->hash(value);
+
+    CSTL_HashNode* found = CSTL_hash_find_node(instance, offset, hash, value, *hash_value);
+
+    if (found != instance->head) {
+        return found;
+    }
+
+    CSTL_HashNode* new_node = CSTL_allocate(CSTL_hash_node_size(type), CSTL_hash_node_alignment(type), alloc);
+
+    if (new_node == NULL) {
+        return NULL;
+    }
+
+    if (!CSTL_hash_check_rehash(instance, offset, hash, alloc)) {
+        CSTL_hash_free_node(new_node, type, alloc);
+        return NULL;
+    }
+
+    *is_new = true;
+
+    return new_node;
+}
+
+// Insertion point of a new node with `hash_value`: before the first node of its bucket,
+// or at the end of the list if the bucket is empty.
+static inline CSTL_HashNode* CSTL_hash_insert_point(CSTL_HashCRef instance, size_t hash_value) {
+    return CSTL_hash_buckets(instance)[(hash_value & instance->mask) << 1];
+}
+
+bool CSTL_hash_construct(CSTL_HashVal* new_instance, CSTL_Type type, CSTL_Alloc* alloc) {
+    CSTL_HashNode* head = CSTL_allocate(CSTL_hash_node_size(type), CSTL_hash_node_alignment(type), alloc);
+
+    new_instance->max_load_factor = 1.0f;
+    new_instance->head            = head;
+    new_instance->size            = 0;
+    new_instance->mask            = CSTL_hash_min_buckets - 1;
+    new_instance->max_index       = CSTL_hash_min_buckets;
+
+    CSTL_vector_construct(&new_instance->buckets);
+
+    if (head == NULL) {
+        return false;
+    }
+
+    head->next = head;
+    head->prev = head;
+
+    CSTL_PodType pod = CSTL_pod_pointer;
+
+    if (!CSTL_vector_assign_n(&new_instance->buckets, pod.type, &pod.copy, CSTL_hash_min_buckets << 1, &head, alloc)) {
+        CSTL_hash_free_node(head, type, alloc);
+        new_instance->head = NULL;
+        return false;
+    }
+
+    return true;
+}
+
+void CSTL_hash_destroy(CSTL_HashRef instance, CSTL_Type type, CSTL_DropTypeCRef drop, CSTL_Alloc* alloc) {
+    if (instance->head == NULL) {
+        return;
+    }
+
+    CSTL_hash_clear(instance, type, drop, alloc);
+    CSTL_hash_free_node(instance->head, type, alloc);
+
+    CSTL_PodType pod = CSTL_pod_pointer;
+    CSTL_vector_destroy(&instance->buckets, pod.type, &pod.copy.move_type.drop_type, alloc);
+
+    instance->head = NULL;
+}
+
+void CSTL_hash_clear(CSTL_HashRef instance, CSTL_Type type, CSTL_DropTypeCRef drop, CSTL_Alloc* alloc) {
+    if (instance->size == 0) {
+        return;
+    }
+
+    CSTL_HashNode* head = instance->head;
+    CSTL_HashNode* node = head->next;
+
+    size_t offset    = CSTL_hash_value_offset(type);
+    size_t type_size = CSTL_type_size(type);
+
+    while (node != head) {
+        CSTL_HashNode* next = node->next;
+        char* value         = CSTL_hash_value(node, offset);
+
+        CSTL_type_drop(drop, value, value + type_size);
+        CSTL_hash_free_node(node, type, alloc);
+
+        node = next;
+    }
+
+    CSTL_HashNode** buckets = CSTL_hash_buckets(instance);
+
+    for (size_t i = 0; i < instance->max_index << 1; ++i) {
+        buckets[i] = head;
+    }
+
+    head->next     = head;
+    head->prev     = head;
+    instance->size = 0;
+}
+
+void CSTL_hash_swap(CSTL_HashRef instance, CSTL_HashRef other_instance) {
+    CSTL_HashVal tmp = *instance;
+    *instance        = *other_instance;
+    *other_instance  = tmp;
+}
+
+bool CSTL_hash_empty(CSTL_HashCRef instance) {
+    return instance->size == 0;
+}
+
+size_t CSTL_hash_size(CSTL_HashCRef instance) {
+    return instance->size;
+}
+
+size_t CSTL_hash_bucket_count(CSTL_HashCRef instance) {
+    return instance->max_index;
+}
+
+float CSTL_hash_load_factor(CSTL_HashCRef instance) {
+    return (float)instance->size / (float)instance->max_index;
+}
+
+float CSTL_hash_max_load_factor(CSTL_HashCRef instance) {
+    return instance->max_load_factor;
+}
+
+void CSTL_hash_set_max_load_factor(CSTL_HashRef instance, float max_load_factor) {
+    assert(max_load_factor > 0.0f);
+    instance->max_load_factor = max_load_factor;
+}
+
+CSTL_HashIter CSTL_hash_begin(CSTL_HashCRef instance, CSTL_Type type) {
+    return CSTL_hash_make_iter(instance->head->next, CSTL_hash_value_offset(type));
+}
+
+CSTL_HashIter CSTL_hash_end(CSTL_HashCRef instance, CSTL_Type type) {
+    return CSTL_hash_make_iter(instance->head, CSTL_hash_value_offset(type));
+}
+
+CSTL_HashIter CSTL_hash_iterator_next(CSTL_HashIter iterator) {
+    iterator.node = iterator.node->next;
+    return iterator;
+}
+
+void* CSTL_hash_iterator_deref(CSTL_HashIter iterator) {
+    return CSTL_hash_value(iterator.node, iterator.offset);
+}
+
+bool CSTL_hash_iterator_eq(CSTL_HashIter lhs, CSTL_HashIter rhs) {
+    return lhs.node == rhs.node;
+}
+
+CSTL_HashIter CSTL_hash_find(CSTL_HashCRef instance, CSTL_Type type, CSTL_HashTypeCRef hash, const void* key) {
+    size_t offset = CSTL_hash_value_offset(type);
+    return CSTL_hash_make_iter(CSTL_hash_find_node(instance, offset, hash, key, hash->hash(key)), offset);
+}
+
+bool CSTL_hash_contains(CSTL_HashCRef instance, CSTL_Type type, CSTL_HashTypeCRef hash, const void* key) {
+    size_t offset = CSTL_hash_value_offset(type);
+    return CSTL_hash_find_node(instance, offset, hash, key, hash->hash(key)) != instance->head;
+}
+
+void CSTL_hash_find_n(CSTL_HashCRef instance, CSTL_Type type, CSTL_HashTypeCRef hash, const void* const* keys, size_t count, void** elements) {
+    CSTL_HashNode** buckets = CSTL_hash_buckets(instance);
+    CSTL_HashNode* head     = instance->head;
+
+    size_t offset = CSTL_hash_value_offset(type);
+    size_t mask   = instance->mask;
+
+    // Lookups go through three stages, `CSTL_hash_lookahead` lookups apart: hashing the key
+    // and prefetching its bucket, prefetching the last node of the bucket, and comparing keys.
+    size_t hash_values[4 * CSTL_hash_lookahead];
+
+    for (size_t i = 0; i < count + 2 * CSTL_hash_lookahead; ++i) {
+        if (i < count) {
+            size_t hash_value = hash->hash(keys[i]);
+
+            hash_values[i % (4 * CSTL_hash_lookahead)] = hash_value;
+            CSTL_hash_prefetch(&buckets[((hash_value & mask) << 1) + 1]);
+        }
+
+        if (i >= CSTL_hash_lookahead && i - CSTL_hash_lookahead < count) {
+            size_t hash_value = hash_values[(i - CSTL_hash_lookahead) % (4 * CSTL_hash_lookahead)];
+
+            CSTL_HashNode* bucket_hi = buckets[((hash_value & mask) << 1) + 1];
+
+            if (bucket_hi != head) {
+                CSTL_hash_prefetch(CSTL_hash_value(bucket_hi, offset));
+            }
+        }
+
+        if (i >= 2 * CSTL_hash_lookahead) {
+            size_t j = i - 2 * CSTL_hash_lookahead;
+
+            if (j < count) {
+                size_t hash_value   = hash_values[j % (4 * CSTL_hash_lookahead)];
+                CSTL_HashNode* node = CSTL_hash_find_node(instance, offset, hash, keys[j], hash_value);
+
+                elements[j] = node != head ? CSTL_hash_value(node, offset) : NULL;
+            }
+        }
+    }
+}
+
+CSTL_HashIter CSTL_hash_copy_insert(CSTL_HashRef instance, CSTL_Type type, CSTL_HashTypeCRef hash, CSTL_CopyTypeCRef copy, const void* value, bool* inserted, CSTL_Alloc* alloc) {
+    size_t offset     = CSTL_hash_value_offset(type);
+    size_t hash_value = 0;
+    bool is_new       = false;
+
+    CSTL_HashNode* node = CSTL_hash_prepare_insert(instance, type, hash, value, &hash_value, &is_new, alloc);
+
+    if (inserted != NULL) {
+        *inserted = is_new;
+    }
+
+    if (node == NULL) {
+        return CSTL_hash_end(instance, type);
+    }
+
+    if (is_new) {
+        char* dest = CSTL_hash_value(node, offset);
+
+        CSTL_type_copy(copy, value, (const char*)value + CSTL_type_size(type), dest);
+        CSTL_hash_link_node(instance, hash_value, CSTL_hash_insert_point(instance, hash_value), node);
+    }
+
+    return CSTL_hash_make_iter(node, offset);
+}
+
+CSTL_HashIter CSTL_hash_move_insert(CSTL_HashRef instance, CSTL_Type type, CSTL_HashTypeCRef hash, CSTL_MoveTypeCRef move, void* value, bool* inserted, CSTL_Alloc* alloc) {
+    size_t offset     = CSTL_hash_value_offset(type);
+    size_t hash_value = 0;
+    bool is_new       = false;
+
+    CSTL_HashNode* node = CSTL_hash_prepare_insert(instance, type, hash, value, &hash_value, &is_new, alloc);
+
+    if (inserted != NULL) {
+        *inserted = is_new;
+    }
+
+    if (node == NULL) {
+        return CSTL_hash_end(instance, type);
+    }
+
+    if (is_new) {
+        char* dest = CSTL_hash_value(node, offset);
+
+        CSTL_type_move(move, value, (char*)value + CSTL_type_size(type), dest);
+        CSTL_hash_link_node(instance, hash_value, CSTL_hash_insert_point(instance, hash_value), node);
+    }
+
+    return CSTL_hash_make_iter(node, offset);
+}
+
+CSTL_HashIter CSTL_hash_erase(CSTL_HashRef instance, CSTL_Type type, CSTL_HashTypeCRef hash, CSTL_DropTypeCRef drop, CSTL_HashIter where, CSTL_Alloc* alloc) {
+    CSTL_HashNode* node = where.node;
+    CSTL_HashNode* next = node->next;
+    CSTL_HashNode* head = instance->head;
+
+    assert(node != head);
+
+    char* value = CSTL_hash_value(node, where.offset);
+
+    CSTL_HashNode** buckets = CSTL_hash_buckets(instance);
+
+    size_t bucket = hash->hash(value) & instance->mask;
+
+    CSTL_HashNode** bucket_lo = &buckets[bucket << 1];
+    CSTL_HashNode** bucket_hi = &buckets[(bucket << 1) + 1];
+
+    if (*bucket_lo == node) {
+        if (*bucket_hi == node) {
+            *bucket_lo = head;
+            *bucket_hi = head;
+        } else {
+            *bucket_lo = next;
+        }
+    } else if (*bucket_hi == node) {
+        *bucket_hi = node->prev;
+    }
+
+    node->prev->next = next;
+    next->prev       = node->prev;
+    instance->size  -= 1;
+
+    CSTL_type_drop(drop, value, value + CSTL_type_size(type));
+    CSTL_hash_free_node(node, type, alloc);
+
+    return CSTL_hash_make_iter(next, where.offset);
+}
+
+size_t CSTL_hash_erase_key(CSTL_HashRef instance, CSTL_Type type, CSTL_HashTypeCRef hash, CSTL_DropTypeCRef drop, const void* key, CSTL_Alloc* alloc) {
+    CSTL_HashIter where = CSTL_hash_find(instance, type, hash, key);
+
+    if (where.node == instance->head) {
+        return 0;
+    }
+
+    CSTL_hash_erase(instance, type, hash, drop, where, alloc);
+
+    return 1;
+}
+
+bool CSTL_hash_rehash(CSTL_HashRef instance, CSTL_Type type, CSTL_HashTypeCRef hash, size_t bucket_count, CSTL_Alloc* alloc) {
+    size_t required = CSTL_hash_min_load_factor_buckets(instance, instance->size);
+
+    if (bucket_count < required) {
+        bucket_count = required;
+    }
+
+    if (bucket_count <= instance->max_index) {
+        return true;
+    }
+
+    size_t buckets = CSTL_hash_ceil_pow2(bucket_count);
+
+    if (buckets == SIZE_MAX) {
+        return false;
+    }
+
+    return CSTL_hash_forced_rehash(instance, CSTL_hash_value_offset(type), hash, buckets, alloc);
+}
+
+bool CSTL_hash_reserve(CSTL_HashRef instance, CSTL_Type type, CSTL_HashTypeCRef hash, size_t count, CSTL_Alloc* alloc) {
+    return CSTL_hash_rehash(instance, type, hash, CSTL_hash_min_load_factor_buckets(instance, count), alloc);
+}
@@ -0,0 +1,273 @@
+#pragma once
+
+#ifndef CSTL_XHASH_H
+#define CSTL_XHASH_H
+
+#include "alloc.h"
+#include "type.h"
+#include "vector.h"
+
+#if defined(__cplusplus)
+#include <cstddef>
+extern "C" {
+#else
+#include <stdbool.h>
+#include <stddef.h>
+#endif
+
+/**
+ * STL ABI list node header of a hash table, followed by the element.
+ * 
+ */
+typedef struct CSTL_HashNode {
+    struct CSTL_HashNode* next;
+    struct CSTL_HashNode* prev;
+} CSTL_HashNode;
+
+/**
+ * STL ABI `std::_Hash` layout, the common base of `std::unordered_map`
+ * and `std::unordered_set`.
+ * 
+ * Elements are stored in a doubly-linked list of nodes, where the nodes of
+ * each bucket are adjacent. `buckets` holds two node pointers per bucket,
+ * the first and the last node of the bucket, or the list head twice if the
+ * bucket is empty. The bucket count is a power of 2 and an element is in
+ * bucket `hash & mask`.
+ * 
+ * The key of an element must be stored at its start, as it is in a set or
+ * in the `std::pair<const Key, T>` of a map. The functions of a `CSTL_HashType`
+ * are called with pointers to keys or elements interchangeably.
+ * 
+ * Only stateless hashers and key comparators are supported, which leave
+ * `max_load_factor` as the only member of the traits object.
+ * 
+ * Does not include the allocator, which nonetheless is a part of the `std::_Hash`
+ * structure! You are responsible for including it, since it can take on any form.
+ * 
+ * Do not manipulate the members directly, use the associated functions!
+ * 
+ */
+typedef struct CSTL_HashVal {
+    float max_load_factor;
+    CSTL_HashNode* head;
+    size_t size;
+    CSTL_VectorVal buckets;
+    size_t mask;
+    size_t max_index;
+} CSTL_HashVal;
+
+/**
+ * Reference to a mutable `CSTL_HashVal`.
+ * 
+ * Must not be null.
+ * 
+ */
+typedef CSTL_HashVal* CSTL_HashRef;
+
+/**
+ * Reference to a const `CSTL_HashVal`.
+ * 
+ * Must not be null.
+ * 
+ */
+typedef const CSTL_HashVal* CSTL_HashCRef;
+
+/**
+ * An iterator over elements of a hash table.
+ * 
+ * Not ABI-compatible with `std::unordered_map::iterator`.
+ * 
+ */
+typedef struct CSTL_HashIter {
+    CSTL_HashNode* node;
+    size_t offset;
+} CSTL_HashIter;
+
+/**
+ * Initializes the hash table pointed to by `new_instance` with 8 empty buckets.
+ * 
+ * Like its C++ counterpart, an empty hash table owns a list head node and
+ * bucket storage, which must be freed with `CSTL_hash_destroy`. Returns `false`
+ * if the allocation fails, in which case nothing needs to be freed.
+ * 
+ */
+bool CSTL_hash_construct(CSTL_HashVal* new_instance, CSTL_Type type, CSTL_Alloc* alloc);
+
+/**
+ * Destroys the hash table pointed to by `instance`, destroying elements
+ * and freeing all nodes and the bucket storage.
+ * 
+ */
+void CSTL_hash_destroy(CSTL_HashRef instance, CSTL_Type type, CSTL_DropTypeCRef drop, CSTL_Alloc* alloc);
+
+/**
+ * Destroys all elements, keeping the bucket count.
+ * 
+ */
+void CSTL_hash_clear(CSTL_HashRef instance, CSTL_Type type, CSTL_DropTypeCRef drop, CSTL_Alloc* alloc);
+
+/**
+ * Swaps the contents of two hash tables.
+ * 
+ * You are responsible for swapping the allocators outside of `CSTL_HashVal` if applicable.
+ * 
+ */
+void CSTL_hash_swap(CSTL_HashRef instance, CSTL_HashRef other_instance);
+
+/**
+ * Returns `true` if the hash table is empty.
+ * 
+ */
+bool CSTL_hash_empty(CSTL_HashCRef instance);
+
+/**
+ * Returns the number of elements in the hash table.
+ * 
+ */
+size_t CSTL_hash_size(CSTL_HashCRef instance);
+
+/**
+ * Returns the number of buckets, always a power of 2.
+ * 
+ */
+size_t CSTL_hash_bucket_count(CSTL_HashCRef instance);
+
+/**
+ * Returns the average number of elements per bucket.
+ * 
+ */
+float CSTL_hash_load_factor(CSTL_HashCRef instance);
+
+/**
+ * Returns the load factor above which the bucket count is increased.
+ * 
+ */
+float CSTL_hash_max_load_factor(CSTL_HashCRef instance);
+
+/**
+ * Sets the load factor above which the bucket count is increased,
+ * which must be positive. Takes effect on the next insertion.
+ * 
+ */
+void CSTL_hash_set_max_load_factor(CSTL_HashRef instance, float max_load_factor);
+
+/**
+ * Returns an iterator to the first element.
+ * 
+ */
+CSTL_HashIter CSTL_hash_begin(CSTL_HashCRef instance, CSTL_Type type);
+
+/**
+ * Returns an iterator past the last element.
+ * 
+ */
+CSTL_HashIter CSTL_hash_end(CSTL_HashCRef instance, CSTL_Type type);
+
+/**
+ * Advances the iterator to the next element.
+ * 
+ */
+CSTL_HashIter CSTL_hash_iterator_next(CSTL_HashIter iterator);
+
+/**
+ * Dereferences the iterator at the element it's pointing to.
+ * 
+ * Returns a pointer to the element.
+ * 
+ * `iterator` must be dereferenceable. The key of the element must not be mutated.
+ * 
+ */
+void* CSTL_hash_iterator_deref(CSTL_HashIter iterator);
+
+/**
+ * Returns `true` if both iterators point to the same element.
+ * 
+ */
+bool CSTL_hash_iterator_eq(CSTL_HashIter lhs, CSTL_HashIter rhs);
+
+/**
+ * Finds the element with a key equal to `key`.
+ * 
+ * Returns an iterator to the element, or the end iterator if there is none.
+ * 
+ */
+CSTL_HashIter CSTL_hash_find(CSTL_HashCRef instance, CSTL_Type type, CSTL_HashTypeCRef hash, const void* key);
+
+/**
+ * Returns `true` if an element with a key equal to `key` exists.
+ * 
+ */
+bool CSTL_hash_contains(CSTL_HashCRef instance, CSTL_Type type, CSTL_HashTypeCRef hash, const void* key);
+
+/**
+ * Finds the elements with keys equal to each of `keys[0]` to `keys[count - 1]`,
+ * writing a pointer to each element, or `NULL` if there is none, to `elements`.
+ * 
+ * Lookups are interleaved and bucket and node loads are prefetched, which hides
+ * most of the memory latency of large tables.
+ * 
+ */
+void CSTL_hash_find_n(CSTL_HashCRef instance, CSTL_Type type, CSTL_HashTypeCRef hash, const void* const* keys, size_t count, void** elements);
+
+/**
+ * Inserts a copy of `value` if no element with an equal key exists.
+ * 
+ * Returns an iterator to the inserted element, or to the element with an equal key.
+ * If `inserted` is not `NULL`, it is set to whether `value` was inserted.
+ * 
+ * If an allocation fails, the hash table is unchanged and the end iterator is returned.
+ * 
+ */
+CSTL_HashIter CSTL_hash_copy_insert(CSTL_HashRef instance, CSTL_Type type, CSTL_HashTypeCRef hash, CSTL_CopyTypeCRef copy, const void* value, bool* inserted, CSTL_Alloc* alloc);
+
+/**
+ * Inserts `value` by moving it if no element with an equal key exists.
+ * 
+ * Returns an iterator to the inserted element, or to the element with an equal key.
+ * If `inserted` is not `NULL`, it is set to whether `value` was inserted.
+ * 
+ * If an allocation fails, the hash table is unchanged and the end iterator is returned.
+ * 
+ */
+CSTL_HashIter CSTL_hash_move_insert(CSTL_HashRef instance, CSTL_Type type, CSTL_HashTypeCRef hash, CSTL_MoveTypeCRef move, void* value, bool* inserted, CSTL_Alloc* alloc);
+
+/**
+ * Erases the element at `where`, which must be dereferenceable.
+ * 
+ * Returns an iterator to the element following the erased one.
+ * 
+ */
+CSTL_HashIter CSTL_hash_erase(CSTL_HashRef instance, CSTL_Type type, CSTL_HashTypeCRef hash, CSTL_DropTypeCRef drop, CSTL_HashIter where, CSTL_Alloc* alloc);
+
+/**
+ * Erases the element with a key equal to `key`, if any.
+ * 
+ * Returns the number of erased elements.
+ * 
+ */
+size_t CSTL_hash_erase_key(CSTL_HashRef instance, CSTL_Type type, CSTL_HashTypeCRef hash, CSTL_DropTypeCRef drop, const void* key, CSTL_Alloc* alloc);
+
+/**
+ * Sets the bucket count to at least `bucket_count`, and at least as many
+ * as the elements need under the maximum load factor, rehashing all elements
+ * in one pass. Never decreases the bucket count.
+ * 
+ * Returns `false` if the allocation fails, leaving the hash table unchanged.
+ * 
+ */
+bool CSTL_hash_rehash(CSTL_HashRef instance, CSTL_Type type, CSTL_HashTypeCRef hash, size_t bucket_count, CSTL_Alloc* alloc);
+
+/**
+ * Sets the bucket count so that `count` elements fit without exceeding
+ * the maximum load factor, rehashing at most once.
+ * 
+ * Returns `false` if the allocation fails, leaving the hash table unchanged.
+ * 
+ */
+bool CSTL_hash_reserve(CSTL_HashRef instance, CSTL_Type type, CSTL_HashTypeCRef hash, size_t count, CSTL_Alloc* alloc);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
@@ -0,0 +1,886 @@
+#include "xtree.h"
+
+#include "internal/alloc_dispatch.h"
+#include "internal/type_ext.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define CSTL_tree_red   ((char)0)
+#define CSTL_tree_black ((char)1)
+
+// Where a new node is linked: as the left or right child of `parent`.
+typedef struct CSTL_TreeLoc {
+    CSTL_TreeNode* parent;
+    bool is_right;
+} CSTL_TreeLoc;
+
+static inline size_t CSTL_tree_node_alignment(CSTL_Type type) {
+    size_t alignment = CSTL_type_alignment(type);
+    return alignment > _Alignof(CSTL_TreeNode) ? alignment : _Alignof(CSTL_TreeNode);
+}
+
+// Offset of the element in a node, as in `std::_Tree_node`: the element
+// directly follows `_Isnil`, not the padded end of the node header.
+static inline size_t CSTL_tree_value_offset(CSTL_Type type) {
+    size_t alignment = CSTL_type_alignment(type);
+    return (offsetof(CSTL_TreeNode, is_nil) + 1 + alignment - 1) & ~(alignment - 1);
+}
+
+static inline size_t CSTL_tree_node_size(CSTL_Type type) {
+    size_t alignment = CSTL_tree_node_alignment(type);
+    size_t size      = CSTL_tree_value_offset(type) + CSTL_type_size(type);
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+static inline void* CSTL_tree_value(CSTL_TreeNode* node, size_t offset) {
+    return (char*)node + offset;
+}
+
+static inline CSTL_TreeIter CSTL_tree_make_iter(CSTL_TreeNode* node, size_t offset) {
+    CSTL_TreeIter iterator = { node, offset };
+    return iterator;
+}
+
+static inline void CSTL_tree_free_node(CSTL_TreeNode* node, CSTL_Type type, CSTL_Alloc* alloc) {
+    CSTL_free(node, CSTL_tree_node_size(type), CSTL_tree_node_alignment(type), alloc);
+}
+
+// Allocates a red node with both children set to `head`, leaving the element uninitialized.
+static inline CSTL_TreeNode* CSTL_tree_new_node(CSTL_TreeNode* head, CSTL_Type type, CSTL_Alloc* alloc) {
+    CSTL_TreeNode* node = CSTL_allocate(CSTL_tree_node_size(type), CSTL_tree_node_alignment(type), alloc);
+
+    if (node != NULL) {
+        node->left   = head;
+        node->parent = head;
+        node->right  = head;
+        node->color  = CSTL_tree_red;
+        node->is_nil = 0;
+    }
+
+    return node;
+}
+
+static inline CSTL_TreeNode* CSTL_tree_min(CSTL_TreeNode* node) {
+    while (!node->left->is_nil) {
+        node = node->left;
+    }
+
+    return node;
+}
+
+static inline CSTL_TreeNode* CSTL_tree_max(CSTL_TreeNode* node) {
+    while (!node->right->is_nil) {
+        node = node->right;
+    }
+
+    return node;
+}
+
+static inline CSTL_TreeNode* CSTL_tree_next(CSTL_TreeNode* node) {
+    if (!node->right->is_nil) {
+        return CSTL_tree_min(node->right);
+    }
+
+    CSTL_TreeNode* parent;
+
+    while (!(parent = node->parent)->is_nil && node == parent->right) {
+        node = parent;
+    }
+
+    return parent;
+}
+
+static inline CSTL_TreeNode* CSTL_tree_prev(CSTL_TreeNode* node) {
+    if (node->is_nil) {
+        return node->right;
+    }
+
+    if (!node->left->is_nil) {
+        return CSTL_tree_max(node->left);
+    }
+
+    CSTL_TreeNode* parent;
+
+    while (!(parent = node->parent)->is_nil && node == parent->left) {
+        node = parent;
+    }
+
+    // The predecessor of the smallest element stays put, as in MSVC.
+    return node->is_nil ? node : parent;
+}
+
+// Promotes the right child of `where` to the root of its subtree, like `std::_Tree_val::_Lrotate`.
+static void CSTL_tree_rotate_left(CSTL_TreeNode* head, CSTL_TreeNode* where) {
+    CSTL_TreeNode* node = where->right;
+    where->right        = node->left;
+
+    if (!node->left->is_nil) {
+        node->left->parent = where;
+    }
+
+    node->parent = where->parent;
+
+    if (where == head->parent) {
+        head->parent = node;
+    } else if (where == where->parent->left) {
+        where->parent->left = node;
+    } else {
+        where->parent->right = node;
+    }
+
+    node->left    = where;
+    where->parent = node;
+}
+
+// Promotes the left child of `where` to the root of its subtree, like `std::_Tree_val::_Rrotate`.
+static void CSTL_tree_rotate_right(CSTL_TreeNode* head, CSTL_TreeNode* where) {
+    CSTL_TreeNode* node = where->left;
+    where->left         = node->right;
+
+    if (!node->right->is_nil) {
+        node->right->parent = where;
+    }
+
+    node->parent = where->parent;
+
+    if (where == head->parent) {
+        head->parent = node;
+    } else if (where == where->parent->right) {
+        where->parent->right = node;
+    } else {
+        where->parent->left = node;
+    }
+
+    node->right   = where;
+    where->parent = node;
+}
+
+// Links `new_node` at `loc` and rebalances, like `std::_Tree_val::_Insert_node`.
+static void CSTL_tree_link_node(CSTL_TreeRef instance, CSTL_TreeLoc loc, CSTL_TreeNode* new_node) {
+    CSTL_TreeNode* head = instance->head;
+
+    instance->size  += 1;
+    new_node->parent = loc.parent;
+
+    if (loc.parent == head) {
+        head->left      = new_node;
+        head->parent    = new_node;
+        head->right     = new_node;
+        new_node->color = CSTL_tree_black;
+        return;
+    }
+
+    if (loc.is_right) {
+        loc.parent->right = new_node;
+
+        if (loc.parent == head->right) {
+            head->right = new_node;
+        }
+    } else {
+        loc.parent->left = new_node;
+
+        if (loc.parent == head->left) {
+            head->left = new_node;
+        }
+    }
+
+    CSTL_TreeNode* node = new_node;
+
+    while (node->parent->color == CSTL_tree_red) {
+        CSTL_TreeNode* parent      = node->parent;
+        CSTL_TreeNode* grandparent = parent->parent;
+
+        if (parent == grandparent->left) {
+            CSTL_TreeNode* uncle = grandparent->right;
+
+            if (uncle->color == CSTL_tree_red) {
+                parent->color      = CSTL_tree_black;
+                uncle->color       = CSTL_tree_black;
+                grandparent->color = CSTL_tree_red;
+                node               = grandparent;
+                continue;
+            }
+
+            if (node == parent->right) {
+                node = parent;
+                CSTL_tree_rotate_left(head, node);
+            }
+
+            node->parent->color         = CSTL_tree_black;
+            node->parent->parent->color = CSTL_tree_red;
+            CSTL_tree_rotate_right(head, node->parent->parent);
+        } else {
+            CSTL_TreeNode* uncle = grandparent->left;
+
+            if (uncle->color == CSTL_tree_red) {
+                parent->color      = CSTL_tree_black;
+                uncle->color       = CSTL_tree_black;
+                grandparent->color = CSTL_tree_red;
+                node               = grandparent;
+                continue;
+            }
+
+            if (node == parent->left) {
+                node = parent;
+                CSTL_tree_rotate_right(head, node);
+            }
+
+            node->parent->color         = CSTL_tree_black;
+            node->parent->parent->color = CSTL_tree_red;
+            CSTL_tree_rotate_left(head, node->parent->parent);
+        }
+    }
+
+    head->parent->color = CSTL_tree_black;
+}
+
+// Unlinks `erased` and rebalances, like `std::_Tree_val::_Extract`.
+static void CSTL_tree_unlink_node(CSTL_TreeRef instance, CSTL_TreeNode* erased) {
+    CSTL_TreeNode* head = instance->head;
+    CSTL_TreeNode* node = erased;
+    CSTL_TreeNode* fix_node;
+    CSTL_TreeNode* fix_parent;
+
+    if (node->left->is_nil) {
+        fix_node = node->right;
+    } else if (node->right->is_nil) {
+        fix_node = node->left;
+    } else {
+        // Two subtrees, replace `erased` with its successor.
+        node     = CSTL_tree_min(erased->right);
+        fix_node = node->right;
+    }
+
+    if (node == erased) {
+        fix_parent = erased->parent;
+
+        if (!fix_node->is_nil) {
+            fix_node->parent = fix_parent;
+        }
+
+        if (head->parent == erased) {
+            head->parent = fix_node;
+        } else if (fix_parent->left == erased) {
+            fix_parent->left = fix_node;
+        } else {
+            fix_parent->right = fix_node;
+        }
+
+        if (head->left == erased) {
+            head->left = fix_node->is_nil ? fix_parent : CSTL_tree_min(fix_node);
+        }
+
+        if (head->right == erased) {
+            head->right = fix_node->is_nil ? fix_parent : CSTL_tree_max(fix_node);
+        }
+    } else {
+        erased->left->parent = node;
+        node->left           = erased->left;
+
+        if (node == erased->right) {
+            fix_parent = node;
+        } else {
+            fix_parent = node->parent;
+
+            if (!fix_node->is_nil) {
+                fix_node->parent = fix_parent;
+            }
+
+            fix_parent->left      = fix_node;
+            node->right           = erased->right;
+            erased->right->parent = node;
+        }
+
+        if (head->parent == erased) {
+            head->parent = node;
+        } else if (erased->parent->left == erased) {
+            erased->parent->left = node;
+        } else {
+            erased->parent->right = node;
+        }
+
+        node->parent = erased->parent;
+
+        char color    = node->color;
+        node->color   = erased->color;
+        erased->color = color;
+    }
+
+    if (erased->color == CSTL_tree_black) {
+        for (; fix_node != head->parent && fix_node->color == CSTL_tree_black; fix_parent = fix_node->parent) {
+            if (fix_node == fix_parent->left) {
+                node = fix_parent->right;
+
+                if (node->color == CSTL_tree_red) {
+                    node->color       = CSTL_tree_black;
+                    fix_parent->color = CSTL_tree_red;
+                    CSTL_tree_rotate_left(head, fix_parent);
+                    node = fix_parent->right;
+                }
+
+                if (node->is_nil) {
+                    fix_node = fix_parent;
+                } else if (node->left->color == CSTL_tree_black && node->right->color == CSTL_tree_black) {
+                    node->color = CSTL_tree_red;
+                    fix_node    = fix_parent;
+                } else {
+                    if (node->right->color == CSTL_tree_black) {
+                        node->left->color = CSTL_tree_black;
+                        node->color       = CSTL_tree_red;
+                        CSTL_tree_rotate_right(head, node);
+                        node = fix_parent->right;
+                    }
+
+                    node->color        = fix_parent->color;
+                    fix_parent->color  = CSTL_tree_black;
+                    node->right->color = CSTL_tree_black;
+                    CSTL_tree_rotate_left(head, fix_parent);
+                    break;
+                }
+            } else {
+                node = fix_parent->left;
+
+                if (node->color == CSTL_tree_red) {
+                    node->color       = CSTL_tree_black;
+                    fix_parent->color = CSTL_tree_red;
+                    CSTL_tree_rotate_right(head, fix_parent);
+                    node = fix_parent->left;
+                }
+
+                if (node->is_nil) {
+                    fix_node = fix_parent;
+                } else if (node->right->color == CSTL_tree_black && node->left->color == CSTL_tree_black) {
+                    node->color = CSTL_tree_red;
+                    fix_node    = fix_parent;
+                } else {
+                    if (node->left->color == CSTL_tree_black) {
+                        node->right->color = CSTL_tree_black;
+                        node->color        = CSTL_tree_red;
+                        CSTL_tree_rotate_left(head, node);
+                        node = fix_parent->left;
+                    }
+
+                    node->color       = fix_parent->color;
+                    fix_parent->color = CSTL_tree_black;
+                    node->left->color = CSTL_tree_black;
+                    CSTL_tree_rotate_right(head, fix_parent);
+                    break;
+                }
+            }
+        }
+
+        fix_node->color = CSTL_tree_black;
+    }
+
+    instance->size -= 1;
+}
+
+// Finds the first node not less than `key` and where a node for `key` would be linked,
+// like `std::_Tree::_Find_lower_bound`. `*bound` is the head if there is no such node.
+static inline CSTL_TreeLoc CSTL_tree_find_lower_bound(CSTL_TreeCRef instance, size_t offset, CSTL_CompTypeCRef comp, const void* key, CSTL_TreeNode** bound) {
+    CSTL_TreeNode* head = instance->head;
+    CSTL_TreeNode* node = head->parent;
+    CSTL_TreeLoc loc    = { node, true };
+
+    *bound = head;
+
+    while (!node->is_nil) {
+        loc.parent = node;
+
+        if (comp->is_lt(CSTL_tree_value(node, offset), key)) {
+            loc.is_right = true;
+            node         = node->right;
+        } else {
+            loc.is_right = false;
+            *bound       = node;
+            node         = node->left;
+        }
+    }
+
+    return loc;
+}
+
+static inline CSTL_TreeNode* CSTL_tree_find_upper_bound(CSTL_TreeCRef instance, size_t offset, CSTL_CompTypeCRef comp, const void* key) {
+    CSTL_TreeNode* head  = instance->head;
+    CSTL_TreeNode* node  = head->parent;
+    CSTL_TreeNode* bound = head;
+
+    while (!node->is_nil) {
+        if (comp->is_lt(key, CSTL_tree_value(node, offset))) {
+            bound = node;
+            node  = node->left;
+        } else {
+            node = node->right;
+        }
+    }
+
+    return bound;
+}
+
+// `bound` is a lower bound of `key`, returns `true` if its key is equivalent to `key`.
+static inline bool CSTL_tree_is_duplicate(CSTL_TreeNode* bound, size_t offset, CSTL_CompTypeCRef comp, const void* key) {
+    return !bound->is_nil && !comp->is_lt(key, CSTL_tree_value(bound, offset));
+}
+
+// Finds where to link `key` without a duplicate. Returns the node with an equivalent key,
+// or `NULL` and sets `*loc`.
+static CSTL_TreeNode* CSTL_tree_find_insert(CSTL_TreeCRef instance, size_t offset, CSTL_CompTypeCRef comp, const void* key, CSTL_TreeLoc* loc) {
+    CSTL_TreeNode* bound = NULL;
+
+    *loc = CSTL_tree_find_lower_bound(instance, offset, comp, key, &bound);
+
+    return CSTL_tree_is_duplicate(bound, offset, comp, key) ? bound : NULL;
+}
+
+// Same as `CSTL_tree_find_insert`, but checks the neighbours of `hint` first,
+// like `std::_Tree::_Find_hint`.
+static CSTL_TreeNode* CSTL_tree_find_hint(CSTL_TreeCRef instance, size_t offset, CSTL_CompTypeCRef comp, CSTL_TreeNode* hint, const void* key, CSTL_TreeLoc* loc) {
+    CSTL_TreeNode* head = instance->head;
+
+    if (hint->is_nil) {
+        // Insert at the end if after the last element, avoid comparing with the head if empty.
+        if (head->parent->is_nil || comp->is_lt(CSTL_tree_value(head->right, offset), key)) {
+            loc->parent   = head->right;
+            loc->is_right = true;
+            return NULL;
+        }
+    } else if (hint == head->left) {
+        // Insert at the beginning if before the first element.
+        if (comp->is_lt(key, CSTL_tree_value(hint, offset))) {
+            loc->parent   = hint;
+            loc->is_right = false;
+            return NULL;
+        }
+    } else if (comp->is_lt(key, CSTL_tree_value(hint, offset))) {
+        CSTL_TreeNode* prev = CSTL_tree_prev(hint);
+
+        if (comp->is_lt(CSTL_tree_value(prev, offset), key)) {
+            if (prev->right->is_nil) {
+                loc->parent   = prev;
+                loc->is_right = true;
+            } else {
+                loc->parent   = hint;
+                loc->is_right = false;
+            }
+
+            return NULL;
+        }
+    } else if (comp->is_lt(CSTL_tree_value(hint, offset), key)) {
+        CSTL_TreeNode* next = CSTL_tree_next(hint);
+
+        if (next->is_nil || comp->is_lt(key, CSTL_tree_value(next, offset))) {
+            if (hint->right->is_nil) {
+                loc->parent   = hint;
+                loc->is_right = true;
+            } else {
+                loc->parent   = next;
+                loc->is_right = false;
+            }
+
+            return NULL;
+        }
+    } else {
+        return hint;
+    }
+
+    return CSTL_tree_find_insert(instance, offset, comp, key, loc);
+}
+
+// Erases the subtree at `node` without rebalancing, like `std::_Tree_val::_Erase_tree`.
+static void CSTL_tree_erase_tree(CSTL_TreeNode* node, CSTL_Type type, CSTL_DropTypeCRef drop, CSTL_Alloc* alloc) {
+    size_t offset    = CSTL_tree_value_offset(type);
+    size_t type_size = CSTL_type_size(type);
+
+    while (!node->is_nil) {
+        CSTL_tree_erase_tree(node->right, type, drop, alloc);
+
+        CSTL_TreeNode* left = node->left;
+        char* value         = CSTL_tree_value(node, offset);
+
+        CSTL_type_drop(drop, value, value + type_size);
+        CSTL_tree_free_node(node, type, alloc);
+
+        node = left;
+    }
+}
+
+// State of `CSTL_tree_build`: the next element to copy and what is needed to copy it.
+typedef struct CSTL_TreeBuild {
+    CSTL_TreeNode* head;
+    const char* value;
+    const char* last;
+    size_t offset;
+    size_t type_size;
+    size_t red_depth;
+    CSTL_Type type;
+    CSTL_CompTypeCRef comp;
+    CSTL_CopyTypeCRef copy;
+    CSTL_Alloc* alloc;
+} CSTL_TreeBuild;
+
+// Builds a subtree of `count` nodes in order, splitting at the middle, so that nodes
+// are allocated and filled in a single ascending pass. Every path has the same number
+// of black nodes if the nodes of the incomplete bottom level at `red_depth` are red
+// and all others black. Returns `NULL` if an allocation fails, freeing the subtree.
+static CSTL_TreeNode* CSTL_tree_build(CSTL_TreeBuild* build, size_t count, size_t depth, CSTL_TreeNode* parent) {
+    if (count == 0) {
+        return build->head;
+    }
+
+    size_t left_count = (count - 1) / 2;
+
+    CSTL_TreeNode* left = CSTL_tree_build(build, left_count, depth + 1, NULL);
+
+    if (left == NULL) {
+        return NULL;
+    }
+
+    CSTL_TreeNode* node = CSTL_tree_new_node(build->head, build->type, build->alloc);
+
+    if (node == NULL) {
+        CSTL_tree_erase_tree(left, build->type, &build->copy->move_type.drop_type, build->alloc);
+        return NULL;
+    }
+
+    node->left   = left;
+    node->parent = parent;
+    node->color  = depth == build->red_depth ? CSTL_tree_red : CSTL_tree_black;
+
+    if (!left->is_nil) {
+        left->parent = node;
+    }
+
+    CSTL_type_copy(build->copy, build->value, build->value + build->type_size, CSTL_tree_value(node, build->offset));
+
+    // Skip the elements equivalent to the copied one.
+    const char* next = build->value + build->type_size;
+
+    while (next != build->last && !build->comp->is_lt(build->value, next)) {
+        next += build->type_size;
+    }
+
+    build->value = next;
+
+    CSTL_TreeNode* right = CSTL_tree_build(build, count - 1 - left_count, depth + 1, node);
+
+    if (right == NULL) {
+        CSTL_tree_erase_tree(node, build->type, &build->copy->move_type.drop_type, build->alloc);
+        return NULL;
+    }
+
+    node->right = right;
+
+    return node;
+}
+
+// Builds the tree from sorted `[first, last)` holding `count` distinct keys.
+static bool CSTL_tree_build_sorted(CSTL_TreeRef instance, CSTL_Type type, CSTL_CompTypeCRef comp, CSTL_CopyTypeCRef copy, const char* first, const char* last, size_t count, CSTL_Alloc* alloc) {
+    CSTL_TreeNode* head = instance->head;
+
+    size_t depth = 0;
+
+    while ((count >> depth) > 1) {
+        depth += 1;
+    }
+
+    CSTL_TreeBuild build = {
+        head, first, last, CSTL_tree_value_offset(type), CSTL_type_size(type),
+        depth == 0 ? SIZE_MAX : depth, type, comp, copy, alloc,
+    };
+
+    CSTL_TreeNode* root = CSTL_tree_build(&build, count, 0, head);
+
+    if (root == NULL) {
+        return false;
+    }
+
+    head->parent   = root;
+    head->left     = CSTL_tree_min(root);
+    head->right    = CSTL_tree_max(root);
+    instance->size = count;
+
+    return true;
+}
+
+bool CSTL_tree_construct(CSTL_TreeVal* new_instance, CSTL_Type type, CSTL_Alloc* alloc) {
+    CSTL_TreeNode* head = CSTL_allocate(CSTL_tree_node_size(type), CSTL_tree_node_alignment(type), alloc);
+
+    new_instance->head = head;
+    new_instance->size = 0;
+
+    if (head == NULL) {
+        return false;
+    }
+
+    head->left   = head;
+    head->parent = head;
+    head->right  = head;
+    head->color  = CSTL_tree_black;
+    head->is_nil = 1;
+
+    return true;
+}
+
+void CSTL_tree_destroy(CSTL_TreeRef instance, CSTL_Type type, CSTL_DropTypeCRef drop, CSTL_Alloc* alloc) {
+    if (instance->head == NULL) {
+        return;
+    }
+
+    CSTL_tree_clear(instance, type, drop, alloc);
+    CSTL_tree_free_node(instance->head, type, alloc);
+
+    instance->head = NULL;
+}
+
+void CSTL_tree_clear(CSTL_TreeRef instance, CSTL_Type type, CSTL_DropTypeCRef drop, CSTL_Alloc* alloc) {
+    CSTL_TreeNode* head = instance->head;
+
+    CSTL_tree_erase_tree(head->parent, type, drop, alloc);
+
+    head->left     = head;
+    head->parent   = head;
+    head->right    = head;
+    instance->size = 0;
+}
+
+void CSTL_tree_swap(CSTL_TreeRef instance, CSTL_TreeRef other_instance) {
+    CSTL_TreeVal tmp = *instance;
+    *instance        = *other_instance;
+    *other_instance  = tmp;
+}
+
+bool CSTL_tree_empty(CSTL_TreeCRef instance) {
+    return instance->size == 0;
+}
+
+size_t CSTL_tree_size(CSTL_TreeCRef instance) {
+    return instance->size;
+}
+
+CSTL_TreeIter CSTL_tree_begin(CSTL_TreeCRef instance, CSTL_Type type) {
+    return CSTL_tree_make_iter(instance->head->left, CSTL_tree_value_offset(type));
+}
+
+CSTL_TreeIter CSTL_tree_end(CSTL_TreeCRef instance, CSTL_Type type) {
+    return CSTL_tree_make_iter(instance->head, CSTL_tree_value_offset(type));
+}
+
+CSTL_TreeIter CSTL_tree_iterator_next(CSTL_TreeIter iterator) {
+    iterator.node = CSTL_tree_next(iterator.node);
+    return iterator;
+}
+
+CSTL_TreeIter CSTL_tree_iterator_prev(CSTL_TreeIter iterator) {
+    iterator.node = CSTL_tree_prev(iterator.node);
+    return iterator;
+}
+
+void* CSTL_tree_iterator_deref(CSTL_TreeIter iterator) {
+    return CSTL_tree_value(iterator.node, iterator.offset);
+}
+
+bool CSTL_tree_iterator_eq(CSTL_TreeIter lhs, CSTL_TreeIter rhs) {
+    return lhs.node == rhs.node;
+}
+
+CSTL_TreeIter CSTL_tree_find(CSTL_TreeCRef instance, CSTL_Type type, CSTL_CompTypeCRef comp, const void* key) {
+    size_t offset        = CSTL_tree_value_offset(type);
+    CSTL_TreeNode* bound = NULL;
+
+    CSTL_tree_find_lower_bound(instance, offset, comp, key, &bound);
+
+    if (!CSTL_tree_is_duplicate(bound, offset, comp, key)) {
+        bound = instance->head;
+    }
+
+    return CSTL_tree_make_iter(bound, offset);
+}
+
+bool CSTL_tree_contains(CSTL_TreeCRef instance, CSTL_Type type, CSTL_CompTypeCRef comp, const void* key) {
+    return CSTL_tree_find(instance, type, comp, key).node != instance->head;
+}
+
+CSTL_TreeIter CSTL_tree_lower_bound(CSTL_TreeCRef instance, CSTL_Type type, CSTL_CompTypeCRef comp, const void* key) {
+    size_t offset        = CSTL_tree_value_offset(type);
+    CSTL_TreeNode* bound = NULL;
+
+    CSTL_tree_find_lower_bound(instance, offset, comp, key, &bound);
+
+    return CSTL_tree_make_iter(bound, offset);
+}
+
+CSTL_TreeIter CSTL_tree_upper_bound(CSTL_TreeCRef instance, CSTL_Type type, CSTL_CompTypeCRef comp, const void* key) {
+    size_t offset = CSTL_tree_value_offset(type);
+    return CSTL_tree_make_iter(CSTL_tree_find_upper_bound(instance, offset, comp, key), offset);
+}
+
+CSTL_TreeRange CSTL_tree_equal_range(CSTL_TreeCRef instance, CSTL_Type type, CSTL_CompTypeCRef comp, const void* key) {
+    size_t offset = CSTL_tree_value_offset(type);
+
+    CSTL_TreeNode* lower = NULL;
+    CSTL_TreeNode* upper = NULL;
+
+    CSTL_tree_find_lower_bound(instance, offset, comp, key, &lower);
+
+    // Keys are unique, so the upper bound is at most one element past the lower bound.
+    upper = CSTL_tree_is_duplicate(lower, offset, comp, key) ? CSTL_tree_next(lower) : lower;
+
+    CSTL_TreeRange range = { CSTL_tree_make_iter(lower, offset), CSTL_tree_make_iter(upper, offset) };
+    return range;
+}
+
+CSTL_TreeIter CSTL_tree_copy_insert(CSTL_TreeRef instance, CSTL_Type type, CSTL_CompTypeCRef comp, CSTL_CopyTypeCRef copy, const void* value, bool* inserted, CSTL_Alloc* alloc) {
+    return CSTL_tree_copy_insert_hint(instance, type, comp, copy, CSTL_tree_make_iter(NULL, 0), value, inserted, alloc);
+}
+
+CSTL_TreeIter CSTL_tree_move_insert(CSTL_TreeRef instance, CSTL_Type type, CSTL_CompTypeCRef comp, CSTL_MoveTypeCRef move, void* value, bool* inserted, CSTL_Alloc* alloc) {
+    return CSTL_tree_move_insert_hint(instance, type, comp, move, CSTL_tree_make_iter(NULL, 0), value, inserted, alloc);
+}
+
+// Finds `value` with `hint`, or without one if `hint.node` is `NULL`, or prepares an unlinked node for it.
+// Returns the existing node, a new node with uninitialized storage (setting `*loc`), or `NULL` on failure.
+static CSTL_TreeNode* CSTL_tree_prepare_insert(CSTL_TreeRef instance, CSTL_Type type, CSTL_CompTypeCRef comp, CSTL_TreeIter hint, const void* value, CSTL_TreeLoc* loc, bool* is_new, CSTL_Alloc* alloc) {
+    size_t offset = CSTL_tree_value_offset(type);
+
+    *is_new = false;
+
+    CSTL_TreeNode* found = hint.node == NULL ? CSTL_tree_find_insert(instance, offset, comp, value, loc)
+                                             : CSTL_tree_find_hint(instance, offset, comp, hint.node, value, loc);
+
+    if (found != NULL) {
+        return found;
+    }
+
+    CSTL_TreeNode* new_node = CSTL_tree_new_node(instance->head, type, alloc);
+
+    *is_new = new_node != NULL;
+
+    return new_node;
+}
+
+CSTL_TreeIter CSTL_tree_copy_insert_hint(CSTL_TreeRef instance, CSTL_Type type, CSTL_CompTypeCRef comp, CSTL_CopyTypeCRef copy, CSTL_TreeIter hint, const void* value, bool* inserted, CSTL_Alloc* alloc) {
+    size_t offset    = CSTL_tree_value_offset(type);
+    CSTL_TreeLoc loc = { NULL, false };
+    bool is_new      = false;
+
+    CSTL_TreeNode* node = CSTL_tree_prepare_insert(instance, type, comp, hint, value, &loc, &is_new, alloc);
+
+    if (inserted != NULL) {
+        *inserted = is_new;
+    }
+
+    if (node == NULL) {
+        return CSTL_tree_end(instance, type);
+    }
+
+    if (is_new) {
+        CSTL_type_copy(copy, value, (const char*)value + CSTL_type_size(type), CSTL_tree_value(node, offset));
+        CSTL_tree_link_node(instance, loc, node);
+    }
+
+    return CSTL_tree_make_iter(node, offset);
+}
+
+CSTL_TreeIter CSTL_tree_move_insert_hint(CSTL_TreeRef instance, CSTL_Type type, CSTL_CompTypeCRef comp, CSTL_MoveTypeCRef move, CSTL_TreeIter hint, void* value, bool* inserted, CSTL_Alloc* alloc) {
+    size_t offset    = CSTL_tree_value_offset(type);
+    CSTL_TreeLoc loc = { NULL, false };
+    bool is_new      = false;
+
+    CSTL_TreeNode* node = CSTL_tree_prepare_insert(instance, type, comp, hint, value, &loc, &is_new, alloc);
+
+    if (inserted != NULL) {
+        *inserted = is_new;
+    }
+
+    if (node == NULL) {
+        return CSTL_tree_end(instance, type);
+    }
+
+    if (is_new) {
+        CSTL_type_move(move, value, (char*)value + CSTL_type_size(type), CSTL_tree_value(node, offset));
+        CSTL_tree_link_node(instance, loc, node);
+    }
+
+    return CSTL_tree_make_iter(node, offset);
+}
+
+bool CSTL_tree_copy_insert_range(CSTL_TreeRef instance, CSTL_Type type, CSTL_CompTypeCRef comp, CSTL_CopyTypeCRef copy, const void* first, const void* last, CSTL_Alloc* alloc) {
+    const char* it  = first;
+    const char* end = last;
+
+    size_t type_size = CSTL_type_size(type);
+
+    if (it == end) {
+        return true;
+    }
+
+    bool was_empty = instance->size == 0;
+
+    if (was_empty) {
+        // Count the distinct keys while checking that the range is sorted.
+        size_t count = 1;
+        bool sorted  = true;
+
+        for (const char* prev = it, *next = it + type_size; next != end; prev = next, next += type_size) {
+            if (comp->is_lt(prev, next)) {
+                count += 1;
+            } else if (comp->is_lt(next, prev)) {
+                sorted = false;
+                break;
+            }
+        }
+
+        if (sorted) {
+            return CSTL_tree_build_sorted(instance, type, comp, copy, it, end, count, alloc);
+        }
+    }
+
+    // Hint at the end like `std::_Tree::_Insert_range_unchecked`, which is
+    // constant time for every element past the current largest one.
+    CSTL_TreeIter hint = CSTL_tree_end(instance, type);
+
+    for (; it != end; it += type_size) {
+        bool inserted       = false;
+        CSTL_TreeIter where = CSTL_tree_copy_insert_hint(instance, type, comp, copy, hint, it, &inserted, alloc);
+
+        if (!inserted && where.node == instance->head) {
+            if (was_empty) {
+                CSTL_tree_clear(instance, type, &copy->move_type.drop_type, alloc);
+            }
+
+            return false;
+        }
+    }
+
+    return true;
+}
+
+CSTL_TreeIter CSTL_tree_erase(CSTL_TreeRef instance, CSTL_Type type, CSTL_DropTypeCRef drop, CSTL_TreeIter where, CSTL_Alloc* alloc) {
+    CSTL_TreeNode* node = where.node;
+
+    assert(!node->is_nil);
+
+    CSTL_TreeNode* next = CSTL_tree_next(node);
+    char* value         = CSTL_tree_value(node, where.offset);
+
+    CSTL_tree_unlink_node(instance, node);
+
+    CSTL_type_drop(drop, value, value + CSTL_type_size(type));
+    CSTL_tree_free_node(node, type, alloc);
+
+    return CSTL_tree_make_iter(next, where.offset);
+}
+
+size_t CSTL_tree_erase_key(CSTL_TreeRef instance, CSTL_Type type, CSTL_CompTypeCRef comp, CSTL_DropTypeCRef drop, const void* key, CSTL_Alloc* alloc) {
+    CSTL_TreeIter where = CSTL_tree_find(instance, type, comp, key);
+
+    if (where.node == instance->head) {
+        return 0;
+    }
+
+    CSTL_tree_erase(instance, type, drop, where, alloc);
+
+    return 1;
+}
@@ -0,0 +1,284 @@
+#pragma once
+
+#ifndef CSTL_XTREE_H
+#define CSTL_XTREE_H
+
+#include "alloc.h"
+#include "type.h"
+
+#if defined(__cplusplus)
+#include <cstddef>
+extern "C" {
+#else
+#include <stdbool.h>
+#include <stddef.h>
+#endif
+
+/**
+ * STL ABI red-black tree node header, followed by the element.
+ * 
+ * The element starts right after `is_nil`, rounded up to its alignment,
+ * which may be before the end of this structure.
+ * 
+ */
+typedef struct CSTL_TreeNode {
+    struct CSTL_TreeNode* left;
+    struct CSTL_TreeNode* parent;
+    struct CSTL_TreeNode* right;
+    char color;  // 0 for red, 1 for black
+    char is_nil; // 1 only for the head node
+} CSTL_TreeNode;
+
+/**
+ * STL ABI `std::_Tree` layout, the common base of `std::map` and `std::set`.
+ * 
+ * The head node doubles as the nil node of the tree: every missing child
+ * points to it. Its `left` is the smallest element, `parent` the root and
+ * `right` the largest element, or the head itself if the tree is empty.
+ * 
+ * The key of an element must be stored at its start, as it is in a set or
+ * in the `std::pair<const Key, T>` of a map. The functions of a `CSTL_CompType`
+ * are called with pointers to keys or elements interchangeably, and only
+ * `is_lt` is used.
+ * 
+ * Only stateless comparators are supported.
+ * 
+ * Does not include the allocator, which nonetheless is a part of the `std::_Tree`
+ * structure! You are responsible for including it, since it can take on any form.
+ * 
+ * Do not manipulate the members directly, use the associated functions!
+ * 
+ */
+typedef struct CSTL_TreeVal {
+    CSTL_TreeNode* head;
+    size_t size;
+} CSTL_TreeVal;
+
+/**
+ * Reference to a mutable `CSTL_TreeVal`.
+ * 
+ * Must not be null.
+ * 
+ */
+typedef CSTL_TreeVal* CSTL_TreeRef;
+
+/**
+ * Reference to a const `CSTL_TreeVal`.
+ * 
+ * Must not be null.
+ * 
+ */
+typedef const CSTL_TreeVal* CSTL_TreeCRef;
+
+/**
+ * A bidirectional iterator over elements of a tree, in ascending order.
+ * 
+ * Not ABI-compatible with `std::map::iterator`.
+ * 
+ */
+typedef struct CSTL_TreeIter {
+    CSTL_TreeNode* node;
+    size_t offset;
+} CSTL_TreeIter;
+
+/**
+ * The range of elements `[first, last)`.
+ * 
+ */
+typedef struct CSTL_TreeRange {
+    CSTL_TreeIter first;
+    CSTL_TreeIter last;
+} CSTL_TreeRange;
+
+/**
+ * Initializes the tree pointed to by `new_instance` as empty.
+ * 
+ * Like its C++ counterpart, an empty tree owns a head node, which must be
+ * freed with `CSTL_tree_destroy`. Returns `false` if the allocation fails,
+ * in which case nothing needs to be freed.
+ * 
+ */
+bool CSTL_tree_construct(CSTL_TreeVal* new_instance, CSTL_Type type, CSTL_Alloc* alloc);
+
+/**
+ * Destroys the tree pointed to by `instance`, destroying elements
+ * and freeing all nodes.
+ * 
+ */
+void CSTL_tree_destroy(CSTL_TreeRef instance, CSTL_Type type, CSTL_DropTypeCRef drop, CSTL_Alloc* alloc);
+
+/**
+ * Destroys all elements.
+ * 
+ */
+void CSTL_tree_clear(CSTL_TreeRef instance, CSTL_Type type, CSTL_DropTypeCRef drop, CSTL_Alloc* alloc);
+
+/**
+ * Swaps the contents of two trees.
+ * 
+ * You are responsible for swapping the allocators outside of `CSTL_TreeVal` if applicable.
+ * 
+ */
+void CSTL_tree_swap(CSTL_TreeRef instance, CSTL_TreeRef other_instance);
+
+/**
+ * Returns `true` if the tree is empty.
+ * 
+ */
+bool CSTL_tree_empty(CSTL_TreeCRef instance);
+
+/**
+ * Returns the number of elements in the tree.
+ * 
+ */
+size_t CSTL_tree_size(CSTL_TreeCRef instance);
+
+/**
+ * Returns an iterator to the smallest element.
+ * 
+ */
+CSTL_TreeIter CSTL_tree_begin(CSTL_TreeCRef instance, CSTL_Type type);
+
+/**
+ * Returns an iterator past the largest element.
+ * 
+ */
+CSTL_TreeIter CSTL_tree_end(CSTL_TreeCRef instance, CSTL_Type type);
+
+/**
+ * Advances the iterator to the next larger element, or the end iterator.
+ * 
+ */
+CSTL_TreeIter CSTL_tree_iterator_next(CSTL_TreeIter iterator);
+
+/**
+ * Moves the iterator to the next smaller element.
+ * 
+ * The end iterator moves to the largest element.
+ * 
+ */
+CSTL_TreeIter CSTL_tree_iterator_prev(CSTL_TreeIter iterator);
+
+/**
+ * Dereferences the iterator at the element it's pointing to.
+ * 
+ * Returns a pointer to the element.
+ * 
+ * `iterator` must be dereferenceable. The key of the element must not be mutated.
+ * 
+ */
+void* CSTL_tree_iterator_deref(CSTL_TreeIter iterator);
+
+/**
+ * Returns `true` if both iterators point to the same element.
+ * 
+ */
+bool CSTL_tree_iterator_eq(CSTL_TreeIter lhs, CSTL_TreeIter rhs);
+
+/**
+ * Finds the element with a key equivalent to `key`.
+ * 
+ * Returns an iterator to the element, or the end iterator if there is none.
+ * 
+ */
+CSTL_TreeIter CSTL_tree_find(CSTL_TreeCRef instance, CSTL_Type type, CSTL_CompTypeCRef comp, const void* key);
+
+/**
+ * Returns `true` if an element with a key equivalent to `key` exists.
+ * 
+ */
+bool CSTL_tree_contains(CSTL_TreeCRef instance, CSTL_Type type, CSTL_CompTypeCRef comp, const void* key);
+
+/**
+ * Returns an iterator to the first element with a key not less than `key`.
+ * 
+ */
+CSTL_TreeIter CSTL_tree_lower_bound(CSTL_TreeCRef instance, CSTL_Type type, CSTL_CompTypeCRef comp, const void* key);
+
+/**
+ * Returns an iterator to the first element with a key greater than `key`.
+ * 
+ */
+CSTL_TreeIter CSTL_tree_upper_bound(CSTL_TreeCRef instance, CSTL_Type type, CSTL_CompTypeCRef comp, const void* key);
+
+/**
+ * Returns the range of elements with a key equivalent to `key`,
+ * from its lower bound to its upper bound.
+ * 
+ */
+CSTL_TreeRange CSTL_tree_equal_range(CSTL_TreeCRef instance, CSTL_Type type, CSTL_CompTypeCRef comp, const void* key);
+
+/**
+ * Inserts a copy of `value` if no element with an equivalent key exists.
+ * 
+ * Returns an iterator to the inserted element, or to the element with an equivalent key.
+ * If `inserted` is not `NULL`, it is set to whether `value` was inserted.
+ * 
+ * If the allocation fails, the tree is unchanged and the end iterator is returned.
+ * 
+ */
+CSTL_TreeIter CSTL_tree_copy_insert(CSTL_TreeRef instance, CSTL_Type type, CSTL_CompTypeCRef comp, CSTL_CopyTypeCRef copy, const void* value, bool* inserted, CSTL_Alloc* alloc);
+
+/**
+ * Inserts `value` by moving it if no element with an equivalent key exists.
+ * 
+ * Otherwise the same as `CSTL_tree_copy_insert`.
+ * 
+ */
+CSTL_TreeIter CSTL_tree_move_insert(CSTL_TreeRef instance, CSTL_Type type, CSTL_CompTypeCRef comp, CSTL_MoveTypeCRef move, void* value, bool* inserted, CSTL_Alloc* alloc);
+
+/**
+ * Inserts a copy of `value` as close as possible to just before `hint`.
+ * 
+ * Takes amortized constant time instead of logarithmic if `value` belongs
+ * right before `hint`, such as when inserting ascending keys at the end.
+ * 
+ * Otherwise the same as `CSTL_tree_copy_insert`.
+ * 
+ */
+CSTL_TreeIter CSTL_tree_copy_insert_hint(CSTL_TreeRef instance, CSTL_Type type, CSTL_CompTypeCRef comp, CSTL_CopyTypeCRef copy, CSTL_TreeIter hint, const void* value, bool* inserted, CSTL_Alloc* alloc);
+
+/**
+ * Inserts `value` by moving it as close as possible to just before `hint`.
+ * 
+ * Otherwise the same as `CSTL_tree_copy_insert_hint`.
+ * 
+ */
+CSTL_TreeIter CSTL_tree_move_insert_hint(CSTL_TreeRef instance, CSTL_Type type, CSTL_CompTypeCRef comp, CSTL_MoveTypeCRef move, CSTL_TreeIter hint, void* value, bool* inserted, CSTL_Alloc* alloc);
+
+/**
+ * Inserts copies of the elements in the range `[first, last)`, skipping
+ * those with a key equivalent to an existing or earlier element.
+ * 
+ * If the tree is empty and the range is sorted in ascending order, the tree
+ * is built in linear time without any rebalancing. Otherwise the elements are
+ * inserted one by one with the end as a hint, which takes constant time for
+ * each element greater than all before it.
+ * 
+ * Returns `false` if an allocation fails. An empty tree is then left empty,
+ * otherwise the elements inserted before the failure remain.
+ * 
+ */
+bool CSTL_tree_copy_insert_range(CSTL_TreeRef instance, CSTL_Type type, CSTL_CompTypeCRef comp, CSTL_CopyTypeCRef copy, const void* first, const void* last, CSTL_Alloc* alloc);
+
+/**
+ * Erases the element at `where`, which must be dereferenceable.
+ * 
+ * Returns an iterator to the element following the erased one.
+ * 
+ */
+CSTL_TreeIter CSTL_tree_erase(CSTL_TreeRef instance, CSTL_Type type, CSTL_DropTypeCRef drop, CSTL_TreeIter where, CSTL_Alloc* alloc);
+
+/**
+ * Erases the element with a key equivalent to `key`, if any.
+ * 
+ * Returns the number of erased elements.
+ * 
+ */
+size_t CSTL_tree_erase_key(CSTL_TreeRef instance, CSTL_Type type, CSTL_CompTypeCRef comp, CSTL_DropTypeCRef drop, const void* key, CSTL_Alloc* alloc);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
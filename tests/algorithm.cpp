@@ -0,0 +1,360 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "algorithm.h"
+#include "alloc.h"
+#include "type.h"
+#include "vector.h"
+
+namespace {
+
+void destroy_string(void* first, void* last) {
+    std::destroy(static_cast<std::string*>(first), static_cast<std::string*>(last));
+}
+
+void move_string(void* first, void* last, void* dest) {
+    std::uninitialized_move(static_cast<std::string*>(first), static_cast<std::string*>(last), static_cast<std::string*>(dest));
+}
+
+bool string_eq(const void* lhs, const void* rhs) {
+    return *static_cast<const std::string*>(lhs) == *static_cast<const std::string*>(rhs);
+}
+
+bool string_lt(const void* lhs, const void* rhs) {
+    return *static_cast<const std::string*>(lhs) < *static_cast<const std::string*>(rhs);
+}
+
+// A key with its original position, ordered by the key only.
+struct Keyed {
+    uint32_t key;
+    uint32_t index;
+};
+
+bool keyed_eq(const void* lhs, const void* rhs) {
+    return static_cast<const Keyed*>(lhs)->key == static_cast<const Keyed*>(rhs)->key;
+}
+
+bool keyed_lt(const void* lhs, const void* rhs) {
+    return static_cast<const Keyed*>(lhs)->key < static_cast<const Keyed*>(rhs)->key;
+}
+
+// Input shapes that trip up naive quicksorts.
+std::vector<uint32_t> make_pattern(std::mt19937_64& rng, size_t pattern, size_t size) {
+    std::vector<uint32_t> values(size);
+
+    for (size_t i = 0; i < size; ++i) {
+        switch (pattern) {
+        case 0:  values[i] = (uint32_t)rng(); break;
+        case 1:  values[i] = (uint32_t)i; break;
+        case 2:  values[i] = (uint32_t)(size - i); break;
+        case 3:  values[i] = 7; break;
+        case 4:  values[i] = (uint32_t)(i < size / 2 ? i : size - i); break;
+        default: values[i] = (uint32_t)(rng() % 4); break;
+        }
+    }
+
+    return values;
+}
+
+// Wraps `values` in a `CSTL_VectorVal` without copying, the vector must not be destroyed.
+CSTL_VectorVal borrow(void* data, size_t bytes) {
+    CSTL_VectorVal vec;
+    vec.first = data;
+    vec.last  = static_cast<char*>(data) + bytes;
+    vec.end   = vec.last;
+    return vec;
+}
+
+template <typename T>
+void radix_sort_matches(std::mt19937_64& rng, const CSTL_PodType& pod, const CSTL_CompType& comp, bool stable) {
+    for (size_t size : { 0, 1, 100, 255, 256, 1000, 20000 }) {
+        std::vector<T> real(size);
+
+        for (auto& value : real) {
+            if constexpr (std::is_floating_point_v<T>) {
+                value = (T)((double)(int64_t)rng() / 1e12);
+            } else {
+                value = (T)rng();
+            }
+        }
+
+        if constexpr (std::is_floating_point_v<T>) {
+            if (size > 3) {
+                real[0] = std::numeric_limits<T>::infinity();
+                real[1] = -std::numeric_limits<T>::infinity();
+                real[2] = (T)0;
+            }
+        }
+
+        std::vector<T> sorted = real;
+        CSTL_VectorVal vec    = borrow(sorted.data(), size * sizeof(T));
+
+        if (stable) {
+            ASSERT_TRUE(CSTL_vector_stable_sort(&vec, pod.type, &pod.copy.move_type, &comp, nullptr)) << "must return true on success";
+        } else {
+            ASSERT_TRUE(CSTL_vector_sort(&vec, pod.type, &pod.copy.move_type, &comp, nullptr)) << "must return true on success";
+        }
+
+        std::sort(real.begin(), real.end());
+
+        ASSERT_EQ(real, sorted) << "must sort like `std::sort`";
+        ASSERT_TRUE(CSTL_vector_is_sorted(&vec, pod.type, &comp)) << "must be sorted";
+    }
+}
+
+std::vector<std::string> to_strings(const std::vector<uint32_t>& keys) {
+    std::vector<std::string> strings;
+
+    for (uint32_t key : keys) {
+        strings.push_back(std::to_string(key % 1000 + 1000) + " is long enough not to be inline");
+    }
+
+    std::sort(strings.begin(), strings.end());
+    return strings;
+}
+
+void copy_string(const void* first, const void* last, void* dest) {
+    std::uninitialized_copy(static_cast<const std::string*>(first), static_cast<const std::string*>(last), static_cast<std::string*>(dest));
+}
+
+// Checks the contents of `vec` against `expected`, then destroys it.
+void expect_and_destroy(CSTL_VectorVal& vec, CSTL_Type type, const CSTL_CopyType& copy, const std::vector<std::string>& expected, const char* what) {
+    auto first = static_cast<const std::string*>(vec.first);
+
+    ASSERT_EQ(expected.size(), CSTL_vector_size(&vec, type)) << what << " must have the right size";
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), first)) << what << " must match the standard algorithm";
+
+    CSTL_vector_destroy(&vec, type, &copy.move_type.drop_type, nullptr);
+}
+
+} // namespace
+
+TEST(AlgorithmTest, SortStrings) {
+    CSTL_MoveType move  = { { &destroy_string }, &move_string, false };
+    CSTL_CompType comp  = { &string_eq, &string_lt };
+    CSTL_Type type      = CSTL_define_type(sizeof(std::string), alignof(std::string));
+    std::mt19937_64 rng{17};
+
+    for (size_t pattern = 0; pattern < 6; ++pattern) {
+        for (size_t size : { 0, 1, 2, 15, 16, 17, 100, 3000 }) {
+            std::vector<uint32_t> keys = make_pattern(rng, pattern, size);
+            std::vector<std::string> real;
+
+            for (uint32_t key : keys) {
+                real.push_back(std::to_string(key) + " is long enough not to be inline");
+            }
+
+            std::vector<std::string> sorted = real;
+            CSTL_VectorVal vec = borrow(sorted.data(), size * sizeof(std::string));
+
+            ASSERT_TRUE(CSTL_vector_sort(&vec, type, &move, &comp, nullptr)) << "must return true on success";
+            ASSERT_TRUE(CSTL_vector_is_sorted(&vec, type, &comp)) << "must be sorted";
+
+            std::sort(real.begin(), real.end());
+
+            ASSERT_EQ(real, sorted) << "must keep every element";
+        }
+    }
+}
+
+TEST(AlgorithmTest, StableSort) {
+    CSTL_PodType pod   = CSTL_pod_type(sizeof(Keyed), alignof(Keyed));
+    CSTL_CompType comp = { &keyed_eq, &keyed_lt };
+    std::mt19937_64 rng{18};
+
+    for (size_t pattern = 0; pattern < 6; ++pattern) {
+        for (size_t size : { 0, 1, 2, 16, 17, 33, 100, 5000 }) {
+            std::vector<uint32_t> keys = make_pattern(rng, pattern, size);
+            std::vector<Keyed> real(size);
+
+            for (size_t i = 0; i < size; ++i) {
+                real[i] = Keyed{ keys[i] % 64, (uint32_t)i };
+            }
+
+            std::vector<Keyed> sorted = real;
+            CSTL_VectorVal vec = borrow(sorted.data(), size * sizeof(Keyed));
+
+            ASSERT_TRUE(CSTL_vector_stable_sort(&vec, pod.type, &pod.copy.move_type, &comp, nullptr)) << "must return true on success";
+
+            std::stable_sort(real.begin(), real.end(), [](const Keyed& lhs, const Keyed& rhs) { return lhs.key < rhs.key; });
+
+            for (size_t i = 0; i < size; ++i) {
+                ASSERT_EQ(real[i].key, sorted[i].key) << "must sort the keys";
+                ASSERT_EQ(real[i].index, sorted[i].index) << "must keep equivalent elements in order";
+            }
+        }
+    }
+}
+
+TEST(AlgorithmTest, RadixSort) {
+    std::mt19937_64 rng{19};
+
+    for (bool stable : { false, true }) {
+        radix_sort_matches<int8_t>(rng, CSTL_pod_int8, CSTL_comp_int8, stable);
+        radix_sort_matches<uint8_t>(rng, CSTL_pod_uint8, CSTL_comp_uint8, stable);
+        radix_sort_matches<int16_t>(rng, CSTL_pod_int16, CSTL_comp_int16, stable);
+        radix_sort_matches<uint16_t>(rng, CSTL_pod_uint16, CSTL_comp_uint16, stable);
+        radix_sort_matches<int32_t>(rng, CSTL_pod_int32, CSTL_comp_int32, stable);
+        radix_sort_matches<uint32_t>(rng, CSTL_pod_uint32, CSTL_comp_uint32, stable);
+        radix_sort_matches<int64_t>(rng, CSTL_pod_int64, CSTL_comp_int64, stable);
+        radix_sort_matches<uint64_t>(rng, CSTL_pod_uint64, CSTL_comp_uint64, stable);
+        radix_sort_matches<float>(rng, CSTL_pod_float, CSTL_comp_float, stable);
+        radix_sort_matches<double>(rng, CSTL_pod_double, CSTL_comp_double, stable);
+        radix_sort_matches<uintptr_t>(rng, CSTL_pod_pointer, CSTL_comp_pointer, stable);
+    }
+}
+
+TEST(AlgorithmTest, PartialSort) {
+    CSTL_MoveType move  = { { &destroy_string }, &move_string, false };
+    CSTL_CompType comp  = { &string_eq, &string_lt };
+    CSTL_Type type      = CSTL_define_type(sizeof(std::string), alignof(std::string));
+    std::mt19937_64 rng{20};
+
+    for (size_t pattern = 0; pattern < 6; ++pattern) {
+        std::vector<uint32_t> keys = make_pattern(rng, pattern, 500);
+        std::vector<std::string> real;
+
+        for (uint32_t key : keys) {
+            real.push_back(std::to_string(key));
+        }
+
+        for (size_t middle : { 0, 1, 10, 250, 500 }) {
+            std::vector<std::string> sorted = real;
+            CSTL_VectorVal vec = borrow(sorted.data(), sorted.size() * sizeof(std::string));
+
+            ASSERT_TRUE(CSTL_vector_partial_sort(&vec, type, &move, &comp, middle, nullptr)) << "must return true on success";
+
+            std::vector<std::string> expected = real;
+            std::sort(expected.begin(), expected.end());
+
+            ASSERT_TRUE(std::equal(expected.begin(), expected.begin() + (ptrdiff_t)middle, sorted.begin())) << "must sort the smallest elements";
+
+            std::sort(sorted.begin() + (ptrdiff_t)middle, sorted.end());
+            ASSERT_EQ(expected, sorted) << "must keep every element";
+        }
+    }
+}
+
+TEST(AlgorithmTest, NthElement) {
+    CSTL_PodType pod = CSTL_pod_uint32;
+    std::mt19937_64 rng{21};
+
+    for (size_t pattern = 0; pattern < 6; ++pattern) {
+        for (size_t size : { 1, 16, 17, 1000, 10000 }) {
+            std::vector<uint32_t> real = make_pattern(rng, pattern, size);
+
+            std::vector<uint32_t> expected = real;
+            std::sort(expected.begin(), expected.end());
+
+            for (size_t nth : { (size_t)0, size / 3, size - 1 }) {
+                std::vector<uint32_t> selected = real;
+                CSTL_VectorVal vec = borrow(selected.data(), size * sizeof(uint32_t));
+
+                ASSERT_TRUE(CSTL_vector_nth_element(&vec, pod.type, &pod.copy.move_type, &CSTL_comp_uint32, nth, nullptr)) << "must return true on success";
+                ASSERT_EQ(expected[nth], selected[nth]) << "must place the nth element";
+
+                for (size_t i = 0; i < size; ++i) {
+                    if (i < nth) {
+                        ASSERT_LE(selected[i], selected[nth]) << "no element before nth may be greater";
+                    } else {
+                        ASSERT_GE(selected[i], selected[nth]) << "no element after nth may be less";
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(AlgorithmTest, BinarySearch) {
+    CSTL_PodType pod = CSTL_pod_int32;
+    std::mt19937_64 rng{22};
+
+    for (size_t size : { 0, 1, 2, 3, 7, 8, 100, 1001 }) {
+        std::vector<int32_t> real(size);
+
+        for (auto& value : real) {
+            value = (int32_t)(rng() % 64) - 32;
+        }
+
+        std::sort(real.begin(), real.end());
+
+        CSTL_VectorVal vec = borrow(real.data(), size * sizeof(int32_t));
+
+        for (int32_t key = -34; key <= 34; ++key) {
+            auto lower = (size_t)(std::lower_bound(real.begin(), real.end(), key) - real.begin());
+            auto upper = (size_t)(std::upper_bound(real.begin(), real.end(), key) - real.begin());
+
+            ASSERT_EQ(lower, CSTL_vector_lower_bound(&vec, pod.type, &CSTL_comp_int32, &key)) << "must match `std::lower_bound`";
+            ASSERT_EQ(upper, CSTL_vector_upper_bound(&vec, pod.type, &CSTL_comp_int32, &key)) << "must match `std::upper_bound`";
+
+            CSTL_IndexRange range = CSTL_vector_equal_range(&vec, pod.type, &CSTL_comp_int32, &key);
+
+            ASSERT_EQ(lower, range.first) << "must match `std::equal_range`";
+            ASSERT_EQ(upper, range.last) << "must match `std::equal_range`";
+
+            ASSERT_EQ(std::binary_search(real.begin(), real.end(), key), CSTL_vector_binary_search(&vec, pod.type, &CSTL_comp_int32, &key))
+                << "must match `std::binary_search`";
+        }
+    }
+}
+
+TEST(AlgorithmTest, SetOperations) {
+    CSTL_CopyType copy = { { { &destroy_string }, &move_string, false }, &copy_string, nullptr };
+    CSTL_CompType comp = { &string_eq, &string_lt };
+    CSTL_Type type     = CSTL_define_type(sizeof(std::string), alignof(std::string));
+    std::mt19937_64 rng{23};
+
+    // Sizes of very different magnitudes exercise galloping.
+    for (auto [lhs_size, rhs_size] : { std::pair{ 0, 0 }, { 0, 5 }, { 5, 0 }, { 50, 50 }, { 3, 2000 }, { 2000, 3 }, { 700, 900 } }) {
+        std::vector<uint32_t> lhs_keys(lhs_size), rhs_keys(rhs_size);
+
+        for (auto& key : lhs_keys) {
+            key = (uint32_t)(rng() % (lhs_size + rhs_size));
+        }
+
+        for (auto& key : rhs_keys) {
+            key = (uint32_t)(rng() % (lhs_size + rhs_size));
+        }
+
+        std::vector<std::string> lhs = to_strings(lhs_keys);
+        std::vector<std::string> rhs = to_strings(rhs_keys);
+
+        CSTL_VectorVal lhs_vec = borrow(lhs.data(), lhs.size() * sizeof(std::string));
+        CSTL_VectorVal rhs_vec = borrow(rhs.data(), rhs.size() * sizeof(std::string));
+
+        // Results are appended after an existing element.
+        std::string prefix = "a prefix that is long enough not to be inline";
+
+        auto run = [&](auto cstl_op, auto std_op, const char* what) {
+            CSTL_VectorVal dest;
+            CSTL_vector_construct(&dest);
+            ASSERT_TRUE(CSTL_vector_copy_push_back(&dest, type, &copy, &prefix, nullptr)) << "must return true on success";
+            ASSERT_TRUE(cstl_op(&dest, type, &copy, &comp, &lhs_vec, &rhs_vec, nullptr)) << what << " must return true on success";
+
+            std::vector<std::string> expected{ prefix };
+            std::back_insert_iterator<std::vector<std::string>> out(expected);
+            std_op(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), out);
+
+            expect_and_destroy(dest, type, copy, expected, what);
+        };
+
+        using Iter = std::vector<std::string>::iterator;
+        using Out  = std::back_insert_iterator<std::vector<std::string>>;
+
+        run(&CSTL_vector_merge, &std::merge<Iter, Iter, Out>, "merge");
+        run(&CSTL_vector_set_union, &std::set_union<Iter, Iter, Out>, "set_union");
+        run(&CSTL_vector_set_intersection, &std::set_intersection<Iter, Iter, Out>, "set_intersection");
+        run(&CSTL_vector_set_difference, &std::set_difference<Iter, Iter, Out>, "set_difference");
+    }
+}
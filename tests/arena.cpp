@@ -0,0 +1,236 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "alloc.h"
+#include "arena.h"
+#include "type.h"
+#include "vector.h"
+#include "xstring.h"
+
+class ArenaTest : public testing::Test {
+protected:
+    ArenaTest() : arena{} {
+        CSTL_arena_construct(&arena, 4096, 0, nullptr);
+    }
+
+    ~ArenaTest() {
+        CSTL_arena_destroy(&arena);
+    }
+
+    CSTL_Arena arena;
+};
+
+TEST_F(ArenaTest, Default) {
+    CSTL_ArenaStats stats = CSTL_arena_stats(&arena);
+
+    EXPECT_EQ(0, stats.used) << "a new arena must not be used";
+    EXPECT_EQ(0, stats.reserved) << "a new arena must not allocate";
+    EXPECT_EQ(0, stats.chunks) << "a new arena must not allocate";
+}
+
+TEST_F(ArenaTest, Alignment) {
+    for (size_t alignment = 1; alignment <= 4096; alignment *= 2) {
+        void* memory = CSTL_arena_allocate(&arena, 3, alignment);
+
+        ASSERT_NE(nullptr, memory) << "must allocate; alignment=" << alignment;
+        EXPECT_EQ(0, (uintptr_t)memory % alignment)
+            << "alignment must be upheld; alignment=" << alignment;
+    }
+
+    void* large = CSTL_arena_allocate(&arena, 1 << 20, 16);
+
+    ASSERT_NE(nullptr, large) << "blocks larger than a chunk must be allocated";
+    memset(large, 0xAB, 1 << 20);
+}
+
+TEST_F(ArenaTest, ResetAndRewind) {
+    void* first = CSTL_arena_allocate(&arena, 100, 8);
+
+    CSTL_ArenaMark mark = CSTL_arena_mark(&arena);
+    void* second = CSTL_arena_allocate(&arena, 100, 8);
+
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_NE(nullptr, CSTL_arena_allocate(&arena, 1000, 8)) << "must allocate; i=" << i;
+    }
+
+    size_t reserved = CSTL_arena_stats(&arena).reserved;
+    size_t chunks   = CSTL_arena_stats(&arena).chunks;
+
+    CSTL_arena_rewind(&arena, mark);
+
+    EXPECT_EQ(second, CSTL_arena_allocate(&arena, 100, 8))
+        << "rewinding must reuse memory after the mark";
+
+    CSTL_arena_reset(&arena);
+
+    EXPECT_EQ(0, CSTL_arena_stats(&arena).used) << "a reset arena must not be used";
+    EXPECT_EQ(first, CSTL_arena_allocate(&arena, 100, 8))
+        << "resetting must reuse memory from the start";
+
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_NE(nullptr, CSTL_arena_allocate(&arena, 1000, 8)) << "must allocate; i=" << i;
+    }
+
+    EXPECT_EQ(reserved, CSTL_arena_stats(&arena).reserved)
+        << "chunks must be reused after a reset";
+    EXPECT_EQ(chunks, CSTL_arena_stats(&arena).chunks)
+        << "chunks must be reused after a reset";
+    EXPECT_LE(CSTL_arena_stats(&arena).used, CSTL_arena_stats(&arena).peak)
+        << "peak usage must not be less than usage";
+}
+
+TEST_F(ArenaTest, Limit) {
+    CSTL_Arena limited;
+    CSTL_arena_construct(&limited, 1024, 8192, nullptr);
+
+    size_t allocated = 0;
+
+    while (CSTL_arena_allocate(&limited, 256, 8) != nullptr) {
+        allocated += 256;
+        ASSERT_LE(allocated, 8192) << "must not allocate past the limit";
+    }
+
+    EXPECT_LE(CSTL_arena_stats(&limited).reserved, 8192)
+        << "must not reserve past the limit";
+    EXPECT_EQ(nullptr, CSTL_arena_allocate(&limited, 16384, 8))
+        << "blocks larger than the limit must fail";
+
+    CSTL_arena_destroy(&limited);
+}
+
+TEST_F(ArenaTest, FreeLast) {
+    ASSERT_NE(nullptr, CSTL_arena_allocate(&arena, 1, 1)) << "must allocate";
+
+    size_t used = CSTL_arena_stats(&arena).used;
+    void* block = CSTL_arena_allocate(&arena, 8, 64);
+
+    ASSERT_NE(nullptr, block) << "must allocate";
+
+    size_t peak = CSTL_arena_stats(&arena).peak;
+
+    for (int i = 0; i < 100; ++i) {
+        arena.alloc.aligned_free(arena.alloc.opaque, block, 8, 64);
+
+        ASSERT_EQ(used, CSTL_arena_stats(&arena).used)
+            << "freeing the last block must give back its padding; i=" << i;
+
+        block = CSTL_arena_allocate(&arena, 8, 64);
+        ASSERT_NE(nullptr, block) << "must allocate; i=" << i;
+    }
+
+    EXPECT_EQ(peak, CSTL_arena_stats(&arena).peak) << "peak usage must not drift";
+}
+
+TEST_F(ArenaTest, FailedChunk) {
+    CSTL_Arena limited;
+    CSTL_arena_construct(&limited, 1024, 4096, nullptr);
+
+    ASSERT_NE(nullptr, CSTL_arena_allocate(&limited, 900, 8)) << "must allocate";
+    ASSERT_NE(nullptr, CSTL_arena_allocate(&limited, 900, 8)) << "must allocate";
+    ASSERT_EQ(2, CSTL_arena_stats(&limited).chunks) << "must use a second chunk";
+
+    CSTL_arena_reset(&limited);
+
+    auto first = (char*)CSTL_arena_allocate(&limited, 96, 8);
+
+    ASSERT_NE(nullptr, first) << "must allocate";
+    EXPECT_EQ(nullptr, CSTL_arena_allocate(&limited, 3000, 8)) << "blocks past the limit must fail";
+    EXPECT_EQ(first + 96, CSTL_arena_allocate(&limited, 96, 8))
+        << "a failed allocation must not skip the rest of the current chunk";
+
+    CSTL_arena_destroy(&limited);
+}
+
+TEST_F(ArenaTest, Containers) {
+    CSTL_PodType pod = CSTL_pod_uint32;
+    CSTL_VectorVal vec;
+
+    CSTL_vector_construct(&vec);
+
+    std::vector<uint32_t> expected;
+
+    for (uint32_t i = 0; i < 10000; ++i) {
+        expected.push_back(i);
+        ASSERT_TRUE(CSTL_vector_copy_push_back(&vec, pod.type, &pod.copy, &i, &arena.alloc))
+            << "must return true on success";
+    }
+
+    ASSERT_EQ(expected.size(), CSTL_vector_size(&vec, pod.type));
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), (const uint32_t*)CSTL_vector_data(&vec)))
+        << "elements must match";
+
+    CSTL_StringVal str;
+    CSTL_string_construct(&str);
+
+    std::string real_str;
+
+    for (int i = 0; i < 1000; ++i) {
+        real_str += "arena ";
+        ASSERT_TRUE(CSTL_string_append(&str, "arena ", &arena.alloc))
+            << "must return true on success";
+    }
+
+    EXPECT_EQ(real_str, std::string(CSTL_string_c_str(&str), CSTL_string_size(&str)))
+        << "strings should compare equal";
+
+    CSTL_string_destroy(&str, &arena.alloc);
+    CSTL_vector_destroy(&vec, pod.type, &pod.copy.move_type.drop_type, &arena.alloc);
+
+    EXPECT_LT(0, CSTL_arena_stats(&arena).peak) << "containers must allocate from the arena";
+}
+
+TEST_F(ArenaTest, GrowInPlace) {
+    CSTL_PodType pod = CSTL_pod_uint32;
+    CSTL_VectorVal vec;
+
+    CSTL_vector_construct(&vec);
+
+    uint32_t value = 0;
+
+    ASSERT_TRUE(CSTL_vector_copy_push_back(&vec, pod.type, &pod.copy, &value, &arena.alloc))
+        << "must return true on success";
+
+    const void* data = CSTL_vector_data(&vec);
+
+    for (value = 1; value < 500; ++value) {
+        ASSERT_TRUE(CSTL_vector_copy_push_back(&vec, pod.type, &pod.copy, &value, &arena.alloc))
+            << "must return true on success";
+    }
+
+    EXPECT_EQ(data, CSTL_vector_data(&vec)) << "the most recent block must grow in place";
+
+    for (uint32_t i = 0; i < 500; ++i) {
+        ASSERT_EQ(i, ((const uint32_t*)CSTL_vector_data(&vec))[i]) << "elements must match; i=" << i;
+    }
+
+    CSTL_ArenaStats stats = CSTL_arena_stats(&arena);
+
+    EXPECT_EQ(1, stats.chunks) << "growing in place must not need more chunks";
+    EXPECT_GE(1000, stats.used - 500 * sizeof(uint32_t)) << "growing in place must not leave old blocks behind";
+
+    CSTL_StringVal str;
+    CSTL_string_construct(&str);
+
+    ASSERT_TRUE(CSTL_string_reserve(&str, 64, &arena.alloc)) << "must return true on success";
+
+    const char* chars = CSTL_string_c_str(&str);
+    std::string real_str;
+
+    for (int i = 0; i < 100; ++i) {
+        real_str += "grow ";
+        ASSERT_TRUE(CSTL_string_append(&str, "grow ", &arena.alloc))
+            << "must return true on success";
+    }
+
+    EXPECT_EQ(chars, CSTL_string_c_str(&str)) << "the most recent block must grow in place";
+    EXPECT_EQ(real_str, std::string(CSTL_string_c_str(&str), CSTL_string_size(&str)))
+        << "strings should compare equal";
+
+    CSTL_string_destroy(&str, &arena.alloc);
+    CSTL_vector_destroy(&vec, pod.type, &pod.copy.move_type.drop_type, &arena.alloc);
+}
@@ -0,0 +1,287 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "alloc.h"
+#include "basic_string.h"
+#include "type.h"
+#include "xstring.h"
+
+namespace {
+
+// An odd-sized character without default traits of its own.
+struct Char3 {
+    unsigned char bytes[3];
+
+    bool operator==(const Char3& other) const {
+        return memcmp(bytes, other.bytes, 3) == 0;
+    }
+};
+
+template <typename T>
+T make_char(uint64_t value) {
+    if constexpr (std::is_same_v<T, Char3>) {
+        return Char3{ { (unsigned char)value, (unsigned char)(value >> 8), (unsigned char)(value >> 16) } };
+    } else {
+        return (T)value;
+    }
+}
+
+size_t ascii_length(const void* ptr) {
+    return strlen(static_cast<const char*>(ptr));
+}
+
+int ascii_icompare(const void* lhs, const void* rhs, size_t count) {
+    auto left  = static_cast<const unsigned char*>(lhs);
+    auto right = static_cast<const unsigned char*>(rhs);
+
+    for (size_t i = 0; i < count; ++i) {
+        int diff = std::tolower(left[i]) - std::tolower(right[i]);
+
+        if (diff != 0) {
+            return diff;
+        }
+    }
+
+    return 0;
+}
+
+size_t ascii_ifind(const void* first, size_t count, const void* ch) {
+    auto chars = static_cast<const unsigned char*>(first);
+    int value  = std::tolower(*static_cast<const unsigned char*>(ch));
+
+    for (size_t i = 0; i < count; ++i) {
+        if (std::tolower(chars[i]) == value) {
+            return i;
+        }
+    }
+
+    return count;
+}
+
+// Runs random edits on a `CSTL_BasicStringVal` of `T` and a vector of `T`.
+template <typename T>
+void random_edits(uint64_t seed) {
+    CSTL_Type type = CSTL_define_type(sizeof(T), alignof(T));
+
+    ASSERT_NE(nullptr, type);
+
+    CSTL_BasicStringVal str;
+    CSTL_basic_string_construct(&str, type);
+
+    std::vector<T> real;
+    std::mt19937_64 rng{seed};
+
+    auto assert_equal = [&] {
+        ASSERT_EQ(real.size(), CSTL_basic_string_size(&str)) << "sizes must match";
+
+        auto data = static_cast<const T*>(CSTL_basic_string_c_str(&str, type));
+
+        ASSERT_TRUE(std::equal(real.begin(), real.end(), data)) << "contents must match";
+        ASSERT_EQ(make_char<T>(0), data[real.size()]) << "must be null-terminated";
+        ASSERT_LE(real.size(), CSTL_basic_string_capacity(&str)) << "capacity must fit the contents";
+    };
+
+    for (size_t i = 0; i < 3000; ++i) {
+        std::vector<T> input(rng() % 24);
+
+        for (auto& ch : input) {
+            ch = make_char<T>(1 + rng() % 4);
+        }
+
+        T ch       = make_char<T>(1 + rng() % 4);
+        size_t off = rng() % (real.size() + 1);
+        size_t n   = rng() % 8;
+
+        switch (rng() % 9) {
+        case 0:
+            real = input;
+            ASSERT_TRUE(CSTL_basic_string_assign_n(&str, type, input.data(), input.size(), nullptr)) << "must return true on success";
+            break;
+        case 1:
+            real.insert(real.end(), input.begin(), input.end());
+            ASSERT_TRUE(CSTL_basic_string_append_n(&str, type, input.data(), input.size(), nullptr)) << "must return true on success";
+            break;
+        case 2:
+            real.insert(real.begin() + (ptrdiff_t)off, input.begin(), input.end());
+            ASSERT_TRUE(CSTL_basic_string_insert_n_at(&str, type, off, input.data(), input.size(), nullptr)) << "must return true on success";
+            break;
+        case 3:
+            real.insert(real.begin() + (ptrdiff_t)off, n, ch);
+            ASSERT_TRUE(CSTL_basic_string_insert_char_at(&str, type, off, n, &ch, nullptr)) << "must return true on success";
+            break;
+        case 4: {
+            size_t count = std::min(n, real.size() - off);
+            real.erase(real.begin() + (ptrdiff_t)off, real.begin() + (ptrdiff_t)(off + count));
+            ASSERT_TRUE(CSTL_basic_string_erase_substr_at(&str, type, off, n)) << "must return true on success";
+            break;
+        }
+        case 5: {
+            // Replace with a part of the string itself.
+            size_t count  = std::min(n, real.size() - off);
+            size_t src    = real.empty() ? 0 : rng() % real.size();
+            size_t count2 = real.empty() ? 0 : rng() % (real.size() - src + 1);
+
+            std::vector<T> piece(real.begin() + (ptrdiff_t)src, real.begin() + (ptrdiff_t)(src + count2));
+            real.erase(real.begin() + (ptrdiff_t)off, real.begin() + (ptrdiff_t)(off + count));
+            real.insert(real.begin() + (ptrdiff_t)off, piece.begin(), piece.end());
+
+            const T* data = static_cast<const T*>(CSTL_basic_string_c_str(&str, type));
+
+            ASSERT_TRUE(CSTL_basic_string_replace_n_at(&str, type, off, n, data + src, count2, nullptr)) << "must return true on success";
+            break;
+        }
+        case 6: {
+            // Append the string to itself.
+            std::vector<T> copy = real;
+            real.insert(real.end(), copy.begin(), copy.end());
+            ASSERT_TRUE(CSTL_basic_string_append_str(&str, type, &str, nullptr)) << "must return true on success";
+            break;
+        }
+        case 7: {
+            size_t new_size = rng() % 40;
+            real.resize(new_size, ch);
+            ASSERT_TRUE(CSTL_basic_string_resize(&str, type, new_size, &ch, nullptr)) << "must return true on success";
+            break;
+        }
+        case 8:
+            if (rng() % 4 == 0) {
+                CSTL_basic_string_shrink_to_fit(&str, type, nullptr);
+            } else {
+                real.push_back(ch);
+                ASSERT_TRUE(CSTL_basic_string_push_back(&str, type, &ch, nullptr)) << "must return true on success";
+            }
+            break;
+        }
+
+        // Keep the strings short, so that they often return to the inline buffer.
+        if (real.size() > 200) {
+            real.clear();
+            CSTL_basic_string_clear(&str, type);
+        }
+
+        assert_equal();
+
+        if (!real.empty() && !input.empty()) {
+            size_t count    = std::min<size_t>(input.size(), 3);
+            auto expected   = std::search(real.begin(), real.end(), input.begin(), input.begin() + (ptrdiff_t)count);
+            size_t found_at = CSTL_basic_string_find_n(&str, type, nullptr, input.data(), 0, count);
+
+            if (expected == real.end()) {
+                ASSERT_EQ((size_t)-1, found_at) << "must not find a missing substring";
+            } else {
+                ASSERT_EQ((size_t)(expected - real.begin()), found_at) << "must find the first occurrence";
+            }
+
+            auto rexpected   = std::find_end(real.begin(), real.end(), input.begin(), input.begin() + (ptrdiff_t)count);
+            size_t rfound_at = CSTL_basic_string_rfind_n(&str, type, nullptr, input.data(), (size_t)-1, count);
+
+            if (rexpected == real.end()) {
+                ASSERT_EQ((size_t)-1, rfound_at) << "must not find a missing substring";
+            } else {
+                ASSERT_EQ((size_t)(rexpected - real.begin()), rfound_at) << "must find the last occurrence";
+            }
+
+            auto cexpected   = std::find(real.begin() + (ptrdiff_t)(off < real.size() ? off : 0), real.end(), ch);
+            size_t cfound_at = CSTL_basic_string_find_char(&str, type, nullptr, &ch, off < real.size() ? off : 0);
+
+            ASSERT_EQ(cexpected == real.end() ? (size_t)-1 : (size_t)(cexpected - real.begin()), cfound_at) << "must find the character";
+        }
+    }
+
+    CSTL_basic_string_destroy(&str, type, nullptr);
+}
+
+} // namespace
+
+TEST(BasicStringTest, Bufsize) {
+    EXPECT_EQ(32, sizeof(CSTL_BasicStringVal)) << "must match the size of `std::basic_string`";
+
+    EXPECT_EQ(16, CSTL_basic_string_bufsize(CSTL_pod_uint8.type)) << "must match `CSTL_string_bufsize`";
+    EXPECT_EQ(8, CSTL_basic_string_bufsize(CSTL_pod_uint16.type)) << "must match `CSTL_string_bufsize`";
+    EXPECT_EQ(4, CSTL_basic_string_bufsize(CSTL_pod_uint32.type)) << "must match `CSTL_string_bufsize`";
+    EXPECT_EQ(2, CSTL_basic_string_bufsize(CSTL_pod_uint64.type)) << "must match `CSTL_string_bufsize`";
+    EXPECT_EQ(5, CSTL_basic_string_bufsize(CSTL_define_type(3, 1))) << "must match `CSTL_string_bufsize`";
+    EXPECT_EQ(1, CSTL_basic_string_bufsize(CSTL_define_type(16, 8))) << "must match `CSTL_string_bufsize`";
+}
+
+TEST(BasicStringTest, RandomEdits) {
+    random_edits<char>(1);
+    random_edits<char16_t>(2);
+    random_edits<char32_t>(3);
+    random_edits<uint64_t>(4);
+    random_edits<Char3>(5);
+}
+
+TEST(BasicStringTest, TypedInterop) {
+    CSTL_Type type = CSTL_define_type(sizeof(char16_t), alignof(char16_t));
+
+    std::u16string real = u"a buffer of 16-bit characters, too long to be inline";
+
+    CSTL_BasicStringVal str;
+    CSTL_basic_string_construct(&str, type);
+
+    ASSERT_TRUE(CSTL_basic_string_assign(&str, type, nullptr, real.c_str(), nullptr)) << "must return true on success";
+
+    // The same object, seen as a typed string.
+    CSTL_UTF16StringVal typed;
+    memcpy(&typed, &str, sizeof(typed));
+
+    EXPECT_EQ(real.size(), CSTL_u16string_size(&typed)) << "layouts must match";
+    EXPECT_EQ(real, std::u16string(CSTL_u16string_c_str(&typed))) << "layouts must match";
+
+    ASSERT_TRUE(CSTL_u16string_append(&typed, u"!", nullptr)) << "must return true on success";
+    memcpy(&str, &typed, sizeof(typed));
+    real += u"!";
+
+    EXPECT_EQ(real.size(), CSTL_basic_string_size(&str)) << "layouts must match";
+    EXPECT_EQ(real.find(u"16-bit"), CSTL_basic_string_find_n(&str, type, nullptr, u"16-bit", 0, 6)) << "must find the substring";
+    EXPECT_EQ(real.rfind(u't'), CSTL_basic_string_rfind_char(&str, type, nullptr, u"t", (size_t)-1)) << "must find the character";
+
+    CSTL_basic_string_destroy(&str, type, nullptr);
+}
+
+TEST(BasicStringTest, CustomTraits) {
+    CSTL_CharTraits traits = { &ascii_length, &ascii_icompare, &ascii_ifind };
+    CSTL_Type type         = CSTL_pod_uint8.type;
+
+    CSTL_BasicStringVal str;
+    CSTL_basic_string_construct(&str, type);
+
+    ASSERT_TRUE(CSTL_basic_string_assign(&str, type, &traits, "Hello, World! Hello, Traits!", nullptr)) << "must return true on success";
+
+    EXPECT_EQ(7, CSTL_basic_string_find_n(&str, type, &traits, "WORLD", 0, 5)) << "must use the traits to compare";
+    EXPECT_EQ((size_t)-1, CSTL_basic_string_find_n(&str, type, nullptr, "WORLD", 0, 5)) << "default traits must be case sensitive";
+    EXPECT_EQ(14, CSTL_basic_string_rfind_n(&str, type, &traits, "hello", (size_t)-1, 5)) << "must use the traits to compare";
+    EXPECT_EQ(7, CSTL_basic_string_find_char(&str, type, &traits, "w", 0)) << "must use the traits to find";
+    EXPECT_EQ(22, CSTL_basic_string_rfind_char(&str, type, &traits, "R", (size_t)-1)) << "must use the traits to compare";
+
+    CSTL_BasicStringVal other;
+    CSTL_basic_string_construct(&other, type);
+    ASSERT_TRUE(CSTL_basic_string_assign(&other, type, &traits, "HELLO, WORLD! HELLO, TRAITS!", nullptr)) << "must return true on success";
+
+    EXPECT_EQ(0, CSTL_basic_string_compare_str(&str, type, &traits, &other)) << "must use the traits to compare";
+    EXPECT_LT(0, CSTL_basic_string_compare_str(&str, type, nullptr, &other)) << "default traits must be case sensitive";
+
+    CSTL_basic_string_destroy(&other, type, nullptr);
+    CSTL_basic_string_destroy(&str, type, nullptr);
+}
+
+TEST(BasicStringTest, Compare) {
+    CSTL_Type type = CSTL_pod_uint64.type;
+
+    const uint64_t small[] = { 1, 2, 3 };
+    const uint64_t large[] = { 1, 2, (uint64_t)1 << 40 };
+
+    EXPECT_GT(0, CSTL_basic_string_compare_nn(type, nullptr, small, 3, large, 3)) << "must compare as unsigned integers";
+    EXPECT_LT(0, CSTL_basic_string_compare_nn(type, nullptr, large, 3, small, 3)) << "must compare as unsigned integers";
+    EXPECT_GT(0, CSTL_basic_string_compare_nn(type, nullptr, small, 2, small, 3)) << "a prefix must be ordered first";
+    EXPECT_EQ(0, CSTL_basic_string_compare_nn(type, nullptr, small, 3, small, 3)) << "equal strings must compare equal";
+}
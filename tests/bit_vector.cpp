@@ -0,0 +1,236 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "bit_vector.h"
+
+namespace {
+
+// Checks `bits` against `real`, including the clear bits past the end.
+void assert_matches(const CSTL_BitVectorVal& bits, const std::vector<bool>& real) {
+    ASSERT_EQ(real.size(), CSTL_bit_vector_size(&bits)) << "sizes must match";
+    ASSERT_EQ((real.size() + 31) / 32, CSTL_bit_vector_word_count(&bits)) << "must use one word per 32 bits";
+    ASSERT_LE(real.size(), CSTL_bit_vector_capacity(&bits)) << "capacity must fit the contents";
+
+    for (size_t i = 0; i < real.size(); ++i) {
+        ASSERT_EQ(real[i], CSTL_bit_vector_test(&bits, i)) << "bits must match at " << i;
+    }
+
+    if (real.size() % 32 != 0) {
+        uint32_t last = CSTL_bit_vector_const_words(&bits)[real.size() / 32];
+        ASSERT_EQ(0u, last >> (real.size() % 32)) << "bits past the end must be clear";
+    }
+}
+
+std::vector<bool> random_bits(std::mt19937_64& rng, size_t size, unsigned density) {
+    std::vector<bool> bits(size);
+
+    for (size_t i = 0; i < size; ++i) {
+        bits[i] = rng() % 100 < density;
+    }
+
+    return bits;
+}
+
+void assign_from(CSTL_BitVectorVal& bits, const std::vector<bool>& real) {
+    ASSERT_TRUE(CSTL_bit_vector_assign_n(&bits, real.size(), false, nullptr)) << "must return true on success";
+
+    for (size_t i = 0; i < real.size(); ++i) {
+        CSTL_bit_vector_assign_bit(&bits, i, real[i]);
+    }
+}
+
+} // namespace
+
+TEST(BitVectorTest, Layout) {
+    EXPECT_EQ(32, sizeof(CSTL_BitVectorVal)) << "must match the size of `std::vector<bool>`";
+
+    CSTL_BitVectorVal bits;
+    CSTL_bit_vector_construct(&bits);
+
+    EXPECT_TRUE(CSTL_bit_vector_empty(&bits)) << "must be empty after construction";
+    EXPECT_EQ(0, CSTL_bit_vector_count(&bits)) << "an empty vector has no set bits";
+    EXPECT_EQ(0, CSTL_bit_vector_find_first_set(&bits, 0)) << "must return the size when not found";
+
+    ASSERT_TRUE(CSTL_bit_vector_assign_n(&bits, 33, true, nullptr)) << "must return true on success";
+
+    const uint32_t* words = CSTL_bit_vector_const_words(&bits);
+
+    EXPECT_EQ(UINT32_MAX, words[0]) << "bits must be packed least significant first";
+    EXPECT_EQ(1u, words[1]) << "bits past the end must be clear";
+
+    CSTL_bit_vector_destroy(&bits, nullptr);
+}
+
+TEST(BitVectorTest, RandomEdits) {
+    std::mt19937_64 rng{16};
+    std::vector<bool> real;
+
+    CSTL_BitVectorVal bits;
+    CSTL_bit_vector_construct(&bits);
+
+    for (size_t i = 0; i < 2000; ++i) {
+        bool value   = rng() % 2 != 0;
+        size_t size  = real.size();
+        size_t first = rng() % (size + 1);
+        size_t last  = first + rng() % (size - first + 1);
+
+        switch (rng() % 9) {
+        case 0: {
+            size_t new_size = rng() % 300;
+            real.resize(new_size, value);
+            ASSERT_TRUE(CSTL_bit_vector_resize(&bits, new_size, value, nullptr)) << "must return true on success";
+            break;
+        }
+        case 1:
+            real.push_back(value);
+            ASSERT_TRUE(CSTL_bit_vector_push_back(&bits, value, nullptr)) << "must return true on success";
+            break;
+        case 2:
+            if (!real.empty()) {
+                real.pop_back();
+                CSTL_bit_vector_pop_back(&bits);
+            }
+            break;
+        case 3:
+            std::fill(real.begin() + (ptrdiff_t)first, real.begin() + (ptrdiff_t)last, true);
+            CSTL_bit_vector_set_range(&bits, first, last);
+            break;
+        case 4:
+            std::fill(real.begin() + (ptrdiff_t)first, real.begin() + (ptrdiff_t)last, false);
+            CSTL_bit_vector_reset_range(&bits, first, last);
+            break;
+        case 5:
+            for (size_t j = first; j < last; ++j) {
+                real[j] = !real[j];
+            }
+            CSTL_bit_vector_flip_range(&bits, first, last);
+            break;
+        case 6:
+            if (first < size) {
+                real[first] = !real[first];
+                CSTL_bit_vector_flip(&bits, first);
+            }
+            break;
+        case 7:
+            if (first < size) {
+                real[first] = value;
+                CSTL_bit_vector_assign_bit(&bits, first, value);
+            }
+            break;
+        case 8: {
+            size_t new_size = rng() % 300;
+            real.assign(new_size, value);
+            ASSERT_TRUE(CSTL_bit_vector_assign_n(&bits, new_size, value, nullptr)) << "must return true on success";
+            break;
+        }
+        }
+
+        assert_matches(bits, real);
+
+        size_t off = rng() % (real.size() + 2);
+
+        auto expected_set   = off < real.size() ? std::find(real.begin() + (ptrdiff_t)off, real.end(), true) : real.end();
+        auto expected_unset = off < real.size() ? std::find(real.begin() + (ptrdiff_t)off, real.end(), false) : real.end();
+
+        ASSERT_EQ((size_t)(expected_set - real.begin()), CSTL_bit_vector_find_first_set(&bits, off)) << "must find the first set bit";
+        ASSERT_EQ((size_t)(expected_unset - real.begin()), CSTL_bit_vector_find_first_unset(&bits, off)) << "must find the first clear bit";
+
+        ASSERT_EQ((size_t)std::count(real.begin(), real.end(), true), CSTL_bit_vector_count(&bits)) << "must count the set bits";
+
+        first = rng() % (real.size() + 1);
+        last  = first + rng() % (real.size() - first + 1);
+
+        ASSERT_EQ((size_t)std::count(real.begin() + (ptrdiff_t)first, real.begin() + (ptrdiff_t)last, true), CSTL_bit_vector_count_range(&bits, first, last))
+            << "must count the set bits in the range";
+    }
+
+    CSTL_bit_vector_destroy(&bits, nullptr);
+}
+
+TEST(BitVectorTest, LongScans) {
+    // Long runs exercise the vectorised word skipping.
+    for (size_t size : { 0, 1, 31, 32, 33, 255, 256, 257, 4099 }) {
+        CSTL_BitVectorVal bits;
+        CSTL_bit_vector_construct(&bits);
+
+        ASSERT_TRUE(CSTL_bit_vector_assign_n(&bits, size, false, nullptr)) << "must return true on success";
+        EXPECT_EQ(size, CSTL_bit_vector_find_first_set(&bits, 0)) << "must not find a set bit in a clear vector";
+        EXPECT_EQ(0, CSTL_bit_vector_find_first_unset(&bits, 0)) << "must find the first clear bit";
+
+        if (size != 0) {
+            CSTL_bit_vector_set(&bits, size - 1);
+            EXPECT_EQ(size - 1, CSTL_bit_vector_find_first_set(&bits, 0)) << "must find the last bit";
+        }
+
+        CSTL_bit_vector_flip_range(&bits, 0, size);
+        EXPECT_EQ(size == 0 ? 0 : size - 1, CSTL_bit_vector_find_first_unset(&bits, 0)) << "must find the last clear bit";
+        EXPECT_EQ(size == 0 ? 0 : size - 1, CSTL_bit_vector_count(&bits)) << "must count the set bits";
+
+        CSTL_bit_vector_set_range(&bits, 0, size);
+        EXPECT_EQ(size, CSTL_bit_vector_find_first_unset(&bits, 0)) << "clear bits past the end must not be found";
+        EXPECT_EQ(size, CSTL_bit_vector_count(&bits)) << "must count the set bits";
+
+        CSTL_bit_vector_destroy(&bits, nullptr);
+    }
+}
+
+TEST(BitVectorTest, Bitwise) {
+    std::mt19937_64 rng{17};
+
+    for (size_t size : { 0, 5, 32, 100, 255, 256, 1000, 4133 }) {
+        std::vector<bool> left  = random_bits(rng, size, 50);
+        std::vector<bool> right = random_bits(rng, size, 30);
+
+        CSTL_BitVectorVal lhs, rhs;
+        CSTL_bit_vector_construct(&lhs);
+        CSTL_bit_vector_construct(&rhs);
+
+        assign_from(lhs, left);
+        assign_from(rhs, right);
+
+        std::vector<bool> expected = left;
+
+        for (size_t i = 0; i < size; ++i) {
+            expected[i] = left[i] && right[i];
+        }
+
+        CSTL_bit_vector_and_assign(&lhs, &rhs);
+        assert_matches(lhs, expected);
+
+        for (size_t i = 0; i < size; ++i) {
+            expected[i] = expected[i] || right[i];
+        }
+
+        CSTL_bit_vector_or_assign(&lhs, &rhs);
+        assert_matches(lhs, expected);
+
+        for (size_t i = 0; i < size; ++i) {
+            expected[i] = expected[i] != right[i];
+        }
+
+        CSTL_bit_vector_xor_assign(&lhs, &rhs);
+        assert_matches(lhs, expected);
+
+        CSTL_BitVectorVal copy;
+        CSTL_bit_vector_construct(&copy);
+
+        ASSERT_TRUE(CSTL_bit_vector_copy_assign(&copy, &lhs, nullptr)) << "must return true on success";
+        EXPECT_TRUE(CSTL_bit_vector_equal(&copy, &lhs)) << "a copy must compare equal";
+
+        CSTL_bit_vector_xor_assign(&copy, &copy);
+        EXPECT_EQ(0, CSTL_bit_vector_count(&copy)) << "xor with itself must clear every bit";
+        EXPECT_EQ(CSTL_bit_vector_count(&lhs) == 0, CSTL_bit_vector_equal(&copy, &lhs)) << "must compare the bits";
+
+        CSTL_bit_vector_swap(&copy, &rhs);
+        assert_matches(copy, right);
+
+        CSTL_bit_vector_destroy(&copy, nullptr);
+        CSTL_bit_vector_destroy(&rhs, nullptr);
+        CSTL_bit_vector_destroy(&lhs, nullptr);
+    }
+}
@@ -0,0 +1,295 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "alloc.h"
+#include "deque.h"
+#include "type.h"
+
+namespace {
+
+void destroy_string(void* first, void* last) {
+    std::destroy(static_cast<std::string*>(first), static_cast<std::string*>(last));
+}
+
+void move_string(void* first, void* last, void* dest) {
+    std::uninitialized_move(static_cast<std::string*>(first), static_cast<std::string*>(last), static_cast<std::string*>(dest));
+}
+
+void copy_string(const void* first, const void* last, void* dest) {
+    std::uninitialized_copy(static_cast<const std::string*>(first), static_cast<const std::string*>(last), static_cast<std::string*>(dest));
+}
+
+} // namespace
+
+class DequeTest : public testing::Test {
+protected:
+    DequeTest() : cstl_deque{}, copy{}, alloc{nullptr}, type{} {}
+
+    ~DequeTest() {
+        CSTL_deque_destroy(&cstl_deque, type, &copy.move_type.drop_type, alloc);
+    }
+
+    void SetUp() override {
+        type = CSTL_define_type(sizeof(std::string), alignof(std::string));
+
+        ASSERT_NE(nullptr, type);
+
+        copy = { { { &destroy_string }, &move_string, false }, &copy_string, nullptr };
+
+        ASSERT_TRUE(CSTL_deque_construct(&cstl_deque, alloc)) << "must return true on success";
+    }
+
+    void deque_assert_equal() {
+        ASSERT_EQ(real_deque.size(), CSTL_deque_size(&cstl_deque)) << "sizes must match";
+
+        for (size_t i = 0; i < real_deque.size(); ++i) {
+            ASSERT_EQ(real_deque[i], *static_cast<std::string*>(CSTL_deque_index(&cstl_deque, type, i)))
+                << "elements must match; index=" << i;
+        }
+    }
+
+    std::deque<std::string> real_deque;
+
+    CSTL_DequeVal cstl_deque;
+    CSTL_CopyType copy;
+    CSTL_Alloc* alloc;
+    CSTL_Type type;
+};
+
+TEST_F(DequeTest, Layout) {
+    if constexpr (sizeof(void*) == 8) {
+        EXPECT_EQ(40, sizeof(CSTL_DequeVal)) << "must match the size of `std::deque`";
+    }
+
+    EXPECT_EQ(&cstl_deque, cstl_deque.proxy->cont) << "proxy must point to its deque";
+    EXPECT_EQ(nullptr, cstl_deque.map) << "empty deque must not allocate a map";
+
+    EXPECT_EQ(16, CSTL_deque_block_size(CSTL_pod_uint8.type)) << "blocks must hold 16 bytes";
+    EXPECT_EQ(8, CSTL_deque_block_size(CSTL_pod_uint16.type)) << "blocks must hold 16 bytes";
+    EXPECT_EQ(4, CSTL_deque_block_size(CSTL_pod_uint32.type)) << "blocks must hold 16 bytes";
+    EXPECT_EQ(2, CSTL_deque_block_size(CSTL_pod_uint64.type)) << "blocks must hold 16 bytes";
+    EXPECT_EQ(1, CSTL_deque_block_size(type)) << "blocks must hold a single large element";
+}
+
+TEST_F(DequeTest, PushPop) {
+    std::mt19937_64 rng{42};
+
+    for (size_t i = 0; i < 20000; ++i) {
+        std::string value = std::to_string(i) + " is a reasonably long string";
+
+        switch (rng() % 6) {
+        case 0:
+        case 1:
+            real_deque.push_back(value);
+            ASSERT_TRUE(CSTL_deque_copy_push_back(&cstl_deque, type, &copy, &value, alloc)) << "must return true on success";
+            break;
+        case 2:
+            real_deque.push_front(value);
+            ASSERT_TRUE(CSTL_deque_move_push_front(&cstl_deque, type, &copy.move_type, &value, alloc)) << "must return true on success";
+            break;
+        case 3:
+            real_deque.push_front(value);
+            ASSERT_TRUE(CSTL_deque_copy_push_front(&cstl_deque, type, &copy, &value, alloc)) << "must return true on success";
+            break;
+        case 4:
+            if (!real_deque.empty()) {
+                real_deque.pop_back();
+                CSTL_deque_pop_back(&cstl_deque, type, &copy.move_type.drop_type);
+            }
+            break;
+        case 5:
+            if (!real_deque.empty()) {
+                real_deque.pop_front();
+                CSTL_deque_pop_front(&cstl_deque, type, &copy.move_type.drop_type);
+            }
+            break;
+        }
+
+        if (i % 1000 == 0) {
+            deque_assert_equal();
+        }
+    }
+
+    deque_assert_equal();
+
+    EXPECT_EQ(real_deque.front(), *static_cast<std::string*>(CSTL_deque_front(&cstl_deque, type))) << "fronts must match";
+    EXPECT_EQ(real_deque.back(), *static_cast<std::string*>(CSTL_deque_back(&cstl_deque, type))) << "backs must match";
+    EXPECT_EQ(nullptr, CSTL_deque_at(&cstl_deque, type, real_deque.size())) << "must be bounds checked";
+
+    CSTL_deque_clear(&cstl_deque, type, &copy.move_type.drop_type, alloc);
+    real_deque.clear();
+
+    EXPECT_EQ(nullptr, cstl_deque.map) << "clear must free the map";
+
+    deque_assert_equal();
+}
+
+TEST_F(DequeTest, Swap) {
+    std::string value = "value";
+
+    CSTL_DequeVal other;
+    ASSERT_TRUE(CSTL_deque_construct(&other, alloc)) << "must return true on success";
+    ASSERT_TRUE(CSTL_deque_copy_push_back(&other, type, &copy, &value, alloc)) << "must return true on success";
+
+    CSTL_deque_swap(&cstl_deque, &other);
+    real_deque.push_back(value);
+
+    EXPECT_EQ(&cstl_deque, cstl_deque.proxy->cont) << "proxy must point to its deque";
+    EXPECT_EQ(&other, other.proxy->cont) << "proxy must point to its deque";
+
+    deque_assert_equal();
+
+    CSTL_deque_destroy(&other, type, &copy.move_type.drop_type, alloc);
+}
+
+TEST_F(DequeTest, Ranges) {
+    std::vector<std::string> values;
+
+    for (size_t i = 0; i < 1000; ++i) {
+        values.push_back(std::to_string(i) + " is a reasonably long string");
+    }
+
+    // Start off-center, so that the range wraps around the map.
+    for (size_t i = 0; i < 5; ++i) {
+        real_deque.push_front(values[i]);
+        CSTL_deque_copy_push_front(&cstl_deque, type, &copy, &values[i], alloc);
+    }
+
+    real_deque.insert(real_deque.end(), values.begin(), values.end());
+
+    ASSERT_TRUE(CSTL_deque_copy_append_range(&cstl_deque, type, &copy, values.data(), values.data() + values.size(), alloc))
+        << "must return true on success";
+
+    deque_assert_equal();
+
+    std::vector<std::string> taken(300);
+    std::destroy(taken.begin(), taken.end());
+
+    CSTL_deque_move_take_front(&cstl_deque, type, &copy.move_type, taken.size(), taken.data());
+
+    for (size_t i = 0; i < taken.size(); ++i) {
+        ASSERT_EQ(real_deque.front(), taken[i]) << "must take elements in order";
+        real_deque.pop_front();
+    }
+
+    deque_assert_equal();
+
+    CSTL_deque_consume_front(&cstl_deque, type, &copy.move_type.drop_type, 500);
+    real_deque.erase(real_deque.begin(), real_deque.begin() + 500);
+
+    deque_assert_equal();
+}
+
+TEST(DequePodTest, Spans) {
+    CSTL_PodType pod = CSTL_pod_uint32;
+
+    CSTL_DequeVal cstl_deque;
+    ASSERT_TRUE(CSTL_deque_construct(&cstl_deque, nullptr)) << "must return true on success";
+
+    std::deque<uint32_t> real_deque;
+    std::mt19937 rng{1};
+
+    uint32_t produced = 0;
+
+    // A FIFO queue that produces and consumes in spans of random length.
+    for (size_t round = 0; round < 10000; ++round) {
+        size_t produce = rng() % 8;
+
+        while (produce != 0) {
+            size_t count = 0;
+            auto span    = static_cast<uint32_t*>(CSTL_deque_back_span(&cstl_deque, pod.type, &count, nullptr));
+
+            ASSERT_NE(nullptr, span) << "must return storage on success";
+            ASSERT_LE(1, count) << "must return room for at least one element";
+            ASSERT_GE(CSTL_deque_block_size(pod.type), count) << "span must not exceed a block";
+
+            size_t n = count < produce ? count : produce;
+
+            for (size_t i = 0; i < n; ++i) {
+                span[i] = produced;
+                real_deque.push_back(produced++);
+            }
+
+            CSTL_deque_commit_back(&cstl_deque, pod.type, n);
+            produce -= n;
+        }
+
+        size_t consume = rng() % 8;
+
+        while (consume != 0 && !real_deque.empty()) {
+            size_t count = 0;
+            auto span    = static_cast<uint32_t*>(CSTL_deque_front_span(&cstl_deque, pod.type, &count));
+
+            ASSERT_NE(nullptr, span) << "non-empty deque must return a span";
+
+            size_t n = count < consume ? count : consume;
+
+            for (size_t i = 0; i < n; ++i) {
+                ASSERT_EQ(real_deque.front(), span[i]) << "must consume elements in order";
+                real_deque.pop_front();
+            }
+
+            CSTL_deque_consume_front(&cstl_deque, pod.type, &pod.copy.move_type.drop_type, n);
+            consume -= n;
+        }
+
+        ASSERT_EQ(real_deque.size(), CSTL_deque_size(&cstl_deque)) << "sizes must match";
+    }
+
+    size_t count = 0;
+
+    CSTL_deque_clear(&cstl_deque, pod.type, &pod.copy.move_type.drop_type, nullptr);
+
+    EXPECT_EQ(nullptr, CSTL_deque_front_span(&cstl_deque, pod.type, &count)) << "empty deque must not return a span";
+    EXPECT_EQ(0, count) << "empty deque must not return a span";
+
+    CSTL_deque_destroy(&cstl_deque, pod.type, &pod.copy.move_type.drop_type, nullptr);
+}
+
+TEST(DequePodTest, PushPop) {
+    CSTL_PodType pod = CSTL_pod_uint16;
+
+    CSTL_DequeVal cstl_deque;
+    ASSERT_TRUE(CSTL_deque_construct(&cstl_deque, nullptr)) << "must return true on success";
+
+    std::deque<uint16_t> real_deque;
+    std::mt19937 rng{2};
+
+    // Growing at both ends wraps the blocks around the map before it grows.
+    for (uint16_t i = 0; i < 30000; ++i) {
+        switch (rng() % 5) {
+        case 0:
+        case 1:
+            real_deque.push_back(i);
+            ASSERT_TRUE(CSTL_deque_copy_push_back(&cstl_deque, pod.type, &pod.copy, &i, nullptr)) << "must return true on success";
+            break;
+        case 2:
+        case 3:
+            real_deque.push_front(i);
+            ASSERT_TRUE(CSTL_deque_copy_push_front(&cstl_deque, pod.type, &pod.copy, &i, nullptr)) << "must return true on success";
+            break;
+        case 4:
+            if (!real_deque.empty()) {
+                real_deque.pop_front();
+                CSTL_deque_pop_front(&cstl_deque, pod.type, &pod.copy.move_type.drop_type);
+            }
+            break;
+        }
+    }
+
+    ASSERT_EQ(real_deque.size(), CSTL_deque_size(&cstl_deque)) << "sizes must match";
+
+    for (size_t i = 0; i < real_deque.size(); ++i) {
+        ASSERT_EQ(real_deque[i], *static_cast<const uint16_t*>(CSTL_deque_const_index(&cstl_deque, pod.type, i)))
+            << "elements must match; index=" << i;
+    }
+
+    CSTL_deque_destroy(&cstl_deque, pod.type, &pod.copy.move_type.drop_type, nullptr);
+}
@@ -0,0 +1,409 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <random>
+#include <string>
+
+#include "alloc.h"
+#include "list.h"
+#include "node_pool.h"
+#include "type.h"
+
+namespace {
+
+void destroy_string(void* first, void* last) {
+    std::destroy(static_cast<std::string*>(first), static_cast<std::string*>(last));
+}
+
+void move_string(void* first, void* last, void* dest) {
+    std::uninitialized_move(static_cast<std::string*>(first), static_cast<std::string*>(last), static_cast<std::string*>(dest));
+}
+
+void copy_string(const void* first, const void* last, void* dest) {
+    std::uninitialized_copy(static_cast<const std::string*>(first), static_cast<const std::string*>(last), static_cast<std::string*>(dest));
+}
+
+bool string_eq(const void* lhs, const void* rhs) {
+    return *static_cast<const std::string*>(lhs) == *static_cast<const std::string*>(rhs);
+}
+
+// Compares the first character only, so that stability is observable.
+bool string_first_lt(const void* lhs, const void* rhs) {
+    return static_cast<const std::string*>(lhs)->front() < static_cast<const std::string*>(rhs)->front();
+}
+
+bool first_lt(const std::string& lhs, const std::string& rhs) {
+    return lhs.front() < rhs.front();
+}
+
+std::string make_value(std::mt19937_64& rng, size_t i) {
+    return std::string(1, (char)('a' + rng() % 8)) + std::to_string(i) + " is a reasonably long string";
+}
+
+} // namespace
+
+class ListTest : public testing::Test {
+protected:
+    ListTest() : cstl_list{}, copy{}, comp{}, alloc{nullptr}, type{} {}
+
+    ~ListTest() {
+        if (cstl_list.head != nullptr) {
+            CSTL_list_destroy(&cstl_list, type, &copy.move_type.drop_type, alloc);
+        }
+    }
+
+    void SetUp() override {
+        type = CSTL_define_type(sizeof(std::string), alignof(std::string));
+
+        ASSERT_NE(nullptr, type);
+
+        copy = { { { &destroy_string }, &move_string, false }, &copy_string, nullptr };
+        comp = { &string_eq, &string_first_lt };
+
+        ASSERT_TRUE(CSTL_list_construct(&cstl_list, type, alloc)) << "must return true on success";
+    }
+
+    void list_assert_equal(const std::list<std::string>& real, CSTL_ListCRef instance) {
+        ASSERT_EQ(real.size(), CSTL_list_size(instance)) << "sizes must match";
+
+        CSTL_ListIter it  = CSTL_list_begin(instance, type);
+        CSTL_ListIter end = CSTL_list_end(instance, type);
+        size_t i          = 0;
+
+        for (const auto& value : real) {
+            ASSERT_FALSE(CSTL_list_iterator_eq(it, end)) << "must not end early; index=" << i;
+            ASSERT_EQ(value, *static_cast<std::string*>(CSTL_list_iterator_deref(it))) << "elements must match; index=" << i;
+            ASSERT_EQ(it.node, it.node->next->prev) << "links must be consistent; index=" << i;
+
+            it = CSTL_list_iterator_next(it);
+            ++i;
+        }
+
+        ASSERT_TRUE(CSTL_list_iterator_eq(it, end)) << "must end after the last element";
+        ASSERT_EQ(end.node, end.node->next->prev) << "links must be consistent";
+    }
+
+    CSTL_ListIter list_at(CSTL_ListCRef instance, size_t pos) {
+        CSTL_ListIter it = CSTL_list_begin(instance, type);
+
+        for (size_t i = 0; i < pos; ++i) {
+            it = CSTL_list_iterator_next(it);
+        }
+
+        return it;
+    }
+
+    void fill(std::list<std::string>& real, CSTL_ListRef instance, std::mt19937_64& rng, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            std::string value = make_value(rng, i);
+            real.push_back(value);
+            ASSERT_TRUE(CSTL_list_copy_push_back(instance, type, &copy, &value, alloc)) << "must return true on success";
+        }
+    }
+
+    std::list<std::string> real_list;
+
+    CSTL_ListVal cstl_list;
+    CSTL_CopyType copy;
+    CSTL_CompType comp;
+    CSTL_Alloc* alloc;
+    CSTL_Type type;
+};
+
+TEST_F(ListTest, Layout) {
+    if constexpr (sizeof(void*) == 8) {
+        EXPECT_EQ(16, sizeof(CSTL_ListVal)) << "must match the size of `std::list`";
+        EXPECT_EQ(48, CSTL_list_node_size(type)) << "must match the size of `std::_List_node`";
+    }
+
+    EXPECT_EQ(sizeof(void*), CSTL_list_node_alignment(CSTL_pod_uint8.type)) << "nodes must be pointer aligned";
+    EXPECT_EQ(cstl_list.head, cstl_list.head->next) << "empty list must link the head to itself";
+    EXPECT_EQ(cstl_list.head, cstl_list.head->prev) << "empty list must link the head to itself";
+}
+
+TEST_F(ListTest, InsertErase) {
+    std::mt19937_64 rng{42};
+
+    for (size_t i = 0; i < 20000; ++i) {
+        std::string value = make_value(rng, i);
+
+        switch (rng() % 7) {
+        case 0:
+            real_list.push_back(value);
+            ASSERT_TRUE(CSTL_list_copy_push_back(&cstl_list, type, &copy, &value, alloc)) << "must return true on success";
+            break;
+        case 1:
+            real_list.push_front(value);
+            ASSERT_TRUE(CSTL_list_move_push_front(&cstl_list, type, &copy.move_type, &value, alloc)) << "must return true on success";
+            break;
+        case 2:
+        case 3: {
+            size_t pos   = real_list.empty() ? 0 : rng() % (real_list.size() + 1);
+            auto real_it = std::next(real_list.begin(), (ptrdiff_t)pos);
+            auto it      = list_at(&cstl_list, pos);
+
+            real_it = real_list.insert(real_it, value);
+            it      = CSTL_list_copy_insert(&cstl_list, type, &copy, it, &value, alloc);
+
+            ASSERT_EQ(*real_it, *static_cast<std::string*>(CSTL_list_iterator_deref(it))) << "must return the inserted element";
+            break;
+        }
+        case 4:
+            if (!real_list.empty()) {
+                size_t pos   = rng() % real_list.size();
+                auto real_it = real_list.erase(std::next(real_list.begin(), (ptrdiff_t)pos));
+                auto it      = list_at(&cstl_list, pos);
+
+                it = CSTL_list_erase(&cstl_list, type, &copy.move_type.drop_type, it, alloc);
+
+                if (real_it == real_list.end()) {
+                    ASSERT_TRUE(CSTL_list_iterator_eq(CSTL_list_end(&cstl_list, type), it)) << "must return the next element";
+                } else {
+                    ASSERT_EQ(*real_it, *static_cast<std::string*>(CSTL_list_iterator_deref(it))) << "must return the next element";
+                }
+            }
+            break;
+        case 5:
+            if (!real_list.empty()) {
+                real_list.pop_back();
+                CSTL_list_pop_back(&cstl_list, type, &copy.move_type.drop_type, alloc);
+            }
+            break;
+        case 6:
+            if (!real_list.empty()) {
+                real_list.pop_front();
+                CSTL_list_pop_front(&cstl_list, type, &copy.move_type.drop_type, alloc);
+            }
+            break;
+        }
+
+        if (i % 1000 == 0) {
+            list_assert_equal(real_list, &cstl_list);
+        }
+    }
+
+    list_assert_equal(real_list, &cstl_list);
+
+    EXPECT_EQ(real_list.front(), *static_cast<std::string*>(CSTL_list_front(&cstl_list, type))) << "fronts must match";
+    EXPECT_EQ(real_list.back(), *static_cast<std::string*>(CSTL_list_back(&cstl_list, type))) << "backs must match";
+
+    CSTL_list_clear(&cstl_list, type, &copy.move_type.drop_type, alloc);
+    real_list.clear();
+
+    list_assert_equal(real_list, &cstl_list);
+}
+
+TEST_F(ListTest, Splice) {
+    std::mt19937_64 rng{1};
+
+    std::list<std::string> real_other;
+    CSTL_ListVal other;
+    ASSERT_TRUE(CSTL_list_construct(&other, type, alloc)) << "must return true on success";
+
+    fill(real_list, &cstl_list, rng, 50);
+    fill(real_other, &other, rng, 30);
+
+    // Whole list into the middle.
+    real_list.splice(std::next(real_list.begin(), 10), real_other);
+    CSTL_list_splice(&cstl_list, list_at(&cstl_list, 10), &other);
+
+    list_assert_equal(real_list, &cstl_list);
+    list_assert_equal(real_other, &other);
+
+    fill(real_other, &other, rng, 30);
+
+    list_assert_equal(real_list, &cstl_list);
+    list_assert_equal(real_other, &other);
+
+    // Single elements back and forth, and within one list.
+    for (size_t i = 0; i < 200; ++i) {
+        size_t from = rng() % real_list.size();
+        size_t to   = rng() % (real_other.size() + 1);
+
+        auto real_from = std::next(real_list.begin(), (ptrdiff_t)from);
+        auto real_to   = std::next(real_other.begin(), (ptrdiff_t)to);
+        auto it_from   = list_at(&cstl_list, from);
+        auto it_to     = list_at(&other, to);
+
+        if (i % 2 == 0) {
+            real_other.splice(real_to, real_list, real_from);
+            CSTL_list_splice_one(&other, it_to, &cstl_list, it_from);
+
+            real_list.splice(real_list.end(), real_other, real_other.begin());
+            CSTL_list_splice_one(&cstl_list, CSTL_list_end(&cstl_list, type), &other, CSTL_list_begin(&other, type));
+        } else {
+            real_list.splice(real_list.begin(), real_list, real_from);
+            CSTL_list_splice_one(&cstl_list, CSTL_list_begin(&cstl_list, type), &cstl_list, it_from);
+        }
+    }
+
+    list_assert_equal(real_list, &cstl_list);
+    list_assert_equal(real_other, &other);
+
+    // Ranges between lists and within one list.
+    for (size_t i = 0; i < 100; ++i) {
+        size_t first = rng() % (real_list.size() + 1);
+        size_t last  = first + rng() % (real_list.size() - first + 1);
+        size_t to    = rng() % (real_other.size() + 1);
+
+        auto it_first = list_at(&cstl_list, first);
+        auto it_last  = list_at(&cstl_list, last);
+        auto it_to    = list_at(&other, to);
+
+        real_other.splice(std::next(real_other.begin(), (ptrdiff_t)to), real_list,
+            std::next(real_list.begin(), (ptrdiff_t)first), std::next(real_list.begin(), (ptrdiff_t)last));
+        CSTL_list_splice_range(&other, it_to, &cstl_list, it_first, it_last);
+
+        // Rotate the other list by moving its tail to the front.
+        if (real_other.size() > 1) {
+            size_t mid  = 1 + rng() % (real_other.size() - 1);
+            auto it_mid = list_at(&other, mid);
+
+            real_other.splice(real_other.begin(), real_other, std::next(real_other.begin(), (ptrdiff_t)mid), real_other.end());
+            CSTL_list_splice_range(&other, CSTL_list_begin(&other, type), &other, it_mid, CSTL_list_end(&other, type));
+        }
+
+        std::swap(real_list, real_other);
+        CSTL_list_swap(&cstl_list, &other);
+
+        list_assert_equal(real_list, &cstl_list);
+        list_assert_equal(real_other, &other);
+    }
+
+    CSTL_list_destroy(&other, type, &copy.move_type.drop_type, alloc);
+}
+
+TEST_F(ListTest, MergeSort) {
+    std::mt19937_64 rng{2};
+
+    for (size_t size : { 0, 1, 2, 3, 17, 1000, 5000 }) {
+        real_list.clear();
+        CSTL_list_clear(&cstl_list, type, &copy.move_type.drop_type, alloc);
+
+        fill(real_list, &cstl_list, rng, size);
+
+        // Few distinct keys, so that a stability failure would show.
+        real_list.sort(&first_lt);
+        CSTL_list_sort(&cstl_list, type, &comp);
+
+        list_assert_equal(real_list, &cstl_list);
+    }
+
+    std::list<std::string> real_other;
+    CSTL_ListVal other;
+    ASSERT_TRUE(CSTL_list_construct(&other, type, alloc)) << "must return true on success";
+
+    fill(real_other, &other, rng, 3000);
+
+    real_other.sort(&first_lt);
+    CSTL_list_sort(&other, type, &comp);
+
+    real_list.merge(real_other, &first_lt);
+    CSTL_list_merge(&cstl_list, &other, type, &comp);
+
+    list_assert_equal(real_list, &cstl_list);
+    list_assert_equal(real_other, &other);
+
+    // Merging into an empty list.
+    fill(real_other, &other, rng, 10);
+    CSTL_list_swap(&cstl_list, &other);
+    std::swap(real_list, real_other);
+
+    real_other.clear();
+    CSTL_list_clear(&other, type, &copy.move_type.drop_type, alloc);
+
+    real_list.sort(&first_lt);
+    CSTL_list_sort(&cstl_list, type, &comp);
+
+    real_other.merge(real_list, &first_lt);
+    CSTL_list_merge(&other, &cstl_list, type, &comp);
+
+    list_assert_equal(real_list, &cstl_list);
+    list_assert_equal(real_other, &other);
+
+    CSTL_list_destroy(&other, type, &copy.move_type.drop_type, alloc);
+}
+
+TEST(ListPoolTest, SharedPool) {
+    CSTL_PodType pod = CSTL_pod_uint64;
+
+    CSTL_NodePool pool;
+    CSTL_node_pool_construct(&pool, CSTL_list_node_size(pod.type), CSTL_list_node_alignment(pod.type), nullptr);
+
+    CSTL_ListVal lists[2];
+    std::list<uint64_t> real_lists[2];
+
+    for (auto& list : lists) {
+        ASSERT_TRUE(CSTL_list_construct(&list, pod.type, &pool.alloc)) << "must return true on success";
+    }
+
+    EXPECT_EQ(2, CSTL_node_pool_stats(&pool).used) << "head nodes must come from the pool";
+
+    std::mt19937_64 rng{3};
+
+    // An LRU-like pattern: push at the back, evict from the front, splice hits to the back.
+    for (uint64_t i = 0; i < 20000; ++i) {
+        size_t which = rng() % 2;
+        auto& list   = lists[which];
+        auto& real   = real_lists[which];
+
+        ASSERT_TRUE(CSTL_list_copy_push_back(&list, pod.type, &pod.copy, &i, &pool.alloc)) << "must return true on success";
+        real.push_back(i);
+
+        if (real.size() > 64) {
+            CSTL_list_pop_front(&list, pod.type, &pod.copy.move_type.drop_type, &pool.alloc);
+            real.pop_front();
+        }
+
+        if (real.size() > 1) {
+            CSTL_list_splice_one(&list, CSTL_list_end(&list, pod.type), &list, CSTL_list_begin(&list, pod.type));
+            real.splice(real.end(), real, real.begin());
+        }
+    }
+
+    CSTL_NodePoolStats stats = CSTL_node_pool_stats(&pool);
+
+    EXPECT_EQ(2 + real_lists[0].size() + real_lists[1].size(), stats.used) << "must count nodes in use";
+    EXPECT_GE(256, stats.reserved) << "freed nodes must be reused";
+
+    for (size_t which = 0; which < 2; ++which) {
+        ASSERT_EQ(real_lists[which].size(), CSTL_list_size(&lists[which])) << "sizes must match";
+
+        auto it = CSTL_list_begin(&lists[which], pod.type);
+
+        for (uint64_t value : real_lists[which]) {
+            ASSERT_EQ(value, *static_cast<uint64_t*>(CSTL_list_iterator_deref(it))) << "elements must match";
+            it = CSTL_list_iterator_next(it);
+        }
+
+        CSTL_list_destroy(&lists[which], pod.type, &pod.copy.move_type.drop_type, &pool.alloc);
+    }
+
+    EXPECT_EQ(0, CSTL_node_pool_stats(&pool).used) << "all nodes must be returned";
+
+    CSTL_node_pool_destroy(&pool);
+}
+
+TEST(ListPoolTest, ConstructFailure) {
+    CSTL_PodType pod = CSTL_pod_uint64;
+    CSTL_Alloc failing_alloc = {
+        nullptr,
+        [](void*, size_t, size_t) -> void* { return nullptr; },
+        [](void*, void*, size_t, size_t) {},
+        nullptr, nullptr
+    };
+
+    CSTL_ListVal list;
+    std::memset(&list, 0xAB, sizeof(list));
+
+    EXPECT_FALSE(CSTL_list_construct(&list, pod.type, &failing_alloc)) << "must return false when the allocation fails";
+    EXPECT_EQ(nullptr, list.head) << "must not leave the head uninitialized";
+
+    // Destroying a list that failed to construct must be harmless.
+    CSTL_list_destroy(&list, pod.type, &pod.copy.move_type.drop_type, &failing_alloc);
+}
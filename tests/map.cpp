@@ -0,0 +1,514 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "alloc.h"
+#include "map.h"
+#include "set.h"
+#include "type.h"
+
+namespace {
+
+using Entry = std::pair<const uint64_t, std::string>;
+
+void destroy_entry(void* first, void* last) {
+    std::destroy(static_cast<Entry*>(first), static_cast<Entry*>(last));
+}
+
+void move_entry(void* first, void* last, void* dest) {
+    std::uninitialized_move(static_cast<Entry*>(first), static_cast<Entry*>(last), static_cast<Entry*>(dest));
+}
+
+void copy_entry(const void* first, const void* last, void* dest) {
+    std::uninitialized_copy(static_cast<const Entry*>(first), static_cast<const Entry*>(last), static_cast<Entry*>(dest));
+}
+
+bool key_eq(const void* lhs, const void* rhs) {
+    return *static_cast<const uint64_t*>(lhs) == *static_cast<const uint64_t*>(rhs);
+}
+
+bool key_lt(const void* lhs, const void* rhs) {
+    return *static_cast<const uint64_t*>(lhs) < *static_cast<const uint64_t*>(rhs);
+}
+
+uint64_t key_of(CSTL_TreeIter where) {
+    return static_cast<Entry*>(CSTL_tree_iterator_deref(where))->first;
+}
+
+} // namespace
+
+class MapTest : public testing::Test {
+protected:
+    MapTest() : cstl_map{}, copy{}, comp{}, alloc{nullptr}, type{} {}
+
+    ~MapTest() {
+        CSTL_tree_destroy(&cstl_map, type, &copy.move_type.drop_type, alloc);
+    }
+
+    void SetUp() override {
+        type = CSTL_define_type(sizeof(Entry), alignof(Entry));
+
+        ASSERT_NE(nullptr, type);
+
+        copy = { { { &destroy_entry }, &move_entry, false }, &copy_entry, nullptr };
+        comp = { &key_eq, &key_lt };
+
+        ASSERT_TRUE(CSTL_tree_construct(&cstl_map, type, alloc)) << "must return true on success";
+    }
+
+    // Returns the black height of the subtree at `node`.
+    size_t subtree_assert_valid(CSTL_TreeNode* node, size_t& size) {
+        auto head = cstl_map.head;
+
+        if (node == head) {
+            return 1;
+        }
+
+        size += 1;
+
+        EXPECT_EQ(0, node->is_nil) << "only the head may be nil";
+        EXPECT_TRUE(node->left == head || node->left->parent == node) << "left child must link back";
+        EXPECT_TRUE(node->right == head || node->right->parent == node) << "right child must link back";
+
+        if (node->color == 0) {
+            EXPECT_EQ(1, node->left->color) << "red nodes must have black children";
+            EXPECT_EQ(1, node->right->color) << "red nodes must have black children";
+        }
+
+        size_t left_height  = subtree_assert_valid(node->left, size);
+        size_t right_height = subtree_assert_valid(node->right, size);
+
+        EXPECT_EQ(left_height, right_height) << "black heights must match";
+
+        return left_height + node->color;
+    }
+
+    // Checks the red-black and head invariants that MSVC code relies on.
+    void map_assert_valid() {
+        auto head = cstl_map.head;
+
+        ASSERT_EQ(1, head->is_nil) << "head must be nil";
+        ASSERT_EQ(1, head->color) << "head must be black";
+
+        size_t size = 0;
+
+        if (head->parent == head) {
+            ASSERT_EQ(head, head->left) << "empty tree must point to the head";
+            ASSERT_EQ(head, head->right) << "empty tree must point to the head";
+        } else {
+            ASSERT_EQ(head, head->parent->parent) << "root must link back to the head";
+            ASSERT_EQ(1, head->parent->color) << "root must be black";
+
+            auto min = head->parent;
+            auto max = head->parent;
+
+            while (min->left != head) {
+                min = min->left;
+            }
+
+            while (max->right != head) {
+                max = max->right;
+            }
+
+            ASSERT_EQ(min, head->left) << "head must point to the smallest element";
+            ASSERT_EQ(max, head->right) << "head must point to the largest element";
+        }
+
+        subtree_assert_valid(head->parent, size);
+
+        ASSERT_EQ(size, CSTL_tree_size(&cstl_map)) << "size must match the tree";
+    }
+
+    void map_assert_equal() {
+        ASSERT_EQ(real_map.size(), CSTL_tree_size(&cstl_map)) << "sizes must match";
+
+        CSTL_TreeIter where = CSTL_tree_begin(&cstl_map, type);
+
+        for (const auto& [key, value] : real_map) {
+            ASSERT_FALSE(CSTL_tree_iterator_eq(where, CSTL_tree_end(&cstl_map, type))) << "must not end early";
+            ASSERT_EQ(key, key_of(where)) << "keys must be in order";
+            EXPECT_EQ(value, static_cast<Entry*>(CSTL_tree_iterator_deref(where))->second)
+                << "values must match; key=" << key;
+
+            where = CSTL_tree_iterator_next(where);
+        }
+
+        EXPECT_TRUE(CSTL_tree_iterator_eq(where, CSTL_tree_end(&cstl_map, type))) << "must end after the last element";
+    }
+
+    std::map<uint64_t, std::string> real_map;
+
+    CSTL_MapVal cstl_map;
+    CSTL_CopyType copy;
+    CSTL_CompType comp;
+    CSTL_Alloc* alloc;
+    CSTL_Type type;
+};
+
+TEST_F(MapTest, Layout) {
+    if constexpr (sizeof(void*) == 8) {
+        EXPECT_EQ(16, sizeof(CSTL_MapVal)) << "must match the size of `std::map`";
+        EXPECT_EQ(24, offsetof(CSTL_TreeNode, color)) << "color must follow the links";
+        EXPECT_EQ(25, offsetof(CSTL_TreeNode, is_nil)) << "nil flag must follow the color";
+    }
+
+    Entry value{1, "one"};
+    CSTL_TreeIter where = CSTL_tree_copy_insert(&cstl_map, type, &comp, &copy, &value, nullptr, alloc);
+
+    auto offset_of = [](CSTL_TreeIter where) {
+        return static_cast<char*>(CSTL_tree_iterator_deref(where)) - reinterpret_cast<char*>(where.node);
+    };
+
+    if constexpr (sizeof(void*) == 8) {
+        EXPECT_EQ(32, offset_of(where)) << "element must be aligned after the nil flag";
+    }
+
+    uint8_t key = 1;
+    CSTL_PodType pod = CSTL_pod_uint8;
+    CSTL_CompType byte_comp = {
+        [](const void* lhs, const void* rhs) { return *(const uint8_t*)lhs == *(const uint8_t*)rhs; },
+        [](const void* lhs, const void* rhs) { return *(const uint8_t*)lhs < *(const uint8_t*)rhs; }
+    };
+
+    CSTL_SetVal cstl_set;
+    ASSERT_TRUE(CSTL_tree_construct(&cstl_set, pod.type, nullptr)) << "must return true on success";
+
+    where = CSTL_tree_copy_insert(&cstl_set, pod.type, &byte_comp, &pod.copy, &key, nullptr, nullptr);
+
+    EXPECT_EQ(offsetof(CSTL_TreeNode, is_nil) + 1, (size_t)offset_of(where)) << "element must directly follow the nil flag";
+
+    CSTL_tree_destroy(&cstl_set, pod.type, &pod.copy.move_type.drop_type, nullptr);
+}
+
+TEST_F(MapTest, Default) {
+    EXPECT_TRUE(CSTL_tree_empty(&cstl_map)) << "must be empty";
+    EXPECT_TRUE(CSTL_tree_iterator_eq(CSTL_tree_begin(&cstl_map, type), CSTL_tree_end(&cstl_map, type)))
+        << "begin must equal end";
+
+    map_assert_valid();
+}
+
+TEST_F(MapTest, InsertFindErase) {
+    std::mt19937_64 rng{42};
+
+    for (size_t i = 0; i < 20000; ++i) {
+        uint64_t key = rng() % 5000;
+        Entry value{key, std::to_string(key) + " is a reasonably long string"};
+
+        if (rng() % 4 != 0) {
+            bool inserted = false;
+            bool expected = real_map.emplace(value).second;
+
+            CSTL_TreeIter where = CSTL_tree_copy_insert(&cstl_map, type, &comp, &copy, &value, &inserted, alloc);
+
+            ASSERT_EQ(expected, inserted) << "must insert only new keys; key=" << key;
+            ASSERT_EQ(key, key_of(where)) << "must return the element with the key";
+        } else {
+            ASSERT_EQ(real_map.erase(key), CSTL_tree_erase_key(&cstl_map, type, &comp, &copy.move_type.drop_type, &key, alloc))
+                << "must erase only existing keys; key=" << key;
+        }
+
+        if (i % 1000 == 0) {
+            map_assert_valid();
+        }
+    }
+
+    map_assert_valid();
+    map_assert_equal();
+
+    for (uint64_t key = 0; key < 5000; ++key) {
+        EXPECT_EQ(real_map.count(key) != 0, CSTL_tree_contains(&cstl_map, type, &comp, &key))
+            << "membership must match; key=" << key;
+    }
+
+    for (CSTL_TreeIter where = CSTL_tree_begin(&cstl_map, type); !CSTL_tree_iterator_eq(where, CSTL_tree_end(&cstl_map, type));) {
+        uint64_t key = key_of(where);
+
+        if (key % 3 == 0) {
+            auto next = real_map.erase(real_map.find(key));
+            where     = CSTL_tree_erase(&cstl_map, type, &copy.move_type.drop_type, where, alloc);
+
+            ASSERT_EQ(next == real_map.end(), CSTL_tree_iterator_eq(where, CSTL_tree_end(&cstl_map, type)))
+                << "must return the next element";
+        } else {
+            where = CSTL_tree_iterator_next(where);
+        }
+    }
+
+    map_assert_valid();
+    map_assert_equal();
+
+    CSTL_tree_clear(&cstl_map, type, &copy.move_type.drop_type, alloc);
+    real_map.clear();
+
+    map_assert_valid();
+}
+
+TEST_F(MapTest, MoveInsert) {
+    Entry value{7, std::string(100, 'x')};
+
+    bool inserted = false;
+    CSTL_TreeIter where = CSTL_tree_move_insert(&cstl_map, type, &comp, &copy.move_type, &value, &inserted, alloc);
+
+    EXPECT_TRUE(inserted) << "must insert a new key";
+    EXPECT_EQ(std::string(100, 'x'), static_cast<Entry*>(CSTL_tree_iterator_deref(where))->second)
+        << "value must be moved in";
+    EXPECT_TRUE(value.second.empty()) << "source must be moved from";
+}
+
+TEST_F(MapTest, Bounds) {
+    for (uint64_t key = 10; key < 1000; key += 10) {
+        Entry value{key, std::to_string(key)};
+        real_map.emplace(value);
+        CSTL_tree_copy_insert(&cstl_map, type, &comp, &copy, &value, nullptr, alloc);
+    }
+
+    CSTL_TreeIter end = CSTL_tree_end(&cstl_map, type);
+
+    for (uint64_t key = 0; key < 1010; ++key) {
+        auto real_lower = real_map.lower_bound(key);
+        auto real_upper = real_map.upper_bound(key);
+
+        CSTL_TreeIter lower  = CSTL_tree_lower_bound(&cstl_map, type, &comp, &key);
+        CSTL_TreeIter upper  = CSTL_tree_upper_bound(&cstl_map, type, &comp, &key);
+        CSTL_TreeRange range = CSTL_tree_equal_range(&cstl_map, type, &comp, &key);
+
+        ASSERT_EQ(real_lower == real_map.end(), CSTL_tree_iterator_eq(lower, end)) << "lower bounds must match; key=" << key;
+        ASSERT_EQ(real_upper == real_map.end(), CSTL_tree_iterator_eq(upper, end)) << "upper bounds must match; key=" << key;
+
+        if (real_lower != real_map.end()) {
+            EXPECT_EQ(real_lower->first, key_of(lower)) << "lower bounds must match; key=" << key;
+        }
+
+        if (real_upper != real_map.end()) {
+            EXPECT_EQ(real_upper->first, key_of(upper)) << "upper bounds must match; key=" << key;
+        }
+
+        EXPECT_TRUE(CSTL_tree_iterator_eq(lower, range.first)) << "range must start at the lower bound";
+        EXPECT_TRUE(CSTL_tree_iterator_eq(upper, range.last)) << "range must end at the upper bound";
+    }
+
+    CSTL_TreeIter where = end;
+
+    for (auto it = real_map.rbegin(); it != real_map.rend(); ++it) {
+        where = CSTL_tree_iterator_prev(where);
+        ASSERT_EQ(it->first, key_of(where)) << "must iterate backwards from the end";
+    }
+
+    EXPECT_TRUE(CSTL_tree_iterator_eq(CSTL_tree_begin(&cstl_map, type), where)) << "must reach the beginning";
+}
+
+TEST_F(MapTest, InsertHint) {
+    // Ascending keys before the end and descending keys before the beginning.
+    for (uint64_t key = 1000; key < 2000; ++key) {
+        Entry value{key, std::to_string(key)};
+        real_map.emplace(value);
+        CSTL_tree_copy_insert_hint(&cstl_map, type, &comp, &copy, CSTL_tree_end(&cstl_map, type), &value, nullptr, alloc);
+    }
+
+    for (uint64_t key = 1000; key-- > 0;) {
+        Entry value{key, std::to_string(key)};
+        real_map.emplace(value);
+        CSTL_tree_copy_insert_hint(&cstl_map, type, &comp, &copy, CSTL_tree_begin(&cstl_map, type), &value, nullptr, alloc);
+    }
+
+    map_assert_valid();
+    map_assert_equal();
+
+    std::mt19937_64 rng{7};
+
+    // Right and wrong hints alike must insert at the right place.
+    for (size_t i = 0; i < 5000; ++i) {
+        uint64_t key  = rng() % 4000;
+        uint64_t near = rng() % 4000;
+
+        Entry value{key, std::to_string(key)};
+
+        CSTL_TreeIter hint = CSTL_tree_lower_bound(&cstl_map, type, &comp, &near);
+
+        bool inserted = false;
+        bool expected = real_map.emplace(value).second;
+
+        CSTL_TreeIter where = rng() % 2 == 0
+            ? CSTL_tree_copy_insert_hint(&cstl_map, type, &comp, &copy, hint, &value, &inserted, alloc)
+            : CSTL_tree_move_insert_hint(&cstl_map, type, &comp, &copy.move_type, hint, &value, &inserted, alloc);
+
+        ASSERT_EQ(expected, inserted) << "must insert only new keys; key=" << key;
+        ASSERT_EQ(key, key_of(where)) << "must return the element with the key";
+    }
+
+    map_assert_valid();
+    map_assert_equal();
+}
+
+TEST_F(MapTest, InsertRange) {
+    std::mt19937_64 rng{3};
+
+    for (size_t count = 0; count <= 100; ++count) {
+        std::vector<uint64_t> keys;
+        std::vector<Entry> values;
+
+        for (size_t i = 0; i < count; ++i) {
+            keys.push_back(rng() % (count + 1));
+        }
+
+        std::sort(keys.begin(), keys.end());
+
+        // Equivalent keys differ in value, only the first one must be inserted.
+        for (size_t i = 0; i < count; ++i) {
+            values.emplace_back(keys[i], std::to_string(keys[i]) + "/" + std::to_string(i));
+        }
+
+        CSTL_tree_clear(&cstl_map, type, &copy.move_type.drop_type, alloc);
+        real_map.clear();
+        real_map.insert(values.begin(), values.end());
+
+        ASSERT_TRUE(CSTL_tree_copy_insert_range(&cstl_map, type, &comp, &copy, values.data(), values.data() + values.size(), alloc))
+            << "must return true on success";
+
+        map_assert_valid();
+        map_assert_equal();
+    }
+
+    std::vector<Entry> values;
+
+    for (uint64_t key = 0; key < 10000; ++key) {
+        values.emplace_back(key * 2, std::to_string(key));
+    }
+
+    CSTL_tree_clear(&cstl_map, type, &copy.move_type.drop_type, alloc);
+    real_map.clear();
+    real_map.insert(values.begin(), values.end());
+
+    ASSERT_TRUE(CSTL_tree_copy_insert_range(&cstl_map, type, &comp, &copy, values.data(), values.data() + values.size(), alloc))
+        << "must return true on success";
+
+    map_assert_valid();
+    map_assert_equal();
+
+    // Into a non-empty tree, and unsorted.
+    std::vector<Entry> more;
+
+    for (uint64_t key = 0; key < 5000; ++key) {
+        uint64_t odd = rng() % 30000;
+        more.emplace_back(odd, std::to_string(odd));
+    }
+
+    real_map.insert(more.begin(), more.end());
+
+    ASSERT_TRUE(CSTL_tree_copy_insert_range(&cstl_map, type, &comp, &copy, more.data(), more.data() + more.size(), alloc))
+        << "must return true on success";
+
+    map_assert_valid();
+    map_assert_equal();
+
+    CSTL_tree_clear(&cstl_map, type, &copy.move_type.drop_type, alloc);
+    real_map.clear();
+    real_map.insert(more.begin(), more.end());
+
+    ASSERT_TRUE(CSTL_tree_copy_insert_range(&cstl_map, type, &comp, &copy, more.data(), more.data() + more.size(), alloc))
+        << "must return true on success";
+
+    map_assert_valid();
+    map_assert_equal();
+}
+
+TEST(SetTest, PodKeys) {
+    CSTL_PodType pod = CSTL_pod_uint32;
+    CSTL_CompType comp = {
+        [](const void* lhs, const void* rhs) { return *(const uint32_t*)lhs == *(const uint32_t*)rhs; },
+        [](const void* lhs, const void* rhs) { return *(const uint32_t*)lhs < *(const uint32_t*)rhs; }
+    };
+
+    CSTL_SetVal cstl_set;
+    ASSERT_TRUE(CSTL_tree_construct(&cstl_set, pod.type, nullptr)) << "must return true on success";
+
+    std::set<uint32_t> real_set;
+
+    for (uint32_t i = 0; i < 10000; ++i) {
+        uint32_t key = i * 37 % 4099;
+
+        bool inserted = false;
+        CSTL_tree_copy_insert(&cstl_set, pod.type, &comp, &pod.copy, &key, &inserted, nullptr);
+
+        ASSERT_EQ(real_set.insert(key).second, inserted) << "must insert only new keys; key=" << key;
+    }
+
+    EXPECT_EQ(real_set.size(), CSTL_tree_size(&cstl_set)) << "sizes must match";
+
+    CSTL_TreeIter where = CSTL_tree_begin(&cstl_set, pod.type);
+
+    for (uint32_t key : real_set) {
+        ASSERT_EQ(key, *static_cast<uint32_t*>(CSTL_tree_iterator_deref(where))) << "keys must be in order";
+        where = CSTL_tree_iterator_next(where);
+    }
+
+    CSTL_tree_destroy(&cstl_set, pod.type, &pod.copy.move_type.drop_type, nullptr);
+}
+
+struct CountdownAlloc {
+    static void* aligned_alloc(void* opaque, size_t size, size_t alignment) {
+        auto self = static_cast<CountdownAlloc*>(opaque);
+
+        if (self->remaining == 0) {
+            return nullptr;
+        }
+
+        self->remaining -= 1;
+        return ::aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1));
+    }
+
+    static void aligned_free(void* opaque, void* memory, size_t size, size_t alignment) {
+        (void)opaque, (void)size, (void)alignment;
+        ::free(memory);
+    }
+
+    size_t remaining;
+};
+
+TEST(SetTest, InsertRangeFailure) {
+    CSTL_PodType pod = CSTL_pod_uint32;
+    CSTL_CompType comp = {
+        [](const void* lhs, const void* rhs) { return *(const uint32_t*)lhs == *(const uint32_t*)rhs; },
+        [](const void* lhs, const void* rhs) { return *(const uint32_t*)lhs < *(const uint32_t*)rhs; }
+    };
+
+    std::vector<uint32_t> keys;
+
+    for (uint32_t i = 0; i < 100; ++i) {
+        keys.push_back(i * 37 % 101);
+    }
+
+    for (bool sorted : {true, false}) {
+        if (sorted) {
+            std::sort(keys.begin(), keys.end());
+        } else {
+            std::reverse(keys.begin(), keys.end());
+        }
+
+        // The head and half of the elements are allocated before the failure.
+        CountdownAlloc countdown{51};
+        CSTL_Alloc alloc = { &countdown, &CountdownAlloc::aligned_alloc, &CountdownAlloc::aligned_free, nullptr, nullptr };
+
+        CSTL_SetVal cstl_set;
+        ASSERT_TRUE(CSTL_tree_construct(&cstl_set, pod.type, &alloc)) << "must return true on success";
+
+        EXPECT_FALSE(CSTL_tree_copy_insert_range(&cstl_set, pod.type, &comp, &pod.copy, keys.data(), keys.data() + keys.size(), &alloc))
+            << "must return false when an allocation fails; sorted=" << sorted;
+        EXPECT_EQ(0, CSTL_tree_size(&cstl_set)) << "an empty tree must be left empty; sorted=" << sorted;
+        EXPECT_TRUE(CSTL_tree_begin(&cstl_set, pod.type).node == CSTL_tree_end(&cstl_set, pod.type).node)
+            << "an empty tree must have no elements; sorted=" << sorted;
+
+        CSTL_tree_destroy(&cstl_set, pod.type, &pod.copy.move_type.drop_type, &alloc);
+    }
+}
@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "alloc.h"
+#include "arena.h"
+#include "mmap_alloc.h"
+#include "type.h"
+#include "vector.h"
+#include "xstring.h"
+
+class MmapAllocTest : public testing::Test {
+protected:
+    MmapAllocTest() : arena{}, mapped{} {
+        CSTL_arena_construct(&arena, 0, 0, nullptr);
+        CSTL_mmap_alloc_construct(&mapped, 64 * 1024, false, &arena.alloc);
+    }
+
+    ~MmapAllocTest() {
+        CSTL_arena_destroy(&arena);
+    }
+
+    CSTL_Arena arena;
+    CSTL_MmapAlloc mapped;
+};
+
+TEST_F(MmapAllocTest, Threshold) {
+    EXPECT_FALSE(CSTL_mmap_alloc_is_mapped(&mapped, 64 * 1024 - 1, 8)) << "small blocks must not be mapped";
+    EXPECT_FALSE(CSTL_mmap_alloc_is_mapped(&mapped, 1 << 20, 1 << 20)) << "over-aligned blocks must not be mapped";
+
+    void* small = CSTL_mmap_alloc_allocate(&mapped, 1000, 16);
+
+    ASSERT_NE(nullptr, small) << "must allocate";
+    EXPECT_EQ(1000, CSTL_arena_stats(&arena).used) << "small blocks must come from the fallback";
+
+    CSTL_mmap_alloc_free(&mapped, small, 1000, 16);
+
+    if (!CSTL_mmap_alloc_is_mapped(&mapped, 64 * 1024, 8)) {
+        GTEST_SKIP() << "mapping is not supported";
+    }
+
+    size_t size = 1000000;
+    auto large  = (unsigned char*)CSTL_mmap_alloc_allocate(&mapped, size, 64);
+
+    ASSERT_NE(nullptr, large) << "must allocate";
+    EXPECT_EQ(0, (uintptr_t)large % 4096) << "mappings must be page-aligned";
+    EXPECT_EQ(0, CSTL_arena_stats(&arena).used) << "large blocks must not come from the fallback";
+
+    memset(large, 0xAB, size);
+
+    CSTL_mmap_alloc_free(&mapped, large, size, 64);
+}
+
+// Returns the `VmFlags` of the mapping containing `address`, or an empty string.
+static std::string vm_flags(const void* address) {
+    std::ifstream smaps("/proc/self/smaps");
+    std::string line;
+    bool found = false;
+
+    while (std::getline(smaps, line)) {
+        uintptr_t first, last;
+        char dash;
+        std::istringstream range(line);
+
+        if (range >> std::hex >> first >> dash >> last && dash == '-') {
+            found = first <= (uintptr_t)address && (uintptr_t)address < last;
+        } else if (found && line.rfind("VmFlags:", 0) == 0) {
+            return line;
+        }
+    }
+
+    return {};
+}
+
+TEST_F(MmapAllocTest, HugePages) {
+    CSTL_MmapAlloc huge;
+    CSTL_mmap_alloc_construct(&huge, 0, true, nullptr);
+
+    size_t size = 5 << 20;
+    auto memory = (unsigned char*)CSTL_mmap_alloc_allocate(&huge, size, 8);
+
+    ASSERT_NE(nullptr, memory) << "must allocate";
+
+#if defined(__linux__)
+    EXPECT_EQ(0, (uintptr_t)memory % (2 << 20)) << "huge page mappings must be aligned to 2 MiB";
+#endif
+
+    memset(memory, 0xCD, size);
+
+    CSTL_mmap_alloc_free(&huge, memory, size, 8);
+}
+
+TEST_F(MmapAllocTest, HugePageGrowth) {
+    CSTL_MmapAlloc huge;
+    CSTL_mmap_alloc_construct(&huge, 0, true, nullptr);
+
+    size_t old_size = 1 << 20;
+    auto memory     = (unsigned char*)CSTL_mmap_alloc_allocate(&huge, old_size, 8);
+
+    ASSERT_NE(nullptr, memory) << "must allocate";
+
+    memset(memory, 0xEF, old_size);
+
+    size_t new_size = 9 << 20;
+    auto grown      = (unsigned char*)huge.alloc.reallocate(huge.alloc.opaque, memory, old_size, new_size, 8);
+
+    ASSERT_NE(nullptr, grown) << "must reallocate";
+
+    for (size_t i = 0; i < old_size; ++i) {
+        ASSERT_EQ(0xEF, grown[i]) << "contents must survive growth; i=" << i;
+    }
+
+    memset(grown, 0x12, new_size);
+
+#if defined(__linux__)
+    EXPECT_EQ(0, (uintptr_t)grown % (2 << 20)) << "grown huge page mappings must be aligned to 2 MiB";
+
+    void* reserved = CSTL_mmap_alloc_allocate(&huge, new_size, 8);
+    ASSERT_NE(nullptr, reserved) << "must allocate";
+
+    // Only comparable where the system supports `MADV_HUGEPAGE` at all.
+    if (vm_flags(reserved).find(" hg") != std::string::npos) {
+        EXPECT_NE(std::string::npos, vm_flags(grown).find(" hg")) << "grown mappings must be marked for huge pages";
+    }
+
+    CSTL_mmap_alloc_free(&huge, reserved, new_size, 8);
+#endif
+
+    CSTL_mmap_alloc_free(&huge, grown, new_size, 8);
+}
+
+TEST_F(MmapAllocTest, Containers) {
+    CSTL_PodType pod = CSTL_pod_uint64;
+    CSTL_VectorVal vec;
+
+    CSTL_vector_construct(&vec);
+
+    for (uint64_t i = 0; i < 1000000; ++i) {
+        ASSERT_TRUE(CSTL_vector_copy_push_back(&vec, pod.type, &pod.copy, &i, &mapped.alloc))
+            << "must return true on success";
+    }
+
+    const uint64_t* data = (const uint64_t*)CSTL_vector_data(&vec);
+
+    for (uint64_t i = 0; i < 1000000; ++i) {
+        ASSERT_EQ(i, data[i]) << "elements must survive growth; i=" << i;
+    }
+
+    CSTL_vector_destroy(&vec, pod.type, &pod.copy.move_type.drop_type, &mapped.alloc);
+
+    CSTL_StringVal str;
+    CSTL_string_construct(&str);
+
+    std::string real_str;
+
+    for (int i = 0; i < 100000; ++i) {
+        real_str += "mapped ";
+        ASSERT_TRUE(CSTL_string_append(&str, "mapped ", &mapped.alloc))
+            << "must return true on success";
+    }
+
+    EXPECT_EQ(real_str, std::string(CSTL_string_c_str(&str), CSTL_string_size(&str)))
+        << "strings should compare equal";
+
+    CSTL_string_destroy(&str, &mapped.alloc);
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <vector>
+
+#include "alloc.h"
+#include "node_pool.h"
+
+class NodePoolTest : public testing::Test {
+protected:
+    NodePoolTest() : pool{} {}
+
+    ~NodePoolTest() {
+        CSTL_node_pool_destroy(&pool);
+    }
+
+    void SetUp() override {
+        CSTL_node_pool_construct(&pool, 40, 8, nullptr);
+    }
+
+    CSTL_NodePool pool;
+};
+
+TEST_F(NodePoolTest, Reuse) {
+    std::vector<void*> nodes;
+
+    for (size_t i = 0; i < 1000; ++i) {
+        void* node = CSTL_node_pool_allocate(&pool, 40, 8);
+
+        ASSERT_NE(nullptr, node) << "must allocate";
+        EXPECT_EQ(0, (uintptr_t)node % 8) << "alignment must be upheld";
+
+        memset(node, (int)(i & 0xFF), 40);
+        nodes.push_back(node);
+    }
+
+    EXPECT_EQ(1000, std::set<void*>(nodes.begin(), nodes.end()).size()) << "live nodes must be distinct";
+
+    CSTL_NodePoolStats stats = CSTL_node_pool_stats(&pool);
+
+    EXPECT_EQ(1000, stats.used) << "must count nodes in use";
+    EXPECT_LE(1000, stats.reserved) << "must reserve at least the nodes in use";
+
+    for (void* node : nodes) {
+        CSTL_node_pool_free(&pool, node, 40, 8);
+    }
+
+    EXPECT_EQ(0, CSTL_node_pool_stats(&pool).used) << "must count nodes in use";
+
+    for (size_t i = 0; i < 1000; ++i) {
+        void* node = CSTL_node_pool_allocate(&pool, 24, 8);
+        ASSERT_NE(nullptr, node) << "must allocate";
+        nodes[i] = node;
+    }
+
+    EXPECT_EQ(stats.reserved, CSTL_node_pool_stats(&pool).reserved) << "freed nodes must be reused";
+
+    for (void* node : nodes) {
+        CSTL_node_pool_free(&pool, node, 24, 8);
+    }
+}
+
+TEST_F(NodePoolTest, Reserve) {
+    ASSERT_TRUE(CSTL_node_pool_reserve(&pool, 500)) << "must return true on success";
+
+    size_t reserved = CSTL_node_pool_stats(&pool).reserved;
+
+    EXPECT_LE(500, reserved) << "must reserve the requested nodes";
+
+    std::vector<void*> nodes;
+
+    for (size_t i = 0; i < 500; ++i) {
+        nodes.push_back(CSTL_node_pool_allocate(&pool, 40, 8));
+    }
+
+    EXPECT_EQ(reserved, CSTL_node_pool_stats(&pool).reserved) << "reserved nodes must not need the upstream allocator";
+
+    for (void* node : nodes) {
+        CSTL_node_pool_free(&pool, node, 40, 8);
+    }
+}
+
+TEST_F(NodePoolTest, PassThrough) {
+    // Bucket arrays and the like do not fit in a node.
+    void* big     = pool.alloc.aligned_alloc(pool.alloc.opaque, 4096, 8);
+    void* aligned = pool.alloc.aligned_alloc(pool.alloc.opaque, 32, 64);
+
+    ASSERT_NE(nullptr, big) << "must allocate";
+    ASSERT_NE(nullptr, aligned) << "must allocate";
+    EXPECT_EQ(0, (uintptr_t)aligned % 64) << "alignment must be upheld";
+
+    memset(big, 0xAB, 4096);
+
+    CSTL_NodePoolStats stats = CSTL_node_pool_stats(&pool);
+
+    EXPECT_EQ(0, stats.used) << "must not count blocks from the upstream allocator";
+    EXPECT_EQ(0, stats.reserved) << "must not reserve nodes for other blocks";
+
+    pool.alloc.aligned_free(pool.alloc.opaque, big, 4096, 8);
+    pool.alloc.aligned_free(pool.alloc.opaque, aligned, 32, 64);
+}
@@ -0,0 +1,365 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "alloc.h"
+#include "parallel.h"
+#include "thread_pool.h"
+#include "type.h"
+#include "vector.h"
+
+namespace {
+
+// Sizes around the chunk boundaries of 4 and 8 byte elements.
+constexpr size_t sizes[] = { 0, 1, 1000, 16384, 16385, 3 * 16384 + 5, 200000 };
+
+struct PoolDeleter {
+    void operator()(CSTL_ThreadPool* pool) const {
+        CSTL_thread_pool_destroy(pool, nullptr);
+    }
+};
+
+using PoolPtr = std::unique_ptr<CSTL_ThreadPool, PoolDeleter>;
+
+CSTL_VectorVal borrow(void* data, size_t bytes) {
+    CSTL_VectorVal vec;
+    vec.first = data;
+    vec.last  = static_cast<char*>(data) + bytes;
+    vec.end   = vec.last;
+    return vec;
+}
+
+void increment_chunk(void* first, void* last, void*) {
+    for (auto it = static_cast<uint32_t*>(first); it != static_cast<uint32_t*>(last); ++it) {
+        *it += 1;
+    }
+}
+
+void square_chunk(const void* first, const void* last, void* dest, void*) {
+    auto out = static_cast<uint64_t*>(dest);
+
+    for (auto it = static_cast<const uint32_t*>(first); it != static_cast<const uint32_t*>(last); ++it) {
+        *out++ = (uint64_t)*it * *it;
+    }
+}
+
+// The map `x -> a * x + b`, composed in order, which is not commutative.
+struct Affine {
+    uint32_t a;
+    uint32_t b;
+};
+
+Affine compose(Affine first, Affine second) {
+    return Affine{ first.a * second.a, first.b * second.a + second.b };
+}
+
+void reduce_affine(const void* first, const void* last, void* result, void*) {
+    Affine acc{ 1, 0 };
+
+    for (auto it = static_cast<const Affine*>(first); it != static_cast<const Affine*>(last); ++it) {
+        acc = compose(acc, *it);
+    }
+
+    *static_cast<Affine*>(result) = acc;
+}
+
+void combine_affine(void* result, const void* lhs, const void* rhs, void*) {
+    *static_cast<Affine*>(result) = compose(*static_cast<const Affine*>(lhs), *static_cast<const Affine*>(rhs));
+}
+
+void reduce_sum(const void* first, const void* last, void* result, void*) {
+    *static_cast<uint64_t*>(result) = std::accumulate(static_cast<const uint64_t*>(first), static_cast<const uint64_t*>(last), uint64_t{ 0 });
+}
+
+void combine_sum(void* result, const void* lhs, const void* rhs, void*) {
+    *static_cast<uint64_t*>(result) = *static_cast<const uint64_t*>(lhs) + *static_cast<const uint64_t*>(rhs);
+}
+
+void inclusive_sum(void* first, void* last, const void* carry, void*) {
+    uint64_t acc = carry != nullptr ? *static_cast<const uint64_t*>(carry) : 0;
+
+    for (auto it = static_cast<uint64_t*>(first); it != static_cast<uint64_t*>(last); ++it) {
+        *it = acc += *it;
+    }
+}
+
+void exclusive_sum(void* first, void* last, const void* carry, void*) {
+    uint64_t acc = *static_cast<const uint64_t*>(carry);
+
+    for (auto it = static_cast<uint64_t*>(first); it != static_cast<uint64_t*>(last); ++it) {
+        uint64_t value = *it;
+        *it = acc;
+        acc += value;
+    }
+}
+
+void destroy_string(void* first, void* last) {
+    std::destroy(static_cast<std::string*>(first), static_cast<std::string*>(last));
+}
+
+void move_string(void* first, void* last, void* dest) {
+    std::uninitialized_move(static_cast<std::string*>(first), static_cast<std::string*>(last), static_cast<std::string*>(dest));
+}
+
+bool string_eq(const void* lhs, const void* rhs) {
+    return *static_cast<const std::string*>(lhs) == *static_cast<const std::string*>(rhs);
+}
+
+bool string_lt(const void* lhs, const void* rhs) {
+    return *static_cast<const std::string*>(lhs) < *static_cast<const std::string*>(rhs);
+}
+
+bool uint32_eq(const void* lhs, const void* rhs) {
+    return *static_cast<const uint32_t*>(lhs) == *static_cast<const uint32_t*>(rhs);
+}
+
+bool uint32_lt(const void* lhs, const void* rhs) {
+    return *static_cast<const uint32_t*>(lhs) < *static_cast<const uint32_t*>(rhs);
+}
+
+// A key with its original position, ordered by the key only.
+struct Keyed {
+    uint32_t key;
+    uint32_t index;
+};
+
+bool keyed_eq(const void* lhs, const void* rhs) {
+    return static_cast<const Keyed*>(lhs)->key == static_cast<const Keyed*>(rhs)->key;
+}
+
+bool keyed_lt(const void* lhs, const void* rhs) {
+    return static_cast<const Keyed*>(lhs)->key < static_cast<const Keyed*>(rhs)->key;
+}
+
+// Fails every allocation in `[min_size, max_size]`, such as the per-part sort buffers.
+struct FailingAlloc {
+    static void* aligned_alloc(void* opaque, size_t size, size_t alignment) {
+        auto self = static_cast<FailingAlloc*>(opaque);
+
+        if (size >= self->min_size && size <= self->max_size) {
+            self->failures += 1;
+            return nullptr;
+        }
+
+        return ::aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1));
+    }
+
+    static void aligned_free(void* opaque, void* memory, size_t size, size_t alignment) {
+        (void)opaque, (void)size, (void)alignment;
+        ::free(memory);
+    }
+
+    size_t min_size;
+    size_t max_size;
+    size_t failures = 0;
+};
+
+} // namespace
+
+TEST(ParallelTest, ForEachAndTransform) {
+    PoolPtr pool{ CSTL_thread_pool_create(4, nullptr) };
+    ASSERT_NE(nullptr, pool) << "must create the pool";
+
+    CSTL_PodType src_pod  = CSTL_pod_uint32;
+    CSTL_PodType dest_pod = CSTL_pod_uint64;
+
+    for (size_t size : sizes) {
+        std::vector<uint32_t> values(size);
+        std::iota(values.begin(), values.end(), 0);
+
+        CSTL_VectorVal src = borrow(values.data(), size * sizeof(uint32_t));
+        CSTL_vector_parallel_for_each(pool.get(), &src, src_pod.type, &increment_chunk, nullptr);
+
+        for (size_t i = 0; i < size; ++i) {
+            ASSERT_EQ(i + 1, values[i]) << "must visit every element once";
+        }
+
+        CSTL_VectorVal dest;
+        CSTL_vector_construct(&dest);
+
+        uint64_t head = 7;
+        ASSERT_TRUE(CSTL_vector_copy_push_back(&dest, dest_pod.type, &dest_pod.copy, &head, nullptr)) << "must return true on success";
+        ASSERT_TRUE(CSTL_vector_parallel_transform(pool.get(), &dest, dest_pod.type, &dest_pod.copy.move_type, &src, src_pod.type, &square_chunk, nullptr, nullptr))
+            << "must return true on success";
+
+        ASSERT_EQ(size + 1, CSTL_vector_size(&dest, dest_pod.type)) << "must append one element per source element";
+
+        auto out = static_cast<const uint64_t*>(dest.first);
+        ASSERT_EQ(7, out[0]) << "must keep the existing elements";
+
+        for (size_t i = 0; i < size; ++i) {
+            ASSERT_EQ((uint64_t)values[i] * values[i], out[i + 1]) << "must transform every element in place";
+        }
+
+        CSTL_vector_destroy(&dest, dest_pod.type, &dest_pod.copy.move_type.drop_type, nullptr);
+    }
+}
+
+TEST(ParallelTest, ReduceAndScan) {
+    PoolPtr pool{ CSTL_thread_pool_create(4, nullptr) };
+    ASSERT_NE(nullptr, pool) << "must create the pool";
+
+    CSTL_Type affine_type = CSTL_define_type(sizeof(Affine), alignof(Affine));
+    CSTL_PodType sum_pod  = CSTL_pod_uint64;
+    std::mt19937_64 rng{19};
+
+    for (size_t size : sizes) {
+        std::vector<Affine> maps(size);
+        Affine expected{ 3, 5 };
+
+        for (auto& map : maps) {
+            map      = Affine{ (uint32_t)rng() | 1, (uint32_t)rng() };
+            expected = compose(expected, map);
+        }
+
+        CSTL_VectorVal vec = borrow(maps.data(), size * sizeof(Affine));
+        Affine result{ 3, 5 };
+
+        ASSERT_TRUE(CSTL_vector_parallel_reduce(pool.get(), &vec, affine_type, affine_type, &reduce_affine, &combine_affine, &result, nullptr, nullptr))
+            << "must return true on success";
+
+        EXPECT_EQ(expected.a, result.a) << "must combine the chunks in order";
+        EXPECT_EQ(expected.b, result.b) << "must combine the chunks in order";
+
+        std::vector<uint64_t> values(size);
+
+        for (auto& value : values) {
+            value = rng() % 1000;
+        }
+
+        std::vector<uint64_t> inclusive = values;
+        std::vector<uint64_t> exclusive = values;
+        std::vector<uint64_t> expected_inclusive(size), expected_exclusive(size);
+
+        std::inclusive_scan(values.begin(), values.end(), expected_inclusive.begin());
+        std::exclusive_scan(values.begin(), values.end(), expected_exclusive.begin(), uint64_t{ 11 });
+
+        CSTL_VectorVal inclusive_vec = borrow(inclusive.data(), size * sizeof(uint64_t));
+        CSTL_VectorVal exclusive_vec = borrow(exclusive.data(), size * sizeof(uint64_t));
+        uint64_t init                = 11;
+
+        ASSERT_TRUE(CSTL_vector_parallel_inclusive_scan(pool.get(), &inclusive_vec, sum_pod.type, &reduce_sum, &combine_sum, &inclusive_sum, nullptr, nullptr))
+            << "must return true on success";
+        ASSERT_TRUE(CSTL_vector_parallel_exclusive_scan(pool.get(), &exclusive_vec, sum_pod.type, &reduce_sum, &combine_sum, &exclusive_sum, &init, nullptr, nullptr))
+            << "must return true on success";
+
+        ASSERT_EQ(expected_inclusive, inclusive) << "must match `std::inclusive_scan`";
+        ASSERT_EQ(expected_exclusive, exclusive) << "must match `std::exclusive_scan`";
+    }
+}
+
+TEST(ParallelTest, Sort) {
+    PoolPtr pool{ CSTL_thread_pool_create(4, nullptr) };
+    ASSERT_NE(nullptr, pool) << "must create the pool";
+
+    CSTL_PodType pod          = CSTL_pod_uint32;
+    CSTL_CompType custom_comp = { &uint32_eq, &uint32_lt };
+    std::mt19937_64 rng{20};
+
+    // The ready-made table sorts the parts with a radix sort, the custom one with comparisons.
+    for (const CSTL_CompType* comp : { &CSTL_comp_uint32, (const CSTL_CompType*)&custom_comp }) {
+        for (size_t size : sizes) {
+            std::vector<uint32_t> real(size);
+
+            for (auto& value : real) {
+                value = (uint32_t)(rng() % (size / 2 + 1));
+            }
+
+            std::vector<uint32_t> sorted = real;
+            CSTL_VectorVal vec = borrow(sorted.data(), size * sizeof(uint32_t));
+
+            ASSERT_TRUE(CSTL_vector_parallel_sort(pool.get(), &vec, pod.type, &pod.copy.move_type, comp, nullptr)) << "must return true on success";
+
+            std::sort(real.begin(), real.end());
+            ASSERT_EQ(real, sorted) << "must sort like `std::sort`";
+        }
+    }
+
+    CSTL_MoveType move       = { { &destroy_string }, &move_string, false };
+    CSTL_CompType string_cmp = { &string_eq, &string_lt };
+    CSTL_Type string_type    = CSTL_define_type(sizeof(std::string), alignof(std::string));
+
+    for (size_t size : { 0, 100, 2048, 2049, 20000 }) {
+        std::vector<std::string> real;
+
+        for (size_t i = 0; i < size; ++i) {
+            real.push_back(std::to_string(rng() % 5000) + " is long enough not to be inline");
+        }
+
+        std::vector<std::string> sorted = real;
+        CSTL_VectorVal vec = borrow(sorted.data(), size * sizeof(std::string));
+
+        ASSERT_TRUE(CSTL_vector_parallel_sort(pool.get(), &vec, string_type, &move, &string_cmp, nullptr)) << "must return true on success";
+
+        std::sort(real.begin(), real.end());
+        ASSERT_EQ(real, sorted) << "must move every non-relocatable element";
+    }
+}
+
+TEST(ParallelTest, StableSort) {
+    PoolPtr pool{ CSTL_thread_pool_create(3, nullptr) };
+    ASSERT_NE(nullptr, pool) << "must create the pool";
+
+    CSTL_PodType pod   = CSTL_pod_type(sizeof(Keyed), alignof(Keyed));
+    CSTL_CompType comp = { &keyed_eq, &keyed_lt };
+    std::mt19937_64 rng{21};
+
+    for (size_t size : sizes) {
+        std::vector<Keyed> real(size);
+
+        for (size_t i = 0; i < size; ++i) {
+            real[i] = Keyed{ (uint32_t)(rng() % 64), (uint32_t)i };
+        }
+
+        std::vector<Keyed> sorted = real;
+        CSTL_VectorVal vec = borrow(sorted.data(), size * sizeof(Keyed));
+
+        ASSERT_TRUE(CSTL_vector_parallel_stable_sort(pool.get(), &vec, pod.type, &pod.copy.move_type, &comp, nullptr)) << "must return true on success";
+
+        std::stable_sort(real.begin(), real.end(), [](const Keyed& lhs, const Keyed& rhs) { return lhs.key < rhs.key; });
+
+        for (size_t i = 0; i < size; ++i) {
+            ASSERT_EQ(real[i].key, sorted[i].key) << "must sort the keys";
+            ASSERT_EQ(real[i].index, sorted[i].index) << "must keep equivalent elements in order";
+        }
+    }
+}
+
+TEST(ParallelTest, SortPartFailure) {
+    PoolPtr pool{ CSTL_thread_pool_create(4, nullptr) };
+    ASSERT_NE(nullptr, pool) << "must create the pool";
+
+    CSTL_PodType pod   = CSTL_pod_type(sizeof(uint32_t), alignof(uint32_t));
+    CSTL_CompType comp = { &uint32_eq, &uint32_lt };
+
+    for (uint64_t seed = 0; seed < 5; ++seed) {
+        FailingAlloc failing{ 50 * 1024, 400 * 1024 };
+        CSTL_Alloc alloc = { &failing, &FailingAlloc::aligned_alloc, &FailingAlloc::aligned_free, nullptr, nullptr };
+
+        std::mt19937_64 rng{seed};
+        std::vector<uint32_t> real(200000);
+
+        for (auto& value : real) {
+            value = (uint32_t)rng();
+        }
+
+        std::vector<uint32_t> sorted = real;
+        CSTL_VectorVal vec = borrow(sorted.data(), sorted.size() * sizeof(uint32_t));
+
+        ASSERT_FALSE(CSTL_vector_parallel_stable_sort(pool.get(), &vec, pod.type, &pod.copy.move_type, &comp, &alloc))
+            << "must return false if sorting a part fails; seed=" << seed;
+        ASSERT_NE(0, failing.failures) << "must have failed a part buffer; seed=" << seed;
+
+        std::sort(real.begin(), real.end());
+        std::sort(sorted.begin(), sorted.end());
+        ASSERT_EQ(real, sorted) << "must keep every element; seed=" << seed;
+    }
+}
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "alloc.h"
+#include "pool.h"
+#include "type.h"
+#include "vector.h"
+#include "xstring.h"
+
+class PoolTest : public testing::Test {
+protected:
+    PoolTest() : alloc{CSTL_pool_alloc()} {}
+
+    CSTL_Alloc* alloc;
+};
+
+TEST_F(PoolTest, SizesAndAlignments) {
+    std::vector<std::pair<unsigned char*, size_t>> blocks;
+
+    for (size_t size = 1; size <= 70000; size += size / 8 + 1) {
+        for (size_t alignment = 1; alignment <= 8192; alignment *= 4) {
+            auto memory = (unsigned char*)CSTL_pool_allocate(size, alignment);
+
+            ASSERT_NE(nullptr, memory) << "must allocate; size=" << size << " alignment=" << alignment;
+            EXPECT_EQ(0, (uintptr_t)memory % alignment)
+                << "alignment must be upheld; size=" << size << " alignment=" << alignment;
+
+            memset(memory, (int)(size & 0xFF), size);
+            blocks.emplace_back(memory, size);
+        }
+    }
+
+    size_t i = 0;
+
+    for (size_t size = 1; size <= 70000; size += size / 8 + 1) {
+        for (size_t alignment = 1; alignment <= 8192; alignment *= 4, ++i) {
+            auto [memory, block_size] = blocks[i];
+
+            for (size_t j = 0; j < block_size; ++j) {
+                ASSERT_EQ(block_size & 0xFF, memory[j])
+                    << "blocks must not overlap; size=" << block_size << " j=" << j;
+            }
+
+            CSTL_pool_free(memory, size, alignment);
+        }
+    }
+}
+
+TEST_F(PoolTest, Reuse) {
+    void* first = CSTL_pool_allocate(40, 8);
+    CSTL_pool_free(first, 40, 8);
+
+    EXPECT_EQ(first, CSTL_pool_allocate(40, 8))
+        << "a freed block must be reused by the same thread";
+
+    CSTL_pool_free(first, 40, 8);
+}
+
+TEST_F(PoolTest, Containers) {
+    CSTL_PodType pod = CSTL_pod_uint64;
+    CSTL_VectorVal vec;
+
+    CSTL_vector_construct(&vec);
+
+    for (uint64_t i = 0; i < 5000; ++i) {
+        ASSERT_TRUE(CSTL_vector_copy_push_back(&vec, pod.type, &pod.copy, &i, alloc))
+            << "must return true on success";
+    }
+
+    for (uint64_t i = 0; i < 5000; ++i) {
+        ASSERT_EQ(i, *(const uint64_t*)CSTL_vector_const_index(&vec, pod.type, i))
+            << "elements must match; i=" << i;
+    }
+
+    CSTL_vector_destroy(&vec, pod.type, &pod.copy.move_type.drop_type, alloc);
+
+    std::vector<CSTL_StringVal> strs(100);
+    std::vector<std::string> real_strs(100);
+
+    for (size_t i = 0; i < strs.size(); ++i) {
+        CSTL_string_construct(&strs[i]);
+
+        for (size_t j = 0; j <= i; ++j) {
+            real_strs[i] += (char)('a' + j % 26);
+            ASSERT_TRUE(CSTL_string_push_back(&strs[i], (char)('a' + j % 26), alloc))
+                << "must return true on success";
+        }
+    }
+
+    for (size_t i = 0; i < strs.size(); ++i) {
+        EXPECT_EQ(real_strs[i], std::string(CSTL_string_c_str(&strs[i]), CSTL_string_size(&strs[i])))
+            << "strings should compare equal; i=" << i;
+
+        CSTL_string_destroy(&strs[i], alloc);
+    }
+}
+
+TEST_F(PoolTest, CrossThreadFree) {
+    constexpr size_t count = 20000;
+
+    std::vector<void*> blocks(count);
+
+    std::thread producer([&] {
+        for (size_t i = 0; i < count; ++i) {
+            blocks[i] = CSTL_pool_allocate(16 + i % 200, 8);
+            memset(blocks[i], 0x5A, 16 + i % 200);
+        }
+    });
+
+    producer.join();
+
+    std::thread consumer([&] {
+        for (size_t i = 0; i < count; ++i) {
+            CSTL_pool_free(blocks[i], 16 + i % 200, 8);
+        }
+    });
+
+    consumer.join();
+
+    // Blocks returned by the exited consumer must be handed out again without overlap.
+    std::vector<unsigned char*> again(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        again[i] = (unsigned char*)CSTL_pool_allocate(16 + i % 200, 8);
+        ASSERT_NE(nullptr, again[i]) << "must allocate; i=" << i;
+        memset(again[i], (int)(i & 0xFF), 16 + i % 200);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        ASSERT_EQ(i & 0xFF, again[i][15]) << "blocks must not overlap; i=" << i;
+        CSTL_pool_free(again[i], 16 + i % 200, 8);
+    }
+}
+
+TEST_F(PoolTest, WideStringClasses) {
+    // Sizes whose character count and byte count fall into different classes.
+    for (size_t capacity : { 40, 100, 1000, 4000 }) {
+        CSTL_WideStringVal str;
+        CSTL_wstring_construct(&str);
+
+        ASSERT_TRUE(CSTL_wstring_reserve(&str, capacity, alloc)) << "must return true on success";
+
+        const wchar_t* buffer = CSTL_wstring_c_str(&str);
+        size_t bytes          = (CSTL_wstring_capacity(&str) + 1) * sizeof(wchar_t);
+
+        CSTL_wstring_destroy(&str, alloc);
+
+        void* reused = CSTL_pool_allocate(bytes, alignof(wchar_t));
+
+        EXPECT_EQ((const void*)buffer, reused)
+            << "wide string buffers must be freed to the class they came from; capacity=" << capacity;
+
+        CSTL_pool_free(reused, bytes, alignof(wchar_t));
+    }
+}
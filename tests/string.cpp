@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "alloc.h"
 #include "xstring.h"
@@ -578,3 +583,481 @@ TEST_F(StringTest, ResizeString) {
     CSTL_string_resize(&cstl_str, 3, '2', alloc);
     string_expect_equal();
 }
+
+TEST_F(StringTest, LongFindChar) {
+    // Long enough to cover every vector width and the overlapping tails:
+    for (size_t size : {1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 200}) {
+        real_str.assign(size, 'a');
+        CSTL_string_assign_char(&cstl_str, size, 'a', alloc);
+        string_expect_equal();
+
+        for (size_t pos = 0; pos < size; ++pos) {
+            real_str[pos] = 'b';
+            *CSTL_string_index(&cstl_str, pos) = 'b';
+
+            EXPECT_EQ(real_str.find('b', 0), CSTL_string_find_char(&cstl_str, 'b', 0))
+                << "matches must be equal; size=" << size << " pos=" << pos;
+            EXPECT_EQ(real_str.find('b', pos + 1), CSTL_string_find_char(&cstl_str, 'b', pos + 1))
+                << "(non)matches must be equal; size=" << size << " pos=" << pos;
+            EXPECT_EQ(real_str.rfind('b'), CSTL_string_rfind_char(&cstl_str, 'b', std::string::npos))
+                << "matches must be equal; size=" << size << " pos=" << pos;
+            EXPECT_EQ(real_str.rfind('b', pos - 1), CSTL_string_rfind_char(&cstl_str, 'b', pos - 1))
+                << "(non)matches must be equal; size=" << size << " pos=" << pos;
+
+            real_str[pos] = 'a';
+            *CSTL_string_index(&cstl_str, pos) = 'a';
+        }
+    }
+}
+
+TEST_F(StringTest, LongCompareAndLength) {
+    std::string other(200, 'x');
+
+    for (size_t size : {1, 16, 17, 32, 33, 64, 65, 200}) {
+        real_str.assign(size, 'x');
+        CSTL_string_assign(&cstl_str, real_str.c_str(), alloc);
+        string_expect_equal();
+
+        EXPECT_EQ(0, CSTL_string_compare_nn(CSTL_string_c_str(&cstl_str), size, other.data(), size))
+            << "equal ranges must compare equal; size=" << size;
+
+        for (size_t pos = 0; pos < size; ++pos) {
+            *CSTL_string_index(&cstl_str, pos) = 'w';
+
+            EXPECT_GT(0, CSTL_string_compare_nn(CSTL_string_c_str(&cstl_str), size, other.data(), size))
+                << "must compare less; size=" << size << " pos=" << pos;
+            EXPECT_LT(0, CSTL_string_compare_nn(other.data(), size, CSTL_string_c_str(&cstl_str), size))
+                << "must compare greater; size=" << size << " pos=" << pos;
+
+            *CSTL_string_index(&cstl_str, pos) = 'x';
+        }
+    }
+}
+
+TEST_F(StringTest, LongFindString) {
+    // Low entropy haystack, most positions match the first and last needle characters:
+    real_str.clear();
+    for (size_t i = 0; i < 3000; ++i) {
+        real_str.push_back(i % 7 == 0 || i % 11 == 0 ? 'b' : 'a');
+    }
+
+    real_str.replace(2500, 6, "marker");
+    CSTL_string_assign_n(&cstl_str, real_str.data(), real_str.size(), alloc);
+    string_expect_equal();
+
+    for (size_t size : {2, 3, 16, 33, 64, 65, 300}) {
+        for (size_t from : {0, 1, 700, 2000, 2499, 2900}) {
+            std::string needle = real_str.substr(from, size);
+
+            for (size_t off : {size_t{0}, from, from + 1, real_str.size(), std::string::npos}) {
+                EXPECT_EQ(real_str.find(needle, off),
+                    CSTL_string_find_n(&cstl_str, needle.data(), off, needle.size()))
+                    << "matches must be equal; size=" << size << " from=" << from << " off=" << off;
+                EXPECT_EQ(real_str.rfind(needle, off),
+                    CSTL_string_rfind_n(&cstl_str, needle.data(), off, needle.size()))
+                    << "matches must be equal; size=" << size << " from=" << from << " off=" << off;
+            }
+        }
+
+        // Periodic needles that almost match everywhere:
+        for (std::string needle : {std::string(size, 'a'), std::string(size - 1, 'a') + 'c',
+                                   'c' + std::string(size - 1, 'a'), std::string(size, 'b')}) {
+            EXPECT_EQ(real_str.find(needle), CSTL_string_find_n(&cstl_str, needle.data(), 0, needle.size()))
+                << "(non)matches must be equal; size=" << size << " needle=" << needle;
+            EXPECT_EQ(real_str.rfind(needle), CSTL_string_rfind_n(&cstl_str, needle.data(), std::string::npos, needle.size()))
+                << "(non)matches must be equal; size=" << size << " needle=" << needle;
+        }
+    }
+}
+
+TEST_F(StringTest, Searcher) {
+    real_str = "abracadabra, abracadabra! abrabrabra";
+    CSTL_string_assign_n(&cstl_str, real_str.data(), real_str.size(), alloc);
+
+    for (const std::string& needle : std::vector<std::string>{"abra", "bra", "a", "", "abracadabra!", "xyz", real_str + "+"}) {
+        CSTL_StringSearcher searcher;
+        CSTL_string_searcher_init(&searcher, needle.data(), needle.size());
+
+        for (size_t off = 0; off <= real_str.size() + 1; ++off) {
+            EXPECT_EQ(real_str.find(needle, off), CSTL_string_searcher_find(&searcher, &cstl_str, off))
+                << "matches must be equal; needle=" << needle << " off=" << off;
+            EXPECT_EQ(real_str.rfind(needle, off), CSTL_string_searcher_rfind(&searcher, &cstl_str, off))
+                << "matches must be equal; needle=" << needle << " off=" << off;
+        }
+
+        size_t in_range = CSTL_string_searcher_find_in(&searcher, real_str.data() + 7, real_str.size() - 7);
+        EXPECT_EQ(real_str.find(needle, 7), in_range != std::string::npos ? in_range + 7 : in_range)
+            << "range matches must be equal; needle=" << needle;
+        EXPECT_EQ(real_str.rfind(needle, 20), CSTL_string_searcher_rfind_in(&searcher, real_str.data(), std::min(real_str.size(), 20 + needle.size())))
+            << "range matches must be equal; needle=" << needle;
+
+        std::vector<size_t> expected;
+        for (size_t pos = real_str.find(needle); pos != std::string::npos;
+             pos = real_str.find(needle, pos + (needle.empty() ? 1 : needle.size()))) {
+            expected.push_back(pos);
+        }
+
+        EXPECT_EQ(expected.size(), CSTL_string_searcher_count(&searcher, &cstl_str))
+            << "counts must be equal; needle=" << needle;
+        EXPECT_EQ(expected.size(), CSTL_string_searcher_count_in(&searcher, real_str.data(), real_str.size()))
+            << "counts must be equal; needle=" << needle;
+
+        std::vector<size_t> positions(2);
+        EXPECT_EQ(expected.size(), CSTL_string_searcher_find_all(&searcher, &cstl_str, positions.data(), positions.size()))
+            << "must return the total count; needle=" << needle;
+
+        positions.resize(expected.size());
+        EXPECT_EQ(expected.size(), CSTL_string_searcher_find_all_in(&searcher, real_str.data(), real_str.size(), positions.data(), positions.size()))
+            << "must return the total count; needle=" << needle;
+        EXPECT_EQ(expected, positions)
+            << "positions must be equal; needle=" << needle;
+    }
+}
+
+TEST_F(StringTest, FindFirstOf) {
+    real_str.clear();
+    for (size_t i = 0; i < 300; ++i) {
+        real_str.push_back(static_cast<char>("lorem ipsum, dolor\t sit\xE9 amet;\n"[i % 32]));
+    }
+
+    CSTL_string_assign_n(&cstl_str, real_str.data(), real_str.size(), alloc);
+    string_expect_equal();
+
+    CSTL_StringVal cstl_set;
+    CSTL_string_construct(&cstl_set);
+
+    // Empty, vectorised and bitmap sized sets, including characters above 127:
+    for (const std::string& set : std::vector<std::string>{"", ";", " ,;\t\n", "abcdefghijklmnopqrstuvwxyz",
+                                                           "\xE9\n", "lorem ipsudt,\xE9;\n\t", "xyz"}) {
+        CSTL_string_assign_n(&cstl_set, set.data(), set.size(), alloc);
+
+        for (size_t off : {size_t{0}, size_t{1}, size_t{31}, size_t{150}, size_t{299}, size_t{300}, std::string::npos}) {
+            EXPECT_EQ(real_str.find_first_of(set, off), CSTL_string_find_first_of_n(&cstl_str, set.data(), off, set.size()))
+                << "matches must be equal; set=" << set << " off=" << off;
+            EXPECT_EQ(real_str.find_first_of(set, off), CSTL_string_find_first_of_str(&cstl_str, &cstl_set, off))
+                << "matches must be equal; set=" << set << " off=" << off;
+            EXPECT_EQ(real_str.find_last_of(set, off), CSTL_string_find_last_of_n(&cstl_str, set.data(), off, set.size()))
+                << "matches must be equal; set=" << set << " off=" << off;
+            EXPECT_EQ(real_str.find_last_of(set, off), CSTL_string_find_last_of(&cstl_str, set.c_str(), off))
+                << "matches must be equal; set=" << set << " off=" << off;
+            EXPECT_EQ(real_str.find_first_not_of(set, off), CSTL_string_find_first_not_of_n(&cstl_str, set.data(), off, set.size()))
+                << "matches must be equal; set=" << set << " off=" << off;
+            EXPECT_EQ(real_str.find_first_not_of(set, off), CSTL_string_find_first_not_of(&cstl_str, set.c_str(), off))
+                << "matches must be equal; set=" << set << " off=" << off;
+            EXPECT_EQ(real_str.find_last_not_of(set, off), CSTL_string_find_last_not_of_n(&cstl_str, set.data(), off, set.size()))
+                << "matches must be equal; set=" << set << " off=" << off;
+            EXPECT_EQ(real_str.find_last_not_of(set, off), CSTL_string_find_last_not_of_str(&cstl_str, &cstl_set, off))
+                << "matches must be equal; set=" << set << " off=" << off;
+        }
+    }
+
+    real_str.assign(100, 'x');
+    CSTL_string_assign_char(&cstl_str, 100, 'x', alloc);
+
+    for (size_t off : {size_t{0}, size_t{50}, size_t{99}, size_t{100}}) {
+        EXPECT_EQ(real_str.find_first_of('x', off), CSTL_string_find_first_of_char(&cstl_str, 'x', off))
+            << "matches must be equal; off=" << off;
+        EXPECT_EQ(real_str.find_last_of('x', off), CSTL_string_find_last_of_char(&cstl_str, 'x', off))
+            << "matches must be equal; off=" << off;
+        EXPECT_EQ(real_str.find_first_not_of('x', off), CSTL_string_find_first_not_of_char(&cstl_str, 'x', off))
+            << "(non)matches must be equal; off=" << off;
+        EXPECT_EQ(real_str.find_last_not_of('x', off), CSTL_string_find_last_not_of_char(&cstl_str, 'x', off))
+            << "(non)matches must be equal; off=" << off;
+    }
+
+    CSTL_string_destroy(&cstl_set, alloc);
+}
+
+TEST_F(StringTest, Hash) {
+    // FNV-1a test vectors, which MSVC's `std::hash<std::string>` reproduces on 64-bit targets:
+    if constexpr (sizeof(size_t) == 8) {
+        EXPECT_EQ((size_t)0xCBF29CE484222325ULL, CSTL_string_hash(&cstl_str))
+            << "an empty string must hash to the offset basis";
+        EXPECT_EQ((size_t)0xAF63DC4C8601EC8CULL, CSTL_string_hash_n("a", 1))
+            << "hashes must match `std::hash`";
+        EXPECT_EQ((size_t)0x85944171F73967E8ULL, CSTL_string_hash_n("foobar", 6))
+            << "hashes must match `std::hash`";
+    }
+
+    real_str.assign(sample);
+    CSTL_string_assign_n(&cstl_str, real_str.data(), real_str.size(), alloc);
+
+    EXPECT_EQ(CSTL_string_hash_n(real_str.data(), real_str.size()), CSTL_string_hash(&cstl_str))
+        << "a string must hash like its characters";
+    EXPECT_EQ(CSTL_string_fast_hash_n(real_str.data(), real_str.size()), CSTL_string_fast_hash(&cstl_str))
+        << "a string must hash like its characters";
+
+    std::string bytes(5000, '\0');
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<char>(i * 131 + 7);
+    }
+
+    // The fast hash must not depend on the instruction set, on either side of every path:
+    const std::pair<size_t, uint64_t> expected[] = {
+        {0, 0x6766AB3B5D6176E4}, {3, 0xE0176A9CEE0AEB2D}, {8, 0xC4DC4F1D73A2F23F},
+        {16, 0x2BF54DA402B78C95}, {17, 0x04BFF7201F87A457}, {48, 0x2B5FE3B8FA07C258},
+        {49, 0xB0733A84F92A664F}, {100, 0x5CCDDB5423B1552B}, {256, 0x2041B64628976B28},
+        {257, 0x18C67F5451E83789}, {1024, 0x101CB0CA7F477C2D}, {1025, 0x805004BD66BDC112},
+        {5000, 0x2693633A1AC268A4},
+    };
+
+    for (const auto& [size, hash] : expected) {
+        EXPECT_EQ((size_t)hash, CSTL_string_fast_hash_n(bytes.data(), size))
+            << "fast hashes must be stable; size=" << size;
+    }
+
+    std::vector<size_t> hashes;
+    for (size_t size = 0; size <= 1100; ++size) {
+        hashes.push_back(CSTL_string_fast_hash_n(bytes.data(), size));
+    }
+
+    // Every byte of a long string must be hashed:
+    for (size_t pos = 0; pos < 2100; pos += 7) {
+        std::string changed = bytes.substr(0, 2100);
+        changed[pos] ^= 1;
+        hashes.push_back(CSTL_string_fast_hash_n(changed.data(), changed.size()));
+    }
+
+    hashes.push_back(CSTL_string_fast_hash_n(bytes.data(), 2100));
+    std::sort(hashes.begin(), hashes.end());
+    EXPECT_EQ(hashes.end(), std::adjacent_find(hashes.begin(), hashes.end()))
+        << "distinct strings should not collide";
+
+    CSTL_StringVal other;
+    CSTL_string_construct(&other);
+    CSTL_string_assign_n(&other, real_str.data(), real_str.size(), alloc);
+
+    for (CSTL_HashTypeCRef hash : {&CSTL_string_hash_type, &CSTL_string_fast_hash_type}) {
+        EXPECT_TRUE(hash->is_eq(&cstl_str, &other))
+            << "equal strings must compare equal";
+        EXPECT_EQ(hash->hash(&cstl_str), hash->hash(&other))
+            << "equal strings must hash equal";
+    }
+
+    EXPECT_EQ(CSTL_string_hash(&cstl_str), CSTL_string_hash_type.hash(&cstl_str))
+        << "the table must hash like `std::hash`";
+
+    CSTL_string_push_back(&other, 'x', alloc);
+    EXPECT_FALSE(CSTL_string_hash_type.is_eq(&cstl_str, &other))
+        << "different strings must not compare equal";
+
+    CSTL_string_destroy(&other, alloc);
+}
+
+TEST_F(StringTest, View) {
+    real_str.clear();
+    for (size_t i = 0; i < 260; ++i) {
+        real_str.push_back(static_cast<char>("key=value; other_key=\xE9t\xE9;\n"[i % 26]));
+    }
+
+    CSTL_string_assign_n(&cstl_str, real_str.data(), real_str.size(), alloc);
+
+    std::string_view real_view = real_str;
+    CSTL_StringView view = CSTL_string_as_view(&cstl_str);
+
+    EXPECT_EQ(CSTL_string_c_str(&cstl_str), view.data) << "a view must refer to the string";
+    EXPECT_EQ(real_view.size(), view.size) << "a view must refer to the whole string";
+
+    static_assert(sizeof(CSTL_StringView) == sizeof(std::string_view), "must have the `std::string_view` layout");
+
+    for (const char* needle : {"", ";", "key", "other_key=", "\xE9t\xE9;\n", "missing"}) {
+        std::string_view real_needle = needle;
+        CSTL_StringView needle_view  = CSTL_string_view(needle);
+
+        for (size_t off : {size_t{0}, size_t{1}, size_t{27}, size_t{150}, size_t{259}, size_t{260}, std::string::npos}) {
+            EXPECT_EQ(real_view.find(real_needle, off), CSTL_string_view_find(view, needle_view, off))
+                << "matches must be equal; needle=" << needle << " off=" << off;
+            EXPECT_EQ(real_view.rfind(real_needle, off), CSTL_string_view_rfind(view, needle_view, off))
+                << "matches must be equal; needle=" << needle << " off=" << off;
+            EXPECT_EQ(real_view.find_first_of(real_needle, off), CSTL_string_view_find_first_of(view, needle_view, off))
+                << "matches must be equal; set=" << needle << " off=" << off;
+            EXPECT_EQ(real_view.find_last_of(real_needle, off), CSTL_string_view_find_last_of(view, needle_view, off))
+                << "matches must be equal; set=" << needle << " off=" << off;
+            EXPECT_EQ(real_view.find_first_not_of(real_needle, off), CSTL_string_view_find_first_not_of(view, needle_view, off))
+                << "matches must be equal; set=" << needle << " off=" << off;
+            EXPECT_EQ(real_view.find_last_not_of(real_needle, off), CSTL_string_view_find_last_not_of(view, needle_view, off))
+                << "matches must be equal; set=" << needle << " off=" << off;
+        }
+    }
+
+    for (size_t off : {size_t{0}, size_t{5}, size_t{259}, std::string::npos}) {
+        EXPECT_EQ(real_view.find('=', off), CSTL_string_view_find_char(view, '=', off)) << "off=" << off;
+        EXPECT_EQ(real_view.rfind('=', off), CSTL_string_view_rfind_char(view, '=', off)) << "off=" << off;
+        EXPECT_EQ(real_view.find_first_not_of('k', off), CSTL_string_view_find_first_not_of_char(view, 'k', off)) << "off=" << off;
+        EXPECT_EQ(real_view.find_last_not_of('\n', off), CSTL_string_view_find_last_not_of_char(view, '\n', off)) << "off=" << off;
+    }
+
+    // Slicing never copies:
+    CSTL_StringView field;
+    ASSERT_TRUE(CSTL_string_view_substr(&field, view, 4, 5)) << "must return true on success";
+    EXPECT_EQ(view.data + 4, field.data) << "a substring must refer to the same characters";
+    EXPECT_TRUE(CSTL_string_view_equal(field, CSTL_string_view("value"))) << "substrings must compare equal";
+    EXPECT_TRUE(CSTL_string_view_substr(&field, view, 260, 5)) << "the end is a valid offset";
+    EXPECT_EQ(0, field.size) << "a substring must be clamped to the view";
+    EXPECT_FALSE(CSTL_string_view_substr(&field, view, 261, 0)) << "must return false when out of range";
+
+    CSTL_StringView trimmed = view;
+    CSTL_string_view_remove_prefix(&trimmed, 4);
+    CSTL_string_view_remove_suffix(&trimmed, 250);
+    EXPECT_EQ(real_view.substr(4, 6), std::string_view(trimmed.data, trimmed.size)) << "must trim the view";
+
+    EXPECT_EQ(nullptr, CSTL_string_view_at(trimmed, 6)) << "must return NULL when out of range";
+    ASSERT_NE(nullptr, CSTL_string_view_at(trimmed, 5));
+    EXPECT_EQ(';', *CSTL_string_view_at(trimmed, 5)) << "must return the character at the position";
+
+    char buf[8];
+    EXPECT_EQ(3, CSTL_string_view_copy(trimmed, buf, 3, 3)) << "must copy up to the end";
+    EXPECT_EQ("ue;", std::string_view(buf, 3)) << "must copy the substring";
+    EXPECT_EQ(std::string::npos, CSTL_string_view_copy(trimmed, buf, 3, 7)) << "must return npos when out of range";
+
+    EXPECT_TRUE(CSTL_string_view_starts_with(view, CSTL_string_view("key="))) << "must match the prefix";
+    EXPECT_FALSE(CSTL_string_view_starts_with(trimmed, view)) << "a longer prefix must not match";
+    EXPECT_TRUE(CSTL_string_view_ends_with(view, CSTL_string_view(";\n"))) << "must match the suffix";
+    EXPECT_FALSE(CSTL_string_view_ends_with(view, CSTL_string_view("key"))) << "must not match another suffix";
+
+    for (const char* other : {"", "key", "key=value", "key=valuf", "kez"}) {
+        int expected = real_view.substr(0, 9).compare(other);
+        int result   = CSTL_string_view_compare(CSTL_string_view_n(view.data, 9), CSTL_string_view(other));
+        EXPECT_EQ(expected < 0, result < 0) << "comparisons must agree; other=" << other;
+        EXPECT_EQ(expected > 0, result > 0) << "comparisons must agree; other=" << other;
+    }
+
+    EXPECT_EQ(CSTL_string_hash(&cstl_str), CSTL_string_view_hash(view)) << "a view must hash like its string";
+    EXPECT_EQ(CSTL_string_fast_hash(&cstl_str), CSTL_string_view_fast_hash(view)) << "a view must hash like its string";
+
+    // Back to a string, also from a view of the string itself:
+    CSTL_StringVal other;
+    CSTL_string_construct(&other);
+
+    ASSERT_TRUE(CSTL_string_assign_view(&other, field, alloc));
+    ASSERT_TRUE(CSTL_string_append_view(&other, trimmed, alloc));
+    EXPECT_EQ("value;", std::string(CSTL_string_c_str(&other))) << "must assign and append views";
+
+    ASSERT_TRUE(CSTL_string_assign_view(&cstl_str, trimmed, alloc));
+    real_str = real_str.substr(4, 6);
+    string_expect_equal();
+
+    CSTL_string_destroy(&other, alloc);
+}
+
+namespace {
+
+// Reference split, one delimiter search at a time.
+std::vector<std::string_view> reference_split(std::string_view text, std::string_view delim, bool any_of, bool skip_empty) {
+    std::vector<std::string_view> fields;
+
+    for (;;) {
+        size_t pos   = any_of ? text.find_first_of(delim) : delim.empty() ? std::string_view::npos : text.find(delim);
+        size_t found = pos == std::string_view::npos ? text.size() : pos;
+
+        if (!skip_empty || found != 0) {
+            fields.push_back(text.substr(0, found));
+        }
+
+        if (pos == std::string_view::npos) {
+            return fields;
+        }
+
+        text.remove_prefix(found + (any_of ? 1 : delim.size()));
+    }
+}
+
+std::vector<std::string_view> split_all(CSTL_StringSplit& split) {
+    std::vector<std::string_view> fields;
+    CSTL_StringView field;
+
+    while (CSTL_string_split_next(&split, &field)) {
+        fields.emplace_back(field.data, field.size);
+    }
+
+    return fields;
+}
+
+} // namespace
+
+struct NullAlloc {
+    static void* aligned_alloc(void* opaque, size_t size, size_t alignment) {
+        (void)opaque, (void)size, (void)alignment;
+        return nullptr;
+    }
+
+    static void aligned_free(void* opaque, void* memory, size_t size, size_t alignment) {
+        (void)opaque, (void)size, (void)alignment;
+        ::free(memory);
+    }
+};
+
+TEST_F(StringTest, Split) {
+    real_str.clear();
+    for (size_t i = 0; i < 40; ++i) {
+        real_str += "2024-01-01 12:00:00 INFO  worker=" + std::to_string(i) + " msg=\"ok\",, took " + std::to_string(i * 7) + "ms\n";
+    }
+
+    CSTL_string_assign_n(&cstl_str, real_str.data(), real_str.size(), alloc);
+    CSTL_StringView view = CSTL_string_as_view(&cstl_str);
+
+    for (std::string text : {std::string{}, std::string{","}, std::string{",,a,,b,"}, std::string{"abc"}, real_str}) {
+        CSTL_StringView text_view = CSTL_string_view_n(text.data(), text.size());
+
+        for (bool skip_empty : {false, true}) {
+            CSTL_StringSplit split;
+
+            CSTL_string_split_init(&split, text_view, ',', skip_empty);
+            EXPECT_EQ(reference_split(text, ",", true, skip_empty), split_all(split))
+                << "must split on a character; text=" << text.substr(0, 20);
+
+            CSTL_string_split_init_any_of(&split, text_view, CSTL_string_view(" ,=\n"), skip_empty);
+            EXPECT_EQ(reference_split(text, " ,=\n", true, skip_empty), split_all(split))
+                << "must split on a set; text=" << text.substr(0, 20);
+
+            CSTL_string_split_init_any_of(&split, text_view, CSTL_string_view(""), skip_empty);
+            EXPECT_EQ(reference_split(text, "", true, skip_empty), split_all(split))
+                << "an empty set must match nothing";
+
+            for (const char* delim : {",,", "ms\n", " ", ""}) {
+                CSTL_string_split_init_str(&split, text_view, CSTL_string_view(delim), skip_empty);
+                EXPECT_EQ(reference_split(text, delim, false, skip_empty), split_all(split))
+                    << "must split on a substring; delim=" << delim << " text=" << text.substr(0, 20);
+            }
+        }
+    }
+
+    CSTL_StringSplit split;
+    CSTL_string_split_init(&split, view, '\n', true);
+
+    CSTL_StringView field;
+    ASSERT_TRUE(CSTL_string_split_next(&split, &field));
+    EXPECT_EQ(view.data, field.data) << "fields must refer to the original characters";
+    EXPECT_TRUE(CSTL_string_view_starts_with(field, CSTL_string_view("2024-01-01"))) << "must return the first field";
+
+    // Appends the remaining lines after an existing element, with a single allocation:
+    CSTL_PodType pod = CSTL_pod_type(sizeof(CSTL_StringView), alignof(CSTL_StringView));
+
+    CSTL_VectorVal fields;
+    CSTL_vector_construct(&fields);
+    ASSERT_TRUE(CSTL_vector_copy_push_back(&fields, pod.type, &pod.copy, &field, alloc));
+
+    ASSERT_TRUE(CSTL_string_split_into_vector(&split, &fields, alloc)) << "must return true on success";
+    ASSERT_EQ(40, CSTL_vector_size(&fields, pod.type)) << "must append every remaining field";
+    EXPECT_EQ(40, CSTL_vector_capacity(&fields, pod.type)) << "must reserve exactly once";
+    EXPECT_FALSE(CSTL_string_split_next(&split, &field)) << "must consume the iterator";
+
+    std::vector<std::string_view> expected = reference_split(real_str, "\n", true, true);
+    const CSTL_StringView* views = static_cast<const CSTL_StringView*>(CSTL_vector_const_data(&fields));
+
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i], std::string_view(views[i].data, views[i].size)) << "fields must be equal; i=" << i;
+    }
+
+    // A failed allocation must leave both the vector and the split as they were:
+    CSTL_Alloc failing_alloc = { nullptr, &NullAlloc::aligned_alloc, &NullAlloc::aligned_free, nullptr, nullptr };
+
+    CSTL_string_split_init(&split, view, '\n', true);
+    CSTL_StringSplit start = split;
+
+    ASSERT_FALSE(CSTL_string_split_into_vector(&split, &fields, &failing_alloc)) << "must fail when growth fails";
+    EXPECT_EQ(40, CSTL_vector_size(&fields, pod.type)) << "must keep the previous size on failure";
+    EXPECT_EQ(0, memcmp(&start, &split, sizeof(split))) << "must restore the split on failure";
+
+    CSTL_vector_destroy(&fields, pod.type, &pod.copy.move_type.drop_type, alloc);
+}
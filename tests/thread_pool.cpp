@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "thread_pool.h"
+
+namespace {
+
+struct PoolDeleter {
+    void operator()(CSTL_ThreadPool* pool) const {
+        CSTL_thread_pool_destroy(pool, nullptr);
+    }
+};
+
+using PoolPtr = std::unique_ptr<CSTL_ThreadPool, PoolDeleter>;
+
+void count_task(size_t index, void* context) {
+    static_cast<std::atomic<uint32_t>*>(context)[index].fetch_add(1, std::memory_order_relaxed);
+}
+
+struct Nested {
+    CSTL_ThreadPool* pool;
+    std::atomic<uint32_t> counts[64];
+};
+
+// Runs a nested call from inside a task.
+void nested_task(size_t index, void* context) {
+    auto nested = static_cast<Nested*>(context);
+    CSTL_thread_pool_run(nested->pool, 8, &count_task, &nested->counts[index * 8]);
+}
+
+// Computes a Fibonacci number by forking both halves, to build deep fork trees.
+struct Fib {
+    CSTL_ThreadPool* pool;
+    uint32_t n;
+    uint64_t result;
+};
+
+void fib_task(void* context) {
+    auto fib = static_cast<Fib*>(context);
+
+    if (fib->n < 2) {
+        fib->result = fib->n;
+        return;
+    }
+
+    Fib lhs{ fib->pool, fib->n - 1, 0 };
+    Fib rhs{ fib->pool, fib->n - 2, 0 };
+
+    CSTL_TaskGroup group;
+    CSTL_task_group_construct(&group, fib->pool);
+    CSTL_task_group_fork(&group, &fib_task, &lhs);
+    fib_task(&rhs);
+    CSTL_task_group_join(&group);
+
+    fib->result = lhs.result + rhs.result;
+}
+
+struct Submitted {
+    CSTL_ThreadPool* pool;
+    std::atomic<uint32_t> count;
+};
+
+// Submits one more task from inside a task, until 100 have run.
+void submit_task(void* context) {
+    auto submitted = static_cast<Submitted*>(context);
+
+    if (submitted->count.fetch_add(1) < 99) {
+        CSTL_thread_pool_submit(submitted->pool, &submit_task, submitted);
+    }
+}
+
+} // namespace
+
+TEST(ThreadPoolTest, Run) {
+    EXPECT_EQ(1, CSTL_thread_pool_thread_count(nullptr)) << "a null pool runs on the calling thread";
+
+    PoolPtr pool{ CSTL_thread_pool_create(4, nullptr) };
+    ASSERT_NE(nullptr, pool) << "must create the pool";
+    EXPECT_EQ(4, CSTL_thread_pool_thread_count(pool.get())) << "must count the calling thread";
+
+    for (CSTL_ThreadPool* runner : { pool.get(), (CSTL_ThreadPool*)nullptr }) {
+        for (size_t task_count : { 0, 1, 3, 1000 }) {
+            std::vector<std::atomic<uint32_t>> counts(task_count);
+
+            for (size_t round = 0; round < 20; ++round) {
+                CSTL_thread_pool_run(runner, task_count, &count_task, counts.data());
+            }
+
+            for (size_t i = 0; i < task_count; ++i) {
+                ASSERT_EQ(20, counts[i].load()) << "must run every task once per call";
+            }
+        }
+    }
+
+    Nested nested{ pool.get(), {} };
+    CSTL_thread_pool_run(pool.get(), 8, &nested_task, &nested);
+
+    for (auto& count : nested.counts) {
+        EXPECT_EQ(1, count.load()) << "nested calls must run every task";
+    }
+}
+
+TEST(ThreadPoolTest, ForkJoin) {
+    CSTL_ThreadPoolConfig config = { 4, true, 0 };
+
+    PoolPtr pool{ CSTL_thread_pool_create_with(&config, nullptr) };
+    ASSERT_NE(nullptr, pool) << "must create a pinned pool";
+
+    for (CSTL_ThreadPool* runner : { pool.get(), (CSTL_ThreadPool*)nullptr }) {
+        Fib fib{ runner, 20, 0 };
+        fib_task(&fib);
+        EXPECT_EQ(6765, fib.result) << "must run every forked task before the join returns";
+    }
+
+    // Far more forks than fit in a deque.
+    std::vector<std::atomic<uint32_t>> counts(5000);
+
+    CSTL_TaskGroup group;
+    CSTL_task_group_construct(&group, pool.get());
+
+    for (size_t round = 0; round < 2; ++round) {
+        for (auto& count : counts) {
+            CSTL_task_group_fork(&group, [](void* context) { static_cast<std::atomic<uint32_t>*>(context)->fetch_add(1); }, &count);
+        }
+
+        CSTL_task_group_join(&group);
+
+        for (auto& count : counts) {
+            ASSERT_EQ(round + 1, count.load()) << "a group must be reusable after a join";
+        }
+    }
+}
+
+TEST(ThreadPoolTest, Submit) {
+    Submitted submitted{ nullptr, { 0 } };
+
+    {
+        PoolPtr pool{ CSTL_thread_pool_create(3, nullptr) };
+        ASSERT_NE(nullptr, pool) << "must create the pool";
+
+        submitted.pool = pool.get();
+        ASSERT_TRUE(CSTL_thread_pool_submit(pool.get(), &submit_task, &submitted)) << "must return true on success";
+    }
+
+    EXPECT_EQ(100, submitted.count.load()) << "destroying the pool must wait for every submitted task";
+
+    submitted.pool = nullptr;
+    submitted.count = 0;
+    ASSERT_TRUE(CSTL_thread_pool_submit(nullptr, &submit_task, &submitted)) << "a null pool runs the task immediately";
+    EXPECT_EQ(100, submitted.count.load()) << "a null pool runs the task immediately";
+
+    PoolPtr automatic{ CSTL_thread_pool_create(0, nullptr) };
+    ASSERT_NE(nullptr, automatic) << "must create the pool";
+    EXPECT_LE(1, CSTL_thread_pool_thread_count(automatic.get())) << "must use one thread per processor";
+}
@@ -0,0 +1,390 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "unicode.h"
+
+namespace {
+
+// Reference encoders, one code point at a time.
+std::u8string encode_utf8(const std::u32string& text) {
+    std::u8string result;
+
+    for (char32_t cp : text) {
+        if (cp < 0x80) {
+            result += (char8_t)cp;
+        } else if (cp < 0x800) {
+            result += (char8_t)(0xC0 | cp >> 6);
+            result += (char8_t)(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            result += (char8_t)(0xE0 | cp >> 12);
+            result += (char8_t)(0x80 | (cp >> 6 & 0x3F));
+            result += (char8_t)(0x80 | (cp & 0x3F));
+        } else {
+            result += (char8_t)(0xF0 | cp >> 18);
+            result += (char8_t)(0x80 | (cp >> 12 & 0x3F));
+            result += (char8_t)(0x80 | (cp >> 6 & 0x3F));
+            result += (char8_t)(0x80 | (cp & 0x3F));
+        }
+    }
+
+    return result;
+}
+
+std::u16string encode_utf16(const std::u32string& text) {
+    std::u16string result;
+
+    for (char32_t cp : text) {
+        if (cp < 0x10000) {
+            result += (char16_t)cp;
+        } else {
+            result += (char16_t)(0xD800 + ((cp - 0x10000) >> 10));
+            result += (char16_t)(0xDC00 + (cp & 0x3FF));
+        }
+    }
+
+    return result;
+}
+
+std::wstring encode_wide(const std::u32string& text) {
+    if constexpr (sizeof(wchar_t) == 2) {
+        std::u16string utf16 = encode_utf16(text);
+        return std::wstring(utf16.begin(), utf16.end());
+    } else {
+        return std::wstring(text.begin(), text.end());
+    }
+}
+
+// Random text with ASCII runs of random length between other code points,
+// so that ASCII blocks start at every offset.
+std::u32string random_text(std::mt19937& rng, size_t count) {
+    std::u32string result;
+
+    while (result.size() < count) {
+        size_t run = rng() % 40;
+
+        for (size_t i = 0; i < run; ++i) {
+            result += (char32_t)(0x20 + rng() % 0x5F);
+        }
+
+        switch (rng() % 3) {
+        case 0:  result += (char32_t)(0x80 + rng() % 0x780); break;
+        case 1:  result += (char32_t)(0x800 + rng() % 0xD000); break; // below the surrogates
+        default: result += (char32_t)(0x10000 + rng() % 0x100000); break;
+        }
+    }
+
+    return result;
+}
+
+// Reference validator, one code point at a time.
+size_t reference_valid_prefix(const std::u8string& text) {
+    size_t i = 0;
+
+    while (i < text.size()) {
+        uint32_t lead = text[i];
+        size_t length = lead < 0x80 ? 1 : lead < 0xC2 ? 0 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : lead < 0xF5 ? 4 : 0;
+
+        if (length == 0 || text.size() - i < length) {
+            return i;
+        }
+
+        uint32_t cp = length == 1 ? lead : lead & (0x7F >> length);
+
+        for (size_t k = 1; k < length; ++k) {
+            if ((text[i + k] & 0xC0) != 0x80) {
+                return i;
+            }
+
+            cp = cp << 6 | (text[i + k] & 0x3F);
+        }
+
+        const uint32_t min_cp[] = { 0, 0, 0x80, 0x800, 0x10000 };
+
+        if (cp < min_cp[length] || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
+            return i;
+        }
+
+        i += length;
+    }
+
+    return i;
+}
+
+} // namespace
+
+TEST(UnicodeTest, Transcode) {
+    std::mt19937 rng{7};
+
+    for (size_t count : { 0, 1, 15, 16, 17, 100, 5000 }) {
+        std::u32string utf32 = random_text(rng, count);
+        std::u16string utf16 = encode_utf16(utf32);
+        std::u8string utf8   = encode_utf8(utf32);
+        std::wstring wide    = encode_wide(utf32);
+
+        EXPECT_EQ(utf16.size(), CSTL_utf8_to_utf16(utf8.data(), utf8.size(), nullptr).written) << "must measure the output";
+        EXPECT_EQ(utf8.size(), CSTL_utf32_to_utf8(utf32.data(), utf32.size(), nullptr).written) << "must measure the output";
+
+        std::u8string out8(utf8.size(), u8'\0');
+        std::u16string out16(utf16.size(), u'\0');
+        std::u32string out32(utf32.size(), U'\0');
+        std::wstring outw(wide.size(), L'\0');
+
+        CSTL_UnicodeResult result = CSTL_utf8_to_utf16(utf8.data(), utf8.size(), out16.data());
+        EXPECT_TRUE(result.valid) << "well-formed input must be valid";
+        EXPECT_EQ(utf8.size(), result.read) << "must read the whole input";
+        EXPECT_EQ(utf16.size(), result.written) << "must write the whole output";
+        EXPECT_EQ(utf16, out16) << "UTF-8 to UTF-16";
+
+        CSTL_utf8_to_utf32(utf8.data(), utf8.size(), out32.data());
+        EXPECT_EQ(utf32, out32) << "UTF-8 to UTF-32";
+
+        CSTL_utf16_to_utf8(utf16.data(), utf16.size(), out8.data());
+        EXPECT_EQ(utf8, out8) << "UTF-16 to UTF-8";
+
+        CSTL_utf16_to_utf32(utf16.data(), utf16.size(), out32.data());
+        EXPECT_EQ(utf32, out32) << "UTF-16 to UTF-32";
+
+        CSTL_utf32_to_utf8(utf32.data(), utf32.size(), out8.data());
+        EXPECT_EQ(utf8, out8) << "UTF-32 to UTF-8";
+
+        CSTL_utf32_to_utf16(utf32.data(), utf32.size(), out16.data());
+        EXPECT_EQ(utf16, out16) << "UTF-32 to UTF-16";
+
+        CSTL_utf8_to_wide(utf8.data(), utf8.size(), outw.data());
+        EXPECT_EQ(wide, outw) << "UTF-8 to wide";
+
+        CSTL_wide_to_utf8(wide.data(), wide.size(), out8.data());
+        EXPECT_EQ(utf8, out8) << "wide to UTF-8";
+
+        CSTL_wide_to_utf16(wide.data(), wide.size(), out16.data());
+        EXPECT_EQ(utf16, out16) << "wide to UTF-16";
+
+        CSTL_wide_to_utf32(wide.data(), wide.size(), out32.data());
+        EXPECT_EQ(utf32, out32) << "wide to UTF-32";
+    }
+
+    // Every scalar value, with the surrogates left out.
+    std::u32string all;
+
+    for (char32_t cp = 0; cp <= 0x10FFFF; ++cp) {
+        if (cp < 0xD800 || cp > 0xDFFF) {
+            all += cp;
+        }
+    }
+
+    std::u8string utf8 = encode_utf8(all);
+    std::u32string out32(all.size(), U'\0');
+
+    CSTL_UnicodeResult result = CSTL_utf8_to_utf32(utf8.data(), utf8.size(), out32.data());
+    EXPECT_TRUE(result.valid) << "every scalar value must round-trip";
+    EXPECT_EQ(all, out32) << "every scalar value must round-trip";
+}
+
+TEST(UnicodeTest, IllFormed) {
+    const std::u8string bad8[] = {
+        u8"\x80",             // lone continuation byte
+        u8"\xC0\xAF",         // overlong
+        u8"\xE0\x80\xAF",     // overlong
+        u8"\xF0\x8F\xBF\xBF", // overlong
+        u8"\xED\xA0\x80",     // encoded surrogate
+        u8"\xF4\x90\x80\x80", // above U+10FFFF
+        u8"\xF5\x80\x80\x80", // invalid lead byte
+        u8"\xE2\x82",         // truncated
+        u8"\xE2\x28\xA1",     // bad continuation
+    };
+
+    for (const std::u8string& bad : bad8) {
+        for (size_t prefix : { 0, 3, 20, 29, 31, 32, 33, 62, 100 }) {
+            std::u8string text = std::u8string(prefix, u8'a') + bad + u8"tail";
+            std::u16string out(text.size(), u'\0');
+
+            CSTL_UnicodeResult result = CSTL_utf8_to_utf16(text.data(), text.size(), out.data());
+            EXPECT_FALSE(result.valid) << "ill-formed UTF-8 must be rejected";
+            EXPECT_EQ(prefix, result.read) << "must stop at the ill-formed sequence";
+            EXPECT_EQ(prefix, result.written) << "must convert everything before it";
+        }
+    }
+
+    const std::u16string bad16[] = {
+        u"a\xDC00",  // lone low surrogate
+        u"a\xD800",  // high surrogate at the end
+        u"a\xD800x", // high surrogate without a low one
+    };
+
+    for (const std::u16string& bad : bad16) {
+        CSTL_UnicodeResult result = CSTL_utf16_to_utf8(bad.data(), bad.size(), nullptr);
+        EXPECT_FALSE(result.valid) << "unpaired surrogates must be rejected";
+        EXPECT_EQ(1, result.read) << "must stop at the unpaired surrogate";
+    }
+
+    const std::u32string bad32[] = {
+        std::u32string(U"ab") + (char32_t)0xD800,
+        std::u32string(U"ab") + (char32_t)0x110000,
+    };
+
+    for (const std::u32string& bad : bad32) {
+        CSTL_UnicodeResult result = CSTL_utf32_to_utf16(bad.data(), bad.size(), nullptr);
+        EXPECT_FALSE(result.valid) << "surrogates and values above U+10FFFF must be rejected";
+        EXPECT_EQ(2, result.read) << "must stop at the invalid code point";
+    }
+}
+
+TEST(UnicodeTest, Measure) {
+    std::mt19937 rng{9};
+
+    for (size_t count : { 0, 1, 3, 4, 7, 8, 9, 100, 5000, 70000 }) {
+        std::u32string utf32 = random_text(rng, count);
+        std::u16string utf16 = encode_utf16(utf32);
+        std::u8string utf8   = encode_utf8(utf32);
+
+        EXPECT_EQ(utf8.size(), CSTL_utf16_to_utf8(utf16.data(), utf16.size(), nullptr).written) << "must measure UTF-16 to UTF-8; count=" << count;
+        EXPECT_EQ(utf32.size(), CSTL_utf16_to_utf32(utf16.data(), utf16.size(), nullptr).written) << "must measure UTF-16 to UTF-32; count=" << count;
+        EXPECT_EQ(utf8.size(), CSTL_utf32_to_utf8(utf32.data(), utf32.size(), nullptr).written) << "must measure UTF-32 to UTF-8; count=" << count;
+        EXPECT_EQ(utf16.size(), CSTL_utf32_to_utf16(utf32.data(), utf32.size(), nullptr).written) << "must measure UTF-32 to UTF-16; count=" << count;
+    }
+
+    // Ill-formed code units after a prefix that ends at every offset within a vector block.
+    for (size_t prefix = 0; prefix < 40; ++prefix) {
+        std::u32string text32(prefix, U'\u00E9');
+        std::u16string text16(prefix, u'\u4E2D');
+
+        for (char16_t bad : { (char16_t)0xDC00, (char16_t)0xD800 }) {
+            std::u16string text = text16 + bad + u"0123456789abcdef";
+
+            CSTL_UnicodeResult result = CSTL_utf16_to_utf8(text.data(), text.size(), nullptr);
+            EXPECT_FALSE(result.valid) << "unpaired surrogates must be rejected; prefix=" << prefix;
+            EXPECT_EQ(prefix, result.read) << "must stop at the unpaired surrogate; prefix=" << prefix;
+            EXPECT_EQ(prefix * 3, result.written) << "must measure everything before it; prefix=" << prefix;
+        }
+
+        for (char32_t bad : { (char32_t)0xDFFF, (char32_t)0x110000, (char32_t)0xFFFFFFFF }) {
+            std::u32string text = text32 + bad + U"0123456789abcdef";
+
+            CSTL_UnicodeResult result = CSTL_utf32_to_utf8(text.data(), text.size(), nullptr);
+            EXPECT_FALSE(result.valid) << "invalid code points must be rejected; prefix=" << prefix;
+            EXPECT_EQ(prefix, result.read) << "must stop at the invalid code point; prefix=" << prefix;
+            EXPECT_EQ(prefix * 2, result.written) << "must measure everything before it; prefix=" << prefix;
+        }
+    }
+}
+
+TEST(UnicodeTest, Assign) {
+    std::mt19937 rng{11};
+
+    std::u32string text = random_text(rng, 300);
+    std::u8string utf8  = encode_utf8(text);
+    std::u16string utf16 = encode_utf16(text);
+    std::wstring wide   = encode_wide(text);
+
+    CSTL_UTF8StringVal str8;
+    CSTL_UTF16StringVal str16;
+    CSTL_UTF32StringVal str32;
+    CSTL_WideStringVal wstr;
+
+    CSTL_u8string_construct(&str8);
+    CSTL_u16string_construct(&str16);
+    CSTL_u32string_construct(&str32);
+    CSTL_wstring_construct(&wstr);
+
+    CSTL_UnicodeResult result;
+
+    ASSERT_TRUE(CSTL_u16string_assign_utf8(&str16, utf8.data(), utf8.size(), &result, nullptr)) << "must convert well-formed input";
+    EXPECT_EQ(utf16.size(), result.written) << "must report the length";
+    EXPECT_EQ(utf16, std::u16string(CSTL_u16string_c_str(&str16))) << "must be null-terminated";
+
+    ASSERT_TRUE(CSTL_u32string_assign_utf16(&str32, CSTL_u16string_data(&str16), CSTL_u16string_size(&str16), nullptr, nullptr));
+    EXPECT_EQ(text, std::u32string(CSTL_u32string_c_str(&str32))) << "UTF-16 to UTF-32";
+
+    ASSERT_TRUE(CSTL_wstring_assign_utf32(&wstr, CSTL_u32string_data(&str32), CSTL_u32string_size(&str32), nullptr, nullptr));
+    EXPECT_EQ(wide, std::wstring(CSTL_wstring_c_str(&wstr))) << "UTF-32 to wide";
+
+    ASSERT_TRUE(CSTL_u8string_assign_wide(&str8, CSTL_wstring_data(&wstr), CSTL_wstring_size(&wstr), nullptr, nullptr));
+    EXPECT_EQ(utf8, std::u8string(CSTL_u8string_c_str(&str8))) << "wide to UTF-8";
+
+    ASSERT_TRUE(CSTL_u8string_assign_utf16(&str8, u"été", 3, nullptr, nullptr));
+    EXPECT_EQ(u8"été", std::u8string(CSTL_u8string_c_str(&str8))) << "must shrink into the existing buffer";
+
+    ASSERT_TRUE(CSTL_wstring_assign_utf8(&wstr, u8"\U0001F600", 4, nullptr, nullptr));
+    EXPECT_EQ(std::wstring(L"\U0001F600"), std::wstring(CSTL_wstring_c_str(&wstr))) << "wchar_t must be UTF-16 or UTF-32 per platform";
+
+    std::u16string bad = u"ok\xDC00";
+    EXPECT_FALSE(CSTL_u32string_assign_utf16(&str32, bad.data(), bad.size(), &result, nullptr)) << "must reject ill-formed input";
+    EXPECT_FALSE(result.valid) << "must report ill-formed input";
+    EXPECT_EQ(2, result.read) << "must report where the input is ill-formed";
+    EXPECT_EQ(text, std::u32string(CSTL_u32string_c_str(&str32))) << "must leave the string unchanged on failure";
+
+    ASSERT_TRUE(CSTL_u16string_assign_utf32(&str16, nullptr, 0, nullptr, nullptr)) << "must accept empty input";
+    EXPECT_TRUE(CSTL_u16string_empty(&str16)) << "must assign empty input";
+
+    ASSERT_TRUE(CSTL_u16string_assign_wide(&str16, L"abc", 3, nullptr, nullptr));
+    ASSERT_TRUE(CSTL_u32string_assign_utf8(&str32, u8"abc", 3, nullptr, nullptr));
+    EXPECT_EQ(std::u16string(u"abc"), std::u16string(CSTL_u16string_c_str(&str16))) << "wide to UTF-16";
+    EXPECT_EQ(std::u32string(U"abc"), std::u32string(CSTL_u32string_c_str(&str32))) << "UTF-8 to UTF-32";
+
+    CSTL_u8string_destroy(&str8, nullptr);
+    CSTL_u16string_destroy(&str16, nullptr);
+    CSTL_u32string_destroy(&str32, nullptr);
+    CSTL_wstring_destroy(&wstr, nullptr);
+}
+
+TEST(UnicodeTest, Validate) {
+    std::mt19937 rng{13};
+
+    for (size_t count : { 0, 1, 31, 32, 33, 64, 1000, 20000 }) {
+        std::u32string utf32 = random_text(rng, count);
+        std::u8string utf8   = encode_utf8(utf32);
+
+        EXPECT_TRUE(CSTL_utf8_validate(utf8.data(), utf8.size())) << "well-formed input must be valid";
+        EXPECT_EQ(utf8.size(), CSTL_utf8_valid_prefix(utf8.data(), utf8.size())) << "the whole input must be the valid prefix";
+        EXPECT_EQ(utf32.size(), CSTL_utf8_count(utf8.data(), utf8.size())) << "must count code points";
+
+        if (utf8.empty()) {
+            continue;
+        }
+
+        // Damage a few bytes anywhere and compare with the reference.
+        for (size_t round = 0; round < 200; ++round) {
+            std::u8string damaged = utf8;
+
+            for (size_t n = rng() % 3 + 1; n != 0; --n) {
+                damaged[rng() % damaged.size()] = (char8_t)rng();
+            }
+
+            size_t expected = reference_valid_prefix(damaged);
+            ASSERT_EQ(expected, CSTL_utf8_valid_prefix(damaged.data(), damaged.size())) << "must find the first ill-formed sequence";
+            ASSERT_EQ(expected == damaged.size(), CSTL_utf8_validate(damaged.data(), damaged.size())) << "must agree with the valid prefix";
+        }
+
+        // Cut a sequence off at the end, also where the end falls on a block boundary.
+        for (size_t size : { utf8.size(), utf8.size() / 32 * 32 }) {
+            std::u8string cut = utf8.substr(0, size);
+
+            if (cut.size() >= 2) {
+                cut[size - 2] = 0xE2;
+                cut[size - 1] = 0x80;
+                EXPECT_EQ(reference_valid_prefix(cut), CSTL_utf8_valid_prefix(cut.data(), cut.size())) << "a cut off sequence must be ill-formed";
+                EXPECT_FALSE(CSTL_utf8_validate(cut.data(), cut.size())) << "a cut off sequence must be ill-formed";
+            }
+        }
+    }
+
+    CSTL_UTF8StringVal str;
+    CSTL_u8string_construct(&str);
+
+    std::u8string text = std::u8string(40, u8'x') + u8"\u00e9t\u00e9 \U0001F600";
+    CSTL_u8string_assign_n(&str, text.data(), text.size(), nullptr);
+    EXPECT_TRUE(CSTL_u8string_validate(&str)) << "must validate the string";
+    EXPECT_EQ(text.size(), CSTL_u8string_valid_prefix(&str)) << "must validate the string";
+    EXPECT_EQ(45, CSTL_u8string_count(&str)) << "must count the code points of the string";
+
+    CSTL_u8string_push_back(&str, 0xC3, nullptr);
+    EXPECT_FALSE(CSTL_u8string_validate(&str)) << "a trailing lead byte is ill-formed";
+    EXPECT_EQ(text.size(), CSTL_u8string_valid_prefix(&str)) << "must stop before the trailing lead byte";
+
+    CSTL_u8string_destroy(&str, nullptr);
+}
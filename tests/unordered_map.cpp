@@ -0,0 +1,295 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "alloc.h"
+#include "type.h"
+#include "unordered_map.h"
+#include "unordered_set.h"
+
+using Entry = std::pair<const uint64_t, std::string>;
+
+void destroy_entry(void* first, void* last) {
+    std::destroy(static_cast<Entry*>(first), static_cast<Entry*>(last));
+}
+
+void move_entry(void* first, void* last, void* dest) {
+    std::uninitialized_move(static_cast<Entry*>(first), static_cast<Entry*>(last), static_cast<Entry*>(dest));
+}
+
+void copy_entry(const void* first, const void* last, void* dest) {
+    std::uninitialized_copy(static_cast<const Entry*>(first), static_cast<const Entry*>(last), static_cast<Entry*>(dest));
+}
+
+bool key_eq(const void* lhs, const void* rhs) {
+    return *static_cast<const uint64_t*>(lhs) == *static_cast<const uint64_t*>(rhs);
+}
+
+// Deliberately weak, so that buckets hold several elements.
+size_t key_hash(const void* key) {
+    return (size_t)(*static_cast<const uint64_t*>(key) % 1021);
+}
+
+class UnorderedMapTest : public testing::Test {
+protected:
+    UnorderedMapTest() : cstl_map{}, copy{}, hash{}, alloc{nullptr}, type{} {}
+
+    ~UnorderedMapTest() {
+        CSTL_hash_destroy(&cstl_map, type, &copy.move_type.drop_type, alloc);
+    }
+
+    void SetUp() override {
+        type = CSTL_define_type(sizeof(Entry), alignof(Entry));
+
+        ASSERT_NE(nullptr, type);
+
+        copy = { { { &destroy_entry }, &move_entry, false }, &copy_entry, nullptr };
+        hash = { &key_eq, &key_hash };
+
+        ASSERT_TRUE(CSTL_hash_construct(&cstl_map, type, alloc)) << "must return true on success";
+    }
+
+    // Checks the list and bucket invariants that MSVC code relies on.
+    void map_assert_valid() {
+        auto buckets = static_cast<CSTL_HashNode**>(cstl_map.buckets.first);
+        auto head    = cstl_map.head;
+
+        size_t bucket_count = CSTL_hash_bucket_count(&cstl_map);
+
+        ASSERT_EQ(bucket_count - 1, cstl_map.mask) << "mask must match the bucket count";
+        ASSERT_EQ(0, bucket_count & (bucket_count - 1)) << "bucket count must be a power of 2";
+        ASSERT_EQ(bucket_count * 2, (size_t)(static_cast<CSTL_HashNode**>(cstl_map.buckets.last) - buckets))
+            << "there must be two bucket pointers per bucket";
+
+        size_t size = 0;
+
+        for (CSTL_HashNode* node = head->next; node != head; ++size) {
+            size_t bucket = key_hash(CSTL_hash_iterator_deref({ node, sizeof(CSTL_HashNode) })) & cstl_map.mask;
+
+            ASSERT_EQ(node, buckets[bucket * 2]) << "the nodes of a bucket must start at its first node";
+
+            while (true) {
+                ASSERT_EQ(node, node->next->prev) << "list must be doubly linked";
+
+                if (node == buckets[bucket * 2 + 1]) {
+                    break;
+                }
+
+                node = node->next;
+                size += 1;
+
+                ASSERT_NE(head, node) << "the last node of a bucket must be in the list";
+                ASSERT_EQ(bucket, key_hash(CSTL_hash_iterator_deref({ node, sizeof(CSTL_HashNode) })) & cstl_map.mask)
+                    << "the nodes of a bucket must be adjacent";
+            }
+
+            node = node->next;
+        }
+
+        ASSERT_EQ(size, CSTL_hash_size(&cstl_map)) << "size must match the list";
+    }
+
+    void map_assert_equal() {
+        ASSERT_EQ(real_map.size(), CSTL_hash_size(&cstl_map)) << "sizes must match";
+
+        for (const auto& [key, value] : real_map) {
+            CSTL_HashIter where = CSTL_hash_find(&cstl_map, type, &hash, &key);
+
+            ASSERT_FALSE(CSTL_hash_iterator_eq(where, CSTL_hash_end(&cstl_map, type)))
+                << "key must be found; key=" << key;
+            EXPECT_EQ(value, static_cast<Entry*>(CSTL_hash_iterator_deref(where))->second)
+                << "values must match; key=" << key;
+        }
+    }
+
+    std::unordered_map<uint64_t, std::string> real_map;
+
+    CSTL_UnorderedMapVal cstl_map;
+    CSTL_CopyType copy;
+    CSTL_HashType hash;
+    CSTL_Alloc* alloc;
+    CSTL_Type type;
+};
+
+TEST_F(UnorderedMapTest, Layout) {
+    if constexpr (sizeof(void*) == 8) {
+        EXPECT_EQ(64, sizeof(CSTL_UnorderedMapVal)) << "must match the size of `std::unordered_map`";
+        EXPECT_EQ(8, offsetof(CSTL_HashVal, head)) << "list must follow the traits object";
+        EXPECT_EQ(48, offsetof(CSTL_HashVal, mask)) << "mask must follow the bucket vector";
+    }
+}
+
+TEST_F(UnorderedMapTest, Default) {
+    EXPECT_TRUE(CSTL_hash_empty(&cstl_map)) << "must be empty";
+    EXPECT_EQ(8, CSTL_hash_bucket_count(&cstl_map)) << "must start with 8 buckets";
+    EXPECT_EQ(1.0f, CSTL_hash_max_load_factor(&cstl_map)) << "default max load factor must be 1";
+    EXPECT_TRUE(CSTL_hash_iterator_eq(CSTL_hash_begin(&cstl_map, type), CSTL_hash_end(&cstl_map, type)))
+        << "begin must equal end";
+
+    map_assert_valid();
+}
+
+TEST_F(UnorderedMapTest, InsertFindErase) {
+    std::mt19937_64 rng{42};
+
+    for (size_t i = 0; i < 20000; ++i) {
+        uint64_t key = rng() % 5000;
+        Entry value{key, std::to_string(key) + " is a reasonably long string"};
+
+        if (rng() % 4 != 0) {
+            bool inserted = false;
+            bool expected = real_map.emplace(value).second;
+
+            CSTL_HashIter where = CSTL_hash_copy_insert(&cstl_map, type, &hash, &copy, &value, &inserted, alloc);
+
+            ASSERT_EQ(expected, inserted) << "must insert only new keys; key=" << key;
+            ASSERT_EQ(key, static_cast<Entry*>(CSTL_hash_iterator_deref(where))->first)
+                << "must return the element with the key";
+        } else {
+            ASSERT_EQ(real_map.erase(key), CSTL_hash_erase_key(&cstl_map, type, &hash, &copy.move_type.drop_type, &key, alloc))
+                << "must erase only existing keys; key=" << key;
+        }
+
+        if (i % 1000 == 0) {
+            map_assert_valid();
+        }
+    }
+
+    map_assert_valid();
+    map_assert_equal();
+
+    EXPECT_GE(CSTL_hash_max_load_factor(&cstl_map), CSTL_hash_load_factor(&cstl_map))
+        << "load factor must be kept under the maximum";
+
+    size_t erased = 0;
+
+    for (CSTL_HashIter where = CSTL_hash_begin(&cstl_map, type); !CSTL_hash_iterator_eq(where, CSTL_hash_end(&cstl_map, type));) {
+        auto entry = static_cast<Entry*>(CSTL_hash_iterator_deref(where));
+
+        if (entry->first % 3 == 0) {
+            real_map.erase(entry->first);
+            where = CSTL_hash_erase(&cstl_map, type, &hash, &copy.move_type.drop_type, where, alloc);
+            erased += 1;
+        } else {
+            where = CSTL_hash_iterator_next(where);
+        }
+    }
+
+    EXPECT_LT(0, erased) << "must have erased elements";
+
+    map_assert_valid();
+    map_assert_equal();
+}
+
+TEST_F(UnorderedMapTest, MoveInsert) {
+    Entry value{7, std::string(100, 'x')};
+
+    bool inserted = false;
+    CSTL_HashIter where = CSTL_hash_move_insert(&cstl_map, type, &hash, &copy.move_type, &value, &inserted, alloc);
+
+    EXPECT_TRUE(inserted) << "must insert a new key";
+    EXPECT_EQ(std::string(100, 'x'), static_cast<Entry*>(CSTL_hash_iterator_deref(where))->second)
+        << "value must be moved in";
+    EXPECT_TRUE(value.second.empty()) << "source must be moved from";
+}
+
+TEST_F(UnorderedMapTest, ReserveAndRehash) {
+    ASSERT_TRUE(CSTL_hash_reserve(&cstl_map, type, &hash, 3000, alloc)) << "must return true on success";
+
+    size_t buckets = CSTL_hash_bucket_count(&cstl_map);
+
+    EXPECT_EQ(4096, buckets) << "must round up to a power of 2";
+
+    for (uint64_t key = 0; key < 3000; ++key) {
+        Entry value{key, "v"};
+        real_map.emplace(value);
+        CSTL_hash_copy_insert(&cstl_map, type, &hash, &copy, &value, nullptr, alloc);
+    }
+
+    EXPECT_EQ(buckets, CSTL_hash_bucket_count(&cstl_map)) << "reserved tables must not rehash";
+
+    ASSERT_TRUE(CSTL_hash_rehash(&cstl_map, type, &hash, 10, alloc)) << "must return true on success";
+    EXPECT_EQ(buckets, CSTL_hash_bucket_count(&cstl_map)) << "rehash must never shrink";
+
+    CSTL_hash_set_max_load_factor(&cstl_map, 0.25f);
+
+    ASSERT_TRUE(CSTL_hash_rehash(&cstl_map, type, &hash, 0, alloc)) << "must return true on success";
+    EXPECT_EQ(16384, CSTL_hash_bucket_count(&cstl_map)) << "must respect the max load factor";
+
+    map_assert_valid();
+    map_assert_equal();
+
+    CSTL_hash_clear(&cstl_map, type, &copy.move_type.drop_type, alloc);
+    real_map.clear();
+
+    EXPECT_EQ(16384, CSTL_hash_bucket_count(&cstl_map)) << "clear must keep the buckets";
+
+    map_assert_valid();
+}
+
+TEST_F(UnorderedMapTest, FindN) {
+    for (uint64_t key = 0; key < 2000; key += 2) {
+        Entry value{key, std::to_string(key)};
+        CSTL_hash_copy_insert(&cstl_map, type, &hash, &copy, &value, nullptr, alloc);
+    }
+
+    std::vector<uint64_t> keys(1000);
+    std::vector<const void*> key_ptrs(keys.size());
+    std::vector<void*> elements(keys.size());
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+        keys[i]     = i * 7 % 2000;
+        key_ptrs[i] = &keys[i];
+    }
+
+    CSTL_hash_find_n(&cstl_map, type, &hash, key_ptrs.data(), keys.size(), elements.data());
+
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (keys[i] % 2 == 0) {
+            ASSERT_NE(nullptr, elements[i]) << "existing keys must be found; key=" << keys[i];
+            EXPECT_EQ(std::to_string(keys[i]), static_cast<Entry*>(elements[i])->second)
+                << "must find the element with the key";
+        } else {
+            EXPECT_EQ(nullptr, elements[i]) << "missing keys must not be found; key=" << keys[i];
+        }
+    }
+}
+
+TEST(UnorderedSetTest, PodKeys) {
+    CSTL_PodType pod = CSTL_pod_uint32;
+    CSTL_HashType hash = {
+        [](const void* lhs, const void* rhs) { return *(const uint32_t*)lhs == *(const uint32_t*)rhs; },
+        [](const void* key) { return (size_t)(*(const uint32_t*)key * 2654435761u); }
+    };
+
+    CSTL_UnorderedSetVal cstl_set;
+    ASSERT_TRUE(CSTL_hash_construct(&cstl_set, pod.type, nullptr)) << "must return true on success";
+
+    std::unordered_set<uint32_t> real_set;
+
+    for (uint32_t i = 0; i < 10000; ++i) {
+        uint32_t key = i * 37 % 4099;
+
+        bool inserted = false;
+        CSTL_hash_copy_insert(&cstl_set, pod.type, &hash, &pod.copy, &key, &inserted, nullptr);
+
+        ASSERT_EQ(real_set.insert(key).second, inserted) << "must insert only new keys; key=" << key;
+    }
+
+    EXPECT_EQ(real_set.size(), CSTL_hash_size(&cstl_set)) << "sizes must match";
+
+    for (uint32_t key = 0; key < 5000; ++key) {
+        EXPECT_EQ(real_set.count(key) != 0, CSTL_hash_contains(&cstl_set, pod.type, &hash, &key))
+            << "membership must match; key=" << key;
+    }
+
+    CSTL_hash_destroy(&cstl_set, pod.type, &pod.copy.move_type.drop_type, nullptr);
+}
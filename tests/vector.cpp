@@ -2,6 +2,8 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <iterator>
 #include <memory>
 #include <vector>
 
@@ -123,7 +125,8 @@ protected:
                 {
                     &destroy_testint
                 },
-                &move_testint
+                &move_testint,
+                false
             },
             &copy_testint,
             &fill_testint
@@ -506,3 +509,215 @@ TEST_F(VectorTest, Resize) {
     vector_expect_size(10);
     vector_assert_equal();
 }
+
+TEST_F(VectorTest, TrivialRelocation) {
+    copy.move_type.trivially_relocatable = true;
+
+    for (uint32_t i = 0; i < 20; ++i) {
+        TestInt value{i};
+
+        real_vec.insert(real_vec.begin() + i / 2, value);
+        CSTL_VectorIter where = CSTL_vector_iterator_add(CSTL_vector_begin(&cstl_vec, type), i / 2);
+        CSTL_vector_copy_insert(&cstl_vec, &copy, where, &value, alloc);
+    }
+
+    vector_expect_size(20);
+    vector_assert_equal();
+
+    TestInt value{0xABCD};
+
+    real_vec.insert(real_vec.begin() + 3, 5, value);
+    CSTL_VectorIter where = CSTL_vector_iterator_add(CSTL_vector_begin(&cstl_vec, type), 3);
+    CSTL_vector_insert_n(&cstl_vec, &copy, where, 5, &value, alloc);
+
+    vector_expect_size(25);
+    vector_assert_equal();
+
+    real_vec.erase(real_vec.begin() + 2, real_vec.begin() + 9);
+    CSTL_VectorIter first = CSTL_vector_iterator_add(CSTL_vector_begin(&cstl_vec, type), 2);
+    CSTL_VectorIter last  = CSTL_vector_iterator_add(CSTL_vector_begin(&cstl_vec, type), 9);
+    CSTL_vector_erase_range(&cstl_vec, &copy.move_type, first, last);
+
+    vector_expect_size(18);
+    vector_assert_equal();
+
+    ASSERT_TRUE(CSTL_vector_reserve(&cstl_vec, type, &copy.move_type, 100, alloc))
+        << "must return true on success";
+
+    vector_expect_size(18);
+    vector_assert_equal();
+}
+
+TEST_F(VectorTest, TrivialType) {
+    CSTL_Type pod_type = CSTL_define_type(sizeof(uint64_t), alignof(uint64_t));
+    CSTL_CopyType pod_copy = {};
+    CSTL_VectorVal pod_vec;
+
+    CSTL_vector_construct(&pod_vec);
+
+    std::vector<uint64_t> expected;
+
+    for (uint64_t i = 0; i < 1000; ++i) {
+        expected.push_back(i * 7);
+        ASSERT_TRUE(CSTL_vector_copy_push_back(&pod_vec, pod_type, &pod_copy, &expected.back(), alloc))
+            << "must return true on success";
+    }
+
+    uint64_t fill_value = 42;
+
+    expected.insert(expected.begin() + 500, 37, fill_value);
+    CSTL_VectorIter where = CSTL_vector_iterator_add(CSTL_vector_begin(&pod_vec, pod_type), 500);
+    CSTL_vector_insert_n(&pod_vec, &pod_copy, where, 37, &fill_value, alloc);
+
+    expected.erase(expected.begin() + 100, expected.begin() + 300);
+    CSTL_VectorIter first = CSTL_vector_iterator_add(CSTL_vector_begin(&pod_vec, pod_type), 100);
+    CSTL_VectorIter last  = CSTL_vector_iterator_add(CSTL_vector_begin(&pod_vec, pod_type), 300);
+    CSTL_vector_erase_range(&pod_vec, &pod_copy.move_type, first, last);
+
+    expected.resize(2000, fill_value);
+    ASSERT_TRUE(CSTL_vector_resize(&pod_vec, pod_type, &pod_copy, 2000, &fill_value, alloc))
+        << "must return true on success";
+
+    ASSERT_EQ(expected.size(), CSTL_vector_size(&pod_vec, pod_type))
+        << "size of vector must be equal to " << expected.size();
+
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), (const uint64_t*)CSTL_vector_data(&pod_vec)))
+        << "trivial elements must match";
+
+    CSTL_vector_destroy(&pod_vec, pod_type, &pod_copy.move_type.drop_type, alloc);
+}
+
+TEST_F(VectorTest, PodTypes) {
+    const CSTL_PodType* pods[] = {
+        &CSTL_pod_int8, &CSTL_pod_uint8, &CSTL_pod_int16, &CSTL_pod_uint16,
+        &CSTL_pod_int32, &CSTL_pod_uint32, &CSTL_pod_int64, &CSTL_pod_uint64,
+        &CSTL_pod_float, &CSTL_pod_double, &CSTL_pod_pointer
+    };
+
+    const size_t sizes[] = { 1, 1, 2, 2, 4, 4, 8, 8, sizeof(float), sizeof(double), sizeof(void*) };
+
+    for (size_t i = 0; i < std::size(pods); ++i) {
+        EXPECT_EQ(sizes[i], CSTL_sizeof_type(pods[i]->type))
+            << "built-in size must match; i=" << i;
+        EXPECT_EQ(sizes[i], CSTL_alignof_type(pods[i]->type))
+            << "built-in alignment must match; i=" << i;
+    }
+
+    struct Triple {
+        uint64_t a, b, c;
+    };
+
+    EXPECT_EQ(nullptr, CSTL_pod_type(12, 8).type)
+        << "invalid layouts must give an invalid table";
+
+    for (CSTL_PodType pod : { CSTL_pod_uint16, CSTL_pod_uint32, CSTL_pod_uint64, CSTL_pod_type(sizeof(Triple), alignof(Triple)) }) {
+        size_t size = CSTL_sizeof_type(pod.type);
+        CSTL_VectorVal pod_vec;
+
+        CSTL_vector_construct(&pod_vec);
+
+        Triple value{0x0123456789ABCDEF, 0xFEDCBA9876543210, 0x5A5A5A5A5A5A5A5A};
+
+        ASSERT_TRUE(CSTL_vector_assign_n(&pod_vec, pod.type, &pod.copy, 100, &value, alloc))
+            << "must return true on success";
+        ASSERT_TRUE(CSTL_vector_resize(&pod_vec, pod.type, &pod.copy, 1000, &value, alloc))
+            << "must return true on success";
+
+        const char* data = (const char*)CSTL_vector_data(&pod_vec);
+
+        for (size_t i = 0; i < 1000; ++i) {
+            ASSERT_EQ(0, memcmp(data + i * size, &value, size))
+                << "filled elements must equal the value; size=" << size << " i=" << i;
+        }
+
+        CSTL_vector_destroy(&pod_vec, pod.type, &pod.copy.move_type.drop_type, alloc);
+    }
+}
+
+struct GrowthAlloc {
+    static void* aligned_alloc(void* opaque, size_t size, size_t alignment) {
+        (void)opaque;
+        return ::aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1));
+    }
+
+    static void aligned_free(void* opaque, void* memory, size_t size, size_t alignment) {
+        (void)opaque, (void)size, (void)alignment;
+        ::free(memory);
+    }
+
+    static bool try_expand(void* opaque, void* memory, size_t old_size, size_t new_size, size_t alignment) {
+        (void)memory, (void)old_size, (void)new_size, (void)alignment;
+        static_cast<GrowthAlloc*>(opaque)->expand_calls += 1;
+        return false;
+    }
+
+    static void* reallocate(void* opaque, void* memory, size_t old_size, size_t new_size, size_t alignment) {
+        (void)old_size, (void)alignment;
+        static_cast<GrowthAlloc*>(opaque)->reallocate_calls += 1;
+        return ::realloc(memory, new_size);
+    }
+
+    size_t expand_calls     = 0;
+    size_t reallocate_calls = 0;
+};
+
+TEST_F(VectorTest, GrowthHooks) {
+    GrowthAlloc counter;
+    CSTL_Alloc growth_alloc = {
+        &counter, &GrowthAlloc::aligned_alloc, &GrowthAlloc::aligned_free,
+        &GrowthAlloc::try_expand, &GrowthAlloc::reallocate
+    };
+
+    alloc = &growth_alloc;
+
+    for (uint32_t i = 0; i < 100; ++i) {
+        real_vec.emplace_back(i);
+        CSTL_vector_copy_push_back(&cstl_vec, type, &copy, &real_vec.back(), alloc);
+    }
+
+    vector_expect_size(100);
+    vector_assert_equal();
+
+    EXPECT_LT(0, counter.expand_calls) << "growth must try to expand in place";
+    EXPECT_EQ(0, counter.reallocate_calls) << "types that are not relocatable must not be reallocated";
+
+    copy.move_type.trivially_relocatable = true;
+
+    for (uint32_t i = 100; i < 1000; ++i) {
+        real_vec.emplace_back(i);
+        CSTL_vector_copy_push_back(&cstl_vec, type, &copy, &real_vec.back(), alloc);
+    }
+
+    vector_expect_size(1000);
+    vector_assert_equal();
+
+    EXPECT_LT(0, counter.reallocate_calls) << "relocatable types must grow through `reallocate`";
+
+    size_t reallocate_calls = counter.reallocate_calls;
+
+    ASSERT_TRUE(CSTL_vector_shrink_to_fit(&cstl_vec, type, &copy.move_type, alloc))
+        << "must return true on success";
+
+    // The inserted value lives inside the vector, which must not be moved from under it.
+    const TestInt* inner = (const TestInt*)CSTL_vector_index(&cstl_vec, type, 10);
+
+    real_vec.insert(real_vec.begin(), real_vec[10]);
+    CSTL_vector_copy_insert(&cstl_vec, &copy, CSTL_vector_begin(&cstl_vec, type), inner, alloc);
+
+    vector_expect_size(1001);
+    vector_assert_equal();
+
+    EXPECT_EQ(reallocate_calls, counter.reallocate_calls) << "aliased growth must not reallocate";
+
+    real_vec.resize(5000, real_int);
+    ASSERT_TRUE(CSTL_vector_resize(&cstl_vec, type, &copy, 5000, cstl_int, alloc))
+        << "must return true on success";
+
+    vector_expect_size(5000);
+    vector_assert_equal();
+
+    CSTL_vector_destroy(&cstl_vec, type, &copy.move_type.drop_type, alloc);
+    CSTL_vector_construct(&cstl_vec);
+
+    alloc = nullptr;
+}
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "alloc.h"
 #include "xstring.h"
@@ -578,3 +580,204 @@ TEST_F(WideStringTest, ResizeString) {
     CSTL_wstring_resize(&cstl_str, 3, L'2', alloc);
     string_expect_equal();
 }
+
+TEST_F(WideStringTest, LongFindChar) {
+    // Long enough to cover every vector width and the overlapping tails:
+    for (size_t size : {1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 200}) {
+        real_str.assign(size, L'a');
+        CSTL_wstring_assign_char(&cstl_str, size, L'a', alloc);
+        string_expect_equal();
+
+        for (size_t pos = 0; pos < size; ++pos) {
+            real_str[pos] = L'b';
+            *CSTL_wstring_index(&cstl_str, pos) = L'b';
+
+            EXPECT_EQ(real_str.find(L'b', 0), CSTL_wstring_find_char(&cstl_str, L'b', 0))
+                << "matches must be equal; size=" << size << " pos=" << pos;
+            EXPECT_EQ(real_str.find(L'b', pos + 1), CSTL_wstring_find_char(&cstl_str, L'b', pos + 1))
+                << "(non)matches must be equal; size=" << size << " pos=" << pos;
+            EXPECT_EQ(real_str.rfind(L'b'), CSTL_wstring_rfind_char(&cstl_str, L'b', std::wstring::npos))
+                << "matches must be equal; size=" << size << " pos=" << pos;
+            EXPECT_EQ(real_str.rfind(L'b', pos - 1), CSTL_wstring_rfind_char(&cstl_str, L'b', pos - 1))
+                << "(non)matches must be equal; size=" << size << " pos=" << pos;
+
+            real_str[pos] = L'a';
+            *CSTL_wstring_index(&cstl_str, pos) = L'a';
+        }
+    }
+}
+
+TEST_F(WideStringTest, LongCompareAndLength) {
+    std::wstring other(200, L'x');
+
+    for (size_t size : {1, 4, 5, 8, 9, 16, 17, 200}) {
+        real_str.assign(size, L'x');
+        CSTL_wstring_assign(&cstl_str, real_str.c_str(), alloc);
+        string_expect_equal();
+
+        EXPECT_EQ(0, CSTL_wstring_compare_nn(CSTL_wstring_c_str(&cstl_str), size, other.data(), size))
+            << "equal ranges must compare equal; size=" << size;
+
+        for (size_t pos = 0; pos < size; ++pos) {
+            *CSTL_wstring_index(&cstl_str, pos) = L'w';
+
+            EXPECT_GT(0, CSTL_wstring_compare_nn(CSTL_wstring_c_str(&cstl_str), size, other.data(), size))
+                << "must compare less; size=" << size << " pos=" << pos;
+            EXPECT_LT(0, CSTL_wstring_compare_nn(other.data(), size, CSTL_wstring_c_str(&cstl_str), size))
+                << "must compare greater; size=" << size << " pos=" << pos;
+
+            *CSTL_wstring_index(&cstl_str, pos) = L'x';
+        }
+    }
+}
+
+TEST_F(WideStringTest, LongFindString) {
+    // Low entropy haystack, L'\x161' shares its low byte with L'a':
+    real_str.clear();
+    for (size_t i = 0; i < 3000; ++i) {
+        real_str.push_back(i % 7 == 0 ? L'b' : i % 11 == 0 ? L'\x161' : L'a');
+    }
+
+    real_str.replace(2500, 6, L"marker");
+    CSTL_wstring_assign_n(&cstl_str, real_str.data(), real_str.size(), alloc);
+    string_expect_equal();
+
+    for (size_t size : {2, 3, 8, 9, 33, 64, 65, 300}) {
+        for (size_t from : {0, 1, 700, 2000, 2499, 2900}) {
+            std::wstring needle = real_str.substr(from, size);
+
+            for (size_t off : {size_t{0}, from, from + 1, real_str.size(), std::wstring::npos}) {
+                EXPECT_EQ(real_str.find(needle, off),
+                    CSTL_wstring_find_n(&cstl_str, needle.data(), off, needle.size()))
+                    << "matches must be equal; size=" << size << " from=" << from << " off=" << off;
+                EXPECT_EQ(real_str.rfind(needle, off),
+                    CSTL_wstring_rfind_n(&cstl_str, needle.data(), off, needle.size()))
+                    << "matches must be equal; size=" << size << " from=" << from << " off=" << off;
+            }
+        }
+
+        // Periodic needles that almost match everywhere:
+        for (std::wstring needle : {std::wstring(size, L'a'), std::wstring(size - 1, L'a') + L'c',
+                                    L'c' + std::wstring(size - 1, L'a'), std::wstring(size, L'\x161')}) {
+            EXPECT_EQ(real_str.find(needle), CSTL_wstring_find_n(&cstl_str, needle.data(), 0, needle.size()))
+                << "(non)matches must be equal; size=" << size;
+            EXPECT_EQ(real_str.rfind(needle), CSTL_wstring_rfind_n(&cstl_str, needle.data(), std::wstring::npos, needle.size()))
+                << "(non)matches must be equal; size=" << size;
+        }
+    }
+}
+
+TEST_F(WideStringTest, Searcher) {
+    real_str = L"abracadabra, \x161\x162racadabra! abrabrabra";
+    CSTL_wstring_assign_n(&cstl_str, real_str.data(), real_str.size(), alloc);
+
+    for (std::wstring needle : {L"abra", L"bra", L"\x161\x162ra", L"", L"xyz"}) {
+        CSTL_WideStringSearcher searcher;
+        CSTL_wstring_searcher_init(&searcher, needle.data(), needle.size());
+
+        for (size_t off = 0; off <= real_str.size() + 1; ++off) {
+            EXPECT_EQ(real_str.find(needle, off), CSTL_wstring_searcher_find(&searcher, &cstl_str, off))
+                << "matches must be equal; off=" << off;
+            EXPECT_EQ(real_str.rfind(needle, off), CSTL_wstring_searcher_rfind(&searcher, &cstl_str, off))
+                << "matches must be equal; off=" << off;
+        }
+
+        size_t expected = 0;
+        for (size_t pos = real_str.find(needle); pos != std::wstring::npos;
+             pos = real_str.find(needle, pos + (needle.empty() ? 1 : needle.size()))) {
+            ++expected;
+        }
+
+        EXPECT_EQ(expected, CSTL_wstring_searcher_count(&searcher, &cstl_str))
+            << "counts must be equal";
+    }
+}
+
+TEST_F(WideStringTest, FindFirstOf) {
+    real_str.clear();
+    for (size_t i = 0; i < 300; ++i) {
+        real_str.push_back(L"lorem ipsum, dolor\t sit\x161 amet;\n"[i % 32]);
+    }
+
+    CSTL_wstring_assign_n(&cstl_str, real_str.data(), real_str.size(), alloc);
+    string_expect_equal();
+
+    // Empty, vectorised and larger sets, including characters above 255:
+    for (const std::wstring& set : std::vector<std::wstring>{L"", L";", L" ,;\t\n", L"abcdefghijklmnopqrstuvwxyz",
+                                                             L"\x161\n", L"lorem ipsudt,\x161;\n\ta", L"lorem ipsudt,;\n\tab", L"xyz"}) {
+        for (size_t off : {size_t{0}, size_t{1}, size_t{31}, size_t{150}, size_t{299}, size_t{300}, std::wstring::npos}) {
+            EXPECT_EQ(real_str.find_first_of(set, off), CSTL_wstring_find_first_of_n(&cstl_str, set.data(), off, set.size()))
+                << "matches must be equal; off=" << off;
+            EXPECT_EQ(real_str.find_last_of(set, off), CSTL_wstring_find_last_of_n(&cstl_str, set.data(), off, set.size()))
+                << "matches must be equal; off=" << off;
+            EXPECT_EQ(real_str.find_first_not_of(set, off), CSTL_wstring_find_first_not_of_n(&cstl_str, set.data(), off, set.size()))
+                << "matches must be equal; off=" << off;
+            EXPECT_EQ(real_str.find_last_not_of(set, off), CSTL_wstring_find_last_not_of_n(&cstl_str, set.data(), off, set.size()))
+                << "matches must be equal; off=" << off;
+        }
+    }
+}
+
+TEST_F(WideStringTest, Hash) {
+    real_str.assign(sample);
+    CSTL_wstring_assign_n(&cstl_str, real_str.data(), real_str.size(), alloc);
+
+    // `std::hash<std::wstring>` hashes the bytes of the characters:
+    const char* bytes = reinterpret_cast<const char*>(real_str.data());
+    EXPECT_EQ(CSTL_string_hash_n(bytes, real_str.size() * sizeof(wchar_t)), CSTL_wstring_hash(&cstl_str))
+        << "a wide string must hash like its bytes";
+    EXPECT_EQ(CSTL_string_fast_hash_n(bytes, real_str.size() * sizeof(wchar_t)), CSTL_wstring_fast_hash(&cstl_str))
+        << "a wide string must hash like its bytes";
+
+    CSTL_WideStringVal other;
+    CSTL_wstring_construct(&other);
+    CSTL_wstring_assign_n(&other, real_str.data(), real_str.size() - 1, alloc);
+
+    EXPECT_FALSE(CSTL_wstring_fast_hash_type.is_eq(&cstl_str, &other))
+        << "different strings must not compare equal";
+    EXPECT_NE(CSTL_wstring_fast_hash_type.hash(&cstl_str), CSTL_wstring_fast_hash_type.hash(&other))
+        << "different strings should not collide";
+
+    CSTL_wstring_push_back(&other, real_str.back(), alloc);
+    EXPECT_TRUE(CSTL_wstring_hash_type.is_eq(&cstl_str, &other))
+        << "equal strings must compare equal";
+    EXPECT_EQ(CSTL_wstring_hash_type.hash(&cstl_str), CSTL_wstring_hash_type.hash(&other))
+        << "equal strings must hash equal";
+
+    CSTL_wstring_destroy(&other, alloc);
+}
+
+TEST_F(WideStringTest, View) {
+    static_assert(sizeof(CSTL_WideStringView) == sizeof(std::wstring_view), "must have the `std::wstring_view` layout");
+
+    real_str.assign(sample);
+    CSTL_wstring_assign_n(&cstl_str, real_str.data(), real_str.size(), alloc);
+
+    std::wstring_view real_view = real_str;
+    CSTL_WideStringView view = CSTL_wstring_as_view(&cstl_str);
+
+    for (const wchar_t* needle : {L"", L"ABC", L"xyz", L"0123456789", L"\x161"}) {
+        CSTL_WideStringView needle_view = CSTL_wstring_view(needle);
+
+        for (size_t off : {size_t{0}, size_t{10}, size_t{61}, size_t{62}, std::wstring::npos}) {
+            EXPECT_EQ(real_view.find(needle, off), CSTL_wstring_view_find(view, needle_view, off))
+                << "matches must be equal; off=" << off;
+            EXPECT_EQ(real_view.rfind(needle, off), CSTL_wstring_view_rfind(view, needle_view, off))
+                << "matches must be equal; off=" << off;
+            EXPECT_EQ(real_view.find_first_of(needle, off), CSTL_wstring_view_find_first_of(view, needle_view, off))
+                << "matches must be equal; off=" << off;
+            EXPECT_EQ(real_view.find_last_not_of(needle, off), CSTL_wstring_view_find_last_not_of(view, needle_view, off))
+                << "matches must be equal; off=" << off;
+        }
+    }
+
+    CSTL_WideStringView digits;
+    ASSERT_TRUE(CSTL_wstring_view_substr(&digits, view, 0, 10));
+    EXPECT_TRUE(CSTL_wstring_view_equal(digits, CSTL_wstring_view(L"0123456789"))) << "substrings must compare equal";
+    EXPECT_GT(0, CSTL_wstring_view_compare(digits, view)) << "a prefix must compare less";
+    EXPECT_EQ(CSTL_wstring_hash_n(L"0123456789", 10), CSTL_wstring_view_hash(digits)) << "a view must hash like its characters";
+
+    ASSERT_TRUE(CSTL_wstring_assign_view(&cstl_str, digits, alloc)) << "must assign a view of itself";
+    real_str.resize(10);
+    string_expect_equal();
+}